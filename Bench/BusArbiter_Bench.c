@@ -0,0 +1,381 @@
+/*!*****************************************************************************
+ * @file    BusArbiter_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Stress test and benchmark of the bus arbiter
+ * @details Host-only benchmark (Linux). The shared I2C interface is a checker
+ *          bus: it detects two transfers at the same time and a packet of a
+ *          client in the middle of the sequence of another one, and gives the
+ *          CPU to the other threads in the middle of each packet so that the
+ *          clients queue and the bus is handed over at each sequence end.
+ *          - Uncontended: one client, the cost of the arbiter per packet
+ *            against the shared interface called directly, no contended
+ *            acquisition
+ *          - Priority: while the bus is held, a bulk client then a high
+ *            priority client queue, the high priority one gets the bus first
+ *          - Stress: 8 client threads of the 3 priority classes run sequences
+ *            of 3 packets, batches, groups of 2 sequences between
+ *            BusArbiter_Acquire() and BusArbiter_Release() (no other sequence
+ *            between them) and sequences ending with an error. At the end all
+ *            the sequences are on the bus, no client waits and the bus is free
+ *          It gives the acquisitions, the contended ones and the wait times per
+ *          priority class, and the worst queue depth. Build and run from the
+ *          repository root:
+ *            gcc -O2 -I. Bench/BusArbiter_Bench.c BusArbiter.c I2C_Interface.c SPI_Interface.c CRC.c EndianTransform.c -lpthread -o BusArbiterBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <pthread.h>
+#include "BusArbiter.h"
+#include "I2C_Interface.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_CLIENT_COUNT     ( 8u )        //!< Count of client threads of the stress test
+#define BENCH_SEQUENCE_COUNT   ( 4000u )     //!< Count of sequences per client thread
+#define BENCH_UNCONTENDED      ( 1000000u )  //!< Count of packets of the uncontended measure
+#define BENCH_FAIL_MARK        ( 0xEEu )     //!< First data byte of a packet that the checker bus fails
+#define BENCH_ORDER_SIZE       ( 16u )       //!< Count of sequence ends logged for the priority check
+
+static const char* const BENCH_PRIORITY_NAMES[BUSARB_PRIORITY_COUNT] = { "high", "normal", "bulk" };
+
+//! Checker bus shared by the clients
+typedef struct BenchBus
+{
+  volatile uint32_t InTransfer;            //!< Count of transfers in progress
+  bool Yield;                              //!< Give the CPU in the middle of each packet
+  uint16_t SequenceAddr;                   //!< Chip address of the sequence in progress. 0 if none
+  uint16_t LastSequenceAddr;               //!< Chip address of the last sequence ended by a stop
+  uint32_t Sequences;                      //!< Count of sequences ended by a stop
+  uint32_t Failed;                         //!< Count of sequences ended by an error
+  uint32_t Packets;                        //!< Count of packets
+  uint32_t Violations;                     //!< Count of arbitration violations
+  uint16_t Order[BENCH_ORDER_SIZE];        //!< Chip addresses of the first sequence ends
+} BenchBus;
+
+//! Client thread of the stress test
+typedef struct BenchClient
+{
+  pthread_t Thread;
+  BusArbiterClient Client;
+  I2C_Interface I2C;
+  uint16_t ChipAddr;
+  uint32_t SequenceCount;
+  uint32_t Failures;
+} BenchClient;
+
+static BenchBus BenchShared;
+static I2C_Interface BenchBusI2C;
+static BusArbiter BenchArbiter;
+static BenchClient BenchClients[BENCH_CLIENT_COUNT];
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Ticks of the arbiter statistics: microseconds
+//=============================================================================
+static uint32_t __Bench_GetTicks(void)
+{
+  return (uint32_t)(__Bench_Now_ns() / 1e3);
+}
+
+
+//=============================================================================
+// [STATIC] Yield of the waiting clients
+//=============================================================================
+static void __Bench_Yield(void)
+{
+  sched_yield();
+}
+
+
+//=============================================================================
+// [STATIC] Checker bus transfer
+//=============================================================================
+static eERRORRESULT __Bench_BusTransfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc)
+{
+  BenchBus* pBus = (BenchBus*)pIntDev->InterfaceDevice;
+  eERRORRESULT Error = ERR_NONE;
+  if (__atomic_add_fetch(&pBus->InTransfer, 1, __ATOMIC_ACQ_REL) != 1) __atomic_add_fetch(&pBus->Violations, 1, __ATOMIC_RELAXED); // Two transfers at the same time
+  const uint16_t ChipAddr = (pPacketDesc->ChipAddr & I2C_ONLY_ADDR8_Mask);
+  if (pPacketDesc->Start)
+  {
+    if ((pBus->SequenceAddr != 0) && (pBus->SequenceAddr != ChipAddr)) pBus->Violations++; // Start in the middle of the sequence of another client
+    pBus->SequenceAddr = ChipAddr;
+  }
+  else if (pBus->SequenceAddr != ChipAddr) pBus->Violations++;                  // Packet of another client in the middle of a sequence
+  pBus->Packets++;
+  if (pBus->Yield) sched_yield();                                               // Let the other clients try to take the bus now
+  if ((pPacketDesc->pBuffer != NULL) && (pPacketDesc->BufferSize > 0) && (pPacketDesc->pBuffer[0] == BENCH_FAIL_MARK))
+  {
+    Error = ERR__I2C_NACK_DATA;                                                  // The master releases the bus after the error
+    pBus->SequenceAddr = 0;
+    pBus->Failed++;
+  }
+  else if (pPacketDesc->Stop)
+  {
+    if (pBus->Sequences < BENCH_ORDER_SIZE) pBus->Order[pBus->Sequences] = ChipAddr;
+    pBus->LastSequenceAddr = ChipAddr;
+    pBus->SequenceAddr = 0;
+    pBus->Sequences++;
+  }
+  __atomic_sub_fetch(&pBus->InTransfer, 1, __ATOMIC_ACQ_REL);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Initialize the checker bus and the arbiter
+//=============================================================================
+static eERRORRESULT __Bench_Init(bool yield)
+{
+  memset(&BenchShared, 0, sizeof(BenchShared));
+  memset(&BenchBusI2C, 0, sizeof(BenchBusI2C));
+  BenchShared.Yield           = yield;
+  BenchBusI2C.InterfaceDevice = &BenchShared;
+  BenchBusI2C.fnI2C_Transfer  = __Bench_BusTransfer;
+  memset(&BenchArbiter, 0, sizeof(BenchArbiter));
+  BenchArbiter.fnYield    = __Bench_Yield;
+  BenchArbiter.fnGetTicks = __Bench_GetTicks;
+  return BusArbiter_Init(&BenchArbiter, &BenchBusI2C, NULL);
+}
+
+
+//=============================================================================
+// [STATIC] Transfer a sequence of 3 packets (start, data, stop)
+//=============================================================================
+static eERRORRESULT __Bench_Sequence(I2C_Interface* pI2C, uint16_t chipAddr, bool batch)
+{
+  uint8_t Data[3] = { 0x01, 0x02, 0x03 };
+  I2CInterface_Packet Packets[3] =
+  {
+    I2C_INTERFACE8_TX_DATA_DESC(chipAddr, true , &Data[0], 1, false, I2C_SIMPLE_TRANSFER),
+    I2C_INTERFACE8_TX_DATA_DESC(chipAddr, false, &Data[1], 1, false, I2C_SIMPLE_TRANSFER),
+    I2C_INTERFACE8_TX_DATA_DESC(chipAddr, false, &Data[2], 1, true , I2C_SIMPLE_TRANSFER),
+  };
+  if (batch) return pI2C->fnI2C_TransferBatch(pI2C, &Packets[0], 3, NULL);
+  eERRORRESULT Error = ERR_NONE;
+  for (size_t zIdx = 0; (zIdx < 3) && (Error == ERR_NONE); ++zIdx) Error = pI2C->fnI2C_Transfer(pI2C, &Packets[zIdx]);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Client thread of the stress test
+//=============================================================================
+static void* __Bench_ClientThread(void* pArg)
+{
+  BenchClient* pBenchClient = (BenchClient*)pArg;
+  for (uint32_t zSeq = 0; zSeq < pBenchClient->SequenceCount; ++zSeq)
+  {
+    eERRORRESULT Error;
+    if ((zSeq % 13u) == 12u)
+    { // Sequence ended by an error in its first packet, the bus shall be released
+      uint8_t Fail = BENCH_FAIL_MARK;
+      I2CInterface_Packet Packet = I2C_INTERFACE8_TX_DATA_DESC(pBenchClient->ChipAddr, true, &Fail, 1, false, I2C_SIMPLE_TRANSFER);
+      if (pBenchClient->I2C.fnI2C_Transfer(&pBenchClient->I2C, &Packet) != ERR__I2C_NACK_DATA) pBenchClient->Failures++;
+      continue;
+    }
+    if ((zSeq % 11u) == 10u)
+    { // Group of 2 sequences, no sequence of another client between them
+      BusArbiter_Acquire(&pBenchClient->Client);
+      Error = __Bench_Sequence(&pBenchClient->I2C, pBenchClient->ChipAddr, false);
+      if (Error == ERR_NONE) __Bench_Yield();
+      if ((Error == ERR_NONE) && (BenchShared.LastSequenceAddr != pBenchClient->ChipAddr)) pBenchClient->Failures++;
+      if (Error == ERR_NONE) Error = __Bench_Sequence(&pBenchClient->I2C, pBenchClient->ChipAddr, true);
+      BusArbiter_Release(&pBenchClient->Client);
+    }
+    else Error = __Bench_Sequence(&pBenchClient->I2C, pBenchClient->ChipAddr, ((zSeq % 7u) == 6u));
+    if (Error != ERR_NONE) pBenchClient->Failures++;
+  }
+  return NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Print the statistics of the arbiter
+//=============================================================================
+static void __Bench_PrintStats(const char* pName)
+{
+  for (size_t zPrio = 0; zPrio < BUSARB_PRIORITY_COUNT; ++zPrio)
+  {
+    const BusArbiterStats* pStats = &BenchArbiter.Stats[zPrio];
+    if (pStats->Acquisitions == 0) continue;
+    printf("%-12s  %-8s  %8u  %9u  %11.1f  %11u  %9u\n", pName, BENCH_PRIORITY_NAMES[zPrio], (unsigned)pStats->Acquisitions, (unsigned)pStats->Contended,
+           (pStats->Contended > 0 ? (double)pStats->TotalWaitTicks / pStats->Contended : 0.0), (unsigned)pStats->MaxWaitTicks, (unsigned)BenchArbiter.MaxQueueDepth);
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Uncontended cost of the arbiter
+//=============================================================================
+static int __Bench_Uncontended(void)
+{
+  int Failures = 0;
+  BusArbiterClient Client;
+  I2C_Interface I2C;
+  uint8_t Data = 0x01;
+  I2CInterface_Packet Packet = I2C_INTERFACE8_TX_DATA_DESC(0x10, true, &Data, 1, true, I2C_SIMPLE_TRANSFER);
+  if ((__Bench_Init(false) != ERR_NONE) || (BusArbiter_I2CclientAttach(&I2C, &Client, &BenchArbiter, BUSARB_PRIORITY_NORMAL) != ERR_NONE)) { printf("Initialization failed\n"); return 1; }
+
+  double Start = __Bench_Now_ns();
+  for (uint32_t zPacket = 0; zPacket < BENCH_UNCONTENDED; ++zPacket) (void)BenchBusI2C.fnI2C_Transfer(&BenchBusI2C, &Packet);
+  const double Direct = (__Bench_Now_ns() - Start) / BENCH_UNCONTENDED;
+  Start = __Bench_Now_ns();
+  for (uint32_t zPacket = 0; zPacket < BENCH_UNCONTENDED; ++zPacket)
+    if (I2C.fnI2C_Transfer(&I2C, &Packet) != ERR_NONE) { ++Failures; break; }
+  const double Arbitrated = (__Bench_Now_ns() - Start) / BENCH_UNCONTENDED;
+  printf("Uncontended packet: %.1f ns direct, %.1f ns through the arbiter\n", Direct, Arbitrated);
+  Failures += __Bench_Check(BenchArbiter.Stats[BUSARB_PRIORITY_NORMAL].Acquisitions == BENCH_UNCONTENDED, "one acquisition per sequence");
+  Failures += __Bench_Check(BenchArbiter.Stats[BUSARB_PRIORITY_NORMAL].Contended == 0, "no contended acquisition without contention");
+  Failures += __Bench_Check(BenchArbiter.pOwner == NULL, "bus free after the sequences");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Wait until a count of clients waits for the bus
+//=============================================================================
+static bool __Bench_WaitQueueDepth(uint32_t depth)
+{
+  const double Timeout = __Bench_Now_ns() + 5e9;
+  while (BusArbiter_GetQueueDepth(&BenchArbiter) < depth)
+  {
+    if (__Bench_Now_ns() > Timeout) return false;
+    sched_yield();
+  }
+  return true;
+}
+
+
+//=============================================================================
+// [STATIC] The bus is handed over to the highest priority waiting client
+//=============================================================================
+static int __Bench_Priority(void)
+{
+  int Failures = 0;
+  BusArbiterClient Holder;
+  I2C_Interface HolderI2C;
+  if ((__Bench_Init(true) != ERR_NONE) || (BusArbiter_I2CclientAttach(&HolderI2C, &Holder, &BenchArbiter, BUSARB_PRIORITY_NORMAL) != ERR_NONE)) { printf("Initialization failed\n"); return 1; }
+  BenchClient* pBulk = &BenchClients[0];
+  BenchClient* pHigh = &BenchClients[1];
+  memset(&BenchClients[0], 0, 2 * sizeof(BenchClient));
+  pBulk->ChipAddr = 0x20; pBulk->SequenceCount = 1;
+  pHigh->ChipAddr = 0x22; pHigh->SequenceCount = 1;
+  if ((BusArbiter_I2CclientAttach(&pBulk->I2C, &pBulk->Client, &BenchArbiter, BUSARB_PRIORITY_BULK) != ERR_NONE)
+   || (BusArbiter_I2CclientAttach(&pHigh->I2C, &pHigh->Client, &BenchArbiter, BUSARB_PRIORITY_HIGH) != ERR_NONE)) { printf("Initialization failed\n"); return 1; }
+
+  BusArbiter_Acquire(&Holder);
+  bool Queued = (pthread_create(&pBulk->Thread, NULL, __Bench_ClientThread, pBulk) == 0);
+  Queued = Queued && __Bench_WaitQueueDepth(1);
+  Queued = Queued && (pthread_create(&pHigh->Thread, NULL, __Bench_ClientThread, pHigh) == 0);
+  Queued = Queued && __Bench_WaitQueueDepth(2);
+  Failures += __Bench_Check(Queued, "2 clients queued while the bus is held");
+  Failures += __Bench_Check(__Bench_Sequence(&HolderI2C, 0x10, false) == ERR_NONE, "sequence of the holder while clients wait");
+  BusArbiter_Release(&Holder);
+  pthread_join(pBulk->Thread, NULL);
+  pthread_join(pHigh->Thread, NULL);
+  Failures += __Bench_Check((pBulk->Failures == 0) && (pHigh->Failures == 0), "sequences of the queued clients");
+  Failures += __Bench_Check((BenchShared.Sequences == 3) && (BenchShared.Order[1] == 0x22) && (BenchShared.Order[2] == 0x20), "high priority client served before the bulk client");
+  Failures += __Bench_Check(BenchShared.Violations == 0, "no arbitration violation");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Stress test of the hand over with client threads
+//=============================================================================
+static int __Bench_Stress(void)
+{
+  int Failures = 0;
+  if (__Bench_Init(true) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  memset(&BenchClients[0], 0, sizeof(BenchClients));
+  uint32_t Expected = 0, ExpectedFailed = 0;
+  for (size_t zClient = 0; zClient < BENCH_CLIENT_COUNT; ++zClient)
+  {
+    BenchClient* pBenchClient = &BenchClients[zClient];
+    pBenchClient->ChipAddr      = (uint16_t)(0x20 + (2 * zClient));
+    pBenchClient->SequenceCount = BENCH_SEQUENCE_COUNT;
+    if (BusArbiter_I2CclientAttach(&pBenchClient->I2C, &pBenchClient->Client, &BenchArbiter, (eBusArbiter_Priority)(zClient % BUSARB_PRIORITY_COUNT)) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+    for (uint32_t zSeq = 0; zSeq < BENCH_SEQUENCE_COUNT; ++zSeq)
+    {
+      if ((zSeq % 13u) == 12u) ExpectedFailed++;
+      else Expected += ((zSeq % 11u) == 10u ? 2u : 1u);
+    }
+  }
+
+  const double Start = __Bench_Now_ns();
+  size_t Started = 0;
+  for (; Started < BENCH_CLIENT_COUNT; ++Started)
+    if (pthread_create(&BenchClients[Started].Thread, NULL, __Bench_ClientThread, &BenchClients[Started]) != 0) { ++Failures; break; }
+  for (size_t zClient = 0; zClient < Started; ++zClient)
+  {
+    pthread_join(BenchClients[zClient].Thread, NULL);
+    if (BenchClients[zClient].Failures > 0) { printf("Client %u: %u failures\n", (unsigned)zClient, (unsigned)BenchClients[zClient].Failures); ++Failures; }
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  Failures += __Bench_Check(Started == BENCH_CLIENT_COUNT, "client threads started");
+  Failures += __Bench_Check(BenchShared.Violations == 0, "no arbitration violation");
+  Failures += __Bench_Check((BenchShared.Sequences == Expected) && (BenchShared.Failed == ExpectedFailed), "all the sequences on the bus");
+  Failures += __Bench_Check((BusArbiter_GetQueueDepth(&BenchArbiter) == 0) && (BenchArbiter.pOwner == NULL), "no waiting client and the bus is free at the end");
+  uint32_t Contended = 0;
+  for (size_t zPrio = 0; zPrio < BUSARB_PRIORITY_COUNT; ++zPrio) Contended += BenchArbiter.Stats[zPrio].Contended;
+  Failures += __Bench_Check(Contended > 0, "contended acquisitions (hand over through the queues)");
+  printf("Stress: %u clients, %u sequences and %u packets in %.0f ms\n", BENCH_CLIENT_COUNT, (unsigned)(BenchShared.Sequences + BenchShared.Failed), (unsigned)BenchShared.Packets, Time / 1e6);
+  __Bench_PrintStats("stress");
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_Uncontended();
+  printf("test          priority  acquired  contended  avg wait us  max wait us  max depth\n");
+  Failures += __Bench_Priority();
+  __Bench_PrintStats("priority");
+  Failures += __Bench_Stress();
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,118 @@
+/*!*****************************************************************************
+ * @file    EndianTransform_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Benchmark of the endian transform engine
+ * @details Host-only benchmark. It compares EndianTransform_Copy() and
+ *          EndianTransform_InPlace() against a byte-at-a-time reference (the
+ *          per-byte striding of the previous interface code) and checks the
+ *          results against it. Build and run from the repository root:
+ *            gcc -O2 -I. Bench/EndianTransform_Bench.c EndianTransform.c -o EndianBench
+ *          Add -mssse3 or -mavx2 (x86) to select the wider kernels
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "EndianTransform.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_BYTES_PER_RUN  ( 256u * 1024u * 1024u ) //!< Bytes transformed per measure
+
+static const size_t BENCH_SIZES[] = { 12, 48, 96, 384, 4092, 65532 }; //!< Buffer sizes, multiples of 2, 3 and 4
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Byte-at-a-time reference: copy with the source pointer striding over each block
+//=============================================================================
+static void __Bench_Reference(uint8_t* pDst, const uint8_t* pSrc, size_t size, size_t blockSize)
+{
+  const uint8_t* pData = pSrc + blockSize - 1;
+  size_t CurrentBlockPos = blockSize;
+  for (size_t zIdx = 0; zIdx < size; ++zIdx)
+  {
+    *pDst++ = *pData;
+    --CurrentBlockPos;
+    if (CurrentBlockPos == 0)
+    {
+      pData += (2 * blockSize) - 1;
+      CurrentBlockPos = blockSize;
+    }
+    else --pData;
+  }
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  const size_t MaxSize = BENCH_SIZES[sizeof(BENCH_SIZES) / sizeof(BENCH_SIZES[0]) - 1];
+  uint8_t* pSrc = (uint8_t*)malloc(MaxSize);
+  uint8_t* pDst = (uint8_t*)malloc(MaxSize);
+  uint8_t* pRef = (uint8_t*)malloc(MaxSize);
+  if ((pSrc == NULL) || (pDst == NULL) || (pRef == NULL)) return EXIT_FAILURE;
+  for (size_t zIdx = 0; zIdx < MaxSize; ++zIdx) pSrc[zIdx] = (uint8_t)(rand() & 0xFF);
+  volatile uint8_t Sink = 0;
+  int Failures = 0;
+
+  printf("block  size    reference MB/s  copy MB/s  in place MB/s\n");
+  for (size_t zBlock = 2; zBlock <= 4; ++zBlock)
+    for (size_t zSize = 0; zSize < (sizeof(BENCH_SIZES) / sizeof(BENCH_SIZES[0])); ++zSize)
+    {
+      const size_t Size = BENCH_SIZES[zSize];
+      const size_t Loops = BENCH_BYTES_PER_RUN / Size;
+      const eEndianTransform Transform = (eEndianTransform)zBlock;
+
+      //--- Check against the reference ---
+      __Bench_Reference(pRef, pSrc, Size, zBlock);
+      if ((EndianTransform_Copy(pDst, pSrc, Size, Transform) != ERR_NONE) || (memcmp(pDst, pRef, Size) != 0)) ++Failures;
+      memcpy(pDst, pSrc, Size);
+      if ((EndianTransform_InPlace(pDst, Size, Transform) != ERR_NONE) || (memcmp(pDst, pRef, Size) != 0)) ++Failures;
+
+      //--- Measures ---
+      double Start = __Bench_Now_ns();
+      for (size_t zLoop = 0; zLoop < Loops; ++zLoop) { __Bench_Reference(pDst, pSrc, Size, zBlock); Sink ^= pDst[zLoop % Size]; }
+      const double RefTime = __Bench_Now_ns() - Start;
+      Start = __Bench_Now_ns();
+      for (size_t zLoop = 0; zLoop < Loops; ++zLoop) { EndianTransform_Copy(pDst, pSrc, Size, Transform); Sink ^= pDst[zLoop % Size]; }
+      const double CopyTime = __Bench_Now_ns() - Start;
+      Start = __Bench_Now_ns();
+      for (size_t zLoop = 0; zLoop < Loops; ++zLoop) { EndianTransform_InPlace(pDst, Size, Transform); Sink ^= pDst[zLoop % Size]; }
+      const double InPlaceTime = __Bench_Now_ns() - Start;
+
+      const double Bytes = (double)Loops * (double)Size * 1e3; // Bytes per ns to MB/s
+      printf("%2u-bit %6u  %14.0f  %9.0f  %13.0f\n", (unsigned)(zBlock * 8), (unsigned)Size, Bytes / RefTime, Bytes / CopyTime, Bytes / InPlaceTime);
+    }
+
+  free(pSrc);
+  free(pDst);
+  free(pRef);
+  printf("%s (%d mismatch)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,98 @@
+/*!*****************************************************************************
+ * @file    Main.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Host stand-in of the STM32cubeIDE Main.h for the benchmarks
+ * @details Only the STM32 HAL types, defines and functions used by the SPI
+ * interface with USE_HAL_DRIVER. The HAL functions are implemented by the
+ * benchmark that includes this folder, to compile the STM32cubeIDE transfers of
+ * SPI_Interface.c on a host
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __BENCH_HAL_MAIN_H_INC
+#define __BENCH_HAL_MAIN_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! HAL status
+typedef enum
+{
+  HAL_OK      = 0x00,
+  HAL_ERROR   = 0x01,
+  HAL_BUSY    = 0x02,
+  HAL_TIMEOUT = 0x03,
+} HAL_StatusTypeDef;
+
+//! GPIO pin state
+typedef enum
+{
+  GPIO_PIN_RESET = 0,
+  GPIO_PIN_SET,
+} GPIO_PinState;
+
+//! GPIO port, only its identification
+typedef struct
+{
+  uint32_t ODR;
+} GPIO_TypeDef;
+
+//! SPI configuration, only the fields used by the SPI interface
+typedef struct
+{
+  uint32_t DataSize;
+  uint32_t CLKPolarity;
+  uint32_t CLKPhase;
+  uint32_t BaudRatePrescaler;
+  uint32_t FirstBit;
+} SPI_InitTypeDef;
+
+//! SPI handle
+typedef struct
+{
+  SPI_InitTypeDef Init;
+} SPI_HandleTypeDef;
+
+#define SPI_DATASIZE_8BIT          ( 0x00000700u )
+#define SPI_DATASIZE_16BIT         ( 0x00000F00u )
+#define SPI_POLARITY_LOW           ( 0x00000000u )
+#define SPI_POLARITY_HIGH          ( 0x00000002u )
+#define SPI_PHASE_1EDGE            ( 0x00000000u )
+#define SPI_PHASE_2EDGE            ( 0x00000001u )
+#define SPI_FIRSTBIT_MSB           ( 0x00000000u )
+#define SPI_FIRSTBIT_LSB           ( 0x00000080u )
+#define SPI_BAUDRATEPRESCALER_2    ( 0x00000000u )
+#define SPI_BAUDRATEPRESCALER_4    ( 0x00000008u )
+#define SPI_BAUDRATEPRESCALER_8    ( 0x00000010u )
+#define SPI_BAUDRATEPRESCALER_16   ( 0x00000018u )
+#define SPI_BAUDRATEPRESCALER_32   ( 0x00000020u )
+#define SPI_BAUDRATEPRESCALER_64   ( 0x00000028u )
+#define SPI_BAUDRATEPRESCALER_128  ( 0x00000030u )
+#define SPI_BAUDRATEPRESCALER_256  ( 0x00000038u )
+
+//-----------------------------------------------------------------------------
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi);
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+
+static inline void __disable_irq(void) { }
+static inline void __enable_irq(void) { }
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __BENCH_HAL_MAIN_H_INC */
@@ -0,0 +1,293 @@
+/*!*****************************************************************************
+ * @file    I2C_EEPROM_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the I2C EEPROM page write coalescing layer
+ * @details Host benchmark on the simulated I2C bus, with a 24xx32 like EEPROM
+ *          (32 bytes pages, 3 ms write cycle, 5 ms in the datasheet) and a
+ *          sensor on the same bus. The time of the layer is the time of the
+ *          simulated bus. It checks:
+ *          - A write is split on the page boundaries, the full pages are
+ *            written immediately and the last partial page stays in the page
+ *            buffer until the next write to another page or the flush
+ *          - The small writes that follow each other in a page are merged in
+ *            one page write, and a read gives the data of the page buffer
+ *          - The learned write cycle time converges to the one of the EEPROM,
+ *            then a write cycle needs a few acknowledge polls only
+ *          - The sensor can be read while a write cycle is in progress
+ *          - A write cycle longer than twice the datasheet time is a timeout
+ *          Then it gives the time, the acknowledge polls and the sensor reads
+ *          per page written, with a fixed datasheet delay after each page and
+ *          with the layer, with and without sensor reads in the yield
+ *          function. Build and run from the repository root:
+ *            gcc -O2 -I. Bench/I2C_EEPROM_Bench.c I2C_EEPROM.c I2C_SimBus.c I2C_Interface.c CRC.c EndianTransform.c -o I2CEEPROMBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "I2C_EEPROM.h"
+#include "I2C_SimBus.h"
+#include "I2C_Interface.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_SENSOR_ADDR    ( 0x90u )   //!< 8-bits address of the sensor
+#define BENCH_EEPROM_ADDR    ( 0xA0u )   //!< 8-bits address of the EEPROM
+#define BENCH_EEPROM_SIZE    ( 4096u )   //!< Memory size of the EEPROM
+#define BENCH_EEPROM_PAGE    ( 32u )     //!< Page size of the EEPROM
+#define BENCH_EEPROM_TWR_US  ( 3000u )   //!< Write cycle of the simulated EEPROM
+#define BENCH_DATASHEET_TWR  ( 5000u )   //!< Maximum write cycle of the datasheet
+#define BENCH_YIELD_US       ( 10u )     //!< Host time of a call of the yield function
+#define BENCH_PAGE_COUNT     ( 64u )     //!< Count of pages written per measure
+
+static uint8_t BenchSensorRegs[256];
+static uint8_t BenchEepromRegs[BENCH_EEPROM_SIZE];
+static uint8_t BenchPageBuffer[BENCH_EEPROM_PAGE];
+static I2C_SimDevice BenchDevices[2];
+static I2C_SimBus BenchBus;
+static I2C_Interface BenchI2C;
+static bool BenchReadSensor;      //!< Read the sensor in the yield function
+static uint32_t BenchSensorReads; //!< Count of sensor reads done
+static uint32_t BenchSensorFails; //!< Count of sensor reads failed
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Current time of the simulated bus in microseconds
+//=============================================================================
+static uint32_t __Bench_GetCurrentus(void)
+{
+  return (uint32_t)I2C_SimBus_GetTime_us(&BenchBus);
+}
+
+
+//=============================================================================
+// [STATIC] Read 2 registers of the sensor
+//=============================================================================
+static eERRORRESULT __Bench_ReadSensor(void)
+{
+  uint8_t Reg = 0x10, Rx[2];
+  I2CInterface_Packet Packets[2] =
+  {
+    I2C_INTERFACE8_TX_DATA_DESC(BENCH_SENSOR_ADDR, true, &Reg, 1, false, I2C_WRITE_THEN_READ_FIRST_PART),
+    I2C_INTERFACE8_RX_DATA_DESC(BENCH_SENSOR_ADDR, true, &Rx[0], 2, true, I2C_WRITE_THEN_READ_SECOND_PART),
+  };
+  const eERRORRESULT Error = Interface_I2CtransferBatch(&BenchI2C, Packets, 2, NULL);
+  if ((Error == ERR_NONE) && (Rx[0] == (0x10 ^ 0x5A)) && (Rx[1] == (0x11 ^ 0x5A))) BenchSensorReads++;
+  else BenchSensorFails++;
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Yield function of the EEPROM: the host works, and reads the sensor if asked
+//=============================================================================
+static void __Bench_Yield(void)
+{
+  I2C_SimBus_AdvanceTime(&BenchBus, BENCH_YIELD_US);
+  if (BenchReadSensor) (void)__Bench_ReadSensor();
+}
+
+
+//=============================================================================
+// [STATIC] Initialize the simulated bus, its devices and the EEPROM layer
+//=============================================================================
+static eERRORRESULT __Bench_Init(I2C_EEPROM* pEEPROM)
+{
+  memset(&BenchDevices[0], 0, sizeof(BenchDevices));
+  for (size_t zIdx = 0; zIdx < sizeof(BenchSensorRegs); ++zIdx) BenchSensorRegs[zIdx] = (uint8_t)(zIdx ^ 0x5A);
+  memset(&BenchEepromRegs[0], 0xFF, sizeof(BenchEepromRegs));
+  BenchDevices[0].ChipAddr          = BENCH_SENSOR_ADDR;
+  BenchDevices[0].RegAddrSize       = 1;
+  BenchDevices[0].pRegisters        = &BenchSensorRegs[0];
+  BenchDevices[0].RegisterCount     = sizeof(BenchSensorRegs);
+  BenchDevices[1].ChipAddr          = BENCH_EEPROM_ADDR;
+  BenchDevices[1].RegAddrSize       = 2;
+  BenchDevices[1].pRegisters        = &BenchEepromRegs[0];
+  BenchDevices[1].RegisterCount     = sizeof(BenchEepromRegs);
+  BenchDevices[1].PageSize          = BENCH_EEPROM_PAGE;
+  BenchDevices[1].WriteCycleTime_us = BENCH_EEPROM_TWR_US;
+  memset(&BenchBus, 0, sizeof(BenchBus));
+  BenchBus.pDevices    = &BenchDevices[0];
+  BenchBus.DeviceCount = sizeof(BenchDevices) / sizeof(BenchDevices[0]);
+  BenchReadSensor  = false;
+  BenchSensorReads = 0;
+  BenchSensorFails = 0;
+  eERRORRESULT Error = I2C_SimBus_Attach(&BenchI2C, &BenchBus);
+  if (Error == ERR_NONE) Error = BenchI2C.fnI2C_Init(&BenchI2C, 400000);
+  if (Error != ERR_NONE) return Error;
+  memset(pEEPROM, 0, sizeof(*pEEPROM));
+  pEEPROM->pI2C            = &BenchI2C;
+  pEEPROM->ChipAddr        = BENCH_EEPROM_ADDR;
+  pEEPROM->AddressSize     = 2;
+  pEEPROM->PageSize        = BENCH_EEPROM_PAGE;
+  pEEPROM->MemorySize      = BENCH_EEPROM_SIZE;
+  pEEPROM->MaxWriteTime_us = BENCH_DATASHEET_TWR;
+  pEEPROM->pPageBuffer     = &BenchPageBuffer[0];
+  pEEPROM->fnGetCurrentus  = __Bench_GetCurrentus;
+  pEEPROM->fnYield         = __Bench_Yield;
+  return I2C_EEPROM_Init(pEEPROM);
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Check the behavior of the EEPROM layer
+//=============================================================================
+static int __Bench_Checks(void)
+{
+  I2C_EEPROM EEPROM;
+  int Failures = 0;
+  uint8_t Data[128], Rx[128];
+  for (size_t zIdx = 0; zIdx < sizeof(Data); ++zIdx) Data[zIdx] = (uint8_t)(zIdx + 1);
+  if (__Bench_Init(&EEPROM) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+
+  //--- Split on the page boundaries ---
+  Failures += __Bench_Check(I2C_EEPROM_Write(&EEPROM, 0x010, &Data[0], 100) == ERR_NONE, "write of 100 bytes");
+  Failures += __Bench_Check(EEPROM.PageWriteCount == 3, "first partial page and 2 full pages written");
+  Failures += __Bench_Check((EEPROM.DirtyEnd - EEPROM.DirtyStart) == 20, "last partial page in the page buffer");
+  Failures += __Bench_Check(I2C_EEPROM_Read(&EEPROM, 0x010, &Rx[0], 100) == ERR_NONE, "read before the flush");
+  Failures += __Bench_Check(memcmp(&Rx[0], &Data[0], 100) == 0, "data of the page buffer given by the read");
+  Failures += __Bench_Check(BenchEepromRegs[0x060] == 0xFF, "page buffer not written yet");
+  Failures += __Bench_Check(I2C_EEPROM_Flush(&EEPROM) == ERR_NONE, "flush");
+  Failures += __Bench_Check(I2C_EEPROM_WaitReady(&EEPROM) == ERR_NONE, "end of the write cycle");
+  Failures += __Bench_Check((BenchDevices[1].WriteCycleCount == 4) && (memcmp(&BenchEepromRegs[0x010], &Data[0], 100) == 0), "4 page writes without page wrap");
+  Failures += __Bench_Check((BenchEepromRegs[0x00F] == 0xFF) && (BenchEepromRegs[0x074] == 0xFF), "bytes around the write untouched");
+
+  //--- Small writes merged ---
+  const uint32_t Cycles = BenchDevices[1].WriteCycleCount;
+  for (size_t zWrite = 0; zWrite < 8; ++zWrite)
+    Failures += __Bench_Check(I2C_EEPROM_Write(&EEPROM, 0x200 + (uint32_t)(zWrite * 4u), &Data[zWrite * 4u], 4) == ERR_NONE, "small write");
+  Failures += __Bench_Check(EEPROM.MergedWriteCount == 7, "small writes merged");
+  Failures += __Bench_Check(BenchDevices[1].WriteCycleCount == Cycles + 1, "one page write for 8 small writes");
+  Failures += __Bench_Check(memcmp(&BenchEepromRegs[0x200], &Data[0], 32) == 0, "data of the merged writes");
+  Failures += __Bench_Check(I2C_EEPROM_Write(&EEPROM, 0x11E, &Data[0], 4) == ERR_NONE, "write across a page boundary");
+  Failures += __Bench_Check(I2C_EEPROM_Flush(&EEPROM) == ERR_NONE, "flush across a page boundary");
+  Failures += __Bench_Check(I2C_EEPROM_WaitReady(&EEPROM) == ERR_NONE, "end of the write cycle across a page boundary");
+  Failures += __Bench_Check((memcmp(&BenchEepromRegs[0x11E], &Data[0], 4) == 0) && (BenchEepromRegs[0x100] == 0xFF), "write across a page boundary split");
+
+  //--- Learned write cycle time, from an initialization ---
+  uint32_t FirstPolls = 0, LastPolls = 0;
+  Failures += __Bench_Check((I2C_EEPROM_Init(&EEPROM) == ERR_NONE) && (EEPROM.WriteTime_us == 0), "write cycle time forgotten by the initialization");
+  for (uint32_t zPage = 0; zPage < 16; ++zPage)
+  {
+    const uint32_t Polls = EEPROM.PollCount;
+    Failures += __Bench_Check(I2C_EEPROM_Write(&EEPROM, 0x400 + (zPage * BENCH_EEPROM_PAGE), &Data[0], BENCH_EEPROM_PAGE) == ERR_NONE, "full page write");
+    Failures += __Bench_Check(I2C_EEPROM_WaitReady(&EEPROM) == ERR_NONE, "end of the full page write cycle");
+    if (zPage == 0) FirstPolls = EEPROM.PollCount - Polls;
+    LastPolls = EEPROM.PollCount - Polls;
+  }
+  Failures += __Bench_Check((EEPROM.WriteTime_us > (BENCH_EEPROM_TWR_US * 9u / 10u)) && (EEPROM.WriteTime_us < (BENCH_EEPROM_TWR_US * 11u / 10u)), "learned write cycle time");
+  Failures += __Bench_Check((FirstPolls > 4) && (LastPolls <= 4), "fewer acknowledge polls once the write cycle time is learned");
+  Failures += __Bench_Check(EEPROM.LastWriteTime_us < BENCH_DATASHEET_TWR, "end of write cycle found before the datasheet time");
+
+  //--- Sensor read during a write cycle ---
+  Failures += __Bench_Check(I2C_EEPROM_Write(&EEPROM, 0x600, &Data[0], BENCH_EEPROM_PAGE) == ERR_NONE, "page write before the sensor read");
+  Failures += __Bench_Check(EEPROM.WriteInProgress, "write returned without waiting for its write cycle");
+  Failures += __Bench_Check(__Bench_ReadSensor() == ERR_NONE, "sensor read during the write cycle");
+  Failures += __Bench_Check(EEPROM.WriteInProgress && (BenchDevices[1].BusyUntil_ns > (BenchBus.Time_ns)), "sensor read while the EEPROM is busy");
+  Failures += __Bench_Check(I2C_EEPROM_Read(&EEPROM, 0x600, &Rx[0], BENCH_EEPROM_PAGE) == ERR_NONE, "read after the write cycle");
+  Failures += __Bench_Check(memcmp(&Rx[0], &Data[0], BENCH_EEPROM_PAGE) == 0, "data after the write cycle");
+
+  //--- Write cycle timeout ---
+  BenchDevices[1].WriteCycleTime_us = 3u * BENCH_DATASHEET_TWR;
+  Failures += __Bench_Check(I2C_EEPROM_Write(&EEPROM, 0x700, &Data[0], BENCH_EEPROM_PAGE) == ERR_NONE, "page write of the timeout");
+  Failures += __Bench_Check(I2C_EEPROM_WaitReady(&EEPROM) == ERR__DEVICE_TIMEOUT, "write cycle timeout");
+  Failures += __Bench_Check(EEPROM.WriteInProgress == false, "no write cycle in progress after a timeout");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Write pages with a fixed datasheet delay after each one
+//=============================================================================
+static int __Bench_RunFixedDelay(void)
+{
+  I2C_EEPROM EEPROM;
+  uint8_t Page[2 + BENCH_EEPROM_PAGE];
+  if (__Bench_Init(&EEPROM) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  const uint64_t Start_us = I2C_SimBus_GetTime_us(&BenchBus);
+  int Failures = 0;
+  for (uint32_t zPage = 0; zPage < BENCH_PAGE_COUNT; ++zPage)
+  {
+    const uint32_t Address = zPage * BENCH_EEPROM_PAGE;
+    Page[0] = (uint8_t)(Address >> 8); Page[1] = (uint8_t)Address;
+    memset(&Page[2], (int)zPage, BENCH_EEPROM_PAGE);
+    I2CInterface_Packet Packet = I2C_INTERFACE8_TX_DATA_DESC(BENCH_EEPROM_ADDR, true, &Page[0], sizeof(Page), true, I2C_SIMPLE_TRANSFER);
+    if (BenchI2C.fnI2C_Transfer(&BenchI2C, &Packet) != ERR_NONE) ++Failures;
+    I2C_SimBus_AdvanceTime(&BenchBus, BENCH_DATASHEET_TWR); // Blind delay of the datasheet
+  }
+  const double Time_us = (double)(I2C_SimBus_GetTime_us(&BenchBus) - Start_us);
+  printf("%-20s  %9.1f  %10.2f  %12.2f\n", "fixed tWR delay", Time_us / BENCH_PAGE_COUNT, 0.0, 0.0);
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Write pages with the EEPROM layer
+//=============================================================================
+static int __Bench_RunLayer(bool readSensor)
+{
+  I2C_EEPROM EEPROM;
+  uint8_t Page[BENCH_EEPROM_PAGE], Rx[BENCH_EEPROM_PAGE];
+  if (__Bench_Init(&EEPROM) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  BenchReadSensor = readSensor;
+  const uint64_t Start_us = I2C_SimBus_GetTime_us(&BenchBus);
+  int Failures = 0;
+  for (uint32_t zPage = 0; zPage < BENCH_PAGE_COUNT; ++zPage)
+  {
+    memset(&Page[0], (int)zPage, BENCH_EEPROM_PAGE);
+    if (I2C_EEPROM_Write(&EEPROM, zPage * BENCH_EEPROM_PAGE, &Page[0], BENCH_EEPROM_PAGE) != ERR_NONE) ++Failures; // Waits for the previous write cycle
+  }
+  if (I2C_EEPROM_WaitReady(&EEPROM) != ERR_NONE) ++Failures;
+  const double Time_us = (double)(I2C_SimBus_GetTime_us(&BenchBus) - Start_us);
+  printf("%-20s  %9.1f  %10.2f  %12.2f\n", (readSensor ? "layer, sensor reads" : "layer"), Time_us / BENCH_PAGE_COUNT,
+         (double)EEPROM.PollCount / BENCH_PAGE_COUNT, (double)BenchSensorReads / BENCH_PAGE_COUNT);
+  BenchReadSensor = false;
+  for (uint32_t zPage = 0; zPage < BENCH_PAGE_COUNT; ++zPage)
+  {
+    if (I2C_EEPROM_Read(&EEPROM, zPage * BENCH_EEPROM_PAGE, &Rx[0], BENCH_EEPROM_PAGE) != ERR_NONE) ++Failures;
+    if ((Rx[0] != (uint8_t)zPage) || (Rx[BENCH_EEPROM_PAGE - 1] != (uint8_t)zPage)) ++Failures;
+  }
+  if (BenchSensorFails > 0) ++Failures;
+  if (Failures > 0) printf("Layer write failed (%d)\n", Failures);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_Checks();
+  printf("%u page writes of %u bytes at 400kHz, write cycle %uus, datasheet %uus\n", BENCH_PAGE_COUNT, BENCH_EEPROM_PAGE, BENCH_EEPROM_TWR_US, BENCH_DATASHEET_TWR);
+  printf("strategy              us/page  polls/page  sensor rd/pg\n");
+  Failures += __Bench_RunFixedDelay();
+  Failures += __Bench_RunLayer(false);
+  Failures += __Bench_RunLayer(true);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,259 @@
+/*!*****************************************************************************
+ * @file    I2C_LinuxDev_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the Linux i2c-dev backend through its ioctl shim
+ * @details Host-only benchmark (Linux). The ioctl() of the backend is replaced
+ *          by a shim that is a 256 bytes I2C memory with an address pointer
+ *          (the first byte written after a start sets the pointer, the other
+ *          bytes are written at the pointer, the reads are at the pointer).
+ *          It checks:
+ *          - A register read (write then read pair) is one I2C_RDWR with 2
+ *            messages
+ *          - The data of a read packet without stop are available at return,
+ *            and a read that continues it (Start = 'false') reads the next bytes
+ *          - A write continued by a packet without start, with and without
+ *            I2C_FUNC_NOSTART (merged in one message)
+ *          - A packet of more than 65535 bytes is rejected without ioctl
+ *          - The SMBus PEC of a register read, and a bad PEC
+ *          - A missing device (ENXIO) returns ERR__I2C_NACK_ADDR
+ *          Then it gives the ioctls, the messages and the host time per
+ *          register read, for the write then read pair and for a write with a
+ *          stop followed by a read. Build and run from the repository root:
+ *            gcc -O2 -I. Bench/I2C_LinuxDev_Bench.c I2C_LinuxDev.c I2C_Interface.c CRC.c EndianTransform.c -o I2CLinuxDevBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+#include "I2C_LinuxDev.h"
+#include "I2C_Interface.h"
+#include "CRC.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_CHIP_ADDR    ( 0xA0u )    //!< 8-bits address of the simulated memory
+#define BENCH_READ_SIZE    ( 2u )       //!< Size of a register
+#define BENCH_READ_COUNT   ( 200000u )  //!< Count of register reads per measure
+
+//! Simulated I2C memory behind the ioctl shim
+typedef struct BenchMemory
+{
+  unsigned long Functionality; //!< Functionalities returned by I2C_FUNCS
+  uint8_t Data[256];           //!< Content of the memory
+  uint8_t Pointer;             //!< Address pointer
+  bool BadPEC;                 //!< Corrupt the PEC of the next read
+} BenchMemory;
+
+static BenchMemory BenchMem;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] ioctl shim: I2C memory with an address pointer and SMBus PEC on the reads of 3 bytes
+//=============================================================================
+static int __Bench_Ioctl(int fd, unsigned long request, void* pArg)
+{
+  (void)fd;
+  if (request == I2C_FUNCS) { *(unsigned long*)pArg = BenchMem.Functionality; return 0; }
+  if (request != I2C_RDWR) { errno = ENOTTY; return -1; }
+  const struct i2c_rdwr_ioctl_data* pMsgSet = (const struct i2c_rdwr_ioctl_data*)pArg;
+  CRC_Context PEC;
+  (void)CRC_Init(&PEC, CRC8_SMBUS);
+  for (uint32_t zMsg = 0; zMsg < pMsgSet->nmsgs; ++zMsg)
+  {
+    const struct i2c_msg* pMsg = &pMsgSet->msgs[zMsg];
+    if (pMsg->addr != (BENCH_CHIP_ADDR >> 1)) { errno = ENXIO; return -1; }
+    const bool Read = ((pMsg->flags & I2C_M_RD) > 0);
+    if ((pMsg->flags & I2C_M_NOSTART) == 0)
+    {
+      const uint8_t AddrByte = (uint8_t)(BENCH_CHIP_ADDR | (Read ? 1u : 0u));
+      (void)CRC_Update(&PEC, &AddrByte, 1);
+    }
+    for (uint16_t zIdx = 0; zIdx < pMsg->len; ++zIdx)
+    {
+      if (Read)
+      {
+        if ((pMsg->len == 3u) && (zIdx == 2u)) pMsg->buf[zIdx] = (uint8_t)(CRC_GetValue(&PEC) ^ (BenchMem.BadPEC ? 0x01u : 0x00u)); // PEC after a register
+        else pMsg->buf[zIdx] = BenchMem.Data[BenchMem.Pointer++];
+      }
+      else if ((zIdx == 0) && ((pMsg->flags & I2C_M_NOSTART) == 0)) BenchMem.Pointer = pMsg->buf[0];
+      else BenchMem.Data[BenchMem.Pointer++] = pMsg->buf[zIdx];
+      (void)CRC_Update(&PEC, &pMsg->buf[zIdx], 1);
+    }
+  }
+  BenchMem.BadPEC = false;
+  return (int)pMsgSet->nmsgs;
+}
+
+
+//=============================================================================
+// [STATIC] Initialize the backend on the shim
+//=============================================================================
+static eERRORRESULT __Bench_Init(I2C_Interface* pI2C, I2C_LinuxDev* pDev, unsigned long functionality)
+{
+  memset(pDev, 0, sizeof(*pDev));
+  pDev->Fd      = 0;                                                             // Not used by the shim
+  pDev->fnIoctl = __Bench_Ioctl;
+  BenchMem.Functionality = functionality;
+  for (size_t zIdx = 0; zIdx < sizeof(BenchMem.Data); ++zIdx) BenchMem.Data[zIdx] = (uint8_t)(zIdx ^ 0x5A);
+  eERRORRESULT Error = I2C_LinuxDev_Attach(pI2C, pDev);
+  if (Error == ERR_NONE) Error = I2C_LinuxDev_Init(pI2C, 400000);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Check the behavior of the backend
+//=============================================================================
+static int __Bench_Checks(void)
+{
+  I2C_Interface I2C;
+  I2C_LinuxDev Dev;
+  int Failures = 0;
+  if (__Bench_Init(&I2C, &Dev, I2C_FUNC_I2C | I2C_FUNC_NOSTART) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+
+  //--- Register read: one ioctl with 2 messages ---
+  uint8_t Reg = 0x10, Rx[4];
+  I2CInterface_Packet WriteReg = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, true, &Reg, 1, false, I2C_WRITE_THEN_READ_FIRST_PART);
+  I2CInterface_Packet ReadReg  = I2C_INTERFACE8_RX_DATA_DESC(BENCH_CHIP_ADDR, true, &Rx[0], 2, true, I2C_WRITE_THEN_READ_SECOND_PART);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteReg) == ERR_NONE, "register write");
+  Failures += __Bench_Check(Dev.IoctlCount == 0, "the write waits for the read");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadReg) == ERR_NONE, "register read");
+  Failures += __Bench_Check((Dev.IoctlCount == 1) && (Dev.MessageCount == 2), "register read in one ioctl of 2 messages");
+  Failures += __Bench_Check((Rx[0] == (0x10 ^ 0x5A)) && (Rx[1] == (0x11 ^ 0x5A)), "register read data");
+
+  //--- Read without stop, its data are available at return, then continued without start ---
+  Reg = 0x20;
+  memset(&Rx[0], 0, sizeof(Rx));
+  I2CInterface_Packet ReadFirst = I2C_INTERFACE8_RX_DATA_DESC(BENCH_CHIP_ADDR, true, &Rx[0], 2, false, I2C_WRITE_THEN_READ_SECOND_PART);
+  I2CInterface_Packet ReadNext  = I2C_INTERFACE8_RX_DATA_DESC(BENCH_CHIP_ADDR, false, &Rx[2], 2, true, I2C_SIMPLE_TRANSFER);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteReg) == ERR_NONE, "register write before a read without stop");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadFirst) == ERR_NONE, "read without stop");
+  Failures += __Bench_Check((Rx[0] == (0x20 ^ 0x5A)) && (Rx[1] == (0x21 ^ 0x5A)), "data of a read without stop available at return");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadNext) == ERR_NONE, "read continued without start");
+  Failures += __Bench_Check((Rx[2] == (0x22 ^ 0x5A)) && (Rx[3] == (0x23 ^ 0x5A)), "data of the continued read");
+
+  //--- Write continued without start, with and without I2C_FUNC_NOSTART ---
+  for (int zNoStart = 1; zNoStart >= 0; --zNoStart)
+  {
+    if (__Bench_Init(&I2C, &Dev, I2C_FUNC_I2C | (zNoStart ? I2C_FUNC_NOSTART : 0)) != ERR_NONE) { printf("Initialization failed\n"); return Failures + 1; }
+    uint8_t Header[2] = { 0x40, 0xC1 }, Payload[3] = { 0xC2, 0xC3, 0xC4 };
+    I2CInterface_Packet WriteHeader  = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, true, &Header[0], 2, false, I2C_SIMPLE_TRANSFER);
+    I2CInterface_Packet WritePayload = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, false, &Payload[0], 3, true, I2C_SIMPLE_TRANSFER);
+    Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteHeader) == ERR_NONE, "write header");
+    Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WritePayload) == ERR_NONE, "write continued without start");
+    Failures += __Bench_Check((Dev.IoctlCount == 1) && (Dev.MessageCount == (zNoStart ? 2u : 1u)), "continued write in one ioctl");
+    Failures += __Bench_Check(memcmp(&BenchMem.Data[0x40], "\xC1\xC2\xC3\xC4", 4) == 0, "continued write data");
+  }
+
+  //--- Packet too large for an I2C message ---
+  static uint8_t Large[70000];
+  I2CInterface_Packet WriteLarge = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, true, &Large[0], sizeof(Large), true, I2C_SIMPLE_TRANSFER);
+  const uint32_t IoctlBefore = Dev.IoctlCount;
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteLarge) == ERR__BAD_DATA_SIZE, "packet of more than 65535 bytes rejected");
+  Failures += __Bench_Check(Dev.IoctlCount == IoctlBefore, "no ioctl for a rejected packet");
+
+  //--- SMBus PEC of a register read ---
+  for (int zBad = 0; zBad < 2; ++zBad)
+  {
+    CRC_Context PEC;
+    (void)CRC_Init(&PEC, CRC8_SMBUS);
+    Reg = 0x30;
+    BenchMem.BadPEC = (zBad > 0);
+    I2CInterface_Packet WritePEC = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, true, &Reg, 1, false, I2C_WRITE_THEN_READ_FIRST_PART);
+    I2CInterface_Packet ReadPEC  = I2C_INTERFACE8_RX_DATA_DESC(BENCH_CHIP_ADDR, true, &Rx[0], 3, true, I2C_WRITE_THEN_READ_SECOND_PART);
+    WritePEC.pCRC = &PEC;
+    ReadPEC.pCRC  = &PEC;
+    ReadPEC.Config.Value |= I2C_CHECK_CRC;
+    Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WritePEC) == ERR_NONE, "register write with PEC");
+    const eERRORRESULT Error = I2C.fnI2C_Transfer(&I2C, &ReadPEC);
+    Failures += __Bench_Check(Error == (zBad > 0 ? ERR__CRC_ERROR : ERR_NONE), (zBad > 0 ? "bad PEC detected" : "good PEC"));
+  }
+
+  //--- Missing device ---
+  I2CInterface_Packet Missing = I2C_INTERFACE8_RX_DATA_DESC(0x42, true, &Rx[0], 1, true, I2C_SIMPLE_TRANSFER);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &Missing) == ERR__I2C_NACK_ADDR, "missing device");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Measure the register reads, with the write then read pair or with a stop after the write
+//=============================================================================
+static int __Bench_Run(bool pair)
+{
+  I2C_Interface I2C;
+  I2C_LinuxDev Dev;
+  if (__Bench_Init(&I2C, &Dev, I2C_FUNC_I2C | I2C_FUNC_NOSTART) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  uint8_t Reg, Rx[BENCH_READ_SIZE];
+  I2CInterface_Packet WriteReg = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, true, &Reg, 1, (pair == false), I2C_WRITE_THEN_READ_FIRST_PART);
+  I2CInterface_Packet ReadReg  = I2C_INTERFACE8_RX_DATA_DESC(BENCH_CHIP_ADDR, true, &Rx[0], BENCH_READ_SIZE, true, I2C_WRITE_THEN_READ_SECOND_PART);
+  int Failures = 0;
+  const double Start = __Bench_Now_ns();
+  for (uint32_t zRead = 0; (zRead < BENCH_READ_COUNT) && (Failures == 0); ++zRead)
+  {
+    Reg = (uint8_t)(zRead * BENCH_READ_SIZE);
+    eERRORRESULT Error = I2C.fnI2C_Transfer(&I2C, &WriteReg);
+    if (Error == ERR_NONE) Error = I2C.fnI2C_Transfer(&I2C, &ReadReg);
+    if ((Error != ERR_NONE) || (Rx[0] != (uint8_t)(Reg ^ 0x5A)) || (Rx[1] != (uint8_t)((Reg + 1) ^ 0x5A)))
+    { printf("Register read %u failed (error %d)\n", (unsigned)zRead, (int)Error); ++Failures; }
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  printf("%-22s  %9.2f  %9.2f  %8.1f\n", (pair ? "write then read pair" : "write, stop, read"),
+         (double)Dev.IoctlCount / BENCH_READ_COUNT, (double)Dev.MessageCount / BENCH_READ_COUNT, Time / BENCH_READ_COUNT);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_Checks();
+  printf("%u register reads of %u bytes through the ioctl shim\n", BENCH_READ_COUNT, BENCH_READ_SIZE);
+  printf("sequence                ioctl/rd    msgs/rd  host ns/rd\n");
+  Failures += __Bench_Run(true);
+  Failures += __Bench_Run(false);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,286 @@
+/*!*****************************************************************************
+ * @file    I2C_RegisterCache_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the write-through I2C register cache
+ * @details Host-only benchmark. The register cache is put before a simulated
+ *          I2C bus with a device of 64 registers (1 byte register addresses),
+ *          the registers 0x30 to 0x3F are volatile. It checks:
+ *          - A read is transferred once, then served without bus transfer
+ *          - A write of an unchanged value is skipped, a changed value is
+ *            written through and the next read is served with it
+ *          - The volatile registers are always read on the bus
+ *          - The device registers changed behind the cache are seen only
+ *            after I2C_RegCache_Invalidate()
+ *          - A write that is not a register access and a packet with an endian
+ *            transform invalidate the registers concerned
+ *          - A failed write makes the registers dirty, I2C_RegCache_Sync()
+ *            writes them again in one write once the device answers
+ *          - The packets of a device not cached are not intercepted
+ *          Then it runs a driver loop (read of a configuration register, write
+ *          of the same configuration, read of a status register) with and
+ *          without the cache, and gives the bus transfers and the bus time per
+ *          loop. Build and run from the repository root:
+ *            gcc -O2 -I. Bench/I2C_RegisterCache_Bench.c I2C_RegisterCache.c I2C_SimBus.c I2C_Interface.c CRC.c EndianTransform.c -o I2CRegCacheBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "I2C_RegisterCache.h"
+#include "I2C_SimBus.h"
+#include "I2C_Interface.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_CHIP_ADDR       ( 0x90u )    //!< 8-bits address of the cached device
+#define BENCH_OTHER_ADDR      ( 0x92u )    //!< 8-bits address of a device not cached
+#define BENCH_MISSING_ADDR    ( 0x9Eu )    //!< Chip address given to the cached device while it is missing
+#define BENCH_REG_COUNT       ( 64u )      //!< Count of registers of the device
+#define BENCH_VOLATILE_FIRST  ( 0x30u )    //!< First volatile register
+#define BENCH_VOLATILE_LAST   ( 0x3Fu )    //!< Last volatile register
+#define BENCH_CONFIG_REG      ( 0x04u )    //!< Configuration register of the driver loop (2 bytes)
+#define BENCH_STATUS_REG      ( 0x30u )    //!< Status register of the driver loop (1 byte)
+#define BENCH_LOOP_COUNT      ( 10000u )   //!< Count of driver loops per measure
+
+static uint8_t BenchRegisters[BENCH_REG_COUNT];
+static uint8_t BenchOtherRegisters[BENCH_REG_COUNT];
+static I2C_SimDevice BenchDevices[2];
+static I2C_SimBus BenchBus;
+static I2C_Interface BenchBusI2C;
+
+static uint8_t BenchShadow[BENCH_REG_COUNT];
+static uint32_t BenchVolatileMap[I2C_REGCACHE_BITMAP_SIZE(BENCH_REG_COUNT)];
+static uint32_t BenchValidMap[I2C_REGCACHE_BITMAP_SIZE(BENCH_REG_COUNT)];
+static uint32_t BenchDirtyMap[I2C_REGCACHE_BITMAP_SIZE(BENCH_REG_COUNT)];
+static I2C_RegCacheDevice BenchCacheDevice;
+static I2C_RegCache BenchCache;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Initialize the simulated bus, and the register cache if used
+//=============================================================================
+static eERRORRESULT __Bench_Init(I2C_Interface* pI2C, bool useCache)
+{
+  for (size_t zIdx = 0; zIdx < BENCH_REG_COUNT; ++zIdx) { BenchRegisters[zIdx] = (uint8_t)(zIdx ^ 0x5A); BenchOtherRegisters[zIdx] = (uint8_t)zIdx; }
+  memset(&BenchDevices[0], 0, sizeof(BenchDevices));
+  BenchDevices[0].ChipAddr      = BENCH_CHIP_ADDR;
+  BenchDevices[0].RegAddrSize   = 1;
+  BenchDevices[0].pRegisters    = &BenchRegisters[0];
+  BenchDevices[0].RegisterCount = BENCH_REG_COUNT;
+  BenchDevices[1].ChipAddr      = BENCH_OTHER_ADDR;
+  BenchDevices[1].RegAddrSize   = 1;
+  BenchDevices[1].pRegisters    = &BenchOtherRegisters[0];
+  BenchDevices[1].RegisterCount = BENCH_REG_COUNT;
+  memset(&BenchBus, 0, sizeof(BenchBus));
+  BenchBus.pDevices    = &BenchDevices[0];
+  BenchBus.DeviceCount = sizeof(BenchDevices) / sizeof(BenchDevices[0]);
+  eERRORRESULT Error = I2C_SimBus_Attach(&BenchBusI2C, &BenchBus);
+  if (Error != ERR_NONE) return Error;
+  if (useCache == false)
+  {
+    *pI2C = BenchBusI2C;
+    return pI2C->fnI2C_Init(pI2C, 400000);
+  }
+
+  memset(&BenchVolatileMap[0], 0, sizeof(BenchVolatileMap));
+  for (uint32_t zReg = BENCH_VOLATILE_FIRST; zReg <= BENCH_VOLATILE_LAST; ++zReg) BenchVolatileMap[zReg >> 5] |= (1u << (zReg & 0x1Fu));
+  memset(&BenchCacheDevice, 0, sizeof(BenchCacheDevice));
+  BenchCacheDevice.ChipAddr      = BENCH_CHIP_ADDR;
+  BenchCacheDevice.RegAddrSize   = 1;
+  BenchCacheDevice.RegisterCount = BENCH_REG_COUNT;
+  BenchCacheDevice.pShadow       = &BenchShadow[0];
+  BenchCacheDevice.pVolatileMap  = &BenchVolatileMap[0];
+  BenchCacheDevice.pValidMap     = &BenchValidMap[0];
+  BenchCacheDevice.pDirtyMap     = &BenchDirtyMap[0];
+  memset(&BenchCache, 0, sizeof(BenchCache));
+  BenchCache.pDevices    = &BenchCacheDevice;
+  BenchCache.DeviceCount = 1;
+  Error = I2C_RegCache_Attach(pI2C, &BenchCache, &BenchBusI2C);
+  if (Error == ERR_NONE) Error = pI2C->fnI2C_Init(pI2C, 400000);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Read registers of a device (write then read with restart)
+//=============================================================================
+static eERRORRESULT __Bench_ReadReg(I2C_Interface* pI2C, uint16_t chipAddr, uint8_t reg, uint8_t* pData, size_t size)
+{
+  I2CInterface_Packet WriteReg = I2C_INTERFACE8_TX_DATA_DESC(chipAddr, true, &reg, 1, false, I2C_WRITE_THEN_READ_FIRST_PART);
+  I2CInterface_Packet ReadReg  = I2C_INTERFACE8_RX_DATA_DESC(chipAddr, true, pData, size, true, I2C_WRITE_THEN_READ_SECOND_PART);
+  eERRORRESULT Error = pI2C->fnI2C_Transfer(pI2C, &WriteReg);
+  if (Error == ERR_NONE) Error = pI2C->fnI2C_Transfer(pI2C, &ReadReg);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Write registers of a device (register address and data in the same packet)
+//=============================================================================
+static eERRORRESULT __Bench_WriteReg(I2C_Interface* pI2C, uint16_t chipAddr, uint8_t reg, const uint8_t* pData, size_t size)
+{
+  uint8_t Buffer[1 + 8];
+  if (size > 8) return ERR__BAD_DATA_SIZE;
+  Buffer[0] = reg;
+  memcpy(&Buffer[1], pData, size);
+  I2CInterface_Packet Write = I2C_INTERFACE8_TX_DATA_DESC(chipAddr, true, &Buffer[0], 1 + size, true, I2C_SIMPLE_TRANSFER);
+  return pI2C->fnI2C_Transfer(pI2C, &Write);
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Check the behavior of the register cache
+//=============================================================================
+static int __Bench_Checks(void)
+{
+  I2C_Interface I2C;
+  int Failures = 0;
+  if (__Bench_Init(&I2C, true) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  uint8_t Rx[4];
+  uint32_t Starts;
+
+  //--- Read transferred once then served by the cache ---
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x08, &Rx[0], 2) == ERR_NONE, "first read");
+  Failures += __Bench_Check((Rx[0] == (0x08 ^ 0x5A)) && (Rx[1] == (0x09 ^ 0x5A)) && (BenchCache.ReadMisses == 1), "first read on the bus");
+  Failures += __Bench_Check((BenchBus.StartCount == 2) && (BenchBus.StopCount == 1), "register address and read in one sequence");
+  Starts = BenchBus.StartCount;
+  memset(&Rx[0], 0, sizeof(Rx));
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x08, &Rx[0], 2) == ERR_NONE, "second read");
+  Failures += __Bench_Check((Rx[0] == (0x08 ^ 0x5A)) && (Rx[1] == (0x09 ^ 0x5A)) && (BenchCache.ReadHits == 1), "second read served by the cache");
+  Failures += __Bench_Check((BenchBus.StartCount == Starts) && (BenchBus.BusBusy == false), "no bus transfer for a cache hit");
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x09, &Rx[0], 2) == ERR_NONE, "read overlapping a cached register");
+  Failures += __Bench_Check((Rx[1] == (0x0A ^ 0x5A)) && (BenchCache.ReadMisses == 2), "read with a register not cached on the bus");
+
+  //--- Write of an unchanged value skipped, changed value written through ---
+  const uint8_t Same[2] = { (0x08 ^ 0x5A), (0x09 ^ 0x5A) }, Changed[2] = { 0xC1, (0x09 ^ 0x5A) };
+  Starts = BenchBus.StartCount;
+  Failures += __Bench_Check(__Bench_WriteReg(&I2C, BENCH_CHIP_ADDR, 0x08, &Same[0], 2) == ERR_NONE, "write of unchanged values");
+  Failures += __Bench_Check((BenchBus.StartCount == Starts) && (BenchCache.WritesSkipped == 1), "write of unchanged values skipped");
+  Failures += __Bench_Check(__Bench_WriteReg(&I2C, BENCH_CHIP_ADDR, 0x08, &Changed[0], 2) == ERR_NONE, "write of changed values");
+  Failures += __Bench_Check((BenchRegisters[0x08] == 0xC1) && (BenchCache.WritesThrough == 1), "changed values written through");
+  Starts = BenchBus.StartCount;
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x08, &Rx[0], 1) == ERR_NONE, "read after the write");
+  Failures += __Bench_Check((Rx[0] == 0xC1) && (BenchBus.StartCount == Starts), "written value served by the cache");
+
+  //--- Volatile registers always on the bus ---
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, BENCH_STATUS_REG, &Rx[0], 1) == ERR_NONE, "first status read");
+  BenchRegisters[BENCH_STATUS_REG] = 0xE7;                                      // The device changes its status
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, BENCH_STATUS_REG, &Rx[0], 1) == ERR_NONE, "second status read");
+  Failures += __Bench_Check(Rx[0] == 0xE7, "volatile register read on the bus");
+
+  //--- Device registers changed behind the cache (device reset) ---
+  BenchRegisters[0x08] = 0x00;
+  Failures += __Bench_Check((__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x08, &Rx[0], 1) == ERR_NONE) && (Rx[0] == 0xC1), "stale value served before the invalidation");
+  Failures += __Bench_Check(I2C_RegCache_Invalidate(&BenchCache, BENCH_CHIP_ADDR) == ERR_NONE, "invalidation");
+  Failures += __Bench_Check((__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x08, &Rx[0], 1) == ERR_NONE) && (Rx[0] == 0x00), "device value read after the invalidation");
+  Failures += __Bench_Check(I2C_RegCache_Invalidate(&BenchCache, BENCH_OTHER_ADDR) == ERR__UNKNOWN_DEVICE, "invalidation of a device not cached");
+
+  //--- Write that is not a register access invalidates the device ---
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x10, &Rx[0], 1) == ERR_NONE, "read before a command write");
+  uint8_t Command = 0x20;
+  I2CInterface_Packet WriteCommand = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, true, &Command, 1, true, I2C_SIMPLE_TRANSFER);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteCommand) == ERR_NONE, "command write");
+  Starts = BenchBus.StartCount;
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x10, &Rx[0], 1) == ERR_NONE, "read after a command write");
+  Failures += __Bench_Check(BenchBus.StartCount == (Starts + 2), "registers invalidated by a write that is not a register access");
+
+  //--- Endian transform invalidates the range ---
+  const uint8_t Reg16 = 0x12;
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, Reg16, &Rx[0], 2) == ERR_NONE, "read before an endian transform read");
+  I2CInterface_Packet WriteSwap = I2C_INTERFACE8_TX_DATA_DESC(BENCH_CHIP_ADDR, true, (uint8_t*)&Reg16, 1, false, I2C_WRITE_THEN_READ_FIRST_PART);
+  I2CInterface_Packet ReadSwap  = I2C_INTERFACE8_RX_DATA_DESC(BENCH_CHIP_ADDR, true, &Rx[0], 2, true, I2C_WRITE_THEN_READ_SECOND_PART);
+  ReadSwap.Config.Value = (ReadSwap.Config.Value & ~I2C_ENDIAN_TRANSFORM_Mask) | I2C_ENDIAN_TRANSFORM_SET(I2C_SWITCH_ENDIAN_16BITS);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteSwap) == ERR_NONE, "register address of an endian transform read");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadSwap) == ERR_NONE, "endian transform read");
+  Starts = BenchBus.StartCount;
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, Reg16, &Rx[0], 2) == ERR_NONE, "read after an endian transform read");
+  Failures += __Bench_Check(BenchBus.StartCount == (Starts + 2), "registers invalidated by an endian transform");
+
+  //--- Failed write: dirty registers, then sync ---
+  const uint8_t Config[3] = { 0x11, 0x22, 0x33 };
+  Failures += __Bench_Check(__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x20, &Rx[0], 3) == ERR_NONE, "read before a failed write");
+  BenchDevices[0].ChipAddr = BENCH_MISSING_ADDR;                                // The device does not answer
+  Failures += __Bench_Check(__Bench_WriteReg(&I2C, BENCH_CHIP_ADDR, 0x20, &Config[0], 3) == ERR__I2C_NACK_ADDR, "failed write");
+  Failures += __Bench_Check((BenchDirtyMap[0x20 >> 5] & 0x7u) == 0x7u, "registers of a failed write dirty");
+  Failures += __Bench_Check(I2C_RegCache_Sync(&BenchCache, BENCH_CHIP_ADDR) == ERR__I2C_NACK_ADDR, "sync while the device does not answer");
+  BenchDevices[0].ChipAddr = BENCH_CHIP_ADDR;
+  Starts = BenchBus.StartCount;
+  Failures += __Bench_Check(I2C_RegCache_Sync(&BenchCache, BENCH_CHIP_ADDR) == ERR_NONE, "sync");
+  Failures += __Bench_Check((BenchBus.StartCount == (Starts + 1)) && (memcmp(&BenchRegisters[0x20], &Config[0], 3) == 0), "dirty registers written in one write");
+  Failures += __Bench_Check((BenchDirtyMap[0] == 0) && (BenchDirtyMap[1] == 0), "no dirty registers after the sync");
+  Starts = BenchBus.StartCount;
+  Failures += __Bench_Check((__Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, 0x20, &Rx[0], 3) == ERR_NONE) && (memcmp(&Rx[0], &Config[0], 3) == 0), "read after the sync");
+  Failures += __Bench_Check(BenchBus.StartCount == Starts, "synced registers served by the cache");
+
+  //--- Device not cached ---
+  BenchOtherRegisters[0x05] = 0x99;
+  Failures += __Bench_Check((__Bench_ReadReg(&I2C, BENCH_OTHER_ADDR, 0x05, &Rx[0], 1) == ERR_NONE) && (Rx[0] == 0x99), "read of a device not cached");
+  BenchOtherRegisters[0x05] = 0x66;
+  Failures += __Bench_Check((__Bench_ReadReg(&I2C, BENCH_OTHER_ADDR, 0x05, &Rx[0], 1) == ERR_NONE) && (Rx[0] == 0x66), "device not cached always read on the bus");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Run the driver loop with or without the cache
+//=============================================================================
+static int __Bench_Run(bool useCache)
+{
+  I2C_Interface I2C;
+  if (__Bench_Init(&I2C, useCache) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  int Failures = 0;
+  uint8_t Config[2], Status;
+  for (uint32_t zLoop = 0; (zLoop < BENCH_LOOP_COUNT) && (Failures == 0); ++zLoop)
+  {
+    BenchRegisters[BENCH_STATUS_REG] = (uint8_t)zLoop;                          // The device updates its status
+    eERRORRESULT Error = __Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, BENCH_CONFIG_REG, &Config[0], 2);
+    if (Error == ERR_NONE) Error = __Bench_WriteReg(&I2C, BENCH_CHIP_ADDR, BENCH_CONFIG_REG, &Config[0], 2); // Read-modify-write that does not change the value
+    if (Error == ERR_NONE) Error = __Bench_ReadReg(&I2C, BENCH_CHIP_ADDR, BENCH_STATUS_REG, &Status, 1);
+    if ((Error != ERR_NONE) || (Config[0] != (BENCH_CONFIG_REG ^ 0x5A)) || (Status != (uint8_t)zLoop))
+    { printf("Loop %u failed (error %d)\n", (unsigned)zLoop, (int)Error); ++Failures; }
+  }
+  printf("%-13s  %9.2f  %12.1f  %9u  %9u  %7u\n", (useCache ? "with cache" : "without cache"),
+         (double)BenchBus.StartCount / BENCH_LOOP_COUNT, (double)I2C_SimBus_GetBusTime_us(&BenchBus) / BENCH_LOOP_COUNT,
+         (unsigned)BenchCache.ReadHits, (unsigned)BenchCache.ReadMisses, (unsigned)BenchCache.WritesSkipped);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_Checks();
+  printf("%u driver loops at 400 kHz: config read, config write (same value), status read\n", BENCH_LOOP_COUNT);
+  printf("interface      starts/lp  bus us/loop  read hits  read miss  skipped\n");
+  memset(&BenchCache, 0, sizeof(BenchCache));
+  Failures += __Bench_Run(false);
+  Failures += __Bench_Run(true);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
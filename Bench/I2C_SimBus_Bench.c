@@ -0,0 +1,236 @@
+/*!*****************************************************************************
+ * @file    I2C_SimBus_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the simulated I2C bus
+ * @details Host-only benchmark. The simulated bus has a 8-bits device with 1
+ *          byte register addresses, a 10-bits device with 2 bytes register
+ *          addresses and clock stretching, and an EEPROM with pages and a write
+ *          cycle. It checks:
+ *          - A register read (write then read with restart) and its SCL cycles
+ *          - The auto-increment of the register pointer between the transfers,
+ *            and a read continued without start
+ *          - A change of direction without restart is rejected
+ *          - An unknown chip address is not acknowledged and releases the bus
+ *          - The 10-bits addressing (read after restart with only the first
+ *            address byte) and the clock stretching cycles
+ *          - The page wrap around of the EEPROM writes, and the acknowledge
+ *            polling during and after the write cycle
+ *          Then it gives the effective throughput and the bus time of the
+ *          register reads for some SCL frequencies and read sizes. Build and
+ *          run from the repository root:
+ *            gcc -O2 -I. Bench/I2C_SimBus_Bench.c I2C_SimBus.c I2C_Interface.c CRC.c EndianTransform.c -o I2CSimBusBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "I2C_SimBus.h"
+#include "I2C_Interface.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_SENSOR_ADDR    ( 0x90u )         //!< 8-bits address of the device with 1 byte register addresses
+#define BENCH_WIDE_ADDR      ( 0x2D3u << 1 )   //!< 10-bits address of the device with 2 bytes register addresses
+#define BENCH_EEPROM_ADDR    ( 0xA0u )         //!< 8-bits address of the EEPROM
+#define BENCH_WIDE_STRETCH   ( 2u )            //!< Clock stretching of the 10-bits device after each byte
+#define BENCH_EEPROM_PAGE    ( 32u )           //!< Page size of the EEPROM
+#define BENCH_EEPROM_TWR_US  ( 5000u )         //!< Write cycle of the EEPROM
+#define BENCH_READ_COUNT     ( 1000u )         //!< Count of register reads per measure
+
+static const uint32_t BENCH_SCL_FREQS[] = { 100000, 400000, 1000000 }; //!< SCL frequencies measured
+static const size_t BENCH_READ_SIZES[]  = { 1, 16, 128 };              //!< Register read sizes measured
+
+static uint8_t BenchSensorRegs[256];
+static uint8_t BenchWideRegs[1024];
+static uint8_t BenchEepromRegs[4096];
+static I2C_SimDevice BenchDevices[3];
+static I2C_SimBus BenchBus;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Initialize the simulated bus and its devices
+//=============================================================================
+static eERRORRESULT __Bench_Init(I2C_Interface* pI2C, uint32_t sclFreq)
+{
+  memset(&BenchDevices[0], 0, sizeof(BenchDevices));
+  for (size_t zIdx = 0; zIdx < sizeof(BenchSensorRegs); ++zIdx) BenchSensorRegs[zIdx] = (uint8_t)(zIdx ^ 0x5A);
+  for (size_t zIdx = 0; zIdx < sizeof(BenchWideRegs); ++zIdx) BenchWideRegs[zIdx] = (uint8_t)((zIdx >> 2) ^ zIdx);
+  memset(&BenchEepromRegs[0], 0xFF, sizeof(BenchEepromRegs));
+  BenchDevices[0].ChipAddr          = BENCH_SENSOR_ADDR;
+  BenchDevices[0].RegAddrSize       = 1;
+  BenchDevices[0].pRegisters        = &BenchSensorRegs[0];
+  BenchDevices[0].RegisterCount     = sizeof(BenchSensorRegs);
+  BenchDevices[1].ChipAddr          = BENCH_WIDE_ADDR;
+  BenchDevices[1].Addr10bits        = true;
+  BenchDevices[1].RegAddrSize       = 2;
+  BenchDevices[1].pRegisters        = &BenchWideRegs[0];
+  BenchDevices[1].RegisterCount     = sizeof(BenchWideRegs);
+  BenchDevices[1].StretchCycles     = BENCH_WIDE_STRETCH;
+  BenchDevices[2].ChipAddr          = BENCH_EEPROM_ADDR;
+  BenchDevices[2].RegAddrSize       = 2;
+  BenchDevices[2].pRegisters        = &BenchEepromRegs[0];
+  BenchDevices[2].RegisterCount     = sizeof(BenchEepromRegs);
+  BenchDevices[2].PageSize          = BENCH_EEPROM_PAGE;
+  BenchDevices[2].WriteCycleTime_us = BENCH_EEPROM_TWR_US;
+  memset(&BenchBus, 0, sizeof(BenchBus));
+  BenchBus.pDevices    = &BenchDevices[0];
+  BenchBus.DeviceCount = sizeof(BenchDevices) / sizeof(BenchDevices[0]);
+  eERRORRESULT Error = I2C_SimBus_Attach(pI2C, &BenchBus);
+  if (Error == ERR_NONE) Error = pI2C->fnI2C_Init(pI2C, sclFreq);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Check the behavior of the simulated bus
+//=============================================================================
+static int __Bench_Checks(void)
+{
+  I2C_Interface I2C;
+  int Failures = 0;
+  if (__Bench_Init(&I2C, 400000) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+
+  //--- Register read with restart ---
+  uint8_t Reg[2] = { 0x10, 0x00 }, Rx[8];
+  I2CInterface_Packet WriteReg = I2C_INTERFACE8_TX_DATA_DESC(BENCH_SENSOR_ADDR, true, &Reg[0], 1, false, I2C_WRITE_THEN_READ_FIRST_PART);
+  I2CInterface_Packet ReadReg  = I2C_INTERFACE8_RX_DATA_DESC(BENCH_SENSOR_ADDR, true, &Rx[0], 4, true, I2C_WRITE_THEN_READ_SECOND_PART);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteReg) == ERR_NONE, "register address write");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadReg) == ERR_NONE, "register read after restart");
+  Failures += __Bench_Check((Rx[0] == (0x10 ^ 0x5A)) && (Rx[3] == (0x13 ^ 0x5A)), "register read data");
+  Failures += __Bench_Check((BenchBus.StartCount == 2) && (BenchBus.StopCount == 1), "one start, one restart and one stop");
+  Failures += __Bench_Check(BenchBus.SCLcycles == (2 * I2C_SIMBUS_START_CYCLES) + ((1 + 1 + 1 + 4) * I2C_SIMBUS_BYTE_CYCLES) + I2C_SIMBUS_STOP_CYCLES, "SCL cycles of a register read");
+  Failures += __Bench_Check(BenchBus.DataBytes == 5, "data bytes without the chip address bytes");
+
+  //--- Auto-increment between the transfers, read continued without start ---
+  I2CInterface_Packet ReadFirst = I2C_INTERFACE8_RX_DATA_DESC(BENCH_SENSOR_ADDR, true, &Rx[0], 2, false, I2C_SIMPLE_TRANSFER);
+  I2CInterface_Packet ReadNext  = I2C_INTERFACE8_RX_DATA_DESC(BENCH_SENSOR_ADDR, false, &Rx[2], 2, false, I2C_SIMPLE_TRANSFER);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadFirst) == ERR_NONE, "read without register address");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadNext) == ERR_NONE, "read continued without start");
+  Failures += __Bench_Check((Rx[0] == (0x14 ^ 0x5A)) && (Rx[3] == (0x17 ^ 0x5A)), "register pointer auto-incremented");
+
+  //--- Change of direction without restart, then release the bus ---
+  I2CInterface_Packet WriteNoStart = I2C_INTERFACE8_TX_DATA_DESC(BENCH_SENSOR_ADDR, false, &Reg[0], 1, true, I2C_SIMPLE_TRANSFER);
+  I2CInterface_Packet ReadStop     = I2C_INTERFACE8_RX_DATA_DESC(BENCH_SENSOR_ADDR, false, NULL, 0, true, I2C_SIMPLE_TRANSFER);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteNoStart) == ERR__I2C_INVALID_COMMAND, "change of direction without restart rejected");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadStop) == ERR_NONE, "stop of the read");
+  Failures += __Bench_Check(BenchBus.BusBusy == false, "bus released by the stop");
+
+  //--- Unknown chip address ---
+  I2C_SimBus_ResetStats(&BenchBus);
+  I2CInterface_Packet Unknown = I2C_INTERFACE8_RX_DATA_DESC(0x42, true, &Rx[0], 1, true, I2C_SIMPLE_TRANSFER);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &Unknown) == ERR__I2C_NACK_ADDR, "unknown chip address not acknowledged");
+  Failures += __Bench_Check((BenchBus.NackCount == 1) && (BenchBus.StopCount == 1) && (BenchBus.BusBusy == false), "bus released after the NACK");
+  I2CInterface_Packet Not8bits = I2C_INTERFACE8_RX_DATA_DESC(BENCH_WIDE_ADDR & I2C_ONLY_ADDR8_Mask, true, &Rx[0], 1, true, I2C_SIMPLE_TRANSFER);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &Not8bits) == ERR__I2C_NACK_ADDR, "10-bits device not addressed by a 8-bits address");
+
+  //--- 10-bits addressing with clock stretching ---
+  I2C_SimBus_ResetStats(&BenchBus);
+  uint8_t WideWrite[4] = { 0x01, 0x23, 0xA5, 0xC3 };
+  I2CInterface_Packet WriteWide   = I2C_INTERFACE8_TX_DATA_DESC(BENCH_WIDE_ADDR, true, &WideWrite[0], 4, true, I2C_SIMPLE_TRANSFER);
+  I2CInterface_Packet WriteWideRg = I2C_INTERFACE8_TX_DATA_DESC(BENCH_WIDE_ADDR, true, &WideWrite[0], 2, false, I2C_WRITE_THEN_READ_FIRST_PART);
+  I2CInterface_Packet ReadWide    = I2C_INTERFACE8_RX_DATA_DESC(BENCH_WIDE_ADDR, true, &Rx[0], 3, true, I2C_WRITE_THEN_READ_SECOND_PART);
+  WriteWide.Config.Value   |= I2C_USE_10BITS_ADDRESS;
+  WriteWideRg.Config.Value |= I2C_USE_10BITS_ADDRESS;
+  ReadWide.Config.Value    |= I2C_USE_10BITS_ADDRESS;
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteWide) == ERR_NONE, "10-bits register write");
+  Failures += __Bench_Check((BenchWideRegs[0x123] == 0xA5) && (BenchWideRegs[0x124] == 0xC3), "10-bits register write data");
+  I2C_SimBus_ResetStats(&BenchBus);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteWideRg) == ERR_NONE, "10-bits register address write");
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &ReadWide) == ERR_NONE, "10-bits register read after restart");
+  Failures += __Bench_Check((Rx[0] == 0xA5) && (Rx[1] == 0xC3) && (Rx[2] == BenchWideRegs[0x125]), "10-bits register read data");
+  Failures += __Bench_Check(BenchBus.StretchCycles == (5 * BENCH_WIDE_STRETCH), "clock stretching after each data byte");
+  Failures += __Bench_Check(BenchBus.SCLcycles == (2 * I2C_SIMBUS_START_CYCLES) + ((2 + 2 + 1 + 3) * I2C_SIMBUS_BYTE_CYCLES) + (5 * BENCH_WIDE_STRETCH) + I2C_SIMBUS_STOP_CYCLES,
+                            "SCL cycles of a 10-bits register read (1 address byte after the restart)");
+
+  //--- EEPROM page wrap around and write cycle ---
+  uint8_t EepromWrite[2 + 40];
+  EepromWrite[0] = 0x01;
+  EepromWrite[1] = 0x10;                                                         // 16 bytes before the end of the page 0x0100
+  for (size_t zIdx = 0; zIdx < 40; ++zIdx) EepromWrite[2 + zIdx] = (uint8_t)(0x80 + zIdx);
+  I2CInterface_Packet WriteEeprom = I2C_INTERFACE8_TX_DATA_DESC(BENCH_EEPROM_ADDR, true, &EepromWrite[0], sizeof(EepromWrite), true, I2C_SIMPLE_TRANSFER);
+  I2CInterface_Packet Probe       = I2C_INTERFACE8_NO_DATA_DESC(BENCH_EEPROM_ADDR);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &WriteEeprom) == ERR_NONE, "EEPROM write");
+  Failures += __Bench_Check((BenchEepromRegs[0x118] == 0x88) && (BenchEepromRegs[0x11F] == 0x8F), "EEPROM write up to the end of the page");
+  Failures += __Bench_Check((BenchEepromRegs[0x100] == 0x90) && (BenchEepromRegs[0x110] == 0xA0) && (BenchEepromRegs[0x120] == 0xFF), "EEPROM write wraps around in the page"); // The last bytes overwrite the first ones
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &Probe) == ERR__I2C_NACK_ADDR, "EEPROM not acknowledged during the write cycle");
+  I2C_SimBus_AdvanceTime(&BenchBus, BENCH_EEPROM_TWR_US);
+  Failures += __Bench_Check(I2C.fnI2C_Transfer(&I2C, &Probe) == ERR_NONE, "EEPROM acknowledged after the write cycle");
+  Failures += __Bench_Check(BenchDevices[2].WriteCycleCount == 1, "one write cycle, the probes do not start one");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Measure the register reads of a device at a SCL frequency
+//=============================================================================
+static int __Bench_Run(bool wide, uint32_t sclFreq, size_t readSize)
+{
+  I2C_Interface I2C;
+  if (__Bench_Init(&I2C, sclFreq) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  const uint8_t* pRegs = (wide ? &BenchWideRegs[0] : &BenchSensorRegs[0]);
+  const size_t RegCount = (wide ? sizeof(BenchWideRegs) : sizeof(BenchSensorRegs));
+  uint8_t Reg[2], Rx[128];
+  I2CInterface_Packet WriteReg = I2C_INTERFACE8_TX_DATA_DESC((wide ? BENCH_WIDE_ADDR : BENCH_SENSOR_ADDR), true, &Reg[0], (wide ? 2 : 1), false, I2C_WRITE_THEN_READ_FIRST_PART);
+  I2CInterface_Packet ReadReg  = I2C_INTERFACE8_RX_DATA_DESC((wide ? BENCH_WIDE_ADDR : BENCH_SENSOR_ADDR), true, &Rx[0], readSize, true, I2C_WRITE_THEN_READ_SECOND_PART);
+  if (wide) { WriteReg.Config.Value |= I2C_USE_10BITS_ADDRESS; ReadReg.Config.Value |= I2C_USE_10BITS_ADDRESS; }
+  int Failures = 0;
+  uint64_t RegBytes = 0;
+  for (uint32_t zRead = 0; (zRead < BENCH_READ_COUNT) && (Failures == 0); ++zRead)
+  {
+    const size_t Address = (zRead * 7u) % RegCount;
+    if (wide) { Reg[0] = (uint8_t)(Address >> 8); Reg[1] = (uint8_t)Address; }
+    else Reg[0] = (uint8_t)Address;
+    eERRORRESULT Error = I2C.fnI2C_Transfer(&I2C, &WriteReg);
+    if (Error == ERR_NONE) Error = I2C.fnI2C_Transfer(&I2C, &ReadReg);
+    if ((Error != ERR_NONE) || (Rx[0] != pRegs[Address]) || (Rx[readSize - 1] != pRegs[(Address + readSize - 1) % RegCount]))
+    { printf("Register read %u failed (error %d)\n", (unsigned)zRead, (int)Error); ++Failures; }
+    RegBytes += WriteReg.BufferSize;
+  }
+  const double Payload = (double)(BenchBus.DataBytes - RegBytes) / BENCH_READ_COUNT;   // Without the register address bytes
+  const double BusTime = (double)I2C_SimBus_GetBusTime_us(&BenchBus) / BENCH_READ_COUNT;
+  const double Ideal   = (double)sclFreq / I2C_SIMBUS_BYTE_CYCLES;                    // Bytes per second of a bus that only sends data bytes
+  printf("%-17s  %7u  %5u  %10.1f  %11.2f  %10u  %6.1f%%\n", (wide ? "10-bits, stretch" : "8-bits"), (unsigned)(sclFreq / 1000u), (unsigned)readSize,
+         BusTime, Payload * 1e3 / BusTime, (unsigned)(I2C_SimBus_GetThroughput(&BenchBus) / 1000u), Payload * 1e6 / BusTime * 100.0 / Ideal);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_Checks();
+  printf("%u register reads (write then read with restart) per measure\n", BENCH_READ_COUNT);
+  printf("device             SCL kHz   size  bus us/rd  payload kB/s  bus kB/s  effic.\n");
+  for (int zWide = 0; zWide < 2; ++zWide)
+    for (size_t zFreq = 0; zFreq < (sizeof(BENCH_SCL_FREQS) / sizeof(BENCH_SCL_FREQS[0])); ++zFreq)
+      for (size_t zSize = 0; zSize < (sizeof(BENCH_READ_SIZES) / sizeof(BENCH_READ_SIZES[0])); ++zSize)
+        Failures += __Bench_Run((zWide > 0), BENCH_SCL_FREQS[zFreq], BENCH_READ_SIZES[zSize]);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,221 @@
+/*!*****************************************************************************
+ * @file    SPI_CANFDrx_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Frames per second benchmark of the CAN FD receive engine
+ * @details Host-only benchmark. Frames are received in two FIFOs of a
+ *          SPI_SimCANFD at each round, then read:
+ *          - One message object per SPI transaction: status of the FIFO, user
+ *            address, message object and FIFO increment for each frame
+ *          - By SPI_CANFDrx_Drain(): one status burst, one message object
+ *            burst per FIFO and the batched FIFO increments
+ *          The frames are checked, and the frames per second are computed
+ *          from the simulated bus time (SCK cycles and command overhead).
+ *          Build and run from the repository root:
+ *            gcc -O2 -I. Bench/SPI_CANFDrx_Bench.c SPI_CANFDrx.c SPI_SimCANFD.c SPI_Interface.c EndianTransform.c CRC.c -o CANFDrxBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "SPI_CANFDrx.h"
+#include "SPI_SimCANFD.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_ROUNDS            ( 2000u )     //!< Count of rounds of frames received then read
+#define BENCH_FIFO1_FRAMES      ( 16u )       //!< Frames received in the FIFO 1 (20 objects of 64 bytes with time stamp) per round
+#define BENCH_FIFO2_FRAMES      ( 12u )       //!< Frames received in the FIFO 2 (16 objects of 8 bytes) per round
+#define BENCH_SCK_FREQ          ( 20000000u ) //!< SCK frequency of the controller
+#define BENCH_COMMAND_OVERHEAD  ( 2000u )     //!< Bus time added for each SPI command in ns
+
+static SPI_SimCANFD BenchSim;
+static SPI_CANFDrxFrame BenchFrames[SPI_CANFD_MAX_BATCH];
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Receive the frames of a round in the simulated controller
+//=============================================================================
+static eERRORRESULT __Bench_ReceiveRound(uint32_t round)
+{
+  uint8_t Data[64];
+  eERRORRESULT Error = ERR_NONE;
+  for (uint32_t zFrame = 0; (zFrame < (BENCH_FIFO1_FRAMES + BENCH_FIFO2_FRAMES)) && (Error == ERR_NONE); ++zFrame)
+  {
+    const uint8_t Fifo = (zFrame < BENCH_FIFO1_FRAMES ? 1u : 2u);
+    const uint32_t Identifier = ((round * 64u) + zFrame) & 0x7FFu;
+    for (size_t zIdx = 0; zIdx < sizeof(Data); ++zIdx) Data[zIdx] = (uint8_t)(Identifier + zIdx);
+    Error = SPI_SimCANFD_ReceiveFrame(&BenchSim, Fifo, Identifier, (Fifo == 1u ? 0xFu | SPI_CANFD_FRAME_FDF : 0x8u), round, &Data[0], (Fifo == 1u ? 64u : 8u));
+  }
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Check a frame read
+//=============================================================================
+static bool __Bench_CheckFrame(const SPI_CANFDrxFrame* pFrame, uint8_t fifo, uint32_t round, uint32_t index)
+{
+  const uint32_t Identifier = ((round * 64u) + index + (fifo == 2u ? BENCH_FIFO1_FRAMES : 0u)) & 0x7FFu;
+  if ((pFrame->Fifo != fifo) || (SPI_CANFD_FRAME_SID_GET(pFrame->Identifier) != Identifier)) return false;
+  if ((fifo == 1u) && (pFrame->TimeStamp != round)) return false;
+  const size_t PayloadSize = (fifo == 1u ? 64u : 8u);
+  for (size_t zIdx = 0; zIdx < PayloadSize; ++zIdx)
+    if (pFrame->Data[zIdx] != (uint8_t)(Identifier + zIdx)) return false;
+  return true;
+}
+
+
+//=============================================================================
+// [STATIC] Write the FIFO increment of a FIFO (blocking)
+//=============================================================================
+static eERRORRESULT __Bench_Increment(SPI_CANFDrx* pRx, uint8_t fifo)
+{
+  const uint16_t Address = (uint16_t)(SPI_CANFD_C1FIFOCON(fifo) + 1u);
+  uint8_t Buffer[SPI_CANFD_COMMAND_SIZE + 1u] = { (uint8_t)((SPI_CANFD_INSTRUCTION_WRITE << 4) | ((Address >> 8) & 0x0Fu)), (uint8_t)Address, (uint8_t)(SPI_CANFD_FIFOCON_UINC >> 8) };
+  SPIInterface_Packet Packet;
+  memset(&Packet, 0, sizeof(Packet));
+  Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+  Packet.ChipSelect   = pRx->ChipSelect;
+  Packet.TxData       = &Buffer[0];
+  Packet.DataSize     = sizeof(Buffer);
+  Packet.Terminate    = true;
+  return pRx->pSPI->fnSPI_Transfer(pRx->pSPI, &Packet);
+}
+
+
+//=============================================================================
+// [STATIC] Read the frames of a FIFO one message object per SPI transaction
+//=============================================================================
+static eERRORRESULT __Bench_ReadPerObject(SPI_CANFDrx* pRx, const SPI_CANFDrxFifo* pFifo, uint32_t round, uint32_t* pCount, int* pFailures)
+{
+  uint32_t Words[(12u + 64u) / sizeof(uint32_t)];
+  uint32_t Index = 0;
+  while (true)
+  {
+    uint32_t Status, UserAddress;
+    eERRORRESULT Error = SPI_CANFDrx_ReadWords(pRx, (uint16_t)SPI_CANFD_C1FIFOSTA(pFifo->Fifo), &Status, 1);
+    if (Error != ERR_NONE) return Error;
+    if ((Status & SPI_CANFD_FIFOSTA_TFNRFNIF) == 0) return ERR_NONE;
+    Error = SPI_CANFDrx_ReadWords(pRx, (uint16_t)SPI_CANFD_C1FIFOUA(pFifo->Fifo), &UserAddress, 1);
+    if (Error == ERR_NONE) Error = SPI_CANFDrx_ReadWords(pRx, (uint16_t)(UserAddress + SPI_CANFD_RAM_ADDRESS), &Words[0], pFifo->ObjectSize / sizeof(uint32_t));
+    if (Error == ERR_NONE) Error = __Bench_Increment(pRx, pFifo->Fifo);
+    if (Error != ERR_NONE) return Error;
+    SPI_CANFDrxFrame Frame;
+    Frame.Identifier = Words[0];
+    Frame.Flags      = Words[1];
+    Frame.TimeStamp  = (pFifo->HeaderSize == 12u ? Words[2] : 0u);
+    Frame.Fifo       = pFifo->Fifo;
+    memcpy(&Frame.Data[0], (const uint8_t*)&Words[0] + pFifo->HeaderSize, pFifo->PayloadSize);
+    if (__Bench_CheckFrame(&Frame, pFifo->Fifo, round, Index++) == false) ++(*pFailures);
+    ++(*pCount);
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Print a result line
+//=============================================================================
+static void __Bench_Print(const char* pName, uint32_t frames, double cpuTime)
+{
+  const double BusTime = (double)SPI_SimCANFD_GetBusTime_ns(&BenchSim);
+  printf("%-22s  %6u  %8u  %11.1f  %9.0f  %13.0f\n", pName, (unsigned)frames, (unsigned)BenchSim.CommandCount, BusTime / (double)frames / 1e3,
+         (double)frames * 1e9 / BusTime, cpuTime / (double)frames);
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  SPI_Interface SPI;
+  memset(&BenchSim, 0, sizeof(BenchSim));
+  BenchSim.Fifos[1].Depth       = 20;
+  BenchSim.Fifos[1].PayloadSize = 64;
+  BenchSim.Fifos[1].TimeStamp   = true;
+  BenchSim.Fifos[2].Depth       = 16;
+  BenchSim.Fifos[2].PayloadSize = 8;
+  BenchSim.Fifos[2].TimeStamp   = false;
+  BenchSim.CommandOverhead_ns   = BENCH_COMMAND_OVERHEAD;
+  eERRORRESULT Error = SPI_SimCANFD_Attach(&SPI, &BenchSim);
+  SPI_CANFDrx Rx;
+  memset(&Rx, 0, sizeof(Rx));
+  Rx.pSPI       = &SPI;
+  Rx.ChipSelect = 0;
+  Rx.SCKfreq    = BENCH_SCK_FREQ;
+  Rx.RxFifoMask = (1u << 1) | (1u << 2);
+  if (Error == ERR_NONE) Error = SPI_CANFDrx_Init(&Rx);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); return EXIT_FAILURE; }
+
+  int Failures = 0;
+  printf("%u rounds of %u + %u frames, SCK %u MHz, %u ns per command\n", BENCH_ROUNDS, BENCH_FIFO1_FRAMES, BENCH_FIFO2_FRAMES, BENCH_SCK_FREQ / 1000000u, BENCH_COMMAND_OVERHEAD);
+  printf("reader                  frames  commands  bus us/frm  frames/s  host ns/frame\n");
+
+  //--- One message object per SPI transaction ---
+  uint32_t Frames = 0;
+  SPI_SimCANFD_ResetStats(&BenchSim);
+  double CpuTime = 0.0;
+  for (uint32_t zRound = 0; (zRound < BENCH_ROUNDS) && (Error == ERR_NONE); ++zRound)
+  {
+    Error = __Bench_ReceiveRound(zRound);
+    const double Start = __Bench_Now_ns();
+    for (size_t zFifo = 0; (zFifo < Rx.FifoCount) && (Error == ERR_NONE); ++zFifo)
+      Error = __Bench_ReadPerObject(&Rx, &Rx.Fifos[zFifo], zRound, &Frames, &Failures);
+    CpuTime += __Bench_Now_ns() - Start;
+  }
+  if (Error != ERR_NONE) { printf("per object reader failed (error %d)\n", (int)Error); ++Failures; }
+  __Bench_Print("one object per command", Frames, CpuTime);
+  const uint32_t Expected = BENCH_ROUNDS * (BENCH_FIFO1_FRAMES + BENCH_FIFO2_FRAMES);
+  if (Frames != Expected) { printf("per object reader: %u frames lost\n", (unsigned)(Expected - Frames)); ++Failures; }
+
+  //--- Batched drain ---
+  Frames = 0;
+  SPI_SimCANFD_ResetStats(&BenchSim);
+  CpuTime = 0.0;
+  for (uint32_t zRound = 0; (zRound < BENCH_ROUNDS) && (Error == ERR_NONE); ++zRound)
+  {
+    Error = __Bench_ReceiveRound(zRound);
+    uint32_t Index[3] = { 0, 0, 0 };
+    size_t Count = 1;
+    const double Start = __Bench_Now_ns();
+    while ((Error == ERR_NONE) && (Count > 0))
+    {
+      Error = SPI_CANFDrx_Drain(&Rx, &BenchFrames[0], SPI_CANFD_MAX_BATCH, &Count);
+      for (size_t zFrame = 0; zFrame < Count; ++zFrame)
+        if (__Bench_CheckFrame(&BenchFrames[zFrame], BenchFrames[zFrame].Fifo, zRound, Index[BenchFrames[zFrame].Fifo]++) == false) ++Failures;
+      Frames += (uint32_t)Count;
+    }
+    if (Error == ERR_NONE) Error = SPI_CANFDrx_WaitWrites(&Rx);
+    CpuTime += __Bench_Now_ns() - Start;
+  }
+  if (Error != ERR_NONE) { printf("batched drain failed (error %d)\n", (int)Error); ++Failures; }
+  __Bench_Print("batched drain", Frames, CpuTime);
+
+  if ((BenchSim.LostCount > 0) || (Frames != Expected)) { printf("batched drain: %u frames lost\n", (unsigned)(Expected - Frames)); ++Failures; }
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
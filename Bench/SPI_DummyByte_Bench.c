@@ -0,0 +1,352 @@
+/*!*****************************************************************************
+ * @file    SPI_DummyByte_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the SPI dummy byte receive without transmit buffer
+ * @details Host-only benchmark. The STM32cubeIDE transfers of SPI_Interface.c
+ *          are compiled with the HAL stand-in of Bench/HAL, the HAL SPI
+ *          functions are a simulated device with a 4 frames FIFO: the
+ *          transmit side is up to 4 frames ahead of the receive side, like the
+ *          peripheral. It checks:
+ *          - A receive packet with a NULL TxData sends its DummyByte from the
+ *            receive buffer, in one HAL_SPI_TransmitReceive(), and receives
+ *            the data of the device
+ *          - With UseDummyByte set, the TxData is not sent nor modified
+ *          - Dummy bytes without receive buffer are sent from a small repeated
+ *            buffer
+ *          - A native segment list with a dummy segment and a dummy receive
+ *            segment is one chip select assertion with the right bytes on bus
+ *          - With 16-bits frames, the HAL is given a count of frames
+ *          Then it gives the transmit buffer bytes, the HAL calls and the host
+ *          time per read of a caller that fills a transmit buffer with the
+ *          dummy byte, and of a dummy byte receive. Build and run from the
+ *          repository root:
+ *            gcc -O2 -DUSE_HAL_DRIVER -I. -IBench/HAL Bench/SPI_DummyByte_Bench.c SPI_Interface.c CRC.c EndianTransform.c -o SPIDummyByteBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "SPI_Interface.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_FIFO_SIZE     ( 4u )         //!< Count of frames the transmit side can be ahead
+#define BENCH_LOG_SIZE      ( 8192u )      //!< Count of bytes logged on the bus
+#define BENCH_MAX_READ      ( 4096u )      //!< Largest read measured
+#define BENCH_TOTAL_BYTES   ( 4000000u )   //!< Count of bytes read per measure
+#define BENCH_CS_PIN        ( 4u )         //!< ChipSelect pin of the device
+
+static const size_t BENCH_READ_SIZES[] = { 16, 512, 4096 }; //!< Read sizes measured
+
+//! Simulated SPI device behind the HAL stand-in
+typedef struct BenchDevice
+{
+  bool Selected;                //!< Chip select asserted
+  uint32_t Count;               //!< Bytes exchanged since the chip select assertion
+  uint32_t SelectCount;         //!< Count of chip select assertions
+  bool Logging;                 //!< Log the bytes transmitted to the device
+  uint8_t Log[BENCH_LOG_SIZE];  //!< Bytes transmitted to the device
+  size_t LogCount;              //!< Count of bytes in the log
+  uint32_t TransmitCount;       //!< Count of HAL_SPI_Transmit() calls
+  uint32_t TransmitReceiveCount;//!< Count of HAL_SPI_TransmitReceive() calls
+  uint16_t LastSize;            //!< Size given to the last HAL call
+  bool InPlace;                 //!< Last HAL_SPI_TransmitReceive() had the same transmit and receive buffer
+} BenchDevice;
+
+static BenchDevice BenchDev;
+static SPI_HandleTypeDef BenchHSPI;
+static GPIO_TypeDef BenchGPIO;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Exchange a byte with the device, the device sends a sequence that depends on the position
+//=============================================================================
+static uint8_t __Bench_Exchange(uint8_t tx)
+{
+  if (BenchDev.Logging && (BenchDev.LogCount < BENCH_LOG_SIZE)) BenchDev.Log[BenchDev.LogCount++] = tx;
+  return (uint8_t)((BenchDev.Count++ * 13u) + 7u);
+}
+
+
+//=============================================================================
+// [STATIC] Expected byte sent by the device at a position
+//=============================================================================
+static uint8_t __Bench_Expected(uint32_t position)
+{
+  return (uint8_t)((position * 13u) + 7u);
+}
+
+
+//=============================================================================
+// HAL stand-in: SPI configuration
+//=============================================================================
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+  (void)hspi;
+  return HAL_OK;
+}
+
+
+//=============================================================================
+// HAL stand-in: SPI transmit
+//=============================================================================
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+  (void)Timeout;
+  if ((BenchDev.Selected == false) || (pData == NULL)) return HAL_ERROR;
+  const size_t ByteCount = (size_t)Size << (hspi->Init.DataSize == SPI_DATASIZE_16BIT ? 1u : 0u);
+  BenchDev.TransmitCount++;
+  BenchDev.LastSize = Size;
+  for (size_t zIdx = 0; zIdx < ByteCount; ++zIdx) (void)__Bench_Exchange(pData[zIdx]);
+  return HAL_OK;
+}
+
+
+//=============================================================================
+// HAL stand-in: SPI transmit and receive, the transmit side can be BENCH_FIFO_SIZE frames ahead
+//=============================================================================
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size, uint32_t Timeout)
+{
+  (void)Timeout;
+  if ((BenchDev.Selected == false) || (pTxData == NULL) || (pRxData == NULL)) return HAL_ERROR;
+  const size_t ByteCount = (size_t)Size << (hspi->Init.DataSize == SPI_DATASIZE_16BIT ? 1u : 0u);
+  uint8_t Pending[BENCH_FIFO_SIZE];
+  BenchDev.TransmitReceiveCount++;
+  BenchDev.LastSize = Size;
+  BenchDev.InPlace  = (pTxData == pRxData);
+  size_t TxIdx = 0, RxIdx = 0;
+  while (RxIdx < ByteCount)
+  {
+    while ((TxIdx < ByteCount) && ((TxIdx - RxIdx) < BENCH_FIFO_SIZE))
+    {
+      Pending[TxIdx % BENCH_FIFO_SIZE] = __Bench_Exchange(pTxData[TxIdx]);
+      ++TxIdx;
+    }
+    pRxData[RxIdx] = Pending[RxIdx % BENCH_FIFO_SIZE];
+    ++RxIdx;
+  }
+  return HAL_OK;
+}
+
+
+//=============================================================================
+// HAL stand-in: the chip select of the device
+//=============================================================================
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+  if ((GPIOx != &BenchGPIO) || (GPIO_Pin != BENCH_CS_PIN)) return;
+  if ((PinState == GPIO_PIN_RESET) && (BenchDev.Selected == false)) { BenchDev.Count = 0; BenchDev.SelectCount++; }
+  BenchDev.Selected = (PinState == GPIO_PIN_RESET);
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Reset the device statistics and start the log
+//=============================================================================
+static void __Bench_ResetDevice(bool logging)
+{
+  BenchDev.SelectCount = 0;
+  BenchDev.LogCount = 0;
+  BenchDev.Logging = logging;
+  BenchDev.TransmitCount = 0;
+  BenchDev.TransmitReceiveCount = 0;
+}
+
+
+//=============================================================================
+// [STATIC] Check that the log has only a value between two positions
+//=============================================================================
+static bool __Bench_LogIs(size_t start, size_t count, uint8_t value)
+{
+  if ((start + count) > BenchDev.LogCount) return false;
+  for (size_t zIdx = start; zIdx < (start + count); ++zIdx)
+    if (BenchDev.Log[zIdx] != value) return false;
+  return true;
+}
+
+
+//=============================================================================
+// [STATIC] Check that a buffer has the data of the device from a position
+//=============================================================================
+static bool __Bench_DataIs(const uint8_t* pData, size_t size, uint32_t position)
+{
+  for (size_t zIdx = 0; zIdx < size; ++zIdx)
+    if (pData[zIdx] != __Bench_Expected(position + (uint32_t)zIdx)) return false;
+  return true;
+}
+
+
+//=============================================================================
+// [STATIC] Check the dummy byte transfers of the STM32cubeIDE interface
+//=============================================================================
+static int __Bench_Checks(SPI_Interface* pSPI)
+{
+  int Failures = 0;
+  static uint8_t Data[1024];
+  uint8_t TxData[64];
+  SPIInterface_Packet Packet;
+
+  //--- Receive with a NULL TxData ---
+  memset(&Packet, 0, sizeof(Packet));
+  Packet.Config.Value = SPI_BLOCKING;
+  Packet.DummyByte    = 0xA5;
+  Packet.RxData       = &Data[0];
+  Packet.DataSize     = 600;
+  Packet.Terminate    = true;
+  __Bench_ResetDevice(true);
+  Failures += __Bench_Check(Interface_SPItransfer(pSPI, &Packet) == ERR_NONE, "receive with a NULL TxData");
+  Failures += __Bench_Check((BenchDev.TransmitReceiveCount == 1) && BenchDev.InPlace && (BenchDev.LastSize == 600), "one in place HAL transfer");
+  Failures += __Bench_Check(__Bench_LogIs(0, 600, 0xA5) && (BenchDev.LogCount == 600), "dummy byte sent for each received byte");
+  Failures += __Bench_Check(__Bench_DataIs(&Data[0], 600, 0), "data received despite the transmit side ahead");
+  Failures += __Bench_Check((BenchDev.SelectCount == 1) && (BenchDev.Selected == false), "chip select of the packet");
+
+  //--- UseDummyByte with a TxData ---
+  memset(&TxData[0], 0x3C, sizeof(TxData));
+  Packet.Config.Value = SPI_BLOCKING | SPI_USE_DUMMYBYTE_FOR_RECEIVE;
+  Packet.DummyByte    = 0xFF;
+  Packet.TxData       = &TxData[0];
+  Packet.DataSize     = sizeof(TxData);
+  __Bench_ResetDevice(true);
+  Failures += __Bench_Check(Interface_SPItransfer(pSPI, &Packet) == ERR_NONE, "receive with UseDummyByte");
+  Failures += __Bench_Check(__Bench_LogIs(0, sizeof(TxData), 0xFF), "TxData not sent with UseDummyByte");
+  Failures += __Bench_Check((TxData[0] == 0x3C) && (TxData[sizeof(TxData) - 1] == 0x3C), "TxData not modified");
+
+  //--- Dummy bytes without receive buffer ---
+  Packet.Config.Value = SPI_BLOCKING | SPI_USE_DUMMYBYTE_FOR_RECEIVE;
+  Packet.DummyByte    = 0x5A;
+  Packet.TxData       = NULL;
+  Packet.RxData       = NULL;
+  Packet.DataSize     = 40;
+  __Bench_ResetDevice(true);
+  Failures += __Bench_Check(Interface_SPItransfer(pSPI, &Packet) == ERR_NONE, "dummy bytes without buffer");
+  Failures += __Bench_Check(__Bench_LogIs(0, 40, 0x5A) && (BenchDev.LogCount == 40), "dummy bytes sent");
+  Failures += __Bench_Check((BenchDev.TransmitCount == 3) && (BenchDev.TransmitReceiveCount == 0), "small repeated dummy buffer");
+
+  //--- Native segment list: command, dummy byte, dummy receive ---
+  uint8_t Command[4] = { 0x0B, 0x00, 0x10, 0x00 };
+  SPIInterface_Segment Segments[3];
+  memset(&Segments[0], 0, sizeof(Segments));
+  Segments[0].TxData = &Command[0]; Segments[0].DataSize = sizeof(Command);
+  Segments[1].DummyByte = 0xEE; Segments[1].DataSize = 1;
+  Segments[2].Config.Value = SPI_USE_DUMMYBYTE_FOR_RECEIVE; Segments[2].DummyByte = 0x00; Segments[2].RxData = &Data[0]; Segments[2].DataSize = 256;
+  SPIInterface_SegmentList List = { SPI_MEMBER(Config.Value) SPI_BLOCKING, SPI_MEMBER(ChipSelect) 0, SPI_MEMBER(pSegments) &Segments[0], SPI_MEMBER(SegmentCount) 3, SPI_MEMBER(Terminate) true };
+  __Bench_ResetDevice(true);
+  Failures += __Bench_Check(Interface_SPItransferSegmentListNative(pSPI, &List) == ERR_NONE, "native segment list");
+  Failures += __Bench_Check((memcmp(&BenchDev.Log[0], &Command[0], sizeof(Command)) == 0) && __Bench_LogIs(4, 1, 0xEE) && __Bench_LogIs(5, 256, 0x00), "bytes of the segments on bus");
+  Failures += __Bench_Check(__Bench_DataIs(&Data[0], 256, 5), "data of the dummy receive segment");
+  Failures += __Bench_Check(BenchDev.SelectCount == 1, "one chip select assertion for the list");
+
+  //--- 16-bits frames ---
+  Packet.Config.Value = SPI_BLOCKING;
+  Packet.ChipSelect   = 1;
+  Packet.DummyByte    = 0x81;
+  Packet.RxData       = &Data[0];
+  Packet.DataSize     = 64;
+  __Bench_ResetDevice(true);
+  Failures += __Bench_Check(Interface_SPItransfer(pSPI, &Packet) == ERR_NONE, "receive with 16-bits frames");
+  Failures += __Bench_Check((BenchDev.LastSize == 32) && (BenchDev.LogCount == 64) && __Bench_LogIs(0, 64, 0x81), "count of 16-bits frames given to the HAL");
+  Failures += __Bench_Check(__Bench_DataIs(&Data[0], 64, 0), "data of the 16-bits frames");
+  BenchDev.Logging = false;
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Measure the reads with a transmit buffer filled with the dummy byte or with a dummy byte receive
+//=============================================================================
+static int __Bench_Run(SPI_Interface* pSPI, bool dummyByte, size_t readSize)
+{
+  static uint8_t TxBuffer[BENCH_MAX_READ];
+  static uint8_t Data[BENCH_MAX_READ];
+  SPIInterface_Packet Packet;
+  memset(&Packet, 0, sizeof(Packet));
+  Packet.Config.Value = SPI_BLOCKING | (dummyByte ? SPI_USE_DUMMYBYTE_FOR_RECEIVE : 0);
+  Packet.DummyByte    = 0xFF;
+  Packet.TxData       = (dummyByte ? NULL : &TxBuffer[0]);
+  Packet.RxData       = &Data[0];
+  Packet.DataSize     = readSize;
+  Packet.Terminate    = true;
+
+  const uint32_t ReadCount = (uint32_t)(BENCH_TOTAL_BYTES / readSize);
+  int Failures = 0;
+  __Bench_ResetDevice(false);
+  const double Start = __Bench_Now_ns();
+  for (uint32_t zRead = 0; (zRead < ReadCount) && (Failures == 0); ++zRead)
+  {
+    if (dummyByte == false) memset(&TxBuffer[0], 0xFF, readSize); // The caller fills a transmit buffer as large as the read
+    const eERRORRESULT Error = Interface_SPItransfer(pSPI, &Packet);
+    if ((Error != ERR_NONE) || (Data[readSize - 1] != __Bench_Expected((uint32_t)readSize - 1)))
+    { printf("Read %u failed (error %d)\n", (unsigned)zRead, (int)Error); ++Failures; }
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  printf("%-12s  %5u  %12u  %9.2f  %10.1f\n", (dummyByte ? "dummy byte" : "TX buffer"), (unsigned)readSize, (unsigned)(dummyByte ? 0 : readSize),
+         (double)(BenchDev.TransmitCount + BenchDev.TransmitReceiveCount) / ReadCount, Time / ReadCount);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  SPI_Interface SPI;
+  memset(&SPI, 0, sizeof(SPI));
+  memset(&BenchDev, 0, sizeof(BenchDev));
+  BenchHSPI.Init.DataSize = SPI_DATASIZE_8BIT;
+  SPI.pHSPI      = &BenchHSPI;
+  SPI.pGPIOx     = &BenchGPIO;
+  SPI.GPIOpin    = BENCH_CS_PIN;
+  SPI.SPItimeout = 100;
+  SPI.SPIclock   = 80000000;
+  int Failures = 0;
+  Failures += __Bench_Check(Interface_SPIinit(&SPI, 0, STD_SPI_MODE0, 10000000) == ERR_NONE, "initialization of the 8-bits device");
+  Failures += __Bench_Check(Interface_SPIinit(&SPI, 1, (eSPIInterface_Mode)(STD_SPI_MODE0 | SPI_DATA_BITCOUNT_SET(16)), 10000000) == ERR_NONE, "initialization of the 16-bits device");
+  Failures += __Bench_Checks(&SPI);
+
+  printf("Reads of %u bytes in total through the STM32cubeIDE transfer\n", BENCH_TOTAL_BYTES);
+  printf("receive        size  TX buffer B  HAL/read  host ns/rd\n");
+  for (size_t zSize = 0; zSize < (sizeof(BENCH_READ_SIZES) / sizeof(BENCH_READ_SIZES[0])); ++zSize)
+  {
+    Failures += __Bench_Run(&SPI, false, BENCH_READ_SIZES[zSize]);
+    Failures += __Bench_Run(&SPI, true, BENCH_READ_SIZES[zSize]);
+  }
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,281 @@
+/*!*****************************************************************************
+ * @file    SPI_FlashLog_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Benchmark of the SPI NOR flash log
+ * @details Host-only benchmark (Linux). Small records are written to a
+ *          SPI_SimNOR with a real time bus and realistic program and erase
+ *          times, in a region small enough to wrap around:
+ *          - By a direct writer: one page program per record, each followed
+ *            by a status polling, and a blocking sector erase when a sector is
+ *            entered
+ *          - By SPI_FlashLog through a SPI_AsyncWorker
+ *          The last record of each key is read back after the writes and after
+ *          a mount of the log. Build and run from the repository root:
+ *            gcc -O2 -I. Bench/SPI_FlashLog_Bench.c SPI_FlashLog.c SPI_AsyncWorker.c SPI_SimNOR.c SPI_Interface.c EndianTransform.c CRC.c -lpthread -o FlashLogBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include "SPI_FlashLog.h"
+#include "SPI_AsyncWorker.h"
+#include "SPI_SimNOR.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_MEMORY_SIZE     ( 1024u * 1024u ) //!< Size of the simulated flash
+#define BENCH_REGION_SIZE     ( 8u * SPI_FLASHLOG_SECTOR_SIZE ) //!< Size of the log region
+#define BENCH_RECORD_COUNT    ( 2048u )         //!< Count of records written (twice the region)
+#define BENCH_RECORD_SIZE     ( 28u )           //!< Size of the data of a record (32 bytes with the record header)
+#define BENCH_KEY_COUNT       ( 64u )           //!< Count of keys, the records use them in turn
+#define BENCH_PAGE_BUFFERS    ( 4u )            //!< Count of page buffers of the log
+#define BENCH_SCK_FREQ        ( 50000000u )     //!< SCK frequency of the simulated flash
+#define BENCH_PROGRAM_TIME    ( 400u )          //!< Page program time in us
+#define BENCH_ERASE_TIME      ( 40000u )        //!< Sector erase time in us
+
+static uint8_t BenchMemory[BENCH_MEMORY_SIZE];
+static uint8_t BenchPageBuffers[BENCH_PAGE_BUFFERS * SPI_FLASHLOG_PAGE_BUFFER_SIZE];
+static uint32_t BenchIndex[BENCH_KEY_COUNT];
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Yield function of the log
+//=============================================================================
+static void __Bench_Yield(void)
+{
+  sched_yield();
+}
+
+
+//=============================================================================
+// [STATIC] Fill the data of a record
+//=============================================================================
+static void __Bench_FillRecord(uint8_t* pData, uint32_t recordIndex)
+{
+  for (size_t zIdx = 0; zIdx < BENCH_RECORD_SIZE; ++zIdx) pData[zIdx] = (uint8_t)(recordIndex + (zIdx * 7u));
+}
+
+
+//=============================================================================
+// [STATIC] Send an instruction to the flash with a blocking transfer
+//=============================================================================
+static eERRORRESULT __Bench_Send(SPI_Interface* pSPI, uint8_t* pTxData, uint8_t* pRxData, size_t size)
+{
+  SPIInterface_Packet Packet;
+  memset(&Packet, 0, sizeof(Packet));
+  Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+  Packet.TxData       = pTxData;
+  Packet.RxData       = pRxData;
+  Packet.DataSize     = size;
+  Packet.Terminate    = true;
+  return pSPI->fnSPI_Transfer(pSPI, &Packet);
+}
+
+
+//=============================================================================
+// [STATIC] Program or erase with a blocking status polling
+//=============================================================================
+static eERRORRESULT __Bench_WriteAndWait(SPI_Interface* pSPI, uint8_t* pCommand, size_t size)
+{
+  uint8_t WriteEnable = SPI_SIMNOR_WRITE_ENABLE;
+  eERRORRESULT Error = __Bench_Send(pSPI, &WriteEnable, NULL, 1);
+  if (Error == ERR_NONE) Error = __Bench_Send(pSPI, pCommand, NULL, size);
+  uint8_t Status[2] = { SPI_SIMNOR_READ_STATUS, SPI_SIMNOR_STATUS_WIP };
+  while ((Error == ERR_NONE) && ((Status[1] & SPI_SIMNOR_STATUS_WIP) > 0))
+  {
+    Status[0] = SPI_SIMNOR_READ_STATUS;
+    Error = __Bench_Send(pSPI, &Status[0], &Status[0], sizeof(Status));
+  }
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Direct writer: one page program per record
+//=============================================================================
+static int __Bench_DirectWriter(SPI_Interface* pSPI, SPI_SimNOR* pSim)
+{
+  uint8_t Command[4 + SPI_FLASHLOG_RECORD_HEADER_SIZE + BENCH_RECORD_SIZE];
+  const uint32_t RecordSize = SPI_FLASHLOG_RECORD_HEADER_SIZE + BENCH_RECORD_SIZE;
+  eERRORRESULT Error = ERR_NONE;
+  double MaxLatency = 0.0;
+  SPI_SimNOR_ResetStats(pSim);
+  const double Start = __Bench_Now_ns();
+  for (uint32_t zRecord = 0; (zRecord < BENCH_RECORD_COUNT) && (Error == ERR_NONE); ++zRecord)
+  {
+    const double RecordStart = __Bench_Now_ns();
+    const uint32_t Address = (zRecord * RecordSize) % BENCH_REGION_SIZE;
+    if ((Address % SPI_FLASHLOG_SECTOR_SIZE) == 0)
+    {
+      Command[0] = SPI_SIMNOR_SECTOR_ERASE;
+      Command[1] = (uint8_t)(Address >> 16);
+      Command[2] = (uint8_t)(Address >> 8);
+      Command[3] = (uint8_t)Address;
+      Error = __Bench_WriteAndWait(pSPI, &Command[0], 4);
+    }
+    Command[0] = SPI_SIMNOR_PAGE_PROGRAM;
+    Command[1] = (uint8_t)(Address >> 16);
+    Command[2] = (uint8_t)(Address >> 8);
+    Command[3] = (uint8_t)Address;
+    Command[4] = (uint8_t)(zRecord % BENCH_KEY_COUNT);
+    Command[5] = 0;
+    Command[6] = (uint8_t)BENCH_RECORD_SIZE;
+    Command[7] = 0;
+    __Bench_FillRecord(&Command[8], zRecord);
+    if (Error == ERR_NONE) Error = __Bench_WriteAndWait(pSPI, &Command[0], sizeof(Command));
+    const double Latency = __Bench_Now_ns() - RecordStart;
+    if (Latency > MaxLatency) MaxLatency = Latency;
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  if (Error != ERR_NONE) { printf("direct writer failed (error %d)\n", (int)Error); return 1; }
+  printf("direct writer  %10.0f  %15.1f  %8u  %6u  %12u\n", (double)BENCH_RECORD_COUNT * 1e9 / Time, MaxLatency / 1e3,
+         (unsigned)pSim->ProgramCount, (unsigned)pSim->EraseCount, (unsigned)(pSim->InstructionCount - (2u * (pSim->ProgramCount + pSim->EraseCount)))); // Each program and erase has its write enable
+  return 0;
+}
+
+
+//=============================================================================
+// [STATIC] Check the last record of each key
+//=============================================================================
+static int __Bench_CheckRecords(SPI_FlashLog* pLog, const char* pWhen)
+{
+  uint8_t Data[BENCH_RECORD_SIZE], Expected[BENCH_RECORD_SIZE];
+  int Failures = 0;
+  for (uint32_t zKey = 0; zKey < BENCH_KEY_COUNT; ++zKey)
+  {
+    size_t RecordSize = 0;
+    const uint32_t LastRecord = BENCH_RECORD_COUNT - BENCH_KEY_COUNT + zKey;
+    __Bench_FillRecord(&Expected[0], LastRecord);
+    const eERRORRESULT Error = SPI_FlashLog_Read(pLog, zKey, &Data[0], sizeof(Data), &RecordSize);
+    if ((Error != ERR_NONE) || (RecordSize != BENCH_RECORD_SIZE) || (memcmp(&Data[0], &Expected[0], BENCH_RECORD_SIZE) != 0))
+    {
+      printf("key %u %s: bad record (error %d)\n", (unsigned)zKey, pWhen, (int)Error);
+      ++Failures;
+    }
+  }
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Flash log through the asynchronous worker
+//=============================================================================
+static int __Bench_FlashLog(SPI_Interface* pSPI, SPI_SimNOR* pSim)
+{
+  SPI_FlashLog Log;
+  memset(&Log, 0, sizeof(Log));
+  Log.pSPI            = pSPI;
+  Log.ChipSelect      = 0;
+  Log.AddressSize     = 3;
+  Log.StartAddress    = 0;
+  Log.Size            = BENCH_REGION_SIZE;
+  Log.EraseAhead      = 2;
+  Log.pPageBuffers    = &BenchPageBuffers[0];
+  Log.PageBufferCount = BENCH_PAGE_BUFFERS;
+  Log.pIndex          = &BenchIndex[0];
+  Log.KeyCount        = BENCH_KEY_COUNT;
+  Log.fnYield         = __Bench_Yield;
+  pSim->SectorEraseTime_us = 0;                                                 // The format is not measured
+  eERRORRESULT Error = SPI_FlashLog_Format(&Log);
+  pSim->SectorEraseTime_us = BENCH_ERASE_TIME;
+  if (Error != ERR_NONE) { printf("flash log format failed (error %d)\n", (int)Error); return 1; }
+
+  uint8_t Data[BENCH_RECORD_SIZE];
+  double MaxLatency = 0.0;
+  SPI_SimNOR_ResetStats(pSim);
+  const double Start = __Bench_Now_ns();
+  for (uint32_t zRecord = 0; (zRecord < BENCH_RECORD_COUNT) && (Error == ERR_NONE); ++zRecord)
+  {
+    __Bench_FillRecord(&Data[0], zRecord);
+    const double RecordStart = __Bench_Now_ns();
+    Error = SPI_FlashLog_Append(&Log, zRecord % BENCH_KEY_COUNT, &Data[0], BENCH_RECORD_SIZE);
+    const double Latency = __Bench_Now_ns() - RecordStart;
+    if (Latency > MaxLatency) MaxLatency = Latency;
+    while (Error == ERR__BUFFER_FULL)                                           // The producer does something else while the flash works
+    {
+      __Bench_Yield();
+      Error = SPI_FlashLog_Process(&Log);
+      if (Error == ERR_NONE) Error = SPI_FlashLog_Append(&Log, zRecord % BENCH_KEY_COUNT, &Data[0], BENCH_RECORD_SIZE);
+    }
+  }
+  if (Error == ERR_NONE) Error = SPI_FlashLog_Flush(&Log);
+  const double Time = __Bench_Now_ns() - Start;
+  if (Error != ERR_NONE) { printf("flash log failed (error %d)\n", (int)Error); return 1; }
+  printf("flash log      %10.0f  %15.1f  %8u  %6u  %12u\n", (double)BENCH_RECORD_COUNT * 1e9 / Time, MaxLatency / 1e3,
+         (unsigned)pSim->ProgramCount, (unsigned)pSim->EraseCount, (unsigned)Log.StatusPollCount);
+  printf("  %u appends refused while the page buffers were full\n", (unsigned)Log.BufferFullCount);
+
+  //--- Read back, then mount the log again and read back ---
+  int Failures = __Bench_CheckRecords(&Log, "after the writes");
+  SPI_FlashLog Mounted = Log;
+  Error = SPI_FlashLog_Mount(&Mounted);
+  if (Error != ERR_NONE) { printf("flash log mount failed (error %d)\n", (int)Error); return Failures + 1; }
+  return Failures + __Bench_CheckRecords(&Mounted, "after the mount");
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  SPI_SimNOR Sim;
+  SPI_Interface Flash;
+  memset(&Sim, 0, sizeof(Sim));
+  memset(&BenchMemory[0], 0xFF, sizeof(BenchMemory));
+  Sim.pMemory            = &BenchMemory[0];
+  Sim.MemorySize         = BENCH_MEMORY_SIZE;
+  Sim.JedecID[0]         = 0xEF;
+  Sim.JedecID[1]         = 0x40;
+  Sim.JedecID[2]         = 0x14;
+  Sim.AddressSize        = 3;
+  Sim.PageProgramTime_us = BENCH_PROGRAM_TIME;
+  Sim.SectorEraseTime_us = BENCH_ERASE_TIME;
+  Sim.RealTimeBus        = true;
+  eERRORRESULT Error = SPI_SimNOR_Attach(&Flash, &Sim);
+  if (Error == ERR_NONE) Error = Flash.fnSPI_Init(&Flash, 0, STD_SPI_MODE0, BENCH_SCK_FREQ);
+  if (Error != ERR_NONE) { printf("Simulated flash initialization failed (error %d)\n", (int)Error); return EXIT_FAILURE; }
+
+  printf("%u records of %u bytes in a %u kB region, program %u us, sector erase %u ms\n", BENCH_RECORD_COUNT, BENCH_RECORD_SIZE, BENCH_REGION_SIZE / 1024u, BENCH_PROGRAM_TIME, BENCH_ERASE_TIME / 1000u);
+  printf("writer         records/s  max latency us  programs  erases  status reads\n");
+  int Failures = __Bench_DirectWriter(&Flash, &Sim);
+
+  SPI_AsyncWorker Worker;
+  SPI_Interface Async;
+  Error = SPI_AsyncWorker_Attach(&Async, &Worker, &Flash);
+  if (Error == ERR_NONE) Error = Async.fnSPI_Init(&Async, 0, STD_SPI_MODE0, BENCH_SCK_FREQ);
+  if (Error != ERR_NONE) { printf("Worker initialization failed (error %d)\n", (int)Error); ++Failures; }
+  else
+  {
+    Failures += __Bench_FlashLog(&Async, &Sim);
+    SPI_AsyncWorker_Stop(&Worker);
+  }
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,259 @@
+/*!*****************************************************************************
+ * @file    SPI_FlashStream_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Benchmark of the SPI flash streaming reader and the asynchronous worker
+ * @details Host-only benchmark (Linux). A flash image file is mapped as the
+ *          memory of a SPI_SimNOR with a real time bus, so each transfer lasts
+ *          its bus time. A consumer processes each chunk for about the same
+ *          time as its read. The region is streamed:
+ *          - Directly on the simulated flash (no asynchronous support, each
+ *            chunk is read then processed)
+ *          - Through a SPI_AsyncWorker with 2, 3 and 4 buffers (the reads of
+ *            the next chunks overlap the processing)
+ *          The checksum of the chunks is checked against the image, and the
+ *          region shall be one read instruction (the bus bytes+ are the bytes
+ *          on the bus more than the data). Through the worker it also
+ *          checks that a blocking transfer is rejected while the stream holds
+ *          the ChipSelect, that a stream stopped before its end releases it,
+ *          and a non-blocking packet given to the blocking transfer. Build and
+ *          run from the repository root:
+ *            gcc -O2 -I. Bench/SPI_FlashStream_Bench.c SPI_FlashStream.c SPI_AsyncWorker.c SPI_SimNOR.c SPI_Interface.c EndianTransform.c CRC.c -lpthread -o FlashStreamBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include "SPI_FlashStream.h"
+#include "SPI_AsyncWorker.h"
+#include "SPI_SimNOR.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_IMAGE_SIZE      ( 16u * 1024u * 1024u ) //!< Size of the flash image file
+#define BENCH_REGION_ADDRESS  ( 0x100000u )           //!< Address of the streamed region
+#define BENCH_REGION_SIZE     ( 1024u * 1024u )       //!< Size of the streamed region
+#define BENCH_CHUNK_SIZE      ( 4096u )               //!< Size of a chunk
+#define BENCH_MAX_BUFFERS     ( 4u )                  //!< Max count of buffers of the reader
+#define BENCH_SCK_FREQ        ( 50000000u )           //!< SCK frequency of the simulated flash
+#define BENCH_CONSUMER_RATE   ( 6.0 )                 //!< Processing rate of the consumer in bytes per us (about the bus rate)
+
+static uint8_t BenchBuffers[BENCH_MAX_BUFFERS * SPI_FLASHSTREAM_BUFFER_SIZE(BENCH_CHUNK_SIZE)];
+static SPI_FlashStreamSlot BenchSlots[BENCH_MAX_BUFFERS];
+static SPI_SimNOR BenchSim;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Yield function of the reader
+//=============================================================================
+static void __Bench_Yield(void)
+{
+  sched_yield();
+}
+
+
+//=============================================================================
+// [STATIC] Checksum of data
+//=============================================================================
+static uint32_t __Bench_Checksum(uint32_t sum, const uint8_t* pData, size_t size)
+{
+  for (size_t zIdx = 0; zIdx < size; ++zIdx) sum = (sum * 31u) + pData[zIdx];
+  return sum;
+}
+
+
+//=============================================================================
+// [STATIC] Initialize a streaming reader
+//=============================================================================
+static eERRORRESULT __Bench_InitStream(SPI_FlashStream* pStream, SPI_Interface* pSPI, size_t bufferCount)
+{
+  memset(pStream, 0, sizeof(*pStream));
+  pStream->pSPI            = pSPI;
+  pStream->ChipSelect      = 0;
+  pStream->ReadInstruction = SPI_SIMNOR_FAST_READ;
+  pStream->AddressSize     = 3;
+  pStream->DummyBytes      = 1;
+  pStream->ChunkSize       = BENCH_CHUNK_SIZE;
+  pStream->pBuffers        = &BenchBuffers[0];
+  pStream->pSlots          = &BenchSlots[0];
+  pStream->BufferCount     = bufferCount;
+  pStream->fnYield         = __Bench_Yield;
+  return SPI_FlashStream_Init(pStream);
+}
+
+
+//=============================================================================
+// [STATIC] Stream the region and process each chunk
+//=============================================================================
+static int __Bench_Stream(const char* pName, SPI_Interface* pSPI, size_t bufferCount, uint32_t expectedSum)
+{
+  SPI_FlashStream Stream;
+  eERRORRESULT Error = __Bench_InitStream(&Stream, pSPI, bufferCount);
+  if (Error != ERR_NONE) { printf("%s: init failed (error %d)\n", pName, (int)Error); return 1; }
+
+  uint32_t Sum = 0;
+  SPI_SimNOR_ResetStats(&BenchSim);
+  const double Start = __Bench_Now_ns();
+  Error = SPI_FlashStream_Start(&Stream, BENCH_REGION_ADDRESS, BENCH_REGION_SIZE);
+  while (Error == ERR_NONE)
+  {
+    const uint8_t* pData;
+    size_t Size;
+    Error = SPI_FlashStream_NextChunk(&Stream, &pData, &Size);
+    if (Error != ERR_NONE) break;
+    Sum = __Bench_Checksum(Sum, pData, Size);
+    const double ProcessEnd = __Bench_Now_ns() + ((double)Size * 1e3 / BENCH_CONSUMER_RATE);
+    while (__Bench_Now_ns() < ProcessEnd) {}                                    // Processing of the chunk by the consumer
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  SPI_FlashStream_Stop(&Stream);
+
+  int Failures = 0;
+  if (Error != ERR__NO_DATA_AVAILABLE) { printf("%s: stream failed (error %d)\n", pName, (int)Error); ++Failures; }
+  if (Sum != expectedSum) { printf("%s: checksum mismatch\n", pName); ++Failures; }
+  if (BenchSim.ReadCount != 1) { printf("%s: %u read instructions for the region\n", pName, (unsigned)BenchSim.ReadCount); ++Failures; }
+  printf("%-22s  %7u  %10.2f  %6u  %5u  %10u\n", pName, (unsigned)bufferCount, (double)Stream.ByteCount * 1e3 / Time, (unsigned)Stream.StallCount,
+         (unsigned)BenchSim.ReadCount, (unsigned)((BenchSim.SCKcycles / 8u) - Stream.ByteCount));
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Check the ChipSelect held by a stream through the worker and a non-blocking packet
+//=============================================================================
+static int __Bench_CheckWorker(SPI_Interface* pAsync, const uint8_t* pImage)
+{
+  int Failures = 0;
+  SPI_FlashStream Stream;
+  const uint8_t* pData;
+  size_t Size;
+  uint8_t ID[4] = { SPI_SIMNOR_READ_JEDEC_ID, 0, 0, 0 };
+  SPIInterface_Packet Packet;
+  memset(&Packet, 0, sizeof(Packet));
+  Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+  Packet.ChipSelect   = 0;
+  Packet.TxData       = &ID[0];
+  Packet.RxData       = &ID[0];
+  Packet.DataSize     = sizeof(ID);
+  Packet.Terminate    = true;
+
+  //--- Blocking transfer while the stream holds the ChipSelect, then stop before the end of the region ---
+  eERRORRESULT Error = __Bench_InitStream(&Stream, pAsync, 2);
+  if (Error == ERR_NONE) Error = SPI_FlashStream_Start(&Stream, BENCH_REGION_ADDRESS, BENCH_REGION_SIZE);
+  if (Error == ERR_NONE) Error = SPI_FlashStream_NextChunk(&Stream, &pData, &Size);
+  if ((Error != ERR_NONE) || (memcmp(pData, &pImage[BENCH_REGION_ADDRESS], Size) != 0)) { printf("Worker: first chunk failed (error %d)\n", (int)Error); ++Failures; }
+  if (pAsync->fnSPI_Transfer(pAsync, &Packet) != ERR__SPI_BUSY) { printf("Worker: blocking transfer not rejected during the stream\n"); ++Failures; }
+  SPI_FlashStream_Stop(&Stream);
+  Error = pAsync->fnSPI_Transfer(pAsync, &Packet);
+  if ((Error != ERR_NONE) || (ID[1] != BenchSim.JedecID[0]) || (ID[2] != BenchSim.JedecID[1]) || (ID[3] != BenchSim.JedecID[2]))
+  { printf("Worker: blocking transfer after the stop failed (error %d)\n", (int)Error); ++Failures; }
+
+  //--- New stream after the stop ---
+  Error = SPI_FlashStream_Start(&Stream, BENCH_REGION_ADDRESS + 12345u, 3u * BENCH_CHUNK_SIZE);
+  for (size_t zChunk = 0; (zChunk < 3) && (Error == ERR_NONE); ++zChunk)
+  {
+    Error = SPI_FlashStream_NextChunk(&Stream, &pData, &Size);
+    if ((Error == ERR_NONE) && (memcmp(pData, &pImage[BENCH_REGION_ADDRESS + 12345u + (zChunk * BENCH_CHUNK_SIZE)], Size) != 0)) Error = ERR__BAD_DATA;
+  }
+  if (Error == ERR_NONE) Error = (SPI_FlashStream_NextChunk(&Stream, &pData, &Size) == ERR__NO_DATA_AVAILABLE ? ERR_NONE : ERR__BAD_DATA);
+  if (Error != ERR_NONE) { printf("Worker: stream after the stop failed (error %d)\n", (int)Error); ++Failures; }
+  SPI_FlashStream_Stop(&Stream);
+
+  //--- Non-blocking packet given to the blocking transfer, then its status check ---
+  ID[0] = SPI_SIMNOR_READ_JEDEC_ID;                                             // The receive overwrote the instruction
+  memset(&ID[1], 0, 3);
+  Packet.Config.Value |= SPI_USE_NON_BLOCKING;
+  Error = pAsync->fnSPI_Transfer(pAsync, &Packet);
+  Packet.DataSize = 0;
+  while (Error == ERR_NONE)
+  {
+    Error = pAsync->fnSPI_Transfer(pAsync, &Packet);
+    if (Error == ERR__SPI_BUSY) { Error = ERR_NONE; __Bench_Yield(); continue; }
+    break;
+  }
+  if ((Error != ERR_NONE) || (ID[1] != BenchSim.JedecID[0]) || (ID[2] != BenchSim.JedecID[1]) || (ID[3] != BenchSim.JedecID[2]))
+  { printf("Worker: non-blocking packet failed (error %d)\n", (int)Error); ++Failures; }
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  //--- Create the flash image file ---
+  char Path[] = "/tmp/FlashStreamBenchXXXXXX";
+  const int Fd = mkstemp(Path);
+  if (Fd < 0) { printf("Cannot create the image file\n"); return EXIT_FAILURE; }
+  uint8_t* pImage = (uint8_t*)malloc(BENCH_IMAGE_SIZE);
+  if (pImage == NULL) { close(Fd); unlink(Path); return EXIT_FAILURE; }
+  for (size_t zIdx = 0; zIdx < BENCH_IMAGE_SIZE; ++zIdx) pImage[zIdx] = (uint8_t)(rand() & 0xFF);
+  const bool Written = (write(Fd, pImage, BENCH_IMAGE_SIZE) == (ssize_t)BENCH_IMAGE_SIZE);
+  close(Fd);
+  const uint32_t ExpectedSum = __Bench_Checksum(0, &pImage[BENCH_REGION_ADDRESS], BENCH_REGION_SIZE);
+
+  //--- Map it in the simulated flash ---
+  SPI_SimNOR* const pSim = &BenchSim;
+  SPI_Interface Flash;
+  memset(pSim, 0, sizeof(*pSim));
+  pSim->JedecID[0]  = 0xEF;
+  pSim->JedecID[1]  = 0x40;
+  pSim->JedecID[2]  = 0x18;
+  pSim->AddressSize = 3;
+  pSim->RealTimeBus = true;
+  eERRORRESULT Error = (Written ? SPI_SimNOR_MapFile(pSim, Path, false) : ERR__WRITE_ERROR);
+  unlink(Path);                                                                 // The mapping keeps the file content
+  if (Error == ERR_NONE) Error = SPI_SimNOR_Attach(&Flash, pSim);
+  if (Error == ERR_NONE) Error = Flash.fnSPI_Init(&Flash, 0, STD_SPI_MODE0, BENCH_SCK_FREQ);
+  if (Error != ERR_NONE) { printf("Simulated flash initialization failed (error %d)\n", (int)Error); free(pImage); return EXIT_FAILURE; }
+
+  int Failures = 0;
+  printf("%u kB region by %u bytes chunks at %u MHz, consumer at %.1f MB/s\n", BENCH_REGION_SIZE / 1024u, BENCH_CHUNK_SIZE, BENCH_SCK_FREQ / 1000000u, BENCH_CONSUMER_RATE);
+  printf("interface               buffers  total MB/s  stalls  reads  bus bytes+\n");
+  Failures += __Bench_Stream("simulated flash (sync)", &Flash, 2, ExpectedSum);
+
+  //--- Through the asynchronous worker ---
+  SPI_AsyncWorker Worker;
+  SPI_Interface Async;
+  Error = SPI_AsyncWorker_Attach(&Async, &Worker, &Flash);
+  if (Error == ERR_NONE) Error = Async.fnSPI_Init(&Async, 0, STD_SPI_MODE0, BENCH_SCK_FREQ);
+  if (Error != ERR_NONE) { printf("Worker initialization failed (error %d)\n", (int)Error); ++Failures; }
+  else
+  {
+    for (size_t zBuffers = 2; zBuffers <= BENCH_MAX_BUFFERS; ++zBuffers)
+      Failures += __Bench_Stream("asynchronous worker", &Async, zBuffers, ExpectedSum);
+    Failures += __Bench_CheckWorker(&Async, pImage);
+    SPI_AsyncWorker_Stop(&Worker);
+  }
+
+  SPI_SimNOR_UnmapFile(pSim);
+  free(pImage);
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
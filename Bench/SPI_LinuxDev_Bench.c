@@ -0,0 +1,291 @@
+/*!*****************************************************************************
+ * @file    SPI_LinuxDev_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the Linux spidev backend through its ioctl shim
+ * @details Host-only benchmark (Linux). The ioctl() of the backend is replaced
+ *          by a shim that is a 64kB SPI memory (0x03 read and 0x02 write with a
+ *          3 bytes address) for each ChipSelect. The shim follows the chip
+ *          select: it is deasserted at the end of a SPI_IOC_MESSAGE(N) unless
+ *          the last transfer has cs_change set.
+ *          It checks:
+ *          - A command packet without terminate and its read packet are one
+ *            ioctl
+ *          - The data of a read packet without terminate are available at
+ *            return, the chip select stays asserted and the next read packet
+ *            continues the same command
+ *          - A CRC error of a packet does not skip the endian transform of the
+ *            next packets of the message
+ *          - A ChipSelect change or a phase transfer while the chip select is
+ *            held are rejected
+ *          Then it gives the ioctls, the transfers, the bus bytes and the host
+ *          time per record read, with a read command per record and with one
+ *          read command whose chip select is held between the records. Build
+ *          and run from the repository root:
+ *            gcc -O2 -I. Bench/SPI_LinuxDev_Bench.c SPI_LinuxDev.c SPI_Interface.c CRC.c EndianTransform.c -o SPILinuxDevBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include "SPI_LinuxDev.h"
+#include "SPI_Interface.h"
+#include "CRC.h"
+#include "ErrorsDef.h"
+#undef SPI_LSB_FIRST
+#include <linux/spi/spidev.h>
+//-----------------------------------------------------------------------------
+
+#define BENCH_CHIP_COUNT    ( 2u )       //!< Count of simulated memories
+#define BENCH_FIRST_FD      ( 3 )        //!< File descriptor of the first memory
+#define BENCH_MEMORY_SIZE   ( 65536u )   //!< Size of a memory
+#define BENCH_RECORD_SIZE   ( 16u )      //!< Size of a record read
+#define BENCH_RECORD_COUNT  ( 200000u )  //!< Count of records read per measure
+
+//! Simulated SPI memory behind the ioctl shim
+typedef struct BenchMemory
+{
+  uint8_t Data[BENCH_MEMORY_SIZE]; //!< Content of the memory
+  bool Selected;                   //!< Chip select asserted
+  uint8_t Command;                 //!< Command in progress
+  uint32_t Count;                  //!< Bytes received since the chip select assertion
+  uint32_t Address;                //!< Address of the command
+} BenchMemory;
+
+static BenchMemory BenchMem[BENCH_CHIP_COUNT];
+static uint64_t BenchBusBytes = 0;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Exchange a byte with a simulated memory
+//=============================================================================
+static uint8_t __Bench_Exchange(BenchMemory* pMem, uint8_t tx)
+{
+  uint8_t Rx = 0xFF;
+  if (pMem->Count == 0) pMem->Command = tx;
+  else if (pMem->Count <= 3) pMem->Address = (pMem->Address << 8) | tx;
+  else if (pMem->Command == 0x03) Rx = pMem->Data[pMem->Address++ % BENCH_MEMORY_SIZE];
+  else if (pMem->Command == 0x02) pMem->Data[pMem->Address++ % BENCH_MEMORY_SIZE] = tx;
+  pMem->Count++;
+  return Rx;
+}
+
+
+//=============================================================================
+// [STATIC] ioctl shim: SPI memories that follow the chip select
+//=============================================================================
+static int __Bench_Ioctl(int fd, unsigned long request, void* pArg)
+{
+  if ((fd < BENCH_FIRST_FD) || (fd >= (BENCH_FIRST_FD + (int)BENCH_CHIP_COUNT))) { errno = EBADF; return -1; }
+  BenchMemory* pMem = &BenchMem[fd - BENCH_FIRST_FD];
+  if ((request == SPI_IOC_WR_MODE32) || (request == SPI_IOC_WR_BITS_PER_WORD) || (request == SPI_IOC_WR_MAX_SPEED_HZ)) return 0;
+  if (_IOC_TYPE(request) != SPI_IOC_MAGIC) { errno = ENOTTY; return -1; }
+  const size_t TransferCount = _IOC_SIZE(request) / sizeof(struct spi_ioc_transfer);
+  const struct spi_ioc_transfer* pTransfers = (const struct spi_ioc_transfer*)pArg;
+  for (size_t zTransfer = 0; zTransfer < TransferCount; ++zTransfer)
+  {
+    const struct spi_ioc_transfer* pTransfer = &pTransfers[zTransfer];
+    if (pMem->Selected == false) { pMem->Selected = true; pMem->Count = 0; pMem->Address = 0; }
+    const uint8_t* pTx = (const uint8_t*)(uintptr_t)pTransfer->tx_buf;
+    uint8_t* pRx = (uint8_t*)(uintptr_t)pTransfer->rx_buf;
+    for (uint32_t zIdx = 0; zIdx < pTransfer->len; ++zIdx)
+    {
+      const uint8_t Rx = __Bench_Exchange(pMem, (pTx != NULL ? pTx[zIdx] : 0x00));
+      if (pRx != NULL) pRx[zIdx] = Rx;
+    }
+    BenchBusBytes += pTransfer->len;
+  }
+  if ((TransferCount > 0) && (pTransfers[TransferCount - 1].cs_change == 0)) pMem->Selected = false; // End of message
+  return (int)TransferCount;
+}
+
+
+//=============================================================================
+// [STATIC] Initialize the backend on the shim
+//=============================================================================
+static eERRORRESULT __Bench_Init(SPI_Interface* pSPI, SPI_LinuxDev* pDev, SPI_LinuxDevChip* pChips)
+{
+  memset(pDev, 0, sizeof(*pDev));
+  memset(pChips, 0, BENCH_CHIP_COUNT * sizeof(pChips[0]));
+  for (size_t zChip = 0; zChip < BENCH_CHIP_COUNT; ++zChip)
+  {
+    pChips[zChip].Fd = BENCH_FIRST_FD + (int)zChip;
+    memset(&BenchMem[zChip], 0, sizeof(BenchMem[zChip]));
+    for (size_t zIdx = 0; zIdx < BENCH_MEMORY_SIZE; ++zIdx) BenchMem[zChip].Data[zIdx] = (uint8_t)((zIdx * 7u) ^ (zIdx >> 8) ^ zChip);
+  }
+  pDev->pChips    = pChips;
+  pDev->ChipCount = BENCH_CHIP_COUNT;
+  pDev->fnIoctl   = __Bench_Ioctl;
+  eERRORRESULT Error = SPI_LinuxDev_Attach(pSPI, pDev);
+  for (uint8_t zChip = 0; (zChip < BENCH_CHIP_COUNT) && (Error == ERR_NONE); ++zChip)
+    Error = SPI_LinuxDev_Init(pSPI, zChip, STD_SPI_MODE0, 10000000);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Fill a packet
+//=============================================================================
+static SPIInterface_Packet __Bench_Packet(uint8_t chipSelect, uint8_t* txData, uint8_t* rxData, size_t size, bool terminate)
+{
+  SPIInterface_Packet Packet;
+  memset(&Packet, 0, sizeof(Packet));
+  Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) | (txData == NULL ? SPI_USE_DUMMYBYTE_FOR_RECEIVE : 0);
+  Packet.ChipSelect   = chipSelect;
+  Packet.TxData       = txData;
+  Packet.RxData       = rxData;
+  Packet.DataSize     = size;
+  Packet.Terminate    = terminate;
+  return Packet;
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Check the behavior of the backend
+//=============================================================================
+static int __Bench_Checks(void)
+{
+  SPI_Interface SPI;
+  SPI_LinuxDev Dev;
+  SPI_LinuxDevChip Chips[BENCH_CHIP_COUNT];
+  int Failures = 0;
+  if (__Bench_Init(&SPI, &Dev, &Chips[0]) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+
+  //--- Command and read: one ioctl ---
+  uint8_t Command[4] = { 0x03, 0x00, 0x01, 0x00 }, Rx[8];
+  SPIInterface_Packet SendCommand = __Bench_Packet(0, &Command[0], NULL, sizeof(Command), false);
+  SPIInterface_Packet ReadFirst   = __Bench_Packet(0, NULL, &Rx[0], 4, false);
+  SPIInterface_Packet ReadNext    = __Bench_Packet(0, NULL, &Rx[4], 4, true);
+  Failures += __Bench_Check(SPI.fnSPI_Transfer(&SPI, &SendCommand) == ERR_NONE, "command");
+  Failures += __Bench_Check(Dev.IoctlCount == 0, "the command waits for the read");
+
+  //--- Read without terminate: data at return, the chip select stays asserted for the next read ---
+  Failures += __Bench_Check(SPI.fnSPI_Transfer(&SPI, &ReadFirst) == ERR_NONE, "read without terminate");
+  Failures += __Bench_Check(Dev.IoctlCount == 1, "command and read in one ioctl");
+  Failures += __Bench_Check(memcmp(&Rx[0], &BenchMem[0].Data[0x100], 4) == 0, "data of a read without terminate available at return");
+  Failures += __Bench_Check(BenchMem[0].Selected && Dev.ChipSelectHeld, "chip select held after a read without terminate");
+
+  //--- ChipSelect change and phase transfer while the chip select is held ---
+  SPIInterface_Packet OtherChip = __Bench_Packet(1, &Command[0], NULL, sizeof(Command), true);
+  Failures += __Bench_Check(SPI.fnSPI_Transfer(&SPI, &OtherChip) == ERR__SPI_CONFIG_ERROR, "ChipSelect change while held rejected");
+  SPIInterface_PhasePacket Phase;
+  memset(&Phase, 0, sizeof(Phase));
+  Phase.ChipSelect       = 0;
+  Phase.Instruction      = 0x05;
+  Phase.InstructionLines = SPI_PHASE_1_LINE;
+  Failures += __Bench_Check(SPI_LinuxDev_TransferPhases(&SPI, &Phase) == ERR__SPI_BUSY, "phase transfer while held rejected");
+
+  Failures += __Bench_Check(SPI.fnSPI_Transfer(&SPI, &ReadNext) == ERR_NONE, "read continued");
+  Failures += __Bench_Check(memcmp(&Rx[4], &BenchMem[0].Data[0x104], 4) == 0, "data of the continued read");
+  Failures += __Bench_Check((BenchMem[0].Selected == false) && (Dev.ChipSelectHeld == false), "chip select released by the terminate");
+  Failures += __Bench_Check(SPI.fnSPI_Transfer(&SPI, &OtherChip) == ERR_NONE, "other ChipSelect after the terminate");
+
+  //--- A CRC error does not skip the endian transform of the next packets ---
+  uint8_t Block[8], Word[4];
+  CRC_Context CRC;
+  (void)CRC_Init(&CRC, CRC16_XMODEM);
+  Command[2] = 0x02;
+  SPIInterface_Packet ReadBlock = __Bench_Packet(0, NULL, &Block[0], sizeof(Block), false);
+  SPIInterface_Packet ReadWord  = __Bench_Packet(0, NULL, &Word[0], sizeof(Word), true);
+  ReadBlock.pCRC          = &CRC;                                              // The last 2 bytes of the block are not its CRC: CRC error
+  ReadBlock.Config.Value |= SPI_CHECK_CRC;
+  ReadWord.Config.Value   = (ReadWord.Config.Value & ~SPI_ENDIAN_TRANSFORM_Mask) | SPI_ENDIAN_TRANSFORM_SET(SPI_SWITCH_ENDIAN_16BITS);
+  SendCommand.Terminate = false;
+  Failures += __Bench_Check(SPI.fnSPI_Transfer(&SPI, &SendCommand) == ERR_NONE, "command before the CRC check");
+  Dev.Packets[Dev.PacketCount++] = ReadBlock;                                  // Same message as the word: collect it without the flush of a read packet
+  Failures += __Bench_Check(SPI.fnSPI_Transfer(&SPI, &ReadWord) == ERR__CRC_ERROR, "CRC error of the first packet returned");
+  const uint8_t* pExpected = &BenchMem[0].Data[0x200 + sizeof(Block)];
+  Failures += __Bench_Check((Word[0] == pExpected[1]) && (Word[1] == pExpected[0]) && (Word[2] == pExpected[3]) && (Word[3] == pExpected[2]), "endian transform after a CRC error");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Measure the record reads, with a read command per record or with the chip select held
+//=============================================================================
+static int __Bench_Run(bool held)
+{
+  SPI_Interface SPI;
+  SPI_LinuxDev Dev;
+  SPI_LinuxDevChip Chips[BENCH_CHIP_COUNT];
+  if (__Bench_Init(&SPI, &Dev, &Chips[0]) != ERR_NONE) { printf("Initialization failed\n"); return 1; }
+  uint8_t Command[4], Record[BENCH_RECORD_SIZE];
+  int Failures = 0;
+  BenchBusBytes = 0;
+  const double Start = __Bench_Now_ns();
+  for (uint32_t zRecord = 0; (zRecord < BENCH_RECORD_COUNT) && (Failures == 0); ++zRecord)
+  {
+    const uint32_t Address = (zRecord * BENCH_RECORD_SIZE) % BENCH_MEMORY_SIZE;
+    eERRORRESULT Error = ERR_NONE;
+    if ((held == false) || (Address == 0))                                     // Held: one command per pass over the memory
+    {
+      Command[0] = 0x03;
+      Command[1] = (uint8_t)(Address >> 16);
+      Command[2] = (uint8_t)(Address >> 8);
+      Command[3] = (uint8_t)Address;
+      SPIInterface_Packet SendCommand = __Bench_Packet(0, &Command[0], NULL, sizeof(Command), false);
+      Error = SPI.fnSPI_Transfer(&SPI, &SendCommand);
+    }
+    const bool Last = ((held == false) || (((Address + BENCH_RECORD_SIZE) % BENCH_MEMORY_SIZE) == 0) || (zRecord == (BENCH_RECORD_COUNT - 1)));
+    SPIInterface_Packet ReadRecord = __Bench_Packet(0, NULL, &Record[0], sizeof(Record), Last);
+    if (Error == ERR_NONE) Error = SPI.fnSPI_Transfer(&SPI, &ReadRecord);
+    if ((Error != ERR_NONE) || (memcmp(&Record[0], &BenchMem[0].Data[Address], sizeof(Record)) != 0))
+    { printf("Record %u failed (error %d)\n", (unsigned)zRecord, (int)Error); ++Failures; }
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  printf("%-26s  %9.2f  %9.2f  %9.2f  %8.1f\n", (held ? "chip select held" : "read command per record"), (double)Dev.IoctlCount / BENCH_RECORD_COUNT,
+         (double)Dev.TransferCount / BENCH_RECORD_COUNT, (double)BenchBusBytes / BENCH_RECORD_COUNT, Time / BENCH_RECORD_COUNT);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_Checks();
+  printf("%u records of %u bytes read through the ioctl shim\n", BENCH_RECORD_COUNT, BENCH_RECORD_SIZE);
+  printf("read                        ioctl/rec  xfers/rec  bytes/rec  host ns/rec\n");
+  Failures += __Bench_Run(false);
+  Failures += __Bench_Run(true);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,270 @@
+/*!*****************************************************************************
+ * @file    SPI_SDcard_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and throughput benchmark of the SD card block device
+ * @details Host-only benchmark (Linux). The block device runs on a simulated
+ *          SD card (SPI_SimSD, 25MHz SCK):
+ *          - Through the Linux spidev backend: its ioctl() is a shim that gives
+ *            each spi_ioc_transfer to the simulated card. It checks the card
+ *            initialization, a write and a read back
+ *          - Directly on the simulated card: 10 requests of 30 contiguous
+ *            blocks submitted one after the other shall be one multiple block
+ *            write
+ *          Then it gives, for the sequential reads and writes with several
+ *          request sizes, the commands and the stops per request, the data
+ *          throughput on the simulated bus (commands, tokens, CRC, latencies
+ *          and busy included) and the host time per block. Build and run from
+ *          the repository root:
+ *            gcc -O2 -I. Bench/SPI_SDcard_Bench.c SPI_SDcard.c SPI_SimSD.c SPI_LinuxDev.c SPI_Interface.c CRC.c EndianTransform.c -o SDcardBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include "SPI_SDcard.h"
+#include "SPI_SimSD.h"
+#include "SPI_LinuxDev.h"
+#include "SPI_Interface.h"
+#include "ErrorsDef.h"
+#undef SPI_LSB_FIRST
+#include <linux/spi/spidev.h>
+//-----------------------------------------------------------------------------
+
+#define BENCH_CARD_BLOCKS     ( 16384u )  //!< Count of blocks of the simulated card (8MB)
+#define BENCH_PASS_BLOCKS     ( 8192u )   //!< Count of blocks read or written per measure
+#define BENCH_SCK_FREQ        ( 25000000u ) //!< SCK frequency after the identification
+#define BENCH_SPIDEV_FD       ( 3 )       //!< File descriptor of the card behind the ioctl shim
+#define BENCH_QUEUE_REQUESTS  ( 10u )     //!< Count of requests of the queued writes check
+#define BENCH_QUEUE_BLOCKS    ( 30u )     //!< Count of blocks per request of the queued writes check
+
+static const uint32_t BENCH_REQUEST_BLOCKS[] = { 1, 8, 64 }; //!< Count of blocks per request
+
+static uint8_t BenchCard[BENCH_CARD_BLOCKS * SPI_SDCARD_BLOCK_SIZE];
+static uint8_t BenchData[BENCH_PASS_BLOCKS * SPI_SDCARD_BLOCK_SIZE];
+static uint8_t BenchCheck[BENCH_PASS_BLOCKS * SPI_SDCARD_BLOCK_SIZE];
+static SPI_SimSD BenchSim;
+static SPI_Interface BenchSimSPI;
+static uint32_t BenchMessageCount = 0;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Current time of the simulated card in ms
+//=============================================================================
+static uint32_t __Bench_Getms(void)
+{
+  return (uint32_t)(BenchSim.Time_ns / 1000000u);
+}
+
+
+//=============================================================================
+// [STATIC] Power up the simulated card
+//=============================================================================
+static eERRORRESULT __Bench_PowerUp(void)
+{
+  memset(&BenchSim, 0, sizeof(BenchSim));
+  BenchSim.pMemory          = &BenchCard[0];
+  BenchSim.BlockCount       = BENCH_CARD_BLOCKS;
+  BenchSim.InitPolls        = 4;
+  BenchSim.ReadLatency_us   = 300;
+  BenchSim.StreamLatency_us = 20;
+  BenchSim.ProgramTime_us   = 250;
+  BenchSim.EraseTime_us     = 3000;
+  BenchSim.EraseGroupBlocks = 64;
+  BenchSim.StopTime_us      = 200;
+  return SPI_SimSD_Attach(&BenchSimSPI, &BenchSim);
+}
+
+
+//=============================================================================
+// [STATIC] ioctl shim: each transfer is exchanged with the simulated card
+//=============================================================================
+static int __Bench_Ioctl(int fd, unsigned long request, void* pArg)
+{
+  if (fd != BENCH_SPIDEV_FD) { errno = EBADF; return -1; }
+  if ((request == SPI_IOC_WR_MODE32) || (request == SPI_IOC_WR_BITS_PER_WORD)) return 0;
+  if (request == SPI_IOC_WR_MAX_SPEED_HZ) return (SPI_SimSD_Init(&BenchSimSPI, 0, STD_SPI_MODE0, *(const uint32_t*)pArg) == ERR_NONE ? 0 : -1);
+  if (_IOC_TYPE(request) != SPI_IOC_MAGIC) { errno = ENOTTY; return -1; }
+  const size_t TransferCount = _IOC_SIZE(request) / sizeof(struct spi_ioc_transfer);
+  const struct spi_ioc_transfer* pTransfers = (const struct spi_ioc_transfer*)pArg;
+  for (size_t zTransfer = 0; zTransfer < TransferCount; ++zTransfer)
+  {
+    SPIInterface_Packet Packet;
+    memset(&Packet, 0, sizeof(Packet));
+    Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+    Packet.DummyByte    = 0x00;                                                  // spidev sends 0x00 without tx_buf
+    Packet.TxData       = (uint8_t*)(uintptr_t)pTransfers[zTransfer].tx_buf;
+    Packet.RxData       = (uint8_t*)(uintptr_t)pTransfers[zTransfer].rx_buf;
+    Packet.DataSize     = pTransfers[zTransfer].len;
+    Packet.Terminate    = (zTransfer == (TransferCount - 1));
+    if (SPI_SimSD_Transfer(&BenchSimSPI, &Packet) != ERR_NONE) { errno = EIO; return -1; }
+  }
+  BenchMessageCount++;
+  return (int)TransferCount;
+}
+
+
+//=============================================================================
+// [STATIC] Fill the data of a pass
+//=============================================================================
+static void __Bench_FillData(uint32_t seed)
+{
+  for (size_t zIdx = 0; zIdx < sizeof(BenchData); ++zIdx) BenchData[zIdx] = (uint8_t)((zIdx * 13u) ^ (zIdx >> 9) ^ seed);
+}
+
+
+//=============================================================================
+// [STATIC] Initialize the block device on an interface
+//=============================================================================
+static eERRORRESULT __Bench_InitCard(SPI_SDcard* pSD, SPI_Interface* pSPI)
+{
+  memset(pSD, 0, sizeof(*pSD));
+  pSD->pSPI           = pSPI;
+  pSD->ChipSelect     = 0;
+  pSD->SCKfreq        = BENCH_SCK_FREQ;
+  pSD->UseCRC         = true;
+  pSD->fnGetCurrentms = __Bench_Getms;
+  pSD->fnYield        = NULL;
+  return SPI_SDcard_Init(pSD);
+}
+
+
+//=============================================================================
+// [STATIC] Check the block device through the spidev backend
+//=============================================================================
+static int __Bench_CheckSpidev(void)
+{
+  SPI_Interface SPI;
+  SPI_LinuxDev Dev;
+  SPI_LinuxDevChip Chip;
+  SPI_SDcard SD;
+  memset(&Dev, 0, sizeof(Dev));
+  memset(&Chip, 0, sizeof(Chip));
+  Chip.Fd       = BENCH_SPIDEV_FD;
+  Dev.pChips    = &Chip;
+  Dev.ChipCount = 1;
+  Dev.fnIoctl   = __Bench_Ioctl;
+  eERRORRESULT Error = __Bench_PowerUp();
+  if (Error == ERR_NONE) Error = SPI_LinuxDev_Attach(&SPI, &Dev);
+  if (Error == ERR_NONE) Error = __Bench_InitCard(&SD, &SPI);
+  if ((Error != ERR_NONE) || (SD.BlockCount != BENCH_CARD_BLOCKS)) { printf("spidev: initialization failed (error %d, %u blocks)\n", (int)Error, (unsigned)SD.BlockCount); return 1; }
+
+  const uint32_t Blocks = 64;
+  __Bench_FillData(0x5A);
+  BenchMessageCount = 0;
+  Error = SPI_SDcard_WriteBlocks(&SD, 1000, &BenchData[0], Blocks);
+  if (Error == ERR_NONE) Error = SPI_SDcard_ReadBlocks(&SD, 1000, &BenchCheck[0], Blocks);
+  if (Error == ERR_NONE) Error = SPI_SDcard_WaitIdle(&SD);
+  if ((Error != ERR_NONE) || (memcmp(&BenchCheck[0], &BenchData[0], Blocks * SPI_SDCARD_BLOCK_SIZE) != 0)
+   || (memcmp(&BenchCard[1000 * SPI_SDCARD_BLOCK_SIZE], &BenchData[0], Blocks * SPI_SDCARD_BLOCK_SIZE) != 0))
+  { printf("spidev: write and read back failed (error %d)\n", (int)Error); return 1; }
+  printf("spidev: %u blocks written and read back, %.2f ioctl per block\n", (unsigned)Blocks, (double)BenchMessageCount / (2.0 * Blocks));
+  return 0;
+}
+
+
+//=============================================================================
+// [STATIC] Check that contiguous write requests submitted one after the other are one multiple block write
+//=============================================================================
+static int __Bench_CheckQueuedWrites(void)
+{
+  SPI_SDcard SD;
+  SPI_SDcardRequest Requests[BENCH_QUEUE_REQUESTS];
+  eERRORRESULT Error = __Bench_PowerUp();
+  if (Error == ERR_NONE) Error = __Bench_InitCard(&SD, &BenchSimSPI);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); return 1; }
+  __Bench_FillData(0xA5);
+  SPI_SDcard_ResetStats(&SD);
+  memset(&Requests[0], 0, sizeof(Requests));
+  for (uint32_t zReq = 0; (zReq < BENCH_QUEUE_REQUESTS) && (Error == ERR_NONE); ++zReq)
+  {
+    Requests[zReq].Write      = true;
+    Requests[zReq].Block      = 2000 + (zReq * BENCH_QUEUE_BLOCKS);
+    Requests[zReq].BlockCount = BENCH_QUEUE_BLOCKS;
+    Requests[zReq].pData      = &BenchData[zReq * BENCH_QUEUE_BLOCKS * SPI_SDCARD_BLOCK_SIZE];
+    Error = SPI_SDcard_Submit(&SD, &Requests[zReq]);
+  }
+  if (Error == ERR_NONE) Error = SPI_SDcard_WaitIdle(&SD);
+  for (uint32_t zReq = 0; (zReq < BENCH_QUEUE_REQUESTS) && (Error == ERR_NONE); ++zReq) Error = Requests[zReq].Result;
+  const size_t Size = BENCH_QUEUE_REQUESTS * BENCH_QUEUE_BLOCKS * SPI_SDCARD_BLOCK_SIZE;
+  if ((Error != ERR_NONE) || (memcmp(&BenchCard[2000 * SPI_SDCARD_BLOCK_SIZE], &BenchData[0], Size) != 0))
+  { printf("Queued writes failed (error %d)\n", (int)Error); return 1; }
+  printf("%u queued writes of %u blocks: %u write command, %u stop\n", BENCH_QUEUE_REQUESTS, BENCH_QUEUE_BLOCKS, (unsigned)SD.WriteCommandCount, (unsigned)SD.StopCount);
+  return ((SD.WriteCommandCount == 1) && (SD.StopCount == 1) ? 0 : 1);
+}
+
+
+//=============================================================================
+// [STATIC] Measure the sequential reads or writes with a request size
+//=============================================================================
+static int __Bench_Run(bool write, uint32_t requestBlocks)
+{
+  SPI_SDcard SD;
+  eERRORRESULT Error = __Bench_PowerUp();
+  if (Error == ERR_NONE) Error = __Bench_InitCard(&SD, &BenchSimSPI);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); return 1; }
+  __Bench_FillData(requestBlocks);
+  if (write == false) memcpy(&BenchCard[0], &BenchData[0], sizeof(BenchData));
+  SPI_SDcard_ResetStats(&SD);
+  SPI_SimSD_ResetStats(&BenchSim);
+
+  const uint32_t RequestCount = BENCH_PASS_BLOCKS / requestBlocks;
+  const double Start = __Bench_Now_ns();
+  for (uint32_t zReq = 0; (zReq < RequestCount) && (Error == ERR_NONE); ++zReq)
+  {
+    uint8_t* pData = (write ? &BenchData[0] : &BenchCheck[0]) + ((size_t)zReq * requestBlocks * SPI_SDCARD_BLOCK_SIZE);
+    if (write) Error = SPI_SDcard_WriteBlocks(&SD, zReq * requestBlocks, pData, requestBlocks);
+    else Error = SPI_SDcard_ReadBlocks(&SD, zReq * requestBlocks, pData, requestBlocks);
+  }
+  if (Error == ERR_NONE) Error = SPI_SDcard_WaitIdle(&SD);
+  const double Time = __Bench_Now_ns() - Start;
+  if ((Error != ERR_NONE) || (memcmp((write ? &BenchCard[0] : &BenchCheck[0]), &BenchData[0], sizeof(BenchData)) != 0))
+  { printf("%s of %u blocks per request failed (error %d)\n", (write ? "Write" : "Read"), (unsigned)requestBlocks, (int)Error); return 1; }
+  const uint32_t Commands = (write ? SD.WriteCommandCount : SD.ReadCommandCount);
+  printf("%-5s  %6u  %9.3f  %9.3f  %9.2f  %11.1f\n", (write ? "write" : "read"), (unsigned)requestBlocks, (double)Commands / RequestCount,
+         (double)SD.StopCount / RequestCount, (double)SPI_SimSD_GetThroughput(&BenchSim) / 1e6, Time / BENCH_PASS_BLOCKS);
+  return 0;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_CheckSpidev();
+  Failures += __Bench_CheckQueuedWrites();
+  printf("%u sequential blocks per measure, SCK %u MHz\n", BENCH_PASS_BLOCKS, BENCH_SCK_FREQ / 1000000u);
+  printf("pass   blocks  cmds/req   stops/req  bus MB/s   host ns/blk\n");
+  for (int zWrite = 0; zWrite < 2; ++zWrite)
+    for (size_t zSize = 0; zSize < (sizeof(BENCH_REQUEST_BLOCKS) / sizeof(BENCH_REQUEST_BLOCKS[0])); ++zSize)
+      Failures += __Bench_Run((zWrite != 0), BENCH_REQUEST_BLOCKS[zSize]);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,309 @@
+/*!*****************************************************************************
+ * @file    SPI_SegmentList_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the SPI scatter-gather segment lists
+ * @details Host-only benchmark (Linux). The native segment list functions of
+ *          the Arduino and STM32 backends can't run on a host, this checks the
+ *          generic Interface_SPItransferSegmentList() on a recording interface:
+ *          - A list is given as a whole to a native segment list function
+ *          - Without native function, each segment is a packet with the chip
+ *            select of the list, only the last one has the Terminate of the
+ *            list, and the dummy byte and configuration of its segment
+ *          - The endian result of each segment is given back, and
+ *            Interface_SPIsegmentEndianTransform() switches the data of a
+ *            segment not transformed by the interface
+ *          - An error stops the list at the segment that failed
+ *          Then a fast read (instruction, 3 bytes address, 1 dummy byte, data)
+ *          of a memory behind the ioctl shim of the Linux spidev backend is
+ *          measured with a linear buffer (the instruction, address and dummy
+ *          byte copied before the data, the data copied out after), and with a
+ *          segment list (no copy, one ioctl for the list). It gives the ioctls,
+ *          the bytes copied by the driver and the host time per read. Build and
+ *          run from the repository root:
+ *            gcc -O2 -I. Bench/SPI_SegmentList_Bench.c SPI_LinuxDev.c SPI_Interface.c CRC.c EndianTransform.c -o SPISegmentListBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include "SPI_LinuxDev.h"
+#include "SPI_Interface.h"
+#include "ErrorsDef.h"
+#undef SPI_LSB_FIRST
+#include <linux/spi/spidev.h>
+//-----------------------------------------------------------------------------
+
+#define BENCH_FD            ( 3 )        //!< File descriptor of the simulated memory
+#define BENCH_MEMORY_SIZE   ( 65536u )   //!< Size of the memory
+#define BENCH_FAST_READ     ( 0x0Bu )    //!< Fast read instruction (3 bytes address, 1 dummy byte)
+#define BENCH_HEADER_SIZE   ( 5u )       //!< Instruction, address and dummy byte
+#define BENCH_MAX_READ      ( 4096u )    //!< Largest read measured
+#define BENCH_RECORD_COUNT  ( 1000000u ) //!< Count of bytes read per measure
+#define BENCH_MAX_RECORDS   ( 8u )       //!< Count of packets kept by the recording interface
+
+static const size_t BENCH_READ_SIZES[] = { 16, 256, 4096 }; //!< Read sizes measured
+
+//! Simulated SPI memory behind the ioctl shim
+typedef struct BenchMemory
+{
+  uint8_t Data[BENCH_MEMORY_SIZE]; //!< Content of the memory
+  bool Selected;                   //!< Chip select asserted
+  uint32_t Count;                  //!< Bytes received since the chip select assertion
+  uint32_t Address;                //!< Address of the read
+} BenchMemory;
+
+//! Recording SPI interface
+typedef struct BenchRecorder
+{
+  SPIInterface_Packet Packets[BENCH_MAX_RECORDS]; //!< Packets transferred
+  size_t PacketCount;                             //!< Count of packets transferred
+  size_t FailAt;                                  //!< Index of the packet that fails
+  size_t ListCount;                               //!< Count of lists given to the native segment list function
+} BenchRecorder;
+
+static BenchMemory BenchMem;
+static BenchRecorder BenchRec;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] ioctl shim: SPI memory with a fast read that follows the chip select
+//=============================================================================
+static int __Bench_Ioctl(int fd, unsigned long request, void* pArg)
+{
+  if (fd != BENCH_FD) { errno = EBADF; return -1; }
+  if ((request == SPI_IOC_WR_MODE32) || (request == SPI_IOC_WR_BITS_PER_WORD) || (request == SPI_IOC_WR_MAX_SPEED_HZ)) return 0;
+  if (_IOC_TYPE(request) != SPI_IOC_MAGIC) { errno = ENOTTY; return -1; }
+  const size_t TransferCount = _IOC_SIZE(request) / sizeof(struct spi_ioc_transfer);
+  const struct spi_ioc_transfer* pTransfers = (const struct spi_ioc_transfer*)pArg;
+  for (size_t zTransfer = 0; zTransfer < TransferCount; ++zTransfer)
+  {
+    const struct spi_ioc_transfer* pTransfer = &pTransfers[zTransfer];
+    if (BenchMem.Selected == false) { BenchMem.Selected = true; BenchMem.Count = 0; BenchMem.Address = 0; }
+    const uint8_t* pTx = (const uint8_t*)(uintptr_t)pTransfer->tx_buf;
+    uint8_t* pRx = (uint8_t*)(uintptr_t)pTransfer->rx_buf;
+    for (uint32_t zIdx = 0; zIdx < pTransfer->len; ++zIdx, ++BenchMem.Count)
+    {
+      const uint8_t Tx = (pTx != NULL ? pTx[zIdx] : 0x00);
+      uint8_t Rx = 0xFF;
+      if ((BenchMem.Count == 0) && (Tx != BENCH_FAST_READ)) BenchMem.Count = BENCH_MEMORY_SIZE; // Unknown instruction, ignore the rest
+      else if ((BenchMem.Count >= 1) && (BenchMem.Count <= 3)) BenchMem.Address = (BenchMem.Address << 8) | Tx;
+      else if ((BenchMem.Count >= BENCH_HEADER_SIZE) && (BenchMem.Count < BENCH_MEMORY_SIZE)) Rx = BenchMem.Data[BenchMem.Address++ % BENCH_MEMORY_SIZE];
+      if (pRx != NULL) pRx[zIdx] = Rx;
+    }
+  }
+  if ((TransferCount > 0) && (pTransfers[TransferCount - 1].cs_change == 0)) BenchMem.Selected = false; // End of message
+  return (int)TransferCount;
+}
+
+
+//=============================================================================
+// [STATIC] Recording interface transfer: the received data are the complement of the transmitted ones
+//=============================================================================
+static eERRORRESULT __Bench_RecTransfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc)
+{
+  BenchRecorder* pRec = (BenchRecorder*)pIntDev->InterfaceDevice;
+  if (pRec->PacketCount >= BENCH_MAX_RECORDS) return ERR__OUT_OF_MEMORY;
+  pRec->Packets[pRec->PacketCount] = *pPacketDesc;
+  if (pRec->PacketCount++ == pRec->FailAt) return ERR__SPI_COMM_ERROR;
+  for (size_t zIdx = 0; (pPacketDesc->RxData != NULL) && (zIdx < pPacketDesc->DataSize); ++zIdx)
+    pPacketDesc->RxData[zIdx] = (uint8_t)~(pPacketDesc->TxData != NULL ? pPacketDesc->TxData[zIdx] : pPacketDesc->DummyByte);
+  pPacketDesc->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;                         // No endian transform by this interface
+  pPacketDesc->Config.Value |= SPI_ENDIAN_RESULT_SET(SPI_NO_ENDIAN_CHANGE);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Recording interface native segment list
+//=============================================================================
+static eERRORRESULT __Bench_RecSegmentList(SPI_Interface *pIntDev, SPIInterface_SegmentList* const pSegmentList)
+{
+  BenchRecorder* pRec = (BenchRecorder*)pIntDev->InterfaceDevice;
+  (void)pSegmentList;
+  pRec->ListCount++;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Check the generic segment list transfer
+//=============================================================================
+static int __Bench_Checks(void)
+{
+  int Failures = 0;
+  SPI_Interface SPI;
+  memset(&SPI, 0, sizeof(SPI));
+  memset(&BenchRec, 0, sizeof(BenchRec));
+  BenchRec.FailAt = BENCH_MAX_RECORDS;
+  SPI.InterfaceDevice = &BenchRec;
+  SPI.fnSPI_Transfer  = __Bench_RecTransfer;
+
+  uint8_t Header[4] = { BENCH_FAST_READ, 0x01, 0x02, 0x03 }, Data[4], Status[2];
+  SPIInterface_Segment Segments[4];
+  memset(&Segments[0], 0, sizeof(Segments));
+  Segments[0].TxData = &Header[0]; Segments[0].DataSize = 4;
+  Segments[1].Config.Value = SPI_USE_DUMMYBYTE_FOR_RECEIVE; Segments[1].DummyByte = 0xA5; Segments[1].DataSize = 1;
+  Segments[2].Config.Value = SPI_USE_DUMMYBYTE_FOR_RECEIVE | SPI_ENDIAN_TRANSFORM_SET(SPI_SWITCH_ENDIAN_16BITS);
+  Segments[2].DummyByte = 0x00; Segments[2].RxData = &Data[0]; Segments[2].DataSize = 4;
+  Segments[3].Config.Value = SPI_USE_DUMMYBYTE_FOR_RECEIVE; Segments[3].DummyByte = 0xFF; Segments[3].RxData = &Status[0]; Segments[3].DataSize = 2;
+  SPIInterface_SegmentList List = { SPI_MEMBER(Config.Value) SPI_BLOCKING, SPI_MEMBER(ChipSelect) 2, SPI_MEMBER(pSegments) &Segments[0], SPI_MEMBER(SegmentCount) 4, SPI_MEMBER(Terminate) true };
+
+  //--- Native segment list function ---
+  SPI.fnSPI_TransferSegmentList = __Bench_RecSegmentList;
+  Failures += __Bench_Check(Interface_SPItransferSegmentList(&SPI, &List) == ERR_NONE, "native segment list");
+  Failures += __Bench_Check((BenchRec.ListCount == 1) && (BenchRec.PacketCount == 0), "list given as a whole to the native function");
+  SPI.fnSPI_TransferSegmentList = NULL;
+
+  //--- One packet per segment ---
+  Failures += __Bench_Check(Interface_SPItransferSegmentList(&SPI, &List) == ERR_NONE, "segment list without native function");
+  Failures += __Bench_Check(BenchRec.PacketCount == 4, "one packet per segment");
+  for (size_t zSeg = 0; zSeg < BenchRec.PacketCount; ++zSeg)
+  {
+    const SPIInterface_Packet* pPacket = &BenchRec.Packets[zSeg];
+    Failures += __Bench_Check(pPacket->ChipSelect == 2, "chip select of the list");
+    Failures += __Bench_Check(pPacket->Terminate == (zSeg == 3), "only the last packet terminates");
+    Failures += __Bench_Check((pPacket->TxData == Segments[zSeg].TxData) && (pPacket->RxData == Segments[zSeg].RxData) && (pPacket->DataSize == Segments[zSeg].DataSize), "buffers of the segment, no copy");
+    Failures += __Bench_Check((pPacket->DummyByte == Segments[zSeg].DummyByte) && (pPacket->Config.Bits.UseDummyByte == Segments[zSeg].Config.Bits.UseDummyByte), "dummy byte of the segment");
+  }
+  Failures += __Bench_Check((Status[0] == 0x00) && (Status[1] == 0x00), "data received with the dummy byte of the segment");
+  Failures += __Bench_Check(SPI_ENDIAN_RESULT_GET(Segments[2].Config.Value) == SPI_NO_ENDIAN_CHANGE, "endian result given back");
+  Data[0] = 0x12; Data[1] = 0x34;
+  Failures += __Bench_Check(Interface_SPIsegmentEndianTransform(&Segments[2]) == ERR_NONE, "endian transform of a segment");
+  Failures += __Bench_Check((Data[0] == 0x34) && (Data[1] == 0x12) && (SPI_ENDIAN_RESULT_GET(Segments[2].Config.Value) == SPI_SWITCH_ENDIAN_16BITS), "segment data switched");
+
+  //--- List without terminate, then an error in the middle of a list ---
+  BenchRec.PacketCount = 0;
+  List.Terminate = false;
+  Failures += __Bench_Check(Interface_SPItransferSegmentList(&SPI, &List) == ERR_NONE, "segment list without terminate");
+  Failures += __Bench_Check(BenchRec.Packets[3].Terminate == false, "chip select kept after a list without terminate");
+  BenchRec.PacketCount = 0;
+  BenchRec.FailAt = 1;
+  List.Terminate = true;
+  Failures += __Bench_Check(Interface_SPItransferSegmentList(&SPI, &List) == ERR__SPI_COMM_ERROR, "error of a segment returned");
+  Failures += __Bench_Check(BenchRec.PacketCount == 2, "list stopped at the segment that failed");
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Measure the fast reads with a linear buffer or with a segment list
+//=============================================================================
+static int __Bench_Run(bool segmentList, size_t readSize)
+{
+  SPI_Interface SPI;
+  SPI_LinuxDev Dev;
+  SPI_LinuxDevChip Chip;
+  memset(&Dev, 0, sizeof(Dev));
+  memset(&Chip, 0, sizeof(Chip));
+  memset(&BenchMem, 0, sizeof(BenchMem));
+  for (size_t zIdx = 0; zIdx < BENCH_MEMORY_SIZE; ++zIdx) BenchMem.Data[zIdx] = (uint8_t)((zIdx * 7u) ^ (zIdx >> 8));
+  Chip.Fd       = BENCH_FD;
+  Dev.pChips    = &Chip;
+  Dev.ChipCount = 1;
+  Dev.fnIoctl   = __Bench_Ioctl;
+  eERRORRESULT Error = SPI_LinuxDev_Attach(&SPI, &Dev);
+  if (Error == ERR_NONE) Error = SPI_LinuxDev_Init(&SPI, 0, STD_SPI_MODE0, 50000000);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); return 1; }
+
+  static uint8_t Linear[BENCH_HEADER_SIZE + BENCH_MAX_READ];
+  static uint8_t Data[BENCH_MAX_READ];
+  uint8_t Header[4] = { BENCH_FAST_READ, 0, 0, 0 };
+  SPIInterface_Segment Segments[3];
+  memset(&Segments[0], 0, sizeof(Segments));
+  Segments[0].TxData = &Header[0]; Segments[0].DataSize = 4;
+  Segments[1].Config.Value = SPI_USE_DUMMYBYTE_FOR_RECEIVE; Segments[1].DataSize = 1;
+  Segments[2].Config.Value = SPI_USE_DUMMYBYTE_FOR_RECEIVE; Segments[2].RxData = &Data[0]; Segments[2].DataSize = readSize;
+  SPIInterface_SegmentList List = { SPI_MEMBER(Config.Value) SPI_BLOCKING, SPI_MEMBER(ChipSelect) 0, SPI_MEMBER(pSegments) &Segments[0], SPI_MEMBER(SegmentCount) 3, SPI_MEMBER(Terminate) true };
+  SPIInterface_Packet Packet;
+  memset(&Packet, 0, sizeof(Packet));
+  Packet.Config.Value = SPI_BLOCKING;
+  Packet.TxData       = &Linear[0];
+  Packet.RxData       = &Linear[0];
+  Packet.DataSize     = BENCH_HEADER_SIZE + readSize;
+  Packet.Terminate    = true;
+
+  const uint32_t ReadCount = (uint32_t)(BENCH_RECORD_COUNT / readSize);
+  uint64_t Copied = 0;
+  int Failures = 0;
+  const double Start = __Bench_Now_ns();
+  for (uint32_t zRead = 0; (zRead < ReadCount) && (Failures == 0); ++zRead)
+  {
+    const uint32_t Address = (zRead * 97u) % (BENCH_MEMORY_SIZE - BENCH_MAX_READ);
+    const uint8_t* pData = &Data[0];
+    if (segmentList)
+    {
+      Header[1] = (uint8_t)(Address >> 16); Header[2] = (uint8_t)(Address >> 8); Header[3] = (uint8_t)Address;
+      Error = Interface_SPItransferSegmentList(&SPI, &List);
+    }
+    else
+    { // The driver builds the whole frame in one buffer, then copies the data out
+      Linear[0] = BENCH_FAST_READ; Linear[1] = (uint8_t)(Address >> 16); Linear[2] = (uint8_t)(Address >> 8); Linear[3] = (uint8_t)Address;
+      memset(&Linear[4], 0x00, 1 + readSize);
+      Error = SPI.fnSPI_Transfer(&SPI, &Packet);
+      memcpy(&Data[0], &Linear[BENCH_HEADER_SIZE], readSize);
+      Copied += (BENCH_HEADER_SIZE + readSize) + readSize;
+    }
+    if ((Error != ERR_NONE) || (memcmp(pData, &BenchMem.Data[Address], readSize) != 0))
+    { printf("Read %u failed (error %d)\n", (unsigned)zRead, (int)Error); ++Failures; }
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  printf("%-14s  %5u  %9.2f  %12.2f  %10.1f  %11.1f\n", (segmentList ? "segment list" : "linear buffer"), (unsigned)readSize, (double)Dev.IoctlCount / ReadCount,
+         (double)Dev.TransferCount / ReadCount, (double)Copied / ReadCount, Time / ReadCount);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = __Bench_Checks();
+  printf("Fast reads of %u bytes in total through the spidev ioctl shim\n", BENCH_RECORD_COUNT);
+  printf("driver           size  ioctl/rd  transfers/rd  copied B/rd  host ns/rd\n");
+  for (size_t zSize = 0; zSize < (sizeof(BENCH_READ_SIZES) / sizeof(BENCH_READ_SIZES[0])); ++zSize)
+  {
+    Failures += __Bench_Run(false, BENCH_READ_SIZES[zSize]);
+    Failures += __Bench_Run(true, BENCH_READ_SIZES[zSize]);
+  }
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
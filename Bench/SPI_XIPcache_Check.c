@@ -0,0 +1,196 @@
+/*!*****************************************************************************
+ * @file    SPI_XIPcache_Check.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check of the XIP read cache against the simulated Quad-SPI NOR
+ * @details Host-only check. It drives SPI_XIPcache through a SPI_Interface
+ *          attached to a SPI_SimNOR, with the 1-1-1 fast read and the 1-4-4
+ *          quad I/O read:
+ *          - Random reads, big direct reads and pointer accesses are compared
+ *            to the memory of the simulated flash
+ *          - A program of the flash is only seen after an invalidation
+ *          - The SCK cycles of a hot region read through the cache are
+ *            compared to the same reads sent directly to the flash
+ *          Build and run from the repository root:
+ *            gcc -O2 -I. Bench/SPI_XIPcache_Check.c SPI_XIPcache.c SPI_SimNOR.c SPI_Interface.c EndianTransform.c CRC.c -o XIPcheck
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "SPI_XIPcache.h"
+#include "SPI_SimNOR.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define CHECK_MEMORY_SIZE    ( 1024u * 1024u ) //!< Size of the simulated flash
+#define CHECK_LINE_COUNT     ( 64u )           //!< Count of cache lines (2kB of cache with the default line size)
+#define CHECK_SCK_FREQ       ( 50000000u )     //!< SCK frequency of the simulated flash
+#define CHECK_RANDOM_READS   ( 20000u )        //!< Count of random reads compared to the flash memory
+#define CHECK_HOT_SIZE       ( 1024u )         //!< Size of the hot region, smaller than the cache
+#define CHECK_HOT_ACCESS     ( 16u )           //!< Size of each access to the hot region
+#define CHECK_HOT_PASSES     ( 100u )          //!< Count of reads of the whole hot region
+
+static uint8_t CheckMemory[CHECK_MEMORY_SIZE];
+static uint8_t CheckLines[CHECK_LINE_COUNT * SPI_XIP_LINE_SIZE];
+static uint32_t CheckTags[CHECK_LINE_COUNT];
+static uint8_t CheckBuffer[3 * CHECK_LINE_COUNT * SPI_XIP_LINE_SIZE];
+
+//! Read instruction checked
+typedef struct
+{
+  const char* pName;             //!< Name of the read instruction
+  uint8_t Instruction;           //!< Instruction byte
+  eSPI_PhaseLines AddressLines;  //!< Line count of the address and dummy cycles phases
+  uint8_t DummyCycles;           //!< Dummy cycles of the instruction
+  eSPI_PhaseLines DataLines;     //!< Line count of the data phase
+} CheckReadCommand;
+
+static const CheckReadCommand CHECK_READ_COMMANDS[] =
+{
+  { "1-1-1 fast read   ", SPI_SIMNOR_FAST_READ   , SPI_PHASE_1_LINE , 8, SPI_PHASE_1_LINE  },
+  { "1-4-4 quad IO read", SPI_SIMNOR_QUAD_IO_READ, SPI_PHASE_4_LINES, 6, SPI_PHASE_4_LINES },
+};
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Count a failed check
+//=============================================================================
+static int __Check_Fail(const char* pName, const char* pWhat, uint32_t address, eERRORRESULT error)
+{
+  printf("%s: %s failed at 0x%06X (error %d)\n", pName, pWhat, (unsigned)address, (int)error);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Check the cache with one read instruction
+//=============================================================================
+static int __Check_ReadCommand(SPI_Interface* pSPI, SPI_SimNOR* pSim, const CheckReadCommand* pCommand)
+{
+  int Failures = 0;
+  eERRORRESULT Error;
+  SPI_XIPcache Cache;
+  memset(&Cache, 0, sizeof(Cache));
+  Cache.pSPI                         = pSPI;
+  Cache.ReadCommand.Instruction      = pCommand->Instruction;
+  Cache.ReadCommand.InstructionLines = SPI_PHASE_1_LINE;
+  Cache.ReadCommand.AddressSize      = 3;
+  Cache.ReadCommand.AddressLines     = pCommand->AddressLines;
+  Cache.ReadCommand.DummyCycles      = pCommand->DummyCycles;
+  Cache.ReadCommand.DataLines        = pCommand->DataLines;
+  Cache.MemorySize                   = CHECK_MEMORY_SIZE;
+  Cache.pLines                       = &CheckLines[0];
+  Cache.pTags                        = &CheckTags[0];
+  Cache.LineCount                    = CHECK_LINE_COUNT;
+  Error = SPI_XIP_Init(&Cache);
+  if (Error != ERR_NONE) return __Check_Fail(pCommand->pName, "init", 0, Error);
+
+  //--- Random reads, smaller and bigger than the cache ---
+  for (uint32_t zRead = 0; zRead < CHECK_RANDOM_READS; ++zRead)
+  {
+    const size_t Size = ((zRead % 100u) == 0 ? sizeof(CheckBuffer) - (size_t)(rand() % 64) : 1u + (size_t)(rand() % 300));
+    const uint32_t Address = (uint32_t)rand() % (CHECK_MEMORY_SIZE - (uint32_t)Size);
+    Error = SPI_XIP_Read(&Cache, Address, &CheckBuffer[0], Size);
+    if ((Error != ERR_NONE) || (memcmp(&CheckBuffer[0], &CheckMemory[Address], Size) != 0)) Failures += __Check_Fail(pCommand->pName, "read", Address, Error);
+  }
+  Error = SPI_XIP_Read(&Cache, CHECK_MEMORY_SIZE - 4u, &CheckBuffer[0], 8u);
+  if (Error != ERR__BAD_ADDRESS) Failures += __Check_Fail(pCommand->pName, "read past the end", CHECK_MEMORY_SIZE - 4u, Error);
+
+  //--- Pointer accesses ---
+  for (uint32_t zRead = 0; zRead < 1000u; ++zRead)
+  {
+    const uint32_t Address = ((uint32_t)rand() % CHECK_MEMORY_SIZE) & ~3u;
+    const uint8_t* pData = NULL;
+    Error = SPI_XIP_GetPointer(&Cache, Address, 4u, &pData);
+    if ((Error != ERR_NONE) || (memcmp(pData, &CheckMemory[Address], 4u) != 0)) Failures += __Check_Fail(pCommand->pName, "pointer access", Address, Error);
+  }
+  const uint8_t* pCrossing = NULL;
+  Error = SPI_XIP_GetPointer(&Cache, SPI_XIP_LINE_SIZE - 2u, 4u, &pCrossing);
+  if (Error != ERR__OUT_OF_RANGE) Failures += __Check_Fail(pCommand->pName, "pointer across lines", SPI_XIP_LINE_SIZE - 2u, Error);
+
+  //--- Program of the flash seen only after invalidation ---
+  const uint32_t ProgAddress = 0x1230u;
+  uint8_t Byte = 0;
+  Error = SPI_XIP_Read(&Cache, ProgAddress, &Byte, 1u);
+  CheckMemory[ProgAddress] ^= 0x5Au;                                            // Same as a program done without the cache
+  Error = SPI_XIP_Read(&Cache, ProgAddress, &Byte, 1u);
+  if ((Error != ERR_NONE) || (Byte == CheckMemory[ProgAddress])) Failures += __Check_Fail(pCommand->pName, "cached line kept", ProgAddress, Error);
+  Error = SPI_XIP_Invalidate(&Cache, ProgAddress, 1u);
+  if (Error == ERR_NONE) Error = SPI_XIP_Read(&Cache, ProgAddress, &Byte, 1u);
+  if ((Error != ERR_NONE) || (Byte != CheckMemory[ProgAddress])) Failures += __Check_Fail(pCommand->pName, "invalidation", ProgAddress, Error);
+
+  //--- Hot region through the cache ---
+  const uint32_t HotAddress = 0x40000u;
+  SPI_XIP_InvalidateAll(&Cache);
+  SPI_XIP_ResetStats(&Cache);
+  SPI_SimNOR_ResetStats(pSim);
+  for (uint32_t zPass = 0; zPass < CHECK_HOT_PASSES; ++zPass)
+    for (uint32_t zOffset = 0; zOffset < CHECK_HOT_SIZE; zOffset += CHECK_HOT_ACCESS)
+    {
+      Error = SPI_XIP_Read(&Cache, HotAddress + zOffset, &CheckBuffer[0], CHECK_HOT_ACCESS);
+      if ((Error != ERR_NONE) || (memcmp(&CheckBuffer[0], &CheckMemory[HotAddress + zOffset], CHECK_HOT_ACCESS) != 0)) Failures += __Check_Fail(pCommand->pName, "hot read", HotAddress + zOffset, Error);
+    }
+  const uint64_t CachedCycles = pSim->SCKcycles;
+  const uint32_t ExpectedMisses = CHECK_HOT_SIZE / SPI_XIP_LINE_SIZE;
+  if (Cache.LineMisses != ExpectedMisses) Failures += __Check_Fail(pCommand->pName, "hot region misses", HotAddress, ERR_NONE);
+
+  //--- Same reads sent directly to the flash ---
+  SPIInterface_PhasePacket Direct = Cache.ReadCommand;
+  Direct.RxData   = &CheckBuffer[0];
+  Direct.DataSize = CHECK_HOT_ACCESS;
+  SPI_SimNOR_ResetStats(pSim);
+  for (uint32_t zPass = 0; zPass < CHECK_HOT_PASSES; ++zPass)
+    for (uint32_t zOffset = 0; zOffset < CHECK_HOT_SIZE; zOffset += CHECK_HOT_ACCESS)
+    {
+      Direct.Address = HotAddress + zOffset;
+      Error = Interface_SPItransferPhases(pSPI, &Direct);
+      if (Error != ERR_NONE) Failures += __Check_Fail(pCommand->pName, "direct read", Direct.Address, Error);
+    }
+  const uint64_t DirectCycles = pSim->SCKcycles;
+
+  printf("%s  %6u  %6u  %5u  %13llu  %13llu  %6.1fx\n", pCommand->pName, (unsigned)Cache.LineHits, (unsigned)Cache.LineMisses, (unsigned)Cache.BusReads,
+         (unsigned long long)CachedCycles, (unsigned long long)DirectCycles, (CachedCycles > 0 ? (double)DirectCycles / (double)CachedCycles : 0.0));
+  return Failures;
+}
+
+
+//=============================================================================
+// Check entry point
+//=============================================================================
+int main(void)
+{
+  for (size_t zIdx = 0; zIdx < CHECK_MEMORY_SIZE; ++zIdx) CheckMemory[zIdx] = (uint8_t)(rand() & 0xFF);
+  SPI_SimNOR Sim;
+  SPI_Interface SPI;
+  memset(&Sim, 0, sizeof(Sim));
+  Sim.pMemory     = &CheckMemory[0];
+  Sim.MemorySize  = CHECK_MEMORY_SIZE;
+  Sim.JedecID[0]  = 0xEF;
+  Sim.JedecID[1]  = 0x40;
+  Sim.JedecID[2]  = 0x14;
+  Sim.AddressSize = 3;
+  eERRORRESULT Error = SPI_SimNOR_Attach(&SPI, &Sim);
+  if (Error == ERR_NONE) Error = SPI.fnSPI_Init(&SPI, 0, QUAD_SPI_MODE0, CHECK_SCK_FREQ);
+  if (Error != ERR_NONE) { printf("Simulated flash initialization failed (error %d)\n", (int)Error); return EXIT_FAILURE; }
+
+  int Failures = 0;
+  printf("hot region of %u bytes read %u times by %u bytes\n", CHECK_HOT_SIZE, CHECK_HOT_PASSES, CHECK_HOT_ACCESS);
+  printf("instruction          hits  misses  reads  cached cycles  direct cycles  saving\n");
+  for (size_t zCmd = 0; zCmd < (sizeof(CHECK_READ_COMMANDS) / sizeof(CHECK_READ_COMMANDS[0])); ++zCmd)
+    Failures += __Check_ReadCommand(&SPI, &Sim, &CHECK_READ_COMMANDS[zCmd]);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
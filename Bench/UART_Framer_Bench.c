@@ -0,0 +1,168 @@
+/*!*****************************************************************************
+ * @file    UART_Framer_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Benchmark of the COBS and SLIP framer against the UART line rates
+ * @details Host-only benchmark. The framer sends its frames to a loopback UART
+ *          (a ring UART interface that receives what it transmits) until the
+ *          ring has no room for a frame, then receives and checks them. For
+ *          each framing, payload and frame size it gives:
+ *          - The encode and decode throughput of the payload
+ *          - The CPU load needed to encode and decode a full duplex 8N1 line
+ *            at 1, 3, 6 and 12 Mbaud (baud / 10 bytes per second each way)
+ *          The payloads are random bytes (few special bytes) and bytes that are
+ *          all special (worst case: a COBS block per byte, each SLIP byte
+ *          escaped). Build and run from the repository root:
+ *            gcc -O2 -I. Bench/UART_Framer_Bench.c UART_Framer.c UART_RingBuffer.c -o FramerBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "UART_Framer.h"
+#include "UART_RingBuffer.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_PAYLOAD_BYTES  ( 32u * 1024u * 1024u ) //!< Payload bytes sent per measure
+#define BENCH_LINE_SIZE      ( 65536u )              //!< Size of the loopback ring
+#define BENCH_POOL_SIZE      ( 65536u )              //!< Size of the pool where the payloads are taken
+#define BENCH_MAX_FRAME      ( 1024u )               //!< Max size of a frame
+#define BENCH_RX_BUFFER_SIZE ( 4096u )               //!< Size of the receive buffer of the framer, holds an encoded frame
+#define BENCH_TX_BUFFER_SIZE ( 1024u )               //!< Size of the transmit buffer of the framer
+
+static const size_t BENCH_FRAME_SIZES[] = { 32, 256, 1024 };       //!< Sizes of the frames
+static const uint32_t BENCH_BAUDRATES[] = { 1000000, 3000000, 6000000, 12000000 }; //!< Line baudrates of the CPU load
+#define BENCH_BAUDRATE_COUNT  ( sizeof(BENCH_BAUDRATES) / sizeof(BENCH_BAUDRATES[0]) )
+
+static uint8_t BenchLineBuffer[BENCH_LINE_SIZE];
+static uint8_t BenchPool[BENCH_POOL_SIZE];
+static uint8_t BenchRxBuffer[BENCH_RX_BUFFER_SIZE];
+static uint8_t BenchTxBuffer[BENCH_TX_BUFFER_SIZE];
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Offset in the pool of the payload of a frame
+//=============================================================================
+static size_t __Bench_FrameOffset(uint32_t frame, size_t frameSize)
+{
+  return ((size_t)frame * 997u) % (BENCH_POOL_SIZE - frameSize);
+}
+
+
+//=============================================================================
+// [STATIC] Run a measure of a framing, a payload and a frame size
+//=============================================================================
+static int __Bench_Run(eUART_FramerType type, bool special, size_t frameSize)
+{
+  if (special) memset(&BenchPool[0], (type == UART_FRAMER_COBS ? UART_FRAMER_COBS_DELIMITER : UART_FRAMER_SLIP_END), sizeof(BenchPool));
+  else for (size_t zIdx = 0; zIdx < BENCH_POOL_SIZE; ++zIdx) BenchPool[zIdx] = (uint8_t)(rand() & 0xFF);
+
+  //--- Loopback UART and framer ---
+  UART_RingBuffer Line;
+  UART_RingInterface LineInt;
+  UART_Interface UART;
+  UART_Framer Framer;
+  eERRORRESULT Error = UART_RingBuffer_Init(&Line, &BenchLineBuffer[0], sizeof(BenchLineBuffer));
+  LineInt.pRx           = &Line;
+  LineInt.pTx           = &Line;
+  LineInt.LastCharError = 0;
+  if (Error == ERR_NONE) Error = UART_RingInterface_Attach(&UART, &LineInt);
+  memset(&Framer, 0, sizeof(Framer));
+  Framer.pUART        = &UART;
+  Framer.Type         = type;
+  Framer.pRxBuffer    = &BenchRxBuffer[0];
+  Framer.RxBufferSize = sizeof(BenchRxBuffer);
+  Framer.pTxBuffer    = &BenchTxBuffer[0];
+  Framer.TxBufferSize = sizeof(BenchTxBuffer);
+  if (Error == ERR_NONE) Error = UART_Framer_Init(&Framer);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); return 1; }
+
+  //--- Send frames while the line has room for a worst case frame, then receive them ---
+  const size_t WorstFrame = (2u * frameSize) + 2u;
+  const uint32_t FrameCount = (uint32_t)(BENCH_PAYLOAD_BYTES / frameSize);
+  uint32_t SentFrames = 0, ReceivedFrames = 0;
+  size_t WireBytes = 0;
+  double EncodeTime = 0.0, DecodeTime = 0.0;
+  int Failures = 0;
+  while ((ReceivedFrames < FrameCount) && (Failures == 0))
+  {
+    const size_t LineStart = UART_RingBuffer_Count(&Line);
+    double Start = __Bench_Now_ns();
+    while ((SentFrames < FrameCount) && ((BENCH_LINE_SIZE - UART_RingBuffer_Count(&Line)) >= WorstFrame))
+    {
+      Error = UART_Framer_SendFrame(&Framer, &BenchPool[__Bench_FrameOffset(SentFrames, frameSize)], frameSize);
+      if (Error != ERR_NONE) { printf("Send failed (error %d)\n", (int)Error); return 1; }
+      ++SentFrames;
+    }
+    EncodeTime += __Bench_Now_ns() - Start;
+    WireBytes  += UART_RingBuffer_Count(&Line) - LineStart;
+
+    Start = __Bench_Now_ns();
+    while ((UART_RingBuffer_Count(&Line) > 0) || (Framer.RxScan < Framer.RxEnd))
+    {
+      UART_FramerFrame Frame;
+      Error = UART_Framer_Receive(&Framer, &Frame);
+      if (Error == ERR__NO_DATA_AVAILABLE) continue;
+      if ((Error != ERR_NONE) || (Frame.Size != frameSize)
+       || (memcmp(Frame.pData, &BenchPool[__Bench_FrameOffset(ReceivedFrames, frameSize)], frameSize) != 0))
+      { printf("Frame %u received wrong (error %d)\n", (unsigned)ReceivedFrames, (int)Error); ++Failures; break; }
+      ++ReceivedFrames;
+    }
+    DecodeTime += __Bench_Now_ns() - Start;
+  }
+  if ((Framer.RxErrorCount != 0) || (Framer.RxOverflowCount != 0)) ++Failures;
+
+  //--- Throughput and CPU load of a full duplex line ---
+  const double PayloadBytes = (double)FrameCount * (double)frameSize;
+  const double WireByte_ns  = (EncodeTime + DecodeTime) / (double)WireBytes;
+  printf("%s %-7s  %5u  %8.2f  %8.0f  %8.0f", (type == UART_FRAMER_COBS ? "COBS" : "SLIP"), (special ? "special" : "random"), (unsigned)frameSize,
+         (double)WireBytes / PayloadBytes, PayloadBytes * 1e3 / EncodeTime, PayloadBytes * 1e3 / DecodeTime);
+  for (size_t zBaud = 0; zBaud < BENCH_BAUDRATE_COUNT; ++zBaud)
+    printf("  %6.2f%%", ((double)BENCH_BAUDRATES[zBaud] / 10.0) * WireByte_ns * 1e-9 * 100.0);
+  printf("\n");
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = 0;
+  printf("%u MB of payload per measure, CPU load to encode and decode a full duplex 8N1 line\n", BENCH_PAYLOAD_BYTES / (1024u * 1024u));
+  printf("framing       frame  overhead  enc MB/s  dec MB/s");
+  for (size_t zBaud = 0; zBaud < BENCH_BAUDRATE_COUNT; ++zBaud) printf("  %2uMbaud", (unsigned)(BENCH_BAUDRATES[zBaud] / 1000000u));
+  printf("\n");
+  for (int zType = 0; zType < 2; ++zType)
+    for (int zSpecial = 0; zSpecial < 2; ++zSpecial)
+      for (size_t zSize = 0; zSize < (sizeof(BENCH_FRAME_SIZES) / sizeof(BENCH_FRAME_SIZES[0])); ++zSize)
+        Failures += __Bench_Run((zType == 0 ? UART_FRAMER_COBS : UART_FRAMER_SLIP), (zSpecial != 0), BENCH_FRAME_SIZES[zSize]);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,221 @@
+/*!*****************************************************************************
+ * @file    UART_LinuxTTY_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Benchmark of the batched receive of the Linux termios backend
+ * @details Host-only benchmark (Linux). A sender thread writes messages on the
+ *          master side of an openpty() pair at the pace of a baudrate (2 bytes
+ *          per character times, then a silence between the messages). The
+ *          slave side is a channel of UART_LinuxTTY and receives each message:
+ *          - With a wake up per part: ppoll() on the tty then
+ *            UART_LinuxTTY_Receive() in a loop until the whole message is
+ *            received (the usual event driven receive)
+ *          - With UART_LinuxTTY_ReceiveBatch() and the size of the message as
+ *            threshold
+ *          - With UART_LinuxTTY_ReceiveBatch() ending on the idle line
+ *          The receive is a stream: a batched receive ended before the end of
+ *          the message by a late sender is counted as an early return and the
+ *          receive goes on, the bytes after the end of a message are kept for
+ *          the next one
+ *          It gives the read() calls, the waits (ppoll() and clock_nanosleep()
+ *          calls) and all these syscalls per message, the latency
+ *          between the write of the last byte and the end of the receive, and
+ *          checks the bytes received. Build and run from the repository root:
+ *            gcc -O2 -I. Bench/UART_LinuxTTY_Bench.c UART_LinuxTTY.c -lpthread -lutil -o LinuxTTYBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <pty.h>
+#include <poll.h>
+#include "UART_LinuxTTY.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_MESSAGE_SIZE   ( 64u )   //!< Size of a message
+#define BENCH_MESSAGE_COUNT  ( 100u )  //!< Count of messages per measure
+#define BENCH_PART_SIZE      ( 2u )    //!< Count of bytes written at once by the sender
+#define BENCH_SILENCE_CHARS  ( 40u )   //!< Silence between the messages in character times
+#define BENCH_IDLE_CHARS     ( 8u )    //!< Idle time that ends the receive, in character times
+#define BENCH_TIMEOUT_US     ( 1000000u ) //!< Timeout of a batched receive
+
+static const uint32_t BENCH_BAUDRATES[] = { 115200, 1000000 }; //!< Baudrates of the sender
+
+//! Receive mode measured
+typedef enum
+{
+  BENCH_WAKEUP,    //!< ppoll() then UART_LinuxTTY_Receive() for each part received
+  BENCH_THRESHOLD, //!< Batched receive ending on the threshold
+  BENCH_IDLE,      //!< Batched receive ending on the idle line
+} eBenchMode;
+
+static const char* const BENCH_MODE_NAMES[] = { "wake up per part", "batch threshold", "batch idle line" };
+
+//! Sender of the messages
+typedef struct BenchSender
+{
+  int Fd;                                        //!< Master side of the pty
+  uint32_t Baudrate;                             //!< Pace of the bytes
+  volatile double LastByte[BENCH_MESSAGE_COUNT]; //!< Time of the write of the last byte of each message, set before the write
+  volatile int Failed;                           //!< Set if a write failed
+} BenchSender;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Sleep until an absolute time in ns
+//=============================================================================
+static void __Bench_SleepUntil(double time_ns)
+{
+  const struct timespec Time = { .tv_sec = (time_t)(time_ns / 1e9), .tv_nsec = (long)(time_ns - ((double)(time_t)(time_ns / 1e9) * 1e9)) };
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Time, NULL) == EINTR);
+}
+
+
+//=============================================================================
+// [STATIC] Sender thread: write the messages at the pace of the baudrate
+//=============================================================================
+static void* __Bench_Sender(void* pArg)
+{
+  BenchSender* pSender = (BenchSender*)pArg;
+  const double CharTime = 10e9 / (double)pSender->Baudrate;                     // 8N1
+  uint8_t Value = 0;
+  double Next = __Bench_Now_ns() + (BENCH_SILENCE_CHARS * CharTime);
+  for (uint32_t zMsg = 0; zMsg < BENCH_MESSAGE_COUNT; ++zMsg)
+  {
+    for (uint32_t zPart = 0; zPart < BENCH_MESSAGE_SIZE; zPart += BENCH_PART_SIZE)
+    {
+      uint8_t Part[BENCH_PART_SIZE];
+      for (uint32_t zIdx = 0; zIdx < BENCH_PART_SIZE; ++zIdx) Part[zIdx] = Value++;
+      Next += BENCH_PART_SIZE * CharTime;                                       // The bytes of the part are on the line
+      __Bench_SleepUntil(Next);
+      if ((zPart + BENCH_PART_SIZE) >= BENCH_MESSAGE_SIZE) pSender->LastByte[zMsg] = __Bench_Now_ns(); // Before the receiver can see the last byte
+      if (write(pSender->Fd, &Part[0], BENCH_PART_SIZE) != (ssize_t)BENCH_PART_SIZE) pSender->Failed = 1;
+    }
+    Next += BENCH_SILENCE_CHARS * CharTime;
+  }
+  return NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Run a measure with a receive mode and a baudrate
+//=============================================================================
+static int __Bench_Run(eBenchMode mode, uint32_t baudrate)
+{
+  int Master, Slave;
+  if (openpty(&Master, &Slave, NULL, NULL, NULL) < 0) { printf("openpty failed\n"); return 1; }
+  UART_LinuxTTYchannel Channel;
+  UART_LinuxTTY Dev;
+  UART_Interface UART;
+  memset(&Channel, 0, sizeof(Channel));
+  Channel.Fd       = Slave;
+  Channel.Baudrate = baudrate;
+  Dev.pChannels    = &Channel;
+  Dev.ChannelCount = 1;
+  eERRORRESULT Error = UART_LinuxTTY_Init(&Dev);
+  if (Error == ERR_NONE) Error = UART_LinuxTTY_Attach(&UART, &Dev, 0);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); close(Master); close(Slave); return 1; }
+
+  static BenchSender Sender;
+  memset(&Sender, 0, sizeof(Sender));
+  Sender.Fd       = Master;
+  Sender.Baudrate = baudrate;
+  pthread_t Thread;
+  if (pthread_create(&Thread, NULL, __Bench_Sender, &Sender) != 0) { UART_LinuxTTY_Close(&Dev); close(Master); return 1; }
+
+  //--- Receive the messages, the bytes after the end of a message are kept for the next one ---
+  int Failures = 0;
+  uint8_t Message[4 * BENCH_MESSAGE_SIZE];
+  uint8_t Expected = 0;
+  size_t Total = 0;
+  uint32_t Early = 0, Waits = 0;
+  double LatencySum = 0.0, LatencyMax = 0.0, End = __Bench_Now_ns();
+  for (uint32_t zMsg = 0; (zMsg < BENCH_MESSAGE_COUNT) && (Failures == 0); ++zMsg)
+  {
+    while ((Total < BENCH_MESSAGE_SIZE) && (Error == ERR_NONE))
+    {
+      size_t Received = 0;
+      uint8_t LastCharError = UART_NO_ERROR;
+      switch (mode)
+      {
+        case BENCH_WAKEUP:
+        {
+          struct pollfd PollFd = { .fd = Slave, .events = POLLIN, .revents = 0 };
+          ++Waits;
+          if (poll(&PollFd, 1, (int)(BENCH_TIMEOUT_US / 1000u)) <= 0) break;     // Timeout
+          Error = UART_LinuxTTY_Receive(&UART, &Message[Total], BENCH_MESSAGE_SIZE - Total, &Received, &LastCharError);
+          break;
+        }
+        case BENCH_THRESHOLD: Error = UART_LinuxTTY_ReceiveBatch(&UART, &Message[Total], BENCH_MESSAGE_SIZE - Total, 0, 0, BENCH_TIMEOUT_US, &Received, &LastCharError); break;
+        default             : Error = UART_LinuxTTY_ReceiveBatch(&UART, &Message[Total], sizeof(Message) - Total, 0, BENCH_IDLE_CHARS, BENCH_TIMEOUT_US, &Received, &LastCharError); break;
+      }
+      End = __Bench_Now_ns();
+      if (Received == 0) break;                                                  // Timeout
+      Total += Received;
+      if ((mode != BENCH_WAKEUP) && (Total < BENCH_MESSAGE_SIZE)) ++Early;       // A late sender ended the receive before the end of the message
+    }
+    if ((Error != ERR_NONE) || (Total < BENCH_MESSAGE_SIZE)) { printf("Message %u: %u bytes received (error %d)\n", (unsigned)zMsg, (unsigned)Total, (int)Error); ++Failures; break; }
+    for (size_t zIdx = 0; zIdx < BENCH_MESSAGE_SIZE; ++zIdx)
+      if (Message[zIdx] != Expected++) { printf("Message %u: wrong byte %u\n", (unsigned)zMsg, (unsigned)zIdx); ++Failures; break; }
+    Total -= BENCH_MESSAGE_SIZE;
+    memmove(&Message[0], &Message[BENCH_MESSAGE_SIZE], Total);
+    const double Latency = End - Sender.LastByte[zMsg];                         // End of the receive that got the last byte of the message
+    LatencySum += Latency;
+    if (Latency > LatencyMax) LatencyMax = Latency;
+  }
+  pthread_join(Thread, NULL);
+  if (Sender.Failed != 0) { printf("The sender failed\n"); ++Failures; }
+
+  Waits += Channel.SleepCount;
+  printf("%-16s  %7u  %9.1f  %9.1f  %12.1f  %10.1f  %10.1f  %5u\n", BENCH_MODE_NAMES[mode], (unsigned)baudrate,
+         (double)Channel.ReadCount / BENCH_MESSAGE_COUNT, (double)Waits / BENCH_MESSAGE_COUNT, (double)(Channel.ReadCount + Waits) / BENCH_MESSAGE_COUNT,
+         LatencySum / BENCH_MESSAGE_COUNT / 1e3, LatencyMax / 1e3, (unsigned)Early);
+  UART_LinuxTTY_Close(&Dev);
+  close(Master);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  int Failures = 0;
+  printf("%u messages of %u bytes, idle line after %u characters\n", BENCH_MESSAGE_COUNT, BENCH_MESSAGE_SIZE, BENCH_IDLE_CHARS);
+  printf("receive           baudrate  reads/msg  waits/msg  syscalls/msg  avg lat us  max lat us  early\n");
+  for (size_t zBaud = 0; zBaud < (sizeof(BENCH_BAUDRATES) / sizeof(BENCH_BAUDRATES[0])); ++zBaud)
+    for (int zMode = BENCH_WAKEUP; zMode <= BENCH_IDLE; ++zMode)
+      Failures += __Bench_Run((eBenchMode)zMode, BENCH_BAUDRATES[zBaud]);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,293 @@
+/*!*****************************************************************************
+ * @file    UART_LinuxTTY_Channels_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Check and benchmark of the non-blocking channels of the Linux termios backend
+ * @details Host-only benchmark (Linux). Both sides of openpty() pairs are
+ *          channels of the same UART_LinuxTTY backend. It checks:
+ *          - A transmit larger than the tty buffer sends a part of the data
+ *            (actuallySent < size) and clears Writable, the next one sends 0
+ *            byte without blocking
+ *          - A receive gets what the tty has, clears Readable when it gets
+ *            less than asked, and gets 0 byte without blocking when empty
+ *          - The epoll gives back the output event when the other side reads
+ *          - The hang up of the other side is given after its last data
+ *          Then one thread serves all the channels with UART_LinuxTTY_Wait():
+ *          the slave side of each pair echoes what it receives, the master
+ *          side sends a stream and checks the echo. It gives the data
+ *          throughput, the epoll_wait() calls and the events per wait, and the
+ *          transmits and receives that did not progress, for 1 to 16 pairs.
+ *          Build and run from the repository root:
+ *            gcc -O2 -I. Bench/UART_LinuxTTY_Channels_Bench.c UART_LinuxTTY.c -lutil -o LinuxTTYChannelsBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pty.h>
+#include "UART_LinuxTTY.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_MAX_PAIRS      ( 16u )         //!< Max count of openpty() pairs
+#define BENCH_STREAM_SIZE    ( 1u << 20 )    //!< Bytes sent by all the pairs per measure
+#define BENCH_CHUNK_SIZE     ( 4096u )       //!< Max bytes per transmit or receive
+#define BENCH_LARGE_SIZE     ( 1u << 20 )    //!< Size of the transmit larger than the tty buffer
+#define BENCH_WAIT_MS        ( 1000 )        //!< Timeout of a wait, a measure without progress during it fails
+
+static const size_t BENCH_PAIR_COUNTS[] = { 1, 4, 16 }; //!< Count of pairs measured
+
+//! Side of a pair in the loop
+typedef struct BenchSide
+{
+  UART_Interface UART;             //!< Interface of the channel
+  uint8_t Buffer[BENCH_CHUNK_SIZE]; //!< Echo buffer of the slave side
+  size_t Start;                    //!< Start of the data to echo
+  size_t End;                      //!< End of the data to echo
+  size_t TxPos;                    //!< Bytes sent by the master side
+  size_t RxPos;                    //!< Bytes checked by the master side
+} BenchSide;
+
+static uint8_t BenchPattern[BENCH_CHUNK_SIZE + 256];
+static uint8_t BenchLarge[BENCH_LARGE_SIZE];
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] Check a condition and print the failure
+//=============================================================================
+static int __Bench_Check(bool condition, const char* pWhat)
+{
+  if (condition) return 0;
+  printf("Check failed: %s\n", pWhat);
+  return 1;
+}
+
+
+//=============================================================================
+// [STATIC] Open the pairs, channel 2N is the master side and 2N+1 the slave side of the pair N
+//=============================================================================
+static eERRORRESULT __Bench_Open(UART_LinuxTTY* pDev, UART_LinuxTTYchannel* pChannels, size_t pairCount)
+{
+  memset(pChannels, 0, 2 * pairCount * sizeof(UART_LinuxTTYchannel));
+  for (size_t zPair = 0; zPair < pairCount; ++zPair)
+  {
+    int Master, Slave;
+    if (openpty(&Master, &Slave, NULL, NULL, NULL) < 0) return ERR__NO_DEVICE_DETECTED;
+    pChannels[2 * zPair].Fd     = Master;
+    pChannels[2 * zPair + 1].Fd = Slave;
+  }
+  pDev->pChannels    = pChannels;
+  pDev->ChannelCount = 2 * pairCount;
+  return UART_LinuxTTY_Init(pDev);
+}
+
+
+//=============================================================================
+// [STATIC] Check the partial progress of the transmits and receives
+//=============================================================================
+static int __Bench_Checks(void)
+{
+  UART_LinuxTTYchannel Channels[2];
+  UART_LinuxTTY Dev;
+  UART_Interface Master, Slave;
+  int Failures = 0;
+  if ((__Bench_Open(&Dev, &Channels[0], 1) != ERR_NONE) || (UART_LinuxTTY_Attach(&Master, &Dev, 0) != ERR_NONE)
+   || (UART_LinuxTTY_Attach(&Slave, &Dev, 1) != ERR_NONE)) { printf("Initialization failed\n"); return 1; }
+  for (size_t zIdx = 0; zIdx < BENCH_LARGE_SIZE; ++zIdx) BenchLarge[zIdx] = (uint8_t)(zIdx ^ (zIdx >> 8));
+  static uint8_t Rx[BENCH_LARGE_SIZE];
+  size_t Sent = 0, Received = 0, Count = 0;
+  uint8_t LastCharError = UART_NO_ERROR;
+
+  //--- Receive without data ---
+  double Start = __Bench_Now_ns();
+  Failures += __Bench_Check(UART_LinuxTTY_Receive(&Slave, &Rx[0], 16, &Received, &LastCharError) == ERR_NONE, "receive without data");
+  Failures += __Bench_Check((Received == 0) && (Channels[1].Readable == false) && (Channels[1].WouldBlock == 1), "nothing received, no progress");
+  Failures += __Bench_Check((__Bench_Now_ns() - Start) < 1e6, "receive without data does not block");
+
+  //--- Transmit larger than the tty buffer ---
+  Failures += __Bench_Check(UART_LinuxTTY_Transmit(&Master, &BenchLarge[0], BENCH_LARGE_SIZE, &Sent) == ERR_NONE, "large transmit");
+  Failures += __Bench_Check((Sent > 0) && (Sent < BENCH_LARGE_SIZE) && (Channels[0].Writable == false), "part of the large transmit sent");
+  Start = __Bench_Now_ns();
+  Failures += __Bench_Check(UART_LinuxTTY_Transmit(&Master, &BenchLarge[Sent], BENCH_LARGE_SIZE - Sent, &Count) == ERR_NONE, "transmit with a full tty buffer");
+  Failures += __Bench_Check((Count == 0) && (Channels[0].WouldBlock == 1), "nothing sent, no progress");
+  Failures += __Bench_Check((__Bench_Now_ns() - Start) < 1e6, "transmit with a full tty buffer does not block");
+
+  //--- Receive of the part sent, then the output event ---
+  Failures += __Bench_Check(UART_LinuxTTY_Wait(&Dev, BENCH_WAIT_MS, &Count) == ERR_NONE, "wait for the input event");
+  Failures += __Bench_Check(Channels[1].Readable, "input event of the slave side");
+  size_t Total = 0;
+  for (int zWait = 0; (zWait < 100) && (Total < Sent); ++zWait)                 // The pty gives the data in parts
+  {
+    while (Channels[1].Readable && (Total < Sent))
+    {
+      Failures += __Bench_Check(UART_LinuxTTY_Receive(&Slave, &Rx[Total], BENCH_LARGE_SIZE - Total, &Received, &LastCharError) == ERR_NONE, "receive of the part sent");
+      Total += Received;
+    }
+    if (Total < Sent) Failures += __Bench_Check(UART_LinuxTTY_Wait(&Dev, BENCH_WAIT_MS, &Count) == ERR_NONE, "wait for the next part");
+  }
+  Failures += __Bench_Check((Total == Sent) && (memcmp(&Rx[0], &BenchLarge[0], Sent) == 0), "part sent received");
+  Failures += __Bench_Check(Channels[1].Readable == false, "Readable cleared by a receive of less than asked");
+  for (int zWait = 0; (zWait < 10) && (Channels[0].Writable == false); ++zWait)
+    Failures += __Bench_Check(UART_LinuxTTY_Wait(&Dev, BENCH_WAIT_MS, &Count) == ERR_NONE, "wait for the output event");
+  Failures += __Bench_Check(Channels[0].Writable, "output event of the master side after the receive");
+
+  //--- Hang up after the last data: the slave side closes, the master side receives its last data then the hang up ---
+  Failures += __Bench_Check(UART_LinuxTTY_Transmit(&Slave, &BenchLarge[0], 100, &Sent) == ERR_NONE, "transmit before the hang up");
+  close(Channels[1].Fd);
+  Channels[1].Fd = -1;
+  Total = 0;
+  LastCharError = UART_NO_ERROR;
+  for (int zWait = 0; (zWait < 100) && (LastCharError == UART_NO_ERROR); ++zWait)
+  {
+    Failures += __Bench_Check(UART_LinuxTTY_Wait(&Dev, BENCH_WAIT_MS, &Count) == ERR_NONE, "wait for the hang up");
+    while (Channels[0].Readable && (LastCharError == UART_NO_ERROR))
+    {
+      Failures += __Bench_Check(UART_LinuxTTY_Receive(&Master, &Rx[Total], 1000 - Total, &Received, &LastCharError) == ERR_NONE, "receive of the last data");
+      Failures += __Bench_Check((LastCharError == UART_NO_ERROR) || (Received == 0), "no data with the hang up");
+      Total += Received;
+    }
+  }
+  Failures += __Bench_Check((Total == 100) && (memcmp(&Rx[0], &BenchLarge[0], 100) == 0), "last data before the hang up");
+  Failures += __Bench_Check((LastCharError == UART_LINUXTTY_HANGUP_ERROR) && Channels[0].HangUp, "hang up given after the last data");
+  UART_LinuxTTY_Close(&Dev);
+  return Failures;
+}
+
+
+//=============================================================================
+// [STATIC] Serve the master side of a pair: send the stream and check the echo
+//=============================================================================
+static int __Bench_ServeMaster(BenchSide* pSide, UART_LinuxTTYchannel* pChannel, size_t streamSize, uint8_t seed, bool* pProgress)
+{
+  size_t Count;
+  uint8_t LastCharError = UART_NO_ERROR, Rx[BENCH_CHUNK_SIZE];
+  while (pChannel->Writable && (pSide->TxPos < streamSize))
+  {
+    const size_t Size = ((streamSize - pSide->TxPos) < BENCH_CHUNK_SIZE ? (streamSize - pSide->TxPos) : BENCH_CHUNK_SIZE);
+    if (UART_LinuxTTY_Transmit(&pSide->UART, &BenchPattern[(pSide->TxPos + seed) & 0xFFu], Size, &Count) != ERR_NONE) return 1;
+    pSide->TxPos += Count;
+    if (Count > 0) *pProgress = true;
+  }
+  while (pChannel->Readable)
+  {
+    if (UART_LinuxTTY_Receive(&pSide->UART, &Rx[0], sizeof(Rx), &Count, &LastCharError) != ERR_NONE) return 1;
+    for (size_t zIdx = 0; zIdx < Count; ++zIdx, ++pSide->RxPos)
+      if (Rx[zIdx] != (uint8_t)(pSide->RxPos + seed)) { printf("Wrong byte echoed at %u\n", (unsigned)pSide->RxPos); return 1; }
+    if (Count > 0) *pProgress = true;
+  }
+  return 0;
+}
+
+
+//=============================================================================
+// [STATIC] Serve the slave side of a pair: echo what is received
+//=============================================================================
+static int __Bench_ServeSlave(BenchSide* pSide, UART_LinuxTTYchannel* pChannel, bool* pProgress)
+{
+  size_t Count;
+  uint8_t LastCharError = UART_NO_ERROR;
+  bool Progress = true;
+  while (Progress)
+  {
+    Progress = false;
+    if (pChannel->Readable && (pSide->End < BENCH_CHUNK_SIZE))
+    {
+      if (UART_LinuxTTY_Receive(&pSide->UART, &pSide->Buffer[pSide->End], BENCH_CHUNK_SIZE - pSide->End, &Count, &LastCharError) != ERR_NONE) return 1;
+      pSide->End += Count;
+      Progress |= (Count > 0);
+    }
+    if (pChannel->Writable && (pSide->Start < pSide->End))
+    {
+      if (UART_LinuxTTY_Transmit(&pSide->UART, &pSide->Buffer[pSide->Start], pSide->End - pSide->Start, &Count) != ERR_NONE) return 1;
+      pSide->Start += Count;
+      Progress |= (Count > 0);
+    }
+    if (pSide->Start == pSide->End) pSide->Start = pSide->End = 0;
+    *pProgress |= Progress;
+  }
+  return 0;
+}
+
+
+//=============================================================================
+// [STATIC] Serve all the channels with one thread
+//=============================================================================
+static int __Bench_Run(size_t pairCount)
+{
+  static UART_LinuxTTYchannel Channels[2 * BENCH_MAX_PAIRS];
+  static BenchSide Sides[2 * BENCH_MAX_PAIRS];
+  UART_LinuxTTY Dev;
+  memset(&Sides[0], 0, sizeof(Sides));
+  eERRORRESULT Error = __Bench_Open(&Dev, &Channels[0], pairCount);
+  for (size_t zChannel = 0; (zChannel < Dev.ChannelCount) && (Error == ERR_NONE); ++zChannel)
+    Error = UART_LinuxTTY_Attach(&Sides[zChannel].UART, &Dev, (uint8_t)zChannel);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); return 1; }
+
+  const size_t StreamSize = BENCH_STREAM_SIZE / pairCount;
+  int Failures = 0;
+  size_t Done = 0;
+  const double Start = __Bench_Now_ns();
+  while ((Done < pairCount) && (Failures == 0))
+  {
+    bool Progress = false;
+    Done = 0;
+    for (size_t zPair = 0; zPair < pairCount; ++zPair)
+    {
+      Failures += __Bench_ServeMaster(&Sides[2 * zPair], &Channels[2 * zPair], StreamSize, (uint8_t)(zPair * 37u), &Progress);
+      Failures += __Bench_ServeSlave(&Sides[2 * zPair + 1], &Channels[2 * zPair + 1], &Progress);
+      if (Sides[2 * zPair].RxPos == StreamSize) ++Done;
+    }
+    if ((Done == pairCount) || Progress) continue;
+    size_t EventCount = 0;
+    if ((UART_LinuxTTY_Wait(&Dev, BENCH_WAIT_MS, &EventCount) != ERR_NONE) || (EventCount == 0)) { printf("No progress with %u pairs\n", (unsigned)pairCount); ++Failures; }
+  }
+  const double Time = __Bench_Now_ns() - Start;
+  uint32_t WouldBlock = 0;
+  for (size_t zChannel = 0; zChannel < Dev.ChannelCount; ++zChannel) WouldBlock += Channels[zChannel].WouldBlock;
+  printf("%5u  %9.2f  %10u  %11.2f  %12u\n", (unsigned)pairCount, ((double)StreamSize * pairCount * 2.0) / (Time / 1e9) / 1e6,
+         (unsigned)Dev.WaitCount, (Dev.WaitCount > 0 ? (double)Dev.EventCount / Dev.WaitCount : 0.0), (unsigned)WouldBlock);
+  UART_LinuxTTY_Close(&Dev);
+  return Failures;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  for (size_t zIdx = 0; zIdx < sizeof(BenchPattern); ++zIdx) BenchPattern[zIdx] = (uint8_t)zIdx;
+  int Failures = __Bench_Checks();
+  printf("Echo of %u bytes over all the pairs, one thread for all the channels\n", BENCH_STREAM_SIZE);
+  printf("pairs  MB/s both  epoll_wait  events/wait  no progress\n");
+  for (size_t zPairs = 0; zPairs < (sizeof(BENCH_PAIR_COUNTS) / sizeof(BENCH_PAIR_COUNTS[0])); ++zPairs)
+    Failures += __Bench_Run(BENCH_PAIR_COUNTS[zPairs]);
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
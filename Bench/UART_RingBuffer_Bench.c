@@ -0,0 +1,172 @@
+/*!*****************************************************************************
+ * @file    UART_RingBuffer_Bench.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Throughput benchmark of the UART ring buffer
+ * @details Host-only benchmark. The UART side fills the receive ring with
+ *          bursts of 1 to 64 bytes until the ring has no room for a burst,
+ *          then a parser empties it and checks the byte sequence:
+ *          - With the copy API: UART_Interface.fnUART_Receive of the ring UART
+ *            interface in a small buffer of the parser, then the parse
+ *          - With the zero-copy API: UART_RingBuffer_PeekRead(), the parse in
+ *            the spans, then UART_RingBuffer_CommitRead()
+ *          Both sides run in the same thread so the measure is the cost of the
+ *          APIs, not of the scheduler. Build and run from the repository root:
+ *            gcc -O2 -I. Bench/UART_RingBuffer_Bench.c UART_RingBuffer.c -o RingBench
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "UART_RingBuffer.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+
+#define BENCH_TOTAL_BYTES   ( 256u * 1024u * 1024u ) //!< Bytes sent through the ring per measure
+#define BENCH_RING_SIZE     ( 4096u )                //!< Size of the receive ring
+#define BENCH_MAX_BURST     ( 64u )                  //!< Max size of a burst of the producer
+#define BENCH_PARSER_BUFFER ( 64u )                  //!< Size of the buffer of the parser with the copy API
+
+static uint8_t BenchRingBuffer[BENCH_RING_SIZE];
+static UART_RingBuffer BenchRing;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in ns
+//=============================================================================
+static double __Bench_Now_ns(void)
+{
+  struct timespec Now;
+  clock_gettime(CLOCK_MONOTONIC, &Now);
+  return ((double)Now.tv_sec * 1e9) + (double)Now.tv_nsec;
+}
+
+
+//=============================================================================
+// [STATIC] UART side: fill the receive ring with bursts while there is room
+//=============================================================================
+static size_t __Bench_Produce(uint32_t* pSeed, uint8_t* pValue, size_t remaining)
+{
+  size_t Produced = 0;
+  while (remaining > 0)
+  {
+    const uint32_t Seed = (*pSeed * 1103515245u) + 12345u;
+    size_t Burst = 1u + ((Seed >> 16) % BENCH_MAX_BURST);
+    if (Burst > remaining) Burst = remaining;
+    UART_RingSpans Spans;
+    if (UART_RingBuffer_PeekWrite(&BenchRing, &Spans) < Burst) break;         // The FIFO of the UART waits for room
+    *pSeed = Seed;
+    size_t Left = Burst;
+    for (size_t zSpan = 0; (zSpan < 2) && (Left > 0); ++zSpan)
+    {
+      const size_t Count = (Spans.Span[zSpan].Size < Left ? Spans.Span[zSpan].Size : Left);
+      for (size_t zIdx = 0; zIdx < Count; ++zIdx) Spans.Span[zSpan].pData[zIdx] = (*pValue)++;
+      Left -= Count;
+    }
+    UART_RingBuffer_CommitWrite(&BenchRing, Burst);
+    remaining -= Burst;
+    Produced  += Burst;
+  }
+  return Produced;
+}
+
+
+//=============================================================================
+// [STATIC] Parse bytes: check the byte sequence
+//=============================================================================
+static size_t __Bench_Parse(const uint8_t* pData, size_t size, uint8_t* pExpected)
+{
+  size_t Errors = 0;
+  uint8_t Expected = *pExpected;
+  for (size_t zIdx = 0; zIdx < size; ++zIdx) Errors += (pData[zIdx] != Expected++ ? 1u : 0u);
+  *pExpected = Expected;
+  return Errors;
+}
+
+
+//=============================================================================
+// [STATIC] Run a measure with the copy API or the zero-copy API
+//=============================================================================
+static size_t __Bench_Run(bool zeroCopy, UART_Interface* pUART, double* pTime)
+{
+  UART_RingBuffer_Init(&BenchRing, &BenchRingBuffer[0], sizeof(BenchRingBuffer));
+  size_t Produced = 0, Received = 0, Errors = 0;
+  uint32_t Seed = 1;
+  uint8_t Value = 0, Expected = 0;
+  double ParseTime = 0.0;
+  while (Received < BENCH_TOTAL_BYTES)
+  {
+    Produced += __Bench_Produce(&Seed, &Value, BENCH_TOTAL_BYTES - Produced);
+    const double Start = __Bench_Now_ns();
+    size_t Count = 1;
+    while (Count > 0)                                                           // The parser empties the ring
+    {
+      if (zeroCopy)
+      {
+        UART_RingSpans Spans;
+        Count = UART_RingBuffer_PeekRead(&BenchRing, &Spans);
+        if (Count == 0) break;
+        Errors += __Bench_Parse(Spans.Span[0].pData, Spans.Span[0].Size, &Expected);
+        if (Spans.Span[1].Size > 0) Errors += __Bench_Parse(Spans.Span[1].pData, Spans.Span[1].Size, &Expected);
+        UART_RingBuffer_CommitRead(&BenchRing, Count);
+      }
+      else
+      {
+        uint8_t Buffer[BENCH_PARSER_BUFFER];
+        uint8_t LastCharError = 0;
+        if (pUART->fnUART_Receive(pUART, &Buffer[0], sizeof(Buffer), &Count, &LastCharError) != ERR_NONE) return 1;
+        Errors += __Bench_Parse(&Buffer[0], Count, &Expected);
+      }
+      Received += Count;
+    }
+    ParseTime += __Bench_Now_ns() - Start;
+  }
+  *pTime = ParseTime;
+  return Errors;
+}
+
+
+//=============================================================================
+// Benchmark entry point
+//=============================================================================
+int main(void)
+{
+  UART_RingBuffer TxRing;
+  uint8_t TxBuffer[16];
+  UART_RingInterface RingInt;
+  UART_Interface UART;
+  eERRORRESULT Error = UART_RingBuffer_Init(&BenchRing, &BenchRingBuffer[0], sizeof(BenchRingBuffer));
+  if (Error == ERR_NONE) Error = UART_RingBuffer_Init(&TxRing, &TxBuffer[0], sizeof(TxBuffer));
+  RingInt.pRx           = &BenchRing;
+  RingInt.pTx           = &TxRing;
+  RingInt.LastCharError = 0;
+  if (Error == ERR_NONE) Error = UART_RingInterface_Attach(&UART, &RingInt);
+  if (Error != ERR_NONE) { printf("Initialization failed (error %d)\n", (int)Error); return EXIT_FAILURE; }
+
+  printf("%u MB through a %u bytes ring, producer bursts of 1 to %u bytes\n", BENCH_TOTAL_BYTES / (1024u * 1024u), BENCH_RING_SIZE, BENCH_MAX_BURST);
+  printf("parser (parse side only)    MB/s  errors\n");
+  double Time;
+  int Failures = 0;
+  size_t Errors;
+  Errors = __Bench_Run(false, &UART, &Time);
+  printf("copy API (%2u bytes reads)  %5.0f  %6u\n", BENCH_PARSER_BUFFER, (double)BENCH_TOTAL_BYTES * 1e3 / Time, (unsigned)Errors);
+  Failures += (int)Errors;
+  Errors = __Bench_Run(true, &UART, &Time);
+  printf("zero-copy peek/commit      %5.0f  %6u\n", (double)BENCH_TOTAL_BYTES * 1e3 / Time, (unsigned)Errors);
+  Failures += (int)Errors;
+
+  printf("%s (%d failure)\n", (Failures == 0 ? "OK" : "FAILED"), Failures);
+  return (Failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
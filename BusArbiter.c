@@ -0,0 +1,428 @@
+/*!*****************************************************************************
+ * @file    BusArbiter.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.1.0
+ * @date    16/10/2026
+ * @brief   Multi-client arbitration of a shared I2C or SPI interface
+ * @details This bus arbiter lets several drivers of the
+ *          https://github.com/Emandhal drivers and developments share one bus.
+ *          The waiting queues are Vyukov's intrusive MPSC queues, the single
+ *          consumer is always the current owner of the bus.
+ *          Only available with the generic interfaces (not Arduino, not
+ *          STM32cubeIDE) and GCC/Clang atomic builtins
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.1.0    Forward the SPI phase transfers
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "BusArbiter.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Bus arbiter internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Push a node in a queue (any thread)
+//=============================================================================
+static void __BusArbiter_Push(BusArbiterQueue* pQueue, BusArbiterNode* pNode)
+{
+  __atomic_store_n(&pNode->pNext, NULL, __ATOMIC_RELAXED);
+  BusArbiterNode* pPrev = __atomic_exchange_n(&pQueue->pHead, pNode, __ATOMIC_ACQ_REL);
+  __atomic_store_n(&pPrev->pNext, pNode, __ATOMIC_RELEASE);                       // Until this store, the node is not reachable by the consumer
+}
+
+
+//=============================================================================
+// [STATIC] Pop a node from a queue (bus owner only)
+//=============================================================================
+static BusArbiterNode* __BusArbiter_Pop(BusArbiterQueue* pQueue)
+{
+  BusArbiterNode* pTail = pQueue->pTail;
+  BusArbiterNode* pNext = __atomic_load_n(&pTail->pNext, __ATOMIC_ACQUIRE);
+  if (pTail == &pQueue->Stub)
+  {
+    if (pNext == NULL) return NULL;                                               // Empty queue
+    pQueue->pTail = pNext;
+    pTail = pNext;
+    pNext = __atomic_load_n(&pTail->pNext, __ATOMIC_ACQUIRE);
+  }
+  if (pNext != NULL)
+  {
+    pQueue->pTail = pNext;
+    return pTail;
+  }
+  if (pTail != __atomic_load_n(&pQueue->pHead, __ATOMIC_ACQUIRE)) return NULL;   // A producer is pushing a node after the tail
+  __BusArbiter_Push(pQueue, &pQueue->Stub);                                       // The tail is the last node, put the stub behind it to pop it
+  pNext = __atomic_load_n(&pTail->pNext, __ATOMIC_ACQUIRE);
+  if (pNext == NULL) return NULL;
+  pQueue->pTail = pNext;
+  return pTail;
+}
+
+
+//=============================================================================
+// [STATIC] Hand over the bus to the highest priority waiting client (bus owner only, with at least one waiting client)
+//=============================================================================
+static void __BusArbiter_HandOver(BusArbiter* pArbiter)
+{
+  const uint32_t Depth = __atomic_load_n(&pArbiter->Waiting, __ATOMIC_ACQUIRE);
+  if (Depth > pArbiter->MaxQueueDepth) pArbiter->MaxQueueDepth = Depth;
+  BusArbiterNode* pNode = NULL;
+  while (true)
+  {
+    for (size_t zPrio = 0; (zPrio < BUSARB_PRIORITY_COUNT) && (pNode == NULL); ++zPrio) pNode = __BusArbiter_Pop(&pArbiter->Queues[zPrio]);
+    if (pNode != NULL) break;
+    if (pArbiter->fnYield != NULL) pArbiter->fnYield();                          // A waiting client is between its counting and its push
+  }
+  __atomic_sub_fetch(&pArbiter->Waiting, 1, __ATOMIC_ACQ_REL);
+  __atomic_store_n(&pArbiter->pOwner, pNode->pClient, __ATOMIC_RELEASE);
+  __atomic_store_n(&pNode->pClient->Granted, true, __ATOMIC_RELEASE);
+}
+
+
+//=============================================================================
+// [STATIC] Acquire the bus for a client
+//=============================================================================
+static void __BusArbiter_Acquire(BusArbiterClient* pClient)
+{
+  BusArbiter* pArbiter = pClient->pArbiter;
+  BusArbiterStats* pStats = &pArbiter->Stats[pClient->Priority];
+  BusArbiterClient* pExpected = NULL;
+  if (pClient->Owns) return;
+
+  //--- Fast path: free bus and nobody waiting ---
+  if (__atomic_load_n(&pArbiter->Waiting, __ATOMIC_ACQUIRE) == 0)
+  {
+    if (__atomic_compare_exchange_n(&pArbiter->pOwner, &pExpected, pClient, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      pClient->Owns = true;
+      pStats->Acquisitions++;
+      return;
+    }
+  }
+
+  //--- Slow path: wait in the queue of the priority class ---
+  const uint32_t StartTicks = (pArbiter->fnGetTicks != NULL ? pArbiter->fnGetTicks() : 0);
+  __atomic_store_n(&pClient->Granted, false, __ATOMIC_RELAXED);
+  __atomic_add_fetch(&pArbiter->Waiting, 1, __ATOMIC_ACQ_REL);
+  __BusArbiter_Push(&pArbiter->Queues[pClient->Priority], &pClient->Node);
+  while (__atomic_load_n(&pClient->Granted, __ATOMIC_ACQUIRE) == false)
+  {
+    pExpected = NULL;
+    if ((__atomic_load_n(&pArbiter->pOwner, __ATOMIC_RELAXED) == NULL)
+     && __atomic_compare_exchange_n(&pArbiter->pOwner, &pExpected, pClient, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    { // The bus has been released while this client was queuing, take it to hand it over to the highest priority waiting client (can be this one)
+      __BusArbiter_HandOver(pArbiter);
+      continue;
+    }
+    if (pArbiter->fnYield != NULL) pArbiter->fnYield();
+  }
+  pClient->Owns = true;
+
+  //--- Statistics, now that this client owns the bus ---
+  pStats->Acquisitions++;
+  pStats->Contended++;
+  if (pArbiter->fnGetTicks != NULL)
+  {
+    const uint32_t WaitTicks = pArbiter->fnGetTicks() - StartTicks;
+    pStats->TotalWaitTicks += WaitTicks;
+    if (WaitTicks > pStats->MaxWaitTicks) pStats->MaxWaitTicks = WaitTicks;
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Release the bus owned by a client
+//=============================================================================
+static void __BusArbiter_Release(BusArbiterClient* pClient)
+{
+  BusArbiter* pArbiter = pClient->pArbiter;
+  if (pClient->Owns == false) return;
+  pClient->Owns = false;
+  if (__atomic_load_n(&pArbiter->Waiting, __ATOMIC_ACQUIRE) > 0) __BusArbiter_HandOver(pArbiter);
+  else __atomic_store_n(&pArbiter->pOwner, NULL, __ATOMIC_RELEASE);              // A client that queues now will take the bus itself
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Bus arbiter functions
+//********************************************************************************************************************
+//=============================================================================
+// Initialize a bus arbiter
+//=============================================================================
+eERRORRESULT BusArbiter_Init(BusArbiter* pArbiter, I2C_Interface* pI2C, SPI_Interface* pSPI)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pArbiter == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pI2C == NULL) == (pSPI == NULL)) return ERR__PARAMETER_ERROR;             // One and only one interface
+  pArbiter->pI2C    = pI2C;
+  pArbiter->pSPI    = pSPI;
+  pArbiter->pOwner  = NULL;
+  pArbiter->Waiting = 0;
+  for (size_t zPrio = 0; zPrio < BUSARB_PRIORITY_COUNT; ++zPrio)
+  {
+    BusArbiterQueue* pQueue = &pArbiter->Queues[zPrio];
+    pQueue->Stub.pNext   = NULL;
+    pQueue->Stub.pClient = NULL;
+    pQueue->pHead        = &pQueue->Stub;
+    pQueue->pTail        = &pQueue->Stub;
+  }
+  BusArbiter_ResetStats(pArbiter);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Reset the statistics of a bus arbiter
+//=============================================================================
+void BusArbiter_ResetStats(BusArbiter* pArbiter)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pArbiter == NULL) return;
+#endif
+  pArbiter->MaxQueueDepth = 0;
+  for (size_t zPrio = 0; zPrio < BUSARB_PRIORITY_COUNT; ++zPrio)
+  {
+    pArbiter->Stats[zPrio].Acquisitions   = 0;
+    pArbiter->Stats[zPrio].Contended      = 0;
+    pArbiter->Stats[zPrio].TotalWaitTicks = 0;
+    pArbiter->Stats[zPrio].MaxWaitTicks   = 0;
+  }
+}
+
+
+//=============================================================================
+// Get the current count of clients waiting for the bus
+//=============================================================================
+uint32_t BusArbiter_GetQueueDepth(BusArbiter* pArbiter)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pArbiter == NULL) return 0;
+#endif
+  return __atomic_load_n(&pArbiter->Waiting, __ATOMIC_RELAXED);
+}
+
+
+//=============================================================================
+// Acquire the bus for a client
+//=============================================================================
+void BusArbiter_Acquire(BusArbiterClient* pClient)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pClient == NULL) || (pClient->pArbiter == NULL)) return;
+#endif
+  __BusArbiter_Acquire(pClient);
+  pClient->Held = true;
+}
+
+
+//=============================================================================
+// Release the bus acquired by BusArbiter_Acquire()
+//=============================================================================
+void BusArbiter_Release(BusArbiterClient* pClient)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pClient == NULL) || (pClient->pArbiter == NULL)) return;
+#endif
+  pClient->Held = false;
+  __BusArbiter_Release(pClient);
+}
+
+
+//=============================================================================
+// [STATIC] Initialize a client of a bus arbiter
+//=============================================================================
+static eERRORRESULT __BusArbiter_ClientInit(BusArbiterClient* pClient, BusArbiter* pArbiter, eBusArbiter_Priority priority)
+{
+  if (priority >= BUSARB_PRIORITY_COUNT) return ERR__PARAMETER_ERROR;
+  pClient->pArbiter     = pArbiter;
+  pClient->Priority     = priority;
+  pClient->Node.pNext   = NULL;
+  pClient->Node.pClient = pClient;
+  pClient->Granted      = false;
+  pClient->Owns         = false;
+  pClient->Held         = false;
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+//=============================================================================
+// Configure an I2C_Interface as a client of a bus arbiter
+//=============================================================================
+eERRORRESULT BusArbiter_I2CclientAttach(I2C_Interface *pIntDev, BusArbiterClient* pClient, BusArbiter* pArbiter, eBusArbiter_Priority priority)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pClient == NULL) || (pArbiter == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if (pArbiter->pI2C == NULL) return ERR__I2C_CONFIG_ERROR;
+  eERRORRESULT Error = __BusArbiter_ClientInit(pClient, pArbiter, priority);
+  if (Error != ERR_NONE) return Error;
+  pIntDev->InterfaceDevice     = pClient;
+  pIntDev->UniqueID            = 0;
+  pIntDev->fnI2C_Init          = BusArbiter_I2CInit;
+  pIntDev->fnI2C_Transfer      = BusArbiter_I2CTransfer;
+  pIntDev->fnI2C_TransferBatch = BusArbiter_I2CTransferBatch;
+  pIntDev->fnI2C_TransferAsync = NULL;                                            // The bus release would happen in the completion context, use the synchronous fallback
+  pIntDev->Channel             = pArbiter->pI2C->Channel;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// I2C client initialization
+//=============================================================================
+eERRORRESULT BusArbiter_I2CInit(I2C_Interface *pIntDev, const uint32_t sclFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  BusArbiterClient* pClient = (BusArbiterClient*)pIntDev->InterfaceDevice;
+  I2C_Interface* pI2C = pClient->pArbiter->pI2C;
+  if (pI2C->fnI2C_Init == NULL) return ERR_NONE;
+  __BusArbiter_Acquire(pClient);
+  const eERRORRESULT Error = pI2C->fnI2C_Init(pI2C, sclFreq);
+  if (pClient->Held == false) __BusArbiter_Release(pClient);
+  return Error;
+}
+
+
+//=============================================================================
+// I2C client transfer
+//=============================================================================
+eERRORRESULT BusArbiter_I2CTransfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  BusArbiterClient* pClient = (BusArbiterClient*)pIntDev->InterfaceDevice;
+  I2C_Interface* pI2C = pClient->pArbiter->pI2C;
+  __BusArbiter_Acquire(pClient);
+  const eERRORRESULT Error = pI2C->fnI2C_Transfer(pI2C, pPacketDesc);
+  if (((Error != ERR_NONE) || pPacketDesc->Stop) && (pClient->Held == false)) __BusArbiter_Release(pClient); // End of the sequence
+  return Error;
+}
+
+
+//=============================================================================
+// I2C client batch transfer
+//=============================================================================
+eERRORRESULT BusArbiter_I2CTransferBatch(I2C_Interface *pIntDev, I2CInterface_Packet* const pPackets, size_t count, eERRORRESULT* const pPacketsResult)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPackets == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  BusArbiterClient* pClient = (BusArbiterClient*)pIntDev->InterfaceDevice;
+  if (count == 0) return ERR_NONE;
+  __BusArbiter_Acquire(pClient);
+  const eERRORRESULT Error = Interface_I2CtransferBatch(pClient->pArbiter->pI2C, pPackets, count, pPacketsResult);
+  if (((Error != ERR_NONE) || pPackets[count - 1].Stop) && (pClient->Held == false)) __BusArbiter_Release(pClient); // End of the sequence
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+//=============================================================================
+// Configure a SPI_Interface as a client of a bus arbiter
+//=============================================================================
+eERRORRESULT BusArbiter_SPIclientAttach(SPI_Interface *pIntDev, BusArbiterClient* pClient, BusArbiter* pArbiter, eBusArbiter_Priority priority)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pClient == NULL) || (pArbiter == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pArbiter->pSPI == NULL) return ERR__SPI_CONFIG_ERROR;
+  eERRORRESULT Error = __BusArbiter_ClientInit(pClient, pArbiter, priority);
+  if (Error != ERR_NONE) return Error;
+  pIntDev->InterfaceDevice           = pClient;
+  pIntDev->UniqueID                  = 0;
+  pIntDev->fnSPI_Init                = BusArbiter_SPIInit;
+  pIntDev->fnSPI_Transfer            = BusArbiter_SPITransfer;
+  pIntDev->fnSPI_TransferSegmentList = NULL;                                         // The generic segment list ends with a terminate packet that releases the bus
+  pIntDev->fnSPI_TransferPhases      = BusArbiter_SPITransferPhases;
+  pIntDev->fnSPI_TransferAsync       = NULL;                                         // The bus release would happen in the completion context, use the synchronous fallback
+  pIntDev->Channel                   = pArbiter->pSPI->Channel;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// SPI client initialization
+//=============================================================================
+eERRORRESULT BusArbiter_SPIInit(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  BusArbiterClient* pClient = (BusArbiterClient*)pIntDev->InterfaceDevice;
+  SPI_Interface* pSPI = pClient->pArbiter->pSPI;
+  if (pSPI->fnSPI_Init == NULL) return ERR_NONE;
+  __BusArbiter_Acquire(pClient);
+  const eERRORRESULT Error = pSPI->fnSPI_Init(pSPI, chipSelect, mode, sckFreq);
+  if (pClient->Held == false) __BusArbiter_Release(pClient);
+  return Error;
+}
+
+
+//=============================================================================
+// SPI client transfer
+//=============================================================================
+eERRORRESULT BusArbiter_SPITransfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  BusArbiterClient* pClient = (BusArbiterClient*)pIntDev->InterfaceDevice;
+  SPI_Interface* pSPI = pClient->pArbiter->pSPI;
+  __BusArbiter_Acquire(pClient);
+  const eERRORRESULT Error = pSPI->fnSPI_Transfer(pSPI, pPacketDesc);
+  if (((Error != ERR_NONE) || pPacketDesc->Terminate) && (pClient->Held == false)) __BusArbiter_Release(pClient); // End of the sequence, the ChipSelect is deasserted
+  return Error;
+}
+
+
+//=============================================================================
+// SPI client phase transfer
+//=============================================================================
+eERRORRESULT BusArbiter_SPITransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPhasePacket == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  BusArbiterClient* pClient = (BusArbiterClient*)pIntDev->InterfaceDevice;
+  __BusArbiter_Acquire(pClient);
+  const eERRORRESULT Error = Interface_SPItransferPhases(pClient->pArbiter->pSPI, pPhasePacket);
+  if (pClient->Held == false) __BusArbiter_Release(pClient);                    // A phase transfer always deasserts the ChipSelect
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+#endif // #if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
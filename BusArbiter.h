@@ -0,0 +1,290 @@
+/*!*****************************************************************************
+ * @file    BusArbiter.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.1.0
+ * @date    16/10/2026
+ * @brief   Multi-client arbitration of a shared I2C or SPI interface
+ * @details This bus arbiter lets several drivers of the
+ * https://github.com/Emandhal drivers and developments share one I2C_Interface
+ * or SPI_Interface from different threads. A client owns the bus from the
+ * first packet of a sequence until the end of the sequence (I2C stop, SPI
+ * terminate) or an error, so sequences of different clients never interleave.
+ * - The uncontended acquisition is a single compare-and-swap, no lock
+ * - Contended clients wait in a lock-free MPSC queue per priority class
+ * - At each sequence boundary, the bus is handed over to the highest priority waiting client
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.1.0    Forward the SPI phase transfers
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __BUSARBITER_H_INC
+#define __BUSARBITER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "I2C_Interface.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Bus arbiter
+//********************************************************************************************************************
+
+//! Priority classes of the bus arbiter clients
+typedef enum
+{
+  BUSARB_PRIORITY_HIGH   = 0, //!< Latency-critical accesses (status reads, interrupt handling...)
+  BUSARB_PRIORITY_NORMAL = 1, //!< Normal accesses
+  BUSARB_PRIORITY_BULK   = 2, //!< Bulk transfers (memory dumps, firmware updates...)
+  BUSARB_PRIORITY_COUNT,      // KEEP LAST! Count of priority classes
+} eBusArbiter_Priority;
+
+//-----------------------------------------------------------------------------
+
+
+typedef struct BusArbiterClient BusArbiterClient; //!< Typedef of BusArbiterClient object structure
+
+/*! @brief Function called by a waiting client between two checks of the bus
+ *
+ * This function should give the CPU to other threads (sched_yield(), taskYIELD(), osThreadYield()...)
+ */
+typedef void (*BusArbiterYield_Func)(void);
+
+/*! @brief Function that gives the current time of the system
+ *
+ * Used to compute the wait time statistics. Can be a millisecond or a microsecond counter
+ * @return Returns the current ticks
+ */
+typedef uint32_t (*BusArbiterGetTicks_Func)(void);
+
+
+//! @brief Waiting node of a client in the MPSC queues of the arbiter
+typedef struct BusArbiterNode
+{
+  struct BusArbiterNode* volatile pNext; //!< Next node in the queue
+  BusArbiterClient* pClient;             //!< Client of the node. NULL for the stub node of a queue
+} BusArbiterNode;
+
+
+//! @brief Lock-free multi-producer single-consumer queue of waiting clients (intrusive, the consumer is the current bus owner)
+typedef struct BusArbiterQueue
+{
+  BusArbiterNode* volatile pHead; //!< Last node pushed (producers side)
+  BusArbiterNode* pTail;          //!< Next node to pop (consumer side)
+  BusArbiterNode Stub;            //!< Stub node, the queue is never really empty
+} BusArbiterQueue;
+
+
+//! @brief Statistics of a priority class. Updated by the bus owner only
+typedef struct BusArbiterStats
+{
+  uint32_t Acquisitions;   //!< Count of bus acquisitions
+  uint32_t Contended;      //!< Count of bus acquisitions that had to wait in the queue
+  uint64_t TotalWaitTicks; //!< Total wait time of the contended acquisitions (in BusArbiter.fnGetTicks ticks)
+  uint32_t MaxWaitTicks;   //!< Worst wait time of a contended acquisition (in BusArbiter.fnGetTicks ticks)
+} BusArbiterStats;
+
+
+//! @brief Bus arbiter of a shared I2C or SPI interface
+typedef struct BusArbiter
+{
+  I2C_Interface* pI2C;                           //!< Shared I2C interface. NULL if the arbiter is for a SPI interface
+  SPI_Interface* pSPI;                           //!< Shared SPI interface. NULL if the arbiter is for an I2C interface
+  BusArbiterYield_Func fnYield;                  //!< This function will be called by waiting clients. Can be NULL (busy wait)
+  BusArbiterGetTicks_Func fnGetTicks;            //!< This function will be called to measure wait times. Can be NULL (no wait time statistics)
+  //--- Arbiter state ---
+  BusArbiterClient* volatile pOwner;             //!< Current owner of the bus. NULL if the bus is free
+  volatile uint32_t Waiting;                     //!< Count of clients in the queues
+  BusArbiterQueue Queues[BUSARB_PRIORITY_COUNT]; //!< Waiting clients per priority class
+  //--- Statistics ---
+  uint32_t MaxQueueDepth;                        //!< Worst count of waiting clients seen at a hand over
+  BusArbiterStats Stats[BUSARB_PRIORITY_COUNT];  //!< Statistics per priority class
+} BusArbiter;
+
+
+//! @brief Client of a bus arbiter. One client per driver, a client shall be used by only one thread
+struct BusArbiterClient
+{
+  BusArbiter* pArbiter;          //!< Arbiter of the bus
+  eBusArbiter_Priority Priority; //!< Priority class of the client
+  BusArbiterNode Node;           //!< Waiting node of the client
+  volatile bool Granted;         //!< Set by the previous owner when the bus is handed over to this client
+  bool Owns;                     //!< 'true' if the client is the current owner of the bus (a sequence is in progress)
+  bool Held;                     //!< 'true' if the bus has been acquired by BusArbiter_Acquire(). The bus is kept until BusArbiter_Release()
+};
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Bus arbiter functions
+//********************************************************************************************************************
+
+/*! @brief Initialize a bus arbiter
+ *
+ * Give the shared interface in pI2C or pSPI, the other one shall be NULL. fnYield and fnGetTicks of the arbiter shall be set before the call (or NULL)
+ * @param[in] *pArbiter Is the bus arbiter to initialize
+ * @param[in] *pI2C Is the shared I2C interface
+ * @param[in] *pSPI Is the shared SPI interface
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_Init(BusArbiter* pArbiter, I2C_Interface* pI2C, SPI_Interface* pSPI);
+
+/*! @brief Reset the statistics of a bus arbiter
+ *
+ * @param[in] *pArbiter Is the bus arbiter
+ */
+void BusArbiter_ResetStats(BusArbiter* pArbiter);
+
+/*! @brief Get the current count of clients waiting for the bus
+ *
+ * @param[in] *pArbiter Is the bus arbiter
+ * @return Returns the queue depth
+ */
+uint32_t BusArbiter_GetQueueDepth(BusArbiter* pArbiter);
+
+
+/*! @brief Acquire the bus for a client
+ *
+ * If the bus is free and no client waits, the bus is acquired with a single compare-and-swap. Else the client waits in the queue of its priority class
+ * The drivers do not need to call this function, the client interfaces acquire the bus at the first packet of a sequence. Use it to group several sequences, the bus is then kept until BusArbiter_Release()
+ * @param[in] *pClient Is the client that wants the bus
+ */
+void BusArbiter_Acquire(BusArbiterClient* pClient);
+
+/*! @brief Release the bus acquired by BusArbiter_Acquire()
+ *
+ * If clients are waiting, the bus is directly handed over to the highest priority one
+ * @param[in] *pClient Is the client that owns the bus
+ */
+void BusArbiter_Release(BusArbiterClient* pClient);
+
+//-----------------------------------------------------------------------------
+
+
+/*! @brief Configure an I2C_Interface as a client of a bus arbiter
+ *
+ * The interface configured here is the one to give to the driver. The bus is acquired at the first packet and released after a packet with Stop = 'true' or an error
+ * @param[out] *pIntDev Is the I2C interface container structure to configure
+ * @param[in] *pClient Is the client structure of the driver
+ * @param[in] *pArbiter Is the bus arbiter of the shared I2C interface
+ * @param[in] priority Is the priority class of the client
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_I2CclientAttach(I2C_Interface *pIntDev, BusArbiterClient* pClient, BusArbiter* pArbiter, eBusArbiter_Priority priority);
+
+/*! @brief I2C client initialization (#I2CInit_Func compatible)
+ *
+ * Initialize the shared I2C interface while owning the bus
+ * @param[in] *pIntDev Is the I2C interface container structure of the client
+ * @param[in] sclFreq Is the SCL frequency in Hz to set at the interface initialization
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_I2CInit(I2C_Interface *pIntDev, const uint32_t sclFreq);
+
+/*! @brief I2C client transfer (#I2CTransferPacket_Func compatible)
+ *
+ * @param[in] *pIntDev Is the I2C interface container structure of the client
+ * @param[in] *pPacketDesc Is the packet description to transfer through I2C
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_I2CTransfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc);
+
+/*! @brief I2C client batch transfer (#I2CTransferBatch_Func compatible)
+ *
+ * The whole batch is transferred while owning the bus
+ * @param[in] *pIntDev Is the I2C interface container structure of the client
+ * @param[in] *pPackets Is the array of packets to transfer through I2C
+ * @param[in] count Is the count of packets in the array
+ * @param[out] *pPacketsResult Is the result of each packet. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_I2CTransferBatch(I2C_Interface *pIntDev, I2CInterface_Packet* const pPackets, size_t count, eERRORRESULT* const pPacketsResult);
+
+//-----------------------------------------------------------------------------
+
+
+/*! @brief Configure a SPI_Interface as a client of a bus arbiter
+ *
+ * The interface configured here is the one to give to the driver. The bus is acquired at the first packet and released after a packet with Terminate = 'true' or an error
+ * @param[out] *pIntDev Is the SPI interface container structure to configure
+ * @param[in] *pClient Is the client structure of the driver
+ * @param[in] *pArbiter Is the bus arbiter of the shared SPI interface
+ * @param[in] priority Is the priority class of the client
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_SPIclientAttach(SPI_Interface *pIntDev, BusArbiterClient* pClient, BusArbiter* pArbiter, eBusArbiter_Priority priority);
+
+/*! @brief SPI client initialization (#SPIInit_Func compatible)
+ *
+ * Initialize the shared SPI interface while owning the bus
+ * @param[in] *pIntDev Is the SPI interface container structure of the client
+ * @param[in] chipSelect Is the Chip Select index to use for the SPI initialization
+ * @param[in] mode Is the mode of the SPI to configure
+ * @param[in] sckFreq Is the SCK frequency in Hz to set at the interface initialization
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_SPIInit(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq);
+
+/*! @brief SPI client transfer (#SPITransferPacket_Func compatible)
+ *
+ * @param[in] *pIntDev Is the SPI interface container structure of the client
+ * @param[in] *pPacketDesc Is the packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_SPITransfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief SPI client phase transfer (#SPITransferPhases_Func compatible)
+ *
+ * The phase packet is given to Interface_SPItransferPhases() of the arbitrated interface
+ * @param[in] *pIntDev Is the SPI interface container structure of the client
+ * @param[in] *pPhasePacket Is the phase packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT BusArbiter_SPITransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __BUSARBITER_H_INC */
@@ -0,0 +1,139 @@
+/*!*****************************************************************************
+ * @file    CRC.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   CRC computation engine
+ * @details This CRC engine is shared by the SPI and I2C interfaces and by all
+ * the https://github.com/Emandhal drivers and developments. It computes the
+ * CRC-8 of the SMBus PEC, the CRC-7 and CRC-16 of the SD cards, the CRC-16 of
+ * the MCP251xFD SPI and the CRC-32 of zlib/Ethernet.
+ * The CRC-16/XMODEM and CRC-32 use slice-by-8 tables. The CRC-32 uses the
+ * ARMv8 CRC32 instructions or the x86 PCLMULQDQ folding when the target
+ * supports them
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __CRC_H_INC
+#define __CRC_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! CRC algorithms enum
+typedef enum
+{
+  CRC8_SMBUS,     //!< CRC-8/SMBUS: polynomial 0x07, init 0x00. SMBus Packet Error Code. The CRC is 1 byte
+  CRC7_MMC,       //!< CRC-7/MMC: polynomial 0x09, init 0x00. SD/MMC command CRC. The CRC is 1 byte sent as (CRC7 << 1) | 1
+  CRC16_XMODEM,   //!< CRC-16/XMODEM: polynomial 0x1021, init 0x0000. SD/MMC data block CRC. The CRC is 2 bytes sent MSB first
+  CRC16_CMS,      //!< CRC-16/CMS: polynomial 0x8005, init 0xFFFF. MCP251xFD SPI CRC. The CRC is 2 bytes sent MSB first
+  CRC32_ISO_HDLC, //!< CRC-32/ISO-HDLC: reflected polynomial 0xEDB88320, init and final xor 0xFFFFFFFF. zlib/Ethernet CRC. The CRC is 4 bytes sent LSB first
+  CRC_TYPE_COUNT, // Keep last
+} eCRC_Type;
+
+//! @brief Running CRC computation. The CRC can be computed over several buffers or packets
+typedef struct CRC_Context
+{
+  eCRC_Type Type; //!< CRC algorithm
+  uint32_t Value; //!< Current CRC register value. Set by CRC_Init(), use CRC_GetValue() to get the CRC
+} CRC_Context;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// CRC functions
+//********************************************************************************************************************
+
+/*! @brief Initialize a running CRC computation
+ *
+ * @param[out] *pCRC Is the CRC context to initialize
+ * @param[in] type Is the CRC algorithm to use
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT CRC_Init(CRC_Context* pCRC, eCRC_Type type);
+
+/*! @brief Add data to a running CRC computation
+ *
+ * @param[in,out] *pCRC Is the CRC context to update
+ * @param[in] *pData Is the data to add to the CRC
+ * @param[in] size Is the size of the data in bytes
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT CRC_Update(CRC_Context* pCRC, const uint8_t* pData, size_t size);
+
+/*! @brief Get the CRC of the data added to a running CRC computation
+ *
+ * The context is not modified, more data can be added after this call
+ * @param[in] *pCRC Is the CRC context
+ * @return Returns the CRC value. The CRC-7 is returned without the shift and the end bit
+ */
+uint32_t CRC_GetValue(const CRC_Context* pCRC);
+
+/*! @brief Get the size of the CRC of an algorithm as sent on a bus
+ *
+ * @param[in] type Is the CRC algorithm
+ * @return Returns the size in bytes, 0 if the algorithm is unknown
+ */
+size_t CRC_GetSize(eCRC_Type type);
+
+/*! @brief Check the CRC received after the data of a running CRC computation
+ *
+ * The received CRC is in the bus order of the algorithm (see #eCRC_Type)
+ * @param[in] *pCRC Is the CRC context, all the data shall be already added
+ * @param[in] *pReceivedCRC Is the CRC received after the data. Its size is CRC_GetSize()
+ * @return Returns #ERR_NONE if the CRC matches, #ERR__CRC_ERROR if not, or another #eERRORRESULT value enum
+ */
+eERRORRESULT CRC_CheckReceived(const CRC_Context* pCRC, const uint8_t* pReceivedCRC);
+
+/*! @brief Compute the CRC of a buffer in one call
+ *
+ * @param[in] type Is the CRC algorithm to use
+ * @param[in] *pData Is the data to compute
+ * @param[in] size Is the size of the data in bytes
+ * @return Returns the CRC value, see CRC_GetValue()
+ */
+uint32_t CRC_Compute(eCRC_Type type, const uint8_t* pData, size_t size);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __CRC_H_INC */
@@ -0,0 +1,240 @@
+/*!*****************************************************************************
+ * @file    EndianTransform.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Endianness transform of data blocks
+ * @details This endian transform engine is shared by the SPI and I2C interfaces
+ *          for all the https://github.com/Emandhal drivers and developments.
+ *          The vector kernels process the bulk of the buffer, the scalar code
+ *          processes the remaining bytes (or the whole buffer without SIMD)
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "EndianTransform.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#if defined(__AVX2__)
+#  include <immintrin.h>
+#elif defined(__SSSE3__)
+#  include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#  define ENDIAN_USE_SSE2
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define ENDIAN_USE_NEON
+#endif
+#if defined(__AVX2__) || defined(__SSSE3__)
+#  define ENDIAN_USE_SSSE3 // AVX2 implies SSSE3
+#  define ENDIAN_USE_SSE2  // SSSE3 implies SSE2
+#endif
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Vector kernels. Each kernel returns the count of bytes processed, the remaining bytes are processed by the scalar code
+//********************************************************************************************************************
+#if defined(ENDIAN_USE_SSE2) || defined(ENDIAN_USE_NEON)
+//=============================================================================
+// [STATIC] Switch endianness of 16-bits blocks
+//=============================================================================
+static size_t __EndianTransform_Vector16(uint8_t* pDst, const uint8_t* pSrc, size_t size)
+{
+  size_t Pos = 0;
+#if defined(__AVX2__)
+  const __m256i Mask = _mm256_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14,
+                                        1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+  for (; (size - Pos) >= 32; Pos += 32)
+  {
+    const __m256i Data = _mm256_loadu_si256((const __m256i*)&pSrc[Pos]);
+    _mm256_storeu_si256((__m256i*)&pDst[Pos], _mm256_shuffle_epi8(Data, Mask));
+  }
+#endif
+#if defined(ENDIAN_USE_SSE2)
+  for (; (size - Pos) >= 16; Pos += 16)
+  {
+    const __m128i Data = _mm_loadu_si128((const __m128i*)&pSrc[Pos]);
+    _mm_storeu_si128((__m128i*)&pDst[Pos], _mm_or_si128(_mm_slli_epi16(Data, 8), _mm_srli_epi16(Data, 8)));
+  }
+#elif defined(ENDIAN_USE_NEON)
+  for (; (size - Pos) >= 16; Pos += 16)
+    vst1q_u8(&pDst[Pos], vrev16q_u8(vld1q_u8(&pSrc[Pos])));
+#endif
+  return Pos;
+}
+
+
+//=============================================================================
+// [STATIC] Switch endianness of 24-bits blocks
+//=============================================================================
+static size_t __EndianTransform_Vector24(uint8_t* pDst, const uint8_t* pSrc, size_t size)
+{
+  size_t Pos = 0;
+#if defined(ENDIAN_USE_SSSE3)
+  // 5 blocks of 3 bytes per 16-bytes vector. The 16th byte is stored unchanged and will be rewritten by the next loop
+  const __m128i Mask = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 14, 13, 12, 15);
+  for (; (size - Pos) >= 16; Pos += 15)
+  {
+    const __m128i Data = _mm_loadu_si128((const __m128i*)&pSrc[Pos]);
+    _mm_storeu_si128((__m128i*)&pDst[Pos], _mm_shuffle_epi8(Data, Mask));
+  }
+#elif defined(ENDIAN_USE_NEON)
+  for (; (size - Pos) >= 48; Pos += 48)
+  {
+    uint8x16x3_t Data = vld3q_u8(&pSrc[Pos]); // De-interleave the 3 bytes of 16 blocks
+    const uint8x16_t Tmp = Data.val[0];
+    Data.val[0] = Data.val[2];
+    Data.val[2] = Tmp;
+    vst3q_u8(&pDst[Pos], Data);
+  }
+#else
+  (void)pDst;
+  (void)pSrc;
+  (void)size;
+#endif
+  return Pos;
+}
+
+
+//=============================================================================
+// [STATIC] Switch endianness of 32-bits blocks
+//=============================================================================
+static size_t __EndianTransform_Vector32(uint8_t* pDst, const uint8_t* pSrc, size_t size)
+{
+  size_t Pos = 0;
+#if defined(__AVX2__)
+  const __m256i Mask = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                        3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+  for (; (size - Pos) >= 32; Pos += 32)
+  {
+    const __m256i Data = _mm256_loadu_si256((const __m256i*)&pSrc[Pos]);
+    _mm256_storeu_si256((__m256i*)&pDst[Pos], _mm256_shuffle_epi8(Data, Mask));
+  }
+#endif
+#if defined(ENDIAN_USE_SSE2)
+  for (; (size - Pos) >= 16; Pos += 16)
+  {
+    __m128i Data = _mm_loadu_si128((const __m128i*)&pSrc[Pos]);
+    Data = _mm_shufflehi_epi16(_mm_shufflelo_epi16(Data, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1)); // Swap 16-bits words
+    _mm_storeu_si128((__m128i*)&pDst[Pos], _mm_or_si128(_mm_slli_epi16(Data, 8), _mm_srli_epi16(Data, 8))); // Then swap bytes
+  }
+#elif defined(ENDIAN_USE_NEON)
+  for (; (size - Pos) >= 16; Pos += 16)
+    vst1q_u8(&pDst[Pos], vrev32q_u8(vld1q_u8(&pSrc[Pos])));
+#endif
+  return Pos;
+}
+#endif // #if defined(ENDIAN_USE_SSE2) || defined(ENDIAN_USE_NEON)
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Endian transform functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Switch endianness of blocks. pDst can be equal to pSrc
+//=============================================================================
+static eERRORRESULT __EndianTransform_Process(uint8_t* pDst, const uint8_t* pSrc, size_t size, eEndianTransform transform)
+{
+  size_t Pos = 0;
+  switch (transform)
+  {
+    case ENDIAN_NO_CHANGE:
+      if (pDst != pSrc)
+        for (; Pos < size; ++Pos) pDst[Pos] = pSrc[Pos];
+      break;
+
+    case ENDIAN_SWITCH_16BITS:
+      if ((size % 2) > 0) return ERR__DATA_MODULO;
+#if defined(ENDIAN_USE_SSE2) || defined(ENDIAN_USE_NEON)
+      Pos = __EndianTransform_Vector16(pDst, pSrc, size);
+#endif
+      for (; Pos < size; Pos += 2)
+      {
+        const uint8_t Tmp = pSrc[Pos];
+        pDst[Pos + 0] = pSrc[Pos + 1];
+        pDst[Pos + 1] = Tmp;
+      }
+      break;
+
+    case ENDIAN_SWITCH_24BITS:
+      if ((size % 3) > 0) return ERR__DATA_MODULO;
+#if defined(ENDIAN_USE_SSE2) || defined(ENDIAN_USE_NEON)
+      Pos = __EndianTransform_Vector24(pDst, pSrc, size);
+#endif
+      for (; Pos < size; Pos += 3)
+      {
+        const uint8_t Tmp = pSrc[Pos];
+        pDst[Pos + 1] = pSrc[Pos + 1];
+        pDst[Pos + 0] = pSrc[Pos + 2];
+        pDst[Pos + 2] = Tmp;
+      }
+      break;
+
+    case ENDIAN_SWITCH_32BITS:
+      if ((size % 4) > 0) return ERR__DATA_MODULO;
+#if defined(ENDIAN_USE_SSE2) || defined(ENDIAN_USE_NEON)
+      Pos = __EndianTransform_Vector32(pDst, pSrc, size);
+#endif
+      for (; Pos < size; Pos += 4)
+      {
+        const uint8_t Tmp0 = pSrc[Pos + 0];
+        const uint8_t Tmp1 = pSrc[Pos + 1];
+        pDst[Pos + 0] = pSrc[Pos + 3];
+        pDst[Pos + 1] = pSrc[Pos + 2];
+        pDst[Pos + 2] = Tmp1;
+        pDst[Pos + 3] = Tmp0;
+      }
+      break;
+
+    default: return ERR__PARAMETER_ERROR;
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Switch the endianness of each data block of a buffer in place
+//=============================================================================
+eERRORRESULT EndianTransform_InPlace(uint8_t* pData, size_t size, eEndianTransform transform)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pData == NULL) && (size > 0)) return ERR__NULL_BUFFER;
+#endif
+  return __EndianTransform_Process(pData, pData, size, transform);
+}
+
+
+//=============================================================================
+// Copy a buffer while switching the endianness of each data block
+//=============================================================================
+eERRORRESULT EndianTransform_Copy(uint8_t* pDst, const uint8_t* pSrc, size_t size, eEndianTransform transform)
+{
+#ifdef CHECK_NULL_PARAM
+  if (((pDst == NULL) || (pSrc == NULL)) && (size > 0)) return ERR__NULL_BUFFER;
+#endif
+  return __EndianTransform_Process(pDst, pSrc, size, transform);
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
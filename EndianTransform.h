@@ -0,0 +1,96 @@
+/*!*****************************************************************************
+ * @file    EndianTransform.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Endianness transform of data blocks
+ * @details This endian transform engine is shared by the SPI and I2C interfaces
+ * for all the https://github.com/Emandhal drivers and developments.
+ * It uses SSE2/SSSE3/AVX2 or NEON kernels when the target supports them and
+ * falls back to a portable scalar implementation
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __ENDIAN_TRANSFORM_H_INC
+#define __ENDIAN_TRANSFORM_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! Endianness block size enum. Values are the same as #eI2C_EndianTransform and #eSPI_EndianTransform
+typedef enum
+{
+  ENDIAN_NO_CHANGE     = 0x0u, //!< Do not change endianness
+  ENDIAN_SWITCH_16BITS = 0x2u, //!< Switch endianness per 16-bits data
+  ENDIAN_SWITCH_24BITS = 0x3u, //!< Switch endianness per 24-bits data
+  ENDIAN_SWITCH_32BITS = 0x4u, //!< Switch endianness per 32-bits data
+} eEndianTransform;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Endian transform functions
+//********************************************************************************************************************
+
+/*! @brief Switch the endianness of each data block of a buffer in place
+ *
+ * @param[in,out] *pData Is the buffer to transform
+ * @param[in] size Is the size of the buffer in bytes. It shall be a multiple of the block size
+ * @param[in] transform Is the endian transform to apply. Can be an #eI2C_EndianTransform or an #eSPI_EndianTransform value
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT EndianTransform_InPlace(uint8_t* pData, size_t size, eEndianTransform transform);
+
+/*! @brief Copy a buffer while switching the endianness of each data block
+ *
+ * @param[out] *pDst Is the destination buffer. It shall not overlap the source buffer
+ * @param[in] *pSrc Is the source buffer
+ * @param[in] size Is the size of the buffers in bytes. It shall be a multiple of the block size
+ * @param[in] transform Is the endian transform to apply. Can be an #eI2C_EndianTransform or an #eSPI_EndianTransform value
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT EndianTransform_Copy(uint8_t* pDst, const uint8_t* pSrc, size_t size, eEndianTransform transform);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __ENDIAN_TRANSFORM_H_INC */
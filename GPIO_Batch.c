@@ -0,0 +1,188 @@
+/*!*****************************************************************************
+ * @file    GPIO_Batch.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   GPIO state changes batched in PORT updates
+ * @details The changes are merged in masks per PORT when queued, the commit
+ *          only issues the PORT calls
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "GPIO_Batch.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// GPIO batch internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Clear the changes queued of all the PORTs
+//=============================================================================
+static void __GPIO_Batch_Clear(GPIO_Batch* pBatch)
+{
+  for (size_t zPort = 0; zPort < pBatch->PortCount; ++zPort)
+  {
+    GPIO_BatchPort* pPort = &pBatch->pPorts[zPort];
+    pPort->Direction     = 0;
+    pPort->DirectionMask = 0;
+    pPort->Level         = 0;
+    pPort->LevelMask     = 0;
+    pPort->ToggleMask    = 0;
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Apply the changes queued of a PORT
+//=============================================================================
+static eERRORRESULT __GPIO_Batch_CommitPort(GPIO_Batch* pBatch, GPIO_BatchPort* pPort)
+{
+  PORT_Interface* pPORT = pPort->pPORT;
+  eERRORRESULT Error;
+  if (pPort->ToggleMask != 0)                                                    // Toggle from the level of the pins
+  {
+    if (pPORT->fnPORT_GetInputLevel == NULL) return ERR__PARAMETER_ERROR;
+    uint32_t PinsLevel = 0;
+    pBatch->PortCallCount++;
+    Error = pPORT->fnPORT_GetInputLevel(pPORT, &PinsLevel, pPort->ToggleMask);
+    if (Error != ERR_NONE) return Error;
+    pPort->Level     = (pPort->Level & ~pPort->ToggleMask) | (~PinsLevel & pPort->ToggleMask);
+    pPort->LevelMask |= pPort->ToggleMask;
+  }
+  if (pPort->LevelMask != 0)                                                     // Before the directions: a pin becoming an output starts at its level
+  {
+    if (pPORT->fnPORT_SetOutputLevel == NULL) return ERR__PARAMETER_ERROR;
+    pBatch->PortCallCount++;
+    Error = pPORT->fnPORT_SetOutputLevel(pPORT, pPort->Level, pPort->LevelMask);
+    if (Error != ERR_NONE) return Error;
+  }
+  if (pPort->DirectionMask != 0)
+  {
+    if (pPORT->fnPORT_SetDirection == NULL) return ERR__PARAMETER_ERROR;
+    pBatch->PortCallCount++;
+    Error = pPORT->fnPORT_SetDirection(pPORT, pPort->Direction, pPort->DirectionMask);
+    if (Error != ERR_NONE) return Error;
+  }
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// GPIO batch functions
+//********************************************************************************************************************
+//=============================================================================
+// GPIO batch initialization
+//=============================================================================
+eERRORRESULT GPIO_Batch_Init(GPIO_Batch* pBatch)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBatch == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pBatch->pPorts == NULL) || (pBatch->PortCount == 0)) return ERR__CONFIGURATION;
+  for (size_t zPort = 0; zPort < pBatch->PortCount; ++zPort)
+    if (pBatch->pPorts[zPort].pPORT == NULL) return ERR__CONFIGURATION;
+  __GPIO_Batch_Clear(pBatch);
+  pBatch->Open          = false;
+  pBatch->QueuedCount   = 0;
+  pBatch->PortCallCount = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Begin a GPIO batch
+//=============================================================================
+eERRORRESULT GPIO_Batch_Begin(GPIO_Batch* pBatch)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBatch == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pBatch->Open) return ERR__BUSY;
+  __GPIO_Batch_Clear(pBatch);
+  pBatch->Open = true;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Queue a GPIO state change in the batch
+//=============================================================================
+eERRORRESULT GPIO_Batch_SetState(GPIO_Batch* pBatch, GPIO_Interface* pGPIO, const eGPIO_State pinState)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pBatch == NULL) || (pGPIO == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pBatch->Open == false) return ERR__NOT_READY;
+  GPIO_BatchPort* pPort = NULL;
+  for (size_t zPort = 0; zPort < pBatch->PortCount; ++zPort)
+  {
+    const PORT_Interface* pPORT = pBatch->pPorts[zPort].pPORT;
+    if ((pPORT->InterfaceDevice == pGPIO->InterfaceDevice) && (pPORT->PORTindex == pGPIO->PORTindex)) { pPort = &pBatch->pPorts[zPort]; break; }
+  }
+  if (pPort == NULL) return ERR__UNKNOWN_ELEMENT;
+  const uint32_t Mask = pGPIO->PinBitMask;
+  switch (pinState)
+  {
+    case GPIO_STATE_OUTPUT:
+    case GPIO_STATE_INPUT:
+      pPort->Direction      = (pinState == GPIO_STATE_INPUT ? pPort->Direction | Mask : pPort->Direction & ~Mask);
+      pPort->DirectionMask |= Mask;
+      break;
+    case GPIO_STATE_RESET:
+    case GPIO_STATE_SET:
+      pPort->Level       = (pinState == GPIO_STATE_SET ? pPort->Level | Mask : pPort->Level & ~Mask);
+      pPort->LevelMask  |= Mask;
+      pPort->ToggleMask &= ~Mask;                                                // The level is known now
+      break;
+    case GPIO_STATE_TOGGLE:
+      pPort->Level      ^= (Mask & pPort->LevelMask);                            // Toggle the levels queued
+      pPort->ToggleMask ^= (Mask & ~pPort->LevelMask);                           // The others toggle from the level of the pins, toggle twice is no change
+      break;
+    default: return ERR__PARAMETER_ERROR;
+  }
+  pBatch->QueuedCount++;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Apply the changes queued and close the batch
+//=============================================================================
+eERRORRESULT GPIO_Batch_Commit(GPIO_Batch* pBatch)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBatch == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pBatch->Open == false) return ERR__NOT_READY;
+  pBatch->Open = false;
+  for (size_t zPort = 0; zPort < pBatch->PortCount; ++zPort)
+  {
+    const eERRORRESULT Error = __GPIO_Batch_CommitPort(pBatch, &pBatch->pPorts[zPort]);
+    if (Error != ERR_NONE) return Error;
+  }
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
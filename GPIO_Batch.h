@@ -0,0 +1,143 @@
+/*!*****************************************************************************
+ * @file    GPIO_Batch.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   GPIO state changes batched in PORT updates
+ * @details Each fnGPIO_SetState() of a GPIO_Interface is a transaction on its
+ * device, so on an I2C or SPI I/O expander, changing 8 pins costs 8 bus
+ * round trips. A batch collects the state changes of many GPIO_Interface and
+ * applies them at commit with at most one fnPORT_SetOutputLevel() and one
+ * fnPORT_SetDirection() per PORT_Interface, with the pins changed as
+ * pinsChangeMask.
+ * A GPIO belongs to the PORT of the batch with the same InterfaceDevice and
+ * the same PORTindex. The last change of a pin wins, a toggle after a set or
+ * a reset in the same batch toggles the queued level, a toggle alone reads
+ * the pins with fnPORT_GetInputLevel() at commit (one more call for the PORT).
+ * At commit, the output levels are set before the directions, so a pin that
+ * becomes an output in the batch starts at the level queued
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __GPIO_BATCH_H_INC
+#define __GPIO_BATCH_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "GPIO_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// GPIO batch
+//********************************************************************************************************************
+
+//! @brief PORT of a GPIO batch and its changes queued
+typedef struct GPIO_BatchPort
+{
+  PORT_Interface* pPORT;  //!< PORT where the changes of its GPIO are applied
+  //--- Changes queued ---
+  uint32_t Direction;     //!< Direction of the pins changed, if bit is '1' then the corresponding GPIO is input else it's output
+  uint32_t DirectionMask; //!< Pins with a direction change
+  uint32_t Level;         //!< Output level of the pins changed, if bit is '1' then the corresponding GPIO is level high else it's level low
+  uint32_t LevelMask;     //!< Pins with a level change
+  uint32_t ToggleMask;    //!< Pins to toggle from their level read at commit
+} GPIO_BatchPort;
+
+
+//! @brief GPIO batch
+typedef struct GPIO_Batch
+{
+  GPIO_BatchPort* pPorts; //!< PORTs of the batch
+  size_t PortCount;       //!< Count of PORTs
+  //--- Batch state ---
+  bool Open;              //!< 'true' between GPIO_Batch_Begin() and GPIO_Batch_Commit()
+  //--- Statistics ---
+  uint32_t QueuedCount;   //!< Count of GPIO state changes queued
+  uint32_t PortCallCount; //!< Count of PORT interface calls issued by the commits
+} GPIO_Batch;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// GPIO batch functions
+//********************************************************************************************************************
+
+/*! @brief GPIO batch initialization
+ *
+ * @param[in] *pBatch Is the batch to initialize. Its PORTs shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT GPIO_Batch_Init(GPIO_Batch* pBatch);
+
+/*! @brief Begin a GPIO batch
+ *
+ * @param[in] *pBatch Is the batch
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUSY if the batch is already open
+ */
+eERRORRESULT GPIO_Batch_Begin(GPIO_Batch* pBatch);
+
+/*! @brief Queue a GPIO state change in the batch
+ *
+ * Nothing is sent to the device until GPIO_Batch_Commit()
+ * @param[in] *pBatch Is the batch
+ * @param[in] *pGPIO Is the GPIO to change
+ * @param[in] pinState Is the new state of the GPIO following #eGPIO_State enumerator
+ * @return Returns an #eERRORRESULT value enum. #ERR__NOT_READY if the batch is not open, #ERR__UNKNOWN_ELEMENT if the PORT of the GPIO is not in the batch
+ */
+eERRORRESULT GPIO_Batch_SetState(GPIO_Batch* pBatch, GPIO_Interface* pGPIO, const eGPIO_State pinState);
+
+/*! @brief Apply the changes queued and close the batch
+ *
+ * For each PORT with changes: one fnPORT_GetInputLevel() if pins are toggled without a level queued, one fnPORT_SetOutputLevel() then one fnPORT_SetDirection()
+ * @param[in] *pBatch Is the batch
+ * @return Returns an #eERRORRESULT value enum. #ERR__NOT_READY if the batch is not open
+ */
+eERRORRESULT GPIO_Batch_Commit(GPIO_Batch* pBatch);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __GPIO_BATCH_H_INC */
@@ -0,0 +1,333 @@
+/*!*****************************************************************************
+ * @file    I2C_EEPROM.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Page write coalescing access layer for I2C EEPROMs
+ * @details This access layer merges the writes by page and finds the end of
+ *          the write cycles by adaptive acknowledge polling through the
+ *          I2C_Interface for all the https://github.com/Emandhal drivers and
+ *          developments
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+//-----------------------------------------------------------------------------
+#include "I2C_EEPROM.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef USE_ERROR_CONTEXT
+#  define UNIT_ERR_CONTEXT  ERRCONTEXT__EEPROM // Error context of this unit
+#  define EEPROM_ERROR(error)  ERR_GENERATE(error)
+#else
+#  define EEPROM_ERROR(error)  (error)
+#endif
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C EEPROM internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Get the chip address to use for a memory address
+//=============================================================================
+static uint16_t __I2C_EEPROM_ChipAddr(const I2C_EEPROM* pEEPROM, uint32_t address)
+{
+  if (pEEPROM->AddressSize == 1) return pEEPROM->ChipAddr | (uint16_t)(((address >> 8) & 0x7u) << 1); // The address bits above 8 are in the chip address
+  return pEEPROM->ChipAddr;
+}
+
+
+//=============================================================================
+// [STATIC] Fill the memory address bytes (MSB first)
+//=============================================================================
+static size_t __I2C_EEPROM_SetAddress(const I2C_EEPROM* pEEPROM, uint8_t* pDest, uint32_t address)
+{
+  if (pEEPROM->AddressSize == 1)
+  {
+    pDest[0] = (uint8_t)address;
+    return 1;
+  }
+  pDest[0] = (uint8_t)(address >> 8);
+  pDest[1] = (uint8_t)address;
+  return 2;
+}
+
+
+//=============================================================================
+// [STATIC] Get the interval between two acknowledge polls
+//=============================================================================
+static uint32_t __I2C_EEPROM_PollInterval(const I2C_EEPROM* pEEPROM)
+{
+  const uint32_t Interval = (pEEPROM->WriteTime_us > 0 ? pEEPROM->WriteTime_us / 16u : pEEPROM->MaxWriteTime_us / 32u); // Fine polling until the write cycle time is learned
+  return (Interval < I2C_EEPROM_MIN_POLL_INTERVAL_us ? I2C_EEPROM_MIN_POLL_INTERVAL_us : Interval);
+}
+
+
+//=============================================================================
+// [STATIC] Learn the write cycle time at the acknowledge
+//=============================================================================
+static void __I2C_EEPROM_LearnWriteTime(I2C_EEPROM* pEEPROM, uint32_t elapsed_us)
+{
+  pEEPROM->LastWriteTime_us = elapsed_us;
+  if (pEEPROM->WriteTime_us == 0) pEEPROM->WriteTime_us = elapsed_us;
+  else if (pEEPROM->CyclePolls == 1)                                              // Acknowledged at the first poll: the write cycle may be shorter
+    pEEPROM->WriteTime_us -= pEEPROM->WriteTime_us / 16u;
+  else pEEPROM->WriteTime_us = elapsed_us - (__I2C_EEPROM_PollInterval(pEEPROM) / 2u); // The write cycle ended between the last two polls
+  if (pEEPROM->WriteTime_us < I2C_EEPROM_MIN_POLL_INTERVAL_us) pEEPROM->WriteTime_us = I2C_EEPROM_MIN_POLL_INTERVAL_us;
+}
+
+
+//=============================================================================
+// [STATIC] Write the data of the page buffer with one page write
+//=============================================================================
+static eERRORRESULT __I2C_EEPROM_WritePage(I2C_EEPROM* pEEPROM)
+{
+  if (pEEPROM->DirtyEnd == pEEPROM->DirtyStart) return ERR_NONE;
+  eERRORRESULT Error = I2C_EEPROM_WaitReady(pEEPROM);                             // The previous write cycle shall be finished
+  if (Error != ERR_NONE) return Error;
+  const uint32_t Address  = pEEPROM->PageAddress + pEEPROM->DirtyStart;
+  const uint16_t ChipAddr = __I2C_EEPROM_ChipAddr(pEEPROM, Address);
+  const size_t Size = pEEPROM->DirtyEnd - pEEPROM->DirtyStart;
+  uint8_t AddrBytes[2];
+  const size_t AddrSize = __I2C_EEPROM_SetAddress(pEEPROM, AddrBytes, Address);
+  I2CInterface_Packet Packets[2] =
+  {
+    I2C_INTERFACE8_TX_DATA_DESC(ChipAddr, true, AddrBytes, AddrSize, false, I2C_WRITE_THEN_WRITE_FIRST_PART),
+    I2C_INTERFACE8_TX_DATA_DESC(ChipAddr, false, &pEEPROM->pPageBuffer[pEEPROM->DirtyStart], Size, true, I2C_WRITE_THEN_WRITE_SECOND_PART),
+  };
+  Error = Interface_I2CtransferBatch(pEEPROM->pI2C, Packets, 2, NULL);
+  if (Error != ERR_NONE) return Error;                                            // The data stay in the page buffer
+
+  //--- The write cycle starts at the stop ---
+  pEEPROM->WriteInProgress = true;
+  pEEPROM->WriteStart_us   = pEEPROM->fnGetCurrentus();
+  pEEPROM->CyclePolls      = 0;
+  pEEPROM->NextPoll_us     = (pEEPROM->WriteTime_us > 0 ? pEEPROM->WriteTime_us - (pEEPROM->WriteTime_us / 8u) : __I2C_EEPROM_PollInterval(pEEPROM)); // First poll a bit before the learned time
+  pEEPROM->DirtyStart      = 0;
+  pEEPROM->DirtyEnd        = 0;
+  pEEPROM->PageWriteCount++;
+  pEEPROM->WriteBytes += Size;
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C EEPROM functions
+//********************************************************************************************************************
+//=============================================================================
+// I2C EEPROM initialization
+//=============================================================================
+eERRORRESULT I2C_EEPROM_Init(I2C_EEPROM* pEEPROM)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pEEPROM == NULL) || (pEEPROM->pI2C == NULL) || (pEEPROM->fnGetCurrentus == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if (pEEPROM->pPageBuffer == NULL) return EEPROM_ERROR(ERR__NULL_BUFFER);
+  if ((pEEPROM->AddressSize < 1) || (pEEPROM->AddressSize > 2)) return EEPROM_ERROR(ERR__I2C_CONFIG_ERROR);
+  if ((pEEPROM->PageSize == 0) || ((pEEPROM->PageSize & (pEEPROM->PageSize - 1u)) != 0)) return EEPROM_ERROR(ERR__I2C_CONFIG_ERROR);
+  if ((pEEPROM->MemorySize == 0) || (pEEPROM->MemorySize > (pEEPROM->AddressSize == 1 ? 2048u : 65536u))) return EEPROM_ERROR(ERR__I2C_CONFIG_ERROR);
+  if (pEEPROM->MaxWriteTime_us == 0) return EEPROM_ERROR(ERR__I2C_CONFIG_ERROR);
+  pEEPROM->PageAddress      = 0;
+  pEEPROM->DirtyStart       = 0;
+  pEEPROM->DirtyEnd         = 0;
+  pEEPROM->WriteInProgress  = false;
+  pEEPROM->WriteTime_us     = 0;
+  pEEPROM->PageWriteCount   = 0;
+  pEEPROM->MergedWriteCount = 0;
+  pEEPROM->WriteBytes       = 0;
+  pEEPROM->PollCount        = 0;
+  pEEPROM->BusyPollCount    = 0;
+  pEEPROM->LastWriteTime_us = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Read data from the EEPROM
+//=============================================================================
+eERRORRESULT I2C_EEPROM_Read(I2C_EEPROM* pEEPROM, uint32_t address, uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pEEPROM == NULL) || (pData == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if ((address > pEEPROM->MemorySize) || (size > (pEEPROM->MemorySize - address))) return EEPROM_ERROR(ERR__BAD_ADDRESS);
+  eERRORRESULT Error = I2C_EEPROM_WaitReady(pEEPROM);                             // The EEPROM does not acknowledge during a write cycle
+  if (Error != ERR_NONE) return Error;
+
+  //--- Random reads ---
+  uint32_t Address = address;
+  uint8_t* pDest = pData;
+  size_t Remaining = size;
+  while (Remaining > 0)
+  {
+    size_t Count = Remaining;
+    if (pEEPROM->AddressSize == 1)                                                // The chip address changes at each 256 bytes block
+    {
+      const size_t BlockRemaining = 256u - (Address & 0xFFu);
+      if (Count > BlockRemaining) Count = BlockRemaining;
+    }
+    const uint16_t ChipAddr = __I2C_EEPROM_ChipAddr(pEEPROM, Address);
+    uint8_t AddrBytes[2];
+    const size_t AddrSize = __I2C_EEPROM_SetAddress(pEEPROM, AddrBytes, Address);
+    I2CInterface_Packet Packets[2] =
+    {
+      I2C_INTERFACE8_TX_DATA_DESC(ChipAddr, true, AddrBytes, AddrSize, false, I2C_WRITE_THEN_READ_FIRST_PART),
+      I2C_INTERFACE8_RX_DATA_DESC(ChipAddr, true, pDest, Count, true, I2C_WRITE_THEN_READ_SECOND_PART),
+    };
+    Error = Interface_I2CtransferBatch(pEEPROM->pI2C, Packets, 2, NULL);
+    if (Error != ERR_NONE) return Error;
+    Address += (uint32_t)Count; pDest += Count; Remaining -= Count;
+  }
+
+  //--- The data not written yet are in the page buffer ---
+  if (pEEPROM->DirtyEnd != pEEPROM->DirtyStart)
+  {
+    const uint32_t DirtyStart = pEEPROM->PageAddress + pEEPROM->DirtyStart;
+    const uint32_t DirtyEnd   = pEEPROM->PageAddress + pEEPROM->DirtyEnd;
+    const uint32_t Start = (DirtyStart > address ? DirtyStart : address);
+    const uint32_t End   = (DirtyEnd < (address + size) ? DirtyEnd : (uint32_t)(address + size));
+    if (Start < End) memcpy(&pData[Start - address], &pEEPROM->pPageBuffer[Start - pEEPROM->PageAddress], End - Start);
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Write data to the EEPROM
+//=============================================================================
+eERRORRESULT I2C_EEPROM_Write(I2C_EEPROM* pEEPROM, uint32_t address, const uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pEEPROM == NULL) || (pData == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if ((address > pEEPROM->MemorySize) || (size > (pEEPROM->MemorySize - address))) return EEPROM_ERROR(ERR__BAD_ADDRESS);
+  eERRORRESULT Error;
+  while (size > 0)
+  {
+    const uint32_t Page   = address & ~((uint32_t)pEEPROM->PageSize - 1u);
+    const uint16_t Offset = (uint16_t)(address - Page);
+    const uint16_t Count  = (uint16_t)(size < (size_t)(pEEPROM->PageSize - Offset) ? size : (size_t)(pEEPROM->PageSize - Offset));
+
+    //--- Merge with the data of the page buffer if they follow or overlap ---
+    if (pEEPROM->DirtyEnd != pEEPROM->DirtyStart)
+    {
+      if ((Page != pEEPROM->PageAddress) || (Offset > pEEPROM->DirtyEnd) || ((Offset + Count) < pEEPROM->DirtyStart))
+      {
+        Error = __I2C_EEPROM_WritePage(pEEPROM);                                  // Not contiguous, write the page buffer first
+        if (Error != ERR_NONE) return Error;
+      }
+      else pEEPROM->MergedWriteCount++;
+    }
+    if (pEEPROM->DirtyEnd == pEEPROM->DirtyStart)
+    {
+      pEEPROM->PageAddress = Page;
+      pEEPROM->DirtyStart  = Offset;
+      pEEPROM->DirtyEnd    = Offset + Count;
+    }
+    else
+    {
+      if (Offset < pEEPROM->DirtyStart) pEEPROM->DirtyStart = Offset;
+      if ((Offset + Count) > pEEPROM->DirtyEnd) pEEPROM->DirtyEnd = Offset + Count;
+    }
+    memcpy(&pEEPROM->pPageBuffer[Offset], pData, Count);
+
+    //--- A full page is written immediately ---
+    if ((pEEPROM->DirtyStart == 0) && (pEEPROM->DirtyEnd == pEEPROM->PageSize))
+    {
+      Error = __I2C_EEPROM_WritePage(pEEPROM);
+      if (Error != ERR_NONE) return Error;
+    }
+    address += Count; pData += Count; size -= Count;
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Write the data of the page buffer
+//=============================================================================
+eERRORRESULT I2C_EEPROM_Flush(I2C_EEPROM* pEEPROM)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pEEPROM == NULL) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  return __I2C_EEPROM_WritePage(pEEPROM);
+}
+
+
+//=============================================================================
+// Check the end of the write cycle
+//=============================================================================
+eERRORRESULT I2C_EEPROM_IsReady(I2C_EEPROM* pEEPROM, bool* pIsReady)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pEEPROM == NULL) || (pIsReady == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  *pIsReady = (pEEPROM->WriteInProgress == false);
+  if (*pIsReady) return ERR_NONE;
+  const uint32_t Elapsed = pEEPROM->fnGetCurrentus() - pEEPROM->WriteStart_us;
+  if (Elapsed < pEEPROM->NextPoll_us) return ERR_NONE;                            // Too early, do not use the bus
+
+  //--- Acknowledge poll ---
+  I2CInterface_Packet Probe = I2C_INTERFACE8_NO_DATA_DESC(pEEPROM->ChipAddr);
+  pEEPROM->PollCount++;
+  pEEPROM->CyclePolls++;
+  const eERRORRESULT Error = pEEPROM->pI2C->fnI2C_Transfer(pEEPROM->pI2C, &Probe);
+  if (Error == ERR_NONE)                                                          // Acknowledged: end of the write cycle
+  {
+    __I2C_EEPROM_LearnWriteTime(pEEPROM, Elapsed);
+    pEEPROM->WriteInProgress = false;
+    *pIsReady = true;
+    return ERR_NONE;
+  }
+  if ((Error != ERR__I2C_NACK) && (Error != ERR__I2C_NACK_ADDR)) return Error;
+  pEEPROM->BusyPollCount++;
+  if (Elapsed > (2u * pEEPROM->MaxWriteTime_us))
+  {
+    pEEPROM->WriteInProgress = false;
+    return EEPROM_ERROR(ERR__DEVICE_TIMEOUT);
+  }
+  pEEPROM->NextPoll_us = Elapsed + __I2C_EEPROM_PollInterval(pEEPROM);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Wait for the end of the write cycle
+//=============================================================================
+eERRORRESULT I2C_EEPROM_WaitReady(I2C_EEPROM* pEEPROM)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pEEPROM == NULL) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  bool IsReady = false;
+  while (true)
+  {
+    const eERRORRESULT Error = I2C_EEPROM_IsReady(pEEPROM, &IsReady);
+    if ((Error != ERR_NONE) || IsReady) return Error;
+    if (pEEPROM->fnYield != NULL) pEEPROM->fnYield();
+  }
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
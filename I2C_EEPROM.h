@@ -0,0 +1,191 @@
+/*!*****************************************************************************
+ * @file    I2C_EEPROM.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Page write coalescing access layer for I2C EEPROMs
+ * @details This access layer reads and writes the 24xx family I2C EEPROMs
+ * through the I2C_Interface for all the https://github.com/Emandhal drivers and
+ * developments:
+ * - The writes are split on the page boundaries, and the small writes that
+ *   follow each other in the same page are merged in a page buffer then
+ *   written with one page write
+ * - The end of the write cycle is found by acknowledge polling. The first poll
+ *   is done at the write cycle time learned from the previous writes, so the
+ *   bus is not flooded with polls and there is no blind fixed delay
+ * - A page write returns without waiting for its write cycle: the bus stays
+ *   free for the other devices until the next access of the EEPROM. The
+ *   caller can also do them in the yield function while the layer waits
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __I2C_EEPROM_H_INC
+#define __I2C_EEPROM_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "I2C_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define I2C_EEPROM_MIN_POLL_INTERVAL_us  ( 50u ) //!< Minimum interval between two acknowledge polls. An acknowledge poll is about 10 SCL cycles
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C EEPROM
+//********************************************************************************************************************
+
+/*! @brief Function that gives the current time in microseconds
+ *
+ * The value can wrap around, only the differences are used
+ */
+typedef uint32_t (*I2C_EEPROMGetCurrentus_Func)(void);
+
+/*! @brief Function called while waiting for the end of a write cycle
+ *
+ * This function can transfer with the other devices of the bus, or give the CPU to other threads or tasks (sched_yield(), taskYIELD(), osThreadYield()...)
+ */
+typedef void (*I2C_EEPROMYield_Func)(void);
+
+
+//! @brief I2C EEPROM. All the arrays are given by the user
+typedef struct I2C_EEPROM
+{
+  I2C_Interface* pI2C;                        //!< I2C interface of the bus
+  uint16_t ChipAddr;                          //!< I2C chip address of the EEPROM with the R/W bit cleared (8-bits format)
+  uint8_t AddressSize;                        //!< Memory address size in bytes (1 or 2). With 1 byte, the address bits above 8 are sent in the chip address (24xx04 to 24xx16)
+  uint16_t PageSize;                          //!< Page size of the EEPROM in bytes (power of 2)
+  uint32_t MemorySize;                        //!< Memory size of the EEPROM in bytes
+  uint32_t MaxWriteTime_us;                   //!< Maximum write cycle time of the datasheet (tWR) in microseconds. A write cycle longer than twice this time is a timeout
+  uint8_t* pPageBuffer;                       //!< Page buffer of the merged writes (PageSize bytes)
+  I2C_EEPROMGetCurrentus_Func fnGetCurrentus; //!< This function will be called to get the current time in microseconds
+  I2C_EEPROMYield_Func fnYield;               //!< This function will be called while waiting for the end of a write cycle. Can be NULL (busy wait)
+  //--- Merged writes ---
+  uint32_t PageAddress;                       //!< Address of the page in the page buffer
+  uint16_t DirtyStart;                        //!< Start of the data to write in the page buffer
+  uint16_t DirtyEnd;                          //!< End of the data to write in the page buffer. Equal to DirtyStart if there is no data to write
+  //--- Write cycle ---
+  bool WriteInProgress;                       //!< 'true' while the last write cycle is not acknowledged
+  uint32_t WriteStart_us;                     //!< Time of the start of the write cycle
+  uint32_t NextPoll_us;                       //!< Time of the next acknowledge poll, relative to WriteStart_us
+  uint32_t CyclePolls;                        //!< Count of acknowledge polls of the write cycle
+  uint32_t WriteTime_us;                      //!< Write cycle time learned from the previous writes. 0 if not learned yet
+  //--- Statistics ---
+  uint32_t PageWriteCount;                    //!< Count of page writes
+  uint32_t MergedWriteCount;                  //!< Count of writes merged with the data already in the page buffer
+  uint64_t WriteBytes;                        //!< Count of bytes written to the EEPROM
+  uint32_t PollCount;                         //!< Count of acknowledge polls
+  uint32_t BusyPollCount;                     //!< Count of acknowledge polls not acknowledged (write cycle in progress)
+  uint32_t LastWriteTime_us;                  //!< Write cycle time measured at the last acknowledge
+} I2C_EEPROM;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C EEPROM functions
+//********************************************************************************************************************
+
+/*! @brief I2C EEPROM initialization
+ *
+ * Check the configuration, empty the page buffer and reset the learned write cycle time and the statistics. The I2C interface shall already be initialized
+ * @param[in] *pEEPROM Is the EEPROM to initialize. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_EEPROM_Init(I2C_EEPROM* pEEPROM);
+
+/*! @brief Read data from the EEPROM
+ *
+ * Wait for the end of the write cycle in progress, then read with random reads (split at the 256 bytes blocks when the address bits are in the chip address). The data not written yet of the page buffer are copied over the data read
+ * @param[in] *pEEPROM Is the EEPROM
+ * @param[in] address Is the address of the data to read
+ * @param[out] *pData Is where the data will be stored
+ * @param[in] size Is the size of the data to read
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_EEPROM_Read(I2C_EEPROM* pEEPROM, uint32_t address, uint8_t* pData, size_t size);
+
+/*! @brief Write data to the EEPROM
+ *
+ * The data are split on the page boundaries. A part that follows or overlaps the data of the page buffer is merged with them, else the page buffer is written first
+ * A full page is written immediately, the last partial page stays in the page buffer until a write to another place or I2C_EEPROM_Flush()
+ * This function does not wait for the end of the last write cycle
+ * @param[in] *pEEPROM Is the EEPROM
+ * @param[in] address Is the address where the data will be written
+ * @param[in] *pData Is the data to write
+ * @param[in] size Is the size of the data to write
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_EEPROM_Write(I2C_EEPROM* pEEPROM, uint32_t address, const uint8_t* pData, size_t size);
+
+/*! @brief Write the data of the page buffer
+ *
+ * This function does not wait for the end of the write cycle, use I2C_EEPROM_WaitReady() if needed
+ * @param[in] *pEEPROM Is the EEPROM
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_EEPROM_Flush(I2C_EEPROM* pEEPROM);
+
+/*! @brief Check the end of the write cycle
+ *
+ * This never waits: the acknowledge poll is only done when the time of the next poll is reached
+ * @param[in] *pEEPROM Is the EEPROM
+ * @param[out] *pIsReady Is where the ready state will be stored: 'true' if there is no write cycle in progress
+ * @return Returns an #eERRORRESULT value enum. #ERR__DEVICE_TIMEOUT if the write cycle lasts more than twice MaxWriteTime_us
+ */
+eERRORRESULT I2C_EEPROM_IsReady(I2C_EEPROM* pEEPROM, bool* pIsReady);
+
+/*! @brief Wait for the end of the write cycle
+ *
+ * The yield function is called between the acknowledge polls
+ * @param[in] *pEEPROM Is the EEPROM
+ * @return Returns an #eERRORRESULT value enum. #ERR__DEVICE_TIMEOUT if the write cycle lasts more than twice MaxWriteTime_us
+ */
+eERRORRESULT I2C_EEPROM_WaitReady(I2C_EEPROM* pEEPROM);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __I2C_EEPROM_H_INC */
@@ -1,8 +1,8 @@
 /*!*****************************************************************************
  * @file    I2C_Interface.h
  * @author  Fabien 'Emandhal' MAILLY
- * @version 1.1.1
- * @date    02/10/2021
+ * @version 1.6.0
+ * @date    16/10/2026
  * @brief   I2C interface for drivers
  * @details This I2C interface that can be used to communicate with devices
  *          for all the https://github.com/Emandhal drivers and developments.
@@ -10,6 +10,11 @@
  ******************************************************************************/
 
 /* Revision history:
+ * 1.6.0    Add the asynchronous transfer of the STM32cubeIDE HAL interface
+ * 1.5.0    Add CRC computation and check of the packets
+ * 1.4.0    Use the shared endian transform engine
+ * 1.3.0    Add asynchronous transfer with completion
+ * 1.2.0    Add batch transfer
  * 1.1.1    Add STM32cubeIDE
  * 1.1.0    Add Arduino
  * 1.0.0    Release version
@@ -17,6 +22,7 @@
 
 //-----------------------------------------------------------------------------
 #include "I2C_Interface.h"
+#include "EndianTransform.h"
 #include "ErrorsDef.h"
 //-----------------------------------------------------------------------------
 #ifdef __cplusplus
@@ -175,6 +181,53 @@ static eERRORRESULT __I2CHALstatusToERRORRESULT(HAL_StatusTypeDef halError)
 }
 
 
+//=============================================================================
+// [STATIC] Device polling with STM32cubeIDE and HAL driver
+//=============================================================================
+static eERRORRESULT __Interface_I2CpollHAL(I2C_Interface *pIntDev, const I2CInterface_Packet* const pPacketDesc)
+{
+  const uint16_t ChipAddr = (pPacketDesc->ChipAddr & (I2C_IS_10BITS_ADDRESS(pPacketDesc->ChipAddr) ? I2C_ONLY_ADDR10_Mask : I2C_ONLY_ADDR8_Mask));
+  switch (HAL_I2C_IsDeviceReady(pIntDev->pHI2C, ChipAddr, 1, 2))
+  {
+    case HAL_OK     : break;
+    default:
+    case HAL_ERROR  : return ERR__I2C_COMM_ERROR;
+    case HAL_BUSY   : return ERR__I2C_NACK;
+    case HAL_TIMEOUT: return ERR__I2C_TIMEOUT;
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Start the interrupt transfer of a packet with STM32cubeIDE and HAL driver
+//=============================================================================
+static eERRORRESULT __Interface_I2CstartHAL(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc)
+{
+  const bool DeviceWrite = ((pPacketDesc->ChipAddr & 0x01) == 0);
+  const uint16_t ChipAddr = (pPacketDesc->ChipAddr & (I2C_IS_10BITS_ADDRESS(pPacketDesc->ChipAddr) ? I2C_ONLY_ADDR10_Mask : I2C_ONLY_ADDR8_Mask));
+  const uint32_t XferOption = (pPacketDesc->Stop ? I2C_AUTOEND_MODE : I2C_SOFTEND_MODE);
+  if (DeviceWrite)
+    return __I2CHALstatusToERRORRESULT(HAL_I2C_Master_Seq_Transmit_IT(pIntDev->pHI2C, ChipAddr, pPacketDesc->pBuffer, pPacketDesc->BufferSize, XferOption));
+  return __I2CHALstatusToERRORRESULT(HAL_I2C_Master_Seq_Receive_IT(pIntDev->pHI2C, ChipAddr, pPacketDesc->pBuffer, pPacketDesc->BufferSize, XferOption));
+}
+
+
+//=============================================================================
+// [STATIC] Transfer a non-blocking packet with the transaction of the interface
+//=============================================================================
+static eERRORRESULT __Interface_I2CnonBlockingHAL(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc)
+{
+  I2CInterface_Transaction* const pTransaction = &pIntDev->_NonBlockingTransaction;
+  if (pTransaction->Status == I2C_TRANSACTION_PENDING) return ERR__BUSY;                  // The previous non-blocking packet is still in transfer
+  if ((pPacketDesc->pBuffer == NULL) || (pPacketDesc->BufferSize <= 0))                   // Status check of the previous non-blocking packet
+    return (pTransaction->Status == I2C_TRANSACTION_COMPLETE ? pTransaction->Result : ERR_NONE);
+  pIntDev->_NonBlockingPacket = *pPacketDesc;                                             // The packet of the driver may not stay valid until the end of the transfer
+  Interface_I2CinitTransaction(pTransaction, &pIntDev->_NonBlockingPacket, NULL, NULL);
+  return Interface_I2CtransferAsync(pIntDev, pTransaction);
+}
+
+
 //=============================================================================
 // Function for I2C transfer with STM32cubeIDE and HAL driver
 //=============================================================================
@@ -183,41 +236,158 @@ eERRORRESULT Interface_I2Ctransfer(I2C_Interface *pIntDev, I2CInterface_Packet*
 #ifdef CHECK_NULL_PARAM
   if (pIntDev == NULL) return ERR__I2C_PARAMETER_ERROR;
 #endif
-  const bool DeviceWrite = ((pPacketDesc->ChipAddr & 0x01) == 0);
-  const uint16_t ChipAddr = (pPacketDesc->ChipAddr & I2C_ONLY_ADDR_Mask);
-  const uint32_t XferOption = (pPacketDesc->Stop ? I2C_AUTOEND_MODE : I2C_SOFTEND_MODE);
-  HAL_StatusTypeDef HALerror;
   eERRORRESULT Error;
 
+  //--- Non-blocking packet? ---
+  if (pPacketDesc->Config.Bits.IsNonBlocking && (pIntDev->fnI2C_TransferAsync != NULL)) // Goes through the asynchronous path
+    return __Interface_I2CnonBlockingHAL(pIntDev, pPacketDesc);
+  while (pIntDev->_pAsyncHead != NULL);           // Wait for the end of the pending asynchronous transactions
+
   //--- Device polling? ---
   if ((pPacketDesc->pBuffer == NULL) || (pPacketDesc->BufferSize <= 0)) // Device polling only
-  {
-    HALerror = HAL_I2C_IsDeviceReady(pIntDev->pHI2C, ChipAddr, 1, 2);
-    switch (HALerror)
-    {
-      case HAL_OK     : break;
-      default:
-      case HAL_ERROR  : return ERR__I2C_COMM_ERROR;
-      case HAL_BUSY   : return ERR__I2C_NACK;
-      case HAL_TIMEOUT: return ERR__I2C_TIMEOUT;
-    }
-    return ERR_NONE;
-  }
+    return __Interface_I2CpollHAL(pIntDev, pPacketDesc);
 
   //--- Transfer data ---
   Error = __Interface_I2Cstatus(pIntDev->pHI2C); // Wait for a I2C ready
   if (Error != ERR_NONE) return Error;           // If the status of the I2C is not ready, return the error
-  if (DeviceWrite)
+  Error = __Interface_I2CstartHAL(pIntDev, pPacketDesc);
+  if (Error != ERR_NONE) return Error;           // If there is an error while calling HAL_I2C_Master_Seq_Transmit_IT() or HAL_I2C_Master_Seq_Receive_IT() then return the error
+  if (pPacketDesc->pCRC == NULL) return __I2CerrorCodeToERRORRESULT(HAL_I2C_GetError(pIntDev->pHI2C));
+
+  //--- CRC of the packet, in a pass over the buffer once the interrupt transfer is done ---
+  Error = __Interface_I2Cstatus(pIntDev->pHI2C); // Wait for the end of the transfer
+  if (Error != ERR_NONE) return Error;
+  Error = __I2CerrorCodeToERRORRESULT(HAL_I2C_GetError(pIntDev->pHI2C));
+  if (Error != ERR_NONE) return Error;
+  return Interface_I2CpacketCRC(pPacketDesc);    // No endian transform with HAL, the bytes are as on the bus
+}
+
+
+//=============================================================================
+// [STATIC] Get the interface of an I2C handle that uses the asynchronous transfer, register it if asked
+//=============================================================================
+static I2C_Interface* __Interface_I2CgetAsyncHAL(I2C_HandleTypeDef *hi2c, I2C_Interface *pIntDev)
+{
+  static I2C_Interface* AsyncInterfaces[I2C_INTERFACE_HAL_ASYNC_COUNT] = { NULL };
+  for (size_t zIdx = 0; zIdx < I2C_INTERFACE_HAL_ASYNC_COUNT; ++zIdx)
+  {
+    if ((AsyncInterfaces[zIdx] != NULL) && (AsyncInterfaces[zIdx]->pHI2C == hi2c)) return AsyncInterfaces[zIdx];
+    if ((AsyncInterfaces[zIdx] != NULL) || (pIntDev == NULL)) continue;
+    //--- Register the interface ---
+#if (USE_HAL_I2C_REGISTER_CALLBACKS == 1)
+    if (HAL_I2C_RegisterCallback(hi2c, HAL_I2C_MASTER_TX_COMPLETE_CB_ID, Interface_I2CtransferCompleteHAL) != HAL_OK) return NULL;
+    if (HAL_I2C_RegisterCallback(hi2c, HAL_I2C_MASTER_RX_COMPLETE_CB_ID, Interface_I2CtransferCompleteHAL) != HAL_OK) return NULL;
+    if (HAL_I2C_RegisterCallback(hi2c, HAL_I2C_ERROR_CB_ID             , Interface_I2CtransferErrorHAL   ) != HAL_OK) return NULL;
+#endif // USE_HAL_I2C_REGISTER_CALLBACKS
+    AsyncInterfaces[zIdx] = pIntDev;
+    return pIntDev;
+  }
+  return NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Remove the transaction in transfer and start the next pending one
+//=============================================================================
+static void __Interface_I2CnextAsyncHAL(I2C_Interface *pIntDev)
+{
+  I2CInterface_Transaction* pNext = pIntDev->_pAsyncHead->pNext;
+  pIntDev->_pAsyncHead = pNext;
+  if (pNext == NULL) pIntDev->_pAsyncTail = NULL;
+  while (pNext != NULL)
   {
-    Error = __I2CHALstatusToERRORRESULT(HAL_I2C_Master_Seq_Transmit_IT(pIntDev->pHI2C, ChipAddr, pPacketDesc->pBuffer, pPacketDesc->BufferSize, XferOption));
-    if (Error != ERR_NONE) return Error;         // If there is an error while calling HAL_I2C_Master_Seq_Transmit_IT() then return the error
+    const eERRORRESULT Error = __Interface_I2CstartHAL(pIntDev, &pNext->Packet);
+    if (Error == ERR_NONE) return;
+    I2CInterface_Transaction* const pFailed = pNext;                                     // Not started, complete it with the error
+    pNext = pFailed->pNext;
+    pIntDev->_pAsyncHead = pNext;
+    if (pNext == NULL) pIntDev->_pAsyncTail = NULL;
+    Interface_I2CcompleteTransaction(pFailed, Error);                                    // If its completion function submits a transaction with an empty queue, the submission starts it
   }
-  else
+}
+
+
+//=============================================================================
+// [STATIC] End the asynchronous transaction in transfer
+//=============================================================================
+static void __Interface_I2CendAsyncHAL(I2C_HandleTypeDef *hi2c, eERRORRESULT result)
+{
+  I2C_Interface* const pIntDev = __Interface_I2CgetAsyncHAL(hi2c, NULL);
+  if (pIntDev == NULL) return;                                                           // Not an interface with asynchronous transfers
+  I2CInterface_Transaction* const pTransaction = pIntDev->_pAsyncHead;
+  if (pTransaction == NULL) return;                                                      // Not an asynchronous transfer
+  if ((result == ERR_NONE) && (pTransaction->Packet.pCRC != NULL))
+    result = Interface_I2CpacketCRC(&pTransaction->Packet);                              // No endian transform with HAL, the bytes are as on the bus
+  __Interface_I2CnextAsyncHAL(pIntDev);                                                  // Start the next one before the completion of this one to keep the bus busy
+  Interface_I2CcompleteTransaction(pTransaction, result);
+}
+
+
+//=============================================================================
+// End of an I2C asynchronous transfer with STM32cubeIDE and HAL driver
+//=============================================================================
+void Interface_I2CtransferCompleteHAL(I2C_HandleTypeDef *hi2c)
+{
+  __Interface_I2CendAsyncHAL(hi2c, ERR_NONE);
+}
+
+
+//=============================================================================
+// Error of an I2C asynchronous transfer with STM32cubeIDE and HAL driver
+//=============================================================================
+void Interface_I2CtransferErrorHAL(I2C_HandleTypeDef *hi2c)
+{
+  const eERRORRESULT Error = __I2CerrorCodeToERRORRESULT(HAL_I2C_GetError(hi2c));
+  __Interface_I2CendAsyncHAL(hi2c, (Error != ERR_NONE ? Error : ERR__I2C_COMM_ERROR));
+}
+
+
+//=============================================================================
+// Function for I2C asynchronous transfer with STM32cubeIDE and HAL driver
+//=============================================================================
+eERRORRESULT Interface_I2CtransferAsyncHAL(I2C_Interface *pIntDev, I2CInterface_Transaction* const pTransaction)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pTransaction == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if (__Interface_I2CgetAsyncHAL(pIntDev->pHI2C, pIntDev) != pIntDev) return ERR__OUT_OF_MEMORY;
+  I2CInterface_Packet* const pPacket = &pTransaction->Packet;
+  eERRORRESULT Error;
+
+  //--- Device polling? Done now, the HAL has no interrupt polling ---
+  if ((pPacket->pBuffer == NULL) || (pPacket->BufferSize <= 0))
   {
-    Error = __I2CHALstatusToERRORRESULT(HAL_I2C_Master_Seq_Receive_IT(pIntDev->pHI2C, ChipAddr, pPacketDesc->pBuffer, pPacketDesc->BufferSize, XferOption));
-    if (Error != ERR_NONE) return Error;         // If there is an error while calling HAL_I2C_Master_Seq_Receive_IT() then return the error
+    if (pIntDev->_pAsyncHead != NULL) return ERR__BUSY;                                  // Can't wait for the pending transactions here
+    Interface_I2CcompleteTransaction(pTransaction, __Interface_I2CpollHAL(pIntDev, pPacket));
+    return ERR_NONE;
   }
-  return __I2CerrorCodeToERRORRESULT(HAL_I2C_GetError(pIntDev->pHI2C));
+
+  //--- Queue the transaction, start it if the bus is idle ---
+  if (pIntDev->_pAsyncHead == NULL)
+  {
+    Error = __Interface_I2Cstatus(pIntDev->pHI2C);                                       // Wait for the end of a blocking transfer
+    if (Error != ERR_NONE) return Error;
+  }
+  pTransaction->pNext = NULL;
+  const uint32_t PriMask = __get_PRIMASK();
+  __disable_irq();                                                                       // The completion of the transaction in transfer modifies the queue
+  if (pIntDev->_pAsyncHead != NULL)
+  {
+    pIntDev->_pAsyncTail->pNext = pTransaction;                                          // Started at the end of the previous one
+    pIntDev->_pAsyncTail = pTransaction;
+    __set_PRIMASK(PriMask);
+    return ERR_NONE;
+  }
+  pIntDev->_pAsyncHead = pTransaction;
+  pIntDev->_pAsyncTail = pTransaction;
+  Error = __Interface_I2CstartHAL(pIntDev, pPacket);                                     // The end of transfer interrupt can't happen before the queue is set
+  if (Error != ERR_NONE)
+  {
+    pIntDev->_pAsyncHead = NULL;                                                         // Transaction not accepted
+    pIntDev->_pAsyncTail = NULL;
+  }
+  __set_PRIMASK(PriMask);
+  return Error;
 }
 #endif // #if defined(USE_HAL_DRIVER) && defined(STM32G4xx_HAL_I2C_H) // STM32cubeIDE with HAL
 
@@ -259,9 +429,10 @@ eERRORRESULT Interface_I2Ctransfer(I2C_Interface *pIntDev, I2CInterface_Packet*
   size_t CurrentBlockPos = BlockSize;
 
   //--- Transfer data ---
-  uint8_t* pBuffer = &pPacketDesc->pBuffer[BlockSize - 1];                                          // Adjust the start of data for endianness
+  uint8_t* pBuffer = pPacketDesc->pBuffer;
   if (DeviceWrite) // Device write
   {
+    pBuffer += BlockSize - 1;                                                                       // Adjust the start of data for endianness. The TX buffer of the driver is not modified
     const uint32_t RequestMode = (pPacketDesc->Start ? LL_I2C_GENERATE_START_WRITE : LL_I2C_GENERATE_NOSTARTSTOP);
     LL_I2C_HandleTransfer(pIntDev->pHI2C, ChipAddr, ChipAddrSize, RemainingBytes, EndMode, RequestMode);
     while (true)
@@ -300,16 +471,8 @@ eERRORRESULT Interface_I2Ctransfer(I2C_Interface *pIntDev, I2CInterface_Packet*
         --Timeout;
       }
 
-      *pBuffer = LL_I2C_ReceiveData8(pIntDev->pHI2C);                                               // Get next data byte
+      *pBuffer++ = LL_I2C_ReceiveData8(pIntDev->pHI2C);                                             // Get next data byte
       --RemainingBytes;
-      //--- Adjust buffer address with data striding ---
-      --CurrentBlockPos;
-      if (CurrentBlockPos == 0)
-      {
-        pBuffer += (2 * BlockSize) - 1;
-        CurrentBlockPos = BlockSize;
-      }
-      else --pBuffer;
     }
   }
   if (pPacketDesc->Stop)
@@ -324,15 +487,266 @@ eERRORRESULT Interface_I2Ctransfer(I2C_Interface *pIntDev, I2CInterface_Packet*
     }
     LL_I2C_ClearFlag_STOP(pIntDev->pHI2C);                                                          // Clear STOP flag
   }
-
   //--- Endianness result ---
   pPacketDesc->Config.Value &= ~I2C_ENDIAN_RESULT_Mask;
-  pPacketDesc->Config.Value |= I2C_ENDIAN_RESULT_SET(EndianTransform);                              // Indicate that the endian transform have been processed
+  pPacketDesc->Config.Value |= I2C_ENDIAN_RESULT_SET(EndianTransform);                              // Indicate that the endian transform have been processed. The sent bytes have been strided
+
+  const eERRORRESULT ErrorCRC = Interface_I2CpacketCRC(pPacketDesc);                              // The CRC is over the bytes as on the bus: sent strided, received before the endian switch
+  if (ErrorCRC != ERR_NONE) return ErrorCRC;
+  if ((DeviceWrite == false) && (EndianTransform != I2C_NO_ENDIAN_CHANGE))                        // Switch endianness of the whole received buffer in one pass, outside of the bus timing
+  {
+    const eERRORRESULT Error = EndianTransform_InPlace(pPacketDesc->pBuffer, pPacketDesc->BufferSize, (eEndianTransform)EndianTransform);
+    if (Error != ERR_NONE) return Error;
+  }
   return ERR_NONE;
 }
 #endif // #if defined(USE_FULL_LL_DRIVER) && defined(STM32G4xx_LL_I2C_H) // STM32cubeIDE with LL
 
 //-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C Interface CRC helper
+//********************************************************************************************************************
+#define I2C_CRC_CHUNK_SIZE  ( 48u ) //!< Size of the chunks of transformed bytes added to the CRC. Multiple of 2, 3 and 4
+
+//=============================================================================
+// [STATIC] Add bytes to the CRC in the order they are on the bus, the transmit data are sent with the endian transform
+//=============================================================================
+static eERRORRESULT __Interface_I2CaddToCRC(CRC_Context* pCRC, const uint8_t* pData, size_t size, eI2C_EndianTransform transform)
+{
+  if (transform == I2C_NO_ENDIAN_CHANGE) return CRC_Update(pCRC, pData, size);
+  uint8_t Chunk[I2C_CRC_CHUNK_SIZE];
+  while (size > 0)
+  {
+    const size_t ChunkSize = (size < I2C_CRC_CHUNK_SIZE ? size : I2C_CRC_CHUNK_SIZE);
+    eERRORRESULT Error = EndianTransform_Copy(&Chunk[0], pData, ChunkSize, (eEndianTransform)transform);
+    if (Error != ERR_NONE) return Error;
+    Error = CRC_Update(pCRC, &Chunk[0], ChunkSize);
+    if (Error != ERR_NONE) return Error;
+    pData += ChunkSize;
+    size  -= ChunkSize;
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Add the bytes of a packet to its CRC and check the received CRC
+//=============================================================================
+eERRORRESULT Interface_I2CpacketCRC(I2CInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pPacketDesc == NULL) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if (pPacketDesc->pCRC == NULL) return ERR_NONE;
+  eERRORRESULT Error;
+  if (pPacketDesc->Start && (pPacketDesc->Config.Bits.Addr10bits == 0))                 // The SMBus PEC starts with the address byte of each start or restart
+  {
+    const uint8_t AddrByte = (uint8_t)(pPacketDesc->ChipAddr & 0xFF);
+    Error = CRC_Update(pPacketDesc->pCRC, &AddrByte, 1);
+    if (Error != ERR_NONE) return Error;
+  }
+  if ((pPacketDesc->pBuffer == NULL) || (pPacketDesc->BufferSize == 0)) return ERR_NONE; // Device polling, nothing more to add
+  const bool DeviceWrite = ((pPacketDesc->ChipAddr & I2C_READ_ORMASK) == 0);
+  const eI2C_EndianTransform Transform = (DeviceWrite ? (eI2C_EndianTransform)I2C_ENDIAN_RESULT_GET(pPacketDesc->Config.Value) : I2C_NO_ENDIAN_CHANGE); // Sent bytes are in the transformed order if the interface did the transform. Received bytes are not transformed yet
+  if (I2C_IS_CHECK_CRC(pPacketDesc->Config.Value) == false) return __Interface_I2CaddToCRC(pPacketDesc->pCRC, pPacketDesc->pBuffer, pPacketDesc->BufferSize, Transform);
+  //--- The last bytes are the CRC to check ---
+  const size_t CRCsize = CRC_GetSize(pPacketDesc->pCRC->Type);
+  if (pPacketDesc->BufferSize < CRCsize) return ERR__I2C_PARAMETER_ERROR;
+  Error = __Interface_I2CaddToCRC(pPacketDesc->pCRC, pPacketDesc->pBuffer, pPacketDesc->BufferSize - CRCsize, Transform);
+  if (Error != ERR_NONE) return Error;
+  return CRC_CheckReceived(pPacketDesc->pCRC, &pPacketDesc->pBuffer[pPacketDesc->BufferSize - CRCsize]);
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C Interface endianness helper
+//********************************************************************************************************************
+//=============================================================================
+// Apply the endian transform not done by the interface on a packet buffer
+//=============================================================================
+eERRORRESULT Interface_I2CendianTransform(I2CInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pPacketDesc == NULL) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  const eI2C_EndianTransform EndianTransform = (eI2C_EndianTransform)I2C_ENDIAN_TRANSFORM_GET(pPacketDesc->Config.Value);
+  const eI2C_EndianTransform EndianResult    = (eI2C_EndianTransform)I2C_ENDIAN_RESULT_GET(pPacketDesc->Config.Value);
+  if (EndianResult == EndianTransform) return ERR_NONE;                                // Already done by the interface or nothing to do
+  eERRORRESULT Error = EndianTransform_InPlace(pPacketDesc->pBuffer, pPacketDesc->BufferSize, (eEndianTransform)EndianTransform);
+  if (Error != ERR_NONE) return Error;
+  pPacketDesc->Config.Value &= ~I2C_ENDIAN_RESULT_Mask;
+  pPacketDesc->Config.Value |= I2C_ENDIAN_RESULT_SET(EndianTransform);                 // Indicate that the endian transform have been processed
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C Interface batch transfer implementation
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Release the bus after a failure in a sequence
+//=============================================================================
+static void __Interface_I2CreleaseBus(I2C_Interface *pIntDev, const I2CInterface_Packet* const pFailedPacket)
+{
+  I2CInterface_Packet ReleasePacket = *pFailedPacket;
+  ReleasePacket.Config.Value &= ~(I2C_USE_NON_BLOCKING | I2C_ENDIAN_TRANSFORM_Mask | I2C_ENDIAN_RESULT_Mask | I2C_CHECK_CRC);
+  ReleasePacket.ChipAddr  &= I2C_WRITE_ANDMASK;
+  ReleasePacket.Start      = true;
+  ReleasePacket.pBuffer    = NULL;                                                     // Zero-length packet: device polling, ends with a STOP
+  ReleasePacket.BufferSize = 0;
+  ReleasePacket.Stop       = true;
+  ReleasePacket.pCRC       = NULL;
+  (void)pIntDev->fnI2C_Transfer(pIntDev, &ReleasePacket);                              // A NACK here is expected and still ends with a STOP
+}
+
+
+//=============================================================================
+// Function for I2C batch transfer
+//=============================================================================
+eERRORRESULT Interface_I2CtransferBatch(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketsDesc, size_t count, eERRORRESULT* const pPacketsResult)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pPacketsDesc == NULL)) return ERR__I2C_PARAMETER_ERROR;
+  if (pIntDev->fnI2C_Transfer == NULL) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if (pIntDev->fnI2C_TransferBatch != NULL)                                            // Native batch support?
+    return pIntDev->fnI2C_TransferBatch(pIntDev, pPacketsDesc, count, pPacketsResult); // Give the whole list to the interface
+  eERRORRESULT FirstError = ERR_NONE;
+  bool SequenceFailed = false;
+
+  //--- Transfer packet per packet ---
+  for (size_t zIdx = 0; zIdx < count; ++zIdx)
+  {
+    I2CInterface_Packet* const pPacket = &pPacketsDesc[zIdx];
+    eERRORRESULT Error = ERR__CANCELED;
+    if (SequenceFailed && pPacket->Start && (zIdx > 0) && pPacketsDesc[zIdx - 1].Stop) SequenceFailed = false; // New sequence after a failed one? Process it
+    if (SequenceFailed == false)
+    {
+      Error = pIntDev->fnI2C_Transfer(pIntDev, pPacket);                               // Transfer the packet
+      if (Error != ERR_NONE)
+      {
+        if (FirstError == ERR_NONE) FirstError = Error;
+        SequenceFailed = (pPacket->Stop == false);                                     // The remaining packets of this sequence will be canceled
+        if (SequenceFailed) __Interface_I2CreleaseBus(pIntDev, pPacket);               // Their Stop will not be sent, release the bus now
+      }
+    }
+    if (pPacketsResult != NULL) pPacketsResult[zIdx] = Error;
+  }
+  return FirstError;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C Interface asynchronous transfer implementation
+//********************************************************************************************************************
+//=============================================================================
+// Initialize an I2C asynchronous transaction
+//=============================================================================
+void Interface_I2CinitTransaction(I2CInterface_Transaction* const pTransaction, I2CInterface_Packet* const pPacketDesc, I2CTransactionComplete_Func fnComplete, void* pContext)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pTransaction == NULL) return;
+#endif
+  pTransaction->pPacketDesc = pPacketDesc;
+  pTransaction->fnComplete  = fnComplete;
+  pTransaction->pContext    = pContext;
+  pTransaction->Status      = I2C_TRANSACTION_IDLE;
+  pTransaction->Result      = ERR_NONE;
+  pTransaction->pNext       = NULL;
+}
+
+
+//=============================================================================
+// Function for I2C asynchronous transfer
+//=============================================================================
+eERRORRESULT Interface_I2CtransferAsync(I2C_Interface *pIntDev, I2CInterface_Transaction* const pTransaction)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pTransaction == NULL)) return ERR__I2C_PARAMETER_ERROR;
+  if ((pTransaction->pPacketDesc == NULL) || (pIntDev->fnI2C_Transfer == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  if (pTransaction->Status == I2C_TRANSACTION_PENDING) return ERR__BUSY;                 // A pending transaction can't be submitted again
+  I2CInterface_Packet* const pPacket = &pTransaction->Packet;                           // The interface works on a copy, the packet of the driver keeps its configuration
+  *pPacket = *pTransaction->pPacketDesc;
+  eERRORRESULT Error;
+
+  //--- Asynchronous transfer ---
+  pTransaction->pNext  = NULL;
+  pTransaction->Result = ERR__BUSY;
+  pTransaction->Status = I2C_TRANSACTION_PENDING;
+  if (pIntDev->fnI2C_TransferAsync != NULL)
+  {
+    pPacket->Config.Value |= I2C_USE_NON_BLOCKING;                                       // Non-blocking packets go through the asynchronous path
+    Error = pIntDev->fnI2C_TransferAsync(pIntDev, pTransaction);
+    if (Error != ERR_NONE) pTransaction->Status = I2C_TRANSACTION_IDLE;                  // Transaction not accepted
+    return Error;
+  }
+
+  //--- No asynchronous support, transfer now and complete the transaction ---
+  pPacket->Config.Value &= ~I2C_USE_NON_BLOCKING;                                        // The interface will do a blocking transfer
+  Error = pIntDev->fnI2C_Transfer(pIntDev, pPacket);
+  Interface_I2CcompleteTransaction(pTransaction, Error);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Complete an I2C asynchronous transaction
+//=============================================================================
+void Interface_I2CcompleteTransaction(I2CInterface_Transaction* const pTransaction, eERRORRESULT result)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pTransaction == NULL) return;
+#endif
+  pTransaction->Result = result;
+  I2CInterface_Packet* const pPacketDesc = pTransaction->pPacketDesc;
+  pPacketDesc->Config.Value &= ~I2C_ENDIAN_RESULT_Mask;
+  pPacketDesc->Config.Value |= (pTransaction->Packet.Config.Value & I2C_ENDIAN_RESULT_Mask); // Give the endian result of the copy to the driver
+#if defined(__GNUC__)
+  __sync_synchronize();                                                                  // The result shall be visible before the completion flag
+#endif
+  pTransaction->Status = I2C_TRANSACTION_COMPLETE;
+  if (pTransaction->fnComplete != NULL) pTransaction->fnComplete(pTransaction);
+}
+
+
+//=============================================================================
+// Check if an I2C asynchronous transaction is complete
+//=============================================================================
+bool Interface_I2CisTransactionComplete(I2CInterface_Transaction* const pTransaction, eERRORRESULT* const pResult)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pTransaction == NULL) return false;
+#endif
+  if (pTransaction->Status != I2C_TRANSACTION_COMPLETE) return false;
+#if defined(__GNUC__)
+  __sync_synchronize();                                                                  // Read the result after the completion flag
+#endif
+  if (pResult != NULL) *pResult = pTransaction->Result;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
 #ifdef __cplusplus
 }
 #endif
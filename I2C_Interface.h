@@ -1,8 +1,8 @@
 /*!*****************************************************************************
  * @file    I2C_Interface.h
  * @author  Fabien 'Emandhal' MAILLY
- * @version 1.1.1
- * @date    18/11/2023
+ * @version 1.6.0
+ * @date    16/10/2026
  * @brief   I2C interface for drivers
  * @details This I2C interface definitions for all the https://github.com/Emandhal
  * drivers and developments
@@ -31,6 +31,11 @@
  *****************************************************************************/
 
 /* Revision history:
+ * 1.6.0    Add the asynchronous transfer of the STM32cubeIDE HAL interface
+ * 1.5.0    Add CRC computation and check of the packets
+ * 1.4.0    Add endian transform helper
+ * 1.3.0    Add asynchronous transfer with completion
+ * 1.2.0    Add batch transfer
  * 1.1.1    Add STM32cubeIDE
  * 1.1.0    Add Arduino
  * 1.0.0    Release version
@@ -46,6 +51,7 @@
 #include <stdlib.h>
 //-----------------------------------------------------------------------------
 #include "ErrorsDef.h"
+#include "CRC.h"
 //-----------------------------------------------------------------------------
 #ifdef __cplusplus
 #  ifdef ARDUINO
@@ -89,7 +95,8 @@ typedef union I2C_Conf
     uint32_t EndianResult   :  3; //!<  4- 6 - If the transfer changes the endianness, the peripheral that do the transfer will say it here
     uint32_t EndianTransform:  3; //!<  7- 9 - The driver that asks for the transfer needs an endian change from little to big-endian or big to little-endian
     uint32_t TransactionInc :  6; //!< 10-15 - Current transaction number (managed by the I2C+DMA driver). When a new DMA transaction is initiate, set this value to '0', the I2C+DMA driver will return an incremental number. This is for knowing that the transaction has been accepted or the bus is busy with another transaction
-    uint32_t                : 15; //!< 16-30
+    uint32_t CheckCRC       :  1; //!< 16    - Check the CRC of the packet (used with I2CInterface_Packet.pCRC): '1' = the last bytes of the packet are the CRC to check ; '0' = all the bytes are added to the CRC
+    uint32_t                : 14; //!< 17-30
     uint32_t Addr10bits     :  1; //!< 31    - Chip address length: '1' = 10-bits address ; '0' = 8-bits address
   } Bits;
 } I2C_Conf;
@@ -140,6 +147,9 @@ typedef enum
 #define I2C_TRANSACTION_NUMBER_SET(value)  (((uint16_t)(value) & I2C_TRANSACTION_NUMBER_Mask) << I2C_TRANSACTION_NUMBER_Pos) //!< Set transaction number
 #define I2C_TRANSACTION_NUMBER_GET(value)  (((uint16_t)(value) >> I2C_TRANSACTION_NUMBER_Pos) & I2C_TRANSACTION_NUMBER_Mask) //!< Get transaction number
 
+#define I2C_CHECK_CRC                      (0x1u << 16)                      //!< The last bytes of the packet are the CRC to check
+#define I2C_IS_CHECK_CRC(value)            ( ((value) & I2C_CHECK_CRC) > 0 ) //!< Is the value has the #I2C_CHECK_CRC bit defined?
+
 #define I2C_USE_10BITS_ADDRESS             (0x1u << 31) //!< Use a 10-bits chip address
 #define I2C_USE_8BITS_ADDRESS              (0x0u << 31) //!< Use a 8-bits chip address
 #define I2C_IS_10BITS_ADDRESS(chipAddr)    ( ((chipAddr) & I2C_USE_10BITS_ADDRESS) > 0 ) //!< Is a 10-bits chip address?
@@ -155,8 +165,38 @@ typedef struct
   uint8_t* pBuffer;   //! In case of write, this is the bytes to send to slave chip, in case of read, this is where data read will be stored
   size_t BufferSize;  //! Buffer size in bytes
   bool Stop;          //! Indicate if the transfer needs a stop after the last byte sent by this function call
+  CRC_Context* pCRC;  //! If not NULL, the address byte (with a start) and the bytes of the packet are added to this CRC by the interface. See #I2C_CHECK_CRC
 } I2CInterface_Packet;
 
+//! I2C transaction status enum
+typedef enum
+{
+  I2C_TRANSACTION_IDLE     = 0x0u, //!< The transaction is not submitted
+  I2C_TRANSACTION_PENDING  = 0x1u, //!< The transaction is submitted and is not complete yet
+  I2C_TRANSACTION_COMPLETE = 0x2u, //!< The transaction is complete, the result is available
+} eI2C_TransactionStatus;
+
+typedef struct I2CInterface_Transaction I2CInterface_Transaction; //! Typedef of I2CInterface_Transaction object structure
+
+/*! @brief Function called when an I2C transaction is complete
+ *
+ * @warning This function can be called in an interrupt context
+ * @param[in] *pTransaction Is the transaction that just completed. Its Result member contains the transfer result
+ */
+typedef void (*I2CTransactionComplete_Func)(I2CInterface_Transaction* const pTransaction);
+
+//! @brief Description of an asynchronous I2C transaction. This object is the handle of the transaction and shall stay valid until completion
+struct I2CInterface_Transaction
+{
+  I2CInterface_Packet* pPacketDesc;       //!< Packet to transfer. It shall stay valid until completion
+  I2CTransactionComplete_Func fnComplete; //!< This function will be called when the transaction is complete. Can be NULL if the completion flag is used
+  void* pContext;                         //!< Driver context, not used by the interface
+  volatile eI2C_TransactionStatus Status; //!< Completion flag of the transaction. Shall be initialized to #I2C_TRANSACTION_IDLE before the first submission, see Interface_I2CinitTransaction()
+  volatile eERRORRESULT Result;           //!< Result of the transfer. Only valid when Status is #I2C_TRANSACTION_COMPLETE
+  I2CInterface_Transaction* pNext;        //!< Used by the interface to queue pending transactions. Do not modify while pending
+  I2CInterface_Packet Packet;             //!< Copy of *pPacketDesc given to the interface with the non-blocking flag set. Managed by the interface
+};
+
 //-----------------------------------------------------------------------------
 
 
@@ -177,18 +217,21 @@ typedef struct
     I2C_MEMBER(pBuffer     ) NULL,                                                                                        \
     I2C_MEMBER(BufferSize  ) 0,                                                                                           \
     I2C_MEMBER(Stop        ) true,                                                                                        \
+    I2C_MEMBER(pCRC        ) NULL,                                                                                        \
   }
 
 //! Prepare I2C packet description to check the DMA status with a 8-bits device address
+//! @deprecated Kept for compatibility with the transaction number polling, use Interface_I2CtransferAsync() instead
 #define I2C_INTERFACE8_CHECK_DMA_DESC(chipAddr,transactionNumber)                                                            \
   {                                                                                                                          \
     I2C_MEMBER(Config.Value) I2C_USE_NON_BLOCKING | I2C_USE_8BITS_ADDRESS | I2C_ENDIAN_TRANSFORM_SET(I2C_NO_ENDIAN_CHANGE)   \
-                           | I2C_TRANSFER_TYPE_SET(I2C_SIMPLE_TRANSFER) | I2C_TRANSACTION_NUMBER_SET(CurrTransactionNumber), \
+                           | I2C_TRANSFER_TYPE_SET(I2C_SIMPLE_TRANSFER) | I2C_TRANSACTION_NUMBER_SET(transactionNumber),     \
     I2C_MEMBER(ChipAddr    ) (chipAddr) | I2C_READ_ORMASK,                                                                   \
     I2C_MEMBER(Start       ) true,                                                                                           \
     I2C_MEMBER(pBuffer     ) NULL,                                                                                           \
     I2C_MEMBER(BufferSize  ) 0,                                                                                              \
     I2C_MEMBER(Stop        ) true,                                                                                           \
+    I2C_MEMBER(pCRC        ) NULL,                                                                                           \
   }
 
 //! Prepare I2C packet description to transmit bytes with a 8-bits device address
@@ -201,6 +244,7 @@ typedef struct
     I2C_MEMBER(pBuffer     ) (uint8_t*)(txData),                                                                   \
     I2C_MEMBER(BufferSize  ) (size),                                                                               \
     I2C_MEMBER(Stop        ) (stop),                                                                               \
+    I2C_MEMBER(pCRC        ) NULL,                                                                                 \
   }
 
 //! Prepare I2C packet description to receive bytes with a 8-bits device address
@@ -213,6 +257,7 @@ typedef struct
     I2C_MEMBER(pBuffer     ) (uint8_t*)(rxData),                                                                   \
     I2C_MEMBER(BufferSize  ) (size),                                                                               \
     I2C_MEMBER(Stop        ) (stop),                                                                               \
+    I2C_MEMBER(pCRC        ) NULL,                                                                                 \
   }
 
 //! Prepare I2C packet description to transmit bytes with DMA and a 8-bits device address
@@ -225,6 +270,7 @@ typedef struct
     I2C_MEMBER(pBuffer     ) (uint8_t*)(txData),                                                                   \
     I2C_MEMBER(BufferSize  ) (size),                                                                               \
     I2C_MEMBER(Stop        ) (stop),                                                                               \
+    I2C_MEMBER(pCRC        ) NULL,                                                                                 \
   }
 
 //! Prepare I2C packet description to receive bytes with DMA and a 8-bits device address
@@ -237,6 +283,7 @@ typedef struct
     I2C_MEMBER(pBuffer     ) (uint8_t*)(rxData),                                                                   \
     I2C_MEMBER(BufferSize  ) (size),                                                                               \
     I2C_MEMBER(Stop        ) (stop),                                                                               \
+    I2C_MEMBER(pCRC        ) NULL,                                                                                 \
   }
 
 //-----------------------------------------------------------------------------
@@ -276,41 +323,87 @@ typedef eERRORRESULT (*I2CInit_Func)(I2C_Interface *pIntDev, const uint32_t sclF
  */
 typedef eERRORRESULT (*I2CTransferPacket_Func)(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc);
 
+
+/*! @brief Interface packets batch function for I2C peripheral transfer
+ *
+ * This function will be called when the driver needs to transfer a list of packets over the I2C communication in one call
+ * Packets are processed in order. A packet with Stop = 'false' followed by a packet with Start = 'true' is a restart, the bus is not released between them.
+ * If a packet fails, the following packets of the same sequence (until the next packet with Stop = 'true') are not transferred and their status is set to ERR__CANCELED. The next sequences are still processed
+ * After a failure in a sequence, a zero-length packet with Start and Stop (device polling of the failed packet address) is transferred to release the bus. Its result is not reported, the canceled packets of the sequence (including the one with Stop = 'true') keep ERR__CANCELED
+ * The bus shall not stay held after a failure: the interface issues the STOP of the failed sequence before processing the next one
+ * @warning A I2CInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pPacketsDesc Is the packets description array to transfer through I2C
+ * @param[in] count Is the count of packets in the array
+ * @param[out] *pPacketsResult Is where the status of each packet will be stored (count items). Can be NULL if not needed
+ * @return Returns the first error that occurred or ERR_NONE if all packets succeeded
+ */
+typedef eERRORRESULT (*I2CTransferBatch_Func)(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketsDesc, size_t count, eERRORRESULT* const pPacketsResult);
+
+
+/*! @brief Interface function for I2C peripheral asynchronous transfer
+ *
+ * This function will be called when the driver needs to transfer a packet without waiting for the end of the transfer
+ * The interface queues the transaction and returns immediately. When the transfer is done, the interface shall call Interface_I2CcompleteTransaction()
+ * There is no limit to the count of pending transactions other than the interface resources, transactions are transferred in submission order
+ * @warning A I2CInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pTransaction Is the transaction to queue. Its status is already set to #I2C_TRANSACTION_PENDING. The packet to transfer is I2CInterface_Transaction.Packet, a copy of the driver packet with the non-blocking flag set
+ * @return Returns an #eERRORRESULT value enum. Any error means that the transaction has not been accepted
+ */
+typedef eERRORRESULT (*I2CTransferAsync_Func)(I2C_Interface *pIntDev, I2CInterface_Transaction* const pTransaction);
+
 //-----------------------------------------------------------------------------
 
 #ifdef ARDUINO
 //! @brief Arduino I2C interface container structure
 struct I2C_Interface
 {
-  TwoWire& _I2Cclass;                    //!< Arduino I2C class
-  I2CInit_Func fnI2C_Init;               //!< This function will be called at driver initialization to configure the interface driver
-  I2CTransferPacket_Func fnI2C_Transfer; //!< This function will be called when the driver needs to transfer data over the I2C communication with the device
+  TwoWire& _I2Cclass;                        //!< Arduino I2C class
+  I2CInit_Func fnI2C_Init;                   //!< This function will be called at driver initialization to configure the interface driver
+  I2CTransferPacket_Func fnI2C_Transfer;     //!< This function will be called when the driver needs to transfer data over the I2C communication with the device
+  I2CTransferBatch_Func fnI2C_TransferBatch; //!< This function will be called when the driver needs to transfer a list of packets. Set to NULL if the interface has no native batch support
+  I2CTransferAsync_Func fnI2C_TransferAsync; //!< This function will be called when the driver needs an asynchronous transfer. Set to NULL if the interface has no asynchronous support
 };
 
 #elif defined(USE_HAL_DRIVER) || defined(USE_FULL_LL_DRIVER) // STM32cubeIDE
+#  if defined(STM32G4xx_HAL_I2C_H) && !defined(I2C_INTERFACE_HAL_ASYNC_COUNT)
+#    define I2C_INTERFACE_HAL_ASYNC_COUNT  2 //!< Count of I2C peripherals that can use Interface_I2CtransferAsyncHAL()
+#  endif
+
 //! @brief STM32 LL/HAL I2C interface container structure
 struct I2C_Interface
 {
 #ifdef STM32G4xx_HAL_I2C_H
-  I2C_HandleTypeDef* pHI2C;              //!< Pointer to I2C handle Structure definition
+  I2C_HandleTypeDef* pHI2C;                  //!< Pointer to I2C handle Structure definition
 #endif
 #ifdef STM32G4xx_LL_I2C_H
-  I2C_TypeDef* pHI2C;                    //!< Pointer to I2C handle Structure definition
+  I2C_TypeDef* pHI2C;                        //!< Pointer to I2C handle Structure definition
+#endif
+  I2CInit_Func fnI2C_Init;                   //!< This function will be called at driver initialization to configure the interface driver
+  I2CTransferPacket_Func fnI2C_Transfer;     //!< This function will be called when the driver needs to transfer data over the I2C communication with the device
+  uint32_t I2Ctimeout;                       //!< I2C timeout
+  I2CTransferBatch_Func fnI2C_TransferBatch; //!< This function will be called when the driver needs to transfer a list of packets. Set to NULL if the interface has no native batch support
+  I2CTransferAsync_Func fnI2C_TransferAsync; //!< This function will be called when the driver needs an asynchronous transfer. Set to NULL if the interface has no asynchronous support. With HAL, set to Interface_I2CtransferAsyncHAL()
+#ifdef STM32G4xx_HAL_I2C_H
+  I2CInterface_Transaction* volatile _pAsyncHead;     //!< First pending asynchronous transaction, the one in transfer. Managed by the interface
+  I2CInterface_Transaction* _pAsyncTail;              //!< Last pending asynchronous transaction. Managed by the interface
+  I2CInterface_Transaction _NonBlockingTransaction;   //!< Transaction of the non-blocking packets given to I2C_Interface.fnI2C_Transfer. Managed by the interface
+  I2CInterface_Packet _NonBlockingPacket;             //!< Copy of the non-blocking packet in transfer, the packet of the driver may not stay valid. Managed by the interface
 #endif
-  I2CInit_Func fnI2C_Init;               //!< This function will be called at driver initialization to configure the interface driver
-  I2CTransferPacket_Func fnI2C_Transfer; //!< This function will be called when the driver needs to transfer data over the I2C communication with the device
-  uint32_t I2Ctimeout;                   //!< I2C timeout
 };
 
 #else
 //! @brief I2C interface container structure
 struct I2C_Interface
 {
-  void *InterfaceDevice;                 //!< This is the pointer that will be in the first parameter of all interface call functions
-  uint32_t UniqueID;                     //!< This is a protection for the #InterfaceDevice pointer. This value will be check when using the struct I2C_Interface in the driver which use the generic I2C interface
-  I2CInit_Func fnI2C_Init;               //!< This function will be called at driver initialization to configure the interface driver
-  I2CTransferPacket_Func fnI2C_Transfer; //!< This function will be called when the driver needs to transfer data over the I2C communication with the device
-  uint8_t Channel;                       //!< I2C channel of the interface device
+  void *InterfaceDevice;                     //!< This is the pointer that will be in the first parameter of all interface call functions
+  uint32_t UniqueID;                         //!< This is a protection for the #InterfaceDevice pointer. This value will be check when using the struct I2C_Interface in the driver which use the generic I2C interface
+  I2CInit_Func fnI2C_Init;                   //!< This function will be called at driver initialization to configure the interface driver
+  I2CTransferPacket_Func fnI2C_Transfer;     //!< This function will be called when the driver needs to transfer data over the I2C communication with the device
+  uint8_t Channel;                           //!< I2C channel of the interface device
+  I2CTransferBatch_Func fnI2C_TransferBatch; //!< This function will be called when the driver needs to transfer a list of packets. Set to NULL if the interface has no native batch support
+  I2CTransferAsync_Func fnI2C_TransferAsync; //!< This function will be called when the driver needs an asynchronous transfer. Set to NULL if the interface has no asynchronous support
 };
 #endif //#ifdef ARDUINO && USE_HAL_DRIVER
 
@@ -346,6 +439,115 @@ eERRORRESULT Interface_I2Cinit(I2C_Interface* pIntDev, const uint32_t sclFreq);
  */
 eERRORRESULT Interface_I2Ctransfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc);
 
+#if defined(USE_HAL_DRIVER) && defined(STM32G4xx_HAL_I2C_H)
+/*! @brief Function for I2C asynchronous transfer with STM32cubeIDE and HAL driver
+ *
+ * Queue the transaction and start its interrupt transfer if the bus is idle, then return. Set it to I2C_Interface.fnI2C_TransferAsync
+ * The transaction is completed (with the CRC of the packet) by Interface_I2CtransferCompleteHAL() or Interface_I2CtransferErrorHAL() called from the HAL callbacks, which start the next pending transaction
+ * A device polling packet (no data) is done at once if no transaction is pending, else it is rejected with #ERR__BUSY
+ * With a non-blocking packet (I2C_Conf.Bits.IsNonBlocking = 1), Interface_I2Ctransfer() also goes through this function with the transaction of the interface: it returns #ERR__BUSY while the previous non-blocking packet is in transfer, and a packet without data returns the result of the previous non-blocking packet (see #I2C_INTERFACE8_CHECK_DMA_DESC)
+ * @warning A blocking transfer waits for the end of the pending transactions, do not call it from a completion function
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pTransaction Is the transaction to queue, see I2CTransferAsync_Func
+ * @return Returns an #eERRORRESULT value enum. #ERR__OUT_OF_MEMORY if more than #I2C_INTERFACE_HAL_ASYNC_COUNT I2C peripherals use this function
+ */
+eERRORRESULT Interface_I2CtransferAsyncHAL(I2C_Interface *pIntDev, I2CInterface_Transaction* const pTransaction);
+
+/*! @brief End of an I2C asynchronous transfer with STM32cubeIDE and HAL driver
+ *
+ * Call it from HAL_I2C_MasterTxCpltCallback() and HAL_I2C_MasterRxCpltCallback(). With USE_HAL_I2C_REGISTER_CALLBACKS set to 1, the interface registers it on the I2C handle
+ * @note This function is called in an interrupt context
+ * @param[in] *hi2c Is the I2C handle of the transfer that ended
+ */
+void Interface_I2CtransferCompleteHAL(I2C_HandleTypeDef *hi2c);
+
+/*! @brief Error of an I2C asynchronous transfer with STM32cubeIDE and HAL driver
+ *
+ * Call it from HAL_I2C_ErrorCallback(). With USE_HAL_I2C_REGISTER_CALLBACKS set to 1, the interface registers it on the I2C handle
+ * @note This function is called in an interrupt context
+ * @param[in] *hi2c Is the I2C handle of the transfer that failed
+ */
+void Interface_I2CtransferErrorHAL(I2C_HandleTypeDef *hi2c);
+#endif
+
+/*! @brief Add the bytes of a packet to its CRC and check the received CRC
+ *
+ * This function will be called by the interface after a transfer, before the endian transform, when I2CInterface_Packet.pCRC is not NULL. An interface that completes asynchronously calls it at completion
+ * With a start of a 8-bits address (I2C_Conf.Bits.Addr10bits = 0), the address byte (with the R/W bit) is added first, as needed by the SMBus Packet Error Code. Then the bytes of the buffer are added to the CRC in the order they are on the bus: for a write, in the transformed order if the endian result says the interface switched them. With #I2C_CHECK_CRC, the last CRC_GetSize() bytes are not added but checked against the CRC
+ * @warning The endian result of a write shall be set before the call. For a read, this function shall be called before the endian transform of the received bytes
+ * @param[in] *pPacketDesc Is the packet description that has been transferred through I2C
+ * @return Returns an #eERRORRESULT value enum, #ERR__CRC_ERROR if the CRC check failed
+ */
+eERRORRESULT Interface_I2CpacketCRC(I2CInterface_Packet* const pPacketDesc);
+
+/*! @brief Apply the endian transform not done by the interface on a packet buffer
+ *
+ * This function will be called by the driver after a transfer when the interface has not performed the requested endian transform (endian result different from the endian transform)
+ * The data blocks of the packet buffer are switched in place with the shared endian transform engine and the endian result is updated
+ * @param[in,out] *pPacketDesc Is the packet description that has been transferred through I2C
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT Interface_I2CendianTransform(I2CInterface_Packet* const pPacketDesc);
+
+/*! @brief Function interface for I2C batch transfer
+ *
+ * This function will be called when the driver needs to transfer a list of packets over the I2C communication with the device
+ * If the interface has a native batch function (I2C_Interface.fnI2C_TransferBatch not NULL), the whole list is given to it. Else each packet is transferred with I2C_Interface.fnI2C_Transfer
+ * Packets are processed in order. A packet with Stop = 'false' followed by a packet with Start = 'true' is a restart, the bus is not released between them.
+ * If a packet fails, the following packets of the same sequence (until the next packet with Stop = 'true') are not transferred and their status is set to ERR__CANCELED. The next sequences are still processed
+ * After a failure in a sequence, a zero-length packet with Start and Stop (device polling of the failed packet address) is transferred to release the bus. Its result is not reported, the canceled packets of the sequence (including the one with Stop = 'true') keep ERR__CANCELED
+ * @warning A I2CInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pPacketsDesc Is the packets description array to transfer through I2C
+ * @param[in] count Is the count of packets in the array
+ * @param[out] *pPacketsResult Is where the status of each packet will be stored (count items). Can be NULL if not needed
+ * @return Returns the first error that occurred or ERR_NONE if all packets succeeded
+ */
+eERRORRESULT Interface_I2CtransferBatch(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketsDesc, size_t count, eERRORRESULT* const pPacketsResult);
+
+
+/*! @brief Initialize an I2C asynchronous transaction
+ *
+ * This function shall be called once before the first submission of a transaction, it sets the transaction as idle
+ * @param[out] *pTransaction Is the transaction to initialize
+ * @param[in] *pPacketDesc Is the packet to transfer. It shall stay valid until completion
+ * @param[in] fnComplete Is the function that will be called when the transaction is complete. Can be NULL if the completion flag is used
+ * @param[in] *pContext Is the driver context, not used by the interface
+ */
+void Interface_I2CinitTransaction(I2CInterface_Transaction* const pTransaction, I2CInterface_Packet* const pPacketDesc, I2CTransactionComplete_Func fnComplete, void* pContext);
+
+/*! @brief Function interface for I2C asynchronous transfer
+ *
+ * This function will be called when the driver needs to transfer a packet without waiting for the end of the transfer
+ * The packet of the transaction is copied into I2CInterface_Transaction.Packet, the copy is set as non-blocking and the transaction is given to I2C_Interface.fnI2C_TransferAsync. The packet of the driver is not modified, except its endian result at completion
+ * @note Only the STM32cubeIDE HAL interface has an asynchronous support (Interface_I2CtransferAsyncHAL()). With the LL, Arduino, Linux and simulated interfaces (fnI2C_TransferAsync set to NULL), this function is a synchronous wrapper: the transfer is done and the transaction completed before the function returns
+ * If the interface has no asynchronous support (I2C_Interface.fnI2C_TransferAsync is NULL), the packet is transferred with I2C_Interface.fnI2C_Transfer and the transaction is completed before returning
+ * The completion is signaled by the transaction status (see Interface_I2CisTransactionComplete()) and by the call of I2CInterface_Transaction.fnComplete if not NULL
+ * @warning A I2CInit_Func() must be called before using this function
+ * @warning The transaction status shall be initialized before the first submission (with Interface_I2CinitTransaction()), else a random status equal to #I2C_TRANSACTION_PENDING is rejected with #ERR__BUSY
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pTransaction Is the transaction to transfer. It is the handle of the transaction and shall stay valid until completion
+ * @return Returns an #eERRORRESULT value enum. ERR_NONE means that the transaction has been accepted, the transfer result is in the transaction
+ */
+eERRORRESULT Interface_I2CtransferAsync(I2C_Interface *pIntDev, I2CInterface_Transaction* const pTransaction);
+
+/*! @brief Complete an I2C asynchronous transaction
+ *
+ * This function shall be called by the interface when the transfer of a transaction is done
+ * @note This function can be called in an interrupt context
+ * @param[in] *pTransaction Is the transaction that is complete
+ * @param[in] result Is the result of the transfer
+ */
+void Interface_I2CcompleteTransaction(I2CInterface_Transaction* const pTransaction, eERRORRESULT result);
+
+/*! @brief Check if an I2C asynchronous transaction is complete
+ *
+ * @param[in] *pTransaction Is the transaction to check
+ * @param[out] *pResult Is where the result of the transfer will be stored if the transaction is complete. Can be NULL if not needed
+ * @return Returns 'true' if the transaction is complete else 'false'
+ */
+bool Interface_I2CisTransactionComplete(I2CInterface_Transaction* const pTransaction, eERRORRESULT* const pResult);
+
 //-----------------------------------------------------------------------------
 #ifdef __cplusplus
 }
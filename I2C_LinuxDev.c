@@ -0,0 +1,253 @@
+/*!*****************************************************************************
+ * @file    I2C_LinuxDev.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.1.0
+ * @date    16/10/2026
+ * @brief   Linux i2c-dev backend of the I2C interface
+ * @details This backend plugs the /dev/i2c-N character devices into the generic
+ *          I2C_Interface of all the https://github.com/Emandhal drivers and
+ *          developments. Only available on Linux with the generic I2C_Interface
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.1.0    Compute the CRC of the packets
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "I2C_LinuxDev.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c.h>
+#include <linux/i2c-dev.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux i2c-dev backend internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Perform an ioctl with the shim or the C library
+//=============================================================================
+static int __I2C_LinuxDev_Ioctl(I2C_LinuxDev* pDev, unsigned long request, void* pArg)
+{
+  if (pDev->fnIoctl != NULL) return pDev->fnIoctl(pDev->Fd, request, pArg);
+  return ioctl(pDev->Fd, request, pArg);
+}
+
+
+//=============================================================================
+// [STATIC] Convert an errno of an I2C_RDWR ioctl to an #eERRORRESULT
+//=============================================================================
+static eERRORRESULT __I2C_LinuxDev_Errno(int error)
+{
+  switch (error)
+  {
+    case ENXIO     : return ERR__I2C_NACK_ADDR;                                   // No device acknowledged the chip address
+    case EREMOTEIO : return ERR__I2C_NACK;
+    case ETIMEDOUT : return ERR__I2C_TIMEOUT;
+    case EAGAIN    : return ERR__I2C_OTHER_BUSY;                                  // Arbitration lost
+    case EBUSY     : return ERR__I2C_BUSY;
+    case EOPNOTSUPP: return ERR__NOT_SUPPORTED;
+    default: break;
+  }
+  return ERR__I2C_COMM_ERROR;
+}
+
+
+//=============================================================================
+// [STATIC] Transfer all the packets collected in one I2C_RDWR ioctl
+//=============================================================================
+static eERRORRESULT __I2C_LinuxDev_Flush(I2C_LinuxDev* pDev)
+{
+  struct i2c_msg Msgs[I2C_LINUXDEV_MAX_MESSAGES];
+  uint8_t* pMerged[I2C_LINUXDEV_MAX_MESSAGES];                                   // Where is the data of each packet in the merge buffer. NULL if the packet buffer is used directly
+  const bool NoStart = ((pDev->Functionality & I2C_FUNC_NOSTART) > 0);
+  size_t MsgCount = 0, MergeUsed = 0, MsgFirstPacket = 0;
+  const size_t PacketCount = pDev->PacketCount;
+  pDev->PacketCount = 0;
+
+  //--- Build the messages ---
+  for (size_t zPacket = 0; zPacket < PacketCount; ++zPacket)
+  {
+    I2CInterface_Packet* pPacket = &pDev->Packets[zPacket];
+    const bool Addr10bits = (pPacket->Config.Bits.Addr10bits > 0);
+    const bool DeviceRead = ((pPacket->ChipAddr & I2C_READ_ORMASK) > 0);
+    if (Addr10bits && ((pDev->Functionality & I2C_FUNC_10BIT_ADDR) == 0)) return ERR__NOT_SUPPORTED;
+    const bool Start = (pPacket->Start || (zPacket == 0));                        // After a read transferred without stop, the continuation begins with a start
+    pMerged[zPacket] = NULL;
+    if (Start || NoStart)
+    { // New message
+      struct i2c_msg* pMsg = &Msgs[MsgCount++];
+      pMsg->addr  = (uint16_t)((pPacket->ChipAddr & (Addr10bits ? I2C_ONLY_ADDR10_Mask : I2C_ONLY_ADDR8_Mask)) >> 1);
+      pMsg->flags = (uint16_t)((DeviceRead ? I2C_M_RD : 0) | (Addr10bits ? I2C_M_TEN : 0) | (Start ? 0 : I2C_M_NOSTART));
+      pMsg->len   = (uint16_t)pPacket->BufferSize;
+      pMsg->buf   = pPacket->pBuffer;
+      MsgFirstPacket = zPacket;
+      continue;
+    }
+
+    //--- Continuation of the previous message without I2C_M_NOSTART: merge the packets ---
+    struct i2c_msg* pMsg = &Msgs[MsgCount - 1];
+    if (((pMsg->flags & I2C_M_RD) > 0) != DeviceRead) return ERR__I2C_INVALID_COMMAND; // The direction can't change without a restart
+    if ((MergeUsed + pMsg->len + pPacket->BufferSize) > I2C_LINUXDEV_MERGE_BUFFER_SIZE) return ERR__I2C_OVERFLOW_ERROR;
+    if (pMerged[MsgFirstPacket] == NULL)
+    { // First merge in this message: move the first packet in the merge buffer
+      pMerged[MsgFirstPacket] = &pDev->MergeBuffer[MergeUsed];
+      if ((DeviceRead == false) && (pMsg->len > 0)) memcpy(pMerged[MsgFirstPacket], pMsg->buf, pMsg->len);
+      pMsg->buf  = pMerged[MsgFirstPacket];
+      MergeUsed += pMsg->len;
+    }
+    pMerged[zPacket] = &pDev->MergeBuffer[MergeUsed];
+    if ((DeviceRead == false) && (pPacket->BufferSize > 0)) memcpy(pMerged[zPacket], pPacket->pBuffer, pPacket->BufferSize);
+    MergeUsed += pPacket->BufferSize;
+    pMsg->len  = (uint16_t)(pMsg->len + pPacket->BufferSize);
+  }
+
+  //--- Transfer all the messages in one syscall ---
+  struct i2c_rdwr_ioctl_data MsgSet = { Msgs, (uint32_t)MsgCount };
+  pDev->IoctlCount++;
+  const int Result = __I2C_LinuxDev_Ioctl(pDev, I2C_RDWR, &MsgSet);
+  if (Result < 0) return __I2C_LinuxDev_Errno(errno);
+  if ((size_t)Result != MsgCount) return ERR__I2C_COMM_ERROR;
+  pDev->MessageCount += (uint32_t)MsgCount;
+
+  //--- Give back the merged read data and compute the CRC of the packets ---
+  eERRORRESULT Error = ERR_NONE;
+  for (size_t zPacket = 0; zPacket < PacketCount; ++zPacket)
+  {
+    I2CInterface_Packet* pPacket = &pDev->Packets[zPacket];
+    if ((pMerged[zPacket] != NULL) && ((pPacket->ChipAddr & I2C_READ_ORMASK) > 0) && (pPacket->BufferSize > 0))
+      memcpy(pPacket->pBuffer, pMerged[zPacket], pPacket->BufferSize);
+    const eERRORRESULT ErrorCRC = Interface_I2CpacketCRC(pPacket);                // The CRC of the packets shall be computed in the bus order
+    if (Error == ERR_NONE) Error = ErrorCRC;
+  }
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux i2c-dev backend functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure an I2C_Interface to use a Linux i2c-dev device
+//=============================================================================
+eERRORRESULT I2C_LinuxDev_Attach(I2C_Interface *pIntDev, I2C_LinuxDev* pDev)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pDev == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  pDev->Functionality = 0;
+  pDev->PacketCount   = 0;
+  pDev->ReadFlushed   = false;
+  pDev->IoctlCount    = 0;
+  pDev->MessageCount  = 0;
+  pIntDev->InterfaceDevice     = pDev;
+  pIntDev->UniqueID            = 0;
+  pIntDev->fnI2C_Init          = I2C_LinuxDev_Init;
+  pIntDev->fnI2C_Transfer      = I2C_LinuxDev_Transfer;
+  pIntDev->fnI2C_TransferBatch = NULL;                                            // The generic batch already ends with one ioctl per stop
+  pIntDev->fnI2C_TransferAsync = NULL;
+  pIntDev->Channel             = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Linux i2c-dev initialization
+//=============================================================================
+eERRORRESULT I2C_LinuxDev_Init(I2C_Interface *pIntDev, const uint32_t sclFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  I2C_LinuxDev* pDev = (I2C_LinuxDev*)pIntDev->InterfaceDevice;
+  if (sclFreq == 0) return ERR__I2C_FREQUENCY_ERROR;
+  pDev->PacketCount = 0;
+  pDev->ReadFlushed = false;
+  if (pDev->Fd < 0)
+  {
+    if (pDev->pDevicePath == NULL) return ERR__I2C_CONFIG_ERROR;
+    pDev->Fd = open(pDev->pDevicePath, O_RDWR | O_CLOEXEC);
+    if (pDev->Fd < 0) return ERR__I2C_CONFIG_ERROR;
+  }
+  unsigned long Functionality = 0;
+  if (__I2C_LinuxDev_Ioctl(pDev, I2C_FUNCS, &Functionality) < 0) return __I2C_LinuxDev_Errno(errno);
+  if ((Functionality & I2C_FUNC_I2C) == 0) return ERR__NOT_SUPPORTED;              // SMBus only adapter, no I2C_RDWR
+  pDev->Functionality = Functionality;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Linux i2c-dev transfer
+//=============================================================================
+eERRORRESULT I2C_LinuxDev_Transfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  I2C_LinuxDev* pDev = (I2C_LinuxDev*)pIntDev->InterfaceDevice;
+  if (pDev->Fd < 0) return ERR__I2C_CONFIG_ERROR;
+  if ((pPacketDesc->pBuffer == NULL) && (pPacketDesc->BufferSize > 0)) return ERR__NULL_BUFFER;
+  pPacketDesc->Config.Value &= ~I2C_ENDIAN_RESULT_Mask;                           // The kernel does not perform endian transform
+  pPacketDesc->Config.Value |= I2C_ENDIAN_RESULT_SET(I2C_NO_ENDIAN_CHANGE);
+
+  //--- Collect the packet ---
+  if ((pPacketDesc->Start == false) && (pDev->PacketCount == 0) && (pDev->ReadFlushed == false)) return ERR__I2C_COMM_ERROR; // No transfer in progress to continue
+  pDev->ReadFlushed = false;
+  if ((pDev->PacketCount >= I2C_LINUXDEV_MAX_MESSAGES) || (pPacketDesc->BufferSize > UINT16_MAX))
+  {
+    pDev->PacketCount = 0;                                                        // Drop the whole transfer
+    return (pPacketDesc->BufferSize > UINT16_MAX ? ERR__BAD_DATA_SIZE : ERR__I2C_OVERFLOW_ERROR); // The length of an I2C message is 16-bits
+  }
+  pDev->Packets[pDev->PacketCount++] = *pPacketDesc;
+  const bool DeviceRead = ((pPacketDesc->ChipAddr & I2C_READ_ORMASK) > 0);
+  if ((pPacketDesc->Stop == false) && ((DeviceRead == false) || (pPacketDesc->BufferSize == 0))) return ERR_NONE; // Writes wait for the stop
+
+  //--- Stop or read data: transfer everything, the read data shall be available at return ---
+  const eERRORRESULT Error = __I2C_LinuxDev_Flush(pDev);
+  pDev->ReadFlushed = ((Error == ERR_NONE) && (pPacketDesc->Stop == false));   // The ioctl ended with a stop, a continuation will begin with a start
+  return Error;
+}
+
+
+//=============================================================================
+// Close the Linux i2c-dev device
+//=============================================================================
+void I2C_LinuxDev_Close(I2C_LinuxDev* pDev)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pDev == NULL) return;
+#endif
+  if (pDev->Fd >= 0) close(pDev->Fd);
+  pDev->Fd          = -1;
+  pDev->PacketCount = 0;
+  pDev->ReadFlushed = false;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif // #if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
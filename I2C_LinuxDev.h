@@ -0,0 +1,155 @@
+/*!*****************************************************************************
+ * @file    I2C_LinuxDev.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Linux i2c-dev backend of the I2C interface
+ * @details This backend plugs the /dev/i2c-N character devices into the generic
+ * I2C_Interface of all the https://github.com/Emandhal drivers and developments.
+ * Packets are collected until a packet with Stop = 'true' or a read packet and
+ * then transferred as one I2C_RDWR message set. Therefore a
+ * I2C_WRITE_THEN_READ_FIRST_PART + I2C_WRITE_THEN_READ_SECOND_PART pair (or the
+ * write then write pair) is one syscall with a repeated start instead of two
+ * transfers.
+ * The ioctl() function can be replaced by a shim to test without hardware
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __I2C_LINUXDEV_H_INC
+#define __I2C_LINUXDEV_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "I2C_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef I2C_LINUXDEV_MAX_MESSAGES
+#  define I2C_LINUXDEV_MAX_MESSAGES       ( 8u )   //!< Max packets collected until a stop. Shall not exceed I2C_RDWR_IOCTL_MAX_MSGS (42) of the kernel
+#endif
+#ifndef I2C_LINUXDEV_MERGE_BUFFER_SIZE
+#  define I2C_LINUXDEV_MERGE_BUFFER_SIZE  ( 256u ) //!< Size of the buffer used to merge the continuation packets when the adapter does not support I2C_M_NOSTART
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux i2c-dev backend
+//********************************************************************************************************************
+
+/*! @brief Function that performs an ioctl on the i2c-dev file descriptor
+ *
+ * Same prototype and behavior as the ioctl() of the C library: returns -1 and sets errno in case of error
+ * @param[in] fd Is the file descriptor of the i2c-dev device
+ * @param[in] request Is the ioctl request (I2C_RDWR, I2C_FUNCS...)
+ * @param[in,out] *pArg Is the argument of the request
+ * @return Returns -1 in case of error, else a non-negative value
+ */
+typedef int (*I2C_LinuxIoctl_Func)(int fd, unsigned long request, void* pArg);
+
+
+//! @brief Linux i2c-dev backend. Set this structure as the I2C_Interface.InterfaceDevice
+typedef struct I2C_LinuxDev
+{
+  const char* pDevicePath;                                 //!< Path of the i2c-dev device (ex: "/dev/i2c-1"). Opened by I2C_LinuxDev_Init() if Fd is negative
+  int Fd;                                                  //!< File descriptor of the i2c-dev device. Set to -1 before initialization or set an already opened file descriptor
+  I2C_LinuxIoctl_Func fnIoctl;                             //!< This function will be called instead of ioctl(). Set to NULL to use ioctl()
+  //--- Backend state ---
+  unsigned long Functionality;                             //!< Functionalities of the adapter (I2C_FUNC_* of the kernel), read at initialization
+  size_t PacketCount;                                      //!< Count of packets collected since the last stop
+  bool ReadFlushed;                                        //!< 'true' if the last packet was a read without stop, transferred at once. The next packet may continue it (Start = 'false')
+  I2CInterface_Packet Packets[I2C_LINUXDEV_MAX_MESSAGES];  //!< Packets collected since the last stop. Their buffers shall stay valid until the stop
+  uint8_t MergeBuffer[I2C_LINUXDEV_MERGE_BUFFER_SIZE];     //!< Messages made of several packets when the adapter does not support I2C_M_NOSTART
+  //--- Statistics ---
+  uint32_t IoctlCount;                                     //!< Count of I2C_RDWR ioctls
+  uint32_t MessageCount;                                   //!< Count of I2C messages transferred by the ioctls
+} I2C_LinuxDev;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux i2c-dev backend functions
+//********************************************************************************************************************
+
+/*! @brief Configure an I2C_Interface to use a Linux i2c-dev device
+ *
+ * @param[out] *pIntDev Is the I2C interface container structure to configure
+ * @param[in] *pDev Is the i2c-dev backend to use. pDevicePath or Fd shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_LinuxDev_Attach(I2C_Interface *pIntDev, I2C_LinuxDev* pDev);
+
+/*! @brief Linux i2c-dev initialization (#I2CInit_Func compatible)
+ *
+ * Open the device if not already opened and read its functionalities. The adapter shall support plain I2C transfers (I2C_FUNC_I2C)
+ * @note The SCL frequency of an i2c-dev adapter is set by the device tree or the kernel module parameters, sclFreq is only checked against 0
+ * @param[in] *pIntDev Is the I2C interface container structure used for the interface initialization
+ * @param[in] sclFreq Is the SCL frequency in Hz
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_LinuxDev_Init(I2C_Interface *pIntDev, const uint32_t sclFreq);
+
+/*! @brief Linux i2c-dev transfer (#I2CTransferPacket_Func compatible)
+ *
+ * Packets are collected until a packet with Stop = 'true' or a read packet, then all of them are transferred in one I2C_RDWR ioctl
+ * A packet with Start = 'true' begins a new message (repeated start after the first one), a packet with Start = 'false' continues the previous message (I2C_M_NOSTART)
+ * A read packet is transferred at once, even without a stop, so its data are available at return. The kernel ends each I2C_RDWR with a stop: a packet that continues a read without stop (Start = 'false') begins with a start and the chip address
+ * @warning Communication errors of a write packet without stop are returned by the next read packet or the packet with the stop. A packet with more than 65535 bytes (UINT16_MAX) is rejected with #ERR__BAD_DATA_SIZE
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through I2C
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_LinuxDev_Transfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc);
+
+/*! @brief Close the Linux i2c-dev device
+ *
+ * @param[in] *pDev Is the i2c-dev backend
+ */
+void I2C_LinuxDev_Close(I2C_LinuxDev* pDev);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __I2C_LINUXDEV_H_INC */
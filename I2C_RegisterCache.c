@@ -0,0 +1,352 @@
+/*!*****************************************************************************
+ * @file    I2C_RegisterCache.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.1.0
+ * @date    16/10/2026
+ * @brief   Write-through register cache for I2C devices
+ * @details This register cache sits between a driver and the I2C_Interface of
+ *          the bus for all the https://github.com/Emandhal drivers and
+ *          developments. Only available with the generic I2C_Interface (not
+ *          Arduino, not STM32cubeIDE)
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.1.0    Forward the packets with a CRC without caching
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "I2C_RegisterCache.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+
+#define REGCACHE_BIT_GET(map,reg)  ( ((map)[(reg) >> 5] & (1u << ((reg) & 0x1Fu))) > 0 )
+#define REGCACHE_BIT_SET(map,reg)  do { (map)[(reg) >> 5] |=  (1u << ((reg) & 0x1Fu)); } while (0)
+#define REGCACHE_BIT_CLR(map,reg)  do { (map)[(reg) >> 5] &= ~(1u << ((reg) & 0x1Fu)); } while (0)
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C register cache internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Find the cached device of a chip address
+//=============================================================================
+static I2C_RegCacheDevice* __I2C_RegCache_FindDevice(I2C_RegCache* pCache, uint16_t chipAddr, bool addr10bits)
+{
+  const uint16_t ChipAddr = (chipAddr & (addr10bits ? I2C_ONLY_ADDR10_Mask : I2C_ONLY_ADDR8_Mask));
+  for (size_t zIdx = 0; zIdx < pCache->DeviceCount; ++zIdx)
+    if ((pCache->pDevices[zIdx].ChipAddr == ChipAddr) && (pCache->pDevices[zIdx].Addr10bits == addr10bits)) return &pCache->pDevices[zIdx];
+  return NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Invalidate all the registers of a cached device
+//=============================================================================
+static void __I2C_RegCache_InvalidateDevice(I2C_RegCacheDevice* pDevice)
+{
+  const size_t MapSize = I2C_REGCACHE_BITMAP_SIZE(pDevice->RegisterCount);
+  for (size_t zIdx = 0; zIdx < MapSize; ++zIdx)
+  {
+    pDevice->pValidMap[zIdx] = 0;
+    pDevice->pDirtyMap[zIdx] = 0;
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Get the register address from the register address bytes (MSB first)
+//=============================================================================
+static uint32_t __I2C_RegCache_RegAddr(const I2C_RegCacheDevice* pDevice, const uint8_t* pRegAddr)
+{
+  return (pDevice->RegAddrSize == 2 ? (((uint32_t)pRegAddr[0] << 8) | pRegAddr[1]) : pRegAddr[0]);
+}
+
+
+//=============================================================================
+// [STATIC] Is a range of registers can be served by the cache?
+//=============================================================================
+static bool __I2C_RegCache_IsCached(const I2C_RegCacheDevice* pDevice, uint32_t regAddr, size_t count)
+{
+  for (size_t zIdx = 0; zIdx < count; ++zIdx, ++regAddr)
+  {
+    if ((pDevice->pVolatileMap != NULL) && REGCACHE_BIT_GET(pDevice->pVolatileMap, regAddr)) return false;
+    if (REGCACHE_BIT_GET(pDevice->pValidMap, regAddr) == false) return false;
+    if (REGCACHE_BIT_GET(pDevice->pDirtyMap, regAddr)) return false;
+  }
+  return true;
+}
+
+
+//=============================================================================
+// [STATIC] Update the shadow values of a range of registers
+//=============================================================================
+static void __I2C_RegCache_Update(I2C_RegCacheDevice* pDevice, uint32_t regAddr, const uint8_t* pData, size_t count, bool deviceUpToDate)
+{
+  for (size_t zIdx = 0; zIdx < count; ++zIdx, ++regAddr)
+  {
+    pDevice->pShadow[regAddr] = pData[zIdx];
+    if (deviceUpToDate)
+    {
+      REGCACHE_BIT_SET(pDevice->pValidMap, regAddr);
+      REGCACHE_BIT_CLR(pDevice->pDirtyMap, regAddr);
+    }
+    else
+    {
+      REGCACHE_BIT_CLR(pDevice->pValidMap, regAddr);
+      REGCACHE_BIT_SET(pDevice->pDirtyMap, regAddr);
+    }
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Invalidate a range of registers
+//=============================================================================
+static void __I2C_RegCache_InvalidateRange(I2C_RegCacheDevice* pDevice, uint32_t regAddr, size_t count)
+{
+  for (size_t zIdx = 0; (zIdx < count) && (regAddr < pDevice->RegisterCount); ++zIdx, ++regAddr)
+  {
+    REGCACHE_BIT_CLR(pDevice->pValidMap, regAddr);
+    REGCACHE_BIT_CLR(pDevice->pDirtyMap, regAddr);
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Transfer the pending first part packet (if any) and a packet on the bus
+//=============================================================================
+static eERRORRESULT __I2C_RegCache_Forward(I2C_RegCache* pCache, I2CInterface_Packet* const pPacketDesc)
+{
+  eERRORRESULT Error;
+  if (pCache->HasPending)
+  {
+    pCache->HasPending = false;
+    I2CInterface_Packet Packets[2] = { pCache->PendingPacket, *pPacketDesc };
+    Error = Interface_I2CtransferBatch(pCache->pI2C, &Packets[0], 2, NULL);   // Both parts in one batch, the bus is not released between them
+    pPacketDesc->Config = Packets[1].Config;                                   // Give back the endian result
+    return Error;
+  }
+  return pCache->pI2C->fnI2C_Transfer(pCache->pI2C, pPacketDesc);
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C register cache functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure an I2C_Interface to use a register cache
+//=============================================================================
+eERRORRESULT I2C_RegCache_Attach(I2C_Interface *pIntDev, I2C_RegCache* pCache, I2C_Interface* pI2C)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pCache == NULL) || (pI2C == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  for (size_t zIdx = 0; zIdx < pCache->DeviceCount; ++zIdx)
+  {
+    I2C_RegCacheDevice* pDevice = &pCache->pDevices[zIdx];
+    if ((pDevice->pShadow == NULL) || (pDevice->pValidMap == NULL) || (pDevice->pDirtyMap == NULL)) return ERR__NULL_BUFFER;
+    if ((pDevice->RegAddrSize < 1) || (pDevice->RegAddrSize > 2)) return ERR__I2C_CONFIG_ERROR;
+    __I2C_RegCache_InvalidateDevice(pDevice);
+  }
+  pCache->pI2C          = pI2C;
+  pCache->HasPending    = false;
+  pCache->ReadHits      = 0;
+  pCache->ReadMisses    = 0;
+  pCache->WritesSkipped = 0;
+  pCache->WritesThrough = 0;
+  pIntDev->InterfaceDevice     = pCache;
+  pIntDev->UniqueID            = 0;
+  pIntDev->fnI2C_Init          = I2C_RegCache_Init;
+  pIntDev->fnI2C_Transfer      = I2C_RegCache_Transfer;
+  pIntDev->fnI2C_TransferBatch = NULL;
+  pIntDev->fnI2C_TransferAsync = NULL;
+  pIntDev->Channel             = pI2C->Channel;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// I2C register cache initialization
+//=============================================================================
+eERRORRESULT I2C_RegCache_Init(I2C_Interface *pIntDev, const uint32_t sclFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  I2C_RegCache* pCache = (I2C_RegCache*)pIntDev->InterfaceDevice;
+  for (size_t zIdx = 0; zIdx < pCache->DeviceCount; ++zIdx) __I2C_RegCache_InvalidateDevice(&pCache->pDevices[zIdx]);
+  pCache->HasPending = false;
+  if (pCache->pI2C->fnI2C_Init == NULL) return ERR_NONE;
+  return pCache->pI2C->fnI2C_Init(pCache->pI2C, sclFreq);
+}
+
+
+//=============================================================================
+// I2C register cache transfer
+//=============================================================================
+eERRORRESULT I2C_RegCache_Transfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  I2C_RegCache* pCache = (I2C_RegCache*)pIntDev->InterfaceDevice;
+  const bool DeviceWrite = ((pPacketDesc->ChipAddr & I2C_READ_ORMASK) == 0);
+  const eI2C_TransferType TransferType = (eI2C_TransferType)pPacketDesc->Config.Bits.TransferType;
+  const bool NoEndianChange = (I2C_ENDIAN_TRANSFORM_GET(pPacketDesc->Config.Value) == I2C_NO_ENDIAN_CHANGE);
+  I2C_RegCacheDevice* pDevice = __I2C_RegCache_FindDevice(pCache, pPacketDesc->ChipAddr, (pPacketDesc->Config.Bits.Addr10bits > 0));
+  eERRORRESULT Error;
+
+  //--- Not a cached device? ---
+  if (pDevice == NULL) return __I2C_RegCache_Forward(pCache, pPacketDesc);
+
+  //--- Register address of a register access: keep it until the second part ---
+  if (I2C_IS_FIRST_TRANSFER(TransferType) && DeviceWrite && pPacketDesc->Start && (pPacketDesc->Stop == false)
+   && (pPacketDesc->pBuffer != NULL) && (pPacketDesc->BufferSize == pDevice->RegAddrSize) && (pCache->HasPending == false) && (pPacketDesc->pCRC == NULL))
+  {
+    memcpy(&pCache->PendingRegAddr[0], pPacketDesc->pBuffer, pDevice->RegAddrSize);
+    pCache->PendingPacket         = *pPacketDesc;
+    pCache->PendingPacket.pBuffer = &pCache->PendingRegAddr[0];
+    pCache->pPending              = pDevice;
+    pCache->HasPending            = true;
+    return ERR_NONE;
+  }
+
+  //--- Get the register range of the access ---
+  uint32_t RegAddr = 0;
+  const uint8_t* pData = pPacketDesc->pBuffer;
+  size_t DataSize = pPacketDesc->BufferSize;
+  bool RegisterAccess = false;
+  if (pCache->HasPending && (pCache->pPending == pDevice) && I2C_IS_SECOND_TRANSFER(TransferType))
+  { // Second part of a register access
+    RegAddr = __I2C_RegCache_RegAddr(pDevice, &pCache->PendingRegAddr[0]);
+    RegisterAccess = (DeviceWrite == I2C_IS_SECOND_TRANSFER_WRITE(TransferType));
+  }
+  else if ((pCache->HasPending == false) && (TransferType == I2C_SIMPLE_TRANSFER) && DeviceWrite && pPacketDesc->Start && pPacketDesc->Stop
+        && (pPacketDesc->pBuffer != NULL) && (pPacketDesc->BufferSize > pDevice->RegAddrSize))
+  { // Register write with the register address and the data in the same packet
+    RegAddr  = __I2C_RegCache_RegAddr(pDevice, pPacketDesc->pBuffer);
+    pData   += pDevice->RegAddrSize;
+    DataSize -= pDevice->RegAddrSize;
+    RegisterAccess = true;
+  }
+  if (RegisterAccess && ((pData == NULL) || (DataSize == 0) || ((RegAddr + DataSize) > pDevice->RegisterCount))) RegisterAccess = false;
+
+  //--- Not a register access or not cacheable. The bytes of a packet with a CRC shall be on the bus ---
+  if ((RegisterAccess == false) || (NoEndianChange == false) || (pPacketDesc->pCRC != NULL))
+  {
+    if (RegisterAccess) __I2C_RegCache_InvalidateRange(pDevice, RegAddr, DataSize);
+    else if (DeviceWrite) __I2C_RegCache_InvalidateDevice(pDevice);            // Unknown write, the effect on registers is unknown
+    return __I2C_RegCache_Forward(pCache, pPacketDesc);
+  }
+
+  //--- Register read ---
+  if (DeviceWrite == false)
+  {
+    if (__I2C_RegCache_IsCached(pDevice, RegAddr, DataSize))
+    {
+      pCache->HasPending = false;                                               // The register address is not sent
+      memcpy(pPacketDesc->pBuffer, &pDevice->pShadow[RegAddr], DataSize);
+      pCache->ReadHits++;
+      return ERR_NONE;
+    }
+    pCache->ReadMisses++;
+    Error = __I2C_RegCache_Forward(pCache, pPacketDesc);
+    if (Error == ERR_NONE) __I2C_RegCache_Update(pDevice, RegAddr, pData, DataSize, true);
+    return Error;
+  }
+
+  //--- Register write ---
+  if (__I2C_RegCache_IsCached(pDevice, RegAddr, DataSize) && (memcmp(&pDevice->pShadow[RegAddr], pData, DataSize) == 0))
+  {
+    pCache->HasPending = false;                                                 // Unchanged values, nothing sent
+    pCache->WritesSkipped++;
+    return ERR_NONE;
+  }
+  pCache->WritesThrough++;
+  Error = __I2C_RegCache_Forward(pCache, pPacketDesc);
+  __I2C_RegCache_Update(pDevice, RegAddr, pData, DataSize, (Error == ERR_NONE)); // If the write failed, the registers are dirty
+  return Error;
+}
+
+
+//=============================================================================
+// Invalidate the cached registers of a device
+//=============================================================================
+eERRORRESULT I2C_RegCache_Invalidate(I2C_RegCache* pCache, uint16_t chipAddr)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pCache == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  I2C_RegCacheDevice* pDevice = __I2C_RegCache_FindDevice(pCache, chipAddr, false);
+  if (pDevice == NULL) pDevice = __I2C_RegCache_FindDevice(pCache, chipAddr, true);
+  if (pDevice == NULL) return ERR__UNKNOWN_DEVICE;
+  __I2C_RegCache_InvalidateDevice(pDevice);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Write again the dirty registers of a device
+//=============================================================================
+eERRORRESULT I2C_RegCache_Sync(I2C_RegCache* pCache, uint16_t chipAddr)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pCache == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  I2C_RegCacheDevice* pDevice = __I2C_RegCache_FindDevice(pCache, chipAddr, false);
+  if (pDevice == NULL) pDevice = __I2C_RegCache_FindDevice(pCache, chipAddr, true);
+  if (pDevice == NULL) return ERR__UNKNOWN_DEVICE;
+  const uint32_t AddrFlag = (pDevice->Addr10bits ? I2C_USE_10BITS_ADDRESS : I2C_USE_8BITS_ADDRESS);
+  eERRORRESULT Error;
+
+  uint32_t RegAddr = 0;
+  while (RegAddr < pDevice->RegisterCount)
+  {
+    if (REGCACHE_BIT_GET(pDevice->pDirtyMap, RegAddr) == false) { ++RegAddr; continue; }
+    uint32_t RunEnd = RegAddr + 1;
+    while ((RunEnd < pDevice->RegisterCount) && REGCACHE_BIT_GET(pDevice->pDirtyMap, RunEnd)) ++RunEnd;
+
+    //--- Write the run of dirty registers directly from the shadow values ---
+    uint8_t RegAddrBytes[2];
+    if (pDevice->RegAddrSize == 2) { RegAddrBytes[0] = (uint8_t)(RegAddr >> 8); RegAddrBytes[1] = (uint8_t)RegAddr; }
+    else RegAddrBytes[0] = (uint8_t)RegAddr;
+    I2CInterface_Packet Packets[2] =
+    {
+      I2C_INTERFACE8_TX_DATA_DESC(pDevice->ChipAddr, true , &RegAddrBytes[0]        , pDevice->RegAddrSize, false, I2C_WRITE_THEN_WRITE_FIRST_PART ),
+      I2C_INTERFACE8_TX_DATA_DESC(pDevice->ChipAddr, false, &pDevice->pShadow[RegAddr], (RunEnd - RegAddr) , true , I2C_WRITE_THEN_WRITE_SECOND_PART),
+    };
+    Packets[0].Config.Value |= AddrFlag;
+    Packets[1].Config.Value |= AddrFlag;
+    Error = Interface_I2CtransferBatch(pCache->pI2C, &Packets[0], 2, NULL);
+    if (Error != ERR_NONE) return Error;
+    __I2C_RegCache_Update(pDevice, RegAddr, &pDevice->pShadow[RegAddr], (RunEnd - RegAddr), true);
+    RegAddr = RunEnd;
+  }
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+#endif // #if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,165 @@
+/*!*****************************************************************************
+ * @file    I2C_RegisterCache.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Write-through register cache for I2C devices
+ * @details This register cache sits between a driver and the I2C_Interface of
+ * the bus for all the https://github.com/Emandhal drivers and developments.
+ * It intercepts the register accesses of the I2C_WRITE_THEN_READ_* and
+ * I2C_WRITE_THEN_WRITE_* conventions and the simple register writes:
+ * - Reads of non-volatile registers already known are served from the shadow values
+ * - Writes of a value equal to the shadow value are skipped
+ * - All other writes go to the device (write-through) and update the shadow values
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __I2C_REGISTERCACHE_H_INC
+#define __I2C_REGISTERCACHE_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "I2C_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define I2C_REGCACHE_BITMAP_SIZE(registerCount)  ( ((registerCount) + 31u) / 32u ) //!< Count of uint32_t needed for a register bitmap
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C register cache
+//********************************************************************************************************************
+
+//! @brief Register cache of a device. All the arrays are given by the user
+typedef struct I2C_RegCacheDevice
+{
+  uint16_t ChipAddr;      //!< I2C chip address of the device with the R/W bit cleared
+  bool Addr10bits;        //!< Chip address length: 'true' = 10-bits address ; 'false' = 8-bits address
+  uint8_t RegAddrSize;    //!< Register address size in bytes (1 or 2), sent MSB first
+  uint16_t RegisterCount; //!< Count of registers of the device (8-bits registers)
+  uint8_t* pShadow;       //!< Shadow values of the registers (RegisterCount bytes)
+  uint32_t* pVolatileMap; //!< Volatile registers bitmap (status, FIFO, counters...): '1' = never served from the cache. Set by the user. Can be NULL if no volatile registers
+  uint32_t* pValidMap;    //!< Valid registers bitmap: '1' = the shadow value is the device value
+  uint32_t* pDirtyMap;    //!< Dirty registers bitmap: '1' = the shadow value has not been written to the device (write error). I2C_RegCache_Sync() writes them again
+} I2C_RegCacheDevice;
+
+
+//! @brief I2C register cache. Set this structure as the I2C_Interface.InterfaceDevice of the interface given to the drivers
+typedef struct I2C_RegCache
+{
+  I2C_Interface* pI2C;               //!< I2C interface of the bus
+  I2C_RegCacheDevice* pDevices;      //!< Cached devices. Packets of other devices are not intercepted
+  size_t DeviceCount;                //!< Count of cached devices
+  //--- Pending register address ---
+  bool HasPending;                   //!< A first part packet is waiting for its second part
+  I2CInterface_Packet PendingPacket; //!< First part packet (register address) not transferred yet
+  uint8_t PendingRegAddr[2];         //!< Copy of the register address bytes of the first part packet
+  I2C_RegCacheDevice* pPending;      //!< Device of the first part packet
+  //--- Statistics ---
+  uint32_t ReadHits;                 //!< Count of reads served by the cache
+  uint32_t ReadMisses;               //!< Count of reads of cached devices transferred on the bus
+  uint32_t WritesSkipped;            //!< Count of writes skipped because the values are unchanged
+  uint32_t WritesThrough;            //!< Count of writes of cached devices transferred on the bus
+} I2C_RegCache;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// I2C register cache functions
+//********************************************************************************************************************
+
+/*! @brief Configure an I2C_Interface to use a register cache
+ *
+ * The interface configured here is the one to give to the drivers. All the cached devices are invalidated
+ * @param[out] *pIntDev Is the I2C interface container structure to configure
+ * @param[in] *pCache Is the register cache to use. Its devices shall already be set
+ * @param[in] *pI2C Is the I2C interface of the bus
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_RegCache_Attach(I2C_Interface *pIntDev, I2C_RegCache* pCache, I2C_Interface* pI2C);
+
+/*! @brief I2C register cache initialization (#I2CInit_Func compatible)
+ *
+ * Initialize the I2C interface of the bus and invalidate all the cached devices
+ * @param[in] *pIntDev Is the I2C interface container structure used for the interface initialization
+ * @param[in] sclFreq Is the SCL frequency in Hz to set at the interface initialization
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_RegCache_Init(I2C_Interface *pIntDev, const uint32_t sclFreq);
+
+/*! @brief I2C register cache transfer (#I2CTransferPacket_Func compatible)
+ *
+ * A write first part packet (register address) of a cached device is kept until its second part. Then the register access is served by the cache or transferred on the bus with its first part
+ * Packets asking for an endian transform are not cached, the registers concerned are invalidated
+ * @note A read served by the cache does not change the register pointer of the device. A current address read (read without register address) is never cached
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through I2C
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_RegCache_Transfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc);
+
+/*! @brief Invalidate the cached registers of a device
+ *
+ * Use this after a device reset or when the device registers have been changed by something else than the cache
+ * @param[in] *pCache Is the register cache
+ * @param[in] chipAddr Is the I2C chip address of the device
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_RegCache_Invalidate(I2C_RegCache* pCache, uint16_t chipAddr);
+
+/*! @brief Write again the dirty registers of a device
+ *
+ * Each contiguous run of dirty registers is written in one register write
+ * @param[in] *pCache Is the register cache
+ * @param[in] chipAddr Is the I2C chip address of the device
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_RegCache_Sync(I2C_RegCache* pCache, uint16_t chipAddr);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __I2C_REGISTERCACHE_H_INC */
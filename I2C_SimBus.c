@@ -0,0 +1,295 @@
+/*!*****************************************************************************
+ * @file    I2C_SimBus.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.2.0
+ * @date    16/10/2026
+ * @brief   Simulated I2C bus for host tests
+ * @details This simulated I2C bus plugs into the generic I2C_Interface of all
+ *          the https://github.com/Emandhal drivers and developments.
+ *          Only available with the generic I2C_Interface (not Arduino, not
+ *          STM32cubeIDE)
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.2.0    Add the EEPROM write cycle model
+ * 1.1.0    Compute the CRC of the packets
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "I2C_SimBus.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated I2C bus functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure an I2C_Interface to use a simulated I2C bus
+//=============================================================================
+eERRORRESULT I2C_SimBus_Attach(I2C_Interface *pIntDev, I2C_SimBus* pBus)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pBus == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  pIntDev->InterfaceDevice     = pBus;
+  pIntDev->UniqueID            = 0;
+  pIntDev->fnI2C_Init          = I2C_SimBus_Init;
+  pIntDev->fnI2C_Transfer      = I2C_SimBus_Transfer;
+  pIntDev->fnI2C_TransferBatch = NULL;
+  pIntDev->fnI2C_TransferAsync = NULL;
+  pIntDev->Channel             = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Simulated I2C bus initialization
+//=============================================================================
+eERRORRESULT I2C_SimBus_Init(I2C_Interface *pIntDev, const uint32_t sclFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  I2C_SimBus* pBus = (I2C_SimBus*)pIntDev->InterfaceDevice;
+  if (sclFreq == 0) return ERR__I2C_FREQUENCY_ERROR;
+  pBus->SCLfreq    = sclFreq;
+  pBus->BusBusy    = false;
+  pBus->pCurrent   = NULL;
+  pBus->pLastWrite = NULL;
+  for (size_t zIdx = 0; zIdx < pBus->DeviceCount; ++zIdx)
+  {
+    if ((pBus->pDevices[zIdx].RegAddrSize < 1) || (pBus->pDevices[zIdx].RegAddrSize > 2)) return ERR__I2C_CONFIG_ERROR;
+    if ((pBus->pDevices[zIdx].PageSize & (pBus->pDevices[zIdx].PageSize - 1u)) != 0) return ERR__I2C_CONFIG_ERROR; // Shall be a power of 2
+    pBus->pDevices[zIdx].RegPointer      = 0;
+    pBus->pDevices[zIdx].BusyUntil_ns    = 0;
+    pBus->pDevices[zIdx].WriteCycleCount = 0;
+  }
+  pBus->DataWritten = false;
+  pBus->Time_ns     = 0;
+  I2C_SimBus_ResetStats(pBus);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Add SCL cycles to the bus cycles and to the time of the bus
+//=============================================================================
+static void __I2C_SimBus_AddCycles(I2C_SimBus* pBus, uint32_t cycles)
+{
+  pBus->SCLcycles += cycles;
+  pBus->Time_ns   += ((uint64_t)cycles * 1000000000u) / pBus->SCLfreq;
+}
+
+
+//=============================================================================
+// [STATIC] Send a stop condition on the simulated bus
+//=============================================================================
+static void __I2C_SimBus_Stop(I2C_SimBus* pBus)
+{
+  __I2C_SimBus_AddCycles(pBus, I2C_SIMBUS_STOP_CYCLES);
+  if (pBus->DataWritten && (pBus->pCurrent != NULL) && (pBus->pCurrent->WriteCycleTime_us > 0)) // The EEPROM write cycle starts at the stop
+  {
+    pBus->pCurrent->BusyUntil_ns = pBus->Time_ns + ((uint64_t)pBus->pCurrent->WriteCycleTime_us * 1000u);
+    pBus->pCurrent->WriteCycleCount++;
+  }
+  pBus->DataWritten = false;
+  pBus->StopCount++;
+  pBus->BusBusy  = false;
+  pBus->pCurrent = NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Add a byte and the clock stretching of the device to the bus cycles
+//=============================================================================
+static void __I2C_SimBus_ByteCycles(I2C_SimBus* pBus, const I2C_SimDevice* pDevice)
+{
+  __I2C_SimBus_AddCycles(pBus, I2C_SIMBUS_BYTE_CYCLES);
+  if (pDevice == NULL) return;
+  __I2C_SimBus_AddCycles(pBus, pDevice->StretchCycles);
+  pBus->StretchCycles += pDevice->StretchCycles;
+}
+
+
+//=============================================================================
+// Simulated I2C bus transfer
+//=============================================================================
+eERRORRESULT I2C_SimBus_Transfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__I2C_PARAMETER_ERROR;
+#endif
+  I2C_SimBus* pBus = (I2C_SimBus*)pIntDev->InterfaceDevice;
+  const bool Addr10bits = (pPacketDesc->Config.Bits.Addr10bits > 0);
+  const bool DeviceRead = ((pPacketDesc->ChipAddr & I2C_READ_ORMASK) > 0);
+  const uint16_t ChipAddr = (pPacketDesc->ChipAddr & (Addr10bits ? I2C_ONLY_ADDR10_Mask : I2C_ONLY_ADDR8_Mask));
+  pPacketDesc->Config.Value &= ~I2C_ENDIAN_RESULT_Mask;                           // The simulated bus does not perform endian transform
+  pPacketDesc->Config.Value |= I2C_ENDIAN_RESULT_SET(I2C_NO_ENDIAN_CHANGE);
+
+  //--- Start and chip address ---
+  if (pPacketDesc->Start)
+  {
+    I2C_SimDevice* pDevice = NULL;
+    for (size_t zIdx = 0; zIdx < pBus->DeviceCount; ++zIdx)
+      if ((pBus->pDevices[zIdx].ChipAddr == ChipAddr) && (pBus->pDevices[zIdx].Addr10bits == Addr10bits)) { pDevice = &pBus->pDevices[zIdx]; break; }
+    const bool Restart = pBus->BusBusy;
+    __I2C_SimBus_AddCycles(pBus, I2C_SIMBUS_START_CYCLES);
+    pBus->StartCount++;
+    pBus->BusBusy = true;
+    if (Addr10bits)
+    {
+      if (DeviceRead && Restart && (pDevice != NULL) && (pBus->pLastWrite == pDevice))
+        __I2C_SimBus_ByteCycles(pBus, NULL);                                      // Read after restart: only the first address byte with the read bit
+      else if (DeviceRead)
+      {                                                                           // Read without previous write: 2 address bytes in write, restart, first address byte with the read bit
+        __I2C_SimBus_ByteCycles(pBus, NULL);
+        __I2C_SimBus_ByteCycles(pBus, NULL);
+        __I2C_SimBus_AddCycles(pBus, I2C_SIMBUS_START_CYCLES);
+        __I2C_SimBus_ByteCycles(pBus, NULL);
+      }
+      else
+      {
+        __I2C_SimBus_ByteCycles(pBus, NULL);
+        __I2C_SimBus_ByteCycles(pBus, NULL);
+      }
+    }
+    else __I2C_SimBus_ByteCycles(pBus, NULL);
+    pBus->DataWritten = false;
+    if ((pDevice != NULL) && (pBus->Time_ns < pDevice->BusyUntil_ns)) pDevice = NULL; // An EEPROM does not acknowledge during its write cycle
+    if (pDevice == NULL)                                                          // No device acknowledged the chip address?
+    {
+      pBus->NackCount++;
+      __I2C_SimBus_Stop(pBus);                                                    // The master releases the bus after a NACK
+      return ERR__I2C_NACK_ADDR;
+    }
+    pBus->pCurrent      = pDevice;
+    pBus->CurrentIsRead = DeviceRead;
+    pBus->RegAddrBytes  = 0;
+    if (DeviceRead == false) pBus->pLastWrite = pDevice;
+  }
+  else
+  {
+    if ((pBus->BusBusy == false) || (pBus->pCurrent == NULL)) return ERR__I2C_COMM_ERROR; // No transfer in progress to continue
+    if (pBus->CurrentIsRead != DeviceRead) return ERR__I2C_INVALID_COMMAND;               // The direction can't change without a restart
+  }
+
+  //--- Data bytes ---
+  I2C_SimDevice* pDevice = pBus->pCurrent;
+  if ((pPacketDesc->pBuffer != NULL) && (pDevice->RegisterCount > 0))
+  {
+    for (size_t zIdx = 0; zIdx < pPacketDesc->BufferSize; ++zIdx)
+    {
+      if (DeviceRead)
+      {
+        pPacketDesc->pBuffer[zIdx] = pDevice->pRegisters[pDevice->RegPointer];
+        pDevice->RegPointer = (pDevice->RegPointer + 1) % pDevice->RegisterCount;
+      }
+      else if (pBus->RegAddrBytes < pDevice->RegAddrSize)                         // Register address bytes, MSB first
+      {
+        pDevice->RegPointer = (pBus->RegAddrBytes == 0 ? 0 : (pDevice->RegPointer << 8)) | pPacketDesc->pBuffer[zIdx];
+        pBus->RegAddrBytes++;
+        if (pBus->RegAddrBytes == pDevice->RegAddrSize) pDevice->RegPointer %= pDevice->RegisterCount;
+      }
+      else
+      {
+        pDevice->pRegisters[pDevice->RegPointer] = pPacketDesc->pBuffer[zIdx];
+        if (pDevice->PageSize > 0)                                                // The EEPROM writes wrap around in the page
+          pDevice->RegPointer = (pDevice->RegPointer & ~((size_t)pDevice->PageSize - 1u)) | ((pDevice->RegPointer + 1) & ((size_t)pDevice->PageSize - 1u));
+        else pDevice->RegPointer = (pDevice->RegPointer + 1) % pDevice->RegisterCount;
+        pBus->DataWritten = true;
+      }
+      __I2C_SimBus_ByteCycles(pBus, pDevice);
+    }
+    pBus->DataBytes += pPacketDesc->BufferSize;
+  }
+
+  //--- Stop ---
+  if (pPacketDesc->Stop) __I2C_SimBus_Stop(pBus);
+  return Interface_I2CpacketCRC(pPacketDesc);
+}
+
+
+//=============================================================================
+// Reset the statistics of the simulated I2C bus
+//=============================================================================
+void I2C_SimBus_ResetStats(I2C_SimBus* pBus)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBus == NULL) return;
+#endif
+  pBus->SCLcycles     = 0;
+  pBus->StretchCycles = 0;
+  pBus->DataBytes     = 0;
+  pBus->StartCount    = 0;
+  pBus->StopCount     = 0;
+  pBus->NackCount     = 0;
+}
+
+
+//=============================================================================
+// Get the simulated bus time used since the last statistics reset
+//=============================================================================
+uint64_t I2C_SimBus_GetBusTime_us(const I2C_SimBus* pBus)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBus == NULL) return 0;
+#endif
+  if (pBus->SCLfreq == 0) return 0;
+  return (pBus->SCLcycles * 1000000u) / pBus->SCLfreq;
+}
+
+
+//=============================================================================
+// Advance the time of the simulated bus
+//=============================================================================
+void I2C_SimBus_AdvanceTime(I2C_SimBus* pBus, uint32_t time_us)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBus == NULL) return;
+#endif
+  pBus->Time_ns += (uint64_t)time_us * 1000u;
+}
+
+
+//=============================================================================
+// Get the time of the simulated bus
+//=============================================================================
+uint64_t I2C_SimBus_GetTime_us(const I2C_SimBus* pBus)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBus == NULL) return 0;
+#endif
+  return pBus->Time_ns / 1000u;
+}
+
+
+//=============================================================================
+// Get the effective data throughput of the simulated bus
+//=============================================================================
+uint32_t I2C_SimBus_GetThroughput(const I2C_SimBus* pBus)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pBus == NULL) return 0;
+#endif
+  if (pBus->SCLcycles == 0) return 0;
+  return (uint32_t)((pBus->DataBytes * pBus->SCLfreq) / pBus->SCLcycles);
+}
+
+//-----------------------------------------------------------------------------
+#endif // #if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,195 @@
+/*!*****************************************************************************
+ * @file    I2C_SimBus.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.2.0
+ * @date    16/10/2026
+ * @brief   Simulated I2C bus for host tests
+ * @details This simulated I2C bus plugs into the generic I2C_Interface of all
+ * the https://github.com/Emandhal drivers and developments. Devices are modeled
+ * as register maps with auto-increment. The bus counts the SCL cycles to give
+ * the effective throughput for the SCL frequency set at initialization.
+ * A device can also model an EEPROM: the writes wrap around in a page and the
+ * device does not acknowledge its address during the write cycle that follows
+ * the stop of a write. The write cycle runs on the time of the bus, advanced by
+ * the SCL cycles and by I2C_SimBus_AdvanceTime()
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.2.0    Add the EEPROM write cycle model
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __I2C_SIMBUS_H_INC
+#define __I2C_SIMBUS_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "I2C_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define I2C_SIMBUS_START_CYCLES  ( 1u ) //!< SCL cycles used by a start or a restart condition
+#define I2C_SIMBUS_STOP_CYCLES   ( 1u ) //!< SCL cycles used by a stop condition
+#define I2C_SIMBUS_BYTE_CYCLES   ( 9u ) //!< SCL cycles used by a byte (8 data bits + ACK/NACK bit)
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated I2C device and bus
+//********************************************************************************************************************
+
+//! @brief Simulated I2C device, modeled as a register map with auto-increment
+typedef struct I2C_SimDevice
+{
+  uint16_t ChipAddr;          //!< I2C chip address of the device with the R/W bit cleared (8-bits format) or 10-bits address shifted left by 1
+  bool Addr10bits;            //!< Chip address length: 'true' = 10-bits address ; 'false' = 8-bits address
+  uint8_t RegAddrSize;        //!< Register address size in bytes (1 or 2), sent MSB first after the chip address at each write
+  uint8_t* pRegisters;        //!< Register map of the device
+  size_t RegisterCount;       //!< Count of registers in the register map. The register pointer wraps around at the end of the map
+  uint32_t StretchCycles;     //!< Clock stretching of the device after each byte, in SCL cycles
+  uint16_t PageSize;          //!< EEPROM page size (power of 2): the register pointer of the writes wraps around in the page. 0 if no page
+  uint32_t WriteCycleTime_us; //!< EEPROM write cycle duration in microseconds after the stop of a write. The device does not acknowledge its address meanwhile. 0 if instantaneous
+  //--- Device state ---
+  size_t RegPointer;          //!< Current register pointer, auto-incremented at each data byte
+  uint64_t BusyUntil_ns;      //!< Time of the end of the write cycle
+  uint32_t WriteCycleCount;   //!< Count of write cycles
+} I2C_SimDevice;
+
+
+//! @brief Simulated I2C bus. Set this structure as the I2C_Interface.InterfaceDevice
+typedef struct I2C_SimBus
+{
+  I2C_SimDevice* pDevices;   //!< Devices on the bus
+  size_t DeviceCount;        //!< Count of devices on the bus
+  uint32_t SCLfreq;          //!< SCL frequency in Hz set by I2C_SimBus_Init()
+  //--- Bus state ---
+  bool BusBusy;              //!< 'true' if a start has been sent without stop
+  bool CurrentIsRead;        //!< Direction of the current transfer
+  I2C_SimDevice* pCurrent;   //!< Device addressed by the current transfer. NULL if no device acknowledged
+  I2C_SimDevice* pLastWrite; //!< Last device addressed in write, used for the 10-bits read after restart
+  size_t RegAddrBytes;       //!< Count of register address bytes received since the last start in write
+  bool DataWritten;          //!< 'true' if data bytes have been written to the current device since the last start
+  uint64_t Time_ns;          //!< Time of the bus, advanced by the SCL cycles and by I2C_SimBus_AdvanceTime(). Not reset with the statistics
+  //--- Statistics ---
+  uint64_t SCLcycles;        //!< Count of SCL cycles used on the bus
+  uint64_t StretchCycles;    //!< Count of SCL cycles of clock stretching (included in SCLcycles)
+  uint64_t DataBytes;        //!< Count of data bytes transferred (chip address bytes are not counted)
+  uint32_t StartCount;       //!< Count of start and restart conditions
+  uint32_t StopCount;        //!< Count of stop conditions
+  uint32_t NackCount;        //!< Count of chip address not acknowledged
+} I2C_SimBus;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated I2C bus functions
+//********************************************************************************************************************
+
+/*! @brief Configure an I2C_Interface to use a simulated I2C bus
+ *
+ * @param[out] *pIntDev Is the I2C interface container structure to configure
+ * @param[in] *pBus Is the simulated bus to use. Its devices shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_SimBus_Attach(I2C_Interface *pIntDev, I2C_SimBus* pBus);
+
+/*! @brief Simulated I2C bus initialization (#I2CInit_Func compatible)
+ *
+ * Set the SCL frequency, release the bus and reset the statistics
+ * @param[in] *pIntDev Is the I2C interface container structure used for the interface initialization
+ * @param[in] sclFreq Is the SCL frequency in Hz
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_SimBus_Init(I2C_Interface *pIntDev, const uint32_t sclFreq);
+
+/*! @brief Simulated I2C bus transfer (#I2CTransferPacket_Func compatible)
+ *
+ * A packet with Start = 'true' sends a start (or a restart if the bus has not been stopped) and the chip address. An unknown chip address returns ERR__I2C_NACK_ADDR and releases the bus
+ * At each write after a start, the first RegAddrSize bytes set the register pointer of the device, the following bytes are written to the register map
+ * Reads get the register map from the register pointer. The register pointer is auto-incremented after each data byte
+ * A device with a WriteCycleTime_us starts its write cycle at the stop of a write with data bytes, and returns ERR__I2C_NACK_ADDR until its end
+ * @param[in] *pIntDev Is the I2C interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through I2C
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT I2C_SimBus_Transfer(I2C_Interface *pIntDev, I2CInterface_Packet* const pPacketDesc);
+
+/*! @brief Reset the statistics of the simulated I2C bus
+ *
+ * @param[in] *pBus Is the simulated bus
+ */
+void I2C_SimBus_ResetStats(I2C_SimBus* pBus);
+
+/*! @brief Get the simulated bus time used since the last statistics reset
+ *
+ * @param[in] *pBus Is the simulated bus
+ * @return Returns the bus time in microseconds at the configured SCL frequency
+ */
+uint64_t I2C_SimBus_GetBusTime_us(const I2C_SimBus* pBus);
+
+/*! @brief Get the effective data throughput of the simulated bus since the last statistics reset
+ *
+ * This takes into account the start/stop conditions, the chip address bytes, the ACK bits and the clock stretching
+ * @param[in] *pBus Is the simulated bus
+ * @return Returns the data throughput in bytes per second at the configured SCL frequency
+ */
+uint32_t I2C_SimBus_GetThroughput(const I2C_SimBus* pBus);
+
+/*! @brief Advance the time of the simulated bus while the bus is idle
+ *
+ * Use this to simulate the time spent by the host between the transfers (delays, processing...)
+ * @param[in] *pBus Is the simulated bus
+ * @param[in] time_us Is the time to add in microseconds
+ */
+void I2C_SimBus_AdvanceTime(I2C_SimBus* pBus, uint32_t time_us);
+
+/*! @brief Get the time of the simulated bus
+ *
+ * @param[in] *pBus Is the simulated bus
+ * @return Returns the time of the bus in microseconds since its initialization
+ */
+uint64_t I2C_SimBus_GetTime_us(const I2C_SimBus* pBus);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __I2C_SIMBUS_H_INC */
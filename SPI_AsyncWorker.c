@@ -0,0 +1,273 @@
+/*!*****************************************************************************
+ * @file    SPI_AsyncWorker.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Worker thread giving the asynchronous transfers to a SPI interface
+ * @details This worker sits between the drivers and a SPI_Interface that only
+ *          has blocking transfers for all the https://github.com/Emandhal
+ *          drivers and developments. Only available on Linux with the
+ *          generic SPI_Interface
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "SPI_AsyncWorker.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI asynchronous worker internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Worker thread: transfer the queued transactions one after the other
+//=============================================================================
+static void* __SPI_AsyncWorker_Thread(void* pArg)
+{
+  SPI_AsyncWorker* pWorker = (SPI_AsyncWorker*)pArg;
+  pthread_mutex_lock(&pWorker->Mutex);
+  while (true)
+  {
+    while (pWorker->Running && ((pWorker->pHead == NULL) || pWorker->SequenceOpen)) pthread_cond_wait(&pWorker->WorkCond, &pWorker->Mutex);
+    if (pWorker->pHead == NULL) break;                                                           // Stopped and nothing left to transfer
+    SPIInterface_Transaction* pTransaction = pWorker->pHead;
+    pWorker->pHead = pTransaction->pNext;
+    if (pWorker->pHead == NULL) pWorker->pTail = NULL;
+    pWorker->QueueDepth--;
+    pWorker->Busy = true;
+    pthread_mutex_unlock(&pWorker->Mutex);
+
+    //--- Transfer the transaction outside the lock, new transactions can be queued meanwhile ---
+    SPIInterface_Packet* const pPacket = &pTransaction->Packet;                                  // Copy of the driver packet made at submission
+    pPacket->Config.Value &= ~SPI_USE_NON_BLOCKING;                                              // The worker thread is the non-blocking part, the interface of the bus shall only return at the end of the transfer
+    const bool Terminate = pPacket->Terminate;                                                   // The transaction can be submitted again as soon as it completes
+    const eERRORRESULT Error = pWorker->pSPI->fnSPI_Transfer(pWorker->pSPI, pPacket);
+    Interface_SPIcompleteTransaction(pTransaction, Error);
+
+    pthread_mutex_lock(&pWorker->Mutex);
+    pWorker->Busy = false;
+    pWorker->AsyncSequenceOpen = (Terminate == false) && (Error == ERR_NONE);                    // The ChipSelect stays asserted until a transaction with Terminate = 'true' or an error
+    pWorker->TransactionCount++;
+    if (pWorker->pHead == NULL) pthread_cond_broadcast(&pWorker->IdleCond);
+  }
+  pthread_mutex_unlock(&pWorker->Mutex);
+  return NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Lock the worker and wait for the end of the queued transactions. The worker is not locked in case of error
+//=============================================================================
+static eERRORRESULT __SPI_AsyncWorker_LockIdle(SPI_AsyncWorker* pWorker)
+{
+  pthread_mutex_lock(&pWorker->Mutex);
+  if (pWorker->SequenceOpen) return ERR_NONE;                                                    // The bus is already ours, the transactions queued meanwhile wait for the end of the sequence
+  while ((pWorker->pHead != NULL) || pWorker->Busy) pthread_cond_wait(&pWorker->IdleCond, &pWorker->Mutex);
+  if (pWorker->AsyncSequenceOpen == false) return ERR_NONE;
+  pthread_mutex_unlock(&pWorker->Mutex);                                                         // The ChipSelect of an asynchronous sequence is asserted until its transaction with Terminate = 'true'
+  return ERR__SPI_BUSY;
+}
+
+
+//=============================================================================
+// [STATIC] Non-blocking packet given to the blocking transfer: transferred by the worker thread with the transaction of the worker
+//=============================================================================
+static eERRORRESULT __SPI_AsyncWorker_NonBlocking(SPI_Interface *pIntDev, SPI_AsyncWorker* pWorker, SPIInterface_Packet* const pPacketDesc)
+{
+  SPIInterface_Transaction* const pTransaction = &pWorker->NonBlockingTransaction;
+  if (pTransaction->Status == SPI_TRANSACTION_PENDING) return ERR__SPI_BUSY;                     // The previous non-blocking packet is still in transfer
+  if (pPacketDesc->DataSize == 0)                                                                // Status check of the previous non-blocking packet
+    return (pTransaction->Status == SPI_TRANSACTION_COMPLETE ? pTransaction->Result : ERR_NONE);
+  pWorker->NonBlockingPacket = *pPacketDesc;                                                     // The packet of the driver may not stay valid until the end of the transfer
+  Interface_SPIinitTransaction(pTransaction, &pWorker->NonBlockingPacket, NULL, pWorker);
+  return Interface_SPItransferAsync(pIntDev, pTransaction);
+}
+
+
+//=============================================================================
+// [STATIC] Unlock the worker after a blocking transfer
+//=============================================================================
+static void __SPI_AsyncWorker_Unlock(SPI_AsyncWorker* pWorker, bool sequenceOpen)
+{
+  pWorker->SequenceOpen = sequenceOpen;
+  if ((sequenceOpen == false) && (pWorker->pHead != NULL)) pthread_cond_signal(&pWorker->WorkCond);
+  pthread_mutex_unlock(&pWorker->Mutex);
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI asynchronous worker functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure a SPI_Interface to use an asynchronous worker
+//=============================================================================
+eERRORRESULT SPI_AsyncWorker_Attach(SPI_Interface *pIntDev, SPI_AsyncWorker* pWorker, SPI_Interface* pSPI)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pWorker == NULL) || (pSPI == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pSPI->fnSPI_Transfer == NULL) return ERR__SPI_CONFIG_ERROR;
+  pWorker->pSPI              = pSPI;
+  pWorker->pHead             = NULL;
+  pWorker->pTail             = NULL;
+  pWorker->Busy              = false;
+  pWorker->SequenceOpen      = false;
+  pWorker->AsyncSequenceOpen = false;
+  pWorker->TransactionCount  = 0;
+  pWorker->QueueDepth        = 0;
+  pWorker->MaxQueueDepth     = 0;
+  Interface_SPIinitTransaction(&pWorker->NonBlockingTransaction, &pWorker->NonBlockingPacket, NULL, pWorker);
+  if (pthread_mutex_init(&pWorker->Mutex, NULL) != 0) return ERR__OUT_OF_MEMORY;
+  if (pthread_cond_init(&pWorker->WorkCond, NULL) != 0)
+  {
+    pthread_mutex_destroy(&pWorker->Mutex);
+    return ERR__OUT_OF_MEMORY;
+  }
+  if (pthread_cond_init(&pWorker->IdleCond, NULL) != 0)
+  {
+    pthread_cond_destroy(&pWorker->WorkCond);
+    pthread_mutex_destroy(&pWorker->Mutex);
+    return ERR__OUT_OF_MEMORY;
+  }
+  pWorker->Running = true;
+  if (pthread_create(&pWorker->Thread, NULL, __SPI_AsyncWorker_Thread, pWorker) != 0)
+  {
+    pWorker->Running = false;
+    pthread_cond_destroy(&pWorker->IdleCond);
+    pthread_cond_destroy(&pWorker->WorkCond);
+    pthread_mutex_destroy(&pWorker->Mutex);
+    return ERR__OUT_OF_MEMORY;
+  }
+  pIntDev->InterfaceDevice           = pWorker;
+  pIntDev->UniqueID                  = 0;
+  pIntDev->fnSPI_Init                = SPI_AsyncWorker_Init;
+  pIntDev->fnSPI_Transfer            = SPI_AsyncWorker_Transfer;
+  pIntDev->fnSPI_TransferSegmentList = NULL;                                         // The generic segment list uses the blocking transfer
+  pIntDev->fnSPI_TransferPhases      = SPI_AsyncWorker_TransferPhases;
+  pIntDev->fnSPI_TransferAsync       = SPI_AsyncWorker_TransferAsync;
+  pIntDev->Channel                   = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Stop the worker thread
+//=============================================================================
+void SPI_AsyncWorker_Stop(SPI_AsyncWorker* pWorker)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pWorker == NULL) return;
+#endif
+  pthread_mutex_lock(&pWorker->Mutex);
+  const bool WasRunning = pWorker->Running;
+  pWorker->Running = false;
+  pthread_cond_broadcast(&pWorker->WorkCond);
+  pthread_mutex_unlock(&pWorker->Mutex);
+  if (WasRunning) pthread_join(pWorker->Thread, NULL);
+}
+
+
+//=============================================================================
+// SPI asynchronous worker initialization
+//=============================================================================
+eERRORRESULT SPI_AsyncWorker_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_AsyncWorker* pWorker = (SPI_AsyncWorker*)pIntDev->InterfaceDevice;
+  if (pWorker->pSPI->fnSPI_Init == NULL) return ERR__SPI_CONFIG_ERROR;
+  eERRORRESULT Error = __SPI_AsyncWorker_LockIdle(pWorker);
+  if (Error != ERR_NONE) return Error;
+  Error = pWorker->pSPI->fnSPI_Init(pWorker->pSPI, chipSelect, mode, sckFreq);
+  __SPI_AsyncWorker_Unlock(pWorker, pWorker->SequenceOpen);
+  return Error;
+}
+
+
+//=============================================================================
+// SPI asynchronous worker blocking transfer
+//=============================================================================
+eERRORRESULT SPI_AsyncWorker_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_AsyncWorker* pWorker = (SPI_AsyncWorker*)pIntDev->InterfaceDevice;
+  if (pPacketDesc->Config.Bits.IsNonBlocking) return __SPI_AsyncWorker_NonBlocking(pIntDev, pWorker, pPacketDesc);
+  eERRORRESULT Error = __SPI_AsyncWorker_LockIdle(pWorker);                                      // The lock is kept during the transfer, the worker thread can't start a transaction in the middle of it
+  if (Error != ERR_NONE) return Error;
+  Error = pWorker->pSPI->fnSPI_Transfer(pWorker->pSPI, pPacketDesc);
+  __SPI_AsyncWorker_Unlock(pWorker, (pPacketDesc->Terminate == false) && (Error == ERR_NONE)); // The ChipSelect stays asserted until a packet with Terminate = 'true' or an error
+  return Error;
+}
+
+
+//=============================================================================
+// SPI asynchronous worker phase transfer
+//=============================================================================
+eERRORRESULT SPI_AsyncWorker_TransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPhasePacket == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_AsyncWorker* pWorker = (SPI_AsyncWorker*)pIntDev->InterfaceDevice;
+  eERRORRESULT Error = __SPI_AsyncWorker_LockIdle(pWorker);
+  if (Error != ERR_NONE) return Error;
+  Error = Interface_SPItransferPhases(pWorker->pSPI, pPhasePacket);
+  __SPI_AsyncWorker_Unlock(pWorker, pWorker->SequenceOpen);
+  return Error;
+}
+
+
+//=============================================================================
+// SPI asynchronous worker transfer
+//=============================================================================
+eERRORRESULT SPI_AsyncWorker_TransferAsync(SPI_Interface *pIntDev, SPIInterface_Transaction* const pTransaction)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pTransaction == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_AsyncWorker* pWorker = (SPI_AsyncWorker*)pIntDev->InterfaceDevice;
+  pthread_mutex_lock(&pWorker->Mutex);
+  if (pWorker->Running == false)
+  {
+    pthread_mutex_unlock(&pWorker->Mutex);
+    return ERR__NOT_READY;
+  }
+  pTransaction->pNext = NULL;
+  if (pWorker->pTail != NULL) pWorker->pTail->pNext = pTransaction;
+  else pWorker->pHead = pTransaction;
+  pWorker->pTail = pTransaction;
+  pWorker->QueueDepth++;
+  if (pWorker->QueueDepth > pWorker->MaxQueueDepth) pWorker->MaxQueueDepth = pWorker->QueueDepth;
+  pthread_cond_signal(&pWorker->WorkCond);
+  pthread_mutex_unlock(&pWorker->Mutex);
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+#endif // #if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,165 @@
+/*!*****************************************************************************
+ * @file    SPI_AsyncWorker.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Worker thread giving the asynchronous transfers to a SPI interface
+ * @details This worker sits between the drivers and a SPI_Interface that only
+ * has blocking transfers (spidev, simulated devices...) for all the
+ * https://github.com/Emandhal drivers and developments. The asynchronous
+ * transactions are queued and transferred one after the other by a worker
+ * thread, so the caller can work while the bus transfers. The blocking
+ * transfers wait for the end of the queued transactions and are done by the
+ * caller. The non-blocking packets (SPI_Conf.Bits.IsNonBlocking = 1) given to
+ * the blocking transfer go through the worker thread.
+ * A transaction with Terminate = 'false' leaves the ChipSelect asserted: the
+ * bus belongs to its driver until its transaction with Terminate = 'true', the
+ * blocking transfers return #ERR__SPI_BUSY meanwhile
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_ASYNCWORKER_H_INC
+#define __SPI_ASYNCWORKER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI asynchronous worker
+//********************************************************************************************************************
+
+//! @brief SPI asynchronous worker. Set this structure as the SPI_Interface.InterfaceDevice of the interface given to the drivers
+typedef struct SPI_AsyncWorker
+{
+  SPI_Interface* pSPI;                             //!< SPI interface of the bus, with blocking transfers
+  //--- Worker state ---
+  pthread_t Thread;                                //!< Worker thread
+  pthread_mutex_t Mutex;                           //!< Protects the queue and the state
+  pthread_cond_t WorkCond;                         //!< Signaled when a transaction is queued or when the worker shall stop
+  pthread_cond_t IdleCond;                         //!< Signaled when the queue becomes empty
+  SPIInterface_Transaction* pHead;                 //!< First queued transaction (next to transfer)
+  SPIInterface_Transaction* pTail;                 //!< Last queued transaction
+  bool Running;                                    //!< 'true' while the worker thread runs
+  bool Busy;                                       //!< 'true' while the worker thread transfers a transaction
+  bool SequenceOpen;                               //!< 'true' while a blocking sequence (packets with Terminate = 'false') is in progress. The worker thread waits for its end
+  bool AsyncSequenceOpen;                          //!< 'true' while the last transaction transferred left the ChipSelect asserted (Terminate = 'false'). The blocking transfers are rejected
+  SPIInterface_Transaction NonBlockingTransaction; //!< Transaction of the non-blocking packets given to the blocking transfer
+  SPIInterface_Packet NonBlockingPacket;           //!< Copy of the non-blocking packet in transfer, the packet of the driver may not stay valid
+  //--- Statistics ---
+  uint32_t TransactionCount;                       //!< Count of transactions transferred by the worker thread
+  uint32_t QueueDepth;                             //!< Current count of queued transactions
+  uint32_t MaxQueueDepth;                          //!< Worst count of queued transactions
+} SPI_AsyncWorker;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI asynchronous worker functions
+//********************************************************************************************************************
+
+/*! @brief Configure a SPI_Interface to use an asynchronous worker and start the worker thread
+ *
+ * The interface configured here is the one to give to the drivers
+ * @param[out] *pIntDev Is the SPI interface container structure to configure
+ * @param[in] *pWorker Is the asynchronous worker to use
+ * @param[in] *pSPI Is the SPI interface of the bus
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_AsyncWorker_Attach(SPI_Interface *pIntDev, SPI_AsyncWorker* pWorker, SPI_Interface* pSPI);
+
+/*! @brief Stop the worker thread
+ *
+ * The transactions already queued are transferred before the worker thread stops
+ * @param[in] *pWorker Is the asynchronous worker
+ */
+void SPI_AsyncWorker_Stop(SPI_AsyncWorker* pWorker);
+
+/*! @brief SPI asynchronous worker initialization (#SPIInit_Func compatible)
+ *
+ * Wait for the end of the queued transactions and initialize the SPI interface of the bus
+ * @param[in] *pIntDev Is the SPI interface container structure used for the interface initialization
+ * @param[in] chipSelect Is the Chip Select index to use for the SPI initialization
+ * @param[in] mode Is the mode of the SPI to configure
+ * @param[in] sckFreq Is the SCK frequency in Hz to set at the interface initialization
+ * @return Returns an #eERRORRESULT value enum. #ERR__SPI_BUSY if an asynchronous transaction left a ChipSelect asserted
+ */
+eERRORRESULT SPI_AsyncWorker_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq);
+
+/*! @brief SPI asynchronous worker blocking transfer (#SPITransferPacket_Func compatible)
+ *
+ * Wait for the end of the queued transactions and transfer the packet with the SPI interface of the bus. Until a packet with Terminate = 'true', the queued transactions wait for the end of the sequence
+ * A non-blocking packet (SPI_Conf.Bits.IsNonBlocking = 1) is queued for the worker thread with the transaction of the worker: it returns #ERR__SPI_BUSY while the previous non-blocking packet is in transfer, and a packet without data returns the result of the previous non-blocking packet
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum. #ERR__SPI_BUSY if an asynchronous transaction left a ChipSelect asserted
+ */
+eERRORRESULT SPI_AsyncWorker_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief SPI asynchronous worker phase transfer (#SPITransferPhases_Func compatible)
+ *
+ * Wait for the end of the queued transactions and transfer the phase packet with the SPI interface of the bus
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPhasePacket Is the phase packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum. #ERR__SPI_BUSY if an asynchronous transaction left a ChipSelect asserted
+ */
+eERRORRESULT SPI_AsyncWorker_TransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket);
+
+/*! @brief SPI asynchronous worker transfer (#SPITransferAsync_Func compatible)
+ *
+ * Queue the transaction for the worker thread. The transaction is completed by the worker thread, its SPIInterface_Transaction.fnComplete is called from the worker thread
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pTransaction Is the transaction to queue
+ * @return Returns an #eERRORRESULT value enum. #ERR__NOT_READY if the worker thread is stopped
+ */
+eERRORRESULT SPI_AsyncWorker_TransferAsync(SPI_Interface *pIntDev, SPIInterface_Transaction* const pTransaction);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_ASYNCWORKER_H_INC */
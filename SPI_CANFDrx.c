@@ -0,0 +1,366 @@
+/*!*****************************************************************************
+ * @file    SPI_CANFDrx.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Batched receive FIFO drain engine for MCP251xFD CAN-FD controllers
+ * @details This receive engine drains the receive FIFOs of MCP251xFD
+ *          controllers by bursts through the SPI_Interface for all the
+ *          https://github.com/Emandhal drivers and developments
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "SPI_CANFDrx.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_CANFD_FRESET_TRIES  ( 16u ) //!< Count of reads of a FIFO control register before the end of its reset
+
+static const uint8_t SPI_CANFD_PAYLOAD_SIZE[8] = { 8, 12, 16, 20, 24, 32, 48, 64 }; //!< Payload sizes of the PLSIZE codes
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// CAN FD receive engine internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Fill the instruction and the address of a SPI command
+//=============================================================================
+static void __SPI_CANFDrx_FillCommand(uint8_t* pBuffer, uint8_t instruction, uint16_t address)
+{
+  pBuffer[0] = (uint8_t)((instruction << 4) | ((address >> 8) & 0x0Fu));
+  pBuffer[1] = (uint8_t)address;
+}
+
+
+//=============================================================================
+// [STATIC] Read with the segments already set after the command segment
+//=============================================================================
+static eERRORRESULT __SPI_CANFDrx_ReadSegments(SPI_CANFDrx* pRx, uint16_t address, size_t segmentCount)
+{
+  size_t Size = 0;
+  for (size_t zSeg = 1; zSeg < segmentCount; ++zSeg) Size += pRx->Segments[zSeg].DataSize;
+  if (((address & 0x3u) > 0) || ((Size & 0x3u) > 0)) return ERR__BYTE_COUNT_MODULO_4;          // The controller is accessed by words
+
+  //--- Command, then the data under the same ChipSelect ---
+  __SPI_CANFDrx_FillCommand(&pRx->Command[0], SPI_CANFD_INSTRUCTION_READ, address);
+  SPIInterface_Segment CommandSegment = SPI_INTERFACE_TX_SEGMENT(&pRx->Command[0], SPI_CANFD_COMMAND_SIZE);
+  pRx->Segments[0] = CommandSegment;
+  SPIInterface_SegmentList SegmentList;
+  SegmentList.Config.Value = SPI_BLOCKING;
+  SegmentList.ChipSelect   = pRx->ChipSelect;
+  SegmentList.pSegments    = &pRx->Segments[0];
+  SegmentList.SegmentCount = segmentCount;
+  SegmentList.Terminate    = true;
+  eERRORRESULT Error = Interface_SPItransferSegmentList(pRx->pSPI, &SegmentList);
+  if (Error != ERR_NONE) return Error;
+  for (size_t zSeg = 1; zSeg < segmentCount; ++zSeg)                                               // The endian transform of the words not done by the interface
+  {
+    Error = Interface_SPIsegmentEndianTransform(&pRx->Segments[zSeg]);
+    if (Error != ERR_NONE) return Error;
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Write a byte of a register (blocking)
+//=============================================================================
+static eERRORRESULT __SPI_CANFDrx_WriteByte(SPI_CANFDrx* pRx, uint16_t address, uint8_t value)
+{
+  uint8_t Buffer[SPI_CANFD_COMMAND_SIZE + 1u];
+  __SPI_CANFDrx_FillCommand(&Buffer[0], SPI_CANFD_INSTRUCTION_WRITE, address);
+  Buffer[SPI_CANFD_COMMAND_SIZE] = value;
+  SPIInterface_Packet Packet;
+  Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+  Packet.ChipSelect   = pRx->ChipSelect;
+  Packet.DummyByte    = 0x00;
+  Packet.TxData       = &Buffer[0];
+  Packet.RxData       = NULL;
+  Packet.DataSize     = sizeof(Buffer);
+  Packet.Terminate    = true;
+  Packet.pCRC         = NULL;
+  return pRx->pSPI->fnSPI_Transfer(pRx->pSPI, &Packet);
+}
+
+
+//=============================================================================
+// [STATIC] Add a write of a byte of a register to the writes of the drain
+//=============================================================================
+static void __SPI_CANFDrx_AddWrite(SPI_CANFDrx* pRx, uint16_t address, uint8_t value)
+{
+  uint8_t* pBuffer = &pRx->Writes[pRx->WriteCount][0];
+  SPIInterface_Packet* pPacket = &pRx->Packets[pRx->WriteCount];
+  __SPI_CANFDrx_FillCommand(pBuffer, SPI_CANFD_INSTRUCTION_WRITE, address);
+  pBuffer[SPI_CANFD_COMMAND_SIZE] = value;
+  pPacket->Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+  pPacket->ChipSelect = pRx->ChipSelect;
+  pPacket->DummyByte  = 0x00;
+  pPacket->TxData     = pBuffer;
+  pPacket->RxData     = NULL;
+  pPacket->DataSize   = SPI_CANFD_COMMAND_SIZE + 1u;
+  pPacket->Terminate  = true;                                                                      // Each write is a SPI command
+  pPacket->pCRC       = NULL;
+  pRx->WriteCount++;
+}
+
+
+//=============================================================================
+// [STATIC] Start the writes of the drain, one after the other
+//=============================================================================
+static eERRORRESULT __SPI_CANFDrx_StartWrites(SPI_CANFDrx* pRx)
+{
+  const size_t Count = pRx->WriteCount;
+  for (size_t zWrite = 0; zWrite < Count; ++zWrite)
+  {
+    SPIInterface_Transaction* pTransaction = &pRx->Transactions[zWrite];
+    pTransaction->pPacketDesc = &pRx->Packets[zWrite];
+    pTransaction->fnComplete  = NULL;
+    pTransaction->pContext    = pRx;
+    const eERRORRESULT Error = Interface_SPItransferAsync(pRx->pSPI, pTransaction);
+    if (Error != ERR_NONE)
+    {
+      pRx->WriteCount = zWrite;                                                                    // Only the writes accepted are waited
+      return Error;
+    }
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Read message objects of a FIFO with one burst
+//=============================================================================
+static eERRORRESULT __SPI_CANFDrx_ReadObjects(SPI_CANFDrx* pRx, const SPI_CANFDrxFifo* pFifo, uint32_t index, size_t count, SPI_CANFDrxFrame* pFrames)
+{
+  const bool Contiguous = (pFifo->HeaderSize == 12u) && (SPI_CANFD_WORD_ENDIAN == SPI_NO_ENDIAN_CHANGE); // Header and payload are contiguous in the frame
+  size_t SegmentCount = 1;
+  for (size_t zObj = 0; zObj < count; ++zObj)
+  {
+    SPI_CANFDrxFrame* pFrame = &pFrames[zObj];
+    pFrame->TimeStamp = 0;
+    pFrame->Fifo      = pFifo->Fifo;
+    if (Contiguous)
+    {
+      SPIInterface_Segment Object = SPI_INTERFACE_RX_SEGMENT_WITH_DUMMYBYTE(0x00, &pFrame->Identifier, (size_t)pFifo->ObjectSize, SPI_NO_ENDIAN_CHANGE);
+      pRx->Segments[SegmentCount++] = Object;
+      continue;
+    }
+    SPIInterface_Segment Header  = SPI_INTERFACE_RX_SEGMENT_WITH_DUMMYBYTE(0x00, &pFrame->Identifier, (size_t)pFifo->HeaderSize, SPI_CANFD_WORD_ENDIAN);
+    SPIInterface_Segment Payload = SPI_INTERFACE_RX_SEGMENT_WITH_DUMMYBYTE(0x00, &pFrame->Data[0], (size_t)pFifo->PayloadSize, SPI_NO_ENDIAN_CHANGE);
+    pRx->Segments[SegmentCount++] = Header;
+    pRx->Segments[SegmentCount++] = Payload;
+  }
+  pRx->BurstCount++;
+  return __SPI_CANFDrx_ReadSegments(pRx, (uint16_t)(pFifo->Base + (index * pFifo->ObjectSize)), SegmentCount);
+}
+
+
+//=============================================================================
+// [STATIC] Drain the message objects available in a FIFO
+//=============================================================================
+static eERRORRESULT __SPI_CANFDrx_DrainFifo(SPI_CANFDrx* pRx, const SPI_CANFDrxFifo* pFifo, SPI_CANFDrxFrame* pFrames, size_t maxFrames, size_t* pCount)
+{
+  const size_t StatusIndex = (SPI_CANFD_C1FIFOSTA(pFifo->Fifo) - pRx->StatusAddress) / sizeof(uint32_t);
+  const uint32_t Status  = pRx->Status[StatusIndex];
+  const uint32_t Address = pRx->Status[StatusIndex + 1u] + SPI_CANFD_RAM_ADDRESS;                  // The user address is an offset in the RAM
+  *pCount = 0;
+  if ((Status & SPI_CANFD_FIFOSTA_RXOVIF) > 0)                                                     // Messages lost, clear the flag with the writes
+  {
+    pRx->OverflowCount++;
+    __SPI_CANFDrx_AddWrite(pRx, SPI_CANFD_C1FIFOSTA(pFifo->Fifo), (uint8_t)(Status & ~SPI_CANFD_FIFOSTA_RXOVIF));
+  }
+  if (((Status & SPI_CANFD_FIFOSTA_TFNRFNIF) == 0) || (maxFrames == 0)) return ERR_NONE;
+  if ((Address < pFifo->Base) || (((Address - pFifo->Base) % pFifo->ObjectSize) > 0)) return ERR__BAD_ADDRESS;
+  const uint32_t Tail = (Address - pFifo->Base) / pFifo->ObjectSize;
+  const uint32_t Head = SPI_CANFD_FIFOSTA_FIFOCI_GET(Status);
+  if ((Tail >= pFifo->Depth) || (Head >= pFifo->Depth)) return ERR__BAD_ADDRESS;
+  uint32_t Available = (Head + pFifo->Depth - Tail) % pFifo->Depth;
+  if (Available == 0) Available = pFifo->Depth;                                                    // Not empty and head on the tail: the FIFO is full
+
+  //--- Message objects up to the end of the FIFO, then from its start ---
+  const size_t Count = (Available < maxFrames ? Available : maxFrames);
+  const size_t First = (Count < (size_t)(pFifo->Depth - Tail) ? Count : (size_t)(pFifo->Depth - Tail));
+  eERRORRESULT Error = __SPI_CANFDrx_ReadObjects(pRx, pFifo, Tail, First, &pFrames[0]);
+  if (Error != ERR_NONE) return Error;
+  if (Count > First)
+  {
+    Error = __SPI_CANFDrx_ReadObjects(pRx, pFifo, 0, Count - First, &pFrames[First]);
+    if (Error != ERR_NONE) return Error;
+  }
+
+  //--- One increment per message object read ---
+  for (size_t zObj = 0; zObj < Count; ++zObj)
+    __SPI_CANFDrx_AddWrite(pRx, SPI_CANFD_C1FIFOCON(pFifo->Fifo) + 1u, (uint8_t)(SPI_CANFD_FIFOCON_UINC >> 8));
+  pRx->IncrementCount += (uint32_t)Count;
+  *pCount = Count;
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// CAN FD receive engine functions
+//********************************************************************************************************************
+//=============================================================================
+// CAN FD receive engine initialization
+//=============================================================================
+eERRORRESULT SPI_CANFDrx_Init(SPI_CANFDrx* pRx)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pRx == NULL) || (pRx->pSPI == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pRx->pSPI->fnSPI_Init == NULL) return ERR__SPI_PARAMETER_ERROR;
+  if (pRx->RxFifoMask == 0) return ERR__CONFIGURATION;
+  if ((pRx->RxFifoMask & 0x1u) > 0) return ERR__TOO_MANY_FIFO;                                   // The FIFO 0 is the TXQ
+  eERRORRESULT Error = pRx->pSPI->fnSPI_Init(pRx->pSPI, pRx->ChipSelect, STD_SPI_MODE0, pRx->SCKfreq);
+  if (Error != ERR_NONE) return Error;
+  pRx->FifoCount  = 0;
+  pRx->WriteCount = 0;
+  SPI_CANFDrx_ResetStats(pRx);
+  for (size_t zWrite = 0; zWrite < SPI_CANFD_MAX_WRITES; ++zWrite) Interface_SPIinitTransaction(&pRx->Transactions[zWrite], &pRx->Packets[zWrite], NULL, pRx);
+
+  //--- Reset each receive FIFO and read its configuration ---
+  for (uint32_t zFifo = 1; zFifo < SPI_CANFD_FIFO_COUNT; ++zFifo)
+  {
+    if ((pRx->RxFifoMask & (1u << zFifo)) == 0) continue;
+    Error = __SPI_CANFDrx_WriteByte(pRx, (uint16_t)(SPI_CANFD_C1FIFOCON(zFifo) + 1u), (uint8_t)(SPI_CANFD_FIFOCON_FRESET >> 8));
+    if (Error != ERR_NONE) return Error;
+    uint32_t Registers[3];                                                                         // Control, status and user address
+    size_t Tries = 0;
+    do
+    {
+      if (Tries++ >= SPI_CANFD_FRESET_TRIES) return ERR__DEVICE_TIMEOUT;
+      Error = SPI_CANFDrx_ReadWords(pRx, (uint16_t)SPI_CANFD_C1FIFOCON(zFifo), &Registers[0], 3);
+      if (Error != ERR_NONE) return Error;
+    } while ((Registers[0] & SPI_CANFD_FIFOCON_FRESET) > 0);
+    if ((Registers[0] & SPI_CANFD_FIFOCON_TXEN) > 0) return ERR__CONFIGURATION;
+    SPI_CANFDrxFifo* pFifo = &pRx->Fifos[pRx->FifoCount++];
+    pFifo->Fifo        = (uint8_t)zFifo;
+    pFifo->Depth       = (uint8_t)(SPI_CANFD_FIFOCON_FSIZE_GET(Registers[0]) + 1u);
+    pFifo->HeaderSize  = ((Registers[0] & SPI_CANFD_FIFOCON_TSEN) > 0 ? 12u : 8u);
+    pFifo->PayloadSize = SPI_CANFD_PAYLOAD_SIZE[SPI_CANFD_FIFOCON_PLSIZE_GET(Registers[0])];
+    pFifo->ObjectSize  = (uint16_t)(pFifo->HeaderSize + pFifo->PayloadSize);
+    pFifo->Base        = (uint16_t)(Registers[2] + SPI_CANFD_RAM_ADDRESS);                        // After the reset, the tail is the first message object
+    if ((pFifo->Base + ((uint32_t)pFifo->Depth * pFifo->ObjectSize)) > (SPI_CANFD_RAM_ADDRESS + SPI_CANFD_RAM_SIZE)) return ERR__BAD_ADDRESS;
+  }
+
+  //--- The status burst covers all the receive FIFOs ---
+  pRx->StatusAddress = (uint16_t)SPI_CANFD_C1FIFOSTA(pRx->Fifos[0].Fifo);
+  pRx->StatusSize    = (SPI_CANFD_C1FIFOUA(pRx->Fifos[pRx->FifoCount - 1u].Fifo) + sizeof(uint32_t)) - pRx->StatusAddress;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Drain the receive FIFOs
+//=============================================================================
+eERRORRESULT SPI_CANFDrx_Drain(SPI_CANFDrx* pRx, SPI_CANFDrxFrame* pFrames, size_t maxFrames, size_t* pCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pRx == NULL) || (pFrames == NULL) || (pCount == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  *pCount = 0;
+  if (pRx->FifoCount == 0) return ERR__NOT_INITIALIZED;
+  eERRORRESULT Error = SPI_CANFDrx_WaitWrites(pRx);                                                // The increments of the last drain shall be done before the status read
+  if (Error != ERR_NONE) return Error;
+  if (maxFrames > SPI_CANFD_MAX_BATCH) maxFrames = SPI_CANFD_MAX_BATCH;
+  pRx->DrainCount++;
+
+  //--- Status of all the receive FIFOs ---
+  Error = SPI_CANFDrx_ReadWords(pRx, pRx->StatusAddress, &pRx->Status[0], pRx->StatusSize / sizeof(uint32_t));
+  if (Error != ERR_NONE) return Error;
+
+  //--- Message objects ---
+  size_t Count = 0;
+  for (size_t zFifo = 0; zFifo < pRx->FifoCount; ++zFifo)
+  {
+    size_t FifoCount = 0;
+    Error = __SPI_CANFDrx_DrainFifo(pRx, &pRx->Fifos[zFifo], &pFrames[Count], maxFrames - Count, &FifoCount);
+    if (Error != ERR_NONE) break;                                                                  // The increments of the objects already read are written
+    Count += FifoCount;
+  }
+  *pCount = Count;
+  pRx->FrameCount += (uint32_t)Count;
+
+  //--- Increments of the message objects read and overflow clears ---
+  const eERRORRESULT WriteError = __SPI_CANFDrx_StartWrites(pRx);
+  return (Error != ERR_NONE ? Error : WriteError);
+}
+
+
+//=============================================================================
+// Wait for the end of the FIFO increments of the last drain
+//=============================================================================
+eERRORRESULT SPI_CANFDrx_WaitWrites(SPI_CANFDrx* pRx)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pRx == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  eERRORRESULT Error = ERR_NONE;
+  const uint32_t Start_ms = (pRx->fnGetCurrentms != NULL ? pRx->fnGetCurrentms() : 0u);
+  for (size_t zWrite = 0; zWrite < pRx->WriteCount; ++zWrite)
+  {
+    eERRORRESULT Result = ERR_NONE;
+    while (Interface_SPIisTransactionComplete(&pRx->Transactions[zWrite], &Result) == false)
+    {
+      if ((pRx->fnGetCurrentms != NULL) && ((pRx->fnGetCurrentms() - Start_ms) > SPI_CANFD_WRITES_TIMEOUT_ms)) return ERR__DEVICE_TIMEOUT; // The writes stay in progress
+      if (pRx->fnYield != NULL) pRx->fnYield();
+    }
+    if ((Result != ERR_NONE) && (Error == ERR_NONE)) Error = Result;
+  }
+  pRx->WriteCount = 0;
+  return Error;
+}
+
+
+//=============================================================================
+// Read words of the SFR or of the RAM of the controller
+//=============================================================================
+eERRORRESULT SPI_CANFDrx_ReadWords(SPI_CANFDrx* pRx, uint16_t address, uint32_t* pWords, size_t count)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pRx == NULL) || (pWords == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPIInterface_Segment Data = SPI_INTERFACE_RX_SEGMENT_WITH_DUMMYBYTE(0x00, pWords, count * sizeof(uint32_t), SPI_CANFD_WORD_ENDIAN);
+  pRx->Segments[1] = Data;
+  return __SPI_CANFDrx_ReadSegments(pRx, address, 2);
+}
+
+
+//=============================================================================
+// Reset the statistics of the receive engine
+//=============================================================================
+void SPI_CANFDrx_ResetStats(SPI_CANFDrx* pRx)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pRx == NULL) return;
+#endif
+  pRx->DrainCount     = 0;
+  pRx->FrameCount     = 0;
+  pRx->BurstCount     = 0;
+  pRx->IncrementCount = 0;
+  pRx->OverflowCount  = 0;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
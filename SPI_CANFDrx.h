@@ -0,0 +1,259 @@
+/*!*****************************************************************************
+ * @file    SPI_CANFDrx.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Batched receive FIFO drain engine for MCP251xFD CAN-FD controllers
+ * @details This receive engine drains the receive FIFOs of a MCP2517FD,
+ * MCP2518FD or MCP251863 through the SPI_Interface for all the
+ * https://github.com/Emandhal drivers and developments:
+ * - The status and user address of all the receive FIFOs are read with one
+ *   SPI burst
+ * - All the message objects available in a FIFO are read with one SPI burst
+ *   (two if the objects wrap around the end of the FIFO), directly in the
+ *   frames of the caller with a segment list. The RAM is only accessed by
+ *   4-bytes words
+ * - The FIFO increments (one UINC write per message object) are batched
+ *   after the reads and are given to the asynchronous transfers of the
+ *   interface if available
+ * The controller configuration (bit time, filters, FIFOs, operation mode) is
+ * not done by this engine
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_CANFDRX_H_INC
+#define __SPI_CANFDRX_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_CANFD_INSTRUCTION_RESET   ( 0x0u )    //!< SPI instruction: reset the controller
+#define SPI_CANFD_INSTRUCTION_WRITE   ( 0x2u )    //!< SPI instruction: write SFR or RAM
+#define SPI_CANFD_INSTRUCTION_READ    ( 0x3u )    //!< SPI instruction: read SFR or RAM
+#define SPI_CANFD_COMMAND_SIZE        ( 2u )      //!< Size of the instruction (4 bits) and address (12 bits)
+
+#define SPI_CANFD_RAM_ADDRESS         ( 0x400u )  //!< Address of the message RAM
+#define SPI_CANFD_RAM_SIZE            ( 2048u )   //!< Size of the message RAM
+#define SPI_CANFD_SFR_SIZE            ( 0x300u )  //!< Size of the CAN FD controller SFR area
+#define SPI_CANFD_FIFO_COUNT          ( 32u )     //!< Count of FIFOs, the FIFO 0 is the TXQ
+#define SPI_CANFD_MAX_BATCH           ( 32u )     //!< Max count of message objects drained by one call (the max depth of a FIFO)
+#define SPI_CANFD_MAX_WRITES          ( SPI_CANFD_MAX_BATCH + SPI_CANFD_FIFO_COUNT ) //!< Max count of writes queued by one drain: the FIFO increments and the overflow clears
+#define SPI_CANFD_STATUS_WORDS        ( (3u * (SPI_CANFD_FIFO_COUNT - 2u)) + 2u )   //!< Max size in words of the status burst, from the status register of FIFO 1 to the user address register of FIFO 31
+#define SPI_CANFD_WRITES_TIMEOUT_ms   ( 10u )     //!< Max time to wait for the FIFO increments of a drain
+
+#define SPI_CANFD_C1RXIF              ( 0x020u )  //!< Receive interrupt status register, one bit per FIFO not empty
+#define SPI_CANFD_C1RXOVIF            ( 0x028u )  //!< Receive overflow interrupt status register, one bit per FIFO
+#define SPI_CANFD_C1FIFOCON(fifo)     ( 0x050u + (12u * (fifo)) ) //!< FIFO control register of a FIFO
+#define SPI_CANFD_C1FIFOSTA(fifo)     ( 0x054u + (12u * (fifo)) ) //!< FIFO status register of a FIFO
+#define SPI_CANFD_C1FIFOUA(fifo)      ( 0x058u + (12u * (fifo)) ) //!< FIFO user address register of a FIFO (offset in the RAM)
+
+#define SPI_CANFD_FIFOCON_TSEN        ( 1u << 5 ) //!< FIFO control: time stamp of the received messages enabled
+#define SPI_CANFD_FIFOCON_TXEN        ( 1u << 7 ) //!< FIFO control: transmit FIFO
+#define SPI_CANFD_FIFOCON_UINC        ( 1u << 8 ) //!< FIFO control: increment the tail of the FIFO (one message object)
+#define SPI_CANFD_FIFOCON_FRESET      ( 1u << 10 ) //!< FIFO control: reset the FIFO, cleared by the controller at the end of the reset
+#define SPI_CANFD_FIFOCON_FSIZE_Pos   24
+#define SPI_CANFD_FIFOCON_FSIZE_Mask  ( 0x1Fu << SPI_CANFD_FIFOCON_FSIZE_Pos )
+#define SPI_CANFD_FIFOCON_FSIZE_SET(value)   (((uint32_t)(value) << SPI_CANFD_FIFOCON_FSIZE_Pos) & SPI_CANFD_FIFOCON_FSIZE_Mask) //!< Set the FIFO depth minus one
+#define SPI_CANFD_FIFOCON_FSIZE_GET(value)   (((uint32_t)(value) & SPI_CANFD_FIFOCON_FSIZE_Mask) >> SPI_CANFD_FIFOCON_FSIZE_Pos) //!< Get the FIFO depth minus one
+#define SPI_CANFD_FIFOCON_PLSIZE_Pos  29
+#define SPI_CANFD_FIFOCON_PLSIZE_Mask ( 0x7u << SPI_CANFD_FIFOCON_PLSIZE_Pos )
+#define SPI_CANFD_FIFOCON_PLSIZE_SET(value)  (((uint32_t)(value) << SPI_CANFD_FIFOCON_PLSIZE_Pos) & SPI_CANFD_FIFOCON_PLSIZE_Mask) //!< Set the payload size code (8, 12, 16, 20, 24, 32, 48, 64 bytes)
+#define SPI_CANFD_FIFOCON_PLSIZE_GET(value)  (((uint32_t)(value) & SPI_CANFD_FIFOCON_PLSIZE_Mask) >> SPI_CANFD_FIFOCON_PLSIZE_Pos) //!< Get the payload size code
+
+#define SPI_CANFD_FIFOSTA_TFNRFNIF    ( 1u << 0 ) //!< FIFO status: the receive FIFO is not empty
+#define SPI_CANFD_FIFOSTA_TFHRFHIF    ( 1u << 1 ) //!< FIFO status: the receive FIFO is at least half full
+#define SPI_CANFD_FIFOSTA_TFERFFIF    ( 1u << 2 ) //!< FIFO status: the receive FIFO is full
+#define SPI_CANFD_FIFOSTA_RXOVIF      ( 1u << 3 ) //!< FIFO status: a message was lost, the receive FIFO was full. Cleared by writing 0
+#define SPI_CANFD_FIFOSTA_FIFOCI_Pos  8
+#define SPI_CANFD_FIFOSTA_FIFOCI_Mask ( 0x1Fu << SPI_CANFD_FIFOSTA_FIFOCI_Pos )
+#define SPI_CANFD_FIFOSTA_FIFOCI_SET(value)  (((uint32_t)(value) << SPI_CANFD_FIFOSTA_FIFOCI_Pos) & SPI_CANFD_FIFOSTA_FIFOCI_Mask) //!< Set the index of the message object the receive FIFO will write next
+#define SPI_CANFD_FIFOSTA_FIFOCI_GET(value)  (((uint32_t)(value) & SPI_CANFD_FIFOSTA_FIFOCI_Mask) >> SPI_CANFD_FIFOSTA_FIFOCI_Pos) //!< Get the index of the message object the receive FIFO will write next
+
+#define SPI_CANFD_FRAME_SID_GET(identifier)  ((uint32_t)(identifier) & 0x7FFu)             //!< Get the standard identifier of a received message object
+#define SPI_CANFD_FRAME_EID_GET(identifier)  (((uint32_t)(identifier) >> 11) & 0x3FFFFu)   //!< Get the extended identifier of a received message object
+#define SPI_CANFD_FRAME_DLC_GET(flags)       ((uint32_t)(flags) & 0xFu)                    //!< Get the DLC of a received message object
+#define SPI_CANFD_FRAME_IDE                  ( 1u << 4 )                                   //!< Flags of a received message object: extended identifier
+#define SPI_CANFD_FRAME_RTR                  ( 1u << 5 )                                   //!< Flags of a received message object: remote frame
+#define SPI_CANFD_FRAME_BRS                  ( 1u << 6 )                                   //!< Flags of a received message object: bit rate switch
+#define SPI_CANFD_FRAME_FDF                  ( 1u << 7 )                                   //!< Flags of a received message object: CAN FD frame
+#define SPI_CANFD_FRAME_ESI                  ( 1u << 8 )                                   //!< Flags of a received message object: error status indicator
+#define SPI_CANFD_FRAME_FILHIT_GET(flags)    (((uint32_t)(flags) >> 11) & 0x1Fu)           //!< Get the filter that accepted a received message object
+
+//! Endian transform of the words of the controller. The controller is little-endian on the bus, the words are switched only on big-endian hosts
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#  define SPI_CANFD_WORD_ENDIAN  SPI_SWITCH_ENDIAN_32BITS
+#else
+#  define SPI_CANFD_WORD_ENDIAN  SPI_NO_ENDIAN_CHANGE
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// CAN FD receive engine
+//********************************************************************************************************************
+
+/*! @brief Function that gives the current time in milliseconds
+ *
+ * The value can wrap around, only the differences are used
+ */
+typedef uint32_t (*SPI_CANFDrxGetCurrentms_Func)(void);
+
+/*! @brief Function called while waiting for the FIFO increments
+ *
+ * This function should give the CPU to other threads or tasks (sched_yield(), taskYIELD(), osThreadYield()...)
+ */
+typedef void (*SPI_CANFDrxYield_Func)(void);
+
+
+//! @brief Frame received from a FIFO. The three words are the header of the message object, in host endianness
+typedef struct SPI_CANFDrxFrame
+{
+  uint32_t Identifier;  //!< Word 0 of the message object: SID, EID and SID11 (see #SPI_CANFD_FRAME_SID_GET and #SPI_CANFD_FRAME_EID_GET)
+  uint32_t Flags;       //!< Word 1 of the message object: DLC, IDE, RTR, BRS, FDF, ESI and FILHIT (see #SPI_CANFD_FRAME_DLC_GET)
+  uint32_t TimeStamp;   //!< Word 2 of the message object if the FIFO has the time stamp enabled, else 0
+  uint8_t Data[64];     //!< Payload of the message object (the payload size of the FIFO, whatever the DLC)
+  uint8_t Fifo;         //!< FIFO that received the frame
+} SPI_CANFDrxFrame;
+
+//! @brief Receive FIFO description, read from the controller at SPI_CANFDrx_Init()
+typedef struct SPI_CANFDrxFifo
+{
+  uint8_t Fifo;         //!< Index of the FIFO (1 to 31)
+  uint8_t Depth;        //!< Count of message objects of the FIFO
+  uint8_t HeaderSize;   //!< Size of the header of a message object (8, or 12 with the time stamp)
+  uint8_t PayloadSize;  //!< Size of the payload of a message object
+  uint16_t ObjectSize;  //!< Size of a message object
+  uint16_t Base;        //!< Address of the first message object of the FIFO
+} SPI_CANFDrxFifo;
+
+
+//! @brief CAN FD receive engine of a MCP251xFD
+typedef struct SPI_CANFDrx
+{
+  SPI_Interface* pSPI;                                               //!< SPI interface of the controller. The engine uses its asynchronous transfers if available
+  uint8_t ChipSelect;                                                //!< Chip Select index of the controller
+  uint32_t SCKfreq;                                                  //!< SCK frequency of the controller (max 0.85 * SYSCLK / 2)
+  uint32_t RxFifoMask;                                               //!< Receive FIFOs to drain, one bit per FIFO (bit 1 for FIFO 1...). The FIFOs shall be configured as receive FIFOs
+  SPI_CANFDrxGetCurrentms_Func fnGetCurrentms;                       //!< This function will be called to get the current time in milliseconds for the timeout of the FIFO increments. Can be NULL (no timeout)
+  SPI_CANFDrxYield_Func fnYield;                                     //!< This function will be called while waiting for the FIFO increments. Can be NULL (busy wait)
+  //--- Set by SPI_CANFDrx_Init() ---
+  SPI_CANFDrxFifo Fifos[SPI_CANFD_FIFO_COUNT - 1u];                  //!< Receive FIFOs, in the order of their index
+  size_t FifoCount;                                                  //!< Count of receive FIFOs
+  uint16_t StatusAddress;                                            //!< Address of the status burst (status register of the first FIFO)
+  size_t StatusSize;                                                 //!< Size of the status burst (up to the user address register of the last FIFO)
+  //--- Transfers ---
+  uint32_t Status[SPI_CANFD_STATUS_WORDS];                           //!< Status, user address (and control) registers of the FIFOs, read by the status burst
+  uint8_t Command[SPI_CANFD_COMMAND_SIZE];                           //!< Instruction and address of the burst in progress
+  SPIInterface_Segment Segments[1u + (2u * SPI_CANFD_MAX_BATCH)];    //!< Segments of a burst: the command, then the header and the payload of each message object
+  uint8_t Writes[SPI_CANFD_MAX_WRITES][SPI_CANFD_COMMAND_SIZE + 1u]; //!< FIFO increments and overflow clears, one byte written each
+  SPIInterface_Packet Packets[SPI_CANFD_MAX_WRITES];                 //!< Packets of the writes
+  SPIInterface_Transaction Transactions[SPI_CANFD_MAX_WRITES];       //!< Asynchronous transactions of the writes
+  size_t WriteCount;                                                 //!< Count of writes in progress
+  //--- Statistics ---
+  uint32_t DrainCount;                                               //!< Count of drains
+  uint32_t FrameCount;                                               //!< Count of frames received
+  uint32_t BurstCount;                                               //!< Count of message object bursts
+  uint32_t IncrementCount;                                           //!< Count of FIFO increments written
+  uint32_t OverflowCount;                                            //!< Count of FIFO overflows seen (RXOVIF)
+} SPI_CANFDrx;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// CAN FD receive engine functions
+//********************************************************************************************************************
+
+/*! @brief CAN FD receive engine initialization
+ *
+ * Set the SCK frequency, read the configuration of the receive FIFOs and reset them. The messages already received in these FIFOs are discarded
+ * The controller shall already be configured and in a normal or listen only mode
+ * @param[in] *pRx Is the receive engine to initialize. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum. #ERR__TOO_MANY_FIFO if the FIFO mask has the TXQ, #ERR__CONFIGURATION if a FIFO is a transmit FIFO
+ */
+eERRORRESULT SPI_CANFDrx_Init(SPI_CANFDrx* pRx);
+
+/*! @brief Drain the receive FIFOs
+ *
+ * Read the status of all the receive FIFOs with one burst, then the message objects available in each FIFO with one burst, in the order of the FIFOs index. Then the FIFO increments of the message objects read are written
+ * The FIFO increments are asynchronous if the interface has asynchronous transfers: they are waited by the next call, their errors are returned by the next call
+ * @param[in] *pRx Is the receive engine
+ * @param[out] *pFrames Is where the frames received will be stored
+ * @param[in] maxFrames Is the count of frames available in pFrames. Max #SPI_CANFD_MAX_BATCH frames are received per call
+ * @param[out] *pCount Is where the count of frames received will be stored
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_CANFDrx_Drain(SPI_CANFDrx* pRx, SPI_CANFDrxFrame* pFrames, size_t maxFrames, size_t* pCount);
+
+/*! @brief Wait for the end of the FIFO increments of the last drain
+ *
+ * SPI_CANFDrx.fnYield is called between two checks. The wait stops after #SPI_CANFD_WRITES_TIMEOUT_ms if SPI_CANFDrx.fnGetCurrentms is set, the writes still in progress are then waited again by the next call
+ * @param[in] *pRx Is the receive engine
+ * @return Returns an #eERRORRESULT value enum. #ERR__DEVICE_TIMEOUT if the writes are not complete after #SPI_CANFD_WRITES_TIMEOUT_ms
+ */
+eERRORRESULT SPI_CANFDrx_WaitWrites(SPI_CANFDrx* pRx);
+
+/*! @brief Read words of the SFR or of the RAM of the controller
+ *
+ * @param[in] *pRx Is the receive engine
+ * @param[in] address Is the address of the first word
+ * @param[out] *pWords Is where the words will be stored, in host endianness
+ * @param[in] count Is the count of words to read
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_CANFDrx_ReadWords(SPI_CANFDrx* pRx, uint16_t address, uint32_t* pWords, size_t count);
+
+/*! @brief Reset the statistics of the receive engine
+ *
+ * @param[in] *pRx Is the receive engine
+ */
+void SPI_CANFDrx_ResetStats(SPI_CANFDrx* pRx);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_CANFDRX_H_INC */
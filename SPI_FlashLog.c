@@ -0,0 +1,600 @@
+/*!*****************************************************************************
+ * @file    SPI_FlashLog.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Log-structured record storage for SPI NOR flashes
+ * @details This storage appends small records to a region of a SPI NOR flash
+ *          by whole page programs through the SPI_Interface for all the
+ *          https://github.com/Emandhal drivers and developments
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+//-----------------------------------------------------------------------------
+#include "SPI_FlashLog.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_FLASHLOG_WRITE_ENABLE_INSTRUCTION  ( 0x06u ) //!< Write enable instruction
+#define SPI_FLASHLOG_READ_STATUS_INSTRUCTION   ( 0x05u ) //!< Read status register instruction
+#define SPI_FLASHLOG_READ_INSTRUCTION          ( 0x03u ) //!< Read data instruction
+#define SPI_FLASHLOG_PAGE_PROGRAM_INSTRUCTION  ( 0x02u ) //!< Page program instruction
+#define SPI_FLASHLOG_SECTOR_ERASE_INSTRUCTION  ( 0x20u ) //!< Sector erase instruction
+#define SPI_FLASHLOG_STATUS_WIP                ( 0x01u ) //!< Write In Progress bit of the status register
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash log internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Get the flash address of a log position
+//=============================================================================
+static uint32_t __SPI_FlashLog_Address(const SPI_FlashLog* pLog, uint64_t pos)
+{
+  return pLog->StartAddress + (uint32_t)(pos % pLog->Size);
+}
+
+
+//=============================================================================
+// [STATIC] Get the page buffer data of a log position
+//=============================================================================
+static uint8_t* __SPI_FlashLog_PageData(const SPI_FlashLog* pLog, uint64_t pos)
+{
+  const size_t Index = (size_t)((pos / SPI_FLASHLOG_PAGE_SIZE) % pLog->PageBufferCount);
+  return &pLog->pPageBuffers[(Index * SPI_FLASHLOG_PAGE_BUFFER_SIZE) + SPI_FLASHLOG_COMMAND_SIZE];
+}
+
+
+//=============================================================================
+// [STATIC] Fill an instruction address (MSB first)
+//=============================================================================
+static void __SPI_FlashLog_SetAddress(const SPI_FlashLog* pLog, uint8_t* pDest, uint32_t address)
+{
+  for (size_t zIdx = 0; zIdx < pLog->AddressSize; ++zIdx)
+    pDest[zIdx] = (uint8_t)(address >> (8u * (pLog->AddressSize - 1u - zIdx)));
+}
+
+
+//=============================================================================
+// [STATIC] Start the asynchronous transfer of an instruction
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_Send(SPI_FlashLog* pLog, uint8_t* pTxData, uint8_t* pRxData, size_t size)
+{
+  pLog->Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+  pLog->Packet.ChipSelect   = pLog->ChipSelect;
+  pLog->Packet.DummyByte    = 0x00;
+  pLog->Packet.TxData       = pTxData;
+  pLog->Packet.RxData       = pRxData;
+  pLog->Packet.DataSize     = size;
+  pLog->Packet.Terminate    = true;
+  pLog->Packet.pCRC         = NULL;
+  pLog->Transaction.pPacketDesc = &pLog->Packet;
+  pLog->Transaction.fnComplete  = NULL;
+  pLog->Transaction.pContext    = pLog;
+  return Interface_SPItransferAsync(pLog->pSPI, &pLog->Transaction);
+}
+
+
+//=============================================================================
+// [STATIC] Start a program or an erase by its write enable instruction
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_StartOperation(SPI_FlashLog* pLog, bool isErase, uint64_t pos, uint64_t end)
+{
+  pLog->OpIsErase  = isErase;
+  pLog->OpPos      = pos;
+  pLog->OpEnd      = end;
+  pLog->Command[0] = SPI_FLASHLOG_WRITE_ENABLE_INSTRUCTION;
+  const eERRORRESULT Error = __SPI_FlashLog_Send(pLog, pLog->Command, NULL, 1u);
+  pLog->State = (Error == ERR_NONE ? SPI_FLASHLOG_WRITE_ENABLE : SPI_FLASHLOG_IDLE);
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Continue the operation in progress
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_Advance(SPI_FlashLog* pLog)
+{
+  eERRORRESULT Error = ERR_NONE;
+  if (pLog->State == SPI_FLASHLOG_IDLE) return ERR_NONE;
+  if (Interface_SPIisTransactionComplete(&pLog->Transaction, &Error) == false) return ERR_NONE; // The instruction is still in progress
+  if (Error != ERR_NONE)
+  {
+    pLog->State = SPI_FLASHLOG_IDLE;                                                               // The operation will be started again
+    return Error;
+  }
+
+  switch (pLog->State)
+  {
+    case SPI_FLASHLOG_WRITE_ENABLE:
+      if (pLog->OpIsErase)
+      {
+        pLog->Command[0] = SPI_FLASHLOG_SECTOR_ERASE_INSTRUCTION;
+        __SPI_FlashLog_SetAddress(pLog, &pLog->Command[1], __SPI_FlashLog_Address(pLog, pLog->OpPos));
+        Error = __SPI_FlashLog_Send(pLog, pLog->Command, NULL, 1u + pLog->AddressSize);
+      }
+      else
+      {
+        uint8_t* pData = __SPI_FlashLog_PageData(pLog, pLog->OpPos) + (pLog->OpPos % SPI_FLASHLOG_PAGE_SIZE);
+        uint8_t* pCmd  = pData - 1u - pLog->AddressSize;                                           // The instruction is written just before the data, over bytes already programmed or in the reserved room
+        pCmd[0] = SPI_FLASHLOG_PAGE_PROGRAM_INSTRUCTION;
+        __SPI_FlashLog_SetAddress(pLog, &pCmd[1], __SPI_FlashLog_Address(pLog, pLog->OpPos));
+        Error = __SPI_FlashLog_Send(pLog, pCmd, NULL, 1u + pLog->AddressSize + (size_t)(pLog->OpEnd - pLog->OpPos));
+      }
+      pLog->State = SPI_FLASHLOG_COMMAND;
+      break;
+
+    case SPI_FLASHLOG_COMMAND:
+    case SPI_FLASHLOG_POLLING:
+      if ((pLog->State == SPI_FLASHLOG_POLLING) && ((pLog->Command[1] & SPI_FLASHLOG_STATUS_WIP) == 0)) // End of the operation
+      {
+        if (pLog->OpIsErase)
+        {
+          if ((pLog->OpPos + SPI_FLASHLOG_SECTOR_SIZE) > pLog->ErasePos) pLog->ErasePos = pLog->OpPos + SPI_FLASHLOG_SECTOR_SIZE;
+        }
+        else pLog->ProgramPos = pLog->OpEnd;
+        pLog->State = SPI_FLASHLOG_IDLE;
+        return ERR_NONE;
+      }
+      pLog->Command[0] = SPI_FLASHLOG_READ_STATUS_INSTRUCTION;
+      pLog->Command[1] = 0x00;
+      Error = __SPI_FlashLog_Send(pLog, pLog->Command, pLog->Command, 2u);
+      pLog->StatusPollCount++;
+      pLog->State = SPI_FLASHLOG_POLLING;
+      break;
+
+    default: break;
+  }
+  if (Error != ERR_NONE) pLog->State = SPI_FLASHLOG_IDLE;
+  return Error;
+}
+
+
+//=============================================================================
+// [STATIC] Wait for the end of the operation in progress
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_WaitIdle(SPI_FlashLog* pLog)
+{
+  while (pLog->State != SPI_FLASHLOG_IDLE)
+  {
+    const eERRORRESULT Error = __SPI_FlashLog_Advance(pLog);
+    if (Error != ERR_NONE) return Error;
+    if ((pLog->State != SPI_FLASHLOG_IDLE) && (pLog->fnYield != NULL)) pLog->fnYield();
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Pass the gap at the end of a sector once the programs reach it
+//=============================================================================
+static void __SPI_FlashLog_SkipGap(SPI_FlashLog* pLog)
+{
+  if ((pLog->SkipTo > pLog->ProgramPos) && (pLog->ProgramPos >= pLog->SkipFrom)) pLog->ProgramPos = pLog->SkipTo;
+}
+
+
+//=============================================================================
+// [STATIC] Get the end of the data to program before the next gap
+//=============================================================================
+static uint64_t __SPI_FlashLog_DataEnd(const SPI_FlashLog* pLog)
+{
+  return (pLog->SkipTo > pLog->ProgramPos ? pLog->SkipFrom : pLog->WritePos);
+}
+
+
+//=============================================================================
+// [STATIC] Drop the index entries of the records of a sector about to be erased
+//=============================================================================
+static void __SPI_FlashLog_DropSector(SPI_FlashLog* pLog, uint32_t address)
+{
+  for (uint32_t zKey = 0; zKey < pLog->KeyCount; ++zKey)
+    if ((pLog->pIndex[zKey] != SPI_FLASHLOG_NO_RECORD) && (pLog->pIndex[zKey] >= address) && (pLog->pIndex[zKey] < (address + SPI_FLASHLOG_SECTOR_SIZE)))
+    {
+      pLog->pIndex[zKey] = SPI_FLASHLOG_NO_RECORD;
+      pLog->DroppedRecordCount++;
+    }
+}
+
+
+//=============================================================================
+// [STATIC] Start the next operation: page program first, then erase ahead
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_StartNext(SPI_FlashLog* pLog)
+{
+  __SPI_FlashLog_SkipGap(pLog);
+  const uint64_t PageEnd = ((pLog->ProgramPos / SPI_FLASHLOG_PAGE_SIZE) + 1u) * SPI_FLASHLOG_PAGE_SIZE;
+  uint64_t DataEnd = __SPI_FlashLog_DataEnd(pLog);
+  if (DataEnd > PageEnd) DataEnd = PageEnd;                                                        // A page program never crosses a page
+  const bool PageComplete = (pLog->WritePos >= PageEnd);                                           // By its data or by a gap
+  if ((DataEnd > pLog->ProgramPos) && (PageComplete || pLog->FlushRequested))
+  {
+    if (((pLog->ProgramPos / SPI_FLASHLOG_SECTOR_SIZE) * SPI_FLASHLOG_SECTOR_SIZE) < pLog->ErasePos)
+    {
+      pLog->ProgramCount++;
+      if ((DataEnd - pLog->ProgramPos) < SPI_FLASHLOG_PAGE_SIZE) pLog->PartialProgramCount++;
+      return __SPI_FlashLog_StartOperation(pLog, false, pLog->ProgramPos, DataEnd);
+    }
+    // The sector of the page is not erased yet, erase it first
+  }
+  else if (pLog->ErasePos >= (((pLog->WritePos / SPI_FLASHLOG_SECTOR_SIZE) + 1u + pLog->EraseAhead) * SPI_FLASHLOG_SECTOR_SIZE)) return ERR_NONE; // Nothing to do
+
+  //--- Erase the next sector ---
+  if (pLog->WritePos <= pLog->ErasePos) __SPI_FlashLog_DropSector(pLog, __SPI_FlashLog_Address(pLog, pLog->ErasePos)); // Else the old records were dropped when the writes entered the sector
+  pLog->EraseCount++;
+  return __SPI_FlashLog_StartOperation(pLog, true, pLog->ErasePos, pLog->ErasePos + SPI_FLASHLOG_SECTOR_SIZE);
+}
+
+
+//=============================================================================
+// [STATIC] Copy data to the page buffers
+//=============================================================================
+static void __SPI_FlashLog_WriteBuffers(SPI_FlashLog* pLog, uint64_t pos, const uint8_t* pData, size_t size)
+{
+  while (size > 0)
+  {
+    const size_t Offset = (size_t)(pos % SPI_FLASHLOG_PAGE_SIZE);
+    const size_t Count  = (size < (SPI_FLASHLOG_PAGE_SIZE - Offset) ? size : (SPI_FLASHLOG_PAGE_SIZE - Offset));
+    uint8_t* pPage = __SPI_FlashLog_PageData(pLog, pos);
+    if (Offset == 0) memset(pPage, 0xFF, SPI_FLASHLOG_PAGE_SIZE);                                 // New page, the bytes not written stay erased
+    memcpy(&pPage[Offset], pData, Count);
+    pos += Count; pData += Count; size -= Count;
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Read data from the flash. The flash shall be idle
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_ReadFlash(SPI_FlashLog* pLog, uint32_t address, uint8_t* pData, size_t size)
+{
+  uint8_t Header[1 + 4];
+  Header[0] = SPI_FLASHLOG_READ_INSTRUCTION;
+  __SPI_FlashLog_SetAddress(pLog, &Header[1], address);
+  SPIInterface_Packet Packet;
+  Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE);
+  Packet.ChipSelect   = pLog->ChipSelect;
+  Packet.DummyByte    = 0x00;
+  Packet.TxData       = Header;
+  Packet.RxData       = NULL;
+  Packet.DataSize     = 1u + pLog->AddressSize;
+  Packet.Terminate    = false;
+  Packet.pCRC         = NULL;
+  eERRORRESULT Error = pLog->pSPI->fnSPI_Transfer(pLog->pSPI, &Packet);                          // Send the instruction and the address
+  if (Error != ERR_NONE) return Error;
+  Packet.TxData    = NULL;
+  Packet.RxData    = pData;
+  Packet.DataSize  = size;
+  Packet.Terminate = true;
+  return pLog->pSPI->fnSPI_Transfer(pLog->pSPI, &Packet);                                         // Read the data
+}
+
+
+//=============================================================================
+// [STATIC] Read the sector header of a sector of the region
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_ReadSectorHeader(SPI_FlashLog* pLog, uint32_t sectorIndex, bool* pValid, uint16_t* pSeq)
+{
+  uint8_t Header[SPI_FLASHLOG_SECTOR_HEADER_SIZE];
+  const eERRORRESULT Error = __SPI_FlashLog_ReadFlash(pLog, pLog->StartAddress + (sectorIndex * SPI_FLASHLOG_SECTOR_SIZE), Header, sizeof(Header));
+  if (Error != ERR_NONE) return Error;
+  *pValid = (((uint16_t)Header[0] | ((uint16_t)Header[1] << 8)) == SPI_FLASHLOG_SECTOR_MAGIC);
+  *pSeq   = (uint16_t)Header[2] | ((uint16_t)Header[3] << 8);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Read data of the log from the flash or from the page buffers
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_ReadLog(SPI_FlashLog* pLog, uint64_t pos, uint8_t* pData, size_t size)
+{
+  eERRORRESULT Error;
+  if (pos < pLog->ProgramPos)
+  {
+    Error = __SPI_FlashLog_WaitIdle(pLog);                                                         // The flash can't be read during a program or an erase
+    if (Error != ERR_NONE) return Error;
+    const size_t Count = ((pLog->ProgramPos - pos) < size ? (size_t)(pLog->ProgramPos - pos) : size);
+    Error = __SPI_FlashLog_ReadFlash(pLog, __SPI_FlashLog_Address(pLog, pos), pData, Count);
+    if (Error != ERR_NONE) return Error;
+    pos += Count; pData += Count; size -= Count;
+  }
+  while (size > 0)                                                                                 // The rest is in the page buffers
+  {
+    const size_t Offset = (size_t)(pos % SPI_FLASHLOG_PAGE_SIZE);
+    const size_t Count  = (size < (SPI_FLASHLOG_PAGE_SIZE - Offset) ? size : (SPI_FLASHLOG_PAGE_SIZE - Offset));
+    memcpy(pData, __SPI_FlashLog_PageData(pLog, pos) + Offset, Count);
+    pos += Count; pData += Count; size -= Count;
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Check the configuration and reset the state of the flash log
+//=============================================================================
+static eERRORRESULT __SPI_FlashLog_Setup(SPI_FlashLog* pLog)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pLog == NULL) || (pLog->pSPI == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pLog->pPageBuffers == NULL) || (pLog->pIndex == NULL)) return ERR__NULL_BUFFER;
+  if (pLog->pSPI->fnSPI_Transfer == NULL) return ERR__SPI_CONFIG_ERROR;
+  if ((pLog->AddressSize < 3) || (pLog->AddressSize > 4)) return ERR__SPI_CONFIG_ERROR;
+  if ((pLog->PageBufferCount < 2) || (pLog->PageBufferCount > SPI_FLASHLOG_MAX_PAGE_BUFFERS)) return ERR__SPI_CONFIG_ERROR;
+  if ((pLog->KeyCount == 0) || (pLog->KeyCount > SPI_FLASHLOG_ERASED_KEY)) return ERR__SPI_CONFIG_ERROR;
+  if (((pLog->StartAddress % SPI_FLASHLOG_SECTOR_SIZE) != 0) || ((pLog->Size % SPI_FLASHLOG_SECTOR_SIZE) != 0)) return ERR__BAD_ADDRESS;
+  if ((pLog->EraseAhead == 0) || ((pLog->Size / SPI_FLASHLOG_SECTOR_SIZE) < (pLog->EraseAhead + 3u))) return ERR__SPI_CONFIG_ERROR;
+  const uint64_t AddressMax = (pLog->AddressSize == 3 ? 0x1000000ull : 0x100000000ull);
+  if (((uint64_t)pLog->StartAddress + pLog->Size) > AddressMax) return ERR__BAD_ADDRESS;
+  if (pLog->State != SPI_FLASHLOG_IDLE)
+  {
+    const eERRORRESULT Error = __SPI_FlashLog_WaitIdle(pLog);
+    if (Error != ERR_NONE) return Error;
+  }
+  for (uint32_t zKey = 0; zKey < pLog->KeyCount; ++zKey) pLog->pIndex[zKey] = SPI_FLASHLOG_NO_RECORD;
+  pLog->WritePos       = 0;
+  pLog->ProgramPos     = 0;
+  pLog->ErasePos       = 0;
+  pLog->SkipFrom       = 0;
+  pLog->SkipTo         = 0;
+  pLog->SeqOffset      = 0;
+  pLog->FlushRequested = false;
+  pLog->State          = SPI_FLASHLOG_IDLE;
+  Interface_SPIinitTransaction(&pLog->Transaction, &pLog->Packet, NULL, pLog);
+  pLog->RecordCount         = 0;
+  pLog->RecordBytes         = 0;
+  pLog->ProgramCount        = 0;
+  pLog->PartialProgramCount = 0;
+  pLog->EraseCount          = 0;
+  pLog->StatusPollCount     = 0;
+  pLog->BufferFullCount     = 0;
+  pLog->DroppedRecordCount  = 0;
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash log functions
+//********************************************************************************************************************
+//=============================================================================
+// Format the log region
+//=============================================================================
+eERRORRESULT SPI_FlashLog_Format(SPI_FlashLog* pLog)
+{
+  eERRORRESULT Error = __SPI_FlashLog_Setup(pLog);
+  if (Error != ERR_NONE) return Error;
+  for (uint64_t Pos = 0; Pos < pLog->Size; Pos += SPI_FLASHLOG_SECTOR_SIZE)
+  {
+    pLog->EraseCount++;
+    Error = __SPI_FlashLog_StartOperation(pLog, true, Pos, Pos + SPI_FLASHLOG_SECTOR_SIZE);
+    if (Error == ERR_NONE) Error = __SPI_FlashLog_WaitIdle(pLog);
+    if (Error != ERR_NONE) return Error;
+  }
+  pLog->ErasePos = pLog->Size;                                                                     // The whole region is erased
+  return ERR_NONE;
+}
+
+
+
+
+//=============================================================================
+// Mount the log of the region
+//=============================================================================
+eERRORRESULT SPI_FlashLog_Mount(SPI_FlashLog* pLog)
+{
+  eERRORRESULT Error = __SPI_FlashLog_Setup(pLog);
+  if (Error != ERR_NONE) return Error;
+  const uint32_t SectorCount = pLog->Size / SPI_FLASHLOG_SECTOR_SIZE;
+  bool Valid;
+  uint16_t Seq;
+
+  //--- Find the last sector written: a valid sector not followed by the next sequence number ---
+  bool FirstValid = false, PrevValid = false, Found = false;
+  uint16_t FirstSeq = 0, PrevSeq = 0, HeadSeq = 0;
+  uint32_t Head = 0;
+  for (uint32_t zSector = 0; zSector <= SectorCount; ++zSector)                                    // The first sector is checked again after the last one
+  {
+    if (zSector < SectorCount)
+    {
+      Error = __SPI_FlashLog_ReadSectorHeader(pLog, zSector, &Valid, &Seq);
+      if (Error != ERR_NONE) return Error;
+      if (zSector == 0) { FirstValid = Valid; FirstSeq = Seq; }
+    }
+    else { Valid = FirstValid; Seq = FirstSeq; }
+    if (PrevValid && ((Valid == false) || (Seq != (uint16_t)(PrevSeq + 1u))))
+    {
+      Found   = true;
+      Head    = zSector - 1u;
+      HeadSeq = PrevSeq;
+      break;
+    }
+    PrevValid = Valid;
+    PrevSeq   = Seq;
+  }
+  if (Found == false) return ERR_NONE;                                                             // Empty log, the sectors will be erased before use
+
+  //--- Scan the records from the oldest sector to the last one ---
+  const uint64_t HeadSector = (uint64_t)Head + SectorCount;                                        // Sector position of the last sector, the oldest sector is at position Head + 1
+  pLog->SeqOffset = (uint16_t)(HeadSeq - (uint16_t)HeadSector);
+  uint32_t HeadEnd = SPI_FLASHLOG_SECTOR_HEADER_SIZE;
+  for (uint64_t zSector = HeadSector + 1u - SectorCount; zSector <= HeadSector; ++zSector)
+  {
+    const uint32_t SectorIndex = (uint32_t)(zSector % SectorCount);
+    const uint32_t Address = pLog->StartAddress + (SectorIndex * SPI_FLASHLOG_SECTOR_SIZE);
+    Error = __SPI_FlashLog_ReadSectorHeader(pLog, SectorIndex, &Valid, &Seq);
+    if (Error != ERR_NONE) return Error;
+    if ((Valid == false) || (Seq != (uint16_t)(zSector + pLog->SeqOffset))) continue;              // Erased or older than the oldest sector
+    uint32_t Offset = SPI_FLASHLOG_SECTOR_HEADER_SIZE;
+    while ((Offset + SPI_FLASHLOG_RECORD_HEADER_SIZE) <= SPI_FLASHLOG_SECTOR_SIZE)
+    {
+      uint8_t Record[SPI_FLASHLOG_RECORD_HEADER_SIZE];
+      Error = __SPI_FlashLog_ReadFlash(pLog, Address + Offset, Record, sizeof(Record));
+      if (Error != ERR_NONE) return Error;
+      const uint16_t Key    = (uint16_t)Record[0] | ((uint16_t)Record[1] << 8);
+      const uint16_t Length = (uint16_t)Record[2] | ((uint16_t)Record[3] << 8);
+      if (Key == SPI_FLASHLOG_ERASED_KEY) break;                                                   // End of the records of the sector
+      if ((Offset + SPI_FLASHLOG_RECORD_HEADER_SIZE + Length) > SPI_FLASHLOG_SECTOR_SIZE) break;   // Corrupted record
+      if (Key < pLog->KeyCount) pLog->pIndex[Key] = Address + Offset;
+      Offset += SPI_FLASHLOG_RECORD_HEADER_SIZE + Length;
+    }
+    if (zSector == HeadSector) HeadEnd = Offset;
+  }
+
+  //--- Continue the log after the last record ---
+  pLog->WritePos   = (HeadSector * SPI_FLASHLOG_SECTOR_SIZE) + HeadEnd;
+  pLog->ProgramPos = pLog->WritePos;
+  pLog->ErasePos   = (HeadSector + 1u) * SPI_FLASHLOG_SECTOR_SIZE;                                 // The next sectors are erased again, an erase may have been interrupted
+  memset(__SPI_FlashLog_PageData(pLog, pLog->WritePos), 0xFF, SPI_FLASHLOG_PAGE_SIZE);            // The rest of the page is erased
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Append a record to the log
+//=============================================================================
+eERRORRESULT SPI_FlashLog_Append(SPI_FlashLog* pLog, uint32_t key, const uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pLog == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pData == NULL) && (size > 0)) return ERR__NULL_BUFFER;
+  if (key >= pLog->KeyCount) return ERR__OUT_OF_RANGE;
+  if (size > SPI_FLASHLOG_MAX_RECORD_SIZE(pLog->PageBufferCount)) return ERR__BAD_DATA_SIZE;
+  eERRORRESULT Error = SPI_FlashLog_Process(pLog);                                                 // Make room in the page buffers
+  if (Error != ERR_NONE) return Error;
+
+  //--- A record never crosses a sector, skip the end of the sector if it does not fit ---
+  uint64_t Pos = pLog->WritePos;
+  const size_t Offset = (size_t)(Pos % SPI_FLASHLOG_SECTOR_SIZE);
+  if ((Offset != 0) && ((Offset + SPI_FLASHLOG_RECORD_HEADER_SIZE + size) > SPI_FLASHLOG_SECTOR_SIZE))
+  {
+    if (pLog->SkipTo > pLog->ProgramPos) { pLog->BufferFullCount++; return ERR__BUFFER_FULL; }     // Only one gap at a time
+    pLog->SkipFrom = Pos;                                                                          // The gap completes the current page, it can be programmed
+    pLog->SkipTo   = Pos + (SPI_FLASHLOG_SECTOR_SIZE - Offset);
+    pLog->WritePos = pLog->SkipTo;
+    Pos = pLog->WritePos;
+    (void)SPI_FlashLog_Process(pLog);
+  }
+
+  //--- Check the room in the page buffers ---
+  const bool NewSector = ((Pos % SPI_FLASHLOG_SECTOR_SIZE) == 0);
+  const uint64_t End = Pos + (NewSector ? SPI_FLASHLOG_SECTOR_HEADER_SIZE : 0u) + SPI_FLASHLOG_RECORD_HEADER_SIZE + size;
+  const uint64_t Oldest = (pLog->ProgramPos / SPI_FLASHLOG_PAGE_SIZE) * SPI_FLASHLOG_PAGE_SIZE;   // Start of the oldest page buffer in use
+  if ((End - Oldest) > ((uint64_t)pLog->PageBufferCount * SPI_FLASHLOG_PAGE_SIZE))
+  {
+    pLog->BufferFullCount++;
+    return ERR__BUFFER_FULL;
+  }
+
+  //--- Copy the record ---
+  if (NewSector)
+  {
+    if (pLog->ErasePos <= Pos) __SPI_FlashLog_DropSector(pLog, __SPI_FlashLog_Address(pLog, Pos));  // The sector is not erased yet, its old records are lost from now on
+    const uint16_t SectorSeq = (uint16_t)((Pos / SPI_FLASHLOG_SECTOR_SIZE) + pLog->SeqOffset);
+    const uint8_t SectorHeader[SPI_FLASHLOG_SECTOR_HEADER_SIZE] = { (uint8_t)SPI_FLASHLOG_SECTOR_MAGIC, (uint8_t)(SPI_FLASHLOG_SECTOR_MAGIC >> 8), (uint8_t)SectorSeq, (uint8_t)(SectorSeq >> 8) };
+    __SPI_FlashLog_WriteBuffers(pLog, Pos, SectorHeader, sizeof(SectorHeader));
+    Pos += SPI_FLASHLOG_SECTOR_HEADER_SIZE;
+  }
+  const uint8_t RecordHeader[SPI_FLASHLOG_RECORD_HEADER_SIZE] = { (uint8_t)key, (uint8_t)(key >> 8), (uint8_t)size, (uint8_t)(size >> 8) };
+  __SPI_FlashLog_WriteBuffers(pLog, Pos, RecordHeader, sizeof(RecordHeader));
+  __SPI_FlashLog_WriteBuffers(pLog, Pos + SPI_FLASHLOG_RECORD_HEADER_SIZE, pData, size);
+  pLog->pIndex[key] = __SPI_FlashLog_Address(pLog, Pos);
+  pLog->WritePos = End;
+  pLog->RecordCount++;
+  pLog->RecordBytes += size;
+  return SPI_FlashLog_Process(pLog);                                                               // Start the program if a page is complete
+}
+
+
+//=============================================================================
+// Read the last record of a key
+//=============================================================================
+eERRORRESULT SPI_FlashLog_Read(SPI_FlashLog* pLog, uint32_t key, uint8_t* pData, size_t size, size_t* pRecordSize)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pLog == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pData == NULL) && (size > 0)) return ERR__NULL_BUFFER;
+  if (key >= pLog->KeyCount) return ERR__OUT_OF_RANGE;
+  if (pLog->pIndex[key] == SPI_FLASHLOG_NO_RECORD) return ERR__NOT_FOUND;
+
+  //--- Get the log position of the record, it is less than one region behind the write position ---
+  const uint32_t WriteOffset  = (uint32_t)(pLog->WritePos % pLog->Size);
+  const uint32_t RecordOffset = pLog->pIndex[key] - pLog->StartAddress;
+  const uint32_t Behind = (WriteOffset >= RecordOffset ? WriteOffset - RecordOffset : (pLog->Size - RecordOffset) + WriteOffset);
+  const uint64_t Pos = pLog->WritePos - Behind;
+
+  //--- Read the record ---
+  uint8_t RecordHeader[SPI_FLASHLOG_RECORD_HEADER_SIZE];
+  eERRORRESULT Error = __SPI_FlashLog_ReadLog(pLog, Pos, RecordHeader, sizeof(RecordHeader));
+  if (Error != ERR_NONE) return Error;
+  const size_t Length = (size_t)RecordHeader[2] | ((size_t)RecordHeader[3] << 8);
+  if (pRecordSize != NULL) *pRecordSize = Length;
+  Error = __SPI_FlashLog_ReadLog(pLog, Pos + SPI_FLASHLOG_RECORD_HEADER_SIZE, pData, (Length < size ? Length : size));
+  if (Error != ERR_NONE) return Error;
+  return (Length > size ? ERR__NOT_ENOUGH_SPACE : ERR_NONE);
+}
+
+
+//=============================================================================
+// Run the operations of the flash log
+//=============================================================================
+eERRORRESULT SPI_FlashLog_Process(SPI_FlashLog* pLog)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pLog == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  const eERRORRESULT Error = __SPI_FlashLog_Advance(pLog);
+  if (Error != ERR_NONE) return Error;
+  if (pLog->State != SPI_FLASHLOG_IDLE) return ERR_NONE;                                           // Wait for the end of the operation in progress
+  return __SPI_FlashLog_StartNext(pLog);
+}
+
+
+//=============================================================================
+// Program all the data of the page buffers
+//=============================================================================
+eERRORRESULT SPI_FlashLog_Flush(SPI_FlashLog* pLog)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pLog == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  eERRORRESULT Error;
+  pLog->FlushRequested = true;
+  while (true)
+  {
+    Error = SPI_FlashLog_Process(pLog);
+    if (Error != ERR_NONE) break;
+    __SPI_FlashLog_SkipGap(pLog);
+    if (((pLog->State == SPI_FLASHLOG_IDLE) || pLog->OpIsErase) && (__SPI_FlashLog_DataEnd(pLog) <= pLog->ProgramPos)) break; // An erase ahead can go on
+    if (pLog->fnYield != NULL) pLog->fnYield();
+  }
+  pLog->FlushRequested = false;
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,219 @@
+/*!*****************************************************************************
+ * @file    SPI_FlashLog.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Log-structured record storage for SPI NOR flashes
+ * @details This storage appends small records to a region of a SPI NOR flash
+ * through the SPI_Interface for all the https://github.com/Emandhal drivers
+ * and developments. The region is used as a circular log:
+ * - The records are appended to page buffers in RAM, and a page is programmed
+ *   with one page program instruction once full (or at a flush)
+ * - The programs, the erases and the status polling are asynchronous
+ *   transactions run by SPI_FlashLog_Process(), the caller never waits for the
+ *   flash while there is room in the page buffers
+ * - The sectors are erased ahead of the write position. When the log wraps
+ *   around, the oldest sector is erased and its records are lost
+ * - A RAM index gives the flash address of the last record of each key
+ * Each sector starts with a sector header (magic and sequence number), each
+ * record is a record header (key and size, little endian) followed by its
+ * data. A record never crosses a sector boundary
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_FLASHLOG_H_INC
+#define __SPI_FLASHLOG_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_FLASHLOG_PAGE_SIZE           ( 256u )     //!< Page size of the page program instruction
+#define SPI_FLASHLOG_SECTOR_SIZE         ( 4096u )    //!< Size erased by the sector erase instruction
+#define SPI_FLASHLOG_COMMAND_SIZE        ( 8u )       //!< Room reserved before each page buffer for the page program instruction and its address
+#define SPI_FLASHLOG_PAGE_BUFFER_SIZE    ( SPI_FLASHLOG_COMMAND_SIZE + SPI_FLASHLOG_PAGE_SIZE ) //!< Size of a page buffer
+
+#define SPI_FLASHLOG_SECTOR_MAGIC        ( 0x474Cu )  //!< Magic of the sector header ("LG")
+#define SPI_FLASHLOG_SECTOR_HEADER_SIZE  ( 4u )       //!< Size of the sector header (magic and sequence number)
+#define SPI_FLASHLOG_RECORD_HEADER_SIZE  ( 4u )       //!< Size of the record header (key and size)
+#define SPI_FLASHLOG_MAX_PAGE_BUFFERS    ( SPI_FLASHLOG_SECTOR_SIZE / SPI_FLASHLOG_PAGE_SIZE ) //!< Max count of page buffers
+#define SPI_FLASHLOG_NO_RECORD           ( 0xFFFFFFFFu ) //!< Index value of a key without record
+#define SPI_FLASHLOG_ERASED_KEY          ( 0xFFFFu )  //!< Key of an erased record header, marks the end of the records of a sector
+
+//! Max size of the data of a record for a count of page buffers. A record with its headers shall fit in the page buffers after the last partial page
+#define SPI_FLASHLOG_MAX_RECORD_SIZE(pageBufferCount)  ( (((pageBufferCount) - 1u) * SPI_FLASHLOG_PAGE_SIZE) - SPI_FLASHLOG_SECTOR_HEADER_SIZE - SPI_FLASHLOG_RECORD_HEADER_SIZE )
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash log
+//********************************************************************************************************************
+
+//! Operation state of the flash log enum
+typedef enum
+{
+  SPI_FLASHLOG_IDLE         = 0x0u, //!< No operation in progress
+  SPI_FLASHLOG_WRITE_ENABLE = 0x1u, //!< The write enable instruction of the operation is in progress
+  SPI_FLASHLOG_COMMAND      = 0x2u, //!< The program or erase instruction is in progress
+  SPI_FLASHLOG_POLLING      = 0x3u, //!< The status is polled until the end of the program or erase
+} eSPI_FlashLogState;
+
+/*! @brief Function called while waiting for the flash
+ *
+ * This function should give the CPU to other threads or tasks (sched_yield(), taskYIELD(), osThreadYield()...)
+ */
+typedef void (*SPI_FlashLogYield_Func)(void);
+
+
+//! @brief SPI NOR flash log. All the arrays are given by the user
+typedef struct SPI_FlashLog
+{
+  SPI_Interface* pSPI;                  //!< SPI interface of the flash. The log uses its asynchronous transfers if available
+  uint8_t ChipSelect;                   //!< Chip Select index of the flash
+  uint8_t AddressSize;                  //!< Address size of the instructions in bytes (3 or 4)
+  uint32_t StartAddress;                //!< Start address of the log region in the flash. Shall be sector aligned
+  uint32_t Size;                        //!< Size of the log region. Shall be a multiple of the sector size, with at least EraseAhead + 3 sectors
+  uint32_t EraseAhead;                  //!< Count of sectors kept erased ahead of the sector of the write position (at least 1)
+  uint8_t* pPageBuffers;                //!< Page buffers (PageBufferCount * #SPI_FLASHLOG_PAGE_BUFFER_SIZE bytes)
+  size_t PageBufferCount;               //!< Count of page buffers (2 to #SPI_FLASHLOG_MAX_PAGE_BUFFERS)
+  uint32_t* pIndex;                     //!< Flash address of the last record of each key (KeyCount values). #SPI_FLASHLOG_NO_RECORD if the key has no record
+  uint32_t KeyCount;                    //!< Count of keys (up to #SPI_FLASHLOG_ERASED_KEY)
+  SPI_FlashLogYield_Func fnYield;       //!< This function will be called while waiting for the flash. Can be NULL (busy wait)
+  //--- Log state (positions in the log, they increase forever and wrap around the region) ---
+  uint64_t WritePos;                    //!< Position of the next byte to append
+  uint64_t ProgramPos;                  //!< Position up to which the data are programmed in the flash. The data from there to WritePos are in the page buffers
+  uint64_t ErasePos;                    //!< Position up to which the sectors are erased
+  uint64_t SkipFrom;                    //!< Start of the gap at the end of a sector, left erased because the next record did not fit
+  uint64_t SkipTo;                      //!< End of the gap. Greater than ProgramPos while the gap is not reached by the programs
+  uint16_t SeqOffset;                   //!< Sequence number of a sector minus its sector position
+  bool FlushRequested;                  //!< 'true' to program the page buffers even if not full
+  //--- Operation in progress ---
+  eSPI_FlashLogState State;             //!< State of the operation in progress
+  bool OpIsErase;                       //!< 'true' if the operation is a sector erase, 'false' if it is a page program
+  uint64_t OpPos;                       //!< Position of the start of the program, or of the sector to erase
+  uint64_t OpEnd;                       //!< Position of the end of the program
+  uint8_t Command[8];                   //!< Buffer of the write enable, erase and status instructions
+  SPIInterface_Packet Packet;           //!< Packet of the instruction in progress
+  SPIInterface_Transaction Transaction; //!< Asynchronous transaction of the packet
+  //--- Statistics ---
+  uint32_t RecordCount;                 //!< Count of records appended
+  uint64_t RecordBytes;                 //!< Count of data bytes of the records appended
+  uint32_t ProgramCount;                //!< Count of page program instructions
+  uint32_t PartialProgramCount;         //!< Count of page program instructions of a partial page (flush, end of sector)
+  uint32_t EraseCount;                  //!< Count of sector erase instructions
+  uint32_t StatusPollCount;             //!< Count of status reads
+  uint32_t BufferFullCount;             //!< Count of appends refused because the page buffers were full
+  uint32_t DroppedRecordCount;          //!< Count of index entries dropped by the erase of their sector
+} SPI_FlashLog;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash log functions
+//********************************************************************************************************************
+
+/*! @brief Format the log region
+ *
+ * Check the configuration, erase all the sectors of the region and start an empty log. This is blocking
+ * @param[in] *pLog Is the flash log to format. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_FlashLog_Format(SPI_FlashLog* pLog);
+
+/*! @brief Mount the log of the region
+ *
+ * Check the configuration, find the last sector written with the sector headers and rebuild the index by scanning the records of all the sectors. This is blocking
+ * A region without valid sector header is mounted as an empty log, its sectors are erased before use
+ * @param[in] *pLog Is the flash log to mount. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_FlashLog_Mount(SPI_FlashLog* pLog);
+
+/*! @brief Append a record to the log
+ *
+ * The record is copied to the page buffers and the index is updated. This function runs SPI_FlashLog_Process() but never waits for the flash
+ * @param[in] *pLog Is the flash log
+ * @param[in] key Is the key of the record (less than KeyCount)
+ * @param[in] *pData Is the data of the record
+ * @param[in] size Is the size of the data (up to SPI_FLASHLOG_MAX_RECORD_SIZE(PageBufferCount))
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUFFER_FULL if there is no room in the page buffers, call SPI_FlashLog_Process() and try again
+ */
+eERRORRESULT SPI_FlashLog_Append(SPI_FlashLog* pLog, uint32_t key, const uint8_t* pData, size_t size);
+
+/*! @brief Read the last record of a key
+ *
+ * The data still in the page buffers are copied from RAM, the others are read from the flash (this waits for the end of the operation in progress)
+ * @param[in] *pLog Is the flash log
+ * @param[in] key Is the key of the record
+ * @param[out] *pData Is where the data of the record will be stored
+ * @param[in] size Is the size of the data buffer
+ * @param[out] *pRecordSize Is where the size of the record will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum. #ERR__NOT_FOUND if the key has no record, #ERR__NOT_ENOUGH_SPACE if the record is bigger than the data buffer (the data buffer is filled)
+ */
+eERRORRESULT SPI_FlashLog_Read(SPI_FlashLog* pLog, uint32_t key, uint8_t* pData, size_t size, size_t* pRecordSize);
+
+/*! @brief Run the operations of the flash log
+ *
+ * Check the transaction in progress and start the next one: write enable, page program of a full page buffer, sector erase ahead of the write position and status polling. This never waits for the flash
+ * Call this function regularly (main loop, timer task...)
+ * @param[in] *pLog Is the flash log
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_FlashLog_Process(SPI_FlashLog* pLog);
+
+/*! @brief Program all the data of the page buffers
+ *
+ * The partial pages are programmed too. This waits for the end of the programs
+ * @param[in] *pLog Is the flash log
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_FlashLog_Flush(SPI_FlashLog* pLog);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_FLASHLOG_H_INC */
@@ -0,0 +1,249 @@
+/*!*****************************************************************************
+ * @file    SPI_FlashStream.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Read-ahead streaming reader of SPI NOR flashes
+ * @details This reader streams a large sequential region of a SPI NOR flash
+ *          through the asynchronous transfers of the SPI_Interface for all the
+ *          https://github.com/Emandhal drivers and developments
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "SPI_FlashStream.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash streaming reader internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Get the buffer of a slot
+//=============================================================================
+static uint8_t* __SPI_FlashStream_Buffer(SPI_FlashStream* pStream, size_t index)
+{
+  return &pStream->pBuffers[index * SPI_FLASHSTREAM_BUFFER_SIZE(pStream->ChunkSize)];
+}
+
+
+//=============================================================================
+// [STATIC] Queue the next chunks of the read instruction in the free buffers
+//=============================================================================
+static void __SPI_FlashStream_Queue(SPI_FlashStream* pStream)
+{
+  const size_t HeaderSize = 1u + pStream->AddressSize + pStream->DummyBytes;
+  while ((pStream->InFlight < pStream->BufferCount) && (pStream->NextAddress < pStream->EndAddress) && (pStream->StreamError == ERR_NONE))
+  {
+    SPI_FlashStreamSlot* pSlot = &pStream->pSlots[pStream->QueueIndex];
+    uint8_t* pData = __SPI_FlashStream_Buffer(pStream, pStream->QueueIndex) + SPI_FLASHSTREAM_HEADER_SIZE;
+    const uint32_t Remaining = pStream->EndAddress - pStream->NextAddress;
+    pSlot->Address = pStream->NextAddress;
+    pSlot->Size    = (Remaining < pStream->ChunkSize ? Remaining : pStream->ChunkSize);
+    pSlot->Packet.Config.Value = SPI_USE_NON_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) | SPI_USE_DUMMYBYTE_FOR_RECEIVE;
+    pSlot->Packet.ChipSelect   = pStream->ChipSelect;
+    pSlot->Packet.DummyByte    = 0x00;
+    pSlot->Packet.TxData       = NULL;                                                             // The next chunks continue the read instruction in progress
+    pSlot->Packet.RxData       = pData;
+    pSlot->Packet.DataSize     = pSlot->Size;
+    pSlot->Packet.Terminate    = (pSlot->Size == Remaining);                                      // The ChipSelect stays asserted until the last chunk of the region
+    pSlot->Packet.pCRC         = NULL;
+
+    //--- The first chunk sends the read instruction ---
+    if (pStream->Selected == false)
+    {
+      uint8_t* pHeader = pData - HeaderSize;                                                       // The header is just before the data, the data stay aligned in the buffer
+      pHeader[0] = pStream->ReadInstruction;
+      for (size_t zIdx = 0; zIdx < pStream->AddressSize; ++zIdx)                                // Address MSB first
+        pHeader[1 + zIdx] = (uint8_t)(pStream->NextAddress >> (8u * (pStream->AddressSize - 1u - zIdx)));
+      for (size_t zIdx = 1u + pStream->AddressSize; zIdx < HeaderSize; ++zIdx) pHeader[zIdx] = 0x00;
+      pSlot->Packet.Config.Value &= ~SPI_USE_DUMMYBYTE_FOR_RECEIVE;
+      pSlot->Packet.TxData        = pHeader;                                                       // The header and the chunk are received in place, the flash ignores the bytes sent after the header
+      pSlot->Packet.RxData        = pHeader;
+      pSlot->Packet.DataSize      = HeaderSize + pSlot->Size;
+    }
+
+    //--- Queue the chunk ---
+    pSlot->Transaction.pPacketDesc = &pSlot->Packet;
+    pSlot->Transaction.fnComplete  = NULL;
+    pSlot->Transaction.pContext    = pStream;
+    const eERRORRESULT Error = Interface_SPItransferAsync(pStream->pSPI, &pSlot->Transaction);
+    if (Error != ERR_NONE)
+    {
+      pStream->QueueError = Error;                                                                 // Try again at the next chunk
+      return;
+    }
+    pStream->Selected = (pSlot->Packet.Terminate == false);
+    pStream->NextAddress += pSlot->Size;
+    pStream->QueueIndex = (pStream->QueueIndex + 1u) % pStream->BufferCount;
+    pStream->InFlight++;
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Wait for the end of the transaction of a slot
+//=============================================================================
+static eERRORRESULT __SPI_FlashStream_Wait(SPI_FlashStream* pStream, SPI_FlashStreamSlot* pSlot)
+{
+  eERRORRESULT Result = ERR_NONE;
+  if (pSlot->Transaction.Status != SPI_TRANSACTION_PENDING) return pSlot->Transaction.Result;
+  while (Interface_SPIisTransactionComplete(&pSlot->Transaction, &Result) == false)
+    if (pStream->fnYield != NULL) pStream->fnYield();
+  return Result;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash streaming reader functions
+//********************************************************************************************************************
+//=============================================================================
+// SPI NOR flash streaming reader initialization
+//=============================================================================
+eERRORRESULT SPI_FlashStream_Init(SPI_FlashStream* pStream)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pStream == NULL) || (pStream->pSPI == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pStream->pBuffers == NULL) || (pStream->pSlots == NULL)) return ERR__NULL_BUFFER;
+  if ((pStream->BufferCount < 2) || (pStream->ChunkSize == 0)) return ERR__SPI_CONFIG_ERROR;
+  if ((pStream->AddressSize < 3) || (pStream->AddressSize > 4)) return ERR__SPI_CONFIG_ERROR;
+  if ((1u + pStream->AddressSize + pStream->DummyBytes) > SPI_FLASHSTREAM_HEADER_SIZE) return ERR__SPI_CONFIG_ERROR;
+  for (size_t zIdx = 0; zIdx < pStream->BufferCount; ++zIdx) Interface_SPIinitTransaction(&pStream->pSlots[zIdx].Transaction, &pStream->pSlots[zIdx].Packet, NULL, pStream);
+  pStream->NextAddress = 0;
+  pStream->EndAddress  = 0;
+  pStream->QueueIndex  = 0;
+  pStream->ReadIndex   = 0;
+  pStream->InFlight    = 0;
+  pStream->HasCurrent  = false;
+  pStream->Selected    = false;
+  pStream->QueueError  = ERR_NONE;
+  pStream->StreamError = ERR_NONE;
+  SPI_FlashStream_ResetStats(pStream);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Start streaming a region of the flash
+//=============================================================================
+eERRORRESULT SPI_FlashStream_Start(SPI_FlashStream* pStream, uint32_t address, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pStream == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pStream->InFlight > 0) || pStream->Selected) return ERR__SPI_BUSY;
+  if (size > (size_t)(UINT32_MAX - address)) return ERR__BAD_ADDRESS;
+  pStream->NextAddress = address;
+  pStream->EndAddress  = address + (uint32_t)size;
+  pStream->QueueIndex  = 0;
+  pStream->ReadIndex   = 0;
+  pStream->HasCurrent  = false;
+  pStream->QueueError  = ERR_NONE;
+  pStream->StreamError = ERR_NONE;
+  __SPI_FlashStream_Queue(pStream);
+  if ((pStream->InFlight == 0) && (size > 0)) return pStream->QueueError;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Get the next chunk of the stream
+//=============================================================================
+eERRORRESULT SPI_FlashStream_NextChunk(SPI_FlashStream* pStream, const uint8_t** ppData, size_t* pSize)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pStream == NULL) || (ppData == NULL) || (pSize == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pStream->HasCurrent)                                                                         // Release the previous chunk, its buffer is queued again
+  {
+    pStream->HasCurrent = false;
+    pStream->InFlight--;
+  }
+  if (pStream->StreamError != ERR_NONE) return pStream->StreamError;                             // The chunks after a failed one are not valid
+  __SPI_FlashStream_Queue(pStream);
+  if (pStream->InFlight == 0) return (pStream->NextAddress < pStream->EndAddress ? pStream->QueueError : ERR__NO_DATA_AVAILABLE);
+
+  //--- Wait for the oldest chunk ---
+  SPI_FlashStreamSlot* pSlot = &pStream->pSlots[pStream->ReadIndex];
+  if (pSlot->Transaction.Status == SPI_TRANSACTION_PENDING) pStream->StallCount++;                // The consumer is faster than the bus
+  const eERRORRESULT Error = __SPI_FlashStream_Wait(pStream, pSlot);
+  *ppData = __SPI_FlashStream_Buffer(pStream, pStream->ReadIndex) + SPI_FLASHSTREAM_HEADER_SIZE;
+  *pSize  = pSlot->Size;
+  pStream->ReadIndex  = (pStream->ReadIndex + 1u) % pStream->BufferCount;
+  pStream->HasCurrent = true;                                                                      // Even in case of error, the buffer is released at the next call
+  if (Error != ERR_NONE)
+  {
+    pStream->StreamError = Error;                                                                  // The read instruction can't be continued
+    return Error;
+  }
+  pStream->ChunkCount++;
+  pStream->ByteCount += pSlot->Size;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Stop the stream
+//=============================================================================
+void SPI_FlashStream_Stop(SPI_FlashStream* pStream)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pStream == NULL) return;
+#endif
+  for (size_t zIdx = 0; zIdx < pStream->BufferCount; ++zIdx)                                      // The queued transactions can't be canceled
+    (void)__SPI_FlashStream_Wait(pStream, &pStream->pSlots[zIdx]);
+  if (pStream->Selected)                                                                           // The region was not read to its end, release the ChipSelect with a last byte
+  {
+    SPI_FlashStreamSlot* pSlot = &pStream->pSlots[0];
+    pSlot->Packet.Config.Value = SPI_USE_NON_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) | SPI_USE_DUMMYBYTE_FOR_RECEIVE;
+    pSlot->Packet.TxData       = NULL;
+    pSlot->Packet.RxData       = NULL;
+    pSlot->Packet.DataSize     = 1;
+    pSlot->Packet.Terminate    = true;
+    if (Interface_SPItransferAsync(pStream->pSPI, &pSlot->Transaction) == ERR_NONE) (void)__SPI_FlashStream_Wait(pStream, pSlot);
+    pStream->Selected = false;
+  }
+  pStream->NextAddress = 0;
+  pStream->EndAddress  = 0;
+  pStream->QueueIndex  = 0;
+  pStream->ReadIndex   = 0;
+  pStream->InFlight    = 0;
+  pStream->HasCurrent  = false;
+}
+
+
+//=============================================================================
+// Reset the statistics of the streaming reader
+//=============================================================================
+void SPI_FlashStream_ResetStats(SPI_FlashStream* pStream)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pStream == NULL) return;
+#endif
+  pStream->ChunkCount = 0;
+  pStream->ByteCount  = 0;
+  pStream->StallCount = 0;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
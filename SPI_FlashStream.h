@@ -0,0 +1,182 @@
+/*!*****************************************************************************
+ * @file    SPI_FlashStream.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Read-ahead streaming reader of SPI NOR flashes
+ * @details This reader streams a large sequential region of a SPI NOR flash
+ * through the asynchronous transfers of the SPI_Interface for all the
+ * https://github.com/Emandhal drivers and developments. The region is read by
+ * chunks in their own buffers, with one read instruction: the first chunk sends
+ * the instruction and each next chunk continues the read, the ChipSelect stays
+ * asserted until the last chunk of the region:
+ * - Up to BufferCount chunks are in flight as non-blocking packets, the next
+ *   chunks are transferred while the consumer processes the current chunk
+ * - The consumer pulls the chunks in order with SPI_FlashStream_NextChunk()
+ * - Without asynchronous support, the chunks are read when they are queued and
+ *   the reader works as a blocking double buffered reader
+ * - The bus belongs to the stream until the end of the region or
+ *   SPI_FlashStream_Stop(), the other devices of the bus can't be used meanwhile
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_FLASHSTREAM_H_INC
+#define __SPI_FLASHSTREAM_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_FLASHSTREAM_HEADER_SIZE  ( 16u ) //!< Room reserved before the data of each buffer for the instruction, the address and the dummy bytes
+
+//! Size of a buffer of the streaming reader for a chunk size. The data of the chunks start at SPI_FLASHSTREAM_HEADER_SIZE in each buffer
+#define SPI_FLASHSTREAM_BUFFER_SIZE(chunkSize)  ( SPI_FLASHSTREAM_HEADER_SIZE + (chunkSize) )
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash streaming reader
+//********************************************************************************************************************
+
+/*! @brief Function called by the consumer while waiting for a chunk
+ *
+ * This function should give the CPU to other threads or tasks (sched_yield(), taskYIELD(), osThreadYield()...)
+ */
+typedef void (*SPI_FlashStreamYield_Func)(void);
+
+
+//! @brief Buffer of a chunk of the streaming reader
+typedef struct SPI_FlashStreamSlot
+{
+  SPIInterface_Packet Packet;           //!< Packet of the chunk, with the read instruction for the first chunk of the region
+  SPIInterface_Transaction Transaction; //!< Asynchronous transaction of the packet
+  uint32_t Address;                     //!< Address of the chunk in the flash
+  size_t Size;                          //!< Size of the chunk
+} SPI_FlashStreamSlot;
+
+
+//! @brief SPI NOR flash streaming reader. All the arrays are given by the user
+typedef struct SPI_FlashStream
+{
+  SPI_Interface* pSPI;                 //!< SPI interface of the flash. The reader uses its asynchronous transfers if available
+  uint8_t ChipSelect;                  //!< Chip Select index of the flash
+  uint8_t ReadInstruction;             //!< Standard SPI read instruction of the flash (ex: 0x03 read, 0x0B fast read)
+  uint8_t AddressSize;                 //!< Address size of the read instruction in bytes (3 or 4)
+  uint8_t DummyBytes;                  //!< Count of dummy bytes of the read instruction (ex: 0 for 0x03, 1 for 0x0B)
+  size_t ChunkSize;                    //!< Size of the data of a chunk
+  uint8_t* pBuffers;                   //!< Buffers of the chunks (BufferCount * SPI_FLASHSTREAM_BUFFER_SIZE(ChunkSize) bytes)
+  SPI_FlashStreamSlot* pSlots;         //!< Descriptions of the buffers (BufferCount values)
+  size_t BufferCount;                  //!< Count of buffers, at least 2
+  SPI_FlashStreamYield_Func fnYield;   //!< This function will be called while waiting for a chunk. Can be NULL (busy wait)
+  //--- Stream state ---
+  uint32_t NextAddress;                //!< Address of the next chunk to queue
+  uint32_t EndAddress;                 //!< Address of the end of the region
+  size_t QueueIndex;                   //!< Index of the next buffer to queue
+  size_t ReadIndex;                    //!< Index of the next buffer to give to the consumer
+  size_t InFlight;                     //!< Count of buffers queued and not released by the consumer
+  bool HasCurrent;                     //!< 'true' if a chunk is in the hands of the consumer
+  bool Selected;                       //!< 'true' while the ChipSelect is left asserted by the last chunk queued, the next chunk continues the read instruction
+  eERRORRESULT QueueError;             //!< Error of the last queuing that failed
+  eERRORRESULT StreamError;            //!< Transfer error of a chunk, the next chunks of the read instruction are not valid
+  //--- Statistics ---
+  uint32_t ChunkCount;                 //!< Count of chunks given to the consumer
+  uint64_t ByteCount;                  //!< Count of data bytes given to the consumer
+  uint32_t StallCount;                 //!< Count of chunks that were not ready when the consumer asked for them
+} SPI_FlashStream;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI NOR flash streaming reader functions
+//********************************************************************************************************************
+
+/*! @brief SPI NOR flash streaming reader initialization
+ *
+ * Check the configuration and reset the statistics. The SPI interface shall already be initialized
+ * @param[in] *pStream Is the streaming reader to initialize. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_FlashStream_Init(SPI_FlashStream* pStream);
+
+/*! @brief Start streaming a region of the flash
+ *
+ * The read instruction and the first chunks are queued immediately
+ * @param[in] *pStream Is the streaming reader
+ * @param[in] address Is the address of the region to stream
+ * @param[in] size Is the size of the region to stream
+ * @return Returns an #eERRORRESULT value enum. #ERR__SPI_BUSY if a stream is already in progress
+ */
+eERRORRESULT SPI_FlashStream_Start(SPI_FlashStream* pStream, uint32_t address, size_t size);
+
+/*! @brief Get the next chunk of the stream
+ *
+ * The previous chunk is released and its buffer is queued again for the next chunk to read, then this function waits for the next chunk
+ * The data of the chunk stays valid until the next call of SPI_FlashStream_NextChunk() or SPI_FlashStream_Stop()
+ * @param[in] *pStream Is the streaming reader
+ * @param[out] **ppData Is where the pointer to the data of the chunk will be stored
+ * @param[out] *pSize Is where the size of the chunk will be stored
+ * @return Returns an #eERRORRESULT value enum. #ERR__NO_DATA_AVAILABLE at the end of the region, or the transfer error of the chunk. After a transfer error, the next calls return it until SPI_FlashStream_Stop()
+ */
+eERRORRESULT SPI_FlashStream_NextChunk(SPI_FlashStream* pStream, const uint8_t** ppData, size_t* pSize);
+
+/*! @brief Stop the stream
+ *
+ * Wait for the end of the chunks already queued and release the ChipSelect if the region was not read to its end, then the buffers can be reused
+ * @param[in] *pStream Is the streaming reader
+ */
+void SPI_FlashStream_Stop(SPI_FlashStream* pStream);
+
+/*! @brief Reset the statistics of the streaming reader
+ *
+ * @param[in] *pStream Is the streaming reader
+ */
+void SPI_FlashStream_ResetStats(SPI_FlashStream* pStream);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_FLASHSTREAM_H_INC */
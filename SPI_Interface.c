@@ -1,8 +1,8 @@
 /*!*****************************************************************************
  * @file    SPI_Interface.c
  * @author  Fabien 'Emandhal' MAILLY
- * @version 1.1.1
- * @date    18/11/2023
+ * @version 1.8.0
+ * @date    16/10/2026
  * @brief   SPI interface for drivers
  * @details This SPI interface that can be used to communicate with devices
  *          for all the https://github.com/Emandhal drivers and developments.
@@ -10,13 +10,22 @@
  ******************************************************************************/
 
 /* Revision history:
+ * 1.8.0    Add the phase transfer of Dual/Quad-SPI memories
+ * 1.7.0    Add CRC computation and check of the packets
+ * 1.6.0    Add per ChipSelect settings, the STM32 peripheral is reconfigured only on device change
+ * 1.5.0    Send the dummy byte without transmit buffer
+ * 1.4.0    Add scatter-gather segment lists, fix Arduino transfer
+ * 1.3.0    Use the shared endian transform engine
+ * 1.2.0    Add asynchronous transfer with completion
  * 1.1.1    Add STM32cubeIDE
  * 1.1.0    Add Arduino
  * 1.0.0    Release version
  *****************************************************************************/
 
 //-----------------------------------------------------------------------------
+#include <string.h>
 #include "SPI_Interface.h"
+#include "EndianTransform.h"
 #include "ErrorsDef.h"
 //-----------------------------------------------------------------------------
 #ifdef __cplusplus
@@ -36,6 +45,26 @@ extern "C" {
 // SPI Interface initialization implementations
 //********************************************************************************************************************
 #ifdef ARDUINO
+//=============================================================================
+// [STATIC] Find the settings of a ChipSelect pin with Arduino. If not found and asked, a free entry is returned
+//=============================================================================
+static SPIInterface_ChipSettings* __Interface_SPIgetChip(SPI_Interface *pIntDev, uint8_t chipSelect, bool getFree)
+{
+  SPIInterface_ChipSettings* pFree = NULL;
+  for (size_t zChip = 0; zChip < SPI_INTERFACE_CHIPSELECT_COUNT; ++zChip)
+  {
+    SPIInterface_ChipSettings* pChip = &pIntDev->_Chips[zChip];
+    if (pChip->Configured == false)
+    {
+      if (pFree == NULL) pFree = pChip;
+      continue;
+    }
+    if (pChip->ChipSelect == chipSelect) return pChip;
+  }
+  return (getFree ? pFree : NULL);
+}
+
+
 //=============================================================================
 // Function for SPI driver initialization with Arduino
 //=============================================================================
@@ -45,8 +74,19 @@ eERRORRESULT Interface_SPIinit(SPI_Interface *pIntDev, uint8_t chipSelect, eSPII
   if (pIntDev == NULL) return ERR__SPI_PARAMETER_ERROR;
 #endif
 
-  if (SPI_PIN_COUNT_GET(mode) > 1u) return ERR__NOT_SUPPORTED;
+  if (SPI_PIN_COUNT_GET(mode) > 1u) return ERR__NOT_SUPPORTED;                      // The SPIClass has no Dual/Quad lines
+  const uint8_t BitCount = (SPI_DATA_BITCOUNT_GET(mode) == 0 ? 8u : SPI_DATA_BITCOUNT_GET(mode)); // Only stored, the SPIClass transfers bytes
+  Interface_SPIendTransaction(pIntDev);                                           // The settings of the open transaction may change
   pIntDev->_SPIsettings = SPISettings(sckFreq, (SPI_IS_LSB_FIRST(mode) ? LSBFIRST : MSBFIRST), SPI_MODE_GET(mode));
+  //--- Store the settings of the device ---
+  SPIInterface_ChipSettings* pChip = __Interface_SPIgetChip(pIntDev, chipSelect, true);
+  if (pChip == NULL) return ERR_NONE;                                              // Table full, this device will use the last _SPIsettings
+  pChip->ChipSelect   = chipSelect;
+  pChip->Mode         = mode;
+  pChip->SCKfreq      = sckFreq;
+  pChip->BitCount     = BitCount;
+  pChip->_SPIsettings = pIntDev->_SPIsettings;
+  pChip->Configured   = true;
   return ERR_NONE;
 }
 #endif // #ifdef ARDUINO
@@ -64,10 +104,33 @@ eERRORRESULT Interface_SPIinit(SPI_Interface *pIntDev, uint8_t chipSelect, eSPII
   if (pIntDev == NULL) return ERR__SPI_PARAMETER_ERROR;
 #endif
 
-  (void)pIntDev;
-  (void)chipSelect;
-  (void)mode;
-  (void)sckFreq;
+  static const uint32_t BaudRatePrescalers[] =
+  {
+    SPI_BAUDRATEPRESCALER_2,  SPI_BAUDRATEPRESCALER_4,  SPI_BAUDRATEPRESCALER_8,   SPI_BAUDRATEPRESCALER_16,
+    SPI_BAUDRATEPRESCALER_32, SPI_BAUDRATEPRESCALER_64, SPI_BAUDRATEPRESCALER_128, SPI_BAUDRATEPRESCALER_256,
+  };
+  if (chipSelect >= SPI_INTERFACE_CHIPSELECT_COUNT) return ERR_NONE;              // Not in the table, the transfers use the peripheral as is
+  if (SPI_PIN_COUNT_GET(mode) > 1u) return ERR__NOT_SUPPORTED;
+  const uint8_t BitCount = (SPI_DATA_BITCOUNT_GET(mode) == 0 ? 8u : SPI_DATA_BITCOUNT_GET(mode));
+  SPIInterface_ChipSettings* pChip = &pIntDev->Chips[chipSelect];
+
+  //--- Compute the baud rate prescaler ---
+  if (pIntDev->SPIclock > 0)
+  {
+    if (sckFreq == 0) return ERR__SPI_FREQUENCY_ERROR;
+    size_t zPrescaler = 0;
+    while ((pIntDev->SPIclock >> (zPrescaler + 1)) > sckFreq)                        // Search the highest SCK frequency not above sckFreq
+      if (++zPrescaler >= (sizeof(BaudRatePrescalers) / sizeof(BaudRatePrescalers[0]))) return ERR__SPI_FREQUENCY_ERROR;
+    pChip->BaudRatePrescaler = BaudRatePrescalers[zPrescaler];
+  }
+  else pChip->BaudRatePrescaler = pIntDev->pHSPI->Init.BaudRatePrescaler;          // Peripheral clock unknown, keep the prescaler configured by STM32cubeMX
+
+  //--- Store the settings of the device ---
+  pChip->Mode          = mode;
+  pChip->SCKfreq       = sckFreq;
+  pChip->BitCount      = BitCount;
+  pChip->Configured    = true;
+  pIntDev->CurrentChip = 0xFF;                                                     // Force the peripheral configuration at next transfer
   return ERR_NONE;
 }
 #endif // #ifdef USE_HAL_DRIVER // STM32cubeIDE
@@ -82,6 +145,66 @@ eERRORRESULT Interface_SPIinit(SPI_Interface *pIntDev, uint8_t chipSelect, eSPII
 // SPI Interface transfer implementations
 //********************************************************************************************************************
 #ifdef ARDUINO
+//=============================================================================
+// [STATIC] Begin the SPI transaction of a device with Arduino, only if the open transaction has other settings
+//=============================================================================
+static void __Interface_SPIbeginTransaction(SPI_Interface *pIntDev, uint8_t chipSelect)
+{
+  const SPIInterface_ChipSettings* pChip = __Interface_SPIgetChip(pIntDev, chipSelect, false);
+  const SPISettings* pSettings = (pChip != NULL ? &pChip->_SPIsettings : &pIntDev->_SPIsettings);
+  if (pIntDev->_pCurrentSettings == pSettings) return;                           // Same device settings, the transaction is still open
+  if (pIntDev->_pCurrentSettings != NULL) pIntDev->_SPIclass.endTransaction();
+  pIntDev->_SPIclass.beginTransaction(*pSettings);
+  pIntDev->_pCurrentSettings = pSettings;
+}
+
+
+//=============================================================================
+// [STATIC] End the SPI transaction with Arduino after a terminate, unless it is kept open
+//=============================================================================
+static void __Interface_SPIterminateTransaction(SPI_Interface *pIntDev)
+{
+#if (SPI_INTERFACE_ARDUINO_KEEP_TRANSACTION == 0)
+  Interface_SPIendTransaction(pIntDev);
+#else
+  (void)pIntDev;                                                                  // Restarted only when the device changes
+#endif
+}
+
+
+//=============================================================================
+// End the SPI transaction kept open with Arduino
+//=============================================================================
+void Interface_SPIendTransaction(SPI_Interface *pIntDev)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pIntDev == NULL) return;
+#endif
+  if (pIntDev->_pCurrentSettings == NULL) return;
+  pIntDev->_SPIclass.endTransaction();
+  pIntDev->_pCurrentSettings = NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Transfer a data block with Arduino, the DummyByte is sent without transmit buffer
+//=============================================================================
+static void __Interface_SPItransferData(SPI_Interface *pIntDev, const uint8_t* txData, uint8_t* rxData, size_t size, bool useDummyByte, uint8_t dummyByte)
+{
+  if (useDummyByte && (rxData != NULL))
+  { // The dummy bytes are sent from the receive buffer, each byte is sent before being overwritten by the received one
+    memset(rxData, dummyByte, size);
+    pIntDev->_SPIclass.transfer(rxData, size);
+    return;
+  }
+  for (size_t zIdx = 0; zIdx < size; ++zIdx)
+  {
+    uint8_t RxValue = pIntDev->_SPIclass.transfer(useDummyByte ? dummyByte : txData[zIdx]);
+    if (rxData != NULL) rxData[zIdx] = RxValue;
+  }
+}
+
+
 //=============================================================================
 // Function for SPI transfer with Arduino
 //=============================================================================
@@ -91,7 +214,7 @@ eERRORRESULT Interface_SPItransfer(SPI_Interface *pIntDev, SPIInterface_Packet*
   if ((pIntDev == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
 #endif
 
-  pIntDev->aSPI.beginTransaction(pIntDev->SPISettings);
+  __Interface_SPIbeginTransaction(pIntDev, pPacketDesc->ChipSelect);                // The transaction stays open over the packets of a ChipSelect assertion
   //--- Disable interrupts ---
   if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pPacketDesc->Config.Value))
   {
@@ -102,12 +225,9 @@ eERRORRESULT Interface_SPItransfer(SPI_Interface *pIntDev, SPIInterface_Packet*
 # endif
   }
   //--- SPI transfer ---
+  const bool UseDummyByte = (pPacketDesc->Config.Bits.UseDummyByte > 0) || (pPacketDesc->TxData == NULL);
   digitalWrite(pPacketDesc->ChipSelect, LOW); // Set CS at low level
-  for (size_t zIdx = 0; zIdx < size; ++zIdx)
-  {
-    uint8_t RxValue = pIntDev->aSPI.transfer(pPacketDesc->TxData[zIdx]);
-    if (pPacketDesc->RxData != NULL) pPacketDesc->RxData[zIdx] = RxValue;
-  }
+  __Interface_SPItransferData(pIntDev, pPacketDesc->TxData, pPacketDesc->RxData, pPacketDesc->DataSize, UseDummyByte, pPacketDesc->DummyByte);
   if (pPacketDesc->Terminate)
   {
     digitalWrite(pPacketDesc->ChipSelect, HIGH); // Set CS at high level
@@ -120,8 +240,62 @@ eERRORRESULT Interface_SPItransfer(SPI_Interface *pIntDev, SPIInterface_Packet*
       interrupts();
 # endif
     }
+    __Interface_SPIterminateTransaction(pIntDev);
+  }
+  eERRORRESULT Error = Interface_SPIpacketCRC(pPacketDesc);
+  if (Error != ERR_NONE) return Error;
+  return Interface_SPIendianTransform(pPacketDesc);
+}
+
+
+//=============================================================================
+// Function for SPI scatter-gather transfer with Arduino
+//=============================================================================
+eERRORRESULT Interface_SPItransferSegmentListNative(SPI_Interface *pIntDev, SPIInterface_SegmentList* const pSegmentList)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pSegmentList == NULL)) return ERR__SPI_PARAMETER_ERROR;
+  if ((pSegmentList->pSegments == NULL) && (pSegmentList->SegmentCount > 0)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+
+  __Interface_SPIbeginTransaction(pIntDev, pSegmentList->ChipSelect);                // The transaction stays open until a terminate
+  //--- Disable interrupts ---
+  if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pSegmentList->Config.Value))
+  {
+# ifdef ARDUINO_ARCH_ESP32
+    taskDISABLE_INTERRUPTS();
+# else
+    noInterrupts();
+# endif
+  }
+  //--- SPI transfer of all segments ---
+  digitalWrite(pSegmentList->ChipSelect, LOW); // Set CS at low level
+  for (size_t zSeg = 0; zSeg < pSegmentList->SegmentCount; ++zSeg)
+  {
+    const SPIInterface_Segment* pSegment = &pSegmentList->pSegments[zSeg];
+    const bool UseDummyByte = (pSegment->Config.Bits.UseDummyByte > 0) || (pSegment->TxData == NULL);
+    __Interface_SPItransferData(pIntDev, pSegment->TxData, pSegment->RxData, pSegment->DataSize, UseDummyByte, pSegment->DummyByte);
+  }
+  if (pSegmentList->Terminate)
+  {
+    digitalWrite(pSegmentList->ChipSelect, HIGH); // Set CS at high level
+    //--- Enable interrupts ---
+    if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pSegmentList->Config.Value))
+    {
+# ifdef ARDUINO_ARCH_ESP32
+      taskENABLE_INTERRUPTS();
+# else
+      interrupts();
+# endif
+    }
+    __Interface_SPIterminateTransaction(pIntDev);
+  }
+  //--- Endian transform of each segment ---
+  for (size_t zSeg = 0; zSeg < pSegmentList->SegmentCount; ++zSeg)
+  {
+    eERRORRESULT Error = Interface_SPIsegmentEndianTransform(&pSegmentList->pSegments[zSeg]);
+    if (Error != ERR_NONE) return Error;
   }
-  pIntDev->aSPI.endTransaction();
   return ERR_NONE;
 }
 #endif // #ifdef ARDUINO
@@ -130,6 +304,72 @@ eERRORRESULT Interface_SPItransfer(SPI_Interface *pIntDev, SPIInterface_Packet*
 
 
 #ifdef USE_HAL_DRIVER // STM32cubeIDE
+//=============================================================================
+// [STATIC] Select a device with STM32cubeIDE, the peripheral is reconfigured only when the device changes
+//=============================================================================
+static HAL_StatusTypeDef __Interface_SPIselectChip(SPI_Interface *pIntDev, uint8_t chipSelect, GPIO_TypeDef** ppGPIOx, uint16_t* pGPIOpin)
+{
+  *ppGPIOx  = pIntDev->pGPIOx;
+  *pGPIOpin = pIntDev->GPIOpin;
+  if (chipSelect >= SPI_INTERFACE_CHIPSELECT_COUNT) return HAL_OK;                // Not in the table, use the peripheral as is
+  const SPIInterface_ChipSettings* pChip = &pIntDev->Chips[chipSelect];
+  if (pChip->pGPIOx != NULL)
+  {
+    *ppGPIOx  = pChip->pGPIOx;
+    *pGPIOpin = pChip->GPIOpin;
+  }
+  if ((pChip->Configured == false) || (pIntDev->CurrentChip == chipSelect)) return HAL_OK;
+
+  //--- Device change, write the peripheral configuration only if different ---
+  SPI_InitTypeDef* pInit = &pIntDev->pHSPI->Init;
+  const uint32_t CLKPolarity = (SPI_CPOL_GET(pChip->Mode) > 0 ? SPI_POLARITY_HIGH : SPI_POLARITY_LOW);
+  const uint32_t CLKPhase    = (SPI_CPHA_GET(pChip->Mode) > 0 ? SPI_PHASE_2EDGE : SPI_PHASE_1EDGE);
+  const uint32_t FirstBit    = (SPI_IS_LSB_FIRST(pChip->Mode) ? SPI_FIRSTBIT_LSB : SPI_FIRSTBIT_MSB);
+  const uint32_t DataSize    = (pChip->BitCount > 8u ? SPI_DATASIZE_16BIT : SPI_DATASIZE_8BIT);
+  pIntDev->CurrentChip = chipSelect;
+  if ((pInit->CLKPolarity == CLKPolarity) && (pInit->CLKPhase == CLKPhase) && (pInit->FirstBit == FirstBit)
+   && (pInit->DataSize == DataSize) && (pInit->BaudRatePrescaler == pChip->BaudRatePrescaler)) return HAL_OK;
+  pInit->CLKPolarity       = CLKPolarity;
+  pInit->CLKPhase          = CLKPhase;
+  pInit->FirstBit          = FirstBit;
+  pInit->DataSize          = DataSize;
+  pInit->BaudRatePrescaler = pChip->BaudRatePrescaler;
+  const HAL_StatusTypeDef HALstatus = HAL_SPI_Init(pIntDev->pHSPI);
+  if (HALstatus != HAL_OK) pIntDev->CurrentChip = 0xFF;                           // Unknown configuration, retry at next transfer
+  return HALstatus;
+}
+
+
+//=============================================================================
+// [STATIC] Transfer a data block with STM32cubeIDE, the DummyByte is sent without transmit buffer
+//=============================================================================
+static HAL_StatusTypeDef __Interface_SPItransferData(SPI_Interface *pIntDev, uint8_t* txData, uint8_t* rxData, size_t size, bool useDummyByte, uint8_t dummyByte)
+{
+  if (size == 0) return HAL_OK;
+  const size_t FrameShift = (pIntDev->pHSPI->Init.DataSize == SPI_DATASIZE_16BIT ? 1u : 0u); // The HAL counts 16-bits frames
+  if (useDummyByte == false)
+  {
+    if (rxData != NULL) return HAL_SPI_TransmitReceive(pIntDev->pHSPI, txData, rxData, size >> FrameShift, pIntDev->SPItimeout);
+    return HAL_SPI_Transmit(pIntDev->pHSPI, txData, size >> FrameShift, pIntDev->SPItimeout);
+  }
+  if (rxData != NULL)
+  { // The dummy bytes are sent from the receive buffer, each byte is sent before being overwritten by the received one
+    memset(rxData, dummyByte, size);
+    return HAL_SPI_TransmitReceive(pIntDev->pHSPI, rxData, rxData, size >> FrameShift, pIntDev->SPItimeout);
+  }
+  //--- Dummy bytes only, send a small repeated buffer ---
+  HAL_StatusTypeDef HALstatus = HAL_OK;
+  uint8_t DummyBytes[16];
+  memset(&DummyBytes[0], dummyByte, sizeof(DummyBytes));
+  for (size_t zIdx = 0; (zIdx < size) && (HALstatus == HAL_OK); zIdx += sizeof(DummyBytes))
+  {
+    const size_t Size = ((size - zIdx) > sizeof(DummyBytes) ? sizeof(DummyBytes) : (size - zIdx));
+    HALstatus = HAL_SPI_Transmit(pIntDev->pHSPI, &DummyBytes[0], Size >> FrameShift, pIntDev->SPItimeout);
+  }
+  return HALstatus;
+}
+
+
 //=============================================================================
 // Function for SPI transfer with STM32cubeIDE
 //=============================================================================
@@ -139,27 +379,431 @@ eERRORRESULT Interface_SPItransfer(SPI_Interface *pIntDev, SPIInterface_Packet*
   if ((pIntDev == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
 #endif
 
-  HAL_StatusTypeDef HALstatus;
+  const bool UseDummyByte = (pPacketDesc->Config.Bits.UseDummyByte > 0) || (pPacketDesc->TxData == NULL);
+  GPIO_TypeDef* pGPIOx;
+  uint16_t GPIOpin;
+  HAL_StatusTypeDef HALstatus = __Interface_SPIselectChip(pIntDev, pPacketDesc->ChipSelect, &pGPIOx, &GPIOpin);
+  if (HALstatus != HAL_OK) return ERR__SPI_CONFIG_ERROR;
   if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pPacketDesc->Config.Value)) __disable_irq();  // Disable IRQ if asked
-  HAL_GPIO_WritePin(pIntDev->pGPIOx, pIntDev->GPIOpin, GPIO_PIN_RESET);                 // Clear CS pin
+  HAL_GPIO_WritePin(pGPIOx, GPIOpin, GPIO_PIN_RESET);                                   // Clear CS pin
   //--- Transfer data ---
-  if (pPacketDesc->RxData != NULL)
-       HALstatus = HAL_SPI_TransmitReceive(pIntDev->pHSPI, pPacketDesc->TxData, pPacketDesc->RxData, pPacketDesc->DataSize, pIntDev->SPItimeout);
-  else HALstatus = HAL_SPI_Transmit(pIntDev->pHSPI, pPacketDesc->TxData, pPacketDesc->DataSize, pIntDev->SPItimeout);
+  HALstatus = __Interface_SPItransferData(pIntDev, pPacketDesc->TxData, pPacketDesc->RxData, pPacketDesc->DataSize, UseDummyByte, pPacketDesc->DummyByte);
   if (pPacketDesc->Terminate || (HALstatus != HAL_OK))                                  // If terminate or transfer error...
   {
-    HAL_GPIO_WritePin(pIntDev->pGPIOx, pIntDev->GPIOpin, GPIO_PIN_SET);                 // Set CS pin
+    HAL_GPIO_WritePin(pGPIOx, GPIOpin, GPIO_PIN_SET);                                   // Set CS pin
     if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pPacketDesc->Config.Value)) __enable_irq(); // Enable IRQ if asked
   }
   //--- Check for errors ---
   if (HALstatus == HAL_ERROR  ) return ERR__SPI_COMM_ERROR;
   if (HALstatus == HAL_BUSY   ) return ERR__SPI_BUSY;
   if (HALstatus == HAL_TIMEOUT) return ERR__SPI_TIMEOUT;
+  eERRORRESULT Error = Interface_SPIpacketCRC(pPacketDesc);
+  if (Error != ERR_NONE) return Error;
+  return Interface_SPIendianTransform(pPacketDesc);
+}
+
+
+//=============================================================================
+// Function for SPI scatter-gather transfer with STM32cubeIDE
+//=============================================================================
+eERRORRESULT Interface_SPItransferSegmentListNative(SPI_Interface *pIntDev, SPIInterface_SegmentList* const pSegmentList)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pSegmentList == NULL)) return ERR__SPI_PARAMETER_ERROR;
+  if ((pSegmentList->pSegments == NULL) && (pSegmentList->SegmentCount > 0)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+
+  GPIO_TypeDef* pGPIOx;
+  uint16_t GPIOpin;
+  HAL_StatusTypeDef HALstatus = __Interface_SPIselectChip(pIntDev, pSegmentList->ChipSelect, &pGPIOx, &GPIOpin);
+  if (HALstatus != HAL_OK) return ERR__SPI_CONFIG_ERROR;
+  if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pSegmentList->Config.Value)) __disable_irq();  // Disable IRQ if asked
+  HAL_GPIO_WritePin(pGPIOx, GPIOpin, GPIO_PIN_RESET);                                    // Clear CS pin
+  //--- Transfer all segments ---
+  for (size_t zSeg = 0; (zSeg < pSegmentList->SegmentCount) && (HALstatus == HAL_OK); ++zSeg)
+  {
+    SPIInterface_Segment* pSegment = &pSegmentList->pSegments[zSeg];
+    const bool UseDummyByte = (pSegment->Config.Bits.UseDummyByte > 0) || (pSegment->TxData == NULL);
+    HALstatus = __Interface_SPItransferData(pIntDev, pSegment->TxData, pSegment->RxData, pSegment->DataSize, UseDummyByte, pSegment->DummyByte);
+  }
+  if (pSegmentList->Terminate || (HALstatus != HAL_OK))                                  // If terminate or transfer error...
+  {
+    HAL_GPIO_WritePin(pGPIOx, GPIOpin, GPIO_PIN_SET);                                    // Set CS pin
+    if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pSegmentList->Config.Value)) __enable_irq(); // Enable IRQ if asked
+  }
+  //--- Check for errors ---
+  if (HALstatus == HAL_ERROR  ) return ERR__SPI_COMM_ERROR;
+  if (HALstatus == HAL_BUSY   ) return ERR__SPI_BUSY;
+  if (HALstatus == HAL_TIMEOUT) return ERR__SPI_TIMEOUT;
+  //--- Endian transform of each segment ---
+  for (size_t zSeg = 0; zSeg < pSegmentList->SegmentCount; ++zSeg)
+  {
+    eERRORRESULT Error = Interface_SPIsegmentEndianTransform(&pSegmentList->pSegments[zSeg]);
+    if (Error != ERR_NONE) return Error;
+  }
+  return ERR_NONE;
+}
+
+
+#ifdef HAL_QSPI_MODULE_ENABLED
+//=============================================================================
+// Function for SPI phase transfer with STM32cubeIDE and the QUADSPI peripheral
+//=============================================================================
+eERRORRESULT Interface_SPItransferPhasePacket(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pPhasePacket == NULL) || (pIntDev->pHQSPI == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  static const uint32_t InstructionModes[5] = { QSPI_INSTRUCTION_NONE, QSPI_INSTRUCTION_1_LINE, QSPI_INSTRUCTION_2_LINES, 0, QSPI_INSTRUCTION_4_LINES };
+  static const uint32_t AddressModes[5]     = { QSPI_ADDRESS_NONE    , QSPI_ADDRESS_1_LINE    , QSPI_ADDRESS_2_LINES    , 0, QSPI_ADDRESS_4_LINES     };
+  static const uint32_t DataModes[5]        = { QSPI_DATA_NONE       , QSPI_DATA_1_LINE       , QSPI_DATA_2_LINES       , 0, QSPI_DATA_4_LINES        };
+  static const uint32_t AddressSizes[4]     = { QSPI_ADDRESS_8_BITS  , QSPI_ADDRESS_16_BITS   , QSPI_ADDRESS_24_BITS    , QSPI_ADDRESS_32_BITS     };
+  const bool HasAddress = (pPhasePacket->AddressSize > 0);
+  const bool HasData    = (pPhasePacket->DataSize > 0);
+  if ((pPhasePacket->InstructionLines > SPI_PHASE_4_LINES) || (pPhasePacket->InstructionLines == 3)) return ERR__NOT_SUPPORTED;
+  if (HasAddress && ((pPhasePacket->AddressLines == SPI_PHASE_NONE) || (pPhasePacket->AddressLines > SPI_PHASE_4_LINES) || (pPhasePacket->AddressLines == 3))) return ERR__NOT_SUPPORTED;
+  if (HasData && ((pPhasePacket->DataLines == SPI_PHASE_NONE) || (pPhasePacket->DataLines > SPI_PHASE_4_LINES) || (pPhasePacket->DataLines == 3))) return ERR__NOT_SUPPORTED;
+  if (pPhasePacket->AddressSize > 4u) return ERR__SPI_PARAMETER_ERROR;
+  if (HasData && (pPhasePacket->TxData == NULL) && (pPhasePacket->RxData == NULL)) return ERR__NULL_BUFFER;
+
+  //--- Fill the command, the QUADSPI sequences the phases with their own line count ---
+  QSPI_CommandTypeDef Command;
+  memset(&Command, 0, sizeof(Command));
+  Command.InstructionMode   = InstructionModes[pPhasePacket->InstructionLines];
+  Command.Instruction       = pPhasePacket->Instruction;
+  Command.AddressMode       = (HasAddress ? AddressModes[pPhasePacket->AddressLines] : QSPI_ADDRESS_NONE);
+  Command.AddressSize       = (HasAddress ? AddressSizes[pPhasePacket->AddressSize - 1] : QSPI_ADDRESS_8_BITS);
+  Command.Address           = pPhasePacket->Address;
+  Command.AlternateByteMode = QSPI_ALTERNATE_BYTES_NONE;
+  Command.DummyCycles       = pPhasePacket->DummyCycles;
+  Command.DataMode          = (HasData ? DataModes[pPhasePacket->DataLines] : QSPI_DATA_NONE);
+  Command.NbData            = (uint32_t)pPhasePacket->DataSize;
+  Command.DdrMode           = QSPI_DDR_MODE_DISABLE;
+  Command.DdrHoldHalfCycle  = QSPI_DDR_HHC_ANALOG_DELAY;
+  Command.SIOOMode          = QSPI_SIOO_INST_EVERY_CMD;
+
+  //--- Transfer ---
+  if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pPhasePacket->Config.Value)) __disable_irq(); // Disable IRQ if asked
+  HAL_StatusTypeDef HALstatus = HAL_QSPI_Command(pIntDev->pHQSPI, &Command, pIntDev->SPItimeout);
+  if ((HALstatus == HAL_OK) && HasData)
+  {
+    if (pPhasePacket->RxData != NULL) HALstatus = HAL_QSPI_Receive(pIntDev->pHQSPI, pPhasePacket->RxData, pIntDev->SPItimeout);
+    else HALstatus = HAL_QSPI_Transmit(pIntDev->pHQSPI, pPhasePacket->TxData, pIntDev->SPItimeout);
+  }
+  if (SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(pPhasePacket->Config.Value)) __enable_irq();  // Enable IRQ if asked
+  //--- Check for errors ---
+  if (HALstatus == HAL_ERROR  ) return ERR__SPI_COMM_ERROR;
+  if (HALstatus == HAL_BUSY   ) return ERR__SPI_BUSY;
+  if (HALstatus == HAL_TIMEOUT) return ERR__SPI_TIMEOUT;
+  //--- Endian transform of the received data ---
+  const eSPI_EndianTransform EndianTransform = (eSPI_EndianTransform)SPI_ENDIAN_TRANSFORM_GET(pPhasePacket->Config.Value);
+  if ((pPhasePacket->RxData != NULL) && (EndianTransform != SPI_NO_ENDIAN_CHANGE))
+  {
+    const eERRORRESULT Error = EndianTransform_InPlace(pPhasePacket->RxData, pPhasePacket->DataSize, (eEndianTransform)EndianTransform);
+    if (Error != ERR_NONE) return Error;
+  }
+  pPhasePacket->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;
+  pPhasePacket->Config.Value |= SPI_ENDIAN_RESULT_SET(EndianTransform);                // Indicate that the endian transform have been processed
   return ERR_NONE;
 }
+#endif // #ifdef HAL_QSPI_MODULE_ENABLED
 #endif // #ifdef USE_HAL_DRIVER // STM32cubeIDE
 
 //-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI Interface CRC helper
+//********************************************************************************************************************
+//=============================================================================
+// Add the bytes of a packet to its CRC and check the received CRC
+//=============================================================================
+eERRORRESULT Interface_SPIpacketCRC(SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pPacketDesc == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pPacketDesc->pCRC == NULL) return ERR_NONE;
+  const bool UseDummyByte = (pPacketDesc->Config.Bits.UseDummyByte > 0) || (pPacketDesc->TxData == NULL);
+  const uint8_t* pData = (pPacketDesc->RxData != NULL ? pPacketDesc->RxData : (UseDummyByte ? NULL : pPacketDesc->TxData));
+  if (pData == NULL) return ERR_NONE;                                                      // Dummy bytes only, nothing to add
+  if (SPI_IS_CHECK_CRC(pPacketDesc->Config.Value) == false) return CRC_Update(pPacketDesc->pCRC, pData, pPacketDesc->DataSize);
+  //--- The last bytes are the CRC to check ---
+  const size_t CRCsize = CRC_GetSize(pPacketDesc->pCRC->Type);
+  if (pPacketDesc->DataSize < CRCsize) return ERR__SPI_PARAMETER_ERROR;
+  eERRORRESULT Error = CRC_Update(pPacketDesc->pCRC, pData, pPacketDesc->DataSize - CRCsize);
+  if (Error != ERR_NONE) return Error;
+  return CRC_CheckReceived(pPacketDesc->pCRC, &pData[pPacketDesc->DataSize - CRCsize]);
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI Interface endianness helper
+//********************************************************************************************************************
+//=============================================================================
+// Apply the endian transform not done by the interface on a packet received data
+//=============================================================================
+eERRORRESULT Interface_SPIendianTransform(SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pPacketDesc == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  const eSPI_EndianTransform EndianTransform = (eSPI_EndianTransform)SPI_ENDIAN_TRANSFORM_GET(pPacketDesc->Config.Value);
+  const eSPI_EndianTransform EndianResult    = (eSPI_EndianTransform)SPI_ENDIAN_RESULT_GET(pPacketDesc->Config.Value);
+  if ((EndianResult == EndianTransform) || (pPacketDesc->RxData == NULL)) return ERR_NONE; // Already done by the interface or nothing to do
+  eERRORRESULT Error = EndianTransform_InPlace(pPacketDesc->RxData, pPacketDesc->DataSize, (eEndianTransform)EndianTransform);
+  if (Error != ERR_NONE) return Error;
+  pPacketDesc->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;
+  pPacketDesc->Config.Value |= SPI_ENDIAN_RESULT_SET(EndianTransform);                     // Indicate that the endian transform have been processed
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Apply the endian transform not done by the interface on a segment received data
+//=============================================================================
+eERRORRESULT Interface_SPIsegmentEndianTransform(SPIInterface_Segment* const pSegment)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSegment == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  const eSPI_EndianTransform EndianTransform = (eSPI_EndianTransform)SPI_ENDIAN_TRANSFORM_GET(pSegment->Config.Value);
+  const eSPI_EndianTransform EndianResult    = (eSPI_EndianTransform)SPI_ENDIAN_RESULT_GET(pSegment->Config.Value);
+  if ((EndianResult == EndianTransform) || (pSegment->RxData == NULL)) return ERR_NONE;    // Already done by the interface or nothing to do
+  eERRORRESULT Error = EndianTransform_InPlace(pSegment->RxData, pSegment->DataSize, (eEndianTransform)EndianTransform);
+  if (Error != ERR_NONE) return Error;
+  pSegment->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;
+  pSegment->Config.Value |= SPI_ENDIAN_RESULT_SET(EndianTransform);                        // Indicate that the endian transform have been processed
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI Interface scatter-gather transfer implementation
+//********************************************************************************************************************
+//=============================================================================
+// Function for SPI scatter-gather transfer
+//=============================================================================
+eERRORRESULT Interface_SPItransferSegmentList(SPI_Interface *pIntDev, SPIInterface_SegmentList* const pSegmentList)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pSegmentList == NULL)) return ERR__SPI_PARAMETER_ERROR;
+  if ((pSegmentList->pSegments == NULL) && (pSegmentList->SegmentCount > 0)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pIntDev->fnSPI_TransferSegmentList != NULL)                                        // Native segment list support?
+    return pIntDev->fnSPI_TransferSegmentList(pIntDev, pSegmentList);                    // Give the whole list to the interface
+#ifdef CHECK_NULL_PARAM
+  if (pIntDev->fnSPI_Transfer == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+
+  //--- No native support, transfer each segment as a packet, the ChipSelect stays asserted until the last one ---
+  const uint16_t SegmentConfMask = SPI_USE_DUMMYBYTE_FOR_RECEIVE | SPI_ENDIAN_RESULT_Mask | SPI_ENDIAN_TRANSFORM_Mask;
+  for (size_t zSeg = 0; zSeg < pSegmentList->SegmentCount; ++zSeg)
+  {
+    SPIInterface_Segment* pSegment = &pSegmentList->pSegments[zSeg];
+    SPIInterface_Packet Packet =
+    {
+      SPI_MEMBER(Config.Value) (uint16_t)((pSegment->Config.Value & SegmentConfMask) | (pSegmentList->Config.Value & SPI_BLOCK_INTERRUPTS_ON_TRANSFER)),
+      SPI_MEMBER(ChipSelect  ) pSegmentList->ChipSelect,
+      SPI_MEMBER(DummyByte   ) pSegment->DummyByte,
+      SPI_MEMBER(TxData      ) pSegment->TxData,
+      SPI_MEMBER(RxData      ) pSegment->RxData,
+      SPI_MEMBER(DataSize    ) pSegment->DataSize,
+      SPI_MEMBER(Terminate   ) (zSeg == (pSegmentList->SegmentCount - 1)) ? pSegmentList->Terminate : false,
+      SPI_MEMBER(pCRC        ) NULL,
+    };
+    eERRORRESULT Error = pIntDev->fnSPI_Transfer(pIntDev, &Packet);
+    pSegment->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;                                   // Give back the endian result
+    pSegment->Config.Value |= (Packet.Config.Value & SPI_ENDIAN_RESULT_Mask);
+    if (Error != ERR_NONE) return Error;                                                 // The interface deasserts the ChipSelect on error
+  }
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI Interface phase transfer implementation
+//********************************************************************************************************************
+//=============================================================================
+// Function for SPI phase transfer
+//=============================================================================
+eERRORRESULT Interface_SPItransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pPhasePacket == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pPhasePacket->AddressSize > 4u) return ERR__SPI_PARAMETER_ERROR;
+  if (pIntDev->fnSPI_TransferPhases != NULL)                                             // Native phase support?
+    return pIntDev->fnSPI_TransferPhases(pIntDev, pPhasePacket);                         // Give the phase packet to the interface
+
+  //--- No native support, only Standard SPI phases can be transferred as a segment list ---
+  const bool HasAddress = (pPhasePacket->AddressSize > 0);
+  const bool HasData    = (pPhasePacket->DataSize > 0);
+  if (pPhasePacket->InstructionLines > SPI_PHASE_1_LINE) return ERR__NOT_SUPPORTED;
+  if (HasAddress && (pPhasePacket->AddressLines != SPI_PHASE_1_LINE)) return ERR__NOT_SUPPORTED;
+  if (HasData && (pPhasePacket->DataLines != SPI_PHASE_1_LINE)) return ERR__NOT_SUPPORTED;
+  if ((pPhasePacket->DummyCycles % 8u) > 0) return ERR__NOT_SUPPORTED;                   // On 1 line, the dummy cycles are sent as dummy bytes
+  uint8_t Header[1 + 4];
+  size_t HeaderSize = 0;
+  if (pPhasePacket->InstructionLines == SPI_PHASE_1_LINE) Header[HeaderSize++] = pPhasePacket->Instruction;
+  for (size_t zByte = pPhasePacket->AddressSize; zByte > 0; --zByte)                    // Address MSB first
+    Header[HeaderSize++] = (uint8_t)(pPhasePacket->Address >> ((zByte - 1) * 8u));
+
+  //--- Build the segments ---
+  SPIInterface_Segment Segments[3];
+  SPIInterface_Segment* pDataSegment = NULL;
+  size_t SegmentCount = 0;
+  memset(&Segments[0], 0, sizeof(Segments));
+  if (HeaderSize > 0)
+  {
+    Segments[SegmentCount].TxData   = &Header[0];
+    Segments[SegmentCount].DataSize = HeaderSize;
+    ++SegmentCount;
+  }
+  if (pPhasePacket->DummyCycles > 0)                                                     // Mode bits and dummy cycles are sent at 0
+  {
+    Segments[SegmentCount].Config.Value = SPI_USE_DUMMYBYTE_FOR_RECEIVE;
+    Segments[SegmentCount].DataSize     = pPhasePacket->DummyCycles / 8u;
+    ++SegmentCount;
+  }
+  if (HasData)
+  {
+    pDataSegment = &Segments[SegmentCount++];
+    pDataSegment->Config.Value = (uint16_t)(pPhasePacket->Config.Value & SPI_ENDIAN_TRANSFORM_Mask);
+    pDataSegment->TxData       = pPhasePacket->TxData;                                   // NULL for a read, the DummyByte is sent
+    pDataSegment->RxData       = pPhasePacket->RxData;
+    pDataSegment->DataSize     = pPhasePacket->DataSize;
+  }
+  if (SegmentCount == 0) return ERR_NONE;
+
+  //--- Transfer the segments under one ChipSelect assertion ---
+  SPIInterface_SegmentList SegmentList;
+  SegmentList.Config.Value = (uint16_t)(pPhasePacket->Config.Value & SPI_BLOCK_INTERRUPTS_ON_TRANSFER);
+  SegmentList.ChipSelect   = pPhasePacket->ChipSelect;
+  SegmentList.pSegments    = &Segments[0];
+  SegmentList.SegmentCount = SegmentCount;
+  SegmentList.Terminate    = true;
+  const eERRORRESULT Error = Interface_SPItransferSegmentList(pIntDev, &SegmentList);
+  pPhasePacket->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;                                 // Give back the endian result
+  if (pDataSegment != NULL) pPhasePacket->Config.Value |= (pDataSegment->Config.Value & SPI_ENDIAN_RESULT_Mask);
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI Interface asynchronous transfer implementation
+//********************************************************************************************************************
+//=============================================================================
+// Initialize a SPI asynchronous transaction
+//=============================================================================
+void Interface_SPIinitTransaction(SPIInterface_Transaction* const pTransaction, SPIInterface_Packet* const pPacketDesc, SPITransactionComplete_Func fnComplete, void* pContext)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pTransaction == NULL) return;
+#endif
+  pTransaction->pPacketDesc = pPacketDesc;
+  pTransaction->fnComplete  = fnComplete;
+  pTransaction->pContext    = pContext;
+  pTransaction->Status      = SPI_TRANSACTION_IDLE;
+  pTransaction->Result      = ERR_NONE;
+  pTransaction->pNext       = NULL;
+}
+
+
+//=============================================================================
+// Function for SPI asynchronous transfer
+//=============================================================================
+eERRORRESULT Interface_SPItransferAsync(SPI_Interface *pIntDev, SPIInterface_Transaction* const pTransaction)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pTransaction == NULL)) return ERR__SPI_PARAMETER_ERROR;
+  if ((pTransaction->pPacketDesc == NULL) || (pIntDev->fnSPI_Transfer == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pTransaction->Status == SPI_TRANSACTION_PENDING) return ERR__BUSY;                 // A pending transaction can't be submitted again
+  SPIInterface_Packet* const pPacket = &pTransaction->Packet;                           // The interface works on a copy, the packet of the driver keeps its configuration
+  *pPacket = *pTransaction->pPacketDesc;
+  eERRORRESULT Error;
+
+  //--- Asynchronous transfer ---
+  pTransaction->pNext  = NULL;
+  pTransaction->Result = ERR__BUSY;
+  pTransaction->Status = SPI_TRANSACTION_PENDING;
+  if (pIntDev->fnSPI_TransferAsync != NULL)
+  {
+    pPacket->Config.Value |= SPI_USE_NON_BLOCKING;                                       // Non-blocking packets go through the asynchronous path
+    Error = pIntDev->fnSPI_TransferAsync(pIntDev, pTransaction);
+    if (Error != ERR_NONE) pTransaction->Status = SPI_TRANSACTION_IDLE;                  // Transaction not accepted
+    return Error;
+  }
+
+  //--- No asynchronous support, transfer now and complete the transaction ---
+  pPacket->Config.Value &= ~SPI_USE_NON_BLOCKING;                                        // The interface will do a blocking transfer
+  Error = pIntDev->fnSPI_Transfer(pIntDev, pPacket);
+  Interface_SPIcompleteTransaction(pTransaction, Error);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Complete a SPI asynchronous transaction
+//=============================================================================
+void Interface_SPIcompleteTransaction(SPIInterface_Transaction* const pTransaction, eERRORRESULT result)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pTransaction == NULL) return;
+#endif
+  pTransaction->Result = result;
+  SPIInterface_Packet* const pPacketDesc = pTransaction->pPacketDesc;
+  pPacketDesc->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;
+  pPacketDesc->Config.Value |= (pTransaction->Packet.Config.Value & SPI_ENDIAN_RESULT_Mask); // Give the endian result of the copy to the driver
+#if defined(__GNUC__)
+  __sync_synchronize();                                                                  // The result shall be visible before the completion flag
+#endif
+  pTransaction->Status = SPI_TRANSACTION_COMPLETE;
+  if (pTransaction->fnComplete != NULL) pTransaction->fnComplete(pTransaction);
+}
+
+
+//=============================================================================
+// Check if a SPI asynchronous transaction is complete
+//=============================================================================
+bool Interface_SPIisTransactionComplete(SPIInterface_Transaction* const pTransaction, eERRORRESULT* const pResult)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pTransaction == NULL) return false;
+#endif
+  if (pTransaction->Status != SPI_TRANSACTION_COMPLETE) return false;
+#if defined(__GNUC__)
+  __sync_synchronize();                                                                  // Read the result after the completion flag
+#endif
+  if (pResult != NULL) *pResult = pTransaction->Result;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
 #ifdef __cplusplus
 }
 #endif
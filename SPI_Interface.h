@@ -1,8 +1,8 @@
 /*!*****************************************************************************
  * @file    SPI_Interface.h
  * @author  Fabien 'Emandhal' MAILLY
- * @version 1.1.0
- * @date    27/08/2023
+ * @version 2.6.0
+ * @date    16/10/2026
  * @brief   SPI interface for drivers
  * @details This SPI interface definitions for all the https://github.com/Emandhal
  * drivers and developments
@@ -31,6 +31,14 @@
  *****************************************************************************/
 
 /* Revision history:
+ * 2.6.1    Arduino: the SPI transaction is only restarted when needed, any data bit count is accepted again
+ * 2.6.0    Add the phase packets of Dual/Quad-SPI memories
+ * 2.5.0    Add CRC computation and check of the packets
+ * 2.4.0    Add the per ChipSelect settings table of Arduino and STM32cubeIDE
+ * 2.3.1    The dummy byte receive does not need a transmit buffer
+ * 2.3.0    Add scatter-gather segment lists
+ * 2.2.0    Add endian transform helper
+ * 2.1.0    Add asynchronous transfer with completion
  * 2.0.0    Add data bit-length support
  * 1.1.1    Add specific for STM32cubeIDE
  * 1.1.0    Add specific for Arduino, change SPI_MODEs names to comply with Arduino library
@@ -47,6 +55,7 @@
 #include <stdlib.h>
 //-----------------------------------------------------------------------------
 #include "ErrorsDef.h"
+#include "CRC.h"
 //-----------------------------------------------------------------------------
 #ifdef ARDUINO
 #  include <Arduino.h>
@@ -96,7 +105,7 @@ typedef union SPI_Conf
   {
     uint16_t UseDummyByte   : 1; //!<  0    - Use dummy byte for receiving: 'true' = use the DummyByte member for all bytes to receive ; 'false' = Use TxData for all bytes to receive
     uint16_t BlockInterrupts: 1; //!<  1    - Block the interrupts for this transfer: 'true' = disable all interrupts before CS low and enable all interrupts after CS high ; 'false' = no enable and/or disable of interrupts
-    uint16_t                : 1; //!<  2
+    uint16_t CheckCRC       : 1; //!<  2    - Check the CRC of the packet (used with SPIInterface_Packet.pCRC): '1' = the last bytes of the packet are the CRC to check ; '0' = all the bytes are added to the CRC
     uint16_t IsNonBlocking  : 1; //!<  3    - Non-blocking use for the SPI: '1' = The driver ask for a non-blocking transfer (with DMA or interrupt transfer) ; '0' = The driver ask for a blocking transfer
     uint16_t EndianResult   : 3; //!<  4- 6 - If the transfer changes the endianness, the peripheral that do the transfer will say it here
     uint16_t EndianTransform: 3; //!<  7- 9 - The driver that asks for the transfer needs an endian change from little to big-endian or big to little-endian
@@ -107,6 +116,7 @@ typedef union SPI_Conf
 #define SPI_USE_DUMMYBYTE_FOR_RECEIVE     (0x1u << 0) //!< Use dummy byte for receiving
 #define SPI_USE_TXDATA_FOR_RECEIVE        (0x0u << 0) //!< Use TxData for receiving
 #define SPI_BLOCK_INTERRUPTS_ON_TRANSFER  (0x1u << 1) //!< Use enable and/or disable of interrupts
+#define SPI_CHECK_CRC                     (0x1u << 2) //!< The last bytes of the packet are the CRC to check
 #define SPI_USE_NON_BLOCKING              (0x1u << 3) //!< Use a non-blocking transfer (with DMA or interrupt transfer)
 #define SPI_BLOCKING                      (0x0u << 3) //!< Use a blocking transfer
 
@@ -133,6 +143,7 @@ typedef enum
 #define SPI_TRANSACTION_NUMBER_GET(value)  (((uint16_t)(value) >> SPI_TRANSACTION_NUMBER_Pos) & SPI_TRANSACTION_NUMBER_Mask) //!< Get transaction number
 
 #define SPI_IS_BLOCK_INTERRUPTS_ON_TRANSFER(value)  (((value) & SPI_BLOCK_INTERRUPTS_ON_TRANSFER) > 0) //!< Is the value has the #SPI_BLOCK_INTERRUPTS_ON_TRANSFER bit defined?
+#define SPI_IS_CHECK_CRC(value)                     (((value) & SPI_CHECK_CRC) > 0)                    //!< Is the value has the #SPI_CHECK_CRC bit defined?
 
 //-----------------------------------------------------------------------------
 
@@ -146,8 +157,86 @@ typedef struct
   uint8_t *RxData;    //!< Is where the data received through the interface will be stored. This parameter can be nulled by the driver if no received data is expected
   size_t DataSize;    //!< Is the size of the data to send and receive through the interface
   bool Terminate;     //!< Ask to terminate the current transfer. If 'true', deassert the ChipSelect pin at the end of transfer else leave the pin asserted
+  CRC_Context* pCRC;  //!< If not NULL, the bytes of the packet as they are on the bus (RxData if not NULL, else TxData) are added to this CRC by the interface. See #SPI_CHECK_CRC
 } SPIInterface_Packet;
 
+//! SPI transaction status enum
+typedef enum
+{
+  SPI_TRANSACTION_IDLE     = 0x0u, //!< The transaction is not submitted
+  SPI_TRANSACTION_PENDING  = 0x1u, //!< The transaction is submitted and is not complete yet
+  SPI_TRANSACTION_COMPLETE = 0x2u, //!< The transaction is complete, the result is available
+} eSPI_TransactionStatus;
+
+typedef struct SPIInterface_Transaction SPIInterface_Transaction; //!< Typedef of SPIInterface_Transaction object structure
+
+/*! @brief Function called when a SPI transaction is complete
+ *
+ * @warning This function can be called in an interrupt context
+ * @param[in] *pTransaction Is the transaction that just completed. Its Result member contains the transfer result
+ */
+typedef void (*SPITransactionComplete_Func)(SPIInterface_Transaction* const pTransaction);
+
+//! @brief Description of an asynchronous SPI transaction. This object is the handle of the transaction and shall stay valid until completion
+struct SPIInterface_Transaction
+{
+  SPIInterface_Packet* pPacketDesc;       //!< Packet to transfer. It shall stay valid until completion
+  SPITransactionComplete_Func fnComplete; //!< This function will be called when the transaction is complete. Can be NULL if the completion flag is used
+  void* pContext;                         //!< Driver context, not used by the interface
+  volatile eSPI_TransactionStatus Status; //!< Completion flag of the transaction. Shall be initialized to #SPI_TRANSACTION_IDLE before the first submission, see Interface_SPIinitTransaction()
+  volatile eERRORRESULT Result;           //!< Result of the transfer. Only valid when Status is #SPI_TRANSACTION_COMPLETE
+  SPIInterface_Transaction* pNext;        //!< Used by the interface to queue pending transactions. Do not modify while pending
+  SPIInterface_Packet Packet;             //!< Copy of *pPacketDesc given to the interface with the non-blocking flag set. Managed by the interface
+};
+
+
+//! @brief Description of a segment of a SPI scatter-gather transfer
+typedef struct SPIInterface_Segment
+{
+  SPI_Conf Config;    //!< Configuration of the segment. Only UseDummyByte, EndianResult and EndianTransform are used
+  uint8_t DummyByte;  //!< Is the byte to send while receiving (used with flag SPI_USE_DUMMYBYTE_FOR_RECEIVE in SPIInterface_Segment.Config or when SPIInterface_Segment.TxData is NULL)
+  uint8_t *TxData;    //!< Is the data to send through the interface. Can be NULL to send the DummyByte
+  uint8_t *RxData;    //!< Is where the data received through the interface will be stored. Can be NULL if no received data is expected
+  size_t DataSize;    //!< Is the size of the data to send and receive through the interface
+} SPIInterface_Segment;
+
+//! @brief Description of a SPI scatter-gather transfer. All the segments are transferred under one ChipSelect assertion. The segments have no CRC, add their buffers to a CRC with CRC_Update() after the transfer
+typedef struct SPIInterface_SegmentList
+{
+  SPI_Conf Config;                 //!< Configuration of the transfer. Only BlockInterrupts is used, each segment has its own configuration
+  uint8_t ChipSelect;              //!< Is the Chip Select index to use for the transfer
+  SPIInterface_Segment* pSegments; //!< Is the list of segments to transfer in order
+  size_t SegmentCount;             //!< Is the count of segments in the list
+  bool Terminate;                  //!< Ask to terminate the current transfer. If 'true', deassert the ChipSelect pin after the last segment else leave the pin asserted
+} SPIInterface_SegmentList;
+
+
+//! SPI memory transfer phase line count enum
+typedef enum
+{
+  SPI_PHASE_NONE    = 0u, //!< The phase is not present
+  SPI_PHASE_1_LINE  = 1u, //!< The phase uses 1 data line (Standard SPI)
+  SPI_PHASE_2_LINES = 2u, //!< The phase uses 2 data lines (Dual-SPI)
+  SPI_PHASE_4_LINES = 4u, //!< The phase uses 4 data lines (Quad-SPI)
+} eSPI_PhaseLines;
+
+//! @brief Description of a SPI memory transfer with an instruction, an address, dummy cycles and a data phase. Each phase has its own line count (Dual/Quad-SPI memories). The ChipSelect is asserted during the whole transfer
+typedef struct SPIInterface_PhasePacket
+{
+  SPI_Conf Config;                  //!< Configuration of the transfer. Only BlockInterrupts, EndianResult and EndianTransform are used
+  uint8_t ChipSelect;               //!< Is the Chip Select index to use for the transfer
+  uint8_t Instruction;              //!< Is the instruction byte to send
+  eSPI_PhaseLines InstructionLines; //!< Is the line count of the instruction phase. #SPI_PHASE_NONE if there is no instruction
+  uint32_t Address;                 //!< Is the address to send MSB first
+  uint8_t AddressSize;              //!< Is the address size in bytes (1 to 4). 0 if there is no address
+  eSPI_PhaseLines AddressLines;     //!< Is the line count of the address phase. The dummy cycles use the same line count
+  uint8_t DummyCycles;              //!< Is the count of dummy SCK cycles between the address and the data phases, mode bits included (sent at 0)
+  eSPI_PhaseLines DataLines;        //!< Is the line count of the data phase
+  uint8_t *TxData;                  //!< Is the data to write. NULL for a read
+  uint8_t *RxData;                  //!< Is where the data read will be stored. NULL for a write
+  size_t DataSize;                  //!< Is the size of the data phase in bytes. 0 if there is no data phase
+} SPIInterface_PhasePacket;
+
 //-----------------------------------------------------------------------------
 
 
@@ -159,6 +248,7 @@ typedef struct
 //********************************************************************************************************************
 
 //! Prepare SPI packet description to check the DMA status
+//! @deprecated Kept for compatibility with the transaction number polling, use Interface_SPItransferAsync() instead
 #define SPI_INTERFACE_CHECK_DMA_DESC(transactionNumber)                                            \
   {                                                                                                \
     SPI_MEMBER(Config.Value) SPI_USE_NON_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) \
@@ -169,6 +259,7 @@ typedef struct
     SPI_MEMBER(RxData      ) NULL,                                                                 \
     SPI_MEMBER(DataSize    ) 0,                                                                    \
     SPI_MEMBER(Terminate   ) true,                                                                 \
+    SPI_MEMBER(pCRC        ) NULL,                                                                 \
   }
 
 //! Prepare SPI packet description to transmit bytes
@@ -181,6 +272,7 @@ typedef struct
     SPI_MEMBER(RxData      ) NULL,                                                          \
     SPI_MEMBER(DataSize    ) size,                                                          \
     SPI_MEMBER(Terminate   ) terminate,                                                     \
+    SPI_MEMBER(pCRC        ) NULL,                                                          \
   }
 
 //! Prepare SPI packet description to transmit bytes (TxData = RxData)
@@ -193,9 +285,10 @@ typedef struct
     SPI_MEMBER(RxData      ) (uint8_t*)data,                                                \
     SPI_MEMBER(DataSize    ) size,                                                          \
     SPI_MEMBER(Terminate   ) terminate,                                                     \
+    SPI_MEMBER(pCRC        ) NULL,                                                          \
   }
 
-//! Prepare SPI packet description to receive data using dummy byte
+//! Prepare SPI packet description to receive data using dummy byte. No transmit buffer is needed, the interface sends the dummy byte itself
 #define SPI_INTERFACE_RX_DATA_WITH_DUMMYBYTE_DESC(dummyByte,rxData,size,terminate)                                          \
   {                                                                                                                         \
     SPI_MEMBER(Config.Value) SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) | SPI_USE_DUMMYBYTE_FOR_RECEIVE, \
@@ -205,6 +298,7 @@ typedef struct
     SPI_MEMBER(RxData      ) (uint8_t*)rxData,                                                                              \
     SPI_MEMBER(DataSize    ) size,                                                                                          \
     SPI_MEMBER(Terminate   ) terminate,                                                                                     \
+    SPI_MEMBER(pCRC        ) NULL,                                                                                          \
   }
 
 //! Prepare SPI packet description to transmit bytes with DMA
@@ -218,6 +312,7 @@ typedef struct
     SPI_MEMBER(RxData      ) NULL,                                                          \
     SPI_MEMBER(DataSize    ) size,                                                          \
     SPI_MEMBER(Terminate   ) terminate,                                                     \
+    SPI_MEMBER(pCRC        ) NULL,                                                          \
   }
 
 //! Prepare SPI packet description to transmit bytes (TxData = RxData) with DMA
@@ -231,6 +326,7 @@ typedef struct
     SPI_MEMBER(RxData      ) (uint8_t*)data,                                                \
     SPI_MEMBER(DataSize    ) size,                                                          \
     SPI_MEMBER(Terminate   ) terminate,                                                     \
+    SPI_MEMBER(pCRC        ) NULL,                                                          \
   }
 
 //! Prepare SPI packet description to receive data using dummy byte with DMA
@@ -244,6 +340,81 @@ typedef struct
     SPI_MEMBER(RxData      ) (uint8_t*)rxData,                                                               \
     SPI_MEMBER(DataSize    ) size,                                                                           \
     SPI_MEMBER(Terminate   ) terminate,                                                                      \
+    SPI_MEMBER(pCRC        ) NULL,                                                                           \
+  }
+
+//! Prepare SPI segment description to transmit bytes
+#define SPI_INTERFACE_TX_SEGMENT(txData,size)                                               \
+  {                                                                                         \
+    SPI_MEMBER(Config.Value) SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE), \
+    SPI_MEMBER(DummyByte   ) 0x00,                                                          \
+    SPI_MEMBER(TxData      ) (uint8_t*)txData,                                              \
+    SPI_MEMBER(RxData      ) NULL,                                                          \
+    SPI_MEMBER(DataSize    ) size,                                                          \
+  }
+
+//! Prepare SPI segment description to receive data using dummy byte
+#define SPI_INTERFACE_RX_SEGMENT_WITH_DUMMYBYTE(dummyByte,rxData,size,endianTransform)                                 \
+  {                                                                                                                    \
+    SPI_MEMBER(Config.Value) SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(endianTransform) | SPI_USE_DUMMYBYTE_FOR_RECEIVE, \
+    SPI_MEMBER(DummyByte   ) dummyByte,                                                                                \
+    SPI_MEMBER(TxData      ) NULL,                                                                                     \
+    SPI_MEMBER(RxData      ) (uint8_t*)rxData,                                                                         \
+    SPI_MEMBER(DataSize    ) size,                                                                                     \
+  }
+
+//! Prepare SPI segment description to send dummy bytes (dummy cycles) without receiving data
+#define SPI_INTERFACE_DUMMY_SEGMENT(dummyByte,size)                                                                         \
+  {                                                                                                                         \
+    SPI_MEMBER(Config.Value) SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) | SPI_USE_DUMMYBYTE_FOR_RECEIVE, \
+    SPI_MEMBER(DummyByte   ) dummyByte,                                                                                     \
+    SPI_MEMBER(TxData      ) NULL,                                                                                          \
+    SPI_MEMBER(RxData      ) NULL,                                                                                          \
+    SPI_MEMBER(DataSize    ) size,                                                                                          \
+  }
+
+//! Prepare SPI phase packet description to read a memory. The line counts are the ones of each phase (ex: Quad I/O fast read = instruction on 1 line, address and data on 4 lines)
+#define SPI_INTERFACE_PHASE_READ_DESC(instruction,instructionLines,address,addressSize,addressLines,dummyCycles,rxData,dataLines,size) \
+  {                                                                                                                                    \
+    SPI_MEMBER(Config.Value    ) SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE),                                        \
+    SPI_MEMBER(ChipSelect      ) pComp->SPIchipSelect,                                                                                 \
+    SPI_MEMBER(Instruction     ) instruction,                                                                                          \
+    SPI_MEMBER(InstructionLines) instructionLines,                                                                                     \
+    SPI_MEMBER(Address         ) address,                                                                                              \
+    SPI_MEMBER(AddressSize     ) addressSize,                                                                                          \
+    SPI_MEMBER(AddressLines    ) addressLines,                                                                                         \
+    SPI_MEMBER(DummyCycles     ) dummyCycles,                                                                                          \
+    SPI_MEMBER(DataLines       ) dataLines,                                                                                            \
+    SPI_MEMBER(TxData          ) NULL,                                                                                                 \
+    SPI_MEMBER(RxData          ) (uint8_t*)rxData,                                                                                     \
+    SPI_MEMBER(DataSize        ) size,                                                                                                 \
+  }
+
+//! Prepare SPI phase packet description to write a memory (or to send an instruction only with a size of 0)
+#define SPI_INTERFACE_PHASE_WRITE_DESC(instruction,instructionLines,address,addressSize,addressLines,txData,dataLines,size) \
+  {                                                                                                                         \
+    SPI_MEMBER(Config.Value    ) SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE),                             \
+    SPI_MEMBER(ChipSelect      ) pComp->SPIchipSelect,                                                                      \
+    SPI_MEMBER(Instruction     ) instruction,                                                                               \
+    SPI_MEMBER(InstructionLines) instructionLines,                                                                          \
+    SPI_MEMBER(Address         ) address,                                                                                   \
+    SPI_MEMBER(AddressSize     ) addressSize,                                                                               \
+    SPI_MEMBER(AddressLines    ) addressLines,                                                                              \
+    SPI_MEMBER(DummyCycles     ) 0,                                                                                         \
+    SPI_MEMBER(DataLines       ) dataLines,                                                                                 \
+    SPI_MEMBER(TxData          ) (uint8_t*)txData,                                                                          \
+    SPI_MEMBER(RxData          ) NULL,                                                                                      \
+    SPI_MEMBER(DataSize        ) size,                                                                                      \
+  }
+
+//! Prepare SPI segment list description
+#define SPI_INTERFACE_SEGMENT_LIST_DESC(segments,count,terminate) \
+  {                                                               \
+    SPI_MEMBER(Config.Value) SPI_BLOCKING,                        \
+    SPI_MEMBER(ChipSelect  ) pComp->SPIchipSelect,                \
+    SPI_MEMBER(pSegments   ) segments,                            \
+    SPI_MEMBER(SegmentCount) count,                               \
+    SPI_MEMBER(Terminate   ) terminate,                           \
   }
 
 //-----------------------------------------------------------------------------
@@ -367,39 +538,118 @@ typedef eERRORRESULT (*SPIInit_Func)(SPI_Interface *pIntDev, uint8_t chipSelect,
  */
 typedef eERRORRESULT (*SPITransferPacket_Func)(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
 
+/*! @brief Interface function for SPI peripheral scatter-gather transfer
+ *
+ * This function will be called when the driver needs to transfer a list of segments under one ChipSelect assertion
+ * Each segment has its own dummy byte and endian configuration. The endian result of each segment shall be set like with #SPITransferPacket_Func
+ * @warning A SPIInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pSegmentList Is the segment list description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+typedef eERRORRESULT (*SPITransferSegmentList_Func)(SPI_Interface *pIntDev, SPIInterface_SegmentList* const pSegmentList);
+
+/*! @brief Interface function for SPI peripheral phase transfer
+ *
+ * This function will be called when the driver needs to transfer an instruction, an address, dummy cycles and data with a line count per phase (Dual/Quad-SPI memories) under one ChipSelect assertion
+ * The endian result shall be set like with #SPITransferPacket_Func
+ * @warning A SPIInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPhasePacket Is the phase packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+typedef eERRORRESULT (*SPITransferPhases_Func)(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket);
+
+/*! @brief Interface function for SPI peripheral asynchronous transfer
+ *
+ * This function will be called when the driver needs to transfer a packet without waiting for the end of the transfer
+ * The interface queues the transaction and returns immediately. When the transfer is done, the interface shall call Interface_SPIcompleteTransaction()
+ * There is no limit to the count of pending transactions other than the interface resources, transactions are transferred in submission order
+ * @warning A SPIInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pTransaction Is the transaction to queue. Its status is already set to #SPI_TRANSACTION_PENDING. The packet to transfer is SPIInterface_Transaction.Packet, a copy of the driver packet with the non-blocking flag set
+ * @return Returns an #eERRORRESULT value enum. Any error means that the transaction has not been accepted
+ */
+typedef eERRORRESULT (*SPITransferAsync_Func)(SPI_Interface *pIntDev, SPIInterface_Transaction* const pTransaction);
+
+//-----------------------------------------------------------------------------
+
+#if defined(ARDUINO) || defined(USE_HAL_DRIVER)
+#  ifndef SPI_INTERFACE_CHIPSELECT_COUNT
+#    define SPI_INTERFACE_CHIPSELECT_COUNT  ( 4u ) //!< Count of devices (ChipSelect) with their own settings on one SPI interface
+#  endif
+#  if defined(ARDUINO) && !defined(SPI_INTERFACE_ARDUINO_KEEP_TRANSACTION)
+#    define SPI_INTERFACE_ARDUINO_KEEP_TRANSACTION  0 //!< With Arduino, set to 1 to keep the SPI transaction open after a terminate, it is only restarted when the device changes. Only if the SPIClass is used through this interface only
+#  endif
+
+//! @brief Settings of a device (ChipSelect) on the SPI interface, filled by Interface_SPIinit()
+typedef struct SPIInterface_ChipSettings
+{
+  bool Configured;            //!< 'true' if the device has been initialized
+  eSPIInterface_Mode Mode;    //!< SPI mode of the device
+  uint32_t SCKfreq;           //!< SCK frequency of the device in Hz
+  uint8_t BitCount;           //!< Data bit count of the device. With Arduino, the SPIClass always transfers 8-bits data whatever this value
+#  ifdef ARDUINO
+  uint8_t ChipSelect;         //!< ChipSelect pin of the device, as set in the packets
+  SPISettings _SPIsettings;   //!< Arduino SPI settings of the device, computed once at initialization
+#  else
+  GPIO_TypeDef* pGPIOx;       //!< Pointer to General Purpose I/O register of the ChipSelect. Set it before initialization, NULL to use the SPI_Interface.pGPIOx
+  uint16_t GPIOpin;           //!< General Purpose I/O pin number of the ChipSelect
+  uint32_t BaudRatePrescaler; //!< HAL baud rate prescaler of the device, computed at initialization
+#  endif
+} SPIInterface_ChipSettings;
+#endif
+
 //-----------------------------------------------------------------------------
 
 #ifdef ARDUINO
 //! @brief Arduino SPI interface container structure
 struct SPI_Interface
 {
-  SPISettings _SPIsettings;              //!< Arduino SPI settings
-  SPIClass& _SPIclass;                   //!< Arduino SPI class
-  SPIInit_Func fnSPI_Init;               //!< This function will be called at driver initialization to configure the interface driver
-  SPITransferPacket_Func fnSPI_Transfer; //!< This function will be called at driver read/write data from/to the interface driver SPI
+  SPISettings _SPIsettings;                                         //!< Arduino SPI settings, used by the ChipSelect not in the settings table
+  SPIClass& _SPIclass;                                              //!< Arduino SPI class
+  SPIInit_Func fnSPI_Init;                                          //!< This function will be called at driver initialization to configure the interface driver
+  SPITransferPacket_Func fnSPI_Transfer;                            //!< This function will be called at driver read/write data from/to the interface driver SPI
+  SPITransferAsync_Func fnSPI_TransferAsync;                        //!< This function will be called when the driver needs an asynchronous transfer. Set to NULL if the interface has no asynchronous support
+  SPITransferSegmentList_Func fnSPI_TransferSegmentList;            //!< This function will be called when the driver needs a scatter-gather transfer. Set to NULL if the interface has no native segment list support
+  SPITransferPhases_Func fnSPI_TransferPhases;                      //!< This function will be called when the driver needs a phase transfer. Set to NULL if the interface has no native phase support (only Standard SPI phases are possible)
+  const SPISettings* _pCurrentSettings;                             //!< Settings of the SPI transaction in progress, NULL if no transaction is open. Managed by the interface
+  SPIInterface_ChipSettings _Chips[SPI_INTERFACE_CHIPSELECT_COUNT]; //!< Settings of each device, found by ChipSelect pin
 };
 
 #elif defined(USE_HAL_DRIVER) //#ifdef STM32cubeIDE
 //! @brief STM32 HAL SPI interface container structure
 struct SPI_Interface
 {
-  SPI_HandleTypeDef* pHSPI;              //!< Pointer to SPI handle Structure definition
-  SPIInit_Func fnSPI_Init;               //!< This function will be called at driver initialization to configure the interface driver
-  SPITransferPacket_Func fnSPI_Transfer; //!< This function will be called at driver read/write data from/to the interface driver SPI
-  GPIO_TypeDef* pGPIOx;                  //!< Pointer to General Purpose I/O register
-  uint16_t GPIOpin;                      //!< General Purpose I/O pin number
-  uint32_t SPItimeout;                   //!< SPI timeout
+  SPI_HandleTypeDef* pHSPI;                                        //!< Pointer to SPI handle Structure definition
+  SPIInit_Func fnSPI_Init;                                         //!< This function will be called at driver initialization to configure the interface driver
+  SPITransferPacket_Func fnSPI_Transfer;                           //!< This function will be called at driver read/write data from/to the interface driver SPI
+  GPIO_TypeDef* pGPIOx;                                            //!< Pointer to General Purpose I/O register, used by the ChipSelect without their own pin
+  uint16_t GPIOpin;                                                //!< General Purpose I/O pin number, used by the ChipSelect without their own pin
+  uint32_t SPItimeout;                                             //!< SPI timeout
+  uint32_t SPIclock;                                               //!< Clock of the SPI peripheral in Hz, used to compute the baud rate prescaler of each device
+  SPIInterface_ChipSettings Chips[SPI_INTERFACE_CHIPSELECT_COUNT]; //!< Settings of each device, indexed by ChipSelect. Set their ChipSelect pins before initialization
+  uint8_t CurrentChip;                                             //!< ChipSelect of the device currently configured on the peripheral, managed by the interface
+  SPITransferAsync_Func fnSPI_TransferAsync;                       //!< This function will be called when the driver needs an asynchronous transfer. Set to NULL if the interface has no asynchronous support
+  SPITransferSegmentList_Func fnSPI_TransferSegmentList;           //!< This function will be called when the driver needs a scatter-gather transfer. Set to NULL if the interface has no native segment list support
+  SPITransferPhases_Func fnSPI_TransferPhases;                     //!< This function will be called when the driver needs a phase transfer. Set to NULL if the interface has no native phase support (only Standard SPI phases are possible)
+#  ifdef HAL_QSPI_MODULE_ENABLED
+  QSPI_HandleTypeDef* pHQSPI;                                      //!< Pointer to QUADSPI handle Structure definition, used by the phase transfers
+#  endif
 };
 
 #else
 //! @brief Generic SPI interface container structure
 struct SPI_Interface
 {
-  void *InterfaceDevice;                 //!< This is the pointer that will be in the first parameter of all interface call functions
-  uint32_t UniqueID;                     //!< This is a protection for the #InterfaceDevice pointer. This value will be check when using the struct SPI_Interface in the driver which use the generic SPI interface
-  SPIInit_Func fnSPI_Init;               //!< This function will be called at driver initialization to configure the interface driver
-  SPITransferPacket_Func fnSPI_Transfer; //!< This function will be called when the driver needs to transfer data over the SPI communication with the device
-  uint8_t Channel;                       //!< SPI channel of the interface device in case of multiple virtual SPI channels (This is not the ChipSelect)
+  void *InterfaceDevice;                                 //!< This is the pointer that will be in the first parameter of all interface call functions
+  uint32_t UniqueID;                                     //!< This is a protection for the #InterfaceDevice pointer. This value will be check when using the struct SPI_Interface in the driver which use the generic SPI interface
+  SPIInit_Func fnSPI_Init;                               //!< This function will be called at driver initialization to configure the interface driver
+  SPITransferPacket_Func fnSPI_Transfer;                 //!< This function will be called when the driver needs to transfer data over the SPI communication with the device
+  uint8_t Channel;                                       //!< SPI channel of the interface device in case of multiple virtual SPI channels (This is not the ChipSelect)
+  SPITransferAsync_Func fnSPI_TransferAsync;             //!< This function will be called when the driver needs an asynchronous transfer. Set to NULL if the interface has no asynchronous support
+  SPITransferSegmentList_Func fnSPI_TransferSegmentList; //!< This function will be called when the driver needs a scatter-gather transfer. Set to NULL if the interface has no native segment list support
+  SPITransferPhases_Func fnSPI_TransferPhases;           //!< This function will be called when the driver needs a phase transfer. Set to NULL if the interface has no native phase support (only Standard SPI phases are possible)
 };
 #endif //#ifdef ARDUINO && USE_HAL_DRIVER
 
@@ -416,6 +666,7 @@ struct SPI_Interface
 /*! @brief Function for interface SPI initialization
  *
  * This function will be called at driver initialization to configure the interface driver
+ * @note With Arduino and STM32cubeIDE, only the Standard SPI modes are accepted, a Dual-SPI or Quad-SPI mode returns ERR__NOT_SUPPORTED (the Arduino SPIClass has no Dual/Quad lines). The Dual/Quad phases are transferred by the SPI_Interface.fnSPI_TransferPhases of the interface, with STM32cubeIDE Interface_SPItransferPhasePacket() and the QUADSPI peripheral
  * @param[in] *pIntDev Is the SPI interface container structure used for the interface initialization
  * @param[in] chipSelect Is the Chip Select index to use for the SPI/Dual-SPI/Quad-SPI initialization
  * @param[in] mode Is the mode of the SPI to configure
@@ -433,6 +684,125 @@ eERRORRESULT Interface_SPIinit(SPI_Interface *pIntDev, uint8_t chipSelect, eSPII
  */
 eERRORRESULT Interface_SPItransfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
 
+/*! @brief Function interface for SPI scatter-gather transfer (native implementation for Arduino and STM32cubeIDE)
+ *
+ * Transfer all the segments of the list under one ChipSelect assertion. Set it to SPI_Interface.fnSPI_TransferSegmentList
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pSegmentList Is the segment list description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT Interface_SPItransferSegmentListNative(SPI_Interface *pIntDev, SPIInterface_SegmentList* const pSegmentList);
+
+#ifdef ARDUINO
+/*! @brief End the SPI transaction kept open with Arduino
+ *
+ * With #SPI_INTERFACE_ARDUINO_KEEP_TRANSACTION set to 1, the transaction stays open after a terminate. Call this function before using the SPIClass outside of this interface
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ */
+void Interface_SPIendTransaction(SPI_Interface *pIntDev);
+#endif
+
+#if defined(USE_HAL_DRIVER) && defined(HAL_QSPI_MODULE_ENABLED)
+/*! @brief Function for SPI phase transfer with the QUADSPI peripheral
+ *
+ * Transfer the phase packet with SPI_Interface.pHQSPI. Set it to SPI_Interface.fnSPI_TransferPhases. The ChipSelect is the one of the QUADSPI peripheral
+ * @warning A SPIInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPhasePacket Is the phase packet description to transfer through QUADSPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT Interface_SPItransferPhasePacket(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket);
+#endif
+
+/*! @brief Add the bytes of a packet to its CRC and check the received CRC
+ *
+ * This function will be called by the interface after a transfer, before the endian transform, when SPIInterface_Packet.pCRC is not NULL
+ * The bytes as they are on the bus (SPIInterface_Packet.RxData if not NULL, else SPIInterface_Packet.TxData) are added to the CRC. With #SPI_CHECK_CRC, the last CRC_GetSize() bytes are not added but checked against the CRC
+ * @param[in] *pPacketDesc Is the packet description that has been transferred through SPI
+ * @return Returns an #eERRORRESULT value enum, #ERR__CRC_ERROR if the CRC check failed
+ */
+eERRORRESULT Interface_SPIpacketCRC(SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief Apply the endian transform not done by the interface on a packet received data
+ *
+ * This function will be called by the driver (or by the interface) after a transfer when the endian transform has not been performed (endian result different from the endian transform)
+ * The data blocks of SPIInterface_Packet.RxData are switched in place with the shared endian transform engine and the endian result is updated
+ * @param[in,out] *pPacketDesc Is the packet description that has been transferred through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT Interface_SPIendianTransform(SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief Apply the endian transform not done by the interface on a segment received data
+ *
+ * Same as Interface_SPIendianTransform() for a segment of a scatter-gather transfer
+ * @param[in,out] *pSegment Is the segment description that has been transferred through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT Interface_SPIsegmentEndianTransform(SPIInterface_Segment* const pSegment);
+
+/*! @brief Function interface for SPI scatter-gather transfer
+ *
+ * This function will be called when the driver needs to transfer a command, an address, dummy cycles and data (or any other list of segments) under one ChipSelect assertion
+ * If the interface has a native segment list function (SPI_Interface.fnSPI_TransferSegmentList not NULL), the whole list is given to it. Else each segment is transferred as a packet with SPI_Interface.fnSPI_Transfer, only the last packet has the Terminate of the list
+ * @warning A SPIInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pSegmentList Is the segment list description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT Interface_SPItransferSegmentList(SPI_Interface *pIntDev, SPIInterface_SegmentList* const pSegmentList);
+
+/*! @brief Function interface for SPI phase transfer
+ *
+ * This function will be called when the driver needs to transfer an instruction, an address, dummy cycles and data with a line count per phase (Dual/Quad-SPI memories)
+ * If the interface has a native phase function (SPI_Interface.fnSPI_TransferPhases not NULL), the phase packet is given to it. Else, if all the phases use 1 line and the dummy cycles are a multiple of 8, the phases are transferred as a segment list with Interface_SPItransferSegmentList()
+ * @warning A SPIInit_Func() must be called before using this function
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPhasePacket Is the phase packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum. #ERR__NOT_SUPPORTED if the phases need more lines than the interface can do
+ */
+eERRORRESULT Interface_SPItransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket);
+
+/*! @brief Initialize a SPI asynchronous transaction
+ *
+ * This function shall be called once before the first submission of a transaction, it sets the transaction as idle
+ * @param[out] *pTransaction Is the transaction to initialize
+ * @param[in] *pPacketDesc Is the packet to transfer. It shall stay valid until completion
+ * @param[in] fnComplete Is the function that will be called when the transaction is complete. Can be NULL if the completion flag is used
+ * @param[in] *pContext Is the driver context, not used by the interface
+ */
+void Interface_SPIinitTransaction(SPIInterface_Transaction* const pTransaction, SPIInterface_Packet* const pPacketDesc, SPITransactionComplete_Func fnComplete, void* pContext);
+
+/*! @brief Function interface for SPI asynchronous transfer
+ *
+ * This function will be called when the driver needs to transfer a packet without waiting for the end of the transfer
+ * The packet of the transaction is copied into SPIInterface_Transaction.Packet, the copy is set as non-blocking and the transaction is given to SPI_Interface.fnSPI_TransferAsync. The packet of the driver is not modified, except its endian result at completion
+ * If the interface has no asynchronous support (SPI_Interface.fnSPI_TransferAsync is NULL), the packet is transferred with SPI_Interface.fnSPI_Transfer and the transaction is completed before returning
+ * The completion is signaled by the transaction status (see Interface_SPIisTransactionComplete()) and by the call of SPIInterface_Transaction.fnComplete if not NULL
+ * @warning A SPIInit_Func() must be called before using this function
+ * @warning The transaction status shall be initialized before the first submission (with Interface_SPIinitTransaction()), else a random status equal to #SPI_TRANSACTION_PENDING is rejected with #ERR__BUSY
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pTransaction Is the transaction to transfer. It is the handle of the transaction and shall stay valid until completion
+ * @return Returns an #eERRORRESULT value enum. ERR_NONE means that the transaction has been accepted, the transfer result is in the transaction
+ */
+eERRORRESULT Interface_SPItransferAsync(SPI_Interface *pIntDev, SPIInterface_Transaction* const pTransaction);
+
+/*! @brief Complete a SPI asynchronous transaction
+ *
+ * This function shall be called by the interface when the transfer of a transaction is done
+ * @note This function can be called in an interrupt context
+ * @param[in] *pTransaction Is the transaction that is complete
+ * @param[in] result Is the result of the transfer
+ */
+void Interface_SPIcompleteTransaction(SPIInterface_Transaction* const pTransaction, eERRORRESULT result);
+
+/*! @brief Check if a SPI asynchronous transaction is complete
+ *
+ * @param[in] *pTransaction Is the transaction to check
+ * @param[out] *pResult Is where the result of the transfer will be stored if the transaction is complete. Can be NULL if not needed
+ * @return Returns 'true' if the transaction is complete else 'false'
+ */
+bool Interface_SPIisTransactionComplete(SPIInterface_Transaction* const pTransaction, eERRORRESULT* const pResult);
+
 //-----------------------------------------------------------------------------
 #ifdef __cplusplus
 }
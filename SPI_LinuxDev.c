@@ -0,0 +1,390 @@
+/*!*****************************************************************************
+ * @file    SPI_LinuxDev.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.2.0
+ * @date    16/10/2026
+ * @brief   Linux spidev backend of the SPI interface
+ * @details This backend plugs the /dev/spidevB.C character devices into the
+ *          generic SPI_Interface of all the https://github.com/Emandhal drivers
+ *          and developments. Only available on Linux with the generic
+ *          SPI_Interface
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.2.0    Add the phase transfer of Dual/Quad-SPI memories
+ * 1.1.0    Compute the CRC of the packets
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "SPI_LinuxDev.h"
+#include "EndianTransform.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+// The kernel headers define their own SPI_LSB_FIRST, keep the SPI_Interface one under another name
+enum { SPI_INTERFACE_LSB_FIRST = SPI_LSB_FIRST };
+#undef SPI_LSB_FIRST
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/spi/spidev.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux spidev backend internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Perform an ioctl with the shim or the C library
+//=============================================================================
+static int __SPI_LinuxDev_Ioctl(SPI_LinuxDev* pDev, int fd, unsigned long request, void* pArg)
+{
+  if (pDev->fnIoctl != NULL) return pDev->fnIoctl(fd, request, pArg);
+  return ioctl(fd, request, pArg);
+}
+
+
+//=============================================================================
+// [STATIC] Convert an errno of a spidev ioctl to an #eERRORRESULT
+//=============================================================================
+static eERRORRESULT __SPI_LinuxDev_Errno(int error)
+{
+  switch (error)
+  {
+    case ETIMEDOUT : return ERR__SPI_TIMEOUT;
+    case EBUSY     : return ERR__SPI_BUSY;
+    case EINVAL    : return ERR__SPI_CONFIG_ERROR;                                // Mode, bit count or speed not supported by the controller
+    case EMSGSIZE  : return ERR__SPI_OVERFLOW_ERROR;                              // Message bigger than the spidev buffer (bufsiz module parameter)
+    case EOPNOTSUPP: return ERR__NOT_SUPPORTED;
+    default: break;
+  }
+  return ERR__SPI_COMM_ERROR;
+}
+
+
+//=============================================================================
+// [STATIC] Transfer all the packets collected in one SPI_IOC_MESSAGE(N) ioctl, the chip select stays asserted at the end if not terminate
+//=============================================================================
+static eERRORRESULT __SPI_LinuxDev_Flush(SPI_LinuxDev* pDev, bool terminate)
+{
+  struct spi_ioc_transfer Transfers[SPI_LINUXDEV_MAX_TRANSFERS];
+  const size_t PacketCount = pDev->PacketCount;
+  SPI_LinuxDevChip* pChip = &pDev->pChips[pDev->Packets[0].ChipSelect];
+  size_t TransferCount = 0;
+  bool DummyFilled = false;
+  uint8_t DummyByte = 0;
+  pDev->PacketCount = 0;
+  memset(&Transfers[0], 0, sizeof(Transfers));                                   // cs_change = 0: the chip select stays asserted until the end of the message
+
+  //--- Build the transfers ---
+  for (size_t zPacket = 0; zPacket < PacketCount; ++zPacket)
+  {
+    const SPIInterface_Packet* pPacket = &pDev->Packets[zPacket];
+    const bool UseDummy = (pPacket->Config.Bits.UseDummyByte > 0) || (pPacket->TxData == NULL);
+    if (UseDummy && (pPacket->DummyByte != 0x00))
+    {
+      if (DummyFilled && (DummyByte != pPacket->DummyByte)) return ERR__NOT_SUPPORTED; // Only one non-zero dummy byte value per message
+      if (DummyFilled == false) memset(&pDev->DummyBuffer[0], pPacket->DummyByte, SPI_LINUXDEV_DUMMY_BUFFER_SIZE);
+      DummyFilled = true;
+      DummyByte   = pPacket->DummyByte;
+    }
+    size_t Offset = 0;
+    do
+    {
+      if (TransferCount >= SPI_LINUXDEV_MAX_TRANSFERS) return ERR__SPI_OVERFLOW_ERROR;
+      struct spi_ioc_transfer* pTransfer = &Transfers[TransferCount++];
+      size_t Size = pPacket->DataSize - Offset;
+      if (UseDummy && (pPacket->DummyByte != 0x00) && (Size > SPI_LINUXDEV_DUMMY_BUFFER_SIZE)) Size = SPI_LINUXDEV_DUMMY_BUFFER_SIZE;
+      if (UseDummy == false) pTransfer->tx_buf = (uintptr_t)&pPacket->TxData[Offset];
+      else if (pPacket->DummyByte != 0x00) pTransfer->tx_buf = (uintptr_t)&pDev->DummyBuffer[0];
+      // else tx_buf = 0: the controller sends zeros
+      if (pPacket->RxData != NULL) pTransfer->rx_buf = (uintptr_t)&pPacket->RxData[Offset];
+      pTransfer->len           = (uint32_t)Size;
+      pTransfer->speed_hz      = pChip->SpeedHz;
+      pTransfer->bits_per_word = pChip->BitsPerWord;
+      Offset += Size;
+    } while (Offset < pPacket->DataSize);
+  }
+
+  //--- Transfer all in one syscall ---
+  if ((terminate == false) && (TransferCount > 0)) Transfers[TransferCount - 1].cs_change = 1; // cs_change on the last transfer: the chip select stays asserted after the message
+  pDev->IoctlCount++;
+  pDev->ChipSelectHeld = false;
+  if (__SPI_LinuxDev_Ioctl(pDev, pChip->Fd, SPI_IOC_MESSAGE(TransferCount), &Transfers[0]) < 0) return __SPI_LinuxDev_Errno(errno);
+  pDev->TransferCount += (uint32_t)TransferCount;
+  pDev->ChipSelectHeld = (terminate == false);
+  pDev->HeldChipSelect = pDev->Packets[0].ChipSelect;
+
+  //--- CRC and endian transform of the received data of all the packets, now that they are available ---
+  eERRORRESULT FirstError = ERR_NONE;
+  for (size_t zPacket = 0; zPacket < PacketCount; ++zPacket)
+  {
+    SPIInterface_Packet* pPacket = &pDev->Packets[zPacket];
+    eERRORRESULT Error = Interface_SPIpacketCRC(pPacket);                         // On the bus bytes, before the endian transform
+    if (FirstError == ERR_NONE) FirstError = Error;
+    const eEndianTransform Transform = (eEndianTransform)SPI_ENDIAN_TRANSFORM_GET(pPacket->Config.Value);
+    if ((pPacket->RxData == NULL) || (Transform == ENDIAN_NO_CHANGE)) continue;
+    Error = EndianTransform_InPlace(pPacket->RxData, pPacket->DataSize, Transform);
+    if (FirstError == ERR_NONE) FirstError = Error;
+  }
+  return FirstError;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux spidev backend functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure a SPI_Interface to use Linux spidev devices
+//=============================================================================
+eERRORRESULT SPI_LinuxDev_Attach(SPI_Interface *pIntDev, SPI_LinuxDev* pDev)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pDev == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pDev->pChips == NULL) || (pDev->ChipCount == 0)) return ERR__SPI_CONFIG_ERROR;
+  for (size_t zChip = 0; zChip < pDev->ChipCount; ++zChip) pDev->pChips[zChip].Configured = false;
+  pDev->PacketCount    = 0;
+  pDev->ChipSelectHeld = false;
+  pDev->IoctlCount     = 0;
+  pDev->TransferCount  = 0;
+  pDev->ConfigCount    = 0;
+  pIntDev->InterfaceDevice           = pDev;
+  pIntDev->UniqueID                  = 0;
+  pIntDev->fnSPI_Init                = SPI_LinuxDev_Init;
+  pIntDev->fnSPI_Transfer            = SPI_LinuxDev_Transfer;
+  pIntDev->fnSPI_TransferSegmentList = NULL;                                         // The generic segment list is chained in one SPI_IOC_MESSAGE(N)
+  pIntDev->fnSPI_TransferPhases      = SPI_LinuxDev_TransferPhases;
+  pIntDev->fnSPI_TransferAsync       = NULL;
+  pIntDev->Channel                   = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Linux spidev initialization
+//=============================================================================
+eERRORRESULT SPI_LinuxDev_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_LinuxDev* pDev = (SPI_LinuxDev*)pIntDev->InterfaceDevice;
+  if (chipSelect >= pDev->ChipCount) return ERR__SPI_CONFIG_ERROR;
+  if (sckFreq == 0) return ERR__SPI_FREQUENCY_ERROR;
+  SPI_LinuxDevChip* pChip = &pDev->pChips[chipSelect];
+  if (pChip->Fd < 0)
+  {
+    if (pChip->pDevicePath == NULL) return ERR__SPI_CONFIG_ERROR;
+    pChip->Fd = open(pChip->pDevicePath, O_RDWR | O_CLOEXEC);
+    if (pChip->Fd < 0) return ERR__SPI_CONFIG_ERROR;
+    pChip->Configured = false;
+  }
+
+  //--- Convert the mode ---
+  uint32_t Mode = 0;
+  if (SPI_CPHA_GET(mode) > 0) Mode |= SPI_CPHA;
+  if (SPI_CPOL_GET(mode) > 0) Mode |= SPI_CPOL;
+  if (((uint16_t)mode & SPI_INTERFACE_LSB_FIRST) > 0) Mode |= SPI_LSB_FIRST;
+  switch (SPI_PIN_COUNT_GET(mode))
+  {
+    case 0: Mode |= SPI_3WIRE; break;
+    case 1: break;
+    case 2: Mode |= SPI_TX_DUAL | SPI_RX_DUAL; break;
+    case 4: Mode |= SPI_TX_QUAD | SPI_RX_QUAD; break;
+    default: return ERR__NOT_SUPPORTED;
+  }
+  uint8_t BitsPerWord = (uint8_t)SPI_DATA_BITCOUNT_GET(mode);
+  if (BitsPerWord == 0) BitsPerWord = 8;
+
+  //--- Apply only what changed ---
+  if ((pChip->Configured == false) || (pChip->Mode != Mode))
+  {
+    pDev->ConfigCount++;
+    if (__SPI_LinuxDev_Ioctl(pDev, pChip->Fd, SPI_IOC_WR_MODE32, &Mode) < 0) { pChip->Configured = false; return __SPI_LinuxDev_Errno(errno); }
+  }
+  if ((pChip->Configured == false) || (pChip->BitsPerWord != BitsPerWord))
+  {
+    pDev->ConfigCount++;
+    if (__SPI_LinuxDev_Ioctl(pDev, pChip->Fd, SPI_IOC_WR_BITS_PER_WORD, &BitsPerWord) < 0) { pChip->Configured = false; return __SPI_LinuxDev_Errno(errno); }
+  }
+  uint32_t SpeedHz = sckFreq;
+  if ((pChip->Configured == false) || (pChip->SpeedHz != SpeedHz))
+  {
+    pDev->ConfigCount++;
+    if (__SPI_LinuxDev_Ioctl(pDev, pChip->Fd, SPI_IOC_WR_MAX_SPEED_HZ, &SpeedHz) < 0) { pChip->Configured = false; return __SPI_LinuxDev_Errno(errno); }
+  }
+  pChip->Mode        = Mode;
+  pChip->BitsPerWord = BitsPerWord;
+  pChip->SpeedHz     = SpeedHz;
+  pChip->Configured  = true;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Linux spidev transfer
+//=============================================================================
+eERRORRESULT SPI_LinuxDev_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_LinuxDev* pDev = (SPI_LinuxDev*)pIntDev->InterfaceDevice;
+  if (pPacketDesc->ChipSelect >= pDev->ChipCount) return ERR__SPI_CONFIG_ERROR;
+  if (pDev->pChips[pPacketDesc->ChipSelect].Configured == false) return ERR__SPI_CONFIG_ERROR;
+  if ((pPacketDesc->Config.Bits.UseDummyByte == 0) && (pPacketDesc->TxData == NULL) && (pPacketDesc->DataSize > 0) && (pPacketDesc->RxData == NULL)) return ERR__NULL_BUFFER;
+  pPacketDesc->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;                           // The endian transform is done after the ioctl
+  pPacketDesc->Config.Value |= SPI_ENDIAN_RESULT_SET(SPI_ENDIAN_TRANSFORM_GET(pPacketDesc->Config.Value));
+
+  //--- Collect the packet ---
+  if (((pDev->PacketCount > 0) && (pDev->Packets[0].ChipSelect != pPacketDesc->ChipSelect))
+   || (pDev->ChipSelectHeld && (pDev->HeldChipSelect != pPacketDesc->ChipSelect)))
+  {
+    pDev->PacketCount = 0;                                                        // The chip select can't change while asserted, drop the whole transfer
+    return ERR__SPI_CONFIG_ERROR;
+  }
+  if (pDev->PacketCount >= SPI_LINUXDEV_MAX_TRANSFERS)
+  {
+    pDev->PacketCount = 0;                                                        // Drop the whole transfer
+    return ERR__SPI_OVERFLOW_ERROR;
+  }
+  pDev->Packets[pDev->PacketCount++] = *pPacketDesc;
+  if ((pPacketDesc->Terminate == false) && (pPacketDesc->RxData == NULL)) return ERR_NONE; // Only the transmit packets wait for the terminate
+
+  //--- Terminate or received data: transfer everything, the received data shall be available at return ---
+  return __SPI_LinuxDev_Flush(pDev, pPacketDesc->Terminate);
+}
+
+
+//=============================================================================
+// Linux spidev phase transfer
+//=============================================================================
+eERRORRESULT SPI_LinuxDev_TransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPhasePacket == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_LinuxDev* pDev = (SPI_LinuxDev*)pIntDev->InterfaceDevice;
+  if (pPhasePacket->ChipSelect >= pDev->ChipCount) return ERR__SPI_CONFIG_ERROR;
+  SPI_LinuxDevChip* pChip = &pDev->pChips[pPhasePacket->ChipSelect];
+  if (pChip->Configured == false) return ERR__SPI_CONFIG_ERROR;
+  if ((pDev->PacketCount > 0) || pDev->ChipSelectHeld) return ERR__SPI_BUSY;    // A packet transfer is in progress, its ChipSelect is asserted
+  const bool HasAddress = (pPhasePacket->AddressSize > 0);
+  const bool HasData    = (pPhasePacket->DataSize > 0);
+  const eSPI_PhaseLines DummyLines = (HasAddress ? pPhasePacket->AddressLines : pPhasePacket->InstructionLines);
+  if (pPhasePacket->AddressSize > 4u) return ERR__SPI_PARAMETER_ERROR;
+  if (HasData && (pPhasePacket->TxData == NULL) && (pPhasePacket->RxData == NULL)) return ERR__NULL_BUFFER;
+  if ((pPhasePacket->InstructionLines > SPI_PHASE_4_LINES) || (pPhasePacket->InstructionLines == 3)) return ERR__NOT_SUPPORTED;
+  if (HasAddress && ((pPhasePacket->AddressLines == SPI_PHASE_NONE) || (pPhasePacket->AddressLines > SPI_PHASE_4_LINES) || (pPhasePacket->AddressLines == 3))) return ERR__NOT_SUPPORTED;
+  if (HasData && ((pPhasePacket->DataLines == SPI_PHASE_NONE) || (pPhasePacket->DataLines > SPI_PHASE_4_LINES) || (pPhasePacket->DataLines == 3))) return ERR__NOT_SUPPORTED;
+  if ((pPhasePacket->DummyCycles > 0) && ((DummyLines == SPI_PHASE_NONE) || (((pPhasePacket->DummyCycles * DummyLines) % 8u) > 0))) return ERR__NOT_SUPPORTED; // spidev transfers whole bytes
+
+  //--- One transfer per phase, each with its own line count ---
+  struct spi_ioc_transfer Transfers[4];
+  uint8_t Header[1 + 4];
+  size_t TransferCount = 0;
+  memset(&Transfers[0], 0, sizeof(Transfers));
+  Header[0] = pPhasePacket->Instruction;
+  for (size_t zByte = 0; zByte < pPhasePacket->AddressSize; ++zByte)             // Address MSB first
+    Header[1 + zByte] = (uint8_t)(pPhasePacket->Address >> ((pPhasePacket->AddressSize - 1 - zByte) * 8u));
+  if (pPhasePacket->InstructionLines != SPI_PHASE_NONE)
+  {
+    Transfers[TransferCount].tx_buf   = (uintptr_t)&Header[0];
+    Transfers[TransferCount].len      = 1;
+    Transfers[TransferCount].tx_nbits = (uint8_t)pPhasePacket->InstructionLines;
+    ++TransferCount;
+  }
+  if (HasAddress)
+  {
+    Transfers[TransferCount].tx_buf   = (uintptr_t)&Header[1];
+    Transfers[TransferCount].len      = pPhasePacket->AddressSize;
+    Transfers[TransferCount].tx_nbits = (uint8_t)pPhasePacket->AddressLines;
+    ++TransferCount;
+  }
+  if (pPhasePacket->DummyCycles > 0)                                             // tx_buf = 0: the controller sends zeros
+  {
+    Transfers[TransferCount].len      = ((uint32_t)pPhasePacket->DummyCycles * DummyLines) / 8u;
+    Transfers[TransferCount].tx_nbits = (uint8_t)DummyLines;
+    ++TransferCount;
+  }
+  if (HasData)
+  {
+    if (pPhasePacket->RxData != NULL)
+    {
+      Transfers[TransferCount].rx_buf   = (uintptr_t)pPhasePacket->RxData;
+      Transfers[TransferCount].rx_nbits = (uint8_t)pPhasePacket->DataLines;
+    }
+    else
+    {
+      Transfers[TransferCount].tx_buf   = (uintptr_t)pPhasePacket->TxData;
+      Transfers[TransferCount].tx_nbits = (uint8_t)pPhasePacket->DataLines;
+    }
+    Transfers[TransferCount].len = (uint32_t)pPhasePacket->DataSize;
+    ++TransferCount;
+  }
+  if (TransferCount == 0) return ERR_NONE;
+  for (size_t zTransfer = 0; zTransfer < TransferCount; ++zTransfer)
+  {
+    Transfers[zTransfer].speed_hz      = pChip->SpeedHz;
+    Transfers[zTransfer].bits_per_word = 8;
+  }
+
+  //--- Transfer all in one syscall ---
+  pDev->IoctlCount++;
+  if (__SPI_LinuxDev_Ioctl(pDev, pChip->Fd, SPI_IOC_MESSAGE(TransferCount), &Transfers[0]) < 0) return __SPI_LinuxDev_Errno(errno);
+  pDev->TransferCount += (uint32_t)TransferCount;
+
+  //--- Endian transform of the received data ---
+  const eEndianTransform Transform = (eEndianTransform)SPI_ENDIAN_TRANSFORM_GET(pPhasePacket->Config.Value);
+  if ((pPhasePacket->RxData != NULL) && (Transform != ENDIAN_NO_CHANGE))
+  {
+    const eERRORRESULT Error = EndianTransform_InPlace(pPhasePacket->RxData, pPhasePacket->DataSize, Transform);
+    if (Error != ERR_NONE) return Error;
+  }
+  pPhasePacket->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;
+  pPhasePacket->Config.Value |= SPI_ENDIAN_RESULT_SET(Transform);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Close all the Linux spidev devices
+//=============================================================================
+void SPI_LinuxDev_Close(SPI_LinuxDev* pDev)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pDev == NULL) return;
+#endif
+  for (size_t zChip = 0; zChip < pDev->ChipCount; ++zChip)
+  {
+    if (pDev->pChips[zChip].Fd >= 0) close(pDev->pChips[zChip].Fd);
+    pDev->pChips[zChip].Fd         = -1;
+    pDev->pChips[zChip].Configured = false;
+  }
+  pDev->PacketCount    = 0;
+  pDev->ChipSelectHeld = false;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif // #if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
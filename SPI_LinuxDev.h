@@ -0,0 +1,183 @@
+/*!*****************************************************************************
+ * @file    SPI_LinuxDev.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.1.0
+ * @date    16/10/2026
+ * @brief   Linux spidev backend of the SPI interface
+ * @details This backend plugs the /dev/spidevB.C character devices into the
+ * generic SPI_Interface of all the https://github.com/Emandhal drivers and
+ * developments. Each ChipSelect index is a spidev device. Transmit only packets
+ * with Terminate = 'false' are collected until a packet with Terminate = 'true'
+ * or a packet that receives data, and then transferred as one
+ * SPI_IOC_MESSAGE(N), the chip select stays asserted during the whole message
+ * and after it if the last packet has Terminate = 'false'. The mode, bit count
+ * and clock of a device are only sent to the kernel when they change. The
+ * phase packets of Dual/Quad-SPI memories use the tx_nbits/rx_nbits of each
+ * transfer.
+ * The ioctl() function can be replaced by a shim to test without hardware
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.1.0    Add the phase transfer of Dual/Quad-SPI memories
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_LINUXDEV_H_INC
+#define __SPI_LINUXDEV_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef SPI_LINUXDEV_MAX_TRANSFERS
+#  define SPI_LINUXDEV_MAX_TRANSFERS       ( 16u )  //!< Max transfers in one SPI_IOC_MESSAGE(N)
+#endif
+#ifndef SPI_LINUXDEV_DUMMY_BUFFER_SIZE
+#  define SPI_LINUXDEV_DUMMY_BUFFER_SIZE   ( 256u ) //!< Size of the buffer of dummy bytes sent while receiving with a non-zero DummyByte. Longer receives are split in several transfers
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux spidev backend
+//********************************************************************************************************************
+
+/*! @brief Function that performs an ioctl on a spidev file descriptor
+ *
+ * Same prototype and behavior as the ioctl() of the C library: returns -1 and sets errno in case of error
+ * @param[in] fd Is the file descriptor of the spidev device
+ * @param[in] request Is the ioctl request (SPI_IOC_MESSAGE(N), SPI_IOC_WR_MODE32...)
+ * @param[in,out] *pArg Is the argument of the request
+ * @return Returns -1 in case of error, else a non-negative value
+ */
+typedef int (*SPI_LinuxIoctl_Func)(int fd, unsigned long request, void* pArg);
+
+
+//! @brief spidev device of a ChipSelect index
+typedef struct SPI_LinuxDevChip
+{
+  const char* pDevicePath; //!< Path of the spidev device (ex: "/dev/spidev0.1"). Opened by SPI_LinuxDev_Init() if Fd is negative
+  int Fd;                  //!< File descriptor of the spidev device. Set to -1 before initialization or set an already opened file descriptor
+  //--- Configuration applied to the kernel ---
+  bool Configured;         //!< 'true' if the following values have been applied to the device
+  uint32_t Mode;           //!< SPI mode flags of the kernel (SPI_CPHA, SPI_CPOL, SPI_LSB_FIRST, SPI_3WIRE, SPI_TX_DUAL...)
+  uint8_t BitsPerWord;     //!< Bits per word
+  uint32_t SpeedHz;        //!< Max SCK frequency in Hz
+} SPI_LinuxDevChip;
+
+
+//! @brief Linux spidev backend. Set this structure as the SPI_Interface.InterfaceDevice
+typedef struct SPI_LinuxDev
+{
+  SPI_LinuxDevChip* pChips;                                //!< spidev devices, indexed by SPIInterface_Packet.ChipSelect
+  size_t ChipCount;                                        //!< Count of spidev devices
+  SPI_LinuxIoctl_Func fnIoctl;                             //!< This function will be called instead of ioctl(). Set to NULL to use ioctl()
+  //--- Backend state ---
+  size_t PacketCount;                                      //!< Count of packets collected since the last terminate
+  bool ChipSelectHeld;                                     //!< 'true' if the last message ended without terminate, its chip select is still asserted
+  uint8_t HeldChipSelect;                                  //!< ChipSelect of the last message, asserted if ChipSelectHeld is 'true'
+  SPIInterface_Packet Packets[SPI_LINUXDEV_MAX_TRANSFERS]; //!< Packets collected since the last terminate. Their buffers shall stay valid until the terminate
+  uint8_t DummyBuffer[SPI_LINUXDEV_DUMMY_BUFFER_SIZE];     //!< Dummy bytes sent while receiving with a non-zero DummyByte
+  //--- Statistics ---
+  uint32_t IoctlCount;                                     //!< Count of SPI_IOC_MESSAGE(N) ioctls
+  uint32_t TransferCount;                                  //!< Count of spi_ioc_transfer transferred by the ioctls
+  uint32_t ConfigCount;                                    //!< Count of configuration ioctls (mode, bits per word, speed)
+} SPI_LinuxDev;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux spidev backend functions
+//********************************************************************************************************************
+
+/*! @brief Configure a SPI_Interface to use Linux spidev devices
+ *
+ * @param[out] *pIntDev Is the SPI interface container structure to configure
+ * @param[in] *pDev Is the spidev backend to use. Its devices shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_LinuxDev_Attach(SPI_Interface *pIntDev, SPI_LinuxDev* pDev);
+
+/*! @brief Linux spidev initialization (#SPIInit_Func compatible)
+ *
+ * Open the device of the ChipSelect if not already opened. The mode, the bit count (#SPI_DATA_BITCOUNT_GET, 8 if not set) and the SCK frequency are sent to the kernel only if they are different from the ones already applied
+ * @param[in] *pIntDev Is the SPI interface container structure used for the interface initialization
+ * @param[in] chipSelect Is the Chip Select index of the device to initialize
+ * @param[in] mode Is the mode of the SPI to configure
+ * @param[in] sckFreq Is the SCK frequency in Hz to set at the interface initialization
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_LinuxDev_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq);
+
+/*! @brief Linux spidev transfer (#SPITransferPacket_Func compatible)
+ *
+ * Transmit only packets are collected until a packet with Terminate = 'true' or a packet with RxData, then all of them are transferred in one SPI_IOC_MESSAGE(N) ioctl. A packet with RxData and Terminate = 'false' sets cs_change on the last transfer of the message: the chip select stays asserted for the next packets, which shall use the same ChipSelect
+ * The CRC and the endian transform of all the packets of the message are done before returning, even if one of them failed. The first error is returned
+ * @warning Communication errors of a transmit packet with Terminate = 'false' are returned by the next packet with RxData or Terminate = 'true'
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_LinuxDev_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief Linux spidev phase transfer (#SPITransferPhases_Func compatible)
+ *
+ * Each phase is a transfer with its own tx_nbits/rx_nbits, all the phases are transferred in one SPI_IOC_MESSAGE(N) ioctl. The dummy cycles are sent as zeros with the line count of the address phase and shall be whole bytes
+ * The Dual/Quad line counts need a device initialized with a Dual/Quad-SPI mode (SPI_TX_DUAL/SPI_RX_DUAL, SPI_TX_QUAD/SPI_RX_QUAD)
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPhasePacket Is the phase packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_LinuxDev_TransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket);
+
+/*! @brief Close all the Linux spidev devices
+ *
+ * @param[in] *pDev Is the spidev backend
+ */
+void SPI_LinuxDev_Close(SPI_LinuxDev* pDev);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_LINUXDEV_H_INC */
@@ -0,0 +1,845 @@
+/*!*****************************************************************************
+ * @file    SPI_SDcard.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   SD card block device over SPI
+ * @details This block device reads and writes SD cards in SPI mode through
+ *          the SPI_Interface for all the https://github.com/Emandhal drivers
+ *          and developments
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "SPI_SDcard.h"
+#include "CRC.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_SDCARD_RESPONSE_WINDOW  ( SPI_SDCARD_NCR_WINDOW + 4u ) //!< Response window of a blocking command, room for the 4 bytes after the R1 of the R3 and R7 responses
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SD card over SPI internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Fill a command frame
+//=============================================================================
+static void __SPI_SDcard_FillCommand(uint8_t* pBuffer, uint8_t command, uint32_t argument)
+{
+  pBuffer[0] = 0x40u | (command & 0x3Fu);                                                          // Start bit, transmission bit and command index
+  pBuffer[1] = (uint8_t)(argument >> 24);
+  pBuffer[2] = (uint8_t)(argument >> 16);
+  pBuffer[3] = (uint8_t)(argument >>  8);
+  pBuffer[4] = (uint8_t)(argument >>  0);
+  pBuffer[5] = (uint8_t)((CRC_Compute(CRC7_MMC, pBuffer, 5) << 1) | 0x01u);                        // Always valid, the CRC of CMD0 and CMD8 are checked even if the CRC is disabled
+}
+
+
+//=============================================================================
+// [STATIC] Get the argument of a block address
+//=============================================================================
+static uint32_t __SPI_SDcard_Address(const SPI_SDcard* pSD, uint32_t block)
+{
+  return (pSD->CardType == SPI_SDCARD_SDHC ? block : block * SPI_SDCARD_BLOCK_SIZE);
+}
+
+
+//=============================================================================
+// [STATIC] Find the first byte that is not 0xFF in a window. Returns the size of the window if not found
+//=============================================================================
+static size_t __SPI_SDcard_FindByte(const uint8_t* pWindow, size_t size)
+{
+  size_t Index = 0;
+  while ((Index < size) && (pWindow[Index] == 0xFF)) Index++;
+  return Index;
+}
+
+
+//=============================================================================
+// [STATIC] Find the R1 response in a window. Returns the size of the window if not found
+//=============================================================================
+static size_t __SPI_SDcard_FindR1(const uint8_t* pWindow, size_t size)
+{
+  size_t Index = 0;
+  while ((Index < size) && ((pWindow[Index] & SPI_SDCARD_R1_NO_RESPONSE) > 0)) Index++;
+  return Index;
+}
+
+
+//=============================================================================
+// [STATIC] Convert a R1 response to an error
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_R1toError(uint8_t r1)
+{
+  if ((r1 & SPI_SDCARD_R1_NO_RESPONSE) > 0) return ERR__NO_CARD;
+  if ((r1 & (SPI_SDCARD_R1_ADDRESS_ERROR | SPI_SDCARD_R1_PARAMETER_ERROR)) > 0) return ERR__CARD_OUT_OF_RANGE;
+  if ((r1 & (SPI_SDCARD_R1_ILLEGAL_COMMAND | SPI_SDCARD_R1_COM_CRC_ERROR | SPI_SDCARD_R1_ERASE_SEQ_ERROR)) > 0) return ERR__CARD_COMMAND_ERROR;
+  if ((r1 & SPI_SDCARD_R1_IDLE) > 0) return ERR__CARD_ERROR;                                       // The card has been reset
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Convert an error token of a read to an error
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_ErrorTokenToError(uint8_t token)
+{
+  if ((token & SPI_SDCARD_ERROR_TOKEN_RANGE) > 0) return ERR__CARD_OUT_OF_RANGE;
+  if ((token & SPI_SDCARD_ERROR_TOKEN_ECC  ) > 0) return ERR__CARD_ECC_FAIL;
+  return ERR__CARD_ERROR;
+}
+
+
+//=============================================================================
+// [STATIC] Check the CRC of a block received
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_CheckBlockCRC(const SPI_SDcard* pSD, const uint8_t* pData, size_t size, const uint8_t* pCRC)
+{
+  if (pSD->UseCRC == false) return ERR_NONE;
+  const uint16_t CRC = (uint16_t)CRC_Compute(CRC16_XMODEM, pData, size);
+  if ((pCRC[0] != (uint8_t)(CRC >> 8)) || (pCRC[1] != (uint8_t)CRC)) return ERR__CRC_ERROR;
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+//=============================================================================
+// [STATIC] Blocking transfer. A NULL pTxData sends 0xFF
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_Transfer(SPI_SDcard* pSD, uint8_t* pTxData, uint8_t* pRxData, size_t size, bool terminate)
+{
+  SPIInterface_Packet Packet;
+  Packet.Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) | (pTxData == NULL ? SPI_USE_DUMMYBYTE_FOR_RECEIVE : SPI_USE_TXDATA_FOR_RECEIVE);
+  Packet.ChipSelect = pSD->ChipSelect;
+  Packet.DummyByte  = 0xFF;
+  Packet.TxData     = pTxData;
+  Packet.RxData     = pRxData;
+  Packet.DataSize   = size;
+  Packet.Terminate  = terminate;
+  Packet.pCRC       = NULL;
+  return pSD->pSPI->fnSPI_Transfer(pSD->pSPI, &Packet);
+}
+
+
+//=============================================================================
+// [STATIC] Blocking command. The bytes that follow the R1 response are stored in pResponse
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_Command(SPI_SDcard* pSD, uint8_t command, uint32_t argument, uint8_t* pR1, uint8_t* pResponse, size_t responseSize, bool terminate)
+{
+  uint8_t* pBuffer = &pSD->Command[0];
+  __SPI_SDcard_FillCommand(pBuffer, command, argument);
+  memset(&pBuffer[SPI_SDCARD_COMMAND_SIZE], 0xFF, SPI_SDCARD_RESPONSE_WINDOW);
+  eERRORRESULT Error = __SPI_SDcard_Transfer(pSD, pBuffer, pBuffer, SPI_SDCARD_COMMAND_SIZE + SPI_SDCARD_RESPONSE_WINDOW, terminate); // The command and its response window in place
+  if (Error != ERR_NONE) return Error;
+  const uint8_t* pWindow = &pBuffer[SPI_SDCARD_COMMAND_SIZE];
+  const size_t Index = __SPI_SDcard_FindR1(pWindow, SPI_SDCARD_NCR_WINDOW);
+  if (Index >= SPI_SDCARD_NCR_WINDOW) return ERR__NO_CARD;
+  *pR1 = pWindow[Index];
+  if (pResponse != NULL) memcpy(pResponse, &pWindow[Index + 1], responseSize);                     // The window has room for the response after the last possible R1
+  pSD->CarryCount = SPI_SDCARD_RESPONSE_WINDOW - 1u - Index;                                       // The bytes after the R1 can hold the start of a data block
+  memcpy(&pSD->Carry[0], &pWindow[Index + 1], pSD->CarryCount);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Blocking receive of a data block after a command
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_ReceiveData(SPI_SDcard* pSD, uint8_t* pData, size_t size)
+{
+  uint8_t Window[SPI_SDCARD_POLL_WINDOW];
+  const uint32_t Start_ms = pSD->fnGetCurrentms();
+  size_t Count = pSD->CarryCount;
+  memcpy(&Window[0], &pSD->Carry[0], Count);                                                       // Search the token in the bytes received after the R1 first
+  while (true)
+  {
+    const size_t Index = __SPI_SDcard_FindByte(&Window[0], Count);
+    if (Index < Count)
+    {
+      if (Window[Index] != SPI_SDCARD_TOKEN_START_BLOCK) return __SPI_SDcard_ErrorTokenToError(Window[Index]);
+      size_t Carry = Count - 1u - Index;
+      uint8_t CRC[2];
+      if (Carry > size) Carry = size;
+      memcpy(pData, &Window[Index + 1], Carry);
+      eERRORRESULT Error = __SPI_SDcard_Transfer(pSD, NULL, &pData[Carry], size - Carry, false);
+      if (Error != ERR_NONE) return Error;
+      Error = __SPI_SDcard_Transfer(pSD, NULL, &CRC[0], sizeof(CRC), true);
+      if (Error != ERR_NONE) return Error;
+      return __SPI_SDcard_CheckBlockCRC(pSD, pData, size, &CRC[0]);
+    }
+    if ((pSD->fnGetCurrentms() - Start_ms) > SPI_SDCARD_TOKEN_TIMEOUT_ms) return ERR__DEVICE_TIMEOUT;
+    Count = sizeof(Window);
+    const eERRORRESULT Error = __SPI_SDcard_Transfer(pSD, NULL, &Window[0], Count, false);
+    if (Error != ERR_NONE) return Error;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+
+//=============================================================================
+// [STATIC] Queue a transfer of the phase in progress. A NULL pTxData sends 0xFF
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_Queue(SPI_SDcard* pSD, uint8_t* pTxData, uint8_t* pRxData, size_t size, bool terminate)
+{
+  SPIInterface_Packet* pPacket = &pSD->Packets[pSD->TransferCount];
+  SPIInterface_Transaction* pTransaction = &pSD->Transactions[pSD->TransferCount];
+  pPacket->Config.Value = SPI_BLOCKING | SPI_ENDIAN_TRANSFORM_SET(SPI_NO_ENDIAN_CHANGE) | (pTxData == NULL ? SPI_USE_DUMMYBYTE_FOR_RECEIVE : SPI_USE_TXDATA_FOR_RECEIVE);
+  pPacket->ChipSelect = pSD->ChipSelect;
+  pPacket->DummyByte  = 0xFF;
+  pPacket->TxData     = pTxData;
+  pPacket->RxData     = pRxData;
+  pPacket->DataSize   = size;
+  pPacket->Terminate  = terminate;
+  pPacket->pCRC       = NULL;
+  pTransaction->pPacketDesc = pPacket;
+  pTransaction->fnComplete  = NULL;
+  pTransaction->pContext    = pSD;
+  const eERRORRESULT Error = Interface_SPItransferAsync(pSD->pSPI, pTransaction);
+  if (Error != ERR_NONE) return Error;
+  pSD->TransferCount++;
+  pSD->Selected = (terminate == false);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Check the end of the transfers of the phase in progress. Returns 'false' if a transfer is still in progress
+//=============================================================================
+static bool __SPI_SDcard_TransfersDone(SPI_SDcard* pSD, eERRORRESULT* pError)
+{
+  *pError = ERR_NONE;
+  for (size_t zIdx = 0; zIdx < pSD->TransferCount; ++zIdx)
+  {
+    eERRORRESULT Result = ERR_NONE;
+    if (Interface_SPIisTransactionComplete(&pSD->Transactions[zIdx], &Result) == false) return false;
+    if ((Result != ERR_NONE) && (*pError == ERR_NONE)) *pError = Result;
+  }
+  pSD->TransferCount = 0;
+  return true;
+}
+
+
+//=============================================================================
+// [STATIC] Complete the request in progress
+//=============================================================================
+static void __SPI_SDcard_CompleteRequest(SPI_SDcard* pSD, eERRORRESULT result)
+{
+  SPI_SDcardRequest* pRequest = pSD->pHead;
+  if (pRequest == NULL) return;
+  pSD->pHead = pRequest->pNext;
+  if (pSD->pHead == NULL) pSD->pTail = NULL;
+  pRequest->pNext  = NULL;
+  pRequest->Result = result;
+#if defined(__GNUC__)
+  __sync_synchronize();                                                                            // The result shall be visible before the completion flag
+#endif
+  pRequest->Status = SPI_SDCARD_REQUEST_COMPLETE;
+}
+
+
+//=============================================================================
+// [STATIC] Fail the request in progress. The data command in progress is stopped
+//=============================================================================
+static void __SPI_SDcard_Fail(SPI_SDcard* pSD, eERRORRESULT error)
+{
+  __SPI_SDcard_CompleteRequest(pSD, error);
+  if (pSD->Stream == SPI_SDCARD_STREAM_SINGLE) pSD->Stream = SPI_SDCARD_STREAM_NONE;
+  pSD->MoreBlocks = false;                                                                         // A multiple block write shall be stopped after a rejected block, even without a next request
+  pSD->Phase = SPI_SDCARD_PHASE_IDLE;                                                              // The idle phase stops a multiple block command
+}
+
+
+//=============================================================================
+// [STATIC] Is the block after the block in progress in the same data command?
+//=============================================================================
+static bool __SPI_SDcard_HasNextBlock(const SPI_SDcard* pSD)
+{
+  const SPI_SDcardRequest* pRequest = pSD->pHead;
+  if ((pSD->Stream != SPI_SDCARD_STREAM_READ) && (pSD->Stream != SPI_SDCARD_STREAM_WRITE)) return false;
+  if ((pRequest->DoneCount + 1u) < pRequest->BlockCount) return true;
+  const SPI_SDcardRequest* pNext = pRequest->pNext;                                                // The next request shall follow on the card, in the same direction
+  return (pNext != NULL) && (pNext->Write == pRequest->Write) && (pNext->Block == (pRequest->Block + pRequest->BlockCount));
+}
+
+
+//=============================================================================
+// [STATIC] Get the count of blocks of the requests that follow each other from the request in progress
+//=============================================================================
+static uint32_t __SPI_SDcard_ContiguousBlocks(const SPI_SDcard* pSD)
+{
+  const SPI_SDcardRequest* pRequest = pSD->pHead;
+  uint32_t Count = pRequest->BlockCount;
+  while ((pRequest->pNext != NULL) && (pRequest->pNext->Write == pRequest->Write) && (pRequest->pNext->Block == (pRequest->Block + pRequest->BlockCount)))
+  {
+    pRequest = pRequest->pNext;
+    Count += pRequest->BlockCount;
+  }
+  return Count;
+}
+
+
+//=============================================================================
+// [STATIC] Search the data token of the next block in a window and start its receive
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_StartRead(SPI_SDcard* pSD, const uint8_t* pWindow, size_t size)
+{
+  const size_t Index = __SPI_SDcard_FindByte(pWindow, size);
+  if (Index >= size)                                                                               // No token yet, poll again
+  {
+    pSD->Phase = SPI_SDCARD_PHASE_TOKEN;
+    pSD->TokenPollCount++;
+    return __SPI_SDcard_Queue(pSD, NULL, &pSD->Carry[0], SPI_SDCARD_POLL_WINDOW, false);
+  }
+  if (pWindow[Index] != SPI_SDCARD_TOKEN_START_BLOCK) return __SPI_SDcard_ErrorTokenToError(pWindow[Index]);
+
+  //--- Data of the block directly in the request, then its CRC with the window of the next token ---
+  SPI_SDcardRequest* pRequest = pSD->pHead;
+  uint8_t* pData = &pRequest->pData[(size_t)pRequest->DoneCount * SPI_SDCARD_BLOCK_SIZE];
+  const size_t Carry = size - 1u - Index;                                                          // The window is smaller than a block
+  memmove(pData, &pWindow[Index + 1], Carry);
+  pSD->MoreBlocks = __SPI_SDcard_HasNextBlock(pSD);
+  pSD->Phase = SPI_SDCARD_PHASE_READ;
+  const eERRORRESULT Error = __SPI_SDcard_Queue(pSD, NULL, &pData[Carry], SPI_SDCARD_BLOCK_SIZE - Carry, false);
+  if (Error != ERR_NONE) return Error;
+  return __SPI_SDcard_Queue(pSD, NULL, &pSD->Window[0], (pSD->MoreBlocks ? SPI_SDCARD_WINDOW_BUFFER_SIZE : 2u), false);
+}
+
+
+//=============================================================================
+// [STATIC] Start the send of the next block
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_StartWrite(SPI_SDcard* pSD)
+{
+  SPI_SDcardRequest* pRequest = pSD->pHead;
+  uint8_t* pData = &pRequest->pData[(size_t)pRequest->DoneCount * SPI_SDCARD_BLOCK_SIZE];
+  pSD->Token = (pSD->Stream == SPI_SDCARD_STREAM_WRITE ? SPI_SDCARD_TOKEN_START_MULTI : SPI_SDCARD_TOKEN_START_BLOCK);
+  memset(&pSD->Window[0], 0xFF, sizeof(pSD->Window));
+  if (pSD->UseCRC)
+  {
+    const uint16_t CRC = (uint16_t)CRC_Compute(CRC16_XMODEM, pData, SPI_SDCARD_BLOCK_SIZE);
+    pSD->Window[0] = (uint8_t)(CRC >> 8);
+    pSD->Window[1] = (uint8_t)CRC;
+  }
+  pSD->MoreBlocks = true;
+  pSD->Phase = SPI_SDCARD_PHASE_WRITE;
+
+  //--- Token, data from the request, then the CRC with the window of the data response and of the busy ---
+  eERRORRESULT Error = __SPI_SDcard_Queue(pSD, &pSD->Token, NULL, 1, false);
+  if (Error != ERR_NONE) return Error;
+  Error = __SPI_SDcard_Queue(pSD, pData, NULL, SPI_SDCARD_BLOCK_SIZE, false);
+  if (Error != ERR_NONE) return Error;
+  return __SPI_SDcard_Queue(pSD, &pSD->Window[0], &pSD->Window[0], SPI_SDCARD_WINDOW_BUFFER_SIZE, true); // The ChipSelect can be released while the card is busy
+}
+
+
+//=============================================================================
+// [STATIC] Start the command of the request in progress
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_StartCommand(SPI_SDcard* pSD)
+{
+  const SPI_SDcardRequest* pRequest = pSD->pHead;
+  const uint32_t Count = __SPI_SDcard_ContiguousBlocks(pSD);
+  const uint32_t Address = __SPI_SDcard_Address(pSD, pRequest->Block + pRequest->DoneCount);
+  uint8_t* pBuffer = &pSD->Command[0];
+  size_t Size = 0;
+  uint8_t Command;
+  memset(pBuffer, 0xFF, sizeof(pSD->Command));
+  if (pRequest->Write)
+  {
+    if (Count > 1)                                                                                 // Pre-erase count of the blocks known, the card can erase them ahead of the write
+    {
+      __SPI_SDcard_FillCommand(&pBuffer[Size], SPI_SDCARD_CMD55_APP_CMD, 0);
+      Size += SPI_SDCARD_COMMAND_SIZE + SPI_SDCARD_NCR_WINDOW;
+      __SPI_SDcard_FillCommand(&pBuffer[Size], SPI_SDCARD_ACMD23_SET_WR_BLK_ERASE_COUNT, (Count - pRequest->DoneCount) & 0x7FFFFFu);
+      Size += SPI_SDCARD_COMMAND_SIZE + SPI_SDCARD_NCR_WINDOW;
+      pSD->PreEraseCount++;
+    }
+    Command = (Count > 1 ? SPI_SDCARD_CMD25_WRITE_MULTIPLE_BLOCK : SPI_SDCARD_CMD24_WRITE_BLOCK);
+    pSD->Stream = (Count > 1 ? SPI_SDCARD_STREAM_WRITE : SPI_SDCARD_STREAM_SINGLE);
+    pSD->WriteCommandCount++;
+  }
+  else
+  {
+    Command = (Count > 1 ? SPI_SDCARD_CMD18_READ_MULTIPLE_BLOCK : SPI_SDCARD_CMD17_READ_SINGLE_BLOCK);
+    pSD->Stream = (Count > 1 ? SPI_SDCARD_STREAM_READ : SPI_SDCARD_STREAM_SINGLE);
+    pSD->ReadCommandCount++;
+  }
+  __SPI_SDcard_FillCommand(&pBuffer[Size], Command, Address);
+  Size += SPI_SDCARD_COMMAND_SIZE + SPI_SDCARD_NCR_WINDOW;
+  pSD->NextBlock = pRequest->Block + pRequest->DoneCount;
+  pSD->Phase = SPI_SDCARD_PHASE_COMMAND;
+  return __SPI_SDcard_Queue(pSD, pBuffer, pBuffer, Size, false);                                   // All the commands with their response windows in one transfer
+}
+
+
+//=============================================================================
+// [STATIC] Check the responses of the commands of a request and start its first block
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_EndCommand(SPI_SDcard* pSD)
+{
+  const size_t CommandCount = (pSD->Packets[0].DataSize / (SPI_SDCARD_COMMAND_SIZE + SPI_SDCARD_NCR_WINDOW));
+  const uint8_t* pWindow = &pSD->Command[0];
+  size_t Index = 0;
+  for (size_t zCmd = 0; zCmd < CommandCount; ++zCmd)
+  {
+    pWindow = &pSD->Command[(zCmd * (SPI_SDCARD_COMMAND_SIZE + SPI_SDCARD_NCR_WINDOW)) + SPI_SDCARD_COMMAND_SIZE];
+    Index = __SPI_SDcard_FindR1(pWindow, SPI_SDCARD_NCR_WINDOW);
+    if (Index >= SPI_SDCARD_NCR_WINDOW) return ERR__NO_CARD;
+    const eERRORRESULT Error = __SPI_SDcard_R1toError(pWindow[Index]);
+    if (Error != ERR_NONE) return Error;
+  }
+  if (pSD->pHead->Write) return __SPI_SDcard_StartWrite(pSD);
+  pSD->PhaseStart_ms = pSD->fnGetCurrentms();
+  return __SPI_SDcard_StartRead(pSD, &pWindow[Index + 1], SPI_SDCARD_NCR_WINDOW - 1u - Index); // The data token can already be in the response window
+}
+
+
+//=============================================================================
+// [STATIC] Go to the next block of a request, or complete it
+//=============================================================================
+static void __SPI_SDcard_NextBlock(SPI_SDcard* pSD)
+{
+  SPI_SDcardRequest* pRequest = pSD->pHead;
+  pRequest->DoneCount++;
+  pSD->NextBlock++;
+  if (pRequest->DoneCount >= pRequest->BlockCount) __SPI_SDcard_CompleteRequest(pSD, ERR_NONE);
+  if (pSD->Stream == SPI_SDCARD_STREAM_SINGLE) pSD->Stream = SPI_SDCARD_STREAM_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Continue the data command after a block written and the end of its busy
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_ContinueWrite(SPI_SDcard* pSD)
+{
+  const SPI_SDcardRequest* pRequest = pSD->pHead;
+  pSD->Phase = SPI_SDCARD_PHASE_IDLE;
+  if ((pSD->Stream != SPI_SDCARD_STREAM_WRITE) || (pSD->MoreBlocks == false) || (pRequest == NULL)) return ERR_NONE; // The idle phase stops the multiple block write if needed
+  if ((pRequest->Write == false) || ((pRequest->Block + pRequest->DoneCount) != pSD->NextBlock)) return ERR_NONE;
+  return __SPI_SDcard_StartWrite(pSD);                                                             // The next block follows, even from a request submitted during the command
+}
+
+
+//=============================================================================
+// [STATIC] Start the busy polling
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_StartBusy(SPI_SDcard* pSD)
+{
+  pSD->Phase = SPI_SDCARD_PHASE_BUSY;
+  pSD->BusyPollCount++;
+  return __SPI_SDcard_Queue(pSD, NULL, &pSD->Carry[0], SPI_SDCARD_POLL_WINDOW, true);              // The ChipSelect can be released while the card is busy
+}
+
+
+//=============================================================================
+// [STATIC] Stop the multiple block command in progress
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_Stop(SPI_SDcard* pSD)
+{
+  uint8_t* pBuffer = &pSD->Command[0];
+  size_t Size;
+  memset(pBuffer, 0xFF, sizeof(pSD->Command));
+  if (pSD->Stream == SPI_SDCARD_STREAM_READ)
+  {
+    __SPI_SDcard_FillCommand(pBuffer, SPI_SDCARD_CMD12_STOP_TRANSMISSION, 0);
+    Size = SPI_SDCARD_COMMAND_SIZE + 1u + SPI_SDCARD_NCR_WINDOW;                                   // A stuff byte is before the response
+  }
+  else
+  {
+    pBuffer[0] = SPI_SDCARD_TOKEN_STOP_TRAN;
+    Size = 2u + SPI_SDCARD_NCR_WINDOW;                                                             // The busy starts one byte after the token
+  }
+  pSD->Stream = SPI_SDCARD_STREAM_NONE;
+  pSD->Phase = SPI_SDCARD_PHASE_STOP;
+  pSD->StopCount++;
+  return __SPI_SDcard_Queue(pSD, pBuffer, pBuffer, Size, false);
+}
+
+
+//=============================================================================
+// [STATIC] Run the end of a phase and start the next one
+//=============================================================================
+static eERRORRESULT __SPI_SDcard_RunPhase(SPI_SDcard* pSD)
+{
+  SPI_SDcardRequest* pRequest = pSD->pHead;
+  eERRORRESULT Error = ERR_NONE;
+  switch (pSD->Phase)
+  {
+    case SPI_SDCARD_PHASE_IDLE:
+      if ((pSD->Stream == SPI_SDCARD_STREAM_WRITE) && pSD->MoreBlocks)
+      {
+        if (pRequest == NULL) return ERR_NONE;                                                     // Left open for a request submitted later that follows on the card, SPI_SDcard_WaitIdle() stops it
+        if (pRequest->Write && ((pRequest->Block + pRequest->DoneCount) == pSD->NextBlock)) return __SPI_SDcard_StartWrite(pSD);
+      }
+      if (pSD->Stream != SPI_SDCARD_STREAM_NONE) return __SPI_SDcard_Stop(pSD);                   // The multiple block command is not continued by the next request
+      if (pRequest != NULL) return __SPI_SDcard_StartCommand(pSD);
+      if (pSD->Selected == false) return ERR_NONE;
+      pSD->Phase = SPI_SDCARD_PHASE_DESELECT;                                                      // Nothing more to do, release the ChipSelect
+      return __SPI_SDcard_Queue(pSD, NULL, NULL, 1, true);
+
+    case SPI_SDCARD_PHASE_COMMAND:
+      Error = __SPI_SDcard_EndCommand(pSD);
+      break;
+
+    case SPI_SDCARD_PHASE_TOKEN:
+      if ((pSD->fnGetCurrentms() - pSD->PhaseStart_ms) > SPI_SDCARD_TOKEN_TIMEOUT_ms) { Error = ERR__DEVICE_TIMEOUT; break; }
+      Error = __SPI_SDcard_StartRead(pSD, &pSD->Carry[0], SPI_SDCARD_POLL_WINDOW);
+      break;
+
+    case SPI_SDCARD_PHASE_READ:
+    {
+      const uint8_t* pData = &pRequest->pData[(size_t)pRequest->DoneCount * SPI_SDCARD_BLOCK_SIZE];
+      Error = __SPI_SDcard_CheckBlockCRC(pSD, pData, SPI_SDCARD_BLOCK_SIZE, &pSD->Window[0]);
+      if (Error != ERR_NONE) break;
+      pSD->BlockReadCount++;
+      const bool MoreBlocks = pSD->MoreBlocks;
+      __SPI_SDcard_NextBlock(pSD);
+      pSD->Phase = SPI_SDCARD_PHASE_IDLE;
+      if (MoreBlocks == false) return ERR_NONE;                                                    // The idle phase stops the multiple block read
+      pSD->PhaseStart_ms = pSD->fnGetCurrentms();
+      Error = __SPI_SDcard_StartRead(pSD, &pSD->Window[2], SPI_SDCARD_POLL_WINDOW);               // The data token of the next block can already be in the window
+      break;
+    }
+
+    case SPI_SDCARD_PHASE_WRITE:
+    {
+      const uint8_t Response = pSD->Window[2] & SPI_SDCARD_DATA_RESPONSE_Mask;                    // The data response follows the CRC
+      if (Response == SPI_SDCARD_DATA_CRC_ERROR) Error = ERR__CRC_ERROR;
+      else if (Response != SPI_SDCARD_DATA_ACCEPTED) Error = ERR__CARD_ERROR;
+      else
+      {
+        pSD->BlockWriteCount++;
+        __SPI_SDcard_NextBlock(pSD);
+      }
+      if (Error != ERR_NONE) __SPI_SDcard_Fail(pSD, Error);
+      pSD->PhaseStart_ms = pSD->fnGetCurrentms();
+      if (pSD->Window[SPI_SDCARD_WINDOW_BUFFER_SIZE - 1u] == 0x00) return __SPI_SDcard_StartBusy(pSD); // Still busy at the end of the window
+      return __SPI_SDcard_ContinueWrite(pSD);
+    }
+
+    case SPI_SDCARD_PHASE_BUSY:
+      if (pSD->Carry[SPI_SDCARD_POLL_WINDOW - 1u] == 0x00)
+      {
+        if ((pSD->fnGetCurrentms() - pSD->PhaseStart_ms) <= SPI_SDCARD_BUSY_TIMEOUT_ms) return __SPI_SDcard_StartBusy(pSD);
+        pSD->Stream = SPI_SDCARD_STREAM_NONE;
+        pSD->Phase  = SPI_SDCARD_PHASE_IDLE;
+        if (pRequest == NULL) return ERR__CARD_STUCK_BUSY;                                         // Busy after a stop
+        __SPI_SDcard_Fail(pSD, ERR__CARD_STUCK_BUSY);
+        return ERR_NONE;
+      }
+      return __SPI_SDcard_ContinueWrite(pSD);
+
+    case SPI_SDCARD_PHASE_STOP:
+      pSD->PhaseStart_ms = pSD->fnGetCurrentms();
+      if (pSD->Command[pSD->Packets[0].DataSize - 1u] == 0x00) return __SPI_SDcard_StartBusy(pSD);  // The R1b of CMD12 and the stop token are followed by a busy
+      pSD->Phase = SPI_SDCARD_PHASE_IDLE;
+      return ERR_NONE;
+
+    case SPI_SDCARD_PHASE_DESELECT:
+    default:
+      pSD->Phase = SPI_SDCARD_PHASE_IDLE;
+      return ERR_NONE;
+  }
+  if (Error != ERR_NONE) __SPI_SDcard_Fail(pSD, Error);
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SD card over SPI functions
+//********************************************************************************************************************
+//=============================================================================
+// SD card initialization
+//=============================================================================
+eERRORRESULT SPI_SDcard_Init(SPI_SDcard* pSD)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSD == NULL) || (pSD->pSPI == NULL) || (pSD->fnGetCurrentms == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pSD->pSPI->fnSPI_Transfer == NULL) return ERR__SPI_CONFIG_ERROR;
+  if (pSD->pHead != NULL) return ERR__BUSY;
+  uint8_t Response[16];
+  uint8_t R1 = 0xFF;
+  eERRORRESULT Error;
+  pSD->CardType      = SPI_SDCARD_NO_CARD;
+  pSD->BlockCount    = 0;
+  pSD->pTail         = NULL;
+  pSD->Stream        = SPI_SDCARD_STREAM_NONE;
+  pSD->Phase         = SPI_SDCARD_PHASE_IDLE;
+  pSD->Selected      = false;
+  pSD->CarryCount    = 0;
+  pSD->TransferCount = 0;
+  SPI_SDcard_ResetStats(pSD);
+  for (size_t zIdx = 0; zIdx < 3; ++zIdx) Interface_SPIinitTransaction(&pSD->Transactions[zIdx], &pSD->Packets[zIdx], NULL, pSD);
+
+  //--- Power up at the identification frequency with at least 74 clocks ---
+  if (pSD->pSPI->fnSPI_Init != NULL)
+  {
+    Error = pSD->pSPI->fnSPI_Init(pSD->pSPI, pSD->ChipSelect, STD_SPI_MODE0, SPI_SDCARD_INIT_SCK_FREQ);
+    if (Error != ERR_NONE) return Error;
+  }
+  Error = __SPI_SDcard_Transfer(pSD, NULL, NULL, 10, true);
+  if (Error != ERR_NONE) return Error;
+
+  //--- Reset to SPI mode and check the voltage ---
+  for (size_t zRetry = 0; zRetry < 10u; ++zRetry)
+  {
+    Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_CMD0_GO_IDLE_STATE, 0, &R1, NULL, 0, true);
+    if ((Error == ERR_NONE) && (R1 == SPI_SDCARD_R1_IDLE)) break;
+  }
+  if (R1 != SPI_SDCARD_R1_IDLE) return ERR__NO_CARD;
+  Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_CMD8_SEND_IF_COND, SPI_SDCARD_CMD8_CHECK_PATTERN, &R1, &Response[0], 4, true);
+  if (Error != ERR_NONE) return Error;
+  const bool Version2 = ((R1 & SPI_SDCARD_R1_ILLEGAL_COMMAND) == 0);                               // CMD8 is unknown by the version 1 cards
+  if (Version2 && (((Response[2] & 0x0Fu) != (uint8_t)(SPI_SDCARD_CMD8_CHECK_PATTERN >> 8)) || (Response[3] != (uint8_t)SPI_SDCARD_CMD8_CHECK_PATTERN))) return ERR__UNUSABLE_CARD;
+  if (pSD->UseCRC)
+  {
+    Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_CMD59_CRC_ON_OFF, 1, &R1, NULL, 0, true);
+    if (Error != ERR_NONE) return Error;
+    if (R1 != SPI_SDCARD_R1_IDLE) return ERR__CARD_COMMAND_ERROR;
+  }
+
+  //--- Initialization of the card ---
+  const uint32_t Start_ms = pSD->fnGetCurrentms();
+  while (true)
+  {
+    Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_CMD55_APP_CMD, 0, &R1, NULL, 0, true);
+    if (Error != ERR_NONE) return Error;
+    Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_ACMD41_SD_SEND_OP_COND, (Version2 ? SPI_SDCARD_ACMD41_HCS : 0u), &R1, NULL, 0, true);
+    if (Error != ERR_NONE) return Error;
+    if (R1 == 0x00) break;
+    if (R1 != SPI_SDCARD_R1_IDLE) return ERR__UNUSABLE_CARD;
+    if ((pSD->fnGetCurrentms() - Start_ms) > SPI_SDCARD_INIT_TIMEOUT_ms) return ERR__UNUSABLE_CARD;
+    if (pSD->fnYield != NULL) pSD->fnYield();
+  }
+  pSD->CardType = SPI_SDCARD_SDSC_V1;
+  if (Version2)
+  {
+    Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_CMD58_READ_OCR, 0, &R1, &Response[0], 4, true);
+    if (Error != ERR_NONE) return Error;
+    if (R1 != 0x00) return ERR__CARD_COMMAND_ERROR;
+    pSD->CardType = (((Response[0] & (SPI_SDCARD_OCR_CCS >> 24)) > 0) ? SPI_SDCARD_SDHC : SPI_SDCARD_SDSC_V2);
+  }
+  if (pSD->CardType != SPI_SDCARD_SDHC)
+  {
+    Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_CMD16_SET_BLOCKLEN, SPI_SDCARD_BLOCK_SIZE, &R1, NULL, 0, true);
+    if (Error != ERR_NONE) return Error;
+    if (R1 != 0x00) return ERR__CARD_COMMAND_ERROR;
+  }
+
+  //--- Capacity of the card ---
+  Error = __SPI_SDcard_Command(pSD, SPI_SDCARD_CMD9_SEND_CSD, 0, &R1, NULL, 0, false);
+  if (Error != ERR_NONE) return Error;
+  if (R1 != 0x00) return ERR__CARD_COMMAND_ERROR;
+  Error = __SPI_SDcard_ReceiveData(pSD, &Response[0], 16);
+  if (Error != ERR_NONE) return Error;
+  if ((Response[0] >> 6) == 1)                                                                     // CSD version 2: (C_SIZE + 1) * 512KB
+  {
+    const uint32_t CSize = ((uint32_t)(Response[7] & 0x3Fu) << 16) | ((uint32_t)Response[8] << 8) | Response[9];
+    pSD->BlockCount = (CSize + 1u) * 1024u;
+  }
+  else                                                                                             // CSD version 1: (C_SIZE + 1) * 2^(C_SIZE_MULT + 2) * 2^READ_BL_LEN
+  {
+    const uint32_t CSize     = ((uint32_t)(Response[6] & 0x03u) << 10) | ((uint32_t)Response[7] << 2) | (Response[8] >> 6);
+    const uint32_t CSizeMult = ((uint32_t)(Response[9] & 0x03u) << 1) | (Response[10] >> 7);
+    const uint32_t ReadBlLen = Response[5] & 0x0Fu;
+    pSD->BlockCount = (CSize + 1u) << (CSizeMult + 2u + ReadBlLen - 9u);
+  }
+
+  //--- Data transfer frequency ---
+  if ((pSD->pSPI->fnSPI_Init != NULL) && (pSD->SCKfreq > 0))
+  {
+    Error = pSD->pSPI->fnSPI_Init(pSD->pSPI, pSD->ChipSelect, STD_SPI_MODE0, pSD->SCKfreq);
+    if (Error != ERR_NONE) return Error;
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Submit a block request
+//=============================================================================
+eERRORRESULT SPI_SDcard_Submit(SPI_SDcard* pSD, SPI_SDcardRequest* pRequest)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSD == NULL) || (pRequest == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pRequest->pData == NULL) return ERR__NULL_BUFFER;
+  if (pSD->CardType == SPI_SDCARD_NO_CARD) return ERR__NO_CARD;
+  if (pRequest->Status == SPI_SDCARD_REQUEST_PENDING) return ERR__BUSY;
+  if ((pRequest->BlockCount == 0) || (pRequest->Block >= pSD->BlockCount) || (pRequest->BlockCount > (pSD->BlockCount - pRequest->Block))) return ERR__CARD_OUT_OF_RANGE;
+  pRequest->DoneCount = 0;
+  pRequest->pNext     = NULL;
+  pRequest->Result    = ERR__BUSY;
+  pRequest->Status    = SPI_SDCARD_REQUEST_PENDING;
+
+  //--- Queue the request ---
+  uint32_t Depth = 1;
+  for (const SPI_SDcardRequest* pQueued = pSD->pHead; pQueued != NULL; pQueued = pQueued->pNext) Depth++;
+  if (pSD->pTail != NULL) pSD->pTail->pNext = pRequest; else pSD->pHead = pRequest;
+  pSD->pTail = pRequest;
+  pSD->RequestCount++;
+  if (Depth > pSD->MaxQueueDepth) pSD->MaxQueueDepth = Depth;
+  return SPI_SDcard_Process(pSD);
+}
+
+
+//=============================================================================
+// Run the transfers of the SD card
+//=============================================================================
+eERRORRESULT SPI_SDcard_Process(SPI_SDcard* pSD)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSD == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  eERRORRESULT Error = ERR_NONE;
+  while (true)
+  {
+    if (__SPI_SDcard_TransfersDone(pSD, &Error) == false) return ERR_NONE;                      // A transfer is still in progress
+    if (Error != ERR_NONE)                                                                         // The state of the card is unknown after an interface error
+    {
+      __SPI_SDcard_CompleteRequest(pSD, Error);
+      pSD->Stream   = SPI_SDCARD_STREAM_NONE;
+      pSD->Phase    = SPI_SDCARD_PHASE_IDLE;
+      pSD->Selected = false;
+      return Error;
+    }
+    const eSPI_SDcardPhase Phase = pSD->Phase;
+    Error = __SPI_SDcard_RunPhase(pSD);
+    if (Error != ERR_NONE)
+    {
+      if (pSD->TransferCount == 0)                                                                 // The next phase could not be queued
+      {
+        __SPI_SDcard_CompleteRequest(pSD, Error);
+        pSD->Stream = SPI_SDCARD_STREAM_NONE;
+        pSD->Phase  = SPI_SDCARD_PHASE_IDLE;
+      }
+      return Error;
+    }
+    if ((pSD->TransferCount == 0) && (pSD->Phase == SPI_SDCARD_PHASE_IDLE) && (Phase == SPI_SDCARD_PHASE_IDLE)) return ERR_NONE; // Nothing more to do
+  }
+}
+
+
+//=============================================================================
+// Wait for the completion of a request
+//=============================================================================
+eERRORRESULT SPI_SDcard_WaitRequest(SPI_SDcard* pSD, SPI_SDcardRequest* pRequest)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSD == NULL) || (pRequest == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (pRequest->Status == SPI_SDCARD_REQUEST_IDLE) return ERR__PARAMETER_ERROR;
+  while (pRequest->Status != SPI_SDCARD_REQUEST_COMPLETE)
+  {
+    SPI_SDcard_Process(pSD);                                                                       // The errors are in the results of the requests
+    if ((pRequest->Status != SPI_SDCARD_REQUEST_COMPLETE) && (pSD->fnYield != NULL)) pSD->fnYield();
+  }
+#if defined(__GNUC__)
+  __sync_synchronize();                                                                            // Read the result after the completion flag
+#endif
+  return pRequest->Result;
+}
+
+
+//=============================================================================
+// Wait for the end of all the requests
+//=============================================================================
+eERRORRESULT SPI_SDcard_WaitIdle(SPI_SDcard* pSD)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSD == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  eERRORRESULT LastError = ERR_NONE;
+  while ((pSD->pHead != NULL) || (pSD->Stream != SPI_SDCARD_STREAM_NONE) || (pSD->Phase != SPI_SDCARD_PHASE_IDLE) || pSD->Selected)
+  {
+    if ((pSD->pHead == NULL) && (pSD->Stream == SPI_SDCARD_STREAM_WRITE) && (pSD->Phase == SPI_SDCARD_PHASE_IDLE) && (pSD->TransferCount == 0))
+      pSD->MoreBlocks = false;                                                                     // No more request: the multiple block write left open is stopped
+    const eERRORRESULT Error = SPI_SDcard_Process(pSD);
+    if (Error != ERR_NONE) LastError = Error;
+    if ((pSD->TransferCount > 0) && (pSD->fnYield != NULL)) pSD->fnYield();
+  }
+  return LastError;
+}
+
+
+//=============================================================================
+// Read blocks from the SD card
+//=============================================================================
+eERRORRESULT SPI_SDcard_ReadBlocks(SPI_SDcard* pSD, uint32_t block, uint8_t* pData, uint32_t count)
+{
+  SPI_SDcardRequest Request;
+  Request.Write      = false;
+  Request.Block      = block;
+  Request.BlockCount = count;
+  Request.pData      = pData;
+  Request.Status     = SPI_SDCARD_REQUEST_IDLE;
+  const eERRORRESULT Error = SPI_SDcard_Submit(pSD, &Request);
+  if (Request.Status == SPI_SDCARD_REQUEST_IDLE) return Error;                                     // Not queued
+  return SPI_SDcard_WaitRequest(pSD, &Request);
+}
+
+
+//=============================================================================
+// Write blocks to the SD card
+//=============================================================================
+eERRORRESULT SPI_SDcard_WriteBlocks(SPI_SDcard* pSD, uint32_t block, const uint8_t* pData, uint32_t count)
+{
+  SPI_SDcardRequest Request;
+  Request.Write      = true;
+  Request.Block      = block;
+  Request.BlockCount = count;
+  Request.pData      = (uint8_t*)pData;                                                            // Only read by the write transfers
+  Request.Status     = SPI_SDCARD_REQUEST_IDLE;
+  const eERRORRESULT Error = SPI_SDcard_Submit(pSD, &Request);
+  if (Request.Status == SPI_SDCARD_REQUEST_IDLE) return Error;
+  return SPI_SDcard_WaitRequest(pSD, &Request);
+}
+
+
+//=============================================================================
+// Reset the statistics of the SD card
+//=============================================================================
+void SPI_SDcard_ResetStats(SPI_SDcard* pSD)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSD == NULL) return;
+#endif
+  pSD->RequestCount      = 0;
+  pSD->MaxQueueDepth     = 0;
+  pSD->ReadCommandCount  = 0;
+  pSD->WriteCommandCount = 0;
+  pSD->PreEraseCount     = 0;
+  pSD->StopCount         = 0;
+  pSD->BlockReadCount    = 0;
+  pSD->BlockWriteCount   = 0;
+  pSD->TokenPollCount    = 0;
+  pSD->BusyPollCount     = 0;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
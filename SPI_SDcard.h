@@ -0,0 +1,339 @@
+/*!*****************************************************************************
+ * @file    SPI_SDcard.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   SD card block device over SPI
+ * @details This block device reads and writes the 512 bytes blocks of SD cards
+ * in SPI mode through the SPI_Interface for all the https://github.com/Emandhal
+ * drivers and developments:
+ * - The block requests are queued. The requests that follow each other on the
+ *   card are transferred with one multiple block command (CMD18 read, CMD25
+ *   write) instead of one command per block, the multiple block writes are
+ *   preceded by the count of blocks to pre-erase (ACMD23) of the requests
+ *   queued at the command
+ * - A multiple block write is left open after its last block: a write request
+ *   submitted later that follows on the card continues it. With an interface
+ *   without asynchronous transfers each request is done by its submit, so the
+ *   writes are merged this way. SPI_SDcard_WaitIdle() or a request that does
+ *   not follow stops it
+ * - The response, data token and busy bytes are received with the dummy byte
+ *   path in polling windows of several bytes. The start of a block received in
+ *   a window is kept, so each block is two transfers: its data directly in the
+ *   request buffer and its CRC with the window of the next token
+ * - The transfers use the asynchronous transfers of the interface if
+ *   available, several transfers of a block are queued at once
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_SDCARD_H_INC
+#define __SPI_SDCARD_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_SDCARD_BLOCK_SIZE         ( 512u )    //!< Size of a block
+#define SPI_SDCARD_INIT_SCK_FREQ      ( 400000u ) //!< SCK frequency of the card identification
+#define SPI_SDCARD_COMMAND_SIZE       ( 6u )      //!< Size of a command frame (command, argument, CRC7)
+#define SPI_SDCARD_NCR_WINDOW         ( 8u )      //!< Max count of bytes before the response of a command (NCR)
+#define SPI_SDCARD_POLL_WINDOW        ( 16u )     //!< Count of bytes received per data token or busy poll
+
+#define SPI_SDCARD_TOKEN_TIMEOUT_ms   ( 100u )    //!< Max time between a read command or a block and its data token
+#define SPI_SDCARD_BUSY_TIMEOUT_ms    ( 500u )    //!< Max busy time after a block written or a stop
+#define SPI_SDCARD_INIT_TIMEOUT_ms    ( 1000u )   //!< Max time of the card initialization (ACMD41)
+
+#define SPI_SDCARD_COMMAND_BUFFER_SIZE  ( 3u * (SPI_SDCARD_COMMAND_SIZE + SPI_SDCARD_NCR_WINDOW) ) //!< Room for the pre-erase count, its application command and the write command with their response windows
+#define SPI_SDCARD_WINDOW_BUFFER_SIZE   ( 2u + SPI_SDCARD_POLL_WINDOW )                           //!< Room for the CRC of a block and the poll window that follows it
+
+#define SPI_SDCARD_R1_IDLE            ( 0x01u )   //!< R1 response: the card is in idle state
+#define SPI_SDCARD_R1_ERASE_RESET     ( 0x02u )   //!< R1 response: an erase sequence was cleared
+#define SPI_SDCARD_R1_ILLEGAL_COMMAND ( 0x04u )   //!< R1 response: illegal command
+#define SPI_SDCARD_R1_COM_CRC_ERROR   ( 0x08u )   //!< R1 response: CRC of the command failed
+#define SPI_SDCARD_R1_ERASE_SEQ_ERROR ( 0x10u )   //!< R1 response: error in the sequence of erase commands
+#define SPI_SDCARD_R1_ADDRESS_ERROR   ( 0x20u )   //!< R1 response: misaligned address
+#define SPI_SDCARD_R1_PARAMETER_ERROR ( 0x40u )   //!< R1 response: argument out of the allowed range
+#define SPI_SDCARD_R1_NO_RESPONSE     ( 0x80u )   //!< Bit always cleared in a R1 response
+
+#define SPI_SDCARD_TOKEN_START_BLOCK  ( 0xFEu )   //!< Data token of a block read, or of a single block write
+#define SPI_SDCARD_TOKEN_START_MULTI  ( 0xFCu )   //!< Data token of a block of a multiple block write
+#define SPI_SDCARD_TOKEN_STOP_TRAN    ( 0xFDu )   //!< Stop token of a multiple block write
+#define SPI_SDCARD_ERROR_TOKEN_Mask   ( 0xF0u )   //!< Bits cleared in an error token of a read
+#define SPI_SDCARD_ERROR_TOKEN_ERROR  ( 0x01u )   //!< Error token: general error
+#define SPI_SDCARD_ERROR_TOKEN_CC     ( 0x02u )   //!< Error token: card controller error
+#define SPI_SDCARD_ERROR_TOKEN_ECC    ( 0x04u )   //!< Error token: card ECC failed
+#define SPI_SDCARD_ERROR_TOKEN_RANGE  ( 0x08u )   //!< Error token: out of range
+
+#define SPI_SDCARD_DATA_RESPONSE_Mask ( 0x1Fu )   //!< Mask of the data response of a block written
+#define SPI_SDCARD_DATA_ACCEPTED      ( 0x05u )   //!< Data response: data accepted
+#define SPI_SDCARD_DATA_CRC_ERROR     ( 0x0Bu )   //!< Data response: data rejected due to a CRC error
+#define SPI_SDCARD_DATA_WRITE_ERROR   ( 0x0Du )   //!< Data response: data rejected due to a write error
+
+#define SPI_SDCARD_CMD8_CHECK_PATTERN ( 0x1AAu )  //!< Argument of CMD8: 2.7-3.6V and check pattern 0xAA
+#define SPI_SDCARD_ACMD41_HCS         ( 1u << 30 ) //!< Argument of ACMD41: the host supports the high capacity cards
+#define SPI_SDCARD_OCR_POWER_UP       ( 1u << 31 ) //!< OCR: the card power up is done
+#define SPI_SDCARD_OCR_CCS            ( 1u << 30 ) //!< OCR: Card Capacity Status, high capacity card
+
+//! SD card commands in SPI mode enum. The application commands (ACMD) shall be preceded by #SPI_SDCARD_CMD55_APP_CMD
+typedef enum
+{
+  SPI_SDCARD_CMD0_GO_IDLE_STATE            =  0, //!< Reset the card to idle state (R1)
+  SPI_SDCARD_CMD8_SEND_IF_COND             =  8, //!< Send the supply voltage and the check pattern (R7)
+  SPI_SDCARD_CMD9_SEND_CSD                 =  9, //!< Read the CSD register as a 16 bytes data block (R1)
+  SPI_SDCARD_CMD12_STOP_TRANSMISSION       = 12, //!< Stop a multiple block read (R1b)
+  SPI_SDCARD_CMD13_SEND_STATUS             = 13, //!< Read the card status (R2)
+  SPI_SDCARD_CMD16_SET_BLOCKLEN            = 16, //!< Set the block length of the standard capacity cards (R1)
+  SPI_SDCARD_CMD17_READ_SINGLE_BLOCK       = 17, //!< Read a block (R1)
+  SPI_SDCARD_CMD18_READ_MULTIPLE_BLOCK     = 18, //!< Read blocks until CMD12 (R1)
+  SPI_SDCARD_CMD24_WRITE_BLOCK             = 24, //!< Write a block (R1)
+  SPI_SDCARD_CMD25_WRITE_MULTIPLE_BLOCK    = 25, //!< Write blocks until the stop token (R1)
+  SPI_SDCARD_CMD55_APP_CMD                 = 55, //!< The next command is an application command (R1)
+  SPI_SDCARD_CMD58_READ_OCR                = 58, //!< Read the OCR register (R3)
+  SPI_SDCARD_CMD59_CRC_ON_OFF              = 59, //!< Enable or disable the CRC (R1)
+  SPI_SDCARD_ACMD23_SET_WR_BLK_ERASE_COUNT = 23, //!< Set the count of blocks to pre-erase before the next multiple block write (R1)
+  SPI_SDCARD_ACMD41_SD_SEND_OP_COND        = 41, //!< Start the card initialization (R1)
+} eSPI_SDcardCommand;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SD card over SPI
+//********************************************************************************************************************
+
+//! SD card type enum
+typedef enum
+{
+  SPI_SDCARD_NO_CARD = 0x0u, //!< No card initialized
+  SPI_SDCARD_SDSC_V1 = 0x1u, //!< Standard capacity card, physical layer version 1 (byte addressing)
+  SPI_SDCARD_SDSC_V2 = 0x2u, //!< Standard capacity card, physical layer version 2 or later (byte addressing)
+  SPI_SDCARD_SDHC    = 0x3u, //!< High or extended capacity card (block addressing)
+} eSPI_SDcardType;
+
+//! Block request status enum
+typedef enum
+{
+  SPI_SDCARD_REQUEST_IDLE     = 0x0u, //!< The request is not queued
+  SPI_SDCARD_REQUEST_PENDING  = 0x1u, //!< The request is queued or in progress
+  SPI_SDCARD_REQUEST_COMPLETE = 0x2u, //!< The request is complete, the result is available
+} eSPI_SDcardRequestStatus;
+
+//! Command stream state enum
+typedef enum
+{
+  SPI_SDCARD_STREAM_NONE   = 0x0u, //!< No data command in progress
+  SPI_SDCARD_STREAM_SINGLE = 0x1u, //!< A single block command (CMD17, CMD24) is in progress
+  SPI_SDCARD_STREAM_READ   = 0x2u, //!< A multiple block read (CMD18) is in progress
+  SPI_SDCARD_STREAM_WRITE  = 0x3u, //!< A multiple block write (CMD25) is in progress
+} eSPI_SDcardStream;
+
+//! Transfer phase enum
+typedef enum
+{
+  SPI_SDCARD_PHASE_IDLE       = 0x0u, //!< No transfer in progress
+  SPI_SDCARD_PHASE_COMMAND    = 0x1u, //!< The command of a request is in progress
+  SPI_SDCARD_PHASE_TOKEN      = 0x2u, //!< The data token of a block is polled
+  SPI_SDCARD_PHASE_READ       = 0x3u, //!< The data and the CRC of a block are received
+  SPI_SDCARD_PHASE_WRITE      = 0x4u, //!< The token, the data and the CRC of a block are sent
+  SPI_SDCARD_PHASE_BUSY       = 0x5u, //!< The end of the busy is polled
+  SPI_SDCARD_PHASE_STOP       = 0x6u, //!< The stop of a multiple block command is in progress
+  SPI_SDCARD_PHASE_DESELECT   = 0x7u, //!< The ChipSelect is released
+} eSPI_SDcardPhase;
+
+/*! @brief Function that gives the current time in milliseconds
+ *
+ * The value can wrap around, only the differences are used
+ */
+typedef uint32_t (*SPI_SDcardGetCurrentms_Func)(void);
+
+/*! @brief Function called while waiting for a request
+ *
+ * This function should give the CPU to other threads or tasks (sched_yield(), taskYIELD(), osThreadYield()...)
+ */
+typedef void (*SPI_SDcardYield_Func)(void);
+
+
+typedef struct SPI_SDcardRequest SPI_SDcardRequest; //!< Typedef of SPI_SDcardRequest object structure
+
+//! @brief Block request of the SD card
+struct SPI_SDcardRequest
+{
+  bool Write;                               //!< 'true' to write the blocks, 'false' to read them
+  uint32_t Block;                           //!< Index of the first block
+  uint32_t BlockCount;                      //!< Count of blocks
+  uint8_t* pData;                           //!< Data of the blocks (BlockCount * #SPI_SDCARD_BLOCK_SIZE bytes). It shall stay valid until completion
+  volatile eSPI_SDcardRequestStatus Status; //!< Completion flag of the request
+  volatile eERRORRESULT Result;             //!< Result of the request. Only valid when Status is #SPI_SDCARD_REQUEST_COMPLETE
+  uint32_t DoneCount;                       //!< Count of blocks transferred
+  SPI_SDcardRequest* pNext;                 //!< Used by the block device to queue pending requests. Do not modify while pending
+};
+
+
+//! @brief SD card over SPI
+typedef struct SPI_SDcard
+{
+  SPI_Interface* pSPI;                             //!< SPI interface of the card. The block device uses its asynchronous transfers if available
+  uint8_t ChipSelect;                              //!< Chip Select index of the card
+  uint32_t SCKfreq;                                //!< SCK frequency after the card identification (up to 25MHz)
+  bool UseCRC;                                     //!< 'true' to enable the CRC of the commands and of the data blocks (CMD59)
+  SPI_SDcardGetCurrentms_Func fnGetCurrentms;      //!< This function will be called to get the current time in milliseconds
+  SPI_SDcardYield_Func fnYield;                    //!< This function will be called while waiting for a request. Can be NULL (busy wait)
+  //--- Card ---
+  eSPI_SDcardType CardType;                        //!< Type of the card found by SPI_SDcard_Init()
+  uint32_t BlockCount;                             //!< Count of blocks of the card
+  //--- Request queue ---
+  SPI_SDcardRequest* pHead;                        //!< First queued request (in progress)
+  SPI_SDcardRequest* pTail;                        //!< Last queued request
+  //--- Transfers in progress ---
+  eSPI_SDcardStream Stream;                        //!< Data command in progress
+  uint32_t NextBlock;                              //!< Index of the next block of the data command in progress
+  eSPI_SDcardPhase Phase;                          //!< Transfer phase in progress
+  uint32_t PhaseStart_ms;                          //!< Time of the start of the token or busy polling
+  bool Selected;                                   //!< 'true' while the ChipSelect is left asserted by the last transfer
+  bool MoreBlocks;                                 //!< 'true' if the block in progress is followed by another block of the same data command, or if the multiple block write left open can be continued
+  uint8_t Carry[SPI_SDCARD_POLL_WINDOW];           //!< Start of the next block, received with the window of its data token
+  size_t CarryCount;                               //!< Count of bytes in Carry
+  uint8_t Command[SPI_SDCARD_COMMAND_BUFFER_SIZE]; //!< Commands with their response windows
+  uint8_t Window[SPI_SDCARD_WINDOW_BUFFER_SIZE];   //!< CRC of a block and the poll window that follows it
+  uint8_t Token;                                   //!< Data token of the block written
+  size_t TransferCount;                            //!< Count of transfers in progress
+  SPIInterface_Packet Packets[3];                  //!< Packets of the transfers in progress
+  SPIInterface_Transaction Transactions[3];        //!< Asynchronous transactions of the packets
+  //--- Statistics ---
+  uint32_t RequestCount;                           //!< Count of requests submitted
+  uint32_t MaxQueueDepth;                          //!< Worst count of queued requests
+  uint32_t ReadCommandCount;                       //!< Count of read commands (CMD17, CMD18)
+  uint32_t WriteCommandCount;                      //!< Count of write commands (CMD24, CMD25)
+  uint32_t PreEraseCount;                          //!< Count of pre-erase counts sent (ACMD23)
+  uint32_t StopCount;                              //!< Count of stops of multiple block commands (CMD12, stop token)
+  uint32_t BlockReadCount;                         //!< Count of blocks read
+  uint32_t BlockWriteCount;                        //!< Count of blocks written
+  uint32_t TokenPollCount;                         //!< Count of data token polls
+  uint32_t BusyPollCount;                          //!< Count of busy polls
+} SPI_SDcard;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SD card over SPI functions
+//********************************************************************************************************************
+
+/*! @brief SD card initialization
+ *
+ * Identify the card at #SPI_SDCARD_INIT_SCK_FREQ (CMD0, CMD8, ACMD41, CMD58), set the block size of the standard capacity cards, enable the CRC if asked, read the capacity (CMD9) and set the SCK frequency. This is blocking
+ * @param[in] *pSD Is the SD card to initialize. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum. #ERR__NO_CARD if the card does not respond, #ERR__UNUSABLE_CARD if the card does not support the voltage or does not leave the idle state
+ */
+eERRORRESULT SPI_SDcard_Init(SPI_SDcard* pSD);
+
+/*! @brief Submit a block request
+ *
+ * The request is queued after the requests in progress and this function runs SPI_SDcard_Process(). It never waits for the card
+ * A request that follows the previous queued one on the card, in the same direction, continues its multiple block command. A write request that follows the last block written continues the multiple block write left open, even if the previous requests are complete
+ * @param[in] *pSD Is the SD card
+ * @param[in] *pRequest Is the request to submit. It is the handle of the request and shall stay valid until completion
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUSY if the request is already pending, #ERR__CARD_OUT_OF_RANGE if the blocks are not on the card
+ */
+eERRORRESULT SPI_SDcard_Submit(SPI_SDcard* pSD, SPI_SDcardRequest* pRequest);
+
+/*! @brief Run the transfers of the SD card
+ *
+ * Check the transfers in progress and start the next ones: commands, data tokens, blocks, busy polls and stops of the multiple block commands. This never waits for the card
+ * Call this function regularly (main loop, timer task...) while requests are pending. With an interface without asynchronous transfers, this runs all the queued requests
+ * @param[in] *pSD Is the SD card
+ * @return Returns an #eERRORRESULT value enum. The errors of the requests are in their result
+ */
+eERRORRESULT SPI_SDcard_Process(SPI_SDcard* pSD);
+
+/*! @brief Wait for the completion of a request
+ *
+ * The yield function is called between the runs of SPI_SDcard_Process()
+ * @param[in] *pSD Is the SD card
+ * @param[in] *pRequest Is the request submitted
+ * @return Returns the result of the request
+ */
+eERRORRESULT SPI_SDcard_WaitRequest(SPI_SDcard* pSD, SPI_SDcardRequest* pRequest);
+
+/*! @brief Wait for the end of all the requests
+ *
+ * The multiple block command in progress is stopped and the end of its busy is waited, so all the blocks written are programmed in the card
+ * @param[in] *pSD Is the SD card
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SDcard_WaitIdle(SPI_SDcard* pSD);
+
+/*! @brief Read blocks from the SD card
+ *
+ * Submit a read request and wait for its completion
+ * @param[in] *pSD Is the SD card
+ * @param[in] block Is the index of the first block
+ * @param[out] *pData Is where the data will be stored (count * #SPI_SDCARD_BLOCK_SIZE bytes)
+ * @param[in] count Is the count of blocks to read
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SDcard_ReadBlocks(SPI_SDcard* pSD, uint32_t block, uint8_t* pData, uint32_t count);
+
+/*! @brief Write blocks to the SD card
+ *
+ * Submit a write request and wait for its completion. The blocks are accepted by the card, use SPI_SDcard_WaitIdle() to wait for their programming
+ * @param[in] *pSD Is the SD card
+ * @param[in] block Is the index of the first block
+ * @param[in] *pData Is the data to write (count * #SPI_SDCARD_BLOCK_SIZE bytes)
+ * @param[in] count Is the count of blocks to write
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SDcard_WriteBlocks(SPI_SDcard* pSD, uint32_t block, const uint8_t* pData, uint32_t count);
+
+/*! @brief Reset the statistics of the SD card
+ *
+ * @param[in] *pSD Is the SD card
+ */
+void SPI_SDcard_ResetStats(SPI_SDcard* pSD);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_SDCARD_H_INC */
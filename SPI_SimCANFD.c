@@ -0,0 +1,350 @@
+/*!*****************************************************************************
+ * @file    SPI_SimCANFD.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Simulated MCP251xFD CAN-FD controller for host tests
+ * @details This simulated controller plugs into the generic SPI_Interface of
+ *          all the https://github.com/Emandhal drivers and developments.
+ *          Only available with the generic SPI_Interface (not Arduino, not
+ *          STM32cubeIDE)
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "SPI_SimCANFD.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated CAN FD controller internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Set a word of the SFR (little-endian)
+//=============================================================================
+static void __SPI_SimCANFD_SetWord(SPI_SimCANFD* pSim, uint16_t address, uint32_t value)
+{
+  pSim->SFR[address + 0u] = (uint8_t)value;
+  pSim->SFR[address + 1u] = (uint8_t)(value >> 8);
+  pSim->SFR[address + 2u] = (uint8_t)(value >> 16);
+  pSim->SFR[address + 3u] = (uint8_t)(value >> 24);
+}
+
+
+//=============================================================================
+// [STATIC] Set or clear the bit of a FIFO in a register with one bit per FIFO
+//=============================================================================
+static void __SPI_SimCANFD_SetFifoBit(SPI_SimCANFD* pSim, uint16_t address, uint8_t fifo, bool set)
+{
+  const uint8_t Mask = (uint8_t)(1u << (fifo & 0x7u));
+  if (set) pSim->SFR[address + (fifo >> 3)] |= Mask;
+  else pSim->SFR[address + (fifo >> 3)] &= (uint8_t)~Mask;
+}
+
+
+//=============================================================================
+// [STATIC] Update the registers of a FIFO from its state
+//=============================================================================
+static void __SPI_SimCANFD_UpdateFifo(SPI_SimCANFD* pSim, uint8_t fifo)
+{
+  const SPI_SimCANFDfifo* pFifo = &pSim->Fifos[fifo];
+  uint32_t PayloadCode = 0;
+  while ((PayloadCode < 7u) && (pFifo->PayloadSize > (PayloadCode < 5u ? 8u + (PayloadCode * 4u) : 32u + ((PayloadCode - 5u) * 16u)))) PayloadCode++;
+  const uint32_t Control = SPI_CANFD_FIFOCON_FSIZE_SET(pFifo->Depth - 1u) | SPI_CANFD_FIFOCON_PLSIZE_SET(PayloadCode) | (pFifo->TimeStamp ? SPI_CANFD_FIFOCON_TSEN : 0u);
+  uint32_t Status = SPI_CANFD_FIFOSTA_FIFOCI_SET(pFifo->Head);
+  if (pFifo->Count > 0) Status |= SPI_CANFD_FIFOSTA_TFNRFNIF;
+  if ((pFifo->Count * 2u) >= pFifo->Depth) Status |= SPI_CANFD_FIFOSTA_TFHRFHIF;
+  if (pFifo->Count >= pFifo->Depth) Status |= SPI_CANFD_FIFOSTA_TFERFFIF;
+  if (pFifo->Overflow) Status |= SPI_CANFD_FIFOSTA_RXOVIF;
+  __SPI_SimCANFD_SetWord(pSim, (uint16_t)SPI_CANFD_C1FIFOCON(fifo), Control);
+  __SPI_SimCANFD_SetWord(pSim, (uint16_t)SPI_CANFD_C1FIFOSTA(fifo), Status);
+  __SPI_SimCANFD_SetWord(pSim, (uint16_t)SPI_CANFD_C1FIFOUA(fifo), (uint32_t)(pFifo->Base + (pFifo->Tail * pFifo->ObjectSize)) - SPI_CANFD_RAM_ADDRESS);
+  __SPI_SimCANFD_SetFifoBit(pSim, SPI_CANFD_C1RXIF, fifo, (pFifo->Count > 0));
+  __SPI_SimCANFD_SetFifoBit(pSim, SPI_CANFD_C1RXOVIF, fifo, pFifo->Overflow);
+}
+
+
+//=============================================================================
+// [STATIC] Reset the controller
+//=============================================================================
+static void __SPI_SimCANFD_Reset(SPI_SimCANFD* pSim)
+{
+  memset(&pSim->SFR[0], 0, sizeof(pSim->SFR));
+  for (uint8_t zFifo = 1; zFifo < SPI_CANFD_FIFO_COUNT; ++zFifo)
+  {
+    SPI_SimCANFDfifo* pFifo = &pSim->Fifos[zFifo];
+    if (pFifo->Depth == 0) continue;
+    pFifo->Head     = 0;
+    pFifo->Tail     = 0;
+    pFifo->Count    = 0;
+    pFifo->Overflow = false;
+    __SPI_SimCANFD_UpdateFifo(pSim, zFifo);
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Get the FIFO of a register address. Returns 0 if the address is not a register of a receive FIFO
+//=============================================================================
+static uint8_t __SPI_SimCANFD_GetFifo(const SPI_SimCANFD* pSim, uint16_t address)
+{
+  if ((address < SPI_CANFD_C1FIFOCON(1)) || (address >= SPI_CANFD_C1FIFOCON(SPI_CANFD_FIFO_COUNT))) return 0;
+  const uint8_t Fifo = (uint8_t)((address - SPI_CANFD_C1FIFOCON(0)) / 12u);
+  return (pSim->Fifos[Fifo].Depth > 0 ? Fifo : 0);
+}
+
+
+//=============================================================================
+// [STATIC] Read a byte of the controller
+//=============================================================================
+static uint8_t __SPI_SimCANFD_ReadByte(const SPI_SimCANFD* pSim, uint16_t address)
+{
+  if (address < SPI_CANFD_SFR_SIZE) return pSim->SFR[address];
+  if ((address >= SPI_CANFD_RAM_ADDRESS) && (address < (SPI_CANFD_RAM_ADDRESS + SPI_CANFD_RAM_SIZE))) return pSim->RAM[address - SPI_CANFD_RAM_ADDRESS];
+  return 0x00;
+}
+
+
+//=============================================================================
+// [STATIC] Write a byte of the controller
+//=============================================================================
+static void __SPI_SimCANFD_WriteByte(SPI_SimCANFD* pSim, uint16_t address, uint8_t value)
+{
+  if ((address >= SPI_CANFD_RAM_ADDRESS) && (address < (SPI_CANFD_RAM_ADDRESS + SPI_CANFD_RAM_SIZE))) { pSim->RAM[address - SPI_CANFD_RAM_ADDRESS] = value; return; }
+  if (address >= SPI_CANFD_SFR_SIZE) return;
+  const uint8_t Fifo = __SPI_SimCANFD_GetFifo(pSim, address);
+  if (Fifo == 0) { pSim->SFR[address] = value; return; }
+
+  //--- Registers of a receive FIFO ---
+  SPI_SimCANFDfifo* pFifo = &pSim->Fifos[Fifo];
+  if (address == (SPI_CANFD_C1FIFOCON(Fifo) + 1u))
+  {
+    if (((value & (uint8_t)(SPI_CANFD_FIFOCON_UINC >> 8)) > 0) && (pFifo->Count > 0))             // The tail goes to the next message object
+    {
+      pFifo->Tail = (uint8_t)((pFifo->Tail + 1u) % pFifo->Depth);
+      pFifo->Count--;
+      pSim->IncrementCount++;
+    }
+    if ((value & (uint8_t)(SPI_CANFD_FIFOCON_FRESET >> 8)) > 0)                                    // The reset is done immediately
+    {
+      pFifo->Head     = 0;
+      pFifo->Tail     = 0;
+      pFifo->Count    = 0;
+      pFifo->Overflow = false;
+    }
+  }
+  else if (address == SPI_CANFD_C1FIFOSTA(Fifo))
+  {
+    if ((value & SPI_CANFD_FIFOSTA_RXOVIF) == 0) pFifo->Overflow = false;                         // The other flags of the byte are read only
+  }
+  __SPI_SimCANFD_UpdateFifo(pSim, Fifo);                                                           // The configuration of the FIFO does not change
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated CAN FD controller functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure a SPI_Interface to use a simulated CAN FD controller
+//=============================================================================
+eERRORRESULT SPI_SimCANFD_Attach(SPI_Interface *pIntDev, SPI_SimCANFD* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pSim == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  //--- Allocate the receive FIFOs in the message RAM ---
+  uint32_t Address = SPI_CANFD_RAM_ADDRESS;
+  for (uint8_t zFifo = 1; zFifo < SPI_CANFD_FIFO_COUNT; ++zFifo)
+  {
+    SPI_SimCANFDfifo* pFifo = &pSim->Fifos[zFifo];
+    if (pFifo->Depth == 0) continue;
+    if (pFifo->Depth > 32u) return ERR__SPI_CONFIG_ERROR;
+    switch (pFifo->PayloadSize)
+    {
+      case 8: case 12: case 16: case 20: case 24: case 32: case 48: case 64: break;
+      default: return ERR__SPI_CONFIG_ERROR;
+    }
+    pFifo->ObjectSize = (uint16_t)((pFifo->TimeStamp ? 12u : 8u) + pFifo->PayloadSize);
+    pFifo->Base       = (uint16_t)Address;
+    Address += (uint32_t)pFifo->Depth * pFifo->ObjectSize;
+    if (Address > (SPI_CANFD_RAM_ADDRESS + SPI_CANFD_RAM_SIZE)) return ERR__OUT_OF_MEMORY;
+  }
+  pIntDev->InterfaceDevice           = pSim;
+  pIntDev->UniqueID                  = 0;
+  pIntDev->fnSPI_Init                = SPI_SimCANFD_Init;
+  pIntDev->fnSPI_Transfer            = SPI_SimCANFD_Transfer;
+  pIntDev->fnSPI_TransferSegmentList = NULL;
+  pIntDev->fnSPI_TransferPhases      = NULL;
+  pIntDev->fnSPI_TransferAsync       = NULL;
+  pIntDev->Channel                   = 0;
+  memset(&pSim->RAM[0], 0, sizeof(pSim->RAM));
+  __SPI_SimCANFD_Reset(pSim);
+  pSim->SCKfreq      = 0;
+  pSim->CommandIndex = 0;
+  pSim->Selected     = false;
+  SPI_SimCANFD_ResetStats(pSim);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Simulated CAN FD controller initialization
+//=============================================================================
+eERRORRESULT SPI_SimCANFD_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  (void)chipSelect;
+  SPI_SimCANFD* pSim = (SPI_SimCANFD*)pIntDev->InterfaceDevice;
+  if (sckFreq == 0) return ERR__SPI_FREQUENCY_ERROR;
+  if (SPI_PIN_COUNT_GET(mode) > 1) return ERR__NOT_SUPPORTED;                                      // The controller is a Standard SPI device
+  pSim->SCKfreq  = sckFreq;
+  pSim->Selected = false;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Simulated CAN FD controller transfer
+//=============================================================================
+eERRORRESULT SPI_SimCANFD_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_SimCANFD* pSim = (SPI_SimCANFD*)pIntDev->InterfaceDevice;
+  if (pSim->SCKfreq == 0) return ERR__SPI_CONFIG_ERROR;
+  const bool UseDummyByte = (pPacketDesc->Config.Bits.UseDummyByte > 0) || (pPacketDesc->TxData == NULL);
+  if (pSim->Selected == false)                                                                     // ChipSelect asserted: new SPI command
+  {
+    pSim->Selected     = true;
+    pSim->CommandIndex = 0;
+    pSim->CommandCount++;
+  }
+
+  //--- Exchange the bytes one by one ---
+  for (size_t zByte = 0; zByte < pPacketDesc->DataSize; ++zByte)
+  {
+    const uint8_t TxByte = (UseDummyByte ? pPacketDesc->DummyByte : pPacketDesc->TxData[zByte]);
+    uint8_t RxByte = 0x00;
+    if (pSim->CommandIndex < SPI_CANFD_COMMAND_SIZE)
+    {
+      pSim->Command[pSim->CommandIndex++] = TxByte;
+      if (pSim->CommandIndex == SPI_CANFD_COMMAND_SIZE)
+      {
+        pSim->Address = (uint16_t)(((pSim->Command[0] & 0x0Fu) << 8) | pSim->Command[1]);
+        if ((pSim->Command[0] >> 4) == SPI_CANFD_INSTRUCTION_RESET) __SPI_SimCANFD_Reset(pSim);
+      }
+    }
+    else
+    {
+      switch (pSim->Command[0] >> 4)
+      {
+        case SPI_CANFD_INSTRUCTION_READ : RxByte = __SPI_SimCANFD_ReadByte(pSim, pSim->Address); break;
+        case SPI_CANFD_INSTRUCTION_WRITE: __SPI_SimCANFD_WriteByte(pSim, pSim->Address, TxByte); break;
+        default: break;
+      }
+      pSim->Address = (uint16_t)((pSim->Address + 1u) & 0xFFFu);
+    }
+    if (pPacketDesc->RxData != NULL) pPacketDesc->RxData[zByte] = RxByte;
+  }
+  pSim->SCKcycles += 8u * pPacketDesc->DataSize;
+  if (pPacketDesc->Terminate) pSim->Selected = false;
+
+  eERRORRESULT Error = Interface_SPIpacketCRC(pPacketDesc);
+  if (Error != ERR_NONE) return Error;
+  pPacketDesc->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;                                            // The simulated controller does not perform the endian transform
+  return Interface_SPIendianTransform(pPacketDesc);
+}
+
+
+//=============================================================================
+// Receive a frame in a FIFO of the simulated controller
+//=============================================================================
+eERRORRESULT SPI_SimCANFD_ReceiveFrame(SPI_SimCANFD* pSim, uint8_t fifo, uint32_t identifier, uint32_t flags, uint32_t timeStamp, const uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSim == NULL) || ((pData == NULL) && (size > 0))) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((fifo == 0) || (fifo >= SPI_CANFD_FIFO_COUNT) || (pSim->Fifos[fifo].Depth == 0)) return ERR__PARAMETER_ERROR;
+  SPI_SimCANFDfifo* pFifo = &pSim->Fifos[fifo];
+  if (pFifo->Count >= pFifo->Depth)
+  {
+    pFifo->Overflow = true;
+    pSim->LostCount++;
+    __SPI_SimCANFD_UpdateFifo(pSim, fifo);
+    return ERR__BUFFER_FULL;
+  }
+
+  //--- Message object at the head of the FIFO ---
+  uint8_t* pObject = &pSim->RAM[(pFifo->Base - SPI_CANFD_RAM_ADDRESS) + ((size_t)pFifo->Head * pFifo->ObjectSize)];
+  uint32_t Header[3] = { identifier, flags, timeStamp };
+  size_t Offset = 0;
+  for (size_t zWord = 0; zWord < (pFifo->TimeStamp ? 3u : 2u); ++zWord)                           // The words are little-endian
+    for (size_t zByte = 0; zByte < 4u; ++zByte) pObject[Offset++] = (uint8_t)(Header[zWord] >> (8u * zByte));
+  const size_t Size = (size < pFifo->PayloadSize ? size : pFifo->PayloadSize);
+  if (Size > 0) memcpy(&pObject[Offset], pData, Size);
+  memset(&pObject[Offset + Size], 0, pFifo->PayloadSize - Size);
+  pFifo->Head = (uint8_t)((pFifo->Head + 1u) % pFifo->Depth);
+  pFifo->Count++;
+  pSim->ReceivedCount++;
+  __SPI_SimCANFD_UpdateFifo(pSim, fifo);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Reset the statistics of the simulated controller
+//=============================================================================
+void SPI_SimCANFD_ResetStats(SPI_SimCANFD* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return;
+#endif
+  pSim->SCKcycles      = 0;
+  pSim->CommandCount   = 0;
+  pSim->ReceivedCount  = 0;
+  pSim->LostCount      = 0;
+  pSim->IncrementCount = 0;
+}
+
+
+//=============================================================================
+// Get the simulated bus time used since the last statistics reset
+//=============================================================================
+uint64_t SPI_SimCANFD_GetBusTime_ns(const SPI_SimCANFD* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return 0;
+#endif
+  if (pSim->SCKfreq == 0) return 0;
+  return ((pSim->SCKcycles * 1000000000u) / pSim->SCKfreq) + ((uint64_t)pSim->CommandCount * pSim->CommandOverhead_ns);
+}
+
+//-----------------------------------------------------------------------------
+#endif // #if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
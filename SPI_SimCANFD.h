@@ -0,0 +1,177 @@
+/*!*****************************************************************************
+ * @file    SPI_SimCANFD.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Simulated MCP251xFD CAN-FD controller for host tests
+ * @details This simulated controller plugs into the generic SPI_Interface of
+ * all the https://github.com/Emandhal drivers and developments. It decodes the
+ * READ, WRITE and RESET instructions on a model of the SFR and of the 2KB
+ * message RAM. The receive FIFOs are allocated in the RAM like the controller
+ * does (the TEF and the TXQ are not used) and the frames injected by the test
+ * are written as message objects at the head of their FIFO. The FIFO status,
+ * user address, increment (UINC), reset (FRESET) and overflow flag work like
+ * the controller. The bus time counts the SCK cycles and a fixed overhead per
+ * SPI command (ChipSelect assertion), to give the frame rate of a receive code
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_SIMCANFD_H_INC
+#define __SPI_SIMCANFD_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+#include "SPI_CANFDrx.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated CAN FD controller
+//********************************************************************************************************************
+
+//! @brief Receive FIFO of the simulated controller
+typedef struct SPI_SimCANFDfifo
+{
+  uint8_t Depth;        //!< Count of message objects (1 to 32). 0 if the FIFO is not used
+  uint8_t PayloadSize;  //!< Size of the payload of a message object (8, 12, 16, 20, 24, 32, 48 or 64)
+  bool TimeStamp;       //!< 'true' if the message objects have a time stamp
+  //--- State ---
+  uint16_t Base;        //!< Address of the first message object of the FIFO, set by SPI_SimCANFD_Attach()
+  uint16_t ObjectSize;  //!< Size of a message object, set by SPI_SimCANFD_Attach()
+  uint8_t Head;         //!< Index of the next message object written by the controller
+  uint8_t Tail;         //!< Index of the next message object to read
+  uint8_t Count;        //!< Count of message objects in the FIFO
+  bool Overflow;        //!< Overflow flag (RXOVIF)
+} SPI_SimCANFDfifo;
+
+
+//! @brief Simulated MCP251xFD controller. Set this structure as the SPI_Interface.InterfaceDevice
+typedef struct SPI_SimCANFD
+{
+  SPI_SimCANFDfifo Fifos[SPI_CANFD_FIFO_COUNT];  //!< Receive FIFOs, the FIFO 0 (TXQ) is not used
+  uint32_t CommandOverhead_ns;                   //!< Bus time added for each SPI command (ChipSelect setup and hold, driver call)
+  //--- Configuration set by SPI_SimCANFD_Init() ---
+  uint32_t SCKfreq;                              //!< SCK frequency in Hz
+  //--- Controller state ---
+  uint8_t SFR[SPI_CANFD_SFR_SIZE];               //!< CAN FD controller SFR
+  uint8_t RAM[SPI_CANFD_RAM_SIZE];               //!< Message RAM
+  uint8_t Command[SPI_CANFD_COMMAND_SIZE];       //!< Instruction and address of the SPI command in progress
+  size_t CommandIndex;                           //!< Count of bytes of the SPI command received
+  uint16_t Address;                              //!< Address of the next byte of the SPI command
+  bool Selected;                                 //!< 'true' while a SPI command is in progress (ChipSelect asserted)
+  //--- Statistics ---
+  uint64_t SCKcycles;                            //!< Count of SCK cycles used on the bus
+  uint32_t CommandCount;                         //!< Count of SPI commands
+  uint32_t ReceivedCount;                        //!< Count of frames injected in the FIFOs
+  uint32_t LostCount;                            //!< Count of frames lost because their FIFO was full
+  uint32_t IncrementCount;                       //!< Count of FIFO increments (UINC)
+} SPI_SimCANFD;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated CAN FD controller functions
+//********************************************************************************************************************
+
+/*! @brief Configure a SPI_Interface to use a simulated CAN FD controller
+ *
+ * The controller is reset, the receive FIFOs are allocated in the message RAM in the order of their index and the statistics are reset
+ * @param[out] *pIntDev Is the SPI interface container structure to configure
+ * @param[in] *pSim Is the simulated controller to use. Its FIFOs and overhead shall already be set
+ * @return Returns an #eERRORRESULT value enum. #ERR__OUT_OF_MEMORY if the FIFOs do not fit in the message RAM
+ */
+eERRORRESULT SPI_SimCANFD_Attach(SPI_Interface *pIntDev, SPI_SimCANFD* pSim);
+
+/*! @brief Simulated CAN FD controller initialization (#SPIInit_Func compatible)
+ *
+ * @param[in] *pIntDev Is the SPI interface container structure used for the interface initialization
+ * @param[in] chipSelect Is the Chip Select index of the controller (not used)
+ * @param[in] mode Is the mode of the SPI to configure. Shall be a Standard SPI mode
+ * @param[in] sckFreq Is the SCK frequency in Hz
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimCANFD_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq);
+
+/*! @brief Simulated CAN FD controller transfer (#SPITransferPacket_Func compatible)
+ *
+ * A SPI command starts with the first packet after a packet with Terminate = 'true'
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimCANFD_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief Receive a frame in a FIFO of the simulated controller
+ *
+ * The message object is written at the head of the FIFO, as if the frame was received on the CAN bus and accepted by a filter of the FIFO
+ * @param[in] *pSim Is the simulated controller
+ * @param[in] fifo Is the FIFO that receives the frame
+ * @param[in] identifier Is the word 0 of the message object (SID, EID, SID11)
+ * @param[in] flags Is the word 1 of the message object (DLC, IDE, RTR, BRS, FDF, ESI, FILHIT)
+ * @param[in] timeStamp Is the time stamp of the frame, only stored if the FIFO has the time stamp enabled
+ * @param[in] *pData Is the payload of the frame
+ * @param[in] size Is the size of the payload. The payload is truncated or padded with 0 to the payload size of the FIFO
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUFFER_FULL if the FIFO is full, the frame is lost and the overflow flag is set
+ */
+eERRORRESULT SPI_SimCANFD_ReceiveFrame(SPI_SimCANFD* pSim, uint8_t fifo, uint32_t identifier, uint32_t flags, uint32_t timeStamp, const uint8_t* pData, size_t size);
+
+/*! @brief Reset the statistics of the simulated controller
+ *
+ * @param[in] *pSim Is the simulated controller
+ */
+void SPI_SimCANFD_ResetStats(SPI_SimCANFD* pSim);
+
+/*! @brief Get the simulated bus time used since the last statistics reset
+ *
+ * @param[in] *pSim Is the simulated controller
+ * @return Returns the bus time in nanoseconds: the SCK cycles at the configured SCK frequency and the overhead of the SPI commands
+ */
+uint64_t SPI_SimCANFD_GetBusTime_ns(const SPI_SimCANFD* pSim);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_SIMCANFD_H_INC */
@@ -0,0 +1,558 @@
+/*!*****************************************************************************
+ * @file    SPI_SimNOR.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.2.0
+ * @date    16/10/2026
+ * @brief   Simulated Quad-SPI NOR flash for host tests
+ * @details This simulated NOR flash plugs into the generic SPI_Interface of
+ *          all the https://github.com/Emandhal drivers and developments.
+ *          Only available with the generic SPI_Interface (not Arduino, not
+ *          STM32cubeIDE)
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.2.0    Add the program and erase times
+ * 1.1.0    Add the memory mapped image files, the bulk reads and the real time bus
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "SPI_SimNOR.h"
+#include "EndianTransform.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+#if defined(__linux__)
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <time.h>
+#endif
+//-----------------------------------------------------------------------------
+
+//! Simulated NOR flash instruction actions enum
+typedef enum
+{
+  SIMNOR_ACTION_WRITE_ENABLE,  //!< Set the Write Enable Latch
+  SIMNOR_ACTION_WRITE_DISABLE, //!< Clear the Write Enable Latch
+  SIMNOR_ACTION_READ_STATUS,   //!< Read the status register
+  SIMNOR_ACTION_READ_ID,       //!< Read the JEDEC ID
+  SIMNOR_ACTION_READ,          //!< Read the memory
+  SIMNOR_ACTION_PROGRAM,       //!< Program a page
+  SIMNOR_ACTION_ERASE_SECTOR,  //!< Erase a sector
+  SIMNOR_ACTION_ERASE_BLOCK,   //!< Erase a block
+  SIMNOR_ACTION_ERASE_CHIP,    //!< Erase the whole memory
+} eSPI_SimNORaction;
+
+//! Simulated NOR flash instruction description
+typedef struct
+{
+  uint8_t Instruction;      //!< Instruction byte, always sent on 1 line
+  uint8_t AddressLines;     //!< Line count of the address phase, 0 if no address
+  uint8_t DummyCycles;      //!< Count of dummy cycles (mode bits included)
+  uint8_t DataLines;        //!< Line count of the data phase, 0 if no data
+  eSPI_SimNORaction Action; //!< Action of the instruction
+} SPI_SimNORinstructionDesc;
+
+//! Instructions decoded by the simulated NOR flash
+static const SPI_SimNORinstructionDesc SPI_SimNORinstructions[] =
+{
+  { SPI_SIMNOR_WRITE_ENABLE     , 0, 0, 0, SIMNOR_ACTION_WRITE_ENABLE  },
+  { SPI_SIMNOR_WRITE_DISABLE    , 0, 0, 0, SIMNOR_ACTION_WRITE_DISABLE },
+  { SPI_SIMNOR_READ_STATUS      , 0, 0, 1, SIMNOR_ACTION_READ_STATUS   },
+  { SPI_SIMNOR_READ_JEDEC_ID    , 0, 0, 1, SIMNOR_ACTION_READ_ID       },
+  { SPI_SIMNOR_READ             , 1, 0, 1, SIMNOR_ACTION_READ          },
+  { SPI_SIMNOR_FAST_READ        , 1, 8, 1, SIMNOR_ACTION_READ          },
+  { SPI_SIMNOR_DUAL_OUTPUT_READ , 1, 8, 2, SIMNOR_ACTION_READ          },
+  { SPI_SIMNOR_DUAL_IO_READ     , 2, 4, 2, SIMNOR_ACTION_READ          },
+  { SPI_SIMNOR_QUAD_OUTPUT_READ , 1, 8, 4, SIMNOR_ACTION_READ          },
+  { SPI_SIMNOR_QUAD_IO_READ     , 4, 6, 4, SIMNOR_ACTION_READ          },
+  { SPI_SIMNOR_PAGE_PROGRAM     , 1, 0, 1, SIMNOR_ACTION_PROGRAM       },
+  { SPI_SIMNOR_QUAD_PAGE_PROGRAM, 1, 0, 4, SIMNOR_ACTION_PROGRAM       },
+  { SPI_SIMNOR_SECTOR_ERASE     , 1, 0, 0, SIMNOR_ACTION_ERASE_SECTOR  },
+  { SPI_SIMNOR_BLOCK_ERASE      , 1, 0, 0, SIMNOR_ACTION_ERASE_BLOCK   },
+  { SPI_SIMNOR_CHIP_ERASE       , 0, 0, 0, SIMNOR_ACTION_ERASE_CHIP    },
+};
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated Quad-SPI NOR flash internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Find the description of an instruction. Returns NULL if unknown
+//=============================================================================
+static const SPI_SimNORinstructionDesc* __SPI_SimNOR_FindInstruction(uint8_t instruction)
+{
+  for (size_t zIdx = 0; zIdx < (sizeof(SPI_SimNORinstructions) / sizeof(SPI_SimNORinstructions[0])); ++zIdx)
+    if (SPI_SimNORinstructions[zIdx].Instruction == instruction) return &SPI_SimNORinstructions[zIdx];
+  return NULL;
+}
+
+
+//=============================================================================
+// [STATIC] Get the current time of the flash in nanoseconds
+//=============================================================================
+static uint64_t __SPI_SimNOR_Now_ns(const SPI_SimNOR* pSim)
+{
+#if defined(__linux__)
+  if (pSim->RealTimeBus)
+  {
+    struct timespec Now;
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+    return ((uint64_t)Now.tv_sec * 1000000000u) + (uint64_t)Now.tv_nsec;
+  }
+#endif
+  return pSim->Time_ns;
+}
+
+
+//=============================================================================
+// [STATIC] Is a program or an erase in progress?
+//=============================================================================
+static bool __SPI_SimNOR_IsBusy(const SPI_SimNOR* pSim)
+{
+  return (pSim->BusyRemaining > 0) || (__SPI_SimNOR_Now_ns(pSim) < pSim->BusyUntil_ns);
+}
+
+
+//=============================================================================
+// [STATIC] Start an instruction (ChipSelect assertion and instruction byte)
+//=============================================================================
+static const SPI_SimNORinstructionDesc* __SPI_SimNOR_Select(SPI_SimNOR* pSim, uint8_t instruction)
+{
+  const SPI_SimNORinstructionDesc* pDesc = __SPI_SimNOR_FindInstruction(instruction);
+  pSim->Instruction = instruction;
+  pSim->Address     = 0;
+  pSim->DataIndex   = 0;
+  pSim->Rejected    = (pDesc == NULL);                                                           // Unknown instruction
+  if (__SPI_SimNOR_IsBusy(pSim) && ((pDesc == NULL) || (pDesc->Action != SIMNOR_ACTION_READ_STATUS))) pSim->Rejected = true; // Only the status can be read while busy
+  pSim->InstructionCount++;
+  return pDesc;
+}
+
+
+//=============================================================================
+// [STATIC] Transfer a data byte of the current instruction
+//=============================================================================
+static uint8_t __SPI_SimNOR_DataByte(SPI_SimNOR* pSim, const SPI_SimNORinstructionDesc* pDesc, uint8_t txByte)
+{
+  const uint32_t AddressMask = pSim->MemorySize - 1u;
+  uint8_t RxByte = 0xFF;
+  switch (pDesc->Action)
+  {
+    case SIMNOR_ACTION_READ_STATUS:
+      RxByte = (__SPI_SimNOR_IsBusy(pSim) ? SPI_SIMNOR_STATUS_WIP : 0u) | (pSim->WriteEnabled ? SPI_SIMNOR_STATUS_WEL : 0u);
+      if (pSim->BusyRemaining > 0) pSim->BusyRemaining--;
+      break;
+    case SIMNOR_ACTION_READ_ID:
+      RxByte = pSim->JedecID[pSim->DataIndex % sizeof(pSim->JedecID)];
+      break;
+    case SIMNOR_ACTION_READ:
+      RxByte = pSim->pMemory[pSim->Address & AddressMask];
+      pSim->Address++;
+      break;
+    case SIMNOR_ACTION_PROGRAM:
+      if (pSim->WriteEnabled)                                                                    // The address wraps around in the page, a program can only clear bits
+      {
+        const uint32_t Address = (pSim->Address & ~(SPI_SIMNOR_PAGE_SIZE - 1u)) | ((pSim->Address + (uint32_t)pSim->DataIndex) & (SPI_SIMNOR_PAGE_SIZE - 1u));
+        pSim->pMemory[Address & AddressMask] &= txByte;
+      }
+      break;
+    default: break;
+  }
+  pSim->DataIndex++;
+  pSim->DataBytes++;
+  return RxByte;
+}
+
+
+//=============================================================================
+// [STATIC] Read data bytes of the current read instruction in one copy
+//=============================================================================
+static void __SPI_SimNOR_ReadBulk(SPI_SimNOR* pSim, uint8_t* pData, size_t size)
+{
+  pSim->DataIndex += size;
+  pSim->DataBytes += size;
+  while (size > 0)
+  {
+    const uint32_t Address = pSim->Address & (pSim->MemorySize - 1u);
+    size_t Count = pSim->MemorySize - Address;                                                   // The address wraps around at the end of the memory
+    if (Count > size) Count = size;
+    memcpy(pData, &pSim->pMemory[Address], Count);
+    pSim->Address += (uint32_t)Count;
+    pData += Count;
+    size  -= Count;
+  }
+}
+
+
+//=============================================================================
+// [STATIC] End the current instruction (ChipSelect deassertion)
+//=============================================================================
+static void __SPI_SimNOR_Deselect(SPI_SimNOR* pSim)
+{
+  const SPI_SimNORinstructionDesc* pDesc = __SPI_SimNOR_FindInstruction(pSim->Instruction);
+  pSim->Selected  = false;
+  pSim->ByteIndex = 0;
+  if (pSim->Rejected || (pDesc == NULL))
+  {
+    pSim->RejectedCount++;
+    pSim->Rejected = false;
+    return;
+  }
+  uint32_t EraseSize = 0, BusyTime_us = 0;
+  switch (pDesc->Action)
+  {
+    case SIMNOR_ACTION_WRITE_ENABLE : pSim->WriteEnabled = true; break;
+    case SIMNOR_ACTION_WRITE_DISABLE: pSim->WriteEnabled = false; break;
+    case SIMNOR_ACTION_READ         : pSim->ReadCount++; break;
+    case SIMNOR_ACTION_PROGRAM      : if (pSim->WriteEnabled) pSim->ProgramCount++; BusyTime_us = pSim->PageProgramTime_us; break;
+    case SIMNOR_ACTION_ERASE_SECTOR : EraseSize = SPI_SIMNOR_SECTOR_SIZE; BusyTime_us = pSim->SectorEraseTime_us; break;
+    case SIMNOR_ACTION_ERASE_BLOCK  : EraseSize = SPI_SIMNOR_BLOCK_SIZE; BusyTime_us = pSim->BlockEraseTime_us; break;
+    case SIMNOR_ACTION_ERASE_CHIP   : EraseSize = pSim->MemorySize; BusyTime_us = pSim->BlockEraseTime_us * ((pSim->MemorySize + SPI_SIMNOR_BLOCK_SIZE - 1u) / SPI_SIMNOR_BLOCK_SIZE); break;
+    default: break;
+  }
+  if ((EraseSize > 0) && pSim->WriteEnabled)
+  {
+    if (EraseSize > pSim->MemorySize) EraseSize = pSim->MemorySize;
+    const uint32_t Address = pSim->Address & (pSim->MemorySize - 1u) & ~(EraseSize - 1u);
+    memset(&pSim->pMemory[Address], 0xFF, EraseSize);
+    pSim->EraseCount++;
+  }
+  if (((EraseSize > 0) || (pDesc->Action == SIMNOR_ACTION_PROGRAM)) && pSim->WriteEnabled)
+  {
+    pSim->WriteEnabled  = false;                                                                 // The Write Enable Latch is cleared at the end of a program or an erase
+    pSim->BusyRemaining = pSim->BusyStatusReads;
+    pSim->BusyUntil_ns  = __SPI_SimNOR_Now_ns(pSim) + ((uint64_t)BusyTime_us * 1000u);
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Advance the time of the flash by the bus time of SCK cycles. Wait for this time if the bus is real time
+//=============================================================================
+static void __SPI_SimNOR_Pace(SPI_SimNOR* pSim, uint64_t sckCycles)
+{
+  if ((pSim->SCKfreq == 0) || (sckCycles == 0)) return;
+  const uint64_t Duration_ns = (sckCycles * 1000000000u) / pSim->SCKfreq;
+  pSim->Time_ns += Duration_ns;
+#if defined(__linux__)
+  if (pSim->RealTimeBus == false) return;
+  struct timespec Delay;
+  Delay.tv_sec  = (time_t)(Duration_ns / 1000000000u);
+  Delay.tv_nsec = (long)(Duration_ns % 1000000000u);
+  while (nanosleep(&Delay, &Delay) != 0) {}                                                     // Sleep again after a signal
+#endif
+}
+
+
+//=============================================================================
+// [STATIC] Get the error of a rejected instruction
+//=============================================================================
+static eERRORRESULT __SPI_SimNOR_RejectError(const SPI_SimNOR* pSim)
+{
+  return (__SPI_SimNOR_IsBusy(pSim) ? ERR__SPI_BUSY : ERR__SPI_COMM_ERROR);
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated Quad-SPI NOR flash functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure a SPI_Interface to use a simulated Quad-SPI NOR flash
+//=============================================================================
+eERRORRESULT SPI_SimNOR_Attach(SPI_Interface *pIntDev, SPI_SimNOR* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pSim == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  pIntDev->InterfaceDevice           = pSim;
+  pIntDev->UniqueID                  = 0;
+  pIntDev->fnSPI_Init                = SPI_SimNOR_Init;
+  pIntDev->fnSPI_Transfer            = SPI_SimNOR_Transfer;
+  pIntDev->fnSPI_TransferSegmentList = NULL;
+  pIntDev->fnSPI_TransferPhases      = SPI_SimNOR_TransferPhases;
+  pIntDev->fnSPI_TransferAsync       = NULL;
+  pIntDev->Channel                   = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Simulated Quad-SPI NOR flash initialization
+//=============================================================================
+eERRORRESULT SPI_SimNOR_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  (void)chipSelect;
+  SPI_SimNOR* pSim = (SPI_SimNOR*)pIntDev->InterfaceDevice;
+  if (sckFreq == 0) return ERR__SPI_FREQUENCY_ERROR;
+  if ((pSim->pMemory == NULL) || (pSim->MemorySize == 0) || ((pSim->MemorySize & (pSim->MemorySize - 1u)) > 0)) return ERR__SPI_CONFIG_ERROR;
+  if ((pSim->AddressSize < 3) || (pSim->AddressSize > 4)) return ERR__SPI_CONFIG_ERROR;
+  switch (SPI_PIN_COUNT_GET(mode))
+  {
+    case 0:
+    case 1: pSim->MaxLines = 1; break;
+    case 2: pSim->MaxLines = 2; break;
+    case 4: pSim->MaxLines = 4; break;
+    default: return ERR__NOT_SUPPORTED;
+  }
+  pSim->SCKfreq       = sckFreq;
+  pSim->Selected      = false;
+  pSim->ByteIndex     = 0;
+  pSim->Rejected      = false;
+  pSim->WriteEnabled  = false;
+  pSim->BusyRemaining = 0;
+  pSim->BusyUntil_ns  = 0;
+  pSim->Time_ns       = 0;
+  SPI_SimNOR_ResetStats(pSim);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Simulated Quad-SPI NOR flash transfer
+//=============================================================================
+eERRORRESULT SPI_SimNOR_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_SimNOR* pSim = (SPI_SimNOR*)pIntDev->InterfaceDevice;
+  const bool UseDummyByte = (pPacketDesc->Config.Bits.UseDummyByte > 0) || (pPacketDesc->TxData == NULL);
+  const SPI_SimNORinstructionDesc* pDesc = (pSim->Selected ? __SPI_SimNOR_FindInstruction(pSim->Instruction) : NULL);
+  const uint64_t StartCycles = pSim->SCKcycles;
+
+  //--- Decode the bytes as a Standard SPI instruction ---
+  for (size_t zByte = 0; zByte < pPacketDesc->DataSize; ++zByte)
+  {
+    const uint8_t TxByte = (UseDummyByte ? pPacketDesc->DummyByte : pPacketDesc->TxData[zByte]);
+    uint8_t RxByte = 0xFF;
+    pSim->SCKcycles += 8u;
+    if (pSim->Selected == false)
+    {
+      pDesc = __SPI_SimNOR_Select(pSim, TxByte);
+      pSim->Selected  = true;
+      pSim->ByteIndex = 1;
+      if ((pDesc != NULL) && ((pDesc->AddressLines > 1) || (pDesc->DataLines > 1))) pSim->Rejected = true; // Dual/Quad-SPI instructions need phase packets
+    }
+    else if (pSim->Rejected == false)
+    {
+      const size_t AddressBytes = (pDesc->AddressLines > 0 ? pSim->AddressSize : 0u);
+      const size_t Position     = pSim->ByteIndex - 1;
+      if (Position < AddressBytes) pSim->Address = (pSim->Address << 8) | TxByte;                // Address MSB first
+      else if ((Position >= (AddressBytes + (pDesc->DummyCycles / 8u))) && (pDesc->DataLines > 0))
+      {
+        if ((pDesc->Action == SIMNOR_ACTION_READ) && (pPacketDesc->RxData != NULL))                // Read the rest of the packet in one copy
+        {
+          const size_t Count = pPacketDesc->DataSize - zByte;
+          __SPI_SimNOR_ReadBulk(pSim, &pPacketDesc->RxData[zByte], Count);
+          pSim->SCKcycles += 8u * (uint64_t)(Count - 1u);
+          pSim->ByteIndex += Count;
+          break;
+        }
+        RxByte = __SPI_SimNOR_DataByte(pSim, pDesc, TxByte);
+      }
+      pSim->ByteIndex++;
+    }
+    if (pPacketDesc->RxData != NULL) pPacketDesc->RxData[zByte] = RxByte;
+  }
+
+  __SPI_SimNOR_Pace(pSim, pSim->SCKcycles - StartCycles);
+
+  //--- End of the instruction ---
+  if (pSim->Selected && pSim->Rejected)
+  {
+    const eERRORRESULT Error = __SPI_SimNOR_RejectError(pSim);
+    __SPI_SimNOR_Deselect(pSim);                                                                 // The ChipSelect is deasserted on error
+    return Error;
+  }
+  if (pPacketDesc->Terminate && pSim->Selected) __SPI_SimNOR_Deselect(pSim);
+  eERRORRESULT Error = Interface_SPIpacketCRC(pPacketDesc);
+  if (Error != ERR_NONE) return Error;
+  pPacketDesc->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;                                          // The simulated flash does not perform the endian transform
+  return Interface_SPIendianTransform(pPacketDesc);
+}
+
+
+//=============================================================================
+// Simulated Quad-SPI NOR flash phase transfer
+//=============================================================================
+eERRORRESULT SPI_SimNOR_TransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPhasePacket == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_SimNOR* pSim = (SPI_SimNOR*)pIntDev->InterfaceDevice;
+  if (pSim->Selected) return ERR__SPI_BUSY;                                                      // A packet instruction is in progress, its ChipSelect is asserted
+  const bool HasAddress = (pPhasePacket->AddressSize > 0);
+  const bool HasData    = (pPhasePacket->DataSize > 0);
+  if ((HasData && (pPhasePacket->TxData == NULL) && (pPhasePacket->RxData == NULL))) return ERR__NULL_BUFFER;
+  if ((pPhasePacket->InstructionLines > pSim->MaxLines) || (HasAddress && (pPhasePacket->AddressLines > pSim->MaxLines))
+   || (HasData && (pPhasePacket->DataLines > pSim->MaxLines))) return ERR__SPI_CONFIG_ERROR;   // The mode does not allow these line counts
+
+  //--- Check the phases against the instruction ---
+  const SPI_SimNORinstructionDesc* pDesc = __SPI_SimNOR_Select(pSim, pPhasePacket->Instruction);
+  if ((pDesc == NULL) || (pPhasePacket->InstructionLines != SPI_PHASE_1_LINE)
+   || (pPhasePacket->AddressSize != (pDesc->AddressLines > 0 ? pSim->AddressSize : 0u)) || (HasAddress && (pPhasePacket->AddressLines != pDesc->AddressLines))
+   || (pPhasePacket->DummyCycles != pDesc->DummyCycles) || (HasData && (pPhasePacket->DataLines != pDesc->DataLines)) || (HasData && (pDesc->DataLines == 0)))
+    pSim->Rejected = true;
+  if (pSim->Rejected)
+  {
+    const eERRORRESULT Error = __SPI_SimNOR_RejectError(pSim);
+    __SPI_SimNOR_Deselect(pSim);
+    return Error;
+  }
+
+  //--- Bus cycles of each phase ---
+  const uint64_t StartCycles = pSim->SCKcycles;
+  pSim->SCKcycles += 8u;
+  if (HasAddress) pSim->SCKcycles += (uint64_t)pPhasePacket->AddressSize * (8u / pPhasePacket->AddressLines);
+  pSim->SCKcycles += pPhasePacket->DummyCycles;
+  if (HasData) pSim->SCKcycles += (uint64_t)pPhasePacket->DataSize * (8u / pPhasePacket->DataLines);
+
+  __SPI_SimNOR_Pace(pSim, pSim->SCKcycles - StartCycles);
+
+  //--- Transfer ---
+  pSim->Address = pPhasePacket->Address;
+  if ((pDesc->Action == SIMNOR_ACTION_READ) && (pPhasePacket->RxData != NULL))
+    __SPI_SimNOR_ReadBulk(pSim, pPhasePacket->RxData, pPhasePacket->DataSize);
+  else
+  {
+    for (size_t zByte = 0; zByte < pPhasePacket->DataSize; ++zByte)
+    {
+      const uint8_t RxByte = __SPI_SimNOR_DataByte(pSim, pDesc, (pPhasePacket->TxData != NULL ? pPhasePacket->TxData[zByte] : 0xFF));
+      if (pPhasePacket->RxData != NULL) pPhasePacket->RxData[zByte] = RxByte;
+    }
+  }
+  __SPI_SimNOR_Deselect(pSim);
+
+  //--- Endian transform of the received data ---
+  const eEndianTransform Transform = (eEndianTransform)SPI_ENDIAN_TRANSFORM_GET(pPhasePacket->Config.Value);
+  if ((pPhasePacket->RxData != NULL) && (Transform != ENDIAN_NO_CHANGE))
+  {
+    const eERRORRESULT Error = EndianTransform_InPlace(pPhasePacket->RxData, pPhasePacket->DataSize, Transform);
+    if (Error != ERR_NONE) return Error;
+  }
+  pPhasePacket->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;
+  pPhasePacket->Config.Value |= SPI_ENDIAN_RESULT_SET(Transform);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Reset the statistics of the simulated Quad-SPI NOR flash
+//=============================================================================
+void SPI_SimNOR_ResetStats(SPI_SimNOR* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return;
+#endif
+  pSim->SCKcycles        = 0;
+  pSim->DataBytes        = 0;
+  pSim->InstructionCount = 0;
+  pSim->ReadCount        = 0;
+  pSim->ProgramCount     = 0;
+  pSim->EraseCount       = 0;
+  pSim->RejectedCount    = 0;
+}
+
+
+//=============================================================================
+// Get the simulated bus time used since the last statistics reset
+//=============================================================================
+uint64_t SPI_SimNOR_GetBusTime_us(const SPI_SimNOR* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return 0;
+#endif
+  if (pSim->SCKfreq == 0) return 0;
+  return (pSim->SCKcycles * 1000000u) / pSim->SCKfreq;
+}
+
+
+//=============================================================================
+// Get the effective data throughput of the simulated flash
+//=============================================================================
+uint32_t SPI_SimNOR_GetThroughput(const SPI_SimNOR* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return 0;
+#endif
+  if (pSim->SCKcycles == 0) return 0;
+  return (uint32_t)((pSim->DataBytes * pSim->SCKfreq) / pSim->SCKcycles);
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+#if defined(__linux__)
+//********************************************************************************************************************
+// Simulated Quad-SPI NOR flash image files
+//********************************************************************************************************************
+//=============================================================================
+// Map an image file as the memory of the simulated flash
+//=============================================================================
+eERRORRESULT SPI_SimNOR_MapFile(SPI_SimNOR* pSim, const char* pPath, bool writeBack)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pSim == NULL) || (pPath == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  const int Fd = open(pPath, (writeBack ? O_RDWR : O_RDONLY));
+  if (Fd < 0) return ERR__NOT_FOUND;
+  struct stat FileStat;
+  if (fstat(Fd, &FileStat) != 0) { close(Fd); return ERR__READ_ERROR; }
+  const uint64_t FileSize = (uint64_t)FileStat.st_size;
+  if ((FileSize == 0) || (FileSize > 0x80000000u) || ((FileSize & (FileSize - 1u)) > 0)) { close(Fd); return ERR__BAD_DATA_SIZE; } // The memory size shall be a power of 2
+  void* pMemory = mmap(NULL, (size_t)FileSize, PROT_READ | PROT_WRITE, (writeBack ? MAP_SHARED : MAP_PRIVATE), Fd, 0); // A private mapping is copy-on-write, the programs and erases stay in memory
+  close(Fd);                                                                                     // The mapping keeps its own reference to the file
+  if (pMemory == MAP_FAILED) return ERR__OUT_OF_MEMORY;
+  pSim->pMemory    = (uint8_t*)pMemory;
+  pSim->MemorySize = (uint32_t)FileSize;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Unmap the image file of the simulated flash
+//=============================================================================
+void SPI_SimNOR_UnmapFile(SPI_SimNOR* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return;
+#endif
+  if (pSim->pMemory == NULL) return;
+  munmap(pSim->pMemory, pSim->MemorySize);
+  pSim->pMemory    = NULL;
+  pSim->MemorySize = 0;
+}
+#endif // #if defined(__linux__)
+
+//-----------------------------------------------------------------------------
+#endif // #if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,225 @@
+/*!*****************************************************************************
+ * @file    SPI_SimNOR.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.2.0
+ * @date    16/10/2026
+ * @brief   Simulated Quad-SPI NOR flash for host tests
+ * @details This simulated NOR flash plugs into the generic SPI_Interface of all
+ * the https://github.com/Emandhal drivers and developments. It decodes the
+ * common instructions of the Dual/Quad-SPI NOR flashes (reads, page programs,
+ * erases, status and JEDEC ID) sent with packets or with phase packets, checks
+ * the line count and the dummy cycles of each phase and counts the SCK cycles
+ * to give the bus time for the SCK frequency set at initialization. The program
+ * and erase times run on this bus time, so the busy polling has a real cost.
+ * On Linux, the memory can be an image file mapped in memory
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.2.0    Add the program and erase times
+ * 1.1.0    Add the memory mapped image files, the bulk reads and the real time bus
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_SIMNOR_H_INC
+#define __SPI_SIMNOR_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define SPI_SIMNOR_PAGE_SIZE      ( 256u )    //!< Page size of the page program instructions. The address wraps around in the page
+#define SPI_SIMNOR_SECTOR_SIZE    ( 4096u )   //!< Size erased by #SPI_SIMNOR_SECTOR_ERASE
+#define SPI_SIMNOR_BLOCK_SIZE     ( 65536u )  //!< Size erased by #SPI_SIMNOR_BLOCK_ERASE
+
+#define SPI_SIMNOR_STATUS_WIP     ( 0x01u )   //!< Status register: Write In Progress
+#define SPI_SIMNOR_STATUS_WEL     ( 0x02u )   //!< Status register: Write Enable Latch
+
+//! Simulated NOR flash instructions enum. The line counts are given as instruction-address-data
+typedef enum
+{
+  SPI_SIMNOR_WRITE_ENABLE      = 0x06, //!< Write enable (1-0-0)
+  SPI_SIMNOR_WRITE_DISABLE     = 0x04, //!< Write disable (1-0-0)
+  SPI_SIMNOR_READ_STATUS       = 0x05, //!< Read status register (1-0-1)
+  SPI_SIMNOR_READ_JEDEC_ID     = 0x9F, //!< Read JEDEC ID (1-0-1)
+  SPI_SIMNOR_READ              = 0x03, //!< Read data (1-1-1), no dummy cycles
+  SPI_SIMNOR_FAST_READ         = 0x0B, //!< Fast read (1-1-1), 8 dummy cycles
+  SPI_SIMNOR_DUAL_OUTPUT_READ  = 0x3B, //!< Dual output fast read (1-1-2), 8 dummy cycles
+  SPI_SIMNOR_DUAL_IO_READ      = 0xBB, //!< Dual I/O fast read (1-2-2), 4 dummy cycles (mode bits included)
+  SPI_SIMNOR_QUAD_OUTPUT_READ  = 0x6B, //!< Quad output fast read (1-1-4), 8 dummy cycles
+  SPI_SIMNOR_QUAD_IO_READ      = 0xEB, //!< Quad I/O fast read (1-4-4), 6 dummy cycles (mode bits included)
+  SPI_SIMNOR_PAGE_PROGRAM      = 0x02, //!< Page program (1-1-1)
+  SPI_SIMNOR_QUAD_PAGE_PROGRAM = 0x32, //!< Quad input page program (1-1-4)
+  SPI_SIMNOR_SECTOR_ERASE      = 0x20, //!< 4KB sector erase (1-1-0)
+  SPI_SIMNOR_BLOCK_ERASE       = 0xD8, //!< 64KB block erase (1-1-0)
+  SPI_SIMNOR_CHIP_ERASE        = 0xC7, //!< Chip erase (1-0-0)
+} eSPI_SimNORinstruction;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated Quad-SPI NOR flash
+//********************************************************************************************************************
+
+//! @brief Simulated Quad-SPI NOR flash. Set this structure as the SPI_Interface.InterfaceDevice
+typedef struct SPI_SimNOR
+{
+  uint8_t* pMemory;             //!< Content of the memory, erased bytes are 0xFF
+  uint32_t MemorySize;          //!< Size of the memory in bytes. Shall be a power of 2, the addresses wrap around at the end of the memory
+  uint8_t JedecID[3];           //!< JEDEC ID returned by #SPI_SIMNOR_READ_JEDEC_ID (manufacturer, memory type, capacity)
+  uint8_t AddressSize;          //!< Address size of the instructions in bytes (3 or 4)
+  uint32_t BusyStatusReads;     //!< Count of status reads returning WIP after a program or an erase. 0 if the program and erase are instantaneous
+  uint32_t PageProgramTime_us;  //!< Duration of a page program in microseconds (typical 400 to 700). 0 if instantaneous
+  uint32_t SectorEraseTime_us;  //!< Duration of a sector erase in microseconds (typical 40000 to 60000). 0 if instantaneous
+  uint32_t BlockEraseTime_us;   //!< Duration of a block erase in microseconds (typical 150000 to 500000), also used per block for the chip erase. 0 if instantaneous
+  bool RealTimeBus;             //!< 'true' to make each transfer last its bus time at the SCK frequency (benchmarks of the asynchronous transfers). Only available on Linux
+  //--- Configuration set by SPI_SimNOR_Init() ---
+  uint32_t SCKfreq;             //!< SCK frequency in Hz
+  uint8_t MaxLines;             //!< Max line count of a phase allowed by the mode (1, 2 or 4)
+  //--- Device state ---
+  bool Selected;                //!< 'true' while the ChipSelect is asserted by packets
+  uint8_t Instruction;          //!< Current instruction
+  size_t ByteIndex;             //!< Count of bytes received with packets since the ChipSelect assertion
+  uint32_t Address;             //!< Current address of the instruction
+  size_t DataIndex;             //!< Count of data bytes of the current instruction
+  bool Rejected;                //!< The current instruction is unknown, has a phase mismatch or has been sent while busy
+  bool WriteEnabled;            //!< Write Enable Latch
+  uint32_t BusyRemaining;       //!< Count of status reads remaining before the end of the program or erase
+  uint64_t BusyUntil_ns;        //!< Time of the end of the program or erase
+  uint64_t Time_ns;             //!< Time of the flash, advanced by the bus time of the transfers. The wall clock is used instead if RealTimeBus is 'true'
+  //--- Statistics ---
+  uint64_t SCKcycles;           //!< Count of SCK cycles used on the bus
+  uint64_t DataBytes;           //!< Count of data bytes transferred (instruction, address and dummy cycles are not counted)
+  uint32_t InstructionCount;    //!< Count of instructions (ChipSelect assertions)
+  uint32_t ReadCount;           //!< Count of read instructions
+  uint32_t ProgramCount;        //!< Count of page program instructions
+  uint32_t EraseCount;          //!< Count of erase instructions
+  uint32_t RejectedCount;       //!< Count of rejected instructions
+} SPI_SimNOR;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated Quad-SPI NOR flash functions
+//********************************************************************************************************************
+
+/*! @brief Configure a SPI_Interface to use a simulated Quad-SPI NOR flash
+ *
+ * @param[out] *pIntDev Is the SPI interface container structure to configure
+ * @param[in] *pSim Is the simulated flash to use. Its memory, size, JEDEC ID and address size shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimNOR_Attach(SPI_Interface *pIntDev, SPI_SimNOR* pSim);
+
+/*! @brief Simulated Quad-SPI NOR flash initialization (#SPIInit_Func compatible)
+ *
+ * Set the SCK frequency and the max line count of the phases (the pin count of the mode, Standard SPI if not Dual/Quad-SPI), deselect the flash and reset the statistics
+ * @param[in] *pIntDev Is the SPI interface container structure used for the interface initialization
+ * @param[in] chipSelect Is the Chip Select index of the flash (not used)
+ * @param[in] mode Is the mode of the SPI to configure
+ * @param[in] sckFreq Is the SCK frequency in Hz
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimNOR_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq);
+
+/*! @brief Simulated Quad-SPI NOR flash transfer (#SPITransferPacket_Func compatible)
+ *
+ * The bytes of the packets are decoded as a Standard SPI instruction, the ChipSelect stays asserted until a packet with Terminate = 'true'. The Dual/Quad-SPI instructions are rejected, they need phase packets
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum. #ERR__SPI_COMM_ERROR if the instruction is unknown, #ERR__SPI_BUSY if a program or an erase is in progress
+ */
+eERRORRESULT SPI_SimNOR_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief Simulated Quad-SPI NOR flash phase transfer (#SPITransferPhases_Func compatible)
+ *
+ * The line count of each phase, the address size and the dummy cycles shall be the ones of the instruction (see #eSPI_SimNORinstruction)
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPhasePacket Is the phase packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum. #ERR__SPI_COMM_ERROR if the instruction is unknown or if a phase does not match, #ERR__SPI_CONFIG_ERROR if a phase uses more lines than the mode, #ERR__SPI_BUSY if a program or an erase is in progress
+ */
+eERRORRESULT SPI_SimNOR_TransferPhases(SPI_Interface *pIntDev, SPIInterface_PhasePacket* const pPhasePacket);
+
+/*! @brief Reset the statistics of the simulated Quad-SPI NOR flash
+ *
+ * @param[in] *pSim Is the simulated flash
+ */
+void SPI_SimNOR_ResetStats(SPI_SimNOR* pSim);
+
+/*! @brief Get the simulated bus time used since the last statistics reset
+ *
+ * @param[in] *pSim Is the simulated flash
+ * @return Returns the bus time in microseconds at the configured SCK frequency
+ */
+uint64_t SPI_SimNOR_GetBusTime_us(const SPI_SimNOR* pSim);
+
+/*! @brief Get the effective data throughput of the simulated flash since the last statistics reset
+ *
+ * This takes into account the instruction, address and dummy cycles of each instruction
+ * @param[in] *pSim Is the simulated flash
+ * @return Returns the data throughput in bytes per second at the configured SCK frequency
+ */
+uint32_t SPI_SimNOR_GetThroughput(const SPI_SimNOR* pSim);
+
+/*! @brief Map an image file as the memory of the simulated flash
+ *
+ * Set the memory and the memory size of the simulated flash to the image file mapped in memory. The pages are loaded by the system on the first access, so images of hundreds of MB can be used
+ * @note Only available on Linux
+ * @param[in,out] *pSim Is the simulated flash. Call SPI_SimNOR_Init() after this function
+ * @param[in] *pPath Is the path of the image file. Its size shall be a power of 2 up to 2GB
+ * @param[in] writeBack Set to 'true' to write the programs and erases back to the image file, else they stay in memory
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimNOR_MapFile(SPI_SimNOR* pSim, const char* pPath, bool writeBack);
+
+/*! @brief Unmap the image file of the simulated flash
+ *
+ * @note Only available on Linux
+ * @param[in,out] *pSim Is the simulated flash
+ */
+void SPI_SimNOR_UnmapFile(SPI_SimNOR* pSim);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_SIMNOR_H_INC */
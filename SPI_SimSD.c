@@ -0,0 +1,479 @@
+/*!*****************************************************************************
+ * @file    SPI_SimSD.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Simulated SD card in SPI mode for host tests
+ * @details This simulated SD card plugs into the generic SPI_Interface of
+ *          all the https://github.com/Emandhal drivers and developments.
+ *          Only available with the generic SPI_Interface (not Arduino, not
+ *          STM32cubeIDE)
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "SPI_SimSD.h"
+#include "CRC.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+
+#define SPI_SIMSD_NO_GROUP  ( 0xFFFFFFFFu ) //!< No erase group erased
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated SD card internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Set the response to send after a command or a block
+//=============================================================================
+static void __SPI_SimSD_Respond(SPI_SimSD* pSim, const uint8_t* pResponse, size_t size)
+{
+  memcpy(&pSim->Response[0], pResponse, size);
+  pSim->ResponseCount = size;
+  pSim->ResponseIndex = 0;
+}
+
+
+//=============================================================================
+// [STATIC] Prepare the send of a data block
+//=============================================================================
+static void __SPI_SimSD_PrepareRead(SPI_SimSD* pSim, const uint8_t* pData, size_t size, uint32_t latency_us)
+{
+  pSim->Mode       = SPI_SIMSD_MODE_READ;
+  pSim->pReadData  = pData;
+  pSim->ReadSize   = size;
+  pSim->DataIndex  = 0;
+  pSim->ReadyAt_ns = pSim->Time_ns + ((uint64_t)latency_us * 1000u);
+  if (pData == NULL) return;                                                                       // Out of range, an error token is sent
+  const uint16_t CRC = (uint16_t)CRC_Compute(CRC16_XMODEM, pData, size);
+  pSim->BlockCRC[0] = (uint8_t)(CRC >> 8);
+  pSim->BlockCRC[1] = (uint8_t)CRC;
+}
+
+
+//=============================================================================
+// [STATIC] Prepare the send of the block in progress
+//=============================================================================
+static void __SPI_SimSD_PrepareBlock(SPI_SimSD* pSim, uint32_t latency_us)
+{
+  const uint8_t* pData = (pSim->Block < pSim->BlockCount ? &pSim->pMemory[(size_t)pSim->Block * SPI_SDCARD_BLOCK_SIZE] : NULL);
+  __SPI_SimSD_PrepareRead(pSim, pData, SPI_SDCARD_BLOCK_SIZE, latency_us);
+}
+
+
+//=============================================================================
+// [STATIC] Get the byte sent by the card
+//=============================================================================
+static uint8_t __SPI_SimSD_OutByte(SPI_SimSD* pSim)
+{
+  if (pSim->ResponseIndex < pSim->ResponseCount) return pSim->Response[pSim->ResponseIndex++];
+  if (pSim->Time_ns < pSim->BusyUntil_ns) { pSim->BusyBytes++; return 0x00; }                    // Busy
+  if (pSim->Mode != SPI_SIMSD_MODE_READ) return 0xFF;
+
+  //--- Data block ---
+  if (pSim->DataIndex == 0)
+  {
+    if (pSim->Time_ns < pSim->ReadyAt_ns) { pSim->BusyBytes++; return 0xFF; }                     // Access time
+    if (pSim->pReadData == NULL)
+    {
+      pSim->Mode = SPI_SIMSD_MODE_NONE;
+      return SPI_SDCARD_ERROR_TOKEN_RANGE;
+    }
+    pSim->DataIndex = 1;
+    return SPI_SDCARD_TOKEN_START_BLOCK;
+  }
+  uint8_t Byte;
+  if (pSim->DataIndex <= pSim->ReadSize) Byte = pSim->pReadData[pSim->DataIndex - 1u];
+  else Byte = pSim->BlockCRC[pSim->DataIndex - 1u - pSim->ReadSize];
+  pSim->DataIndex++;
+  if (pSim->DataIndex > (pSim->ReadSize + 2u))                                                     // End of the block with its CRC
+  {
+    pSim->DataBytes += pSim->ReadSize;
+    if (pSim->ReadSize == SPI_SDCARD_BLOCK_SIZE) pSim->BlockReadCount++;
+    if (pSim->Multiple)
+    {
+      pSim->Block++;
+      __SPI_SimSD_PrepareBlock(pSim, pSim->StreamLatency_us);
+    }
+    else pSim->Mode = SPI_SIMSD_MODE_NONE;
+  }
+  return Byte;
+}
+
+
+//=============================================================================
+// [STATIC] End of a block received
+//=============================================================================
+static void __SPI_SimSD_EndWriteBlock(SPI_SimSD* pSim)
+{
+  uint8_t Response = SPI_SDCARD_DATA_ACCEPTED;
+  pSim->DataIndex = 0;
+  if (pSim->CRCenabled)
+  {
+    const uint16_t CRC = (uint16_t)CRC_Compute(CRC16_XMODEM, &pSim->WriteBuffer[0], SPI_SDCARD_BLOCK_SIZE);
+    if ((pSim->WriteBuffer[SPI_SDCARD_BLOCK_SIZE] != (uint8_t)(CRC >> 8)) || (pSim->WriteBuffer[SPI_SDCARD_BLOCK_SIZE + 1u] != (uint8_t)CRC))
+    {
+      pSim->CRCerrorCount++;
+      Response = SPI_SDCARD_DATA_CRC_ERROR;
+    }
+  }
+  if (pSim->Block >= pSim->BlockCount) Response = SPI_SDCARD_DATA_WRITE_ERROR;
+  __SPI_SimSD_Respond(pSim, &Response, 1);                                                         // The data response follows the CRC
+  if (Response != SPI_SDCARD_DATA_ACCEPTED) return;
+
+  //--- Program the block, after the erase of its group if needed ---
+  uint64_t BusyTime_us = pSim->ProgramTime_us;
+  const uint32_t Group = pSim->Block / pSim->EraseGroupBlocks;
+  bool Erase;
+  if (pSim->Multiple == false) Erase = true;                                                       // A single block is merged in its group, that is erased each time
+  else if (pSim->Block < pSim->PreEraseEnd) Erase = (pSim->PreErased == false);                   // The blocks pre-erased are erased together
+  else Erase = (Group != pSim->ErasedGroup);
+  if (Erase)
+  {
+    BusyTime_us += pSim->EraseTime_us;
+    pSim->EraseCount++;
+    pSim->ErasedGroup = Group;
+    if (pSim->Block < pSim->PreEraseEnd) pSim->PreErased = true;
+  }
+  memcpy(&pSim->pMemory[(size_t)pSim->Block * SPI_SDCARD_BLOCK_SIZE], &pSim->WriteBuffer[0], SPI_SDCARD_BLOCK_SIZE);
+  pSim->BusyUntil_ns = pSim->Time_ns + (BusyTime_us * 1000u);
+  pSim->DataBytes += SPI_SDCARD_BLOCK_SIZE;
+  pSim->BlockWriteCount++;
+  if (pSim->Multiple) pSim->Block++;
+  else pSim->Mode = SPI_SIMSD_MODE_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Execute the command received
+//=============================================================================
+static void __SPI_SimSD_Execute(SPI_SimSD* pSim)
+{
+  const uint8_t Command = pSim->Command[0] & 0x3Fu;
+  const uint32_t Argument = ((uint32_t)pSim->Command[1] << 24) | ((uint32_t)pSim->Command[2] << 16) | ((uint32_t)pSim->Command[3] << 8) | pSim->Command[4];
+  const bool CRCok = (pSim->Command[5] == (uint8_t)((CRC_Compute(CRC7_MMC, &pSim->Command[0], 5) << 1) | 0x01u));
+  const bool AppCommand = pSim->AppCommand;
+  uint8_t Response[6] = { 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00 };                                   // One byte before the response (NCR)
+  size_t Size = 2;
+  pSim->CommandCount++;
+  pSim->AppCommand = false;
+  if ((CRCok == false) && (pSim->CRCenabled || (Command == SPI_SDCARD_CMD0_GO_IDLE_STATE) || (Command == SPI_SDCARD_CMD8_SEND_IF_COND)))
+  {
+    pSim->CRCerrorCount++;
+    Response[1] = (pSim->Idle ? SPI_SDCARD_R1_IDLE : 0x00u) | SPI_SDCARD_R1_COM_CRC_ERROR;
+    __SPI_SimSD_Respond(pSim, &Response[0], Size);
+    return;
+  }
+  if (Command == SPI_SDCARD_CMD0_GO_IDLE_STATE)
+  {
+    pSim->Idle       = true;
+    pSim->CRCenabled = false;
+    pSim->InitCount  = 0;
+    pSim->Mode       = SPI_SIMSD_MODE_NONE;
+  }
+
+  //--- Application commands ---
+  if (AppCommand && ((Command == SPI_SDCARD_ACMD41_SD_SEND_OP_COND) || (Command == SPI_SDCARD_ACMD23_SET_WR_BLK_ERASE_COUNT)))
+  {
+    if (Command == SPI_SDCARD_ACMD41_SD_SEND_OP_COND)
+    {
+      pSim->InitCount++;
+      if ((pSim->InitCount > pSim->InitPolls) && ((Argument & SPI_SDCARD_ACMD41_HCS) > 0)) pSim->Idle = false; // A high capacity card needs a host that supports it
+    }
+    else if (pSim->Idle == false) pSim->PreEraseCount = Argument & 0x7FFFFFu;
+    Response[1] = (pSim->Idle ? SPI_SDCARD_R1_IDLE : 0x00u) | ((pSim->Idle && (Command != SPI_SDCARD_ACMD41_SD_SEND_OP_COND)) ? SPI_SDCARD_R1_ILLEGAL_COMMAND : 0x00u);
+    __SPI_SimSD_Respond(pSim, &Response[0], Size);
+    return;
+  }
+
+  //--- Commands ---
+  Response[1] = (pSim->Idle ? SPI_SDCARD_R1_IDLE : 0x00u);
+  switch (Command)
+  {
+    case SPI_SDCARD_CMD0_GO_IDLE_STATE:
+      break;
+    case SPI_SDCARD_CMD8_SEND_IF_COND:                                                             // R7: voltage accepted and check pattern
+      Response[4] = (uint8_t)((Argument >> 8) & 0x0Fu);
+      Response[5] = (uint8_t)Argument;
+      Size = 6;
+      break;
+    case SPI_SDCARD_CMD55_APP_CMD:
+      pSim->AppCommand = true;
+      break;
+    case SPI_SDCARD_CMD58_READ_OCR:                                                                // R3: power up status, CCS and 2.7-3.6V
+      Response[2] = (uint8_t)((pSim->Idle ? 0x00u : (SPI_SDCARD_OCR_POWER_UP >> 24)) | (SPI_SDCARD_OCR_CCS >> 24));
+      Response[3] = 0xFF;
+      Response[4] = 0x80;
+      Size = 6;
+      break;
+    case SPI_SDCARD_CMD59_CRC_ON_OFF:
+      pSim->CRCenabled = ((Argument & 0x1u) > 0);
+      break;
+    default:
+      if (pSim->Idle) { Response[1] |= SPI_SDCARD_R1_ILLEGAL_COMMAND; break; }                    // Only the identification commands in idle state
+      switch (Command)
+      {
+        case SPI_SDCARD_CMD9_SEND_CSD:
+          pSim->Multiple = false;
+          __SPI_SimSD_PrepareRead(pSim, &pSim->CSD[0], sizeof(pSim->CSD), 0);
+          break;
+        case SPI_SDCARD_CMD12_STOP_TRANSMISSION:                                                  // R1b: a stuff byte before the response, then a busy
+          Response[1] = 0xFF;
+          Size = 3;
+          pSim->Mode = SPI_SIMSD_MODE_NONE;
+          pSim->BusyUntil_ns = pSim->Time_ns + ((uint64_t)pSim->StopTime_us * 1000u);
+          break;
+        case SPI_SDCARD_CMD13_SEND_STATUS:                                                         // R2
+          Size = 3;
+          break;
+        case SPI_SDCARD_CMD16_SET_BLOCKLEN:
+          if (Argument != SPI_SDCARD_BLOCK_SIZE) Response[1] |= SPI_SDCARD_R1_PARAMETER_ERROR;
+          break;
+        case SPI_SDCARD_CMD17_READ_SINGLE_BLOCK:
+        case SPI_SDCARD_CMD18_READ_MULTIPLE_BLOCK:
+          if (Argument >= pSim->BlockCount) { Response[1] |= SPI_SDCARD_R1_PARAMETER_ERROR; break; }
+          pSim->ReadCommandCount++;
+          pSim->Multiple = (Command == SPI_SDCARD_CMD18_READ_MULTIPLE_BLOCK);
+          pSim->Block    = Argument;
+          __SPI_SimSD_PrepareBlock(pSim, pSim->ReadLatency_us);
+          break;
+        case SPI_SDCARD_CMD24_WRITE_BLOCK:
+        case SPI_SDCARD_CMD25_WRITE_MULTIPLE_BLOCK:
+          if (Argument >= pSim->BlockCount) { Response[1] |= SPI_SDCARD_R1_PARAMETER_ERROR; break; }
+          pSim->WriteCommandCount++;
+          pSim->Mode        = SPI_SIMSD_MODE_WRITE;
+          pSim->Multiple    = (Command == SPI_SDCARD_CMD25_WRITE_MULTIPLE_BLOCK);
+          pSim->Block       = Argument;
+          pSim->DataIndex   = 0;
+          pSim->ErasedGroup = SPI_SIMSD_NO_GROUP;
+          pSim->PreErased   = false;
+          pSim->PreEraseEnd = (pSim->Multiple ? Argument + pSim->PreEraseCount : 0u);
+          pSim->PreEraseCount = 0;                                                                 // The pre-erase count is only for the next multiple block write
+          break;
+        default:
+          Response[1] |= SPI_SDCARD_R1_ILLEGAL_COMMAND;
+          break;
+      }
+      break;
+  }
+  __SPI_SimSD_Respond(pSim, &Response[0], Size);
+}
+
+
+//=============================================================================
+// [STATIC] Receive a byte from the host
+//=============================================================================
+static void __SPI_SimSD_InByte(SPI_SimSD* pSim, uint8_t byte)
+{
+  if (pSim->CommandIndex > 0)                                                                      // Command frame in progress
+  {
+    pSim->Command[pSim->CommandIndex++] = byte;
+    if (pSim->CommandIndex >= SPI_SDCARD_COMMAND_SIZE)
+    {
+      pSim->CommandIndex = 0;
+      __SPI_SimSD_Execute(pSim);
+    }
+    return;
+  }
+  if (pSim->Mode == SPI_SIMSD_MODE_WRITE)
+  {
+    if (pSim->DataIndex > 0)                                                                       // Block in progress
+    {
+      pSim->WriteBuffer[pSim->DataIndex - 1u] = byte;
+      pSim->DataIndex++;
+      if (pSim->DataIndex > sizeof(pSim->WriteBuffer)) __SPI_SimSD_EndWriteBlock(pSim);
+      return;
+    }
+    if (pSim->Time_ns < pSim->BusyUntil_ns) return;                                                // The bytes are ignored while busy
+    if (byte == (pSim->Multiple ? SPI_SDCARD_TOKEN_START_MULTI : SPI_SDCARD_TOKEN_START_BLOCK)) { pSim->DataIndex = 1; return; }
+    if (pSim->Multiple && (byte == SPI_SDCARD_TOKEN_STOP_TRAN))
+    {
+      const uint8_t Response = 0xFF;                                                               // The busy starts one byte after the stop token
+      pSim->Mode = SPI_SIMSD_MODE_NONE;
+      __SPI_SimSD_Respond(pSim, &Response, 1);
+      pSim->BusyUntil_ns = pSim->Time_ns + ((uint64_t)pSim->StopTime_us * 1000u);
+      return;
+    }
+  }
+  if ((byte & 0xC0u) == 0x40u)                                                                     // Start bit and transmission bit of a command
+  {
+    pSim->Command[0]   = byte;
+    pSim->CommandIndex = 1;
+  }
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated SD card functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure a SPI_Interface to use a simulated SD card
+//=============================================================================
+eERRORRESULT SPI_SimSD_Attach(SPI_Interface *pIntDev, SPI_SimSD* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pSim == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pSim->pMemory == NULL) || (pSim->BlockCount == 0) || ((pSim->BlockCount % 1024u) > 0)) return ERR__SPI_CONFIG_ERROR;
+  if ((pSim->EraseGroupBlocks == 0) || ((pSim->EraseGroupBlocks & (pSim->EraseGroupBlocks - 1u)) > 0)) return ERR__SPI_CONFIG_ERROR;
+  pIntDev->InterfaceDevice           = pSim;
+  pIntDev->UniqueID                  = 0;
+  pIntDev->fnSPI_Init                = SPI_SimSD_Init;
+  pIntDev->fnSPI_Transfer            = SPI_SimSD_Transfer;
+  pIntDev->fnSPI_TransferSegmentList = NULL;
+  pIntDev->fnSPI_TransferPhases      = NULL;
+  pIntDev->fnSPI_TransferAsync       = NULL;
+  pIntDev->Channel                   = 0;
+
+  //--- Power up ---
+  const uint32_t CSize = (pSim->BlockCount / 1024u) - 1u;                                          // CSD version 2: capacity = (C_SIZE + 1) * 512KB
+  memset(&pSim->CSD[0], 0, sizeof(pSim->CSD));
+  pSim->CSD[0]  = 0x40;                                                                            // CSD_STRUCTURE = 1
+  pSim->CSD[5]  = 0x59;                                                                            // READ_BL_LEN = 9
+  pSim->CSD[7]  = (uint8_t)((CSize >> 16) & 0x3Fu);
+  pSim->CSD[8]  = (uint8_t)(CSize >> 8);
+  pSim->CSD[9]  = (uint8_t)CSize;
+  pSim->CSD[15] = (uint8_t)((CRC_Compute(CRC7_MMC, &pSim->CSD[0], 15) << 1) | 0x01u);
+  pSim->Idle          = true;
+  pSim->AppCommand    = false;
+  pSim->CRCenabled    = false;
+  pSim->InitCount     = 0;
+  pSim->CommandIndex  = 0;
+  pSim->ResponseCount = 0;
+  pSim->ResponseIndex = 0;
+  pSim->Mode          = SPI_SIMSD_MODE_NONE;
+  pSim->PreEraseCount = 0;
+  pSim->ReadyAt_ns    = 0;
+  pSim->BusyUntil_ns  = 0;
+  pSim->Time_ns       = 0;
+  pSim->TimeFraction_ps = 0;
+  pSim->SCKfreq       = 0;
+  pSim->ByteTime_ps   = 0;
+  SPI_SimSD_ResetStats(pSim);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Simulated SD card initialization
+//=============================================================================
+eERRORRESULT SPI_SimSD_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  (void)chipSelect;
+  SPI_SimSD* pSim = (SPI_SimSD*)pIntDev->InterfaceDevice;
+  if (sckFreq == 0) return ERR__SPI_FREQUENCY_ERROR;
+  if (SPI_PIN_COUNT_GET(mode) > 1) return ERR__NOT_SUPPORTED;                                      // The SPI mode of the SD cards is Standard SPI
+  pSim->SCKfreq     = sckFreq;
+  pSim->ByteTime_ps = (8u * 1000000000000u) / sckFreq;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Simulated SD card transfer
+//=============================================================================
+eERRORRESULT SPI_SimSD_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (pPacketDesc == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  SPI_SimSD* pSim = (SPI_SimSD*)pIntDev->InterfaceDevice;
+  if (pSim->SCKfreq == 0) return ERR__SPI_CONFIG_ERROR;
+  const bool UseDummyByte = (pPacketDesc->Config.Bits.UseDummyByte > 0) || (pPacketDesc->TxData == NULL);
+
+  //--- Exchange the bytes one by one ---
+  for (size_t zByte = 0; zByte < pPacketDesc->DataSize; ++zByte)
+  {
+    const uint8_t TxByte = (UseDummyByte ? pPacketDesc->DummyByte : pPacketDesc->TxData[zByte]);
+    const uint8_t RxByte = __SPI_SimSD_OutByte(pSim);
+    __SPI_SimSD_InByte(pSim, TxByte);
+    if (pPacketDesc->RxData != NULL) pPacketDesc->RxData[zByte] = RxByte;
+    pSim->SCKcycles       += 8u;
+    pSim->TimeFraction_ps += pSim->ByteTime_ps;
+    pSim->Time_ns         += pSim->TimeFraction_ps / 1000u;
+    pSim->TimeFraction_ps %= 1000u;
+  }
+
+  eERRORRESULT Error = Interface_SPIpacketCRC(pPacketDesc);
+  if (Error != ERR_NONE) return Error;
+  pPacketDesc->Config.Value &= ~SPI_ENDIAN_RESULT_Mask;                                            // The simulated card does not perform the endian transform
+  return Interface_SPIendianTransform(pPacketDesc);
+}
+
+
+//=============================================================================
+// Reset the statistics of the simulated SD card
+//=============================================================================
+void SPI_SimSD_ResetStats(SPI_SimSD* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return;
+#endif
+  pSim->SCKcycles         = 0;
+  pSim->DataBytes         = 0;
+  pSim->CommandCount      = 0;
+  pSim->ReadCommandCount  = 0;
+  pSim->WriteCommandCount = 0;
+  pSim->BlockReadCount    = 0;
+  pSim->BlockWriteCount   = 0;
+  pSim->EraseCount        = 0;
+  pSim->CRCerrorCount     = 0;
+  pSim->BusyBytes         = 0;
+}
+
+
+//=============================================================================
+// Get the simulated bus time used since the last statistics reset
+//=============================================================================
+uint64_t SPI_SimSD_GetBusTime_us(const SPI_SimSD* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return 0;
+#endif
+  if (pSim->SCKfreq == 0) return 0;
+  return (pSim->SCKcycles * 1000000u) / pSim->SCKfreq;
+}
+
+
+//=============================================================================
+// Get the effective data throughput of the simulated card
+//=============================================================================
+uint32_t SPI_SimSD_GetThroughput(const SPI_SimSD* pSim)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pSim == NULL) return 0;
+#endif
+  if (pSim->SCKcycles == 0) return 0;
+  return (uint32_t)((pSim->DataBytes * pSim->SCKfreq) / pSim->SCKcycles);
+}
+
+//-----------------------------------------------------------------------------
+#endif // #if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,199 @@
+/*!*****************************************************************************
+ * @file    SPI_SimSD.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Simulated SD card in SPI mode for host tests
+ * @details This simulated SD card plugs into the generic SPI_Interface of all
+ * the https://github.com/Emandhal drivers and developments. It decodes the
+ * commands of the SD cards in SPI mode (identification, CSD, single and
+ * multiple block reads and writes, pre-erase count, stop) byte per byte and
+ * counts the SCK cycles to give the bus time for the SCK frequency. The read
+ * latency, the program time of a block and the erase time of an erase group
+ * run on this bus time, so the data token and busy polling have a real cost.
+ * The erase of a group is only needed once for the blocks pre-erased (ACMD23)
+ * of a multiple block write, and for each single block write
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_SIMSD_H_INC
+#define __SPI_SIMSD_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+#include "SPI_SDcard.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! Data mode of the simulated SD card enum
+typedef enum
+{
+  SPI_SIMSD_MODE_NONE  = 0x0u, //!< No data transfer
+  SPI_SIMSD_MODE_READ  = 0x1u, //!< Blocks or a register are sent to the host
+  SPI_SIMSD_MODE_WRITE = 0x2u, //!< Blocks are received from the host
+} eSPI_SimSDmode;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated SD card
+//********************************************************************************************************************
+
+//! @brief Simulated SD card (high capacity, block addressing). Set this structure as the SPI_Interface.InterfaceDevice
+typedef struct SPI_SimSD
+{
+  uint8_t* pMemory;                                 //!< Content of the card (BlockCount * #SPI_SDCARD_BLOCK_SIZE bytes)
+  uint32_t BlockCount;                              //!< Count of blocks of the card. Shall be a multiple of 1024
+  uint32_t InitPolls;                               //!< Count of ACMD41 answered with the idle state before the card is ready
+  uint32_t ReadLatency_us;                          //!< Time between a read command and the data token of its first block (typical 100 to 1000)
+  uint32_t StreamLatency_us;                        //!< Time between two blocks of a multiple block read
+  uint32_t ProgramTime_us;                          //!< Busy time of a block written (typical 100 to 500)
+  uint32_t EraseTime_us;                            //!< Busy time of the erase of an erase group before its first block written (typical 1000 to 10000)
+  uint32_t EraseGroupBlocks;                        //!< Count of blocks of an erase group (power of 2)
+  uint32_t StopTime_us;                             //!< Busy time after a stop
+  //--- Configuration set by SPI_SimSD_Init() ---
+  uint32_t SCKfreq;                                 //!< SCK frequency in Hz
+  uint64_t ByteTime_ps;                             //!< Bus time of a byte in picoseconds
+  //--- Card state ---
+  bool Idle;                                        //!< 'true' while the card is in idle state
+  bool AppCommand;                                  //!< 'true' if the next command is an application command
+  bool CRCenabled;                                  //!< 'true' if the CRC of the commands and of the data blocks are checked (CMD59)
+  uint32_t InitCount;                               //!< Count of ACMD41 received
+  uint8_t CSD[16];                                  //!< CSD register
+  uint8_t Command[SPI_SDCARD_COMMAND_SIZE];         //!< Command frame in progress
+  size_t CommandIndex;                              //!< Count of bytes of the command frame received
+  uint8_t Response[8];                              //!< Response bytes to send
+  size_t ResponseCount;                             //!< Count of response bytes
+  size_t ResponseIndex;                             //!< Count of response bytes sent
+  eSPI_SimSDmode Mode;                              //!< Data mode
+  bool Multiple;                                    //!< 'true' if the data mode is a multiple block command
+  uint32_t Block;                                   //!< Block in progress
+  const uint8_t* pReadData;                         //!< Data of the block or register sent
+  size_t ReadSize;                                  //!< Size of the block or register sent
+  size_t DataIndex;                                 //!< Index of the byte of the block in progress (0 before its data token, then the data and the CRC)
+  uint8_t BlockCRC[2];                              //!< CRC of the block sent
+  uint8_t WriteBuffer[2 + SPI_SDCARD_BLOCK_SIZE];   //!< Block received with its CRC
+  uint32_t ErasedGroup;                             //!< Erase group erased for the multiple block write in progress
+  bool PreErased;                                   //!< 'true' if the blocks pre-erased of the multiple block write in progress are erased
+  uint32_t PreEraseCount;                           //!< Count of blocks to pre-erase set by ACMD23
+  uint32_t PreEraseEnd;                             //!< End of the blocks pre-erased of the multiple block write in progress
+  uint64_t ReadyAt_ns;                              //!< Time of the next data token of a read
+  uint64_t BusyUntil_ns;                            //!< Time of the end of the busy
+  uint64_t Time_ns;                                 //!< Time of the card, advanced by the bus time of the transfers
+  uint64_t TimeFraction_ps;                         //!< Picoseconds of the bus time not yet added to Time_ns
+  //--- Statistics ---
+  uint64_t SCKcycles;                               //!< Count of SCK cycles used on the bus
+  uint64_t DataBytes;                               //!< Count of data bytes of the blocks transferred
+  uint32_t CommandCount;                            //!< Count of commands
+  uint32_t ReadCommandCount;                        //!< Count of read commands (CMD17, CMD18)
+  uint32_t WriteCommandCount;                       //!< Count of write commands (CMD24, CMD25)
+  uint32_t BlockReadCount;                          //!< Count of blocks read
+  uint32_t BlockWriteCount;                         //!< Count of blocks written
+  uint32_t EraseCount;                              //!< Count of erase group erases
+  uint32_t CRCerrorCount;                           //!< Count of commands and blocks with a bad CRC
+  uint64_t BusyBytes;                               //!< Count of bytes received while busy or waiting for a data token
+} SPI_SimSD;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Simulated SD card functions
+//********************************************************************************************************************
+
+/*! @brief Configure a SPI_Interface to use a simulated SD card
+ *
+ * The card is powered up: it is reset and waits for CMD0, and the statistics are reset
+ * @param[out] *pIntDev Is the SPI interface container structure to configure
+ * @param[in] *pSim Is the simulated card to use. Its memory, block count and timings shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimSD_Attach(SPI_Interface *pIntDev, SPI_SimSD* pSim);
+
+/*! @brief Simulated SD card initialization (#SPIInit_Func compatible)
+ *
+ * Only set the SCK frequency: the card keeps its state when the host changes the SCK frequency after the identification
+ * @param[in] *pIntDev Is the SPI interface container structure used for the interface initialization
+ * @param[in] chipSelect Is the Chip Select index of the card (not used)
+ * @param[in] mode Is the mode of the SPI to configure. Shall be a Standard SPI mode
+ * @param[in] sckFreq Is the SCK frequency in Hz
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimSD_Init(SPI_Interface *pIntDev, uint8_t chipSelect, eSPIInterface_Mode mode, const uint32_t sckFreq);
+
+/*! @brief Simulated SD card transfer (#SPITransferPacket_Func compatible)
+ *
+ * The bytes of the packets are exchanged with the card one by one. The card ignores the ChipSelect, as a card that keeps its state between two assertions
+ * @param[in] *pIntDev Is the SPI interface container structure used for the communication
+ * @param[in] *pPacketDesc Is the packet description to transfer through SPI
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_SimSD_Transfer(SPI_Interface *pIntDev, SPIInterface_Packet* const pPacketDesc);
+
+/*! @brief Reset the statistics of the simulated SD card
+ *
+ * @param[in] *pSim Is the simulated card
+ */
+void SPI_SimSD_ResetStats(SPI_SimSD* pSim);
+
+/*! @brief Get the simulated bus time used since the last statistics reset
+ *
+ * @param[in] *pSim Is the simulated card
+ * @return Returns the bus time in microseconds at the configured SCK frequency
+ */
+uint64_t SPI_SimSD_GetBusTime_us(const SPI_SimSD* pSim);
+
+/*! @brief Get the effective data throughput of the simulated card since the last statistics reset
+ *
+ * This takes into account the commands, the data tokens, the CRC, the latencies and the busy times
+ * @param[in] *pSim Is the simulated card
+ * @return Returns the data throughput in bytes per second
+ */
+uint32_t SPI_SimSD_GetThroughput(const SPI_SimSD* pSim);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_SIMSD_H_INC */
@@ -0,0 +1,214 @@
+/*!*****************************************************************************
+ * @file    SPI_XIPcache.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Execute-in-place style read cache for SPI memories
+ * @details This read cache gives a memory-mapped style access to a Dual/Quad-SPI
+ *          memory through the phase transfers of the SPI_Interface for all the
+ *          https://github.com/Emandhal drivers and developments
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "SPI_XIPcache.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI execute-in-place read cache internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Read data from the memory with the read instruction
+//=============================================================================
+static eERRORRESULT __SPI_XIP_BusRead(SPI_XIPcache* pCache, uint32_t address, uint8_t* pData, size_t size)
+{
+  SPIInterface_PhasePacket Packet = pCache->ReadCommand;
+  Packet.Config.Value &= ~SPI_ENDIAN_RESULT_Mask;
+  Packet.Address  = address;
+  Packet.TxData   = NULL;
+  Packet.RxData   = pData;
+  Packet.DataSize = size;
+  pCache->BusReads++;
+  pCache->BusBytes += size;
+  return Interface_SPItransferPhases(pCache->pSPI, &Packet);
+}
+
+
+//=============================================================================
+// [STATIC] Copy the part of a read that is in a cache line
+//=============================================================================
+static void __SPI_XIP_CopyLine(const SPI_XIPcache* pCache, uint32_t line, uint32_t address, uint8_t* pData, size_t size)
+{
+  const uint32_t LineAddress = line * SPI_XIP_LINE_SIZE;
+  const uint32_t Start = (address > LineAddress ? address : LineAddress);
+  const uint32_t End   = ((address + size) < (LineAddress + SPI_XIP_LINE_SIZE) ? (uint32_t)(address + size) : (LineAddress + SPI_XIP_LINE_SIZE));
+  const size_t Slot    = line & (pCache->LineCount - 1u);
+  memcpy(&pData[Start - address], &pCache->pLines[(Slot * SPI_XIP_LINE_SIZE) + (Start - LineAddress)], End - Start);
+}
+
+
+//=============================================================================
+// [STATIC] Fill a run of cache lines from the memory
+//=============================================================================
+static eERRORRESULT __SPI_XIP_FillLines(SPI_XIPcache* pCache, uint32_t line, size_t count)
+{
+  const size_t Slot = line & (pCache->LineCount - 1u);
+  for (size_t zIdx = 0; zIdx < count; ++zIdx) pCache->pTags[Slot + zIdx] = SPI_XIP_INVALID_TAG; // The lines are not valid if the read fails
+  eERRORRESULT Error = __SPI_XIP_BusRead(pCache, line * SPI_XIP_LINE_SIZE, &pCache->pLines[Slot * SPI_XIP_LINE_SIZE], count * SPI_XIP_LINE_SIZE);
+  if (Error != ERR_NONE) return Error;
+  for (size_t zIdx = 0; zIdx < count; ++zIdx) pCache->pTags[Slot + zIdx] = line + (uint32_t)zIdx;
+  pCache->LineMisses += (uint32_t)count;
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI execute-in-place read cache functions
+//********************************************************************************************************************
+//=============================================================================
+// SPI execute-in-place read cache initialization
+//=============================================================================
+eERRORRESULT SPI_XIP_Init(SPI_XIPcache* pCache)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pCache == NULL) || (pCache->pSPI == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((pCache->pLines == NULL) || (pCache->pTags == NULL)) return ERR__NULL_BUFFER;
+  if ((pCache->LineCount == 0) || ((pCache->LineCount & (pCache->LineCount - 1u)) > 0)) return ERR__SPI_CONFIG_ERROR;
+  if ((pCache->MemorySize == 0) || ((pCache->MemorySize % SPI_XIP_LINE_SIZE) > 0)) return ERR__SPI_CONFIG_ERROR;
+  if (pCache->ReadCommand.DataLines == SPI_PHASE_NONE) return ERR__SPI_CONFIG_ERROR;
+  if (SPI_ENDIAN_TRANSFORM_GET(pCache->ReadCommand.Config.Value) != SPI_NO_ENDIAN_CHANGE) return ERR__SPI_CONFIG_ERROR; // The cache lines keep the memory data as is
+  SPI_XIP_InvalidateAll(pCache);
+  SPI_XIP_ResetStats(pCache);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Read data from the memory through the cache
+//=============================================================================
+eERRORRESULT SPI_XIP_Read(SPI_XIPcache* pCache, uint32_t address, uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pCache == NULL) return ERR__SPI_PARAMETER_ERROR;
+  if (pData == NULL) return ERR__NULL_BUFFER;
+#endif
+  if (size == 0) return ERR_NONE;
+  if ((address >= pCache->MemorySize) || (size > (size_t)(pCache->MemorySize - address))) return ERR__BAD_ADDRESS;
+  if (size >= (pCache->LineCount * SPI_XIP_LINE_SIZE)) return __SPI_XIP_BusRead(pCache, address, pData, size); // Too big for the cache, read directly
+  eERRORRESULT Error;
+
+  //--- Read line by line ---
+  const uint32_t LastLine = (uint32_t)((address + size - 1u) / SPI_XIP_LINE_SIZE);
+  const uint32_t SlotMask = (uint32_t)(pCache->LineCount - 1u);
+  uint32_t Line = address / SPI_XIP_LINE_SIZE;
+  while (Line <= LastLine)
+  {
+    if (pCache->pTags[Line & SlotMask] == Line)
+    {
+      __SPI_XIP_CopyLine(pCache, Line, address, pData, size);
+      pCache->LineHits++;
+      ++Line;
+      continue;
+    }
+    //--- Fill the run of missing lines with one read, up to the end of the cache lines array ---
+    uint32_t EndLine = Line + 1;
+    while ((EndLine <= LastLine) && ((EndLine & SlotMask) != 0) && (pCache->pTags[EndLine & SlotMask] != EndLine)) ++EndLine;
+    Error = __SPI_XIP_FillLines(pCache, Line, EndLine - Line);
+    if (Error != ERR_NONE) return Error;
+    for (; Line < EndLine; ++Line) __SPI_XIP_CopyLine(pCache, Line, address, pData, size);
+  }
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Get a pointer to the data of the memory in the cache
+//=============================================================================
+eERRORRESULT SPI_XIP_GetPointer(SPI_XIPcache* pCache, uint32_t address, size_t size, const uint8_t** ppData)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pCache == NULL) || (ppData == NULL)) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if ((address >= pCache->MemorySize) || (size > (size_t)(pCache->MemorySize - address))) return ERR__BAD_ADDRESS;
+  if (((address % SPI_XIP_LINE_SIZE) + size) > SPI_XIP_LINE_SIZE) return ERR__OUT_OF_RANGE;
+  const uint32_t Line = address / SPI_XIP_LINE_SIZE;
+  const size_t Slot   = Line & (pCache->LineCount - 1u);
+  if (pCache->pTags[Slot] == Line) pCache->LineHits++;
+  else
+  {
+    eERRORRESULT Error = __SPI_XIP_FillLines(pCache, Line, 1);
+    if (Error != ERR_NONE) return Error;
+  }
+  *ppData = &pCache->pLines[(Slot * SPI_XIP_LINE_SIZE) + (address % SPI_XIP_LINE_SIZE)];
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Invalidate the cache lines of a range of the memory
+//=============================================================================
+eERRORRESULT SPI_XIP_Invalidate(SPI_XIPcache* pCache, uint32_t address, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pCache == NULL) return ERR__SPI_PARAMETER_ERROR;
+#endif
+  if (size == 0) return ERR_NONE;
+  if ((address >= pCache->MemorySize) || (size > (size_t)(pCache->MemorySize - address))) return ERR__BAD_ADDRESS;
+  const uint32_t FirstLine = address / SPI_XIP_LINE_SIZE;
+  const uint32_t LastLine  = (uint32_t)((address + size - 1u) / SPI_XIP_LINE_SIZE);
+  for (size_t zSlot = 0; zSlot < pCache->LineCount; ++zSlot)                                    // Check the tags of the cache instead of the lines of the range, an erase can be bigger than the cache
+    if ((pCache->pTags[zSlot] >= FirstLine) && (pCache->pTags[zSlot] <= LastLine)) pCache->pTags[zSlot] = SPI_XIP_INVALID_TAG;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Invalidate all the cache lines
+//=============================================================================
+void SPI_XIP_InvalidateAll(SPI_XIPcache* pCache)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pCache == NULL) return;
+#endif
+  for (size_t zSlot = 0; zSlot < pCache->LineCount; ++zSlot) pCache->pTags[zSlot] = SPI_XIP_INVALID_TAG;
+}
+
+
+//=============================================================================
+// Reset the statistics of the read cache
+//=============================================================================
+void SPI_XIP_ResetStats(SPI_XIPcache* pCache)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pCache == NULL) return;
+#endif
+  pCache->LineHits   = 0;
+  pCache->LineMisses = 0;
+  pCache->BusReads   = 0;
+  pCache->BusBytes   = 0;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,157 @@
+/*!*****************************************************************************
+ * @file    SPI_XIPcache.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Execute-in-place style read cache for SPI memories
+ * @details This read cache gives a memory-mapped style access to a Dual/Quad-SPI
+ * memory through the phase transfers of the SPI_Interface for all the
+ * https://github.com/Emandhal drivers and developments. The memory is read by
+ * lines kept in a direct-mapped cache:
+ * - Reads of lines already in the cache do not use the bus
+ * - Consecutive missing lines of a read are filled with one read instruction
+ * - Reads bigger than the cache go directly to the user buffer
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __SPI_XIPCACHE_H_INC
+#define __SPI_XIPCACHE_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "SPI_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef SPI_XIP_LINE_SIZE
+#  define SPI_XIP_LINE_SIZE  ( 32u )          //!< Size of a cache line in bytes. Shall be a power of 2
+#endif
+#define SPI_XIP_INVALID_TAG  ( 0xFFFFFFFFu )  //!< Tag of a line not in the cache
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI execute-in-place read cache
+//********************************************************************************************************************
+
+//! @brief SPI execute-in-place read cache. All the arrays are given by the user
+typedef struct SPI_XIPcache
+{
+  SPI_Interface* pSPI;                  //!< SPI interface of the memory
+  SPIInterface_PhasePacket ReadCommand; //!< Read instruction of the memory with its phases (instruction, lines, address size, dummy cycles). The address and the data are set by the cache
+  uint32_t MemorySize;                  //!< Size of the memory in bytes. Shall be a multiple of #SPI_XIP_LINE_SIZE
+  uint8_t* pLines;                      //!< Data of the cache lines (LineCount * #SPI_XIP_LINE_SIZE bytes)
+  uint32_t* pTags;                      //!< Memory line index of each cache line (LineCount values). #SPI_XIP_INVALID_TAG if the cache line is empty
+  size_t LineCount;                     //!< Count of cache lines. Shall be a power of 2
+  //--- Statistics ---
+  uint32_t LineHits;                    //!< Count of lines read from the cache
+  uint32_t LineMisses;                  //!< Count of lines read from the memory
+  uint32_t BusReads;                    //!< Count of read instructions sent to the memory
+  uint64_t BusBytes;                    //!< Count of bytes read from the memory
+} SPI_XIPcache;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// SPI execute-in-place read cache functions
+//********************************************************************************************************************
+
+/*! @brief SPI execute-in-place read cache initialization
+ *
+ * Check the configuration, empty the cache and reset the statistics. The SPI interface shall already be initialized
+ * @param[in] *pCache Is the read cache to initialize. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_XIP_Init(SPI_XIPcache* pCache);
+
+/*! @brief Read data from the memory through the cache
+ *
+ * The lines already in the cache are copied without using the bus, each run of consecutive missing lines is read with one read instruction and kept in the cache
+ * A read of a size of the whole cache or more is transferred directly to the data buffer and does not change the cache
+ * @param[in] *pCache Is the read cache
+ * @param[in] address Is the address of the memory where to read
+ * @param[out] *pData Is where the data read will be stored
+ * @param[in] size Is the size of the data to read
+ * @return Returns an #eERRORRESULT value enum. #ERR__BAD_ADDRESS if the read goes past the end of the memory
+ */
+eERRORRESULT SPI_XIP_Read(SPI_XIPcache* pCache, uint32_t address, uint8_t* pData, size_t size);
+
+/*! @brief Get a pointer to the data of the memory in the cache
+ *
+ * Memory-mapped style access: the line of the data is read if needed and a pointer to the data in the cache line is given. The pointer stays valid until the line is replaced by another read or invalidated
+ * @param[in] *pCache Is the read cache
+ * @param[in] address Is the address of the memory to access
+ * @param[in] size Is the size of the data to access. The data shall not cross a line boundary
+ * @param[out] **ppData Is where the pointer to the data will be stored
+ * @return Returns an #eERRORRESULT value enum. #ERR__OUT_OF_RANGE if the data crosses a line boundary
+ */
+eERRORRESULT SPI_XIP_GetPointer(SPI_XIPcache* pCache, uint32_t address, size_t size, const uint8_t** ppData);
+
+/*! @brief Invalidate the cache lines of a range of the memory
+ *
+ * Use this after a program or an erase of the memory
+ * @param[in] *pCache Is the read cache
+ * @param[in] address Is the address of the range to invalidate
+ * @param[in] size Is the size of the range to invalidate
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT SPI_XIP_Invalidate(SPI_XIPcache* pCache, uint32_t address, size_t size);
+
+/*! @brief Invalidate all the cache lines
+ *
+ * @param[in] *pCache Is the read cache
+ */
+void SPI_XIP_InvalidateAll(SPI_XIPcache* pCache);
+
+/*! @brief Reset the statistics of the read cache
+ *
+ * @param[in] *pCache Is the read cache
+ */
+void SPI_XIP_ResetStats(SPI_XIPcache* pCache);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __SPI_XIPCACHE_H_INC */
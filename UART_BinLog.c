@@ -0,0 +1,181 @@
+/*!*****************************************************************************
+ * @file    UART_BinLog.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Deferred binary logging over a UART interface
+ * @details A record is at most UART_BINLOG_RECORD_MAX_SIZE bytes, less than a
+ *          COBS block, so its encoding is always the record plus 2 bytes
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "UART_BinLog.h"
+#include "UART_Framer.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#if (UART_BINLOG_MAX_ARGS > UART_BINLOG_ARGS_COUNT_Mask) || (UART_BINLOG_RECORD_MAX_SIZE > UART_FRAMER_COBS_MAX_BLOCK)
+#  error UART_BINLOG_MAX_ARGS is too big
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Put a 32-bit value in little endian
+//=============================================================================
+static void __UART_BinLog_Put32(uint8_t* pData, uint32_t value)
+{
+  pData[0] = (uint8_t)(value >>  0);
+  pData[1] = (uint8_t)(value >>  8);
+  pData[2] = (uint8_t)(value >> 16);
+  pData[3] = (uint8_t)(value >> 24);
+}
+
+
+//=============================================================================
+// [STATIC] COBS encode a record shorter than a COBS block. Returns the encoded size
+//=============================================================================
+static size_t __UART_BinLog_EncodeCOBS(const uint8_t* pData, size_t size, uint8_t* pEncoded)
+{
+  size_t Code = 0, Write = 1;
+  for (size_t zByte = 0; zByte < size; ++zByte)
+  {
+    if (pData[zByte] == UART_FRAMER_COBS_DELIMITER)                              // The code byte of the block replaces the zero
+    {
+      pEncoded[Code] = (uint8_t)(Write - Code);
+      Code = Write++;
+    }
+    else pEncoded[Write++] = pData[zByte];
+  }
+  pEncoded[Code]    = (uint8_t)(Write - Code);
+  pEncoded[Write++] = UART_FRAMER_COBS_DELIMITER;
+  return Write;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log functions
+//********************************************************************************************************************
+//=============================================================================
+// UART binary log initialization
+//=============================================================================
+eERRORRESULT UART_BinLog_Init(UART_BinLog* pLog)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pLog == NULL) || (pLog->pRing == NULL) || (pLog->pUART == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pLog->pRing->Size < UART_BINLOG_ENCODED_MAX_SIZE) return ERR__CONFIGURATION;
+  pLog->Sequence     = 0;
+  pLog->RecordCount  = 0;
+  pLog->DroppedCount = 0;
+  pLog->MaxUsage     = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Write a record in the ring of the binary log
+//=============================================================================
+eERRORRESULT UART_BinLog_Write(UART_BinLog* pLog, uint16_t id, const uint32_t* pArgs, size_t argCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pLog == NULL) || (pLog->pRing == NULL) || ((pArgs == NULL) && (argCount > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  if (argCount > UART_BINLOG_MAX_ARGS) return ERR__OUT_OF_RANGE;
+
+  //--- Fill the record ---
+  uint8_t Record[UART_BINLOG_RECORD_MAX_SIZE];
+  size_t Size = UART_BINLOG_HEADER_SIZE;
+  Record[0] = (uint8_t)(id >> 0);
+  Record[1] = (uint8_t)(id >> 8);
+  Record[2] = (uint8_t)argCount;
+  Record[3] = pLog->Sequence++;                                                  // Also incremented for a dropped record, the host sees the gap
+  if (pLog->fnGetTimestamp != NULL)
+  {
+    Record[2] |= UART_BINLOG_TIMESTAMP_FLAG;
+    __UART_BinLog_Put32(&Record[Size], pLog->fnGetTimestamp());
+    Size += 4u;
+  }
+  for (size_t zArg = 0; zArg < argCount; ++zArg, Size += 4u) __UART_BinLog_Put32(&Record[Size], pArgs[zArg]);
+
+  //--- Encode it in the ring ---
+  UART_RingSpans Spans;
+  if (UART_RingBuffer_PeekWrite(pLog->pRing, &Spans) < (Size + 2u))              // The record is whole or not at all
+  {
+    pLog->DroppedCount++;
+    return ERR__BUFFER_FULL;
+  }
+  uint8_t Encoded[UART_BINLOG_ENCODED_MAX_SIZE];
+  const size_t EncodedSize = __UART_BinLog_EncodeCOBS(&Record[0], Size, &Encoded[0]);
+  const size_t First = (EncodedSize < Spans.Span[0].Size ? EncodedSize : Spans.Span[0].Size);
+  memcpy(Spans.Span[0].pData, &Encoded[0], First);
+  memcpy(Spans.Span[1].pData, &Encoded[First], EncodedSize - First);
+  UART_RingBuffer_CommitWrite(pLog->pRing, EncodedSize);
+  pLog->RecordCount++;
+  const size_t Usage = (pLog->pRing->Size - Spans.Size) + EncodedSize;          // Bytes in the ring at the peek with this record
+  if (Usage > pLog->MaxUsage) pLog->MaxUsage = (uint32_t)Usage;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Write a record of up to 4 arguments in the ring of the binary log
+//=============================================================================
+eERRORRESULT UART_BinLog_WriteArgs(UART_BinLog* pLog, uint16_t id, size_t argCount, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3)
+{
+  if (argCount > 4u) return ERR__OUT_OF_RANGE;
+  const uint32_t Args[4] = { a0, a1, a2, a3 };
+  return UART_BinLog_Write(pLog, id, &Args[0], argCount);
+}
+
+
+//=============================================================================
+// Send the records of the ring to the UART
+//=============================================================================
+eERRORRESULT UART_BinLog_Flush(UART_BinLog* pLog, size_t* pPending)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pLog == NULL) || (pLog->pRing == NULL) || (pLog->pUART == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  const eERRORRESULT Error = UART_RingBuffer_TransmitTo(pLog->pUART, pLog->pRing, NULL);
+  if (pPending != NULL) *pPending = UART_RingBuffer_Count(pLog->pRing);
+  return Error;
+}
+
+
+//=============================================================================
+// Get the bits of a float argument
+//=============================================================================
+uint32_t UART_BinLog_Float(float value)
+{
+  uint32_t Bits;
+  memcpy(&Bits, &value, sizeof(Bits));
+  return Bits;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
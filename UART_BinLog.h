@@ -0,0 +1,210 @@
+/*!*****************************************************************************
+ * @file    UART_BinLog.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Deferred binary logging over a UART interface
+ * @details The device never formats a log line: a log record is the numeric
+ * ID of its format string and its arguments as raw 32-bit words. The record
+ * is COBS encoded (see UART_Framer.h) in a lock-free ring buffer and the
+ * ring is sent to the UART in batches by UART_BinLog_Flush(). The host gets
+ * the frames with a UART_Framer and rebuilds the text with the format
+ * strings of the same message list (see UART_BinLogHost.h).
+ * The messages are listed once in an X-macro table of a project header, like
+ * the ERRORS_TABLE of ErrorsDef.h:
+ *
+ *   #define APP_LOG_TABLE                                    \
+ *     X(LOG_BOOT, "Boot, reset cause 0x%02X"               ) \
+ *     X(LOG_TEMP, "Temperature %d.%u C, supply %.2f V"     )
+ *
+ *   typedef enum                        // Device and host
+ *   {
+ *   #define X(eName, format) eName,
+ *     APP_LOG_TABLE
+ *   #undef X
+ *   } eAppLogId;
+ *
+ *   static const char* const AppLogFormats[] = // Host only
+ *   {
+ *   #define X(eName, format) format,
+ *     APP_LOG_TABLE
+ *   #undef X
+ *   };
+ *
+ * The IDs are the values of the enum set at build time, the format strings
+ * are not in the device firmware. The host dictionary is the array of the
+ * format strings, indexed by ID.
+ * Record (before COBS encoding, little endian):
+ *   ID (16 bits), argument count (4 bits) + timestamp flag (bit 7),
+ *   sequence (8 bits), [timestamp (32 bits)], arguments (32 bits each).
+ * The sequence increments for each record, written or dropped, so the host
+ * sees the records lost when the ring was full
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __UART_BINLOG_H_INC
+#define __UART_BINLOG_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "UART_Interface.h"
+#include "UART_RingBuffer.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef UART_BINLOG_MAX_ARGS
+#  define UART_BINLOG_MAX_ARGS  ( 8u ) //!< Max count of arguments of a record (max 15)
+#endif
+
+#define UART_BINLOG_HEADER_SIZE         ( 4u )                                                         //!< Size of the header of a record: ID, argument count and flags, sequence
+#define UART_BINLOG_ARGS_COUNT_Mask     ( 0x0Fu )                                                      //!< Argument count in the second byte of the record header
+#define UART_BINLOG_TIMESTAMP_FLAG      ( 0x80u )                                                      //!< A 32-bit timestamp follows the record header
+#define UART_BINLOG_RECORD_MAX_SIZE     ( UART_BINLOG_HEADER_SIZE + 4u + (4u * UART_BINLOG_MAX_ARGS) ) //!< Max size of a record before encoding
+#define UART_BINLOG_ENCODED_MAX_SIZE    ( UART_BINLOG_RECORD_MAX_SIZE + 2u )                           //!< Max size of a record in the ring: COBS code byte and delimiter added
+
+//-----------------------------------------------------------------------------
+
+//! Log a record without argument. Like all the UART_BINLOGx() helpers, returns the #eERRORRESULT of UART_BinLog_Write()
+#define UART_BINLOG0(pLog, id)  \
+  UART_BinLog_Write((pLog), (uint16_t)(id), NULL, 0u)
+//! Log a record with 1 argument. The arguments are converted to uint32_t, use UART_BinLog_Float() for the float arguments
+#define UART_BINLOG1(pLog, id, a0)  \
+  UART_BinLog_WriteArgs((pLog), (uint16_t)(id), 1u, (uint32_t)(a0), 0u, 0u, 0u)
+//! Log a record with 2 arguments
+#define UART_BINLOG2(pLog, id, a0, a1)  \
+  UART_BinLog_WriteArgs((pLog), (uint16_t)(id), 2u, (uint32_t)(a0), (uint32_t)(a1), 0u, 0u)
+//! Log a record with 3 arguments
+#define UART_BINLOG3(pLog, id, a0, a1, a2)  \
+  UART_BinLog_WriteArgs((pLog), (uint16_t)(id), 3u, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), 0u)
+//! Log a record with 4 arguments
+#define UART_BINLOG4(pLog, id, a0, a1, a2, a3)  \
+  UART_BinLog_WriteArgs((pLog), (uint16_t)(id), 4u, (uint32_t)(a0), (uint32_t)(a1), (uint32_t)(a2), (uint32_t)(a3))
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log
+//********************************************************************************************************************
+
+/*! @brief Function that gives the timestamp of the records
+ *
+ * @return Returns the current time, in the unit of the application
+ */
+typedef uint32_t (*UART_BinLogTimestamp_Func)(void);
+
+
+//! @brief UART binary log
+typedef struct UART_BinLog
+{
+  UART_RingBuffer* pRing;                   //!< Ring of the encoded records. The writer of the records is its producer, the flush is its consumer. Shall be initialized
+  UART_Interface* pUART;                    //!< UART interface where the records are sent
+  UART_BinLogTimestamp_Func fnGetTimestamp; //!< Timestamp of the records. Can be NULL to send the records without timestamp
+  //--- Log state ---
+  uint8_t Sequence;                         //!< Sequence of the next record
+  //--- Statistics ---
+  uint32_t RecordCount;                     //!< Count of records written in the ring
+  uint32_t DroppedCount;                    //!< Count of records dropped because the ring was full
+  uint32_t MaxUsage;                        //!< Max count of bytes in the ring after a write. Near the ring size, the ring or the flush rate shall increase
+} UART_BinLog;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log functions
+//********************************************************************************************************************
+
+/*! @brief UART binary log initialization
+ *
+ * @param[in] *pLog Is the binary log to initialize. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum. #ERR__CONFIGURATION if the ring cannot hold a record of #UART_BINLOG_ENCODED_MAX_SIZE bytes
+ */
+eERRORRESULT UART_BinLog_Init(UART_BinLog* pLog);
+
+/*! @brief Write a record in the ring of the binary log
+ *
+ * Only one context shall write in a binary log (single producer of the ring): use a binary log per context that logs, each one with its UART, or serialize the writes.
+ * The record is never partially written: if the ring is full, the record is dropped and counted in UART_BinLog.DroppedCount
+ * @param[in] *pLog Is the binary log
+ * @param[in] id Is the ID of the message
+ * @param[in] *pArgs Is the arguments of the message. Can be NULL if argCount is 0
+ * @param[in] argCount Is the count of arguments. Max #UART_BINLOG_MAX_ARGS
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUFFER_FULL if the record has been dropped
+ */
+eERRORRESULT UART_BinLog_Write(UART_BinLog* pLog, uint16_t id, const uint32_t* pArgs, size_t argCount);
+
+/*! @brief Write a record of up to 4 arguments in the ring of the binary log
+ *
+ * Used by the UART_BINLOG1() to UART_BINLOG4() helpers, the arguments do not need an array of the caller
+ * @param[in] *pLog Is the binary log
+ * @param[in] id Is the ID of the message
+ * @param[in] argCount Is the count of arguments. Max 4
+ * @param[in] a0 Is the first argument, ignored if argCount is 0
+ * @param[in] a1 Is the second argument, ignored if argCount is less than 2
+ * @param[in] a2 Is the third argument, ignored if argCount is less than 3
+ * @param[in] a3 Is the fourth argument, ignored if argCount is less than 4
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUFFER_FULL if the record has been dropped
+ */
+eERRORRESULT UART_BinLog_WriteArgs(UART_BinLog* pLog, uint16_t id, size_t argCount, uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+/*! @brief Send the records of the ring to the UART
+ *
+ * Send as many bytes as the UART accepts, the next flush continues where this one stopped. Only one context shall flush a binary log (single consumer of the ring)
+ * @param[in] *pLog Is the binary log
+ * @param[out] *pPending Is where the count of bytes still waiting in the ring will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_BinLog_Flush(UART_BinLog* pLog, size_t* pPending);
+
+/*! @brief Get the bits of a float argument
+ *
+ * @param[in] value Is the float value
+ * @return Returns the IEEE 754 bits of the value, to give as argument of a record
+ */
+uint32_t UART_BinLog_Float(float value);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __UART_BINLOG_H_INC */
@@ -0,0 +1,197 @@
+/*!*****************************************************************************
+ * @file    UART_BinLogHost.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Host decoder of the UART binary log
+ * @details Each conversion of the format string is printed alone with its
+ *          argument cast to the type the conversion expects
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "UART_BinLogHost.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+#if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+
+#define UART_BINLOGHOST_SPEC_MAX  ( 24u ) //!< Max size of a conversion specification of a format string
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log host decoder internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Get a 32-bit value in little endian
+//=============================================================================
+static uint32_t __UART_BinLogHost_Get32(const uint8_t* pData)
+{
+  return ((uint32_t)pData[0] << 0) | ((uint32_t)pData[1] << 8) | ((uint32_t)pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+
+//=============================================================================
+// [STATIC] Print at the end of the text, truncated at the end of the buffer
+//=============================================================================
+static void __UART_BinLogHost_Print(char* pText, size_t textSize, size_t* pPos, const char* pFormat, ...)
+{
+  if (*pPos >= (textSize - 1u)) return;                                          // The text is already full
+  va_list Args;
+  va_start(Args, pFormat);
+  const int Count = vsnprintf(&pText[*pPos], textSize - *pPos, pFormat, Args);
+  va_end(Args);
+  if (Count < 0) return;
+  *pPos += (size_t)Count;
+  if (*pPos > (textSize - 1u)) *pPos = textSize - 1u;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log host decoder functions
+//********************************************************************************************************************
+//=============================================================================
+// Binary log host decoder initialization
+//=============================================================================
+eERRORRESULT UART_BinLogHost_Init(UART_BinLogHost* pHost)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pHost == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pHost->pFormats == NULL) && (pHost->FormatCount > 0)) return ERR__CONFIGURATION;
+  pHost->SequenceValid = false;
+  pHost->NextSequence  = 0;
+  pHost->RecordCount   = 0;
+  pHost->LostCount     = 0;
+  pHost->BadCount      = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Decode a frame of the binary log in a record
+//=============================================================================
+eERRORRESULT UART_BinLogHost_Decode(UART_BinLogHost* pHost, const uint8_t* pData, size_t size, UART_BinLogRecord* pRecord)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pHost == NULL) || (pRecord == NULL) || ((pData == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  if (size < UART_BINLOG_HEADER_SIZE) { pHost->BadCount++; return ERR__PARSE_ERROR; }
+  pRecord->Id           = (uint16_t)(pData[0] | ((uint16_t)pData[1] << 8));
+  pRecord->ArgCount     = (size_t)(pData[2] & UART_BINLOG_ARGS_COUNT_Mask);
+  pRecord->HasTimestamp = ((pData[2] & UART_BINLOG_TIMESTAMP_FLAG) > 0);
+  pRecord->Sequence     = pData[3];
+  size_t Pos = UART_BINLOG_HEADER_SIZE;
+  if (size != (Pos + (pRecord->HasTimestamp ? 4u : 0u) + (4u * pRecord->ArgCount))) { pHost->BadCount++; return ERR__PARSE_ERROR; } // Corrupted on the line
+  pRecord->Timestamp = 0;
+  if (pRecord->HasTimestamp) { pRecord->Timestamp = __UART_BinLogHost_Get32(&pData[Pos]); Pos += 4u; }
+  for (size_t zArg = 0; zArg < pRecord->ArgCount; ++zArg, Pos += 4u) pRecord->Args[zArg] = __UART_BinLogHost_Get32(&pData[Pos]);
+
+  //--- Records lost since the previous one ---
+  pRecord->Lost = (pHost->SequenceValid ? (uint8_t)(pRecord->Sequence - pHost->NextSequence) : 0u);
+  pHost->LostCount    += pRecord->Lost;
+  pHost->NextSequence  = (uint8_t)(pRecord->Sequence + 1u);
+  pHost->SequenceValid = true;
+  pHost->RecordCount++;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Rebuild the text of a record
+//=============================================================================
+eERRORRESULT UART_BinLogHost_Format(UART_BinLogHost* pHost, const UART_BinLogRecord* pRecord, char* pText, size_t textSize)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pHost == NULL) || (pRecord == NULL) || (pText == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (textSize == 0) return ERR__PARAMETER_ERROR;
+  size_t Pos = 0;
+  pText[0] = '\0';
+  if ((pRecord->Id >= pHost->FormatCount) || (pHost->pFormats[pRecord->Id] == NULL))
+  {
+    __UART_BinLogHost_Print(pText, textSize, &Pos, "<unknown message %u>", (unsigned)pRecord->Id);
+    return ERR__UNKNOWN_ELEMENT;
+  }
+  const char* pFormat = pHost->pFormats[pRecord->Id];
+  eERRORRESULT Error = ERR_NONE;
+  size_t zArg = 0;
+  while (*pFormat != '\0')
+  {
+    //--- Text up to the next conversion ---
+    const size_t Run = strcspn(pFormat, "%");
+    if (Run > 0)
+    {
+      __UART_BinLogHost_Print(pText, textSize, &Pos, "%.*s", (int)Run, pFormat);
+      pFormat += Run;
+      continue;
+    }
+    if (pFormat[1] == '%') { __UART_BinLogHost_Print(pText, textSize, &Pos, "%%"); pFormat += 2; continue; }
+
+    //--- Conversion: flags, width and precision are kept, length modifiers are removed ---
+    const char* pStart = pFormat++;
+    pFormat += strspn(pFormat, "-+ #0");
+    pFormat += strspn(pFormat, "0123456789");
+    if (*pFormat == '.') { pFormat++; pFormat += strspn(pFormat, "0123456789"); }
+    const size_t SpecSize = (size_t)(pFormat - pStart);
+    pFormat += strspn(pFormat, "hlLqjzt");
+    const char Conversion = *pFormat;
+    if (Conversion == '\0') { Error = ERR__PARSE_ERROR; break; }
+    pFormat++;
+    if (zArg >= pRecord->ArgCount) { __UART_BinLogHost_Print(pText, textSize, &Pos, "<?>"); Error = ERR__PARSE_ERROR; continue; }
+    const uint32_t Arg = pRecord->Args[zArg++];
+    char Spec[UART_BINLOGHOST_SPEC_MAX];
+    if (SpecSize > (sizeof(Spec) - 2u)) { __UART_BinLogHost_Print(pText, textSize, &Pos, "<?>"); Error = ERR__PARSE_ERROR; continue; }
+    memcpy(&Spec[0], pStart, SpecSize);
+    Spec[SpecSize]      = Conversion;
+    Spec[SpecSize + 1u] = '\0';
+    switch (Conversion)
+    {
+      case 'd': case 'i':
+        __UART_BinLogHost_Print(pText, textSize, &Pos, Spec, (int)(int32_t)Arg); break;
+      case 'u': case 'o': case 'x': case 'X':
+        __UART_BinLogHost_Print(pText, textSize, &Pos, Spec, (unsigned)Arg); break;
+      case 'c':
+        __UART_BinLogHost_Print(pText, textSize, &Pos, Spec, (int)(Arg & 0xFFu)); break;
+      case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+      {
+        float Value;
+        memcpy(&Value, &Arg, sizeof(Value));
+        __UART_BinLogHost_Print(pText, textSize, &Pos, Spec, (double)Value);
+      } break;
+      default:                                                                   // %s, %p, %n, '*': the argument is not the value
+        __UART_BinLogHost_Print(pText, textSize, &Pos, "<?>");
+        Error = ERR__PARSE_ERROR;
+        break;
+    }
+  }
+  if (zArg < pRecord->ArgCount) Error = ERR__PARSE_ERROR;                        // More arguments than conversions
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+#endif // #if !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+/*!*****************************************************************************
+ * @file    UART_BinLogHost.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Host decoder of the UART binary log
+ * @details The host gets the COBS frames of the device binary log with a
+ * UART_Framer (see UART_Framer.h), decodes each frame in a record and
+ * rebuilds the text with the format string of the record ID. The format
+ * strings are the host dictionary built from the X-macro table of the
+ * messages shared with the device (see UART_BinLog.h).
+ * The arguments are 32-bit words: %d and %i are signed, %u %o %x %X are
+ * unsigned, %c is the low byte and %f %e %g %a are float. The flags, width
+ * and precision are kept, the length modifiers are ignored. %s, %p, %n and
+ * the '*' width or precision cannot be rebuilt and are replaced by "<?>".
+ * Only available on host (not ARDUINO, HAL or LL)
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __UART_BINLOGHOST_H_INC
+#define __UART_BINLOGHOST_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "UART_BinLog.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log host decoder
+//********************************************************************************************************************
+
+//! @brief Record of the binary log decoded
+typedef struct UART_BinLogRecord
+{
+  uint16_t Id;                                //!< ID of the message, index of its format string
+  uint8_t Sequence;                           //!< Sequence of the record
+  uint8_t Lost;                               //!< Count of records lost before this one (dropped by the device or corrupted on the line), modulo 256
+  bool HasTimestamp;                          //!< 'true' if the record has a timestamp
+  uint32_t Timestamp;                         //!< Timestamp of the record, if HasTimestamp
+  size_t ArgCount;                            //!< Count of arguments
+  uint32_t Args[UART_BINLOG_ARGS_COUNT_Mask]; //!< Arguments of the record. Room for the max of the record format, whatever the UART_BINLOG_MAX_ARGS of the device
+} UART_BinLogRecord;
+
+
+//! @brief Host decoder of the binary log
+typedef struct UART_BinLogHost
+{
+  const char* const* pFormats; //!< Format strings of the messages, indexed by message ID (host dictionary)
+  size_t FormatCount;          //!< Count of format strings
+  //--- Decoder state ---
+  bool SequenceValid;          //!< 'true' after the first record
+  uint8_t NextSequence;        //!< Sequence expected for the next record
+  //--- Statistics ---
+  uint32_t RecordCount;        //!< Count of records decoded
+  uint32_t LostCount;          //!< Count of records lost, seen by the gaps of the sequence
+  uint32_t BadCount;           //!< Count of frames that are not a record
+} UART_BinLogHost;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART binary log host decoder functions
+//********************************************************************************************************************
+
+/*! @brief Binary log host decoder initialization
+ *
+ * @param[in] *pHost Is the host decoder to initialize. Its dictionary shall already be set
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_BinLogHost_Init(UART_BinLogHost* pHost);
+
+/*! @brief Decode a frame of the binary log in a record
+ *
+ * @param[in] *pHost Is the host decoder
+ * @param[in] *pData Is the frame decoded by the UART_Framer (COBS)
+ * @param[in] size Is the size of the frame
+ * @param[out] *pRecord Is where the record will be stored
+ * @return Returns an #eERRORRESULT value enum. #ERR__PARSE_ERROR if the frame is not a record
+ */
+eERRORRESULT UART_BinLogHost_Decode(UART_BinLogHost* pHost, const uint8_t* pData, size_t size, UART_BinLogRecord* pRecord);
+
+/*! @brief Rebuild the text of a record
+ *
+ * The text is always terminated, and truncated if longer than the buffer
+ * @param[in] *pHost Is the host decoder
+ * @param[in] *pRecord Is the record to format
+ * @param[out] *pText Is where the text will be stored
+ * @param[in] textSize Is the size of the text buffer
+ * @return Returns an #eERRORRESULT value enum. #ERR__UNKNOWN_ELEMENT if the ID is not in the dictionary, #ERR__PARSE_ERROR if the arguments do not match the format string (the text is still given)
+ */
+eERRORRESULT UART_BinLogHost_Format(UART_BinLogHost* pHost, const UART_BinLogRecord* pRecord, char* pText, size_t textSize);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __UART_BINLOGHOST_H_INC */
@@ -0,0 +1,484 @@
+/*!*****************************************************************************
+ * @file    UART_Framer.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   COBS and SLIP streaming framer over a UART interface
+ * @details The delimiter and special byte scans use SSE2 or NEON compares when
+ *          the compiler targets them, else a scalar loop
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "UART_Framer.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  include <emmintrin.h>
+#  define FRAMER_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#  include <arm_neon.h>
+#  define FRAMER_USE_NEON
+#endif
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#endif
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART framer internal functions
+//********************************************************************************************************************
+#if defined(FRAMER_USE_SSE2) || defined(FRAMER_USE_NEON)
+//=============================================================================
+// [STATIC] Count the trailing zero bits of a non-zero mask
+//=============================================================================
+static size_t __UART_Framer_Ctz(uint64_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long Index;
+  _BitScanForward64(&Index, mask);
+  return (size_t)Index;
+#else
+  return (size_t)__builtin_ctzll(mask);
+#endif
+}
+#endif
+
+
+//=============================================================================
+// [STATIC] Find the first byte equal to byte1 or byte2. Returns size if not found
+//=============================================================================
+static size_t __UART_Framer_Find(const uint8_t* pData, size_t size, uint8_t byte1, uint8_t byte2)
+{
+  size_t Pos = 0;
+#if defined(FRAMER_USE_SSE2)
+  const __m128i Byte1 = _mm_set1_epi8((char)byte1);
+  const __m128i Byte2 = _mm_set1_epi8((char)byte2);
+  for (; (size - Pos) >= 16; Pos += 16)
+  {
+    const __m128i Data = _mm_loadu_si128((const __m128i*)&pData[Pos]);
+    const int Mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(Data, Byte1), _mm_cmpeq_epi8(Data, Byte2)));
+    if (Mask != 0) return Pos + __UART_Framer_Ctz((uint64_t)(uint32_t)Mask);
+  }
+#elif defined(FRAMER_USE_NEON)
+  const uint8x16_t Byte1 = vdupq_n_u8(byte1);
+  const uint8x16_t Byte2 = vdupq_n_u8(byte2);
+  for (; (size - Pos) >= 16; Pos += 16)
+  {
+    const uint8x16_t Data  = vld1q_u8(&pData[Pos]);
+    const uint8x16_t Match = vorrq_u8(vceqq_u8(Data, Byte1), vceqq_u8(Data, Byte2));
+    const uint64_t Mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(Match), 4)), 0); // 4 bits per byte
+    if (Mask != 0) return Pos + (__UART_Framer_Ctz(Mask) >> 2);
+  }
+#endif
+  for (; Pos < size; ++Pos)
+    if ((pData[Pos] == byte1) || (pData[Pos] == byte2)) return Pos;
+  return size;
+}
+
+
+//=============================================================================
+// [STATIC] Decode a COBS frame in place. Returns the decoded size, or size + 1 if the encoding is bad
+//=============================================================================
+static size_t __UART_Framer_DecodeCOBS(uint8_t* pData, size_t size)
+{
+  size_t Read = 0, Write = 0;
+  while (Read < size)
+  {
+    const uint8_t Code = pData[Read++];                                          // Never 0, the frame was cut on the zeros
+    const size_t Count = (size_t)Code - 1u;
+    if (Count > (size - Read)) return size + 1u;                                 // The block goes after the end of the frame
+    memmove(&pData[Write], &pData[Read], Count);
+    Write += Count;
+    Read  += Count;
+    if ((Code < 0xFFu) && (Read < size)) pData[Write++] = 0x00;                 // The zero replaced by the next code byte
+  }
+  return Write;
+}
+
+
+//=============================================================================
+// [STATIC] Decode a SLIP frame in place. Returns the decoded size, or size + 1 if the encoding is bad
+//=============================================================================
+static size_t __UART_Framer_DecodeSLIP(uint8_t* pData, size_t size)
+{
+  size_t Read = 0, Write = 0;
+  while (Read < size)
+  {
+    const size_t Run = __UART_Framer_Find(&pData[Read], size - Read, UART_FRAMER_SLIP_ESC, UART_FRAMER_SLIP_ESC);
+    if (Write != Read) memmove(&pData[Write], &pData[Read], Run);
+    Write += Run;
+    Read  += Run;
+    if (Read >= size) break;
+    if ((Read + 1u) >= size) return size + 1u;                                  // ESC at the end of the frame
+    switch (pData[Read + 1u])
+    {
+      case UART_FRAMER_SLIP_ESC_END: pData[Write++] = UART_FRAMER_SLIP_END; break;
+      case UART_FRAMER_SLIP_ESC_ESC: pData[Write++] = UART_FRAMER_SLIP_ESC; break;
+      default: return size + 1u;
+    }
+    Read += 2u;
+  }
+  return Write;
+}
+
+
+//=============================================================================
+// [STATIC] Make room in the transmit buffer: flush to the UART and move the bytes not sent to the start
+//=============================================================================
+static eERRORRESULT __UART_Framer_TxRoom(UART_Framer* pFramer, size_t needed)
+{
+  if ((pFramer->TxBufferSize - pFramer->TxEnd) >= needed) return ERR_NONE;
+  const eERRORRESULT Error = UART_Framer_Flush(pFramer, NULL);
+  if (Error != ERR_NONE) return Error;
+  if (pFramer->TxSent > 0)
+  {
+    memmove(&pFramer->pTxBuffer[0], &pFramer->pTxBuffer[pFramer->TxSent], pFramer->TxEnd - pFramer->TxSent);
+    pFramer->TxEnd -= pFramer->TxSent;
+    if (pFramer->TxFrameOpen) pFramer->TxCode -= pFramer->TxSent;               // The code byte is never sent before its block is complete
+    pFramer->TxFrameStart -= (pFramer->TxFrameStart > pFramer->TxSent ? pFramer->TxSent : pFramer->TxFrameStart);
+    pFramer->TxSent = 0;
+  }
+  return ((pFramer->TxBufferSize - pFramer->TxEnd) >= needed ? ERR_NONE : ERR__BUFFER_FULL);
+}
+
+
+//=============================================================================
+// [STATIC] Encode data of a COBS frame
+//=============================================================================
+static eERRORRESULT __UART_Framer_AppendCOBS(UART_Framer* pFramer, const uint8_t* pData, size_t size, size_t* pAccepted)
+{
+  uint8_t* pTx = pFramer->pTxBuffer;
+  eERRORRESULT Error = ERR_NONE;
+  size_t Accepted = 0;
+  while (Accepted < size)
+  {
+    Error = __UART_Framer_TxRoom(pFramer, 2u);                                   // A data byte and the code byte of the next block
+    if (Error != ERR_NONE) break;
+    size_t BlockCount = pFramer->TxEnd - pFramer->TxCode - 1u;
+    size_t Max = size - Accepted;
+    if (Max > (UART_FRAMER_COBS_MAX_BLOCK - BlockCount)) Max = UART_FRAMER_COBS_MAX_BLOCK - BlockCount;
+    if (Max > (pFramer->TxBufferSize - pFramer->TxEnd - 1u)) Max = pFramer->TxBufferSize - pFramer->TxEnd - 1u;
+    const size_t Run = __UART_Framer_Find(&pData[Accepted], Max, UART_FRAMER_COBS_DELIMITER, UART_FRAMER_COBS_DELIMITER);
+    memcpy(&pTx[pFramer->TxEnd], &pData[Accepted], Run);
+    pFramer->TxEnd += Run;
+    Accepted       += Run;
+    BlockCount     += Run;
+    if (Run < Max)                                                               // A zero ends the block, its code byte replaces it
+    {
+      pTx[pFramer->TxCode] = (uint8_t)(BlockCount + 1u);
+      pFramer->TxCode = pFramer->TxEnd++;
+      Accepted++;
+    }
+    else if (BlockCount >= UART_FRAMER_COBS_MAX_BLOCK)                           // Full block without zero
+    {
+      pTx[pFramer->TxCode] = 0xFFu;
+      pFramer->TxCode = pFramer->TxEnd++;
+    }
+  }
+  *pAccepted = Accepted;
+  return (Error == ERR__BUFFER_FULL ? ERR_NONE : Error);                         // The UART does not accept more bytes for now
+}
+
+
+//=============================================================================
+// [STATIC] Encode data of a SLIP frame
+//=============================================================================
+static eERRORRESULT __UART_Framer_AppendSLIP(UART_Framer* pFramer, const uint8_t* pData, size_t size, size_t* pAccepted)
+{
+  uint8_t* pTx = pFramer->pTxBuffer;
+  eERRORRESULT Error = ERR_NONE;
+  size_t Accepted = 0;
+  while (Accepted < size)
+  {
+    Error = __UART_Framer_TxRoom(pFramer, 2u);                                   // An escaped byte
+    if (Error != ERR_NONE) break;
+    size_t Max = size - Accepted;
+    if (Max > (pFramer->TxBufferSize - pFramer->TxEnd - 1u)) Max = pFramer->TxBufferSize - pFramer->TxEnd - 1u;
+    const size_t Run = __UART_Framer_Find(&pData[Accepted], Max, UART_FRAMER_SLIP_END, UART_FRAMER_SLIP_ESC);
+    memcpy(&pTx[pFramer->TxEnd], &pData[Accepted], Run);
+    pFramer->TxEnd += Run;
+    Accepted       += Run;
+    if (Run < Max)                                                               // There are still 2 bytes free
+    {
+      pTx[pFramer->TxEnd++] = UART_FRAMER_SLIP_ESC;
+      pTx[pFramer->TxEnd++] = (pData[Accepted] == UART_FRAMER_SLIP_END ? UART_FRAMER_SLIP_ESC_END : UART_FRAMER_SLIP_ESC_ESC);
+      Accepted++;
+    }
+  }
+  *pAccepted = Accepted;
+  return (Error == ERR__BUFFER_FULL ? ERR_NONE : Error);                         // The UART does not accept more bytes for now
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART framer functions
+//********************************************************************************************************************
+//=============================================================================
+// UART framer initialization
+//=============================================================================
+eERRORRESULT UART_Framer_Init(UART_Framer* pFramer)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFramer == NULL) || (pFramer->pUART == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pFramer->pRxBuffer == NULL) || (pFramer->pTxBuffer == NULL)) return ERR__NULL_BUFFER;
+  if ((pFramer->Type != UART_FRAMER_COBS) && (pFramer->Type != UART_FRAMER_SLIP)) return ERR__CONFIGURATION;
+  if ((pFramer->RxBufferSize == 0) || (pFramer->TxBufferSize < UART_FRAMER_TX_BUFFER_MIN)) return ERR__CONFIGURATION;
+  pFramer->RxStart         = 0;
+  pFramer->RxScan          = 0;
+  pFramer->RxEnd           = 0;
+  pFramer->RxDiscard       = false;
+  pFramer->TxSent          = 0;
+  pFramer->TxEnd           = 0;
+  pFramer->TxCode          = 0;
+  pFramer->TxFrameOpen     = false;
+  pFramer->TxFrameStart    = 0;
+  pFramer->TxFrameSent     = false;
+  pFramer->RxFrameCount    = 0;
+  pFramer->RxErrorCount    = 0;
+  pFramer->RxOverflowCount = 0;
+  pFramer->TxFrameCount    = 0;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Receive a frame
+//=============================================================================
+eERRORRESULT UART_Framer_Receive(UART_Framer* pFramer, UART_FramerFrame* pFrame)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFramer == NULL) || (pFramer->pUART == NULL) || (pFrame == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  const uint8_t Delimiter = (pFramer->Type == UART_FRAMER_COBS ? UART_FRAMER_COBS_DELIMITER : UART_FRAMER_SLIP_END);
+  uint8_t* pRx = pFramer->pRxBuffer;
+  pFrame->pData = NULL;
+  pFrame->Size  = 0;
+  bool Received = false;
+  while (true)
+  {
+    //--- Look for a delimiter in the bytes received ---
+    while (pFramer->RxScan < pFramer->RxEnd)
+    {
+      const size_t Pos = pFramer->RxScan + __UART_Framer_Find(&pRx[pFramer->RxScan], pFramer->RxEnd - pFramer->RxScan, Delimiter, Delimiter);
+      if (Pos >= pFramer->RxEnd) { pFramer->RxScan = pFramer->RxEnd; break; }
+      const size_t Start = pFramer->RxStart;
+      pFramer->RxStart = Pos + 1u;                                               // The frame stays in the buffer until the next call
+      pFramer->RxScan  = Pos + 1u;
+      if (pFramer->RxDiscard) { pFramer->RxDiscard = false; continue; }          // End of a too long frame
+      if (Pos == Start) continue;                                                // Empty frame
+      const size_t Size = (pFramer->Type == UART_FRAMER_COBS ? __UART_Framer_DecodeCOBS(&pRx[Start], Pos - Start) : __UART_Framer_DecodeSLIP(&pRx[Start], Pos - Start));
+      if (Size > (Pos - Start))
+      {
+        pFramer->RxErrorCount++;
+        return ERR__PARSE_ERROR;
+      }
+      pFramer->RxFrameCount++;
+      pFrame->pData = &pRx[Start];
+      pFrame->Size  = Size;
+      return ERR_NONE;
+    }
+    if (Received) return ERR__NO_DATA_AVAILABLE;
+
+    //--- Make room for the next bytes, the frames already given are released ---
+    if (pFramer->RxStart > 0)
+    {
+      memmove(&pRx[0], &pRx[pFramer->RxStart], pFramer->RxEnd - pFramer->RxStart); // Only the start of the next frame is moved
+      pFramer->RxEnd  -= pFramer->RxStart;
+      pFramer->RxScan -= pFramer->RxStart;
+      pFramer->RxStart = 0;
+    }
+    if (pFramer->RxEnd >= pFramer->RxBufferSize)                                 // Frame too long, discard it up to its delimiter
+    {
+      pFramer->RxOverflowCount++;
+      pFramer->RxDiscard = true;
+      pFramer->RxScan    = 0;
+      pFramer->RxEnd     = 0;
+    }
+
+    //--- Receive ---
+    if (pFramer->pUART->fnUART_Receive == NULL) return ERR__PARAMETER_ERROR;
+    size_t Count = 0;
+    uint8_t LastCharError = UART_NO_ERROR;
+    const eERRORRESULT Error = pFramer->pUART->fnUART_Receive(pFramer->pUART, &pRx[pFramer->RxEnd], pFramer->RxBufferSize - pFramer->RxEnd, &Count, &LastCharError);
+    if (Error != ERR_NONE) return Error;
+    if (Count > (pFramer->RxBufferSize - pFramer->RxEnd)) Count = pFramer->RxBufferSize - pFramer->RxEnd;
+    pFramer->RxEnd += Count;
+    if (Count == 0) return ERR__NO_DATA_AVAILABLE;
+    Received = true;
+  }
+}
+
+
+//=============================================================================
+// Begin a frame to send
+//=============================================================================
+eERRORRESULT UART_Framer_BeginFrame(UART_Framer* pFramer)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pFramer == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pFramer->TxFrameOpen) return ERR__BUSY;
+  const eERRORRESULT Error = __UART_Framer_TxRoom(pFramer, 1u);
+  if (Error != ERR_NONE) return Error;
+  pFramer->TxFrameStart = pFramer->TxEnd;
+  pFramer->TxFrameSent  = false;
+  if (pFramer->Type == UART_FRAMER_COBS) pFramer->TxCode = pFramer->TxEnd++;    // Code byte of the first block, written at the end of the block
+  else pFramer->pTxBuffer[pFramer->TxEnd++] = UART_FRAMER_SLIP_END;             // Flush the line noise received before the frame
+  pFramer->TxFrameOpen = true;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Encode data of the frame in progress
+//=============================================================================
+eERRORRESULT UART_Framer_AppendFrame(UART_Framer* pFramer, const uint8_t* pData, size_t size, size_t* pAccepted)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFramer == NULL) || (pAccepted == NULL) || ((pData == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  *pAccepted = 0;
+  if (pFramer->TxFrameOpen == false) return ERR__NOT_READY;
+  if (pFramer->Type == UART_FRAMER_COBS) return __UART_Framer_AppendCOBS(pFramer, pData, size, pAccepted);
+  return __UART_Framer_AppendSLIP(pFramer, pData, size, pAccepted);
+}
+
+
+//=============================================================================
+// End the frame in progress
+//=============================================================================
+eERRORRESULT UART_Framer_EndFrame(UART_Framer* pFramer)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pFramer == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pFramer->TxFrameOpen == false) return ERR__NOT_READY;
+  const eERRORRESULT Error = __UART_Framer_TxRoom(pFramer, 1u);
+  if (Error != ERR_NONE) return Error;
+  if (pFramer->Type == UART_FRAMER_COBS)
+  {
+    pFramer->pTxBuffer[pFramer->TxCode] = (uint8_t)(pFramer->TxEnd - pFramer->TxCode);
+    pFramer->pTxBuffer[pFramer->TxEnd++] = UART_FRAMER_COBS_DELIMITER;
+  }
+  else pFramer->pTxBuffer[pFramer->TxEnd++] = UART_FRAMER_SLIP_END;
+  pFramer->TxFrameOpen = false;
+  pFramer->TxFrameCount++;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Abort the frame in progress
+//=============================================================================
+eERRORRESULT UART_Framer_AbortFrame(UART_Framer* pFramer)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pFramer == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pFramer->TxFrameOpen == false) return ERR__NOT_READY;
+  if (pFramer->TxFrameSent == false)                                             // Nothing sent, the frame is only in the transmit buffer
+  {
+    pFramer->TxEnd       = pFramer->TxFrameStart;
+    pFramer->TxFrameOpen = false;
+    return ERR_NONE;
+  }
+  const eERRORRESULT Error = __UART_Framer_TxRoom(pFramer, 2u);
+  if (Error != ERR_NONE) return Error;
+  if (pFramer->Type == UART_FRAMER_COBS)
+  {
+    pFramer->pTxBuffer[pFramer->TxCode]  = 0xFFu;                                // The block in progress is shorter than 254 bytes: bad encoding
+    pFramer->pTxBuffer[pFramer->TxEnd++] = UART_FRAMER_COBS_DELIMITER;
+  }
+  else
+  {
+    pFramer->pTxBuffer[pFramer->TxEnd++] = UART_FRAMER_SLIP_ESC;                 // ESC at the end of the frame: bad encoding
+    pFramer->pTxBuffer[pFramer->TxEnd++] = UART_FRAMER_SLIP_END;
+  }
+  pFramer->TxFrameOpen = false;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Send the encoded bytes of the transmit buffer to the UART
+//=============================================================================
+eERRORRESULT UART_Framer_Flush(UART_Framer* pFramer, size_t* pPending)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFramer == NULL) || (pFramer->pUART == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  const size_t Limit = ((pFramer->Type == UART_FRAMER_COBS) && pFramer->TxFrameOpen ? pFramer->TxCode : pFramer->TxEnd); // The COBS block in progress waits for its code byte
+  eERRORRESULT Error = ERR_NONE;
+  if (Limit > pFramer->TxSent)
+  {
+    if (pFramer->pUART->fnUART_Transmit == NULL) return ERR__PARAMETER_ERROR;
+    size_t Sent = 0;
+    Error = pFramer->pUART->fnUART_Transmit(pFramer->pUART, &pFramer->pTxBuffer[pFramer->TxSent], Limit - pFramer->TxSent, &Sent);
+    pFramer->TxSent += (Sent < (Limit - pFramer->TxSent) ? Sent : (Limit - pFramer->TxSent));
+    if (pFramer->TxFrameOpen && (pFramer->TxSent > pFramer->TxFrameStart)) pFramer->TxFrameSent = true;
+  }
+  if (pFramer->TxSent == pFramer->TxEnd)                                         // All sent, restart at the beginning of the buffer
+  {
+    pFramer->TxSent       = 0;
+    pFramer->TxEnd        = 0;
+    pFramer->TxFrameStart = 0;
+  }
+  if (pPending != NULL) *pPending = pFramer->TxEnd - pFramer->TxSent;
+  return Error;
+}
+
+
+//=============================================================================
+// Send a whole frame
+//=============================================================================
+eERRORRESULT UART_Framer_SendFrame(UART_Framer* pFramer, const uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pFramer == NULL) || ((pData == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  eERRORRESULT Error;
+  do { Error = UART_Framer_BeginFrame(pFramer); } while (Error == ERR__BUFFER_FULL);
+  if (Error != ERR_NONE) return Error;
+  size_t Done = 0;
+  while (Done < size)
+  {
+    size_t Accepted = 0;
+    Error = UART_Framer_AppendFrame(pFramer, &pData[Done], size - Done, &Accepted);
+    if (Error != ERR_NONE) return Error;
+    Done += Accepted;
+  }
+  do { Error = UART_Framer_EndFrame(pFramer); } while (Error == ERR__BUFFER_FULL);
+  if (Error != ERR_NONE) return Error;
+  size_t Pending = 0;
+  do
+  {
+    Error = UART_Framer_Flush(pFramer, &Pending);
+    if (Error != ERR_NONE) return Error;
+  } while (Pending > 0);
+  return ERR_NONE;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,211 @@
+/*!*****************************************************************************
+ * @file    UART_Framer.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   COBS and SLIP streaming framer over a UART interface
+ * @details The framer sits on the fnUART_Receive and fnUART_Transmit functions
+ * of a UART_Interface and cuts the byte stream in frames. The COBS framing
+ * (Consistent Overhead Byte Stuffing) ends each frame with a 0x00 delimiter and
+ * has no 0x00 inside the frame. The SLIP framing (RFC 1055) ends each frame
+ * with a 0xC0 END and escapes the END and ESC bytes inside the frame.
+ * The receive bytes are stored in a linear buffer, the delimiters are found
+ * 16 bytes at a time with SSE2 or NEON compares if available, and each frame
+ * is decoded in place: the frame given to the application is a span of the
+ * receive buffer, valid until the next receive.
+ * The transmit is incremental: a frame is encoded piece by piece in a small
+ * transmit buffer flushed to the UART, the whole frame is never needed at once.
+ * A COBS code byte is written when its block is complete, so the transmit
+ * buffer shall hold at least one COBS block (255 bytes) and the delimiter
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __UART_FRAMER_H_INC
+#define __UART_FRAMER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "UART_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#define UART_FRAMER_COBS_DELIMITER  ( 0x00u ) //!< COBS frame delimiter
+#define UART_FRAMER_COBS_MAX_BLOCK  ( 254u )  //!< Max count of data bytes of a COBS block (code 0xFF)
+#define UART_FRAMER_SLIP_END        ( 0xC0u ) //!< SLIP frame delimiter
+#define UART_FRAMER_SLIP_ESC        ( 0xDBu ) //!< SLIP escape
+#define UART_FRAMER_SLIP_ESC_END    ( 0xDCu ) //!< SLIP escaped END
+#define UART_FRAMER_SLIP_ESC_ESC    ( 0xDDu ) //!< SLIP escaped ESC
+
+#define UART_FRAMER_TX_BUFFER_MIN   ( UART_FRAMER_COBS_MAX_BLOCK + 3u ) //!< Min size of the transmit buffer: a COBS block with its code byte and the delimiter
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART framer
+//********************************************************************************************************************
+
+//! Framing of the UART framer
+typedef enum
+{
+  UART_FRAMER_COBS = 0, //!< Consistent Overhead Byte Stuffing, frames end with 0x00
+  UART_FRAMER_SLIP = 1, //!< Serial Line Internet Protocol (RFC 1055), frames end with 0xC0
+} eUART_FramerType;
+
+
+//! @brief Frame received, span of the receive buffer of the framer
+typedef struct UART_FramerFrame
+{
+  uint8_t* pData; //!< Decoded data of the frame. Valid until the next UART_Framer_Receive()
+  size_t Size;    //!< Count of bytes of the frame
+} UART_FramerFrame;
+
+
+//! @brief UART framer
+typedef struct UART_Framer
+{
+  UART_Interface* pUART;    //!< UART interface of the stream
+  eUART_FramerType Type;    //!< Framing of the stream
+  uint8_t* pRxBuffer;       //!< Receive buffer. A frame longer than this buffer (encoded) is discarded
+  size_t RxBufferSize;      //!< Size of the receive buffer
+  uint8_t* pTxBuffer;       //!< Transmit buffer of the encoded bytes not sent yet
+  size_t TxBufferSize;      //!< Size of the transmit buffer. Min #UART_FRAMER_TX_BUFFER_MIN
+  //--- Receive state ---
+  size_t RxStart;           //!< Start of the next frame in the receive buffer
+  size_t RxScan;            //!< End of the bytes already scanned for a delimiter
+  size_t RxEnd;             //!< End of the bytes received
+  bool RxDiscard;           //!< 'true' while the end of a too long frame is discarded
+  //--- Transmit state ---
+  size_t TxSent;            //!< Start of the bytes not sent in the transmit buffer
+  size_t TxEnd;             //!< End of the encoded bytes in the transmit buffer
+  size_t TxCode;            //!< Position of the code byte of the COBS block in progress
+  bool TxFrameOpen;         //!< 'true' between UART_Framer_BeginFrame() and UART_Framer_EndFrame()
+  size_t TxFrameStart;      //!< Position of the frame in progress in the transmit buffer
+  bool TxFrameSent;         //!< 'true' if bytes of the frame in progress have already been sent
+  //--- Statistics ---
+  uint32_t RxFrameCount;    //!< Count of frames received
+  uint32_t RxErrorCount;    //!< Count of frames with a bad encoding
+  uint32_t RxOverflowCount; //!< Count of frames discarded because longer than the receive buffer
+  uint32_t TxFrameCount;    //!< Count of frames sent
+} UART_Framer;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART framer functions
+//********************************************************************************************************************
+
+/*! @brief UART framer initialization
+ *
+ * @param[in] *pFramer Is the framer to initialize. Its configuration shall already be set
+ * @return Returns an #eERRORRESULT value enum. #ERR__CONFIGURATION if the transmit buffer is smaller than #UART_FRAMER_TX_BUFFER_MIN
+ */
+eERRORRESULT UART_Framer_Init(UART_Framer* pFramer);
+
+/*! @brief Receive a frame
+ *
+ * Release the frame of the last call, then look for a complete frame in the bytes already received. If none, receive from the UART (once) and look again.
+ * Empty frames (consecutive delimiters) are skipped
+ * @param[in] *pFramer Is the framer
+ * @param[out] *pFrame Is where the span of the frame will be stored. Valid until the next call
+ * @return Returns an #eERRORRESULT value enum. #ERR__NO_DATA_AVAILABLE if no complete frame is available, #ERR__PARSE_ERROR if a frame with a bad encoding is dropped (call again to get the next frame)
+ */
+eERRORRESULT UART_Framer_Receive(UART_Framer* pFramer, UART_FramerFrame* pFrame);
+
+/*! @brief Begin a frame to send
+ *
+ * @param[in] *pFramer Is the framer
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUSY if a frame is already in progress, #ERR__BUFFER_FULL if the transmit buffer is full (flush and call again)
+ */
+eERRORRESULT UART_Framer_BeginFrame(UART_Framer* pFramer);
+
+/*! @brief Encode data of the frame in progress
+ *
+ * The data are encoded in the transmit buffer, the transmit buffer is flushed to the UART when full. The UART never blocks the function: if the UART does not accept the bytes, the count of data accepted is less than the size
+ * @param[in] *pFramer Is the framer
+ * @param[in] *pData Is the data to add to the frame
+ * @param[in] size Is the count of data to add to the frame
+ * @param[out] *pAccepted Is where the count of data encoded will be stored. Call again with the remaining data
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_Framer_AppendFrame(UART_Framer* pFramer, const uint8_t* pData, size_t size, size_t* pAccepted);
+
+/*! @brief End the frame in progress
+ *
+ * @param[in] *pFramer Is the framer
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUFFER_FULL if the transmit buffer is full (flush and call again)
+ */
+eERRORRESULT UART_Framer_EndFrame(UART_Framer* pFramer);
+
+/*! @brief Abort the frame in progress
+ *
+ * If no byte of the frame has been sent yet, the frame is removed from the transmit buffer. Else the frame is ended with a bad encoding, so the receiver drops it
+ * @param[in] *pFramer Is the framer
+ * @return Returns an #eERRORRESULT value enum. #ERR__NOT_READY if no frame is in progress, #ERR__BUFFER_FULL if the transmit buffer is full (flush and call again)
+ */
+eERRORRESULT UART_Framer_AbortFrame(UART_Framer* pFramer);
+
+/*! @brief Send the encoded bytes of the transmit buffer to the UART
+ *
+ * The bytes of the COBS block in progress wait for their code byte
+ * @param[in] *pFramer Is the framer
+ * @param[out] *pPending Is where the count of bytes still waiting in the transmit buffer will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_Framer_Flush(UART_Framer* pFramer, size_t* pPending);
+
+/*! @brief Send a whole frame
+ *
+ * Begin, encode, end and flush a frame. Retry as long as the UART does not accept all the bytes
+ * @param[in] *pFramer Is the framer
+ * @param[in] *pData Is the data of the frame
+ * @param[in] size Is the count of data of the frame
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_Framer_SendFrame(UART_Framer* pFramer, const uint8_t* pData, size_t size);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __UART_FRAMER_H_INC */
@@ -1,8 +1,8 @@
 /*!*****************************************************************************
  * @file    UART_Interface.h
  * @author  Fabien 'Emandhal' MAILLY
- * @version 1.0.0
- * @date    16/01/2022
+ * @version 1.1.0
+ * @date    16/10/2026
  * @brief   UART interface for driver
  *
  * This UART interface definitions for all the https://github.com/Emandhal drivers
@@ -32,6 +32,7 @@
  *****************************************************************************/
 
 /* Revision history:
+ * 1.1.0    Add batched receive with threshold, idle line and timeout
  * 1.0.1    Add UART_Interface's UniqueID
  * 1.0.0    Release version
  *****************************************************************************/
@@ -95,26 +96,47 @@ typedef eERRORRESULT (*UARTtransmit_Func)(UART_Interface *pIntDev, const uint8_t
  */
 typedef eERRORRESULT (*UARTreceive_Func)(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError);
 
+
+/*! @brief Interface function for UART batched receive
+ *
+ * This function will be called to receive a batch of data over the UART. It returns at the first of these conditions:
+ * - threshold data have been received
+ * - at least one data has been received and the line has been idle for idleChars character times
+ * - timeoutUs microseconds have elapsed since the call
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART receive
+ * @param[out] *data Is where the data will be stored
+ * @param[in] size Is the count of data that the data buffer can hold
+ * @param[in] threshold Is the count of data that ends the receive. Set to 0 to use size
+ * @param[in] idleChars Is the idle time of the line that ends the receive, in character times. Set to 0 to not end on idle line
+ * @param[in] timeoutUs Is the max duration of the receive in microseconds
+ * @param[out] *actuallyReceived Is the count of data actually received. 0 if the timeout elapsed without data
+ * @param[out] *lastCharError Is the last char received error. Set to UART_NO_ERROR (0) if no errors
+ * @return Returns an #eERRORRESULT value enum
+ */
+typedef eERRORRESULT (*UARTreceiveBatch_Func)(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t threshold, uint32_t idleChars, uint32_t timeoutUs, size_t*const actuallyReceived, uint8_t*const lastCharError);
+
 //-----------------------------------------------------------------------------
 
 #if defined(USE_HAL_DRIVER) //#ifdef STM32cubeIDE
 //! @brief STM32 HAL UART interface container structure
 struct UART_Interface
 {
-  UART_HandleTypeDef* pHUART;        //!< Pointer to UART handle Structure definition
-  UARTtransmit_Func fnUART_Transmit; //!< This function will be called at driver initialization to configure the interface driver
-  UARTreceive_Func fnUART_Receive;   //!< This function will be called at driver read/write data from/to the interface driver SPI
+  UART_HandleTypeDef* pHUART;                //!< Pointer to UART handle Structure definition
+  UARTtransmit_Func fnUART_Transmit;         //!< This function will be called at driver initialization to configure the interface driver
+  UARTreceive_Func fnUART_Receive;           //!< This function will be called at driver read/write data from/to the interface driver SPI
+  UARTreceiveBatch_Func fnUART_ReceiveBatch; //!< This function will be called when a driver/library needs to receive a batch of data. Can be NULL if not available
 };
 
 #else
 //! @brief UART interface container structure
 struct UART_Interface
 {
-  void* InterfaceDevice;             //!< This is the pointer that will be in the first parameter of all interface call functions
-  uint32_t UniqueID;                 //!< This is a protection for the #InterfaceDevice pointer. This value will be check when using the struct UART_Interface in the driver which use the generic UART interface
-  UARTtransmit_Func fnUART_Transmit; //!< This function will be called when a driver/library needs to transmit data
-  UARTreceive_Func fnUART_Receive;   //!< This function will be called when a driver/library needs to receive data
-  uint8_t Channel;                   //!< UART channel of the interface device
+  void* InterfaceDevice;                     //!< This is the pointer that will be in the first parameter of all interface call functions
+  uint32_t UniqueID;                         //!< This is a protection for the #InterfaceDevice pointer. This value will be check when using the struct UART_Interface in the driver which use the generic UART interface
+  UARTtransmit_Func fnUART_Transmit;         //!< This function will be called when a driver/library needs to transmit data
+  UARTreceive_Func fnUART_Receive;           //!< This function will be called when a driver/library needs to receive data
+  uint8_t Channel;                           //!< UART channel of the interface device
+  UARTreceiveBatch_Func fnUART_ReceiveBatch; //!< This function will be called when a driver/library needs to receive a batch of data. Can be NULL if not available
 };
 #endif //#ifdef USE_HAL_DRIVER
 
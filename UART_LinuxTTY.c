@@ -0,0 +1,392 @@
+/*!*****************************************************************************
+ * @file    UART_LinuxTTY.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.1.0
+ * @date    16/10/2026
+ * @brief   Linux termios backend of the UART interface
+ * @details This backend plugs the Linux tty devices into the generic
+ *          UART_Interface of all the https://github.com/Emandhal drivers and
+ *          developments. Only available on Linux with the generic
+ *          UART_Interface
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.1.0    Add batched receive with threshold, idle line and timeout
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE // For ppoll(), before the first system header
+#endif
+#include "UART_LinuxTTY.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <time.h>
+#include <poll.h>
+#include <sys/epoll.h>
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+//! Baudrates of termios
+static const struct
+{
+  uint32_t Baudrate;
+  speed_t Speed;
+} UART_LINUXTTY_SPEEDS[] =
+{
+  {     1200, B1200     }, {     2400, B2400     }, {    4800, B4800     }, {    9600, B9600     },
+  {    19200, B19200    }, {    38400, B38400    }, {   57600, B57600    }, {  115200, B115200   },
+  {   230400, B230400   }, {   460800, B460800   }, {  500000, B500000   }, {  576000, B576000   },
+  {   921600, B921600   }, {  1000000, B1000000  }, { 1152000, B1152000  }, { 1500000, B1500000  },
+  {  2000000, B2000000  }, {  2500000, B2500000  }, { 3000000, B3000000  }, { 3500000, B3500000  },
+  {  4000000, B4000000  },
+};
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux termios backend internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Get the channel of a UART interface
+//=============================================================================
+static UART_LinuxTTYchannel* __UART_LinuxTTY_GetChannel(UART_Interface *pIntDev)
+{
+  UART_LinuxTTY* pDev = (UART_LinuxTTY*)pIntDev->InterfaceDevice;
+  if ((pDev->pChannels == NULL) || (pIntDev->Channel >= pDev->ChannelCount)) return NULL;
+  UART_LinuxTTYchannel* pChannel = &pDev->pChannels[pIntDev->Channel];
+  return (pChannel->Fd < 0 ? NULL : pChannel);
+}
+
+
+//=============================================================================
+// [STATIC] Configure a tty in non-blocking mode and raw termios
+//=============================================================================
+static eERRORRESULT __UART_LinuxTTY_Configure(UART_LinuxTTYchannel* pChannel)
+{
+  const int Flags = fcntl(pChannel->Fd, F_GETFL);
+  if ((Flags < 0) || (fcntl(pChannel->Fd, F_SETFL, Flags | O_NONBLOCK) < 0)) return ERR__CONFIGURATION;
+  struct termios Termios;
+  if (tcgetattr(pChannel->Fd, &Termios) < 0) return ERR__CONFIGURATION;
+  cfmakeraw(&Termios);                                                           // 8 bits, no parity, no echo, no line processing
+  Termios.c_cflag &= ~(tcflag_t)(CSTOPB | CRTSCTS);
+  Termios.c_cflag |= CLOCAL | CREAD;
+  Termios.c_iflag &= ~(tcflag_t)(IXON | IXOFF | IXANY);
+  Termios.c_cc[VMIN]  = 1;                                                       // With O_NONBLOCK, read() returns what is available or fails with EAGAIN (0 only on hang up)
+  Termios.c_cc[VTIME] = 0;
+  if (pChannel->Baudrate > 0)
+  {
+    size_t zSpeed = 0;
+    while ((zSpeed < (sizeof(UART_LINUXTTY_SPEEDS) / sizeof(UART_LINUXTTY_SPEEDS[0]))) && (UART_LINUXTTY_SPEEDS[zSpeed].Baudrate != pChannel->Baudrate)) zSpeed++;
+    if (zSpeed >= (sizeof(UART_LINUXTTY_SPEEDS) / sizeof(UART_LINUXTTY_SPEEDS[0]))) return ERR__BAUDRATE_ERROR;
+    if ((cfsetispeed(&Termios, UART_LINUXTTY_SPEEDS[zSpeed].Speed) < 0) || (cfsetospeed(&Termios, UART_LINUXTTY_SPEEDS[zSpeed].Speed) < 0)) return ERR__BAUDRATE_ERROR;
+  }
+  if (tcsetattr(pChannel->Fd, TCSANOW, &Termios) < 0) return ERR__CONFIGURATION;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Read as much data as the tty has received, without blocking
+//=============================================================================
+static eERRORRESULT __UART_LinuxTTY_Read(UART_LinuxTTYchannel* pChannel, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError)
+{
+  *actuallyReceived = 0;
+  if (size == 0) return ERR_NONE;
+  pChannel->ReadCount++;
+  const ssize_t Received = read(pChannel->Fd, data, size);
+  if (Received < 0)
+  {
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))      // Nothing received: no progress, wait for an input event
+    {
+      pChannel->Readable = false;
+      pChannel->WouldBlock++;
+      return ERR_NONE;
+    }
+    if (errno != EIO) return ERR__RECEIVE_ERROR;
+    pChannel->HangUp = true;                                                     // A pseudo terminal master gets EIO when the slave is closed
+  }
+  if (Received <= 0)                                                             // Hang up and all the data received
+  {
+    pChannel->Readable = false;
+    *lastCharError = UART_LINUXTTY_HANGUP_ERROR;
+    return ERR_NONE;
+  }
+  if (((size_t)Received < size) && (pChannel->HangUp == false)) pChannel->Readable = false; // All the data available have been received. After a hang up, the next receive gives it: no other event will come
+  pChannel->RxBytes += (uint32_t)Received;
+  *actuallyReceived = (size_t)Received;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Get the monotonic time in nanoseconds
+//=============================================================================
+static uint64_t __UART_LinuxTTY_Now(void)
+{
+  struct timespec Time;
+  clock_gettime(CLOCK_MONOTONIC, &Time);
+  return ((uint64_t)Time.tv_sec * 1000000000u) + (uint64_t)Time.tv_nsec;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux termios backend functions
+//********************************************************************************************************************
+//=============================================================================
+// Linux termios backend initialization
+//=============================================================================
+eERRORRESULT UART_LinuxTTY_Init(UART_LinuxTTY* pDev)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pDev == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pDev->pChannels == NULL) || (pDev->ChannelCount == 0) || (pDev->ChannelCount > 256u)) return ERR__CONFIGURATION; // UART_Interface.Channel is 8 bits
+  pDev->EpollFd = epoll_create1(EPOLL_CLOEXEC);
+  if (pDev->EpollFd < 0) return ERR__OUT_OF_MEMORY;
+  pDev->WaitCount  = 0;
+  pDev->EventCount = 0;
+
+  //--- Open, configure and register each channel ---
+  eERRORRESULT Error = ERR_NONE;
+  size_t zChannel = 0;
+  for (; zChannel < pDev->ChannelCount; ++zChannel)
+  {
+    UART_LinuxTTYchannel* pChannel = &pDev->pChannels[zChannel];
+    pChannel->Readable   = true;                                                 // Data may have been received before the registration
+    pChannel->Writable   = true;
+    pChannel->HangUp     = false;
+    pChannel->TxBytes    = 0;
+    pChannel->RxBytes    = 0;
+    pChannel->WouldBlock = 0;
+    pChannel->ReadCount  = 0;
+    pChannel->SleepCount = 0;
+    pChannel->Opened     = false;
+    if (pChannel->Fd < 0)
+    {
+      if (pChannel->pDevicePath == NULL) { Error = ERR__CONFIGURATION; break; }
+      pChannel->Fd = open(pChannel->pDevicePath, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+      if (pChannel->Fd < 0) { Error = ERR__NO_DEVICE_DETECTED; break; }
+      pChannel->Opened = true;
+    }
+    Error = __UART_LinuxTTY_Configure(pChannel);
+    if (Error != ERR_NONE) break;
+    struct epoll_event Event;
+    memset(&Event, 0, sizeof(Event));
+    Event.events   = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;                  // Edge triggered: one event per change of the channel state
+    Event.data.u64 = zChannel;
+    if (epoll_ctl(pDev->EpollFd, EPOLL_CTL_ADD, pChannel->Fd, &Event) < 0) { Error = ERR__CONFIGURATION; break; }
+  }
+  if (Error != ERR_NONE)
+  {
+    for (size_t zOpened = 0; (zOpened <= zChannel) && (zOpened < pDev->ChannelCount); ++zOpened) // Close the devices opened here, not the file descriptors given
+    {
+      UART_LinuxTTYchannel* pChannel = &pDev->pChannels[zOpened];
+      if (pChannel->Opened == false) continue;
+      close(pChannel->Fd);
+      pChannel->Fd     = -1;
+      pChannel->Opened = false;
+    }
+    close(pDev->EpollFd);
+    pDev->EpollFd = -1;
+  }
+  return Error;
+}
+
+
+//=============================================================================
+// Configure a UART_Interface to use a channel of the Linux termios backend
+//=============================================================================
+eERRORRESULT UART_LinuxTTY_Attach(UART_Interface *pIntDev, UART_LinuxTTY* pDev, uint8_t channel)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pDev == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pDev->pChannels == NULL) || (channel >= pDev->ChannelCount)) return ERR__UNKNOWN_CHANNEL;
+  pIntDev->InterfaceDevice     = pDev;
+  pIntDev->UniqueID            = 0;
+  pIntDev->fnUART_Transmit     = UART_LinuxTTY_Transmit;
+  pIntDev->fnUART_Receive      = UART_LinuxTTY_Receive;
+  pIntDev->Channel             = channel;
+  pIntDev->fnUART_ReceiveBatch = UART_LinuxTTY_ReceiveBatch;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Linux termios transmit
+//=============================================================================
+eERRORRESULT UART_LinuxTTY_Transmit(UART_Interface *pIntDev, const uint8_t* data, size_t size, size_t*const actuallySent)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (actuallySent == NULL) || ((data == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  *actuallySent = 0;
+  UART_LinuxTTYchannel* pChannel = __UART_LinuxTTY_GetChannel(pIntDev);
+  if (pChannel == NULL) return ERR__UNKNOWN_CHANNEL;
+  if (size == 0) return ERR_NONE;
+  const ssize_t Sent = write(pChannel->Fd, data, size);
+  if (Sent < 0)
+  {
+    if ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR))      // Output buffer full: no progress, wait for an output event
+    {
+      pChannel->Writable = false;
+      pChannel->WouldBlock++;
+      return ERR_NONE;
+    }
+    return ERR__TRANSMIT_ERROR;
+  }
+  if ((size_t)Sent < size) pChannel->Writable = false;                          // Output buffer full after this part
+  pChannel->TxBytes += (uint32_t)Sent;
+  *actuallySent = (size_t)Sent;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Linux termios receive
+//=============================================================================
+eERRORRESULT UART_LinuxTTY_Receive(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (actuallyReceived == NULL) || (lastCharError == NULL) || ((data == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  *actuallyReceived = 0;
+  *lastCharError    = UART_NO_ERROR;
+  UART_LinuxTTYchannel* pChannel = __UART_LinuxTTY_GetChannel(pIntDev);
+  if (pChannel == NULL) return ERR__UNKNOWN_CHANNEL;
+  return __UART_LinuxTTY_Read(pChannel, data, size, actuallyReceived, lastCharError);
+}
+
+
+//=============================================================================
+// Linux termios batched receive
+//=============================================================================
+eERRORRESULT UART_LinuxTTY_ReceiveBatch(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t threshold, uint32_t idleChars, uint32_t timeoutUs, size_t*const actuallyReceived, uint8_t*const lastCharError)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (actuallyReceived == NULL) || (lastCharError == NULL) || ((data == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  *actuallyReceived = 0;
+  *lastCharError    = UART_NO_ERROR;
+  UART_LinuxTTYchannel* pChannel = __UART_LinuxTTY_GetChannel(pIntDev);
+  if (pChannel == NULL) return ERR__UNKNOWN_CHANNEL;
+  if (size == 0) return ERR_NONE;
+  if ((threshold == 0) || (threshold > size)) threshold = size;
+  const uint64_t CharTimeNs = (10u * 1000000000ull) / (pChannel->Baudrate > 0 ? pChannel->Baudrate : UART_LINUXTTY_DEFAULT_BAUDRATE); // 8N1: start + 8 bits + stop
+  const uint64_t MinWaitNs  = (uint64_t)UART_LINUXTTY_MIN_WAIT_US * 1000u;
+  uint64_t IdleNs = (uint64_t)idleChars * CharTimeNs;
+  if ((idleChars > 0) && (IdleNs < MinWaitNs)) IdleNs = MinWaitNs;
+  uint64_t Now = __UART_LinuxTTY_Now();
+  const uint64_t Deadline = Now + (uint64_t)timeoutUs * 1000u;
+  uint64_t LastRx = Now;
+  size_t Total = 0;
+  while (true)
+  {
+    //--- Get all the bytes already received ---
+    size_t Received = 0;
+    const eERRORRESULT Error = __UART_LinuxTTY_Read(pChannel, &data[Total], size - Total, &Received, lastCharError);
+    if (Error != ERR_NONE) { *actuallyReceived = Total; return Error; }
+    Total += Received;
+    Now = __UART_LinuxTTY_Now();
+    if (Received > 0) LastRx = Now;
+    if ((Total >= threshold) || (*lastCharError != UART_NO_ERROR) || (Now >= Deadline)) break;
+    if ((Total > 0) && (idleChars > 0) && ((Now - LastRx) >= IdleNs)) break;    // No new byte during the idle time: the line is idle
+
+    //--- Wait for the next bytes ---
+    pChannel->SleepCount++;
+    if (Total == 0)                                                              // Nothing yet: wake up on the first byte
+    {
+      const uint64_t WaitNs = Deadline - Now;
+      struct pollfd PollFd = { .fd = pChannel->Fd, .events = POLLIN, .revents = 0 };
+      const struct timespec Timeout = { .tv_sec = (time_t)(WaitNs / 1000000000u), .tv_nsec = (long)(WaitNs % 1000000000u) };
+      if ((ppoll(&PollFd, 1, &Timeout, NULL) < 0) && (errno != EINTR)) { *actuallyReceived = Total; return ERR__RECEIVE_ERROR; }
+    }
+    else                                                                         // Sleep while the missing bytes arrive, the tty buffers them
+    {
+      uint64_t WaitNs = (uint64_t)(threshold - Total) * CharTimeNs;
+      if ((idleChars > 0) && (WaitNs > IdleNs)) WaitNs = IdleNs;
+      if (WaitNs < MinWaitNs) WaitNs = MinWaitNs;
+      uint64_t WakeUp = Now + WaitNs;
+      if (WakeUp > Deadline) WakeUp = Deadline;
+      const struct timespec Time = { .tv_sec = (time_t)(WakeUp / 1000000000u), .tv_nsec = (long)(WakeUp % 1000000000u) };
+      while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &Time, NULL) == EINTR);
+    }
+  }
+  *actuallyReceived = Total;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Wait for events on the channels of the Linux termios backend
+//=============================================================================
+eERRORRESULT UART_LinuxTTY_Wait(UART_LinuxTTY* pDev, int timeoutMs, size_t* pEventCount)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pDev == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pEventCount != NULL) *pEventCount = 0;
+  if (pDev->EpollFd < 0) return ERR__NOT_INITIALIZED;
+  struct epoll_event Events[UART_LINUXTTY_MAX_EVENTS];
+  pDev->WaitCount++;
+  const int Count = epoll_wait(pDev->EpollFd, &Events[0], (int)UART_LINUXTTY_MAX_EVENTS, timeoutMs);
+  if (Count < 0) return (errno == EINTR ? ERR_NONE : ERR__GENERAL_ERROR);       // A signal is like a timeout
+  for (int zEvent = 0; zEvent < Count; ++zEvent)
+  {
+    if (Events[zEvent].data.u64 >= pDev->ChannelCount) continue;
+    UART_LinuxTTYchannel* pChannel = &pDev->pChannels[Events[zEvent].data.u64];
+    const uint32_t Flags = Events[zEvent].events;
+    if ((Flags & (EPOLLIN | EPOLLHUP | EPOLLRDHUP | EPOLLERR)) > 0) pChannel->Readable = true; // The receive reports the hang up after the last data
+    if ((Flags & EPOLLOUT) > 0) pChannel->Writable = true;
+    if ((Flags & (EPOLLHUP | EPOLLRDHUP)) > 0) pChannel->HangUp = true;
+  }
+  pDev->EventCount += (uint32_t)Count;
+  if (pEventCount != NULL) *pEventCount = (size_t)Count;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Close all the channels and the epoll of the Linux termios backend
+//=============================================================================
+void UART_LinuxTTY_Close(UART_LinuxTTY* pDev)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pDev == NULL) return;
+#endif
+  for (size_t zChannel = 0; zChannel < pDev->ChannelCount; ++zChannel)
+  {
+    if (pDev->pChannels[zChannel].Fd >= 0) close(pDev->pChannels[zChannel].Fd);
+    pDev->pChannels[zChannel].Fd = -1;
+  }
+  if (pDev->EpollFd >= 0) close(pDev->EpollFd);
+  pDev->EpollFd = -1;
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif // #if defined(__linux__) && !defined(ARDUINO) && !defined(USE_HAL_DRIVER) && !defined(USE_FULL_LL_DRIVER)
+//-----------------------------------------------------------------------------
@@ -0,0 +1,215 @@
+/*!*****************************************************************************
+ * @file    UART_LinuxTTY.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.1.0
+ * @date    16/10/2026
+ * @brief   Linux termios backend of the UART interface
+ * @details This backend plugs the Linux tty devices (/dev/ttySx, /dev/ttyUSBx,
+ * pseudo terminals...) into the generic UART_Interface of all the
+ * https://github.com/Emandhal drivers and developments. Each channel is a tty
+ * file descriptor in non-blocking mode and raw termios, each UART_Interface
+ * selects its channel with UART_Interface.Channel. The transmit and receive
+ * functions never block: they give the count of bytes actually sent or
+ * received, that can be less than asked or 0.
+ * All the channels are registered in one epoll (edge triggered), so one thread
+ * can serve many UARTs: wait with UART_LinuxTTY_Wait() then call the drivers of
+ * the channels ready. The file descriptors can be the master and slave of an
+ * openpty() pair to test without hardware.
+ * The batched receive waits on one channel until a count of bytes, an idle
+ * line or a timeout, and sleeps while the bytes arrive instead of waking up
+ * for each part of them
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.1.0    Add batched receive with threshold, idle line and timeout
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __UART_LINUXTTY_H_INC
+#define __UART_LINUXTTY_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "UART_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef UART_LINUXTTY_MAX_EVENTS
+#  define UART_LINUXTTY_MAX_EVENTS  ( 16u ) //!< Max epoll events read by one UART_LinuxTTY_Wait(). The other events are read by the next call
+#endif
+
+#ifndef UART_LINUXTTY_DEFAULT_BAUDRATE
+#  define UART_LINUXTTY_DEFAULT_BAUDRATE  ( 115200u ) //!< Baudrate used for the character time of the batched receive when the channel keeps the current baudrate (Baudrate = 0)
+#endif
+
+#ifndef UART_LINUXTTY_MIN_WAIT_US
+#  define UART_LINUXTTY_MIN_WAIT_US  ( 100u ) //!< Min sleep of the batched receive in microseconds, shorter sleeps cost more wake ups than they save latency
+#endif
+
+//! Last char errors of the Linux termios backend
+#define UART_LINUXTTY_HANGUP_ERROR  ( 0x01u ) //!< The other side of the tty has been closed (hang up). The data already received can still be read
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux termios backend
+//********************************************************************************************************************
+
+//! @brief tty device of a UART channel
+typedef struct UART_LinuxTTYchannel
+{
+  const char* pDevicePath; //!< Path of the tty device (ex: "/dev/ttyUSB0"). Opened by UART_LinuxTTY_Init() if Fd is negative
+  int Fd;                  //!< File descriptor of the tty device. Set to -1 before initialization or set an already opened file descriptor (ex: an openpty() side)
+  uint32_t Baudrate;       //!< Baudrate of the tty in bauds. Set to 0 to keep the current baudrate (pseudo terminals)
+  //--- Channel state ---
+  bool Readable;           //!< 'true' if the tty may have received data: set by an epoll input event, cleared when a receive gets less than asked (but kept after a hang up until the receive gives it)
+  bool Writable;           //!< 'true' if the tty may accept data: set by an epoll output event, cleared when a transmit sends less than asked
+  bool HangUp;             //!< 'true' if the other side of the tty has been closed
+  bool Opened;             //!< 'true' if the device has been opened by UART_LinuxTTY_Init() (closed again if the initialization fails)
+  //--- Statistics ---
+  uint32_t TxBytes;        //!< Count of bytes sent
+  uint32_t RxBytes;        //!< Count of bytes received
+  uint32_t WouldBlock;     //!< Count of transmits and receives that did not progress (EAGAIN)
+  uint32_t ReadCount;      //!< Count of read() calls
+  uint32_t SleepCount;     //!< Count of waits of the batched receive (ppoll() and clock_nanosleep() calls)
+} UART_LinuxTTYchannel;
+
+
+//! @brief Linux termios backend. Set this structure as the UART_Interface.InterfaceDevice of the interfaces of all its channels
+typedef struct UART_LinuxTTY
+{
+  UART_LinuxTTYchannel* pChannels; //!< tty devices, indexed by UART_Interface.Channel
+  size_t ChannelCount;             //!< Count of tty devices
+  //--- Backend state ---
+  int EpollFd;                     //!< epoll file descriptor of all the channels, set by UART_LinuxTTY_Init()
+  //--- Statistics ---
+  uint32_t WaitCount;              //!< Count of epoll_wait() calls
+  uint32_t EventCount;             //!< Count of epoll events received
+} UART_LinuxTTY;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// Linux termios backend functions
+//********************************************************************************************************************
+
+/*! @brief Linux termios backend initialization
+ *
+ * Open the devices of the channels not already opened, set all the channels in non-blocking mode and raw termios (8N1, no flow control, with the baudrate of the channel) and register them in a new epoll.
+ * If it fails, the devices it opened and the epoll are closed, the file descriptors given by the channels stay opened
+ * @param[in] *pDev Is the termios backend to initialize. Its channels shall already be set
+ * @return Returns an #eERRORRESULT value enum. #ERR__BAUDRATE_ERROR if a baudrate is not supported by termios
+ */
+eERRORRESULT UART_LinuxTTY_Init(UART_LinuxTTY* pDev);
+
+/*! @brief Configure a UART_Interface to use a channel of the Linux termios backend
+ *
+ * Many UART_Interface can share the same backend, each one with its channel
+ * @param[out] *pIntDev Is the UART interface container structure to configure
+ * @param[in] *pDev Is the termios backend to use
+ * @param[in] channel Is the channel of the interface
+ * @return Returns an #eERRORRESULT value enum. #ERR__UNKNOWN_CHANNEL if the channel does not exist
+ */
+eERRORRESULT UART_LinuxTTY_Attach(UART_Interface *pIntDev, UART_LinuxTTY* pDev, uint8_t channel);
+
+/*! @brief Linux termios transmit (#UARTtransmit_Func compatible)
+ *
+ * Write as much data as the tty accepts without blocking. If the tty output buffer is full, actuallySent is 0 and the function returns #ERR_NONE
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART transmit
+ * @param[in] *data Is the data array to send
+ * @param[in] size Is the count of data to send
+ * @param[out] *actuallySent Is the count of data actually sent to the tty
+ * @return Returns an #eERRORRESULT value enum. #ERR__TRANSMIT_ERROR if the write failed
+ */
+eERRORRESULT UART_LinuxTTY_Transmit(UART_Interface *pIntDev, const uint8_t* data, size_t size, size_t*const actuallySent);
+
+/*! @brief Linux termios receive (#UARTreceive_Func compatible)
+ *
+ * Read as much data as the tty has received, without blocking. If there is no data, actuallyReceived is 0 and the function returns #ERR_NONE
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART receive
+ * @param[out] *data Is where the data will be stored
+ * @param[in] size Is the count of data that the data buffer can hold
+ * @param[out] *actuallyReceived Is the count of data actually received
+ * @param[out] *lastCharError Is the last char received error: UART_NO_ERROR (0) or #UART_LINUXTTY_HANGUP_ERROR when the other side of the tty is closed and all its data have been received
+ * @return Returns an #eERRORRESULT value enum. #ERR__RECEIVE_ERROR if the read failed
+ */
+eERRORRESULT UART_LinuxTTY_Receive(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError);
+
+/*! @brief Linux termios batched receive (#UARTreceiveBatch_Func compatible)
+ *
+ * Block the calling thread until threshold bytes have been received, or the line is idle for idleChars character times after at least one byte, or the timeout elapsed.
+ * Before the first byte the function waits for input with ppoll(). After it, the function sleeps for the time the missing bytes need at the baudrate of the channel, limited to the idle time: a stream of bytes costs one read() per sleep instead of one wake up per part received.
+ * The idle line is seen when no new byte has been received for the idle time (min #UART_LINUXTTY_MIN_WAIT_US), checked after each sleep, so it is detected between 1 and 2 idle times after the last byte.
+ * A character is 10 bits (8N1) at UART_LinuxTTYchannel.Baudrate, or #UART_LINUXTTY_DEFAULT_BAUDRATE if the channel keeps the current baudrate.
+ * This function uses only its channel, not the epoll of the backend: do not wait on the epoll for this channel at the same time
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART receive
+ * @param[out] *data Is where the data will be stored
+ * @param[in] size Is the count of data that the data buffer can hold
+ * @param[in] threshold Is the count of data that ends the receive. Set to 0 to use size
+ * @param[in] idleChars Is the idle time of the line that ends the receive, in character times. Set to 0 to not end on idle line
+ * @param[in] timeoutUs Is the max duration of the receive in microseconds
+ * @param[out] *actuallyReceived Is the count of data actually received. 0 if the timeout elapsed without data
+ * @param[out] *lastCharError Is the last char received error: UART_NO_ERROR (0) or #UART_LINUXTTY_HANGUP_ERROR when the other side of the tty is closed and all its data have been received
+ * @return Returns an #eERRORRESULT value enum. #ERR__RECEIVE_ERROR if the read or the wait failed
+ */
+eERRORRESULT UART_LinuxTTY_ReceiveBatch(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t threshold, uint32_t idleChars, uint32_t timeoutUs, size_t*const actuallyReceived, uint8_t*const lastCharError);
+
+/*! @brief Wait for events on the channels of the Linux termios backend
+ *
+ * The events update the UART_LinuxTTYchannel.Readable, UART_LinuxTTYchannel.Writable and UART_LinuxTTYchannel.HangUp flags of the channels. The epoll is edge triggered: a channel gets a new event only after a receive or a transmit that did not get or send all the data asked
+ * @param[in] *pDev Is the termios backend
+ * @param[in] timeoutMs Is the max time to wait in milliseconds. 0 to return immediately, -1 to wait without limit
+ * @param[out] *pEventCount Is where the count of channels with an event will be stored (0 if the timeout elapsed). Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_LinuxTTY_Wait(UART_LinuxTTY* pDev, int timeoutMs, size_t* pEventCount);
+
+/*! @brief Close all the channels and the epoll of the Linux termios backend
+ *
+ * @param[in] *pDev Is the termios backend
+ */
+void UART_LinuxTTY_Close(UART_LinuxTTY* pDev);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __UART_LINUXTTY_H_INC */
@@ -0,0 +1,248 @@
+/*!*****************************************************************************
+ * @file    UART_Mux.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Virtual channels multiplexed over one physical UART
+ * @details A packet is only encoded when the transmit buffer of the framer is
+ *          empty, and UART_Mux_Init() checks that this buffer holds a worst
+ *          case packet, so the framer never holds nor sends a half packet
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include "UART_Mux.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#if (UART_MUX_MAX_PAYLOAD > 250u) || (UART_MUX_MAX_PAYLOAD == 0u)
+#  error UART_MUX_MAX_PAYLOAD shall be between 1 and 250
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART multiplexer internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Put the received frames in the receive rings of their channel
+//=============================================================================
+static eERRORRESULT __UART_Mux_Demux(UART_Mux* pMux)
+{
+  while (true)
+  {
+    UART_FramerFrame Frame;
+    const eERRORRESULT Error = UART_Framer_Receive(pMux->pFramer, &Frame);
+    if (Error == ERR__NO_DATA_AVAILABLE) return ERR_NONE;
+    if (Error == ERR__PARSE_ERROR) continue;                                     // Counted by the framer, the next frame can be good
+    if (Error != ERR_NONE) return Error;
+    if ((Frame.Size == 0) || (Frame.pData[0] >= pMux->ChannelCount)) { pMux->RxUnknownCount++; continue; }
+    UART_MuxChannel* pChannel = &pMux->pChannels[Frame.pData[0]];
+    const size_t Size = Frame.Size - 1u;
+    if ((pChannel->pRxRing->Size - UART_RingBuffer_Count(pChannel->pRxRing)) < Size) // The packet is whole or not at all
+    {
+      pChannel->RxDropped++;
+      continue;
+    }
+    UART_RingBuffer_Write(pChannel->pRxRing, &Frame.pData[1], Size);
+    pChannel->RxPackets++;
+  }
+}
+
+
+//=============================================================================
+// [STATIC] Encode a packet of a channel in the empty transmit buffer of the framer
+//=============================================================================
+static eERRORRESULT __UART_Mux_EncodePacket(UART_Mux* pMux, size_t channel, size_t size)
+{
+  UART_MuxChannel* pChannel = &pMux->pChannels[channel];
+  UART_Framer* pFramer = pMux->pFramer;
+  const uint8_t Index = (uint8_t)channel;
+  UART_RingSpans Spans;
+  UART_RingBuffer_PeekRead(pChannel->pTxRing, &Spans);
+  size_t Accepted = 0;
+  eERRORRESULT Error = UART_Framer_BeginFrame(pFramer);
+  if (Error != ERR_NONE) return Error;
+  Error = UART_Framer_AppendFrame(pFramer, &Index, 1u, &Accepted);
+  if ((Error == ERR_NONE) && (Accepted < 1u)) Error = ERR__BUFFER_FULL;
+  for (size_t zSpan = 0, Left = size; (zSpan < 2u) && (Left > 0) && (Error == ERR_NONE); ++zSpan)
+  {
+    const size_t Part = (Spans.Span[zSpan].Size < Left ? Spans.Span[zSpan].Size : Left);
+    Error = UART_Framer_AppendFrame(pFramer, Spans.Span[zSpan].pData, Part, &Accepted);
+    if ((Error == ERR_NONE) && (Accepted < Part)) Error = ERR__BUFFER_FULL;      // A half packet is never sent
+    Left -= Part;
+  }
+  if (Error == ERR_NONE) Error = UART_Framer_EndFrame(pFramer);
+  if (Error != ERR_NONE)                                                         // Drop the packet, the data stay in the ring
+  {
+    UART_Framer_AbortFrame(pFramer);                                             // Nothing sent: the packet fits in the empty transmit buffer (see UART_Mux_Init())
+    return Error;
+  }
+  UART_RingBuffer_CommitRead(pChannel->pTxRing, size);
+  pChannel->TxPackets++;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// [STATIC] Send packets of the channels by deficit round robin while the physical UART accepts them
+//=============================================================================
+static eERRORRESULT __UART_Mux_Schedule(UART_Mux* pMux)
+{
+  size_t Pending = 0;
+  eERRORRESULT Error = UART_Framer_Flush(pMux->pFramer, &Pending);
+  size_t Idle = 0;                                                               // Count of channels visited in a row without data
+  while ((Error == ERR_NONE) && (Pending == 0) && (Idle < pMux->ChannelCount))
+  {
+    UART_MuxChannel* pChannel = &pMux->pChannels[pMux->TxCurrent];
+    const size_t Count = UART_RingBuffer_Count(pChannel->pTxRing);
+    if (Count == 0)                                                              // An idle channel does not keep its deficit
+    {
+      pChannel->Deficit    = 0;
+      pMux->TxQuantumGiven = false;
+      pMux->TxCurrent      = (pMux->TxCurrent + 1u) % pMux->ChannelCount;
+      Idle++;
+      continue;
+    }
+    Idle = 0;
+    if (pMux->TxQuantumGiven == false)
+    {
+      pChannel->Deficit   += (uint32_t)pChannel->Weight * UART_MUX_MAX_PAYLOAD;
+      pMux->TxQuantumGiven = true;
+    }
+    const size_t Size = (Count < UART_MUX_MAX_PAYLOAD ? Count : UART_MUX_MAX_PAYLOAD);
+    if (Size > pChannel->Deficit)                                                // End of the turn of the channel, the rest of the deficit is for the next round
+    {
+      pMux->TxQuantumGiven = false;
+      pMux->TxCurrent      = (pMux->TxCurrent + 1u) % pMux->ChannelCount;
+      continue;
+    }
+    Error = __UART_Mux_EncodePacket(pMux, pMux->TxCurrent, Size);
+    if (Error != ERR_NONE) break;
+    pChannel->Deficit -= (uint32_t)Size;
+    Error = UART_Framer_Flush(pMux->pFramer, &Pending);
+  }
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART multiplexer functions
+//********************************************************************************************************************
+//=============================================================================
+// UART multiplexer initialization
+//=============================================================================
+eERRORRESULT UART_Mux_Init(UART_Mux* pMux)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pMux == NULL) || (pMux->pFramer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pMux->pChannels == NULL) || (pMux->ChannelCount == 0) || (pMux->ChannelCount > 256u)) return ERR__CONFIGURATION; // The channel index is one byte
+  for (size_t zChannel = 0; zChannel < pMux->ChannelCount; ++zChannel)
+  {
+    UART_MuxChannel* pChannel = &pMux->pChannels[zChannel];
+    if ((pChannel->pTxRing == NULL) || (pChannel->pRxRing == NULL) || (pChannel->Weight == 0)) return ERR__CONFIGURATION;
+    pChannel->Deficit   = 0;
+    pChannel->TxPackets = 0;
+    pChannel->RxPackets = 0;
+    pChannel->RxDropped = 0;
+  }
+  pMux->TxCurrent      = 0;
+  pMux->TxQuantumGiven = false;
+  pMux->RxUnknownCount = 0;
+  const eERRORRESULT Error = UART_Framer_Init(pMux->pFramer);
+  if (Error != ERR_NONE) return Error;
+  const size_t PacketMaxSize = (pMux->pFramer->Type == UART_FRAMER_COBS ? UART_MUX_COBS_PACKET_MAX_SIZE : UART_MUX_SLIP_PACKET_MAX_SIZE);
+  if (pMux->pFramer->TxBufferSize < PacketMaxSize) return ERR__CONFIGURATION;  // A packet shall always fit in the empty transmit buffer
+  return ERR_NONE;
+}
+
+
+#if !defined(USE_HAL_DRIVER)
+//=============================================================================
+// Configure a UART_Interface to use a virtual channel of the multiplexer
+//=============================================================================
+eERRORRESULT UART_Mux_Attach(UART_Interface *pIntDev, UART_Mux* pMux, uint8_t channel)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pMux == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pMux->pChannels == NULL) || (channel >= pMux->ChannelCount)) return ERR__UNKNOWN_CHANNEL;
+  pIntDev->InterfaceDevice     = pMux;
+  pIntDev->UniqueID            = 0;
+  pIntDev->fnUART_Transmit     = UART_Mux_Transmit;
+  pIntDev->fnUART_Receive      = UART_Mux_Receive;
+  pIntDev->Channel             = channel;
+  pIntDev->fnUART_ReceiveBatch = NULL;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Virtual channel transmit
+//=============================================================================
+eERRORRESULT UART_Mux_Transmit(UART_Interface *pIntDev, const uint8_t* data, size_t size, size_t*const actuallySent)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (actuallySent == NULL) || ((data == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  UART_Mux* pMux = (UART_Mux*)pIntDev->InterfaceDevice;
+  *actuallySent = 0;
+  if (pIntDev->Channel >= pMux->ChannelCount) return ERR__UNKNOWN_CHANNEL;
+  *actuallySent = UART_RingBuffer_Write(pMux->pChannels[pIntDev->Channel].pTxRing, data, size);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Virtual channel receive
+//=============================================================================
+eERRORRESULT UART_Mux_Receive(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (actuallyReceived == NULL) || (lastCharError == NULL) || ((data == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  UART_Mux* pMux = (UART_Mux*)pIntDev->InterfaceDevice;
+  *actuallyReceived = 0;
+  *lastCharError    = UART_NO_ERROR;
+  if (pIntDev->Channel >= pMux->ChannelCount) return ERR__UNKNOWN_CHANNEL;
+  *actuallyReceived = UART_RingBuffer_Read(pMux->pChannels[pIntDev->Channel].pRxRing, data, size);
+  return ERR_NONE;
+}
+#endif //#if !defined(USE_HAL_DRIVER)
+
+
+//=============================================================================
+// Move the packets between the rings of the channels and the physical UART
+//=============================================================================
+eERRORRESULT UART_Mux_Process(UART_Mux* pMux)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pMux == NULL) || (pMux->pFramer == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  const eERRORRESULT Error = __UART_Mux_Demux(pMux);
+  if (Error != ERR_NONE) return Error;
+  return __UART_Mux_Schedule(pMux);
+}
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,178 @@
+/*!*****************************************************************************
+ * @file    UART_Mux.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Virtual channels multiplexed over one physical UART
+ * @details The multiplexer gives a logical UART_Interface per channel (console,
+ * telemetry, firmware update...) on top of the UART_Framer of one physical
+ * UART. The data of each channel are sent in packets: a frame of the framer
+ * with the channel index as first byte and at most #UART_MUX_MAX_PAYLOAD
+ * bytes of the channel. A long transfer is cut in small packets, so the
+ * other channels never wait more than a packet.
+ * Each channel has a transmit ring and a receive ring (see UART_RingBuffer.h):
+ * the logical UART_Interface of a channel only copies in and out of its
+ * rings, and UART_Mux_Process() moves the packets between the rings and the
+ * physical UART. On transmit, the channels with data are served by deficit
+ * round robin: at each round a channel can send Weight x #UART_MUX_MAX_PAYLOAD
+ * bytes, so the link is shared in proportion of the weights whatever the
+ * amount of data queued. On receive, a packet goes in the ring of its
+ * channel, or is dropped if this ring is full: a channel that is not read
+ * does not block the others
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __UART_MUX_H_INC
+#define __UART_MUX_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "UART_Interface.h"
+#include "UART_RingBuffer.h"
+#include "UART_Framer.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef UART_MUX_MAX_PAYLOAD
+#  define UART_MUX_MAX_PAYLOAD  ( 64u ) //!< Max count of channel bytes in a packet (max 250). Smaller packets lower the wait of the other channels, bigger packets lower the overhead
+#endif
+
+#define UART_MUX_COBS_PACKET_MAX_SIZE  ( (UART_MUX_MAX_PAYLOAD + 1u) + 2u )        //!< Max size of an encoded COBS packet: channel index and payload, code byte and delimiter
+#define UART_MUX_SLIP_PACKET_MAX_SIZE  ( (2u * (UART_MUX_MAX_PAYLOAD + 1u)) + 2u ) //!< Max size of an encoded SLIP packet: channel index and payload all escaped, END before and after
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART multiplexer
+//********************************************************************************************************************
+
+//! @brief Virtual channel of the multiplexer
+typedef struct UART_MuxChannel
+{
+  UART_RingBuffer* pTxRing; //!< Transmit ring: the logical UART_Interface is the producer, UART_Mux_Process() is the consumer. Shall be initialized
+  UART_RingBuffer* pRxRing; //!< Receive ring: UART_Mux_Process() is the producer, the logical UART_Interface is the consumer. Shall be initialized
+  uint8_t Weight;           //!< Share of the link of the channel, relative to the other channels. Shall be at least 1
+  //--- Scheduler state ---
+  uint32_t Deficit;         //!< Bytes the channel can still send in the current round
+  //--- Statistics ---
+  uint32_t TxPackets;       //!< Count of packets sent
+  uint32_t RxPackets;       //!< Count of packets received in the receive ring
+  uint32_t RxDropped;       //!< Count of packets dropped because the receive ring was full
+} UART_MuxChannel;
+
+
+//! @brief Multiplexer of virtual channels over one physical UART. Set this structure as the UART_Interface.InterfaceDevice of the logical interfaces of all its channels
+typedef struct UART_Mux
+{
+  UART_Framer* pFramer;       //!< Framer of the physical UART. Its configuration shall be set, UART_Mux_Init() initializes it
+  UART_MuxChannel* pChannels; //!< Virtual channels, indexed by UART_Interface.Channel
+  size_t ChannelCount;        //!< Count of virtual channels
+  //--- Scheduler state ---
+  size_t TxCurrent;           //!< Channel served by the transmit scheduler
+  bool TxQuantumGiven;        //!< 'true' if the current channel already got its quantum of the round
+  //--- Statistics ---
+  uint32_t RxUnknownCount;    //!< Count of frames received for a channel that does not exist
+} UART_Mux;
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART multiplexer functions
+//********************************************************************************************************************
+
+/*! @brief UART multiplexer initialization
+ *
+ * @param[in] *pMux Is the multiplexer to initialize. Its configuration, the configuration of its framer and the rings of its channels shall already be set
+ * @return Returns an #eERRORRESULT value enum. #ERR__CONFIGURATION if the transmit buffer of the framer cannot hold a packet of #UART_MUX_COBS_PACKET_MAX_SIZE or #UART_MUX_SLIP_PACKET_MAX_SIZE bytes (following its framing)
+ */
+eERRORRESULT UART_Mux_Init(UART_Mux* pMux);
+
+#if !defined(USE_HAL_DRIVER)
+/*! @brief Configure a UART_Interface to use a virtual channel of the multiplexer
+ *
+ * @param[out] *pIntDev Is the UART interface container structure to configure
+ * @param[in] *pMux Is the multiplexer to use
+ * @param[in] channel Is the channel of the interface
+ * @return Returns an #eERRORRESULT value enum. #ERR__UNKNOWN_CHANNEL if the channel does not exist
+ */
+eERRORRESULT UART_Mux_Attach(UART_Interface *pIntDev, UART_Mux* pMux, uint8_t channel);
+
+/*! @brief Virtual channel transmit (#UARTtransmit_Func compatible)
+ *
+ * Copy as much data as the transmit ring of the channel can hold. The data are sent by UART_Mux_Process()
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART transmit
+ * @param[in] *data Is the data array to send
+ * @param[in] size Is the count of data to send
+ * @param[out] *actuallySent Is the count of data actually copied in the transmit ring
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_Mux_Transmit(UART_Interface *pIntDev, const uint8_t* data, size_t size, size_t*const actuallySent);
+
+/*! @brief Virtual channel receive (#UARTreceive_Func compatible)
+ *
+ * Copy as much data as available in the receive ring of the channel
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART receive
+ * @param[out] *data Is where the data will be stored
+ * @param[in] size Is the count of data that the data buffer can hold
+ * @param[out] *actuallyReceived Is the count of data actually received
+ * @param[out] *lastCharError Is the last char received error. Always UART_NO_ERROR (0)
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_Mux_Receive(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError);
+#endif //#if !defined(USE_HAL_DRIVER)
+
+/*! @brief Move the packets between the rings of the channels and the physical UART
+ *
+ * Receive all the frames available on the physical UART and put their data in the receive rings, then send packets of the channels, by deficit round robin, as long as the physical UART accepts them.
+ * Call it periodically or when the physical UART is ready, from one context only
+ * @param[in] *pMux Is the multiplexer
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_Mux_Process(UART_Mux* pMux);
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __UART_MUX_H_INC */
@@ -0,0 +1,308 @@
+/*!*****************************************************************************
+ * @file    UART_RingBuffer.c
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Lock-free single-producer single-consumer ring buffer for UART
+ * @details The indexes are published with release stores and read with
+ *          acquire loads of the other side, no lock is needed between an
+ *          interrupt and a thread or between two threads
+ ******************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+
+//-----------------------------------------------------------------------------
+#include <string.h>
+#include "UART_RingBuffer.h"
+#include "ErrorsDef.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART ring buffer internal functions
+//********************************************************************************************************************
+//=============================================================================
+// [STATIC] Fill the spans of a part of the ring buffer
+//=============================================================================
+static size_t __UART_RingBuffer_Spans(const UART_RingBuffer* pRing, uint32_t index, uint32_t size, UART_RingSpans* pSpans)
+{
+  const uint32_t Start = index & pRing->Mask;
+  const uint32_t First = ((pRing->Size - Start) < size ? (pRing->Size - Start) : size);     // Up to the end of the buffer
+  pSpans->Span[0].pData = &pRing->pBuffer[Start];
+  pSpans->Span[0].Size  = First;
+  pSpans->Span[1].pData = &pRing->pBuffer[0];
+  pSpans->Span[1].Size  = size - First;
+  pSpans->Size          = size;
+  return size;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART ring buffer functions
+//********************************************************************************************************************
+//=============================================================================
+// Ring buffer initialization
+//=============================================================================
+eERRORRESULT UART_RingBuffer_Init(UART_RingBuffer* pRing, uint8_t* pBuffer, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pRing == NULL) return ERR__PARAMETER_ERROR;
+#endif
+  if (pBuffer == NULL) return ERR__NULL_BUFFER;
+  if ((size == 0) || (size > 0x80000000u) || ((size & (size - 1u)) > 0)) return ERR__CONFIGURATION; // The free running indexes need a power of 2
+  pRing->pBuffer = pBuffer;
+  pRing->Size    = (uint32_t)size;
+  pRing->Mask    = (uint32_t)(size - 1u);
+  __atomic_store_n(&pRing->Head, 0, __ATOMIC_RELAXED);
+  __atomic_store_n(&pRing->Tail, 0, __ATOMIC_RELEASE);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Get the count of bytes in the ring buffer
+//=============================================================================
+size_t UART_RingBuffer_Count(const UART_RingBuffer* pRing)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pRing == NULL) return 0;
+#endif
+  const uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_ACQUIRE);
+  const uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);
+  return (size_t)(Head - Tail);
+}
+
+
+//=============================================================================
+// Peek the bytes to read (consumer side)
+//=============================================================================
+size_t UART_RingBuffer_PeekRead(UART_RingBuffer* pRing, UART_RingSpans* pSpans)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pRing == NULL) || (pSpans == NULL)) return 0;
+#endif
+  const uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_ACQUIRE);                  // The bytes before the head are written
+  const uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_RELAXED);                  // Only written by the consumer
+  return __UART_RingBuffer_Spans(pRing, Tail, Head - Tail, pSpans);
+}
+
+
+//=============================================================================
+// Release bytes read (consumer side)
+//=============================================================================
+void UART_RingBuffer_CommitRead(UART_RingBuffer* pRing, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pRing == NULL) return;
+#endif
+  const uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_RELAXED);
+  __atomic_store_n(&pRing->Tail, Tail + (uint32_t)size, __ATOMIC_RELEASE);                // The reads of the bytes are done before the producer can reuse them
+}
+
+
+//=============================================================================
+// Peek the free space to write (producer side)
+//=============================================================================
+size_t UART_RingBuffer_PeekWrite(UART_RingBuffer* pRing, UART_RingSpans* pSpans)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pRing == NULL) || (pSpans == NULL)) return 0;
+#endif
+  const uint32_t Tail = __atomic_load_n(&pRing->Tail, __ATOMIC_ACQUIRE);                  // The bytes before the tail are released
+  const uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_RELAXED);                  // Only written by the producer
+  return __UART_RingBuffer_Spans(pRing, Head, pRing->Size - (Head - Tail), pSpans);
+}
+
+
+//=============================================================================
+// Publish bytes written (producer side)
+//=============================================================================
+void UART_RingBuffer_CommitWrite(UART_RingBuffer* pRing, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if (pRing == NULL) return;
+#endif
+  const uint32_t Head = __atomic_load_n(&pRing->Head, __ATOMIC_RELAXED);
+  __atomic_store_n(&pRing->Head, Head + (uint32_t)size, __ATOMIC_RELEASE);                // The writes of the bytes are done before the consumer can see them
+}
+
+
+//=============================================================================
+// Copy bytes in the ring buffer (producer side)
+//=============================================================================
+size_t UART_RingBuffer_Write(UART_RingBuffer* pRing, const uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pRing == NULL) || ((pData == NULL) && (size > 0))) return 0;
+#endif
+  UART_RingSpans Spans;
+  UART_RingBuffer_PeekWrite(pRing, &Spans);
+  if (size > Spans.Size) size = Spans.Size;
+  const size_t First = (size < Spans.Span[0].Size ? size : Spans.Span[0].Size);
+  if (First > 0) memcpy(Spans.Span[0].pData, pData, First);
+  if (size > First) memcpy(Spans.Span[1].pData, &pData[First], size - First);
+  UART_RingBuffer_CommitWrite(pRing, size);
+  return size;
+}
+
+
+//=============================================================================
+// Copy bytes from the ring buffer (consumer side)
+//=============================================================================
+size_t UART_RingBuffer_Read(UART_RingBuffer* pRing, uint8_t* pData, size_t size)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pRing == NULL) || ((pData == NULL) && (size > 0))) return 0;
+#endif
+  UART_RingSpans Spans;
+  UART_RingBuffer_PeekRead(pRing, &Spans);
+  if (size > Spans.Size) size = Spans.Size;
+  const size_t First = (size < Spans.Span[0].Size ? size : Spans.Span[0].Size);
+  if (First > 0) memcpy(pData, Spans.Span[0].pData, First);
+  if (size > First) memcpy(&pData[First], Spans.Span[1].pData, size - First);
+  UART_RingBuffer_CommitRead(pRing, size);
+  return size;
+}
+
+//-----------------------------------------------------------------------------
+
+
+//=============================================================================
+// Receive from a UART directly in the free space of a ring buffer (producer side)
+//=============================================================================
+eERRORRESULT UART_RingBuffer_ReceiveFrom(UART_Interface *pIntDev, UART_RingBuffer* pRing, size_t* pReceived, uint8_t*const lastCharError)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pRing == NULL) || (lastCharError == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pReceived != NULL) *pReceived = 0;
+  *lastCharError = UART_NO_ERROR;
+  if (pIntDev->fnUART_Receive == NULL) return ERR__PARAMETER_ERROR;
+  UART_RingSpans Spans;
+  if (UART_RingBuffer_PeekWrite(pRing, &Spans) == 0) return ERR__BUFFER_FULL;
+
+  //--- Receive in each span of the free space ---
+  size_t Total = 0;
+  eERRORRESULT Error = ERR_NONE;
+  for (size_t zSpan = 0; zSpan < 2u; ++zSpan)
+  {
+    if (Spans.Span[zSpan].Size == 0) break;
+    size_t Received = 0;
+    Error = pIntDev->fnUART_Receive(pIntDev, Spans.Span[zSpan].pData, Spans.Span[zSpan].Size, &Received, lastCharError);
+    if (Received > Spans.Span[zSpan].Size) Received = Spans.Span[zSpan].Size;
+    UART_RingBuffer_CommitWrite(pRing, Received);                                         // Published span by span, the consumer can start on the first one
+    Total += Received;
+    if ((Error != ERR_NONE) || (*lastCharError != UART_NO_ERROR) || (Received < Spans.Span[zSpan].Size)) break; // Nothing more to receive for now
+  }
+  if (pReceived != NULL) *pReceived = Total;
+  return Error;
+}
+
+
+//=============================================================================
+// Transmit to a UART directly from the bytes of a ring buffer (consumer side)
+//=============================================================================
+eERRORRESULT UART_RingBuffer_TransmitTo(UART_Interface *pIntDev, UART_RingBuffer* pRing, size_t* pSent)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pRing == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if (pSent != NULL) *pSent = 0;
+  if (pIntDev->fnUART_Transmit == NULL) return ERR__PARAMETER_ERROR;
+  UART_RingSpans Spans;
+  if (UART_RingBuffer_PeekRead(pRing, &Spans) == 0) return ERR_NONE;
+
+  //--- Transmit each span of the bytes to read ---
+  size_t Total = 0;
+  eERRORRESULT Error = ERR_NONE;
+  for (size_t zSpan = 0; zSpan < 2u; ++zSpan)
+  {
+    if (Spans.Span[zSpan].Size == 0) break;
+    size_t Sent = 0;
+    Error = pIntDev->fnUART_Transmit(pIntDev, Spans.Span[zSpan].pData, Spans.Span[zSpan].Size, &Sent);
+    if (Sent > Spans.Span[zSpan].Size) Sent = Spans.Span[zSpan].Size;
+    UART_RingBuffer_CommitRead(pRing, Sent);
+    Total += Sent;
+    if ((Error != ERR_NONE) || (Sent < Spans.Span[zSpan].Size)) break;                     // The UART transmit FIFO is full
+  }
+  if (pSent != NULL) *pSent = Total;
+  return Error;
+}
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+#if !defined(USE_HAL_DRIVER)
+//********************************************************************************************************************
+// Ring UART interface functions
+//********************************************************************************************************************
+//=============================================================================
+// Configure a UART_Interface to use a ring UART interface
+//=============================================================================
+eERRORRESULT UART_RingInterface_Attach(UART_Interface *pIntDev, UART_RingInterface* pRingInt)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pRingInt == NULL)) return ERR__PARAMETER_ERROR;
+#endif
+  if ((pRingInt->pRx == NULL) || (pRingInt->pTx == NULL)) return ERR__CONFIGURATION;
+  pIntDev->InterfaceDevice     = pRingInt;
+  pIntDev->UniqueID            = 0;
+  pIntDev->fnUART_Transmit     = UART_RingInterface_Transmit;
+  pIntDev->fnUART_Receive      = UART_RingInterface_Receive;
+  pIntDev->Channel             = 0;
+  pIntDev->fnUART_ReceiveBatch = NULL;
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Ring UART interface transmit
+//=============================================================================
+eERRORRESULT UART_RingInterface_Transmit(UART_Interface *pIntDev, const uint8_t* data, size_t size, size_t*const actuallySent)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (actuallySent == NULL) || ((data == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  UART_RingInterface* pRingInt = (UART_RingInterface*)pIntDev->InterfaceDevice;
+  *actuallySent = UART_RingBuffer_Write(pRingInt->pTx, data, size);
+  return ERR_NONE;
+}
+
+
+//=============================================================================
+// Ring UART interface receive
+//=============================================================================
+eERRORRESULT UART_RingInterface_Receive(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError)
+{
+#ifdef CHECK_NULL_PARAM
+  if ((pIntDev == NULL) || (pIntDev->InterfaceDevice == NULL) || (actuallyReceived == NULL) || (lastCharError == NULL) || ((data == NULL) && (size > 0))) return ERR__PARAMETER_ERROR;
+#endif
+  UART_RingInterface* pRingInt = (UART_RingInterface*)pIntDev->InterfaceDevice;
+  *actuallyReceived = UART_RingBuffer_Read(pRingInt->pRx, data, size);
+  *lastCharError    = __atomic_exchange_n(&pRingInt->LastCharError, UART_NO_ERROR, __ATOMIC_ACQ_REL);
+  return ERR_NONE;
+}
+#endif //#if !defined(USE_HAL_DRIVER)
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
@@ -0,0 +1,256 @@
+/*!*****************************************************************************
+ * @file    UART_RingBuffer.h
+ * @author  Fabien 'Emandhal' MAILLY
+ * @version 1.0.0
+ * @date    16/10/2026
+ * @brief   Lock-free single-producer single-consumer ring buffer for UART
+ * @details The ring buffer holds the received or the to-send bytes of a UART
+ * between one producer and one consumer (interrupt and thread, or two threads)
+ * without lock. The size is a power of two and the indexes are free running,
+ * masked at each access. The producer index and the consumer index are on
+ * different cache lines.
+ * The data are accessed in place: a peek gives up to two contiguous spans
+ * (before and after the end of the buffer) and a commit releases them. The
+ * UART pump functions receive from and transmit to a UART_Interface directly
+ * in the spans, and the ring UART interface gives the copy API to the drivers
+ * that still use it
+ ******************************************************************************/
+ /* @page License
+ *
+ * Copyright (c) 2020-2023 Fabien MAILLY
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS,
+ * IMPLIED OR STATUTORY, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO
+ * EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *****************************************************************************/
+
+/* Revision history:
+ * 1.0.0    Release version
+ *****************************************************************************/
+#ifndef __UART_RINGBUFFER_H_INC
+#define __UART_RINGBUFFER_H_INC
+//=============================================================================
+
+//-----------------------------------------------------------------------------
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+//-----------------------------------------------------------------------------
+#include "ErrorsDef.h"
+#include "UART_Interface.h"
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+extern "C" {
+#endif
+//-----------------------------------------------------------------------------
+
+#ifndef UART_RINGBUFFER_CACHE_LINE
+#  define UART_RINGBUFFER_CACHE_LINE  ( 64u ) //!< Size of a cache line of the CPU. The producer and the consumer indexes are separated by this size
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART ring buffer
+//********************************************************************************************************************
+
+//! @brief Contiguous part of the ring buffer
+typedef struct UART_RingSpan
+{
+  uint8_t* pData; //!< First byte of the span
+  size_t Size;    //!< Count of bytes of the span. 0 if the span is not used
+} UART_RingSpan;
+
+
+//! @brief Up to two contiguous parts of the ring buffer, in the order of the data
+typedef struct UART_RingSpans
+{
+  UART_RingSpan Span[2]; //!< The first span ends at the end of the buffer or at the end of the data, the second one starts at the beginning of the buffer
+  size_t Size;           //!< Total count of bytes of the spans
+} UART_RingSpans;
+
+
+//! @brief Single-producer single-consumer ring buffer
+typedef struct UART_RingBuffer
+{
+  uint8_t* pBuffer;                                                            //!< Buffer of the data
+  uint32_t Size;                                                               //!< Size of the buffer, a power of 2 (max 2^31)
+  uint32_t Mask;                                                               //!< Size - 1, set by UART_RingBuffer_Init()
+  uint8_t _Pad0[UART_RINGBUFFER_CACHE_LINE];
+  volatile uint32_t Head;                                                      //!< Free running index of the next byte to write, only written by the producer
+  uint8_t _Pad1[UART_RINGBUFFER_CACHE_LINE - sizeof(uint32_t)];
+  volatile uint32_t Tail;                                                      //!< Free running index of the next byte to read, only written by the consumer
+  uint8_t _Pad2[UART_RINGBUFFER_CACHE_LINE - sizeof(uint32_t)];
+} UART_RingBuffer;
+
+
+#if !defined(USE_HAL_DRIVER)
+//! @brief Ring UART interface: the UART_Interface functions of the drivers use a receive ring and a transmit ring filled and emptied by the UART side (interrupt, DMA, pump thread)
+typedef struct UART_RingInterface
+{
+  UART_RingBuffer* pRx;                                                        //!< Receive ring: the UART side is the producer, the driver is the consumer
+  UART_RingBuffer* pTx;                                                        //!< Transmit ring: the driver is the producer, the UART side is the consumer
+  volatile uint8_t LastCharError;                                              //!< Last char error set by the UART side, given and cleared by the next receive of the driver
+} UART_RingInterface;
+#endif
+
+//-----------------------------------------------------------------------------
+
+
+
+
+
+//********************************************************************************************************************
+// UART ring buffer functions
+//********************************************************************************************************************
+
+/*! @brief Ring buffer initialization
+ *
+ * @param[out] *pRing Is the ring buffer to initialize
+ * @param[in] *pBuffer Is the buffer of the data
+ * @param[in] size Is the size of the buffer. Shall be a power of 2
+ * @return Returns an #eERRORRESULT value enum. #ERR__CONFIGURATION if the size is not a power of 2
+ */
+eERRORRESULT UART_RingBuffer_Init(UART_RingBuffer* pRing, uint8_t* pBuffer, size_t size);
+
+/*! @brief Get the count of bytes in the ring buffer
+ *
+ * Can be called by the producer and the consumer. The other side can change the count at any time: the consumer can read at least this count and the producer can write at least the size minus this count
+ * @param[in] *pRing Is the ring buffer
+ * @return Returns the count of bytes in the ring buffer
+ */
+size_t UART_RingBuffer_Count(const UART_RingBuffer* pRing);
+
+/*! @brief Peek the bytes to read (consumer side)
+ *
+ * The spans stay valid until the commit of their bytes
+ * @param[in] *pRing Is the ring buffer
+ * @param[out] *pSpans Is where the spans of the bytes to read will be stored
+ * @return Returns the count of bytes to read
+ */
+size_t UART_RingBuffer_PeekRead(UART_RingBuffer* pRing, UART_RingSpans* pSpans);
+
+/*! @brief Release bytes read (consumer side)
+ *
+ * @param[in] *pRing Is the ring buffer
+ * @param[in] size Is the count of bytes to release. Shall not be more than the size given by the last UART_RingBuffer_PeekRead()
+ */
+void UART_RingBuffer_CommitRead(UART_RingBuffer* pRing, size_t size);
+
+/*! @brief Peek the free space to write (producer side)
+ *
+ * The spans stay valid until the commit of their bytes
+ * @param[in] *pRing Is the ring buffer
+ * @param[out] *pSpans Is where the spans of the free space will be stored
+ * @return Returns the count of bytes that can be written
+ */
+size_t UART_RingBuffer_PeekWrite(UART_RingBuffer* pRing, UART_RingSpans* pSpans);
+
+/*! @brief Publish bytes written (producer side)
+ *
+ * @param[in] *pRing Is the ring buffer
+ * @param[in] size Is the count of bytes to publish. Shall not be more than the size given by the last UART_RingBuffer_PeekWrite()
+ */
+void UART_RingBuffer_CommitWrite(UART_RingBuffer* pRing, size_t size);
+
+/*! @brief Copy bytes in the ring buffer (producer side)
+ *
+ * @param[in] *pRing Is the ring buffer
+ * @param[in] *pData Is the data to copy
+ * @param[in] size Is the count of bytes to copy
+ * @return Returns the count of bytes copied, less than size if the ring buffer is full
+ */
+size_t UART_RingBuffer_Write(UART_RingBuffer* pRing, const uint8_t* pData, size_t size);
+
+/*! @brief Copy bytes from the ring buffer (consumer side)
+ *
+ * @param[in] *pRing Is the ring buffer
+ * @param[out] *pData Is where the bytes will be copied
+ * @param[in] size Is the max count of bytes to copy
+ * @return Returns the count of bytes copied
+ */
+size_t UART_RingBuffer_Read(UART_RingBuffer* pRing, uint8_t* pData, size_t size);
+
+//-----------------------------------------------------------------------------
+
+/*! @brief Receive from a UART directly in the free space of a ring buffer (producer side)
+ *
+ * The UART receive function is called for each span of the free space until it receives less than the span size
+ * @param[in] *pIntDev Is the UART interface to receive from
+ * @param[in] *pRing Is the ring buffer
+ * @param[out] *pReceived Is where the count of bytes received will be stored. Can be NULL
+ * @param[out] *lastCharError Is the last char received error. Set to UART_NO_ERROR (0) if no errors
+ * @return Returns an #eERRORRESULT value enum. #ERR__BUFFER_FULL if the ring buffer is full
+ */
+eERRORRESULT UART_RingBuffer_ReceiveFrom(UART_Interface *pIntDev, UART_RingBuffer* pRing, size_t* pReceived, uint8_t*const lastCharError);
+
+/*! @brief Transmit to a UART directly from the bytes of a ring buffer (consumer side)
+ *
+ * The UART transmit function is called for each span of the bytes to read until it sends less than the span size
+ * @param[in] *pIntDev Is the UART interface to transmit to
+ * @param[in] *pRing Is the ring buffer
+ * @param[out] *pSent Is where the count of bytes sent will be stored. Can be NULL
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_RingBuffer_TransmitTo(UART_Interface *pIntDev, UART_RingBuffer* pRing, size_t* pSent);
+
+//-----------------------------------------------------------------------------
+
+#if !defined(USE_HAL_DRIVER)
+/*! @brief Configure a UART_Interface to use a ring UART interface
+ *
+ * The drivers use the UART_Interface; the UART side fills the receive ring, empties the transmit ring and sets UART_RingInterface.LastCharError
+ * @param[out] *pIntDev Is the UART interface container structure to configure
+ * @param[in] *pRingInt Is the ring UART interface to use. Its rings shall already be initialized
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_RingInterface_Attach(UART_Interface *pIntDev, UART_RingInterface* pRingInt);
+
+/*! @brief Ring UART interface transmit (#UARTtransmit_Func compatible)
+ *
+ * Copy as much data as the transmit ring can hold
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART transmit
+ * @param[in] *data Is the data array to send
+ * @param[in] size Is the count of data to send
+ * @param[out] *actuallySent Is the count of data actually copied in the transmit ring
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_RingInterface_Transmit(UART_Interface *pIntDev, const uint8_t* data, size_t size, size_t*const actuallySent);
+
+/*! @brief Ring UART interface receive (#UARTreceive_Func compatible)
+ *
+ * Copy as much data as available in the receive ring
+ * @param[in] *pIntDev Is the UART interface container structure used for the UART receive
+ * @param[out] *data Is where the data will be stored
+ * @param[in] size Is the count of data that the data buffer can hold
+ * @param[out] *actuallyReceived Is the count of data actually received
+ * @param[out] *lastCharError Is the last char received error. Set to UART_NO_ERROR (0) if no errors
+ * @return Returns an #eERRORRESULT value enum
+ */
+eERRORRESULT UART_RingInterface_Receive(UART_Interface *pIntDev, uint8_t* data, size_t size, size_t*const actuallyReceived, uint8_t*const lastCharError);
+#endif //#if !defined(USE_HAL_DRIVER)
+
+//-----------------------------------------------------------------------------
+#ifdef __cplusplus
+}
+#endif
+//-----------------------------------------------------------------------------
+#endif /* __UART_RINGBUFFER_H_INC */